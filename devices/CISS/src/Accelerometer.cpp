@@ -182,16 +182,31 @@ void Accelerometer::update(const IoT::Devices::Acceleration& acceleration)
 
 	if (_enabled)
 	{
-		if (!_ready || acceleration.x != _acceleration.x || acceleration.y != _acceleration.y || acceleration.z != _acceleration.z)
-		{
-			_ready = true;
-			_acceleration = acceleration;
-			lock.unlock();
+		bool changed = !_ready || acceleration.x != _acceleration.x || acceleration.y != _acceleration.y || acceleration.z != _acceleration.z;
+		_ready = true;
+		_acceleration = acceleration;
+		IoT::Devices::BufferedSampleStream::Ptr pSampleStream = _pSampleStream;
+		lock.unlock();
 
+		if (pSampleStream)
+		{
+			double values[3] = {acceleration.x, acceleration.y, acceleration.z};
+			pSampleStream->addSample(Poco::Timestamp(), values);
+		}
+		if (changed)
+		{
 			accelerationChanged(this, acceleration);
 		}
 	}
 }
 
 
+void Accelerometer::setSampleStream(IoT::Devices::BufferedSampleStream::Ptr pSampleStream)
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	_pSampleStream = pSampleStream;
+}
+
+
 } } // namespace IoT::CISS
@@ -14,6 +14,7 @@
 
 #include "IoT/Devices/Accelerometer.h"
 #include "IoT/Devices/DeviceImpl.h"
+#include "IoT/Devices/BufferedSampleStream.h"
 #include "Poco/SharedPtr.h"
 
 
@@ -46,6 +47,10 @@ public:
 	void update(const IoT::Devices::Acceleration& acceleration);
 		/// Updates the acceleration.
 
+	void setSampleStream(IoT::Devices::BufferedSampleStream::Ptr pSampleStream);
+		/// Sets the SampleStream that receives every sample,
+		/// whether or not it differs from the previous one.
+
 	void enable(bool enabled);
 		/// Enables or disables the sensor.
 
@@ -78,6 +83,7 @@ protected:
 	bool _ready;
 	IoT::Devices::Acceleration _acceleration;
 	Poco::Any _deviceIdentifier;
+	IoT::Devices::BufferedSampleStream::Ptr _pSampleStream;
 };
 
 
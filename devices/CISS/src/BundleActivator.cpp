@@ -16,10 +16,13 @@
 #include "Poco/OSP/ServiceFinder.h"
 #include "Poco/OSP/PreferencesService.h"
 #include "Poco/RemotingNG/ORB.h"
+#include "Poco/Util/Timer.h"
 #include "IoT/Devices/SensorServerHelper.h"
 #include "IoT/Devices/AccelerometerServerHelper.h"
 #include "IoT/Devices/GyroscopeServerHelper.h"
 #include "IoT/Devices/MagnetometerServerHelper.h"
+#include "IoT/Devices/SampleStreamServerHelper.h"
+#include "IoT/Devices/BufferedSampleStream.h"
 #include "Poco/Delegate.h"
 #include "Poco/ClassLibrary.h"
 #include "Poco/Format.h"
@@ -144,10 +147,47 @@ public:
 		_serviceRefs.push_back(pServiceRef);
 	}
 
+	IoT::Devices::BufferedSampleStream::Ptr registerSampleStream(Poco::SharedPtr<Node> pNode, const std::string& baseKey, const std::string& name, const std::string& symbolicName, const std::string& physicalQuantity, const std::string& physicalUnit)
+	{
+		typedef Poco::RemotingNG::ServerHelper<IoT::Devices::SampleStream> ServerHelper;
+
+		IoT::Devices::BufferedSampleStream::Params params;
+		params.name = name + " Stream";
+		params.symbolicName = symbolicName + ".stream";
+		params.deviceIdentifier = pNode->id();
+		params.physicalQuantity = physicalQuantity;
+		params.physicalUnit = physicalUnit;
+		params.channelNames.push_back("x");
+		params.channelNames.push_back("y");
+		params.channelNames.push_back("z");
+		params.blockSize = _pPrefs->configuration()->getInt(baseKey + ".sampleStream.blockSize", IoT::Devices::BufferedSampleStream::DEFAULT_BLOCK_SIZE);
+		params.blockLatency = _pPrefs->configuration()->getInt(baseKey + ".sampleStream.blockLatency", IoT::Devices::BufferedSampleStream::DEFAULT_BLOCK_LATENCY);
+		params.bufferSize = _pPrefs->configuration()->getInt(baseKey + ".sampleStream.bufferSize", IoT::Devices::BufferedSampleStream::DEFAULT_BUFFER_SIZE);
+		params.pTimer = _pTimer;
+
+		IoT::Devices::BufferedSampleStream::Ptr pSampleStream = new IoT::Devices::BufferedSampleStream(params);
+
+		std::string oid(params.symbolicName);
+		oid += '#';
+		oid += pNode->id();
+
+		ServerHelper::RemoteObjectPtr pSampleStreamRemoteObject = ServerHelper::createRemoteObject(pSampleStream, oid);
+
+		Properties props;
+		props.set("io.macchina.device", params.symbolicName);
+		props.set("io.macchina.deviceType", IoT::Devices::BufferedSampleStream::TYPE);
+
+		ServiceRef::Ptr pServiceRef = _pContext->registry().registerService(oid, pSampleStreamRemoteObject, props);
+		_serviceRefs.push_back(pServiceRef);
+
+		return pSampleStream;
+	}
+
 	void start(BundleContext::Ptr pContext)
 	{
 		_pContext = pContext;
 		_pPrefs = ServiceFinder::find<PreferencesService>(pContext);
+		_pTimer = new Poco::Util::Timer;
 
 		Poco::Util::AbstractConfiguration::Keys keys;
 		_pPrefs->configuration()->keys("ciss.ports", keys);
@@ -178,6 +218,13 @@ public:
 				registerSensor(_pNode, _pNode->pressure());
 				registerSensor(_pNode, _pNode->light());
 
+				if (_pPrefs->configuration()->getBool(baseKey + ".sampleStream.enable", true))
+				{
+					_pNode->accelerometer()->setSampleStream(registerSampleStream(_pNode, baseKey, Accelerometer::NAME, Accelerometer::SYMBOLIC_NAME, "acceleration", "g"));
+					_pNode->magnetometer()->setSampleStream(registerSampleStream(_pNode, baseKey, Magnetometer::NAME, Magnetometer::SYMBOLIC_NAME, "magneticFluxDensity", "mT"));
+					_pNode->gyroscope()->setSampleStream(registerSampleStream(_pNode, baseKey, Gyroscope::NAME, Gyroscope::SYMBOLIC_NAME, "angularVelocity", "deg/s"));
+				}
+
 				_pNode->setSamplingInterval(Node::CISS_SENSOR_ACCELEROMETER,
 					_pPrefs->configuration()->getInt(baseKey + ".inertial.samplingInterval.usec",
 						1000*_pPrefs->configuration()->getInt(baseKey + ".inertial.samplingInterval", 100)));
@@ -211,6 +258,8 @@ public:
 		}
 		_serviceRefs.clear();
 		_pNode = 0;
+		_pTimer->cancel(true);
+		_pTimer = 0;
 		_pPrefs = 0;
 		_pContext = 0;
 	}
@@ -220,6 +269,7 @@ private:
 	PreferencesService::Ptr _pPrefs;
 	std::vector<ServiceRef::Ptr> _serviceRefs;
 	Poco::SharedPtr<Node> _pNode;
+	Poco::SharedPtr<Poco::Util::Timer> _pTimer;
 };
 
 
@@ -14,6 +14,7 @@
 
 #include "IoT/Devices/Gyroscope.h"
 #include "IoT/Devices/DeviceImpl.h"
+#include "IoT/Devices/BufferedSampleStream.h"
 #include "Poco/SharedPtr.h"
 
 
@@ -46,6 +47,10 @@ public:
 	void update(const IoT::Devices::Rotation& rotation);
 		/// Updates the Rotation.
 
+	void setSampleStream(IoT::Devices::BufferedSampleStream::Ptr pSampleStream);
+		/// Sets the SampleStream that receives every sample,
+		/// whether or not it differs from the previous one.
+
 	void enable(bool enabled);
 		/// Enables or disables the sensor.
 
@@ -75,6 +80,7 @@ protected:
 	bool _ready;
 	IoT::Devices::Rotation _rotation;
 	Poco::Any _deviceIdentifier;
+	IoT::Devices::BufferedSampleStream::Ptr _pSampleStream;
 };
 
 
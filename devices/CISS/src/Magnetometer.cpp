@@ -157,15 +157,31 @@ void Magnetometer::update(const IoT::Devices::MagneticFieldStrength& fieldStreng
 
 	if (_enabled)
 	{
-		if (!_ready || fieldStrength.x != _fieldStrength.x || fieldStrength.y != _fieldStrength.y || fieldStrength.z != _fieldStrength.z || fieldStrength.r != _fieldStrength.r)
+		bool changed = !_ready || fieldStrength.x != _fieldStrength.x || fieldStrength.y != _fieldStrength.y || fieldStrength.z != _fieldStrength.z || fieldStrength.r != _fieldStrength.r;
+		_ready = true;
+		_fieldStrength = fieldStrength;
+		IoT::Devices::BufferedSampleStream::Ptr pSampleStream = _pSampleStream;
+		lock.unlock();
+
+		if (pSampleStream)
+		{
+			double values[3] = {fieldStrength.x, fieldStrength.y, fieldStrength.z};
+			pSampleStream->addSample(Poco::Timestamp(), values);
+		}
+		if (changed)
 		{
-			_ready = true;
-			_fieldStrength = fieldStrength;
-			lock.unlock();
 			fieldStrengthChanged(this, fieldStrength);
 		}
 	}
 }
 
 
+void Magnetometer::setSampleStream(IoT::Devices::BufferedSampleStream::Ptr pSampleStream)
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	_pSampleStream = pSampleStream;
+}
+
+
 } } // namespace IoT::CISS
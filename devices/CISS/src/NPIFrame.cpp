@@ -78,6 +78,21 @@ void NPIFrame::swap(NPIFrame& other)
 
 
 NPIFrame::ReadStatus NPIFrame::read(NPIFrame& frame, const char* buffer, std::size_t size)
+{
+	if (size == 0) return CISS_FRAME_NOT_ENOUGH_DATA;
+
+	std::size_t offset;
+	std::size_t length;
+	ReadStatus rs = scan(buffer, size, offset, length);
+	if (rs == CISS_FRAME_OK)
+	{
+		frame.assign(buffer + offset, length);
+	}
+	return rs;
+}
+
+
+NPIFrame::ReadStatus NPIFrame::scan(const char* buffer, std::size_t size, std::size_t& offset, std::size_t& length)
 {
 	std::size_t i = 0;
 	while (i < size)
@@ -90,24 +105,46 @@ NPIFrame::ReadStatus NPIFrame::read(NPIFrame& frame, const char* buffer, std::si
 				std::size_t dataSize = static_cast<unsigned char>(buffer[i + 1]);
 				if (dataSize <= CISS_MAX_DATA_LENGTH)
 				{
-					if (i + 2 + dataSize < size) // 2 length bytes + data + checksum
+					if (i + 2 + dataSize < size) // length byte + data + checksum
 					{
-
-						NPIFrame tempFrame(buffer + i + 2, dataSize);
-						if (tempFrame.checksum() == static_cast<unsigned char>(buffer[i + 2 + dataSize]))
+						// length byte, data and checksum must XOR to 0
+						char checksum = 0;
+						const char* p = buffer + i + 1;
+						const char* end = p + dataSize + 2;
+						while (p < end) checksum ^= *p++;
+						if (checksum == 0)
 						{
-							frame.swap(tempFrame);
+							offset = i;
+							length = dataSize + 3;
 							return CISS_FRAME_OK;
 						}
 					}
-					else return CISS_FRAME_NOT_ENOUGH_DATA;
+					else
+					{
+						offset = i;
+						return CISS_FRAME_NOT_ENOUGH_DATA;
+					}
 				}
 				i++;
 			}
-			else return CISS_FRAME_NOT_ENOUGH_DATA;
+			else
+			{
+				offset = i;
+				return CISS_FRAME_NOT_ENOUGH_DATA;
+			}
 		}
 	}
-	return size == 0 ? CISS_FRAME_NOT_ENOUGH_DATA : CISS_FRAME_NOT_FOUND;
+	offset = size;
+	return CISS_FRAME_NOT_FOUND;
+}
+
+
+void NPIFrame::assign(const char* frame, std::size_t length)
+{
+	poco_assert (length >= 3 && length <= CISS_MAX_FRAME_LENGTH);
+
+	std::memcpy(_frame, frame, length);
+	_size = length;
 }
 
 
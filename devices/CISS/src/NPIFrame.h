@@ -83,6 +83,23 @@ public:
 		///     to read the entire frame. Retry again with a buffer containing more data.
 		///   - CISS_FRAME_NOT_FOUND if no valid frame was found.
 
+	static ReadStatus scan(const char* buffer, std::size_t size, std::size_t& offset, std::size_t& length);
+		/// Locates a frame in the given buffer, without copying it.
+		///
+		/// Returns:
+		///   - CISS_FRAME_OK if a valid frame was found. offset receives the
+		///     position of the frame's start delimiter, and length receives
+		///     the length of the raw frame.
+		///   - CISS_FRAME_NOT_ENOUGH_DATA if the buffer does not contain enough data
+		///     to read the entire frame. offset receives the position of
+		///     the incomplete frame; any data before it can be discarded.
+		///   - CISS_FRAME_NOT_FOUND if no valid frame was found. offset receives
+		///     the size of the buffer, as the entire data can be discarded.
+
+	void assign(const char* frame, std::size_t length);
+		/// Assigns a raw NPI frame (including start delimiter, length and
+		/// checksum), as located with scan().
+
 protected:
 	void init(const char* data, std::size_t length);
 	unsigned char checksum() const;
@@ -10,6 +10,7 @@
 
 #include "NPIPort.h"
 #include "NPIFrame.h"
+#include <cstring>
 
 
 namespace IoT {
@@ -18,7 +19,9 @@ namespace CISS {
 
 NPIPort::NPIPort(Poco::SharedPtr<Poco::Serial::SerialPort> pSerialPort):
 	_pSerialPort(pSerialPort),
-	_buffer(NPIFrame::CISS_MAX_FRAME_LENGTH)
+	_buffer(4*NPIFrame::CISS_MAX_FRAME_LENGTH),
+	_begin(0),
+	_end(0)
 {
 }
 
@@ -36,18 +39,58 @@ void NPIPort::sendFrame(const NPIFrame& frame)
 
 std::size_t NPIPort::receiveFrame(NPIFrame& frame, const Poco::Timespan& timeout)
 {
-	std::size_t n = 0;
-	NPIFrame::ReadStatus rs = NPIFrame::CISS_FRAME_NOT_FOUND;
-	do
+	std::size_t length = 0;
+	while (!extractFrame(frame, length))
 	{
-		std::size_t rd = _pSerialPort->read(_buffer.begin() + n, 1, timeout);
-		if (rd == 0) return 0;
-		n += rd;
-		rs = NPIFrame::read(frame, _buffer.begin(), n);
+		if (!_pSerialPort->poll(timeout)) return 0;
+
+		// poll() has filled the SerialPort's buffer, so
+		// this will not block.
+		_end += _pSerialPort->read(_buffer.begin() + _end, space());
+	}
+	return length;
+}
+
+
+bool NPIPort::extractFrame(NPIFrame& frame, std::size_t& length)
+{
+	std::size_t offset = 0;
+	NPIFrame::ReadStatus rs = NPIFrame::scan(_buffer.begin() + _begin, _end - _begin, offset, length);
+	if (rs == NPIFrame::CISS_FRAME_OK)
+	{
+		frame.assign(_buffer.begin() + _begin + offset, length);
+		_begin += offset + length;
+	}
+	else
+	{
+		_begin += offset;
+	}
+	if (_begin == _end)
+	{
+		_begin = _end = 0;
 	}
-	while (rs == NPIFrame::CISS_FRAME_NOT_ENOUGH_DATA && n < _buffer.size());
+	return rs == NPIFrame::CISS_FRAME_OK;
+}
 
-	return rs == NPIFrame::CISS_FRAME_OK ? n : 0;
+
+std::size_t NPIPort::space()
+{
+	if (_end == _buffer.size())
+	{
+		if (_begin > 0)
+		{
+			// move the incomplete frame to the start of the buffer
+			std::memmove(_buffer.begin(), _buffer.begin() + _begin, _end - _begin);
+			_end -= _begin;
+			_begin = 0;
+		}
+		else
+		{
+			// the buffer is full, but does not contain a valid frame
+			_end = 0;
+		}
+	}
+	return _buffer.size() - _end;
 }
 
 
@@ -30,6 +30,10 @@ class NPIFrame;
 class NPIPort
 	/// This class provides an interface to a CISS node
 	/// over USB using the NPI protocol.
+	///
+	/// Received data is kept in an internal buffer, from which
+	/// frames are decoded in place. Data following a frame
+	/// is retained for the next call to receiveFrame().
 {
 public:
 	typedef Poco::SharedPtr<NPIPort> Ptr;
@@ -51,6 +55,9 @@ public:
 		///
 		/// Returns the number of bytes received, which may be 0 if the
 		/// receive operation times out.
+		///
+		/// The timeout only applies if no complete frame is
+		/// already in the internal buffer.
 
 	bool poll(const Poco::Timespan& timeout);
 		/// Waits for data to arrive at the port.
@@ -64,8 +71,13 @@ private:
 	NPIPort(const NPIPort&);
 	NPIPort& operator = (const NPIPort&);
 
+	bool extractFrame(NPIFrame& frame, std::size_t& length);
+	std::size_t space();
+
 	Poco::SharedPtr<Poco::Serial::SerialPort> _pSerialPort;
 	Poco::Buffer<char> _buffer;
+	std::size_t _begin;
+	std::size_t _end;
 };
 
 
@@ -74,7 +86,7 @@ private:
 //
 inline bool NPIPort::poll(const Poco::Timespan& timeout)
 {
-	return _pSerialPort->poll(timeout);
+	return _begin < _end || _pSerialPort->poll(timeout);
 }
 
 
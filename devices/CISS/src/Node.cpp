@@ -15,7 +15,51 @@
 #include "NPIFrame.h"
 #include "Poco/MemoryStream.h"
 #include "Poco/BinaryWriter.h"
-#include "Poco/BinaryReader.h"
+#include "Poco/ByteOrder.h"
+#include "Poco/Exception.h"
+#include <cstring>
+
+
+namespace
+{
+	class PayloadReader
+		/// Decodes little-endian fields directly from
+		/// the payload of a received NPIFrame.
+	{
+	public:
+		PayloadReader(const IoT::CISS::NPIFrame& frame):
+			_pCur(frame.payload()),
+			_pEnd(frame.payload() + frame.payloadSize())
+		{
+		}
+
+		PayloadReader& operator >> (Poco::UInt8& value)
+		{
+			if (available() < 1) throw Poco::DataFormatException("Truncated NPI frame");
+			value = static_cast<Poco::UInt8>(*_pCur++);
+			return *this;
+		}
+
+		template <typename T>
+		PayloadReader& operator >> (T& value)
+		{
+			if (available() < sizeof(T)) throw Poco::DataFormatException("Truncated NPI frame");
+			std::memcpy(&value, _pCur, sizeof(T));
+			value = Poco::ByteOrder::fromLittleEndian(value);
+			_pCur += sizeof(T);
+			return *this;
+		}
+
+		std::size_t available() const
+		{
+			return static_cast<std::size_t>(_pEnd - _pCur);
+		}
+
+	private:
+		const char* _pCur;
+		const char* _pEnd;
+	};
+}
 
 
 namespace IoT {
@@ -89,6 +133,7 @@ void Node::enableSensorImpl(Poco::UInt8 sensorId, bool enable)
 	};
 	NPIFrame frame(payload, 2);
 
+	_responseReceived.reset();
 	_pPort->sendFrame(frame);
 	_responseReceived.wait(CISS_COMMAND_TIMEOUT);
 	if (!_lastCommandOK) throw Poco::IOException("Failed to enable sensor");
@@ -159,6 +204,7 @@ void Node::setSamplingInterval(Poco::UInt8 sensorId, Poco::UInt32 interval)
 	NPIFrame frame(payload, sizeof(payload));
 
 	Poco::FastMutex::ScopedLock lock(_mutex);
+	_responseReceived.reset();
 	_pPort->sendFrame(frame);
 	_responseReceived.wait(CISS_COMMAND_TIMEOUT);
 	if (!_lastCommandOK) throw Poco::IOException("Failed to set sampling interval");
@@ -180,6 +226,7 @@ void Node::setEnvironmentalSamplingInterval(Poco::UInt8 sensorId, Poco::UInt16 i
 	NPIFrame frame(payload, sizeof(payload));
 
 	Poco::FastMutex::ScopedLock lock(_mutex);
+	_responseReceived.reset();
 	_pPort->sendFrame(frame);
 	_responseReceived.wait(CISS_COMMAND_TIMEOUT);
 	if (!_lastCommandOK) throw Poco::IOException("Failed to set sampling interval");
@@ -204,6 +251,7 @@ void Node::setAccelerometerRange(Poco::UInt8 rangeInGs)
 	NPIFrame frame(payload, sizeof(payload));
 
 	Poco::FastMutex::ScopedLock lock(_mutex);
+	_responseReceived.reset();
 	_pPort->sendFrame(frame);
 	_responseReceived.wait(CISS_COMMAND_TIMEOUT);
 	if (!_lastCommandOK) throw Poco::IOException("Failed to set accelerometer range");
@@ -212,13 +260,12 @@ void Node::setAccelerometerRange(Poco::UInt8 rangeInGs)
 
 void Node::handleFrame(const NPIFrame& frame)
 {
-	Poco::MemoryInputStream istr(frame.payload(), frame.payloadSize());
-	Poco::BinaryReader reader(istr, Poco::BinaryReader::LITTLE_ENDIAN_BYTE_ORDER);
+	PayloadReader reader(frame);
 	bool done = false;
-	Poco::UInt8 type;
-	reader >> type;
-	while (!istr.eof() && !done)
+	while (!done && reader.available() > 0)
 	{
+		Poco::UInt8 type;
+		reader >> type;
 		switch (type)
 		{
 		case CISS_OK:
@@ -309,7 +356,6 @@ void Node::handleFrame(const NPIFrame& frame)
 				static_cast<unsigned>(frame.type()), frame.frameSize());
 			break;
 		}
-		reader >> type;
 	}
 }
 
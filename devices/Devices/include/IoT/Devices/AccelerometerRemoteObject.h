@@ -48,6 +48,24 @@ public:
 		/// Returns true if the feature with the given name
 		/// is enabled, or false otherwise.
 
+	std::vector < IoT::Devices::DeviceProperty > getProperties(const std::vector < std::string >& names) const;
+		/// Returns the values of the device properties with
+		/// the given names, in the given order.
+		///
+		/// Unlike the getProperty*() methods, this method does not
+		/// throw if a property is unknown or cannot be read. Instead,
+		/// the type of the respective element is set to
+		/// DEVICE_PROPERTY_UNKNOWN.
+		///
+		/// Reading multiple properties with a single call is
+		/// considerably faster for a remote device (or a device
+		/// accessed from JavaScript) than calling the getProperty*()
+		/// methods for each property.
+		///
+		/// The default implementation calls the getProperty*()
+		/// methods and is meant to be overridden; DeviceImpl
+		/// provides an efficient implementation.
+
 	virtual bool getPropertyBool(const std::string& name) const;
 		/// Returns the value of the device property with
 		/// the given name.
@@ -122,6 +140,14 @@ public:
 		/// Which properties are supported is defined by the
 		/// actual device implementation.
 
+	std::vector < IoT::Devices::DeviceProperty > snapshot() const;
+		/// Returns the values of all readable device properties.
+		///
+		/// The default implementation returns the properties
+		/// every device should expose (symbolicName, type, name
+		/// and status), if available. DeviceImpl returns all
+		/// properties added with DeviceImpl::addProperty().
+
 protected:
 	void event__accelerationChanged(const IoT::Devices::Acceleration& data);
 
@@ -142,6 +168,12 @@ inline bool AccelerometerRemoteObject::getFeature(const std::string& name) const
 }
 
 
+inline std::vector < IoT::Devices::DeviceProperty > AccelerometerRemoteObject::getProperties(const std::vector < std::string >& names) const
+{
+	return _pServiceObject->getProperties(names);
+}
+
+
 inline bool AccelerometerRemoteObject::getPropertyBool(const std::string& name) const
 {
 	return _pServiceObject->getPropertyBool(name);
@@ -214,6 +246,12 @@ inline void AccelerometerRemoteObject::setPropertyString(const std::string& name
 }
 
 
+inline std::vector < IoT::Devices::DeviceProperty > AccelerometerRemoteObject::snapshot() const
+{
+	return _pServiceObject->snapshot();
+}
+
+
 } // namespace Devices
 } // namespace IoT
 
@@ -0,0 +1,159 @@
+//
+// BufferedSampleStream.h
+//
+// Library: IoT/Devices
+// Package: Devices
+// Module:  BufferedSampleStream
+//
+// Definition of the BufferedSampleStream class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Devices_BufferedSampleStream_INCLUDED
+#define IoT_Devices_BufferedSampleStream_INCLUDED
+
+
+#include "IoT/Devices/SampleStream.h"
+#include "IoT/Devices/SampleBuffer.h"
+#include "IoT/Devices/DeviceImpl.h"
+#include "Poco/Util/Timer.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Mutex.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+class IoTDevices_API BufferedSampleStream: public DeviceImpl<SampleStream, BufferedSampleStream>
+	/// A generic SampleStream implementation based on a SampleBuffer.
+	///
+	/// A device driver creates a BufferedSampleStream for every
+	/// high-rate sensor and passes each new sample to addSample(),
+	/// in addition to (or instead of) updating the sensor itself.
+	///
+	/// If a timer is given in Params, an incomplete block is also
+	/// delivered when the sensor stops producing samples, as soon
+	/// as its first sample is older than blockLatency.
+	///
+	/// Blocks are always delivered in order, even if samples
+	/// are added by different threads.
+	///
+	/// The following properties are supported:
+	///   - name, symbolicName, deviceIdentifier, physicalQuantity,
+	///     physicalUnit (read-only, as given in Params)
+	///   - type (read-only, "io.macchina.sampleStream")
+	///   - blockSize (int): maximum number of samples per block
+	///   - blockLatency (int): maximum age of the first sample in
+	///     a block, in milliseconds; 0 disables the latency limit
+	///   - bufferSize (int, read-only): number of samples kept for
+	///     late subscribers.
+{
+public:
+	typedef Poco::SharedPtr<BufferedSampleStream> Ptr;
+
+	struct Params
+	{
+		Params():
+			blockSize(DEFAULT_BLOCK_SIZE),
+			blockLatency(DEFAULT_BLOCK_LATENCY),
+			bufferSize(DEFAULT_BUFFER_SIZE)
+		{
+		}
+
+		std::string name;
+		std::string symbolicName;
+		std::string deviceIdentifier;
+		std::string physicalQuantity;
+		std::string physicalUnit;
+		std::vector<std::string> channelNames;
+		int blockSize;
+		int blockLatency;
+		int bufferSize;
+		Poco::SharedPtr<Poco::Util::Timer> pTimer;
+			/// Optional timer used for delivering incomplete
+			/// blocks once blockLatency has expired.
+	};
+
+	enum
+	{
+		DEFAULT_BLOCK_SIZE    = 32,
+		DEFAULT_BLOCK_LATENCY = 250,
+		DEFAULT_BUFFER_SIZE   = 1024
+	};
+
+	explicit BufferedSampleStream(const Params& params);
+		/// Creates the BufferedSampleStream.
+		/// The number of channels is given by the number of
+		/// channel names in params.
+		///
+		/// Throws a Poco::InvalidArgumentException if there are
+		/// no channel names, if blockSize is less than 1, or if
+		/// blockLatency or bufferSize is negative.
+
+	~BufferedSampleStream();
+		/// Destroys the BufferedSampleStream.
+
+	void addSample(const Poco::Timestamp& timestamp, const double* values);
+		/// Adds a sample consisting of channels() values.
+		/// Fires samplesAvailable if the current block is complete.
+
+	void flush();
+		/// Fires samplesAvailable with all samples not yet delivered.
+
+	void flushExpired();
+		/// Fires samplesAvailable with all samples not yet delivered
+		/// if the first of them is older than blockLatency.
+		///
+		/// Called periodically if a timer has been given in Params.
+
+	// SampleStream
+	int channels() const;
+	std::vector<std::string> channelNames() const;
+	SampleBlock recentSamples(Poco::Int64 sequence) const;
+
+	static const std::string TYPE;
+
+protected:
+	class FlushTarget;
+	class FlushTask;
+
+	void deliver(bool expiredOnly);
+	void scheduleFlush(Poco::Timestamp::TimeDiff blockLatency);
+	Poco::Any getName(const std::string&) const;
+	Poco::Any getType(const std::string&) const;
+	Poco::Any getSymbolicName(const std::string&) const;
+	Poco::Any getDeviceIdentifier(const std::string&) const;
+	Poco::Any getPhysicalQuantity(const std::string&) const;
+	Poco::Any getPhysicalUnit(const std::string&) const;
+	Poco::Any getBlockSize(const std::string&) const;
+	void setBlockSize(const std::string&, const Poco::Any& value);
+	Poco::Any getBlockLatency(const std::string&) const;
+	void setBlockLatency(const std::string&, const Poco::Any& value);
+	Poco::Any getBufferSize(const std::string&) const;
+
+private:
+	Poco::Any _name;
+	Poco::Any _symbolicName;
+	Poco::Any _deviceIdentifier;
+	Poco::Any _physicalQuantity;
+	Poco::Any _physicalUnit;
+	std::vector<std::string> _channelNames;
+	SampleBuffer _buffer;
+	Poco::SharedPtr<Poco::Util::Timer> _pTimer;
+	Poco::AutoPtr<FlushTarget> _pFlushTarget;
+	Poco::Util::TimerTask::Ptr _pFlushTask;
+	Poco::Mutex _deliveryMutex;
+};
+
+
+} } // namespace IoT::Devices
+
+
+#endif // IoT_Devices_BufferedSampleStream_INCLUDED
@@ -48,6 +48,24 @@ public:
 		/// Returns true if the feature with the given name
 		/// is enabled, or false otherwise.
 
+	std::vector < IoT::Devices::DeviceProperty > getProperties(const std::vector < std::string >& names) const;
+		/// Returns the values of the device properties with
+		/// the given names, in the given order.
+		///
+		/// Unlike the getProperty*() methods, this method does not
+		/// throw if a property is unknown or cannot be read. Instead,
+		/// the type of the respective element is set to
+		/// DEVICE_PROPERTY_UNKNOWN.
+		///
+		/// Reading multiple properties with a single call is
+		/// considerably faster for a remote device (or a device
+		/// accessed from JavaScript) than calling the getProperty*()
+		/// methods for each property.
+		///
+		/// The default implementation calls the getProperty*()
+		/// methods and is meant to be overridden; DeviceImpl
+		/// provides an efficient implementation.
+
 	virtual bool getPropertyBool(const std::string& name) const;
 		/// Returns the value of the device property with
 		/// the given name.
@@ -126,6 +144,14 @@ public:
 		/// Which properties are supported is defined by the
 		/// actual device implementation.
 
+	std::vector < IoT::Devices::DeviceProperty > snapshot() const;
+		/// Returns the values of all readable device properties.
+		///
+		/// The default implementation returns the properties
+		/// every device should expose (symbolicName, type, name
+		/// and status), if available. DeviceImpl returns all
+		/// properties added with DeviceImpl::addProperty().
+
 protected:
 	void event__countChanged(const Poco::Int32& data);
 
@@ -146,6 +172,12 @@ inline bool CounterRemoteObject::getFeature(const std::string& name) const
 }
 
 
+inline std::vector < IoT::Devices::DeviceProperty > CounterRemoteObject::getProperties(const std::vector < std::string >& names) const
+{
+	return _pServiceObject->getProperties(names);
+}
+
+
 inline bool CounterRemoteObject::getPropertyBool(const std::string& name) const
 {
 	return _pServiceObject->getPropertyBool(name);
@@ -224,6 +256,12 @@ inline void CounterRemoteObject::setPropertyString(const std::string& name, cons
 }
 
 
+inline std::vector < IoT::Devices::DeviceProperty > CounterRemoteObject::snapshot() const
+{
+	return _pServiceObject->snapshot();
+}
+
+
 } // namespace Devices
 } // namespace IoT
 
@@ -20,6 +20,7 @@
 
 #include "IoT/Devices/Devices.h"
 #include "Poco/BasicEvent.h"
+#include <vector>
 
 
 namespace IoT {
@@ -46,6 +47,33 @@ struct DeviceStatusChange
 };
 
 
+enum DevicePropertyType
+	/// Type of a property value returned by Device::getProperties().
+{
+	DEVICE_PROPERTY_UNKNOWN = 0, /// The property is not supported or cannot be read.
+	DEVICE_PROPERTY_STRING  = 1, /// The property value is a string (stringValue).
+	DEVICE_PROPERTY_INT     = 2, /// The property value is an int (intValue).
+	DEVICE_PROPERTY_DOUBLE  = 3, /// The property value is a double (doubleValue).
+	DEVICE_PROPERTY_BOOL    = 4  /// The property value is a bool (boolValue).
+};
+
+
+//@ serialize
+struct DeviceProperty
+	/// Name, type and value of a device property,
+	/// as returned by Device::getProperties().
+	///
+	/// Only the value member corresponding to type is valid.
+{
+	std::string name;         /// Name of the property
+	DevicePropertyType type;  /// Type of the property value
+	std::string stringValue;  /// Value of a string property
+	int intValue;             /// Value of an int property
+	double doubleValue;       /// Value of a double property
+	bool boolValue;           /// Value of a bool property
+};
+
+
 //@ remote
 class IoTDevices_API Device
 	/// The base class for all devices and sensors.
@@ -151,6 +179,32 @@ public:
 		/// Returns true if the property with the given name
 		/// exists, or false otherwise.
 
+	virtual std::vector<DeviceProperty> getProperties(const std::vector<std::string>& names) const;
+		/// Returns the values of the device properties with
+		/// the given names, in the given order.
+		///
+		/// Unlike the getProperty*() methods, this method does not
+		/// throw if a property is unknown or cannot be read. Instead,
+		/// the type of the respective element is set to
+		/// DEVICE_PROPERTY_UNKNOWN.
+		///
+		/// Reading multiple properties with a single call is
+		/// considerably faster for a remote device (or a device
+		/// accessed from JavaScript) than calling the getProperty*()
+		/// methods for each property.
+		///
+		/// The default implementation calls the getProperty*()
+		/// methods and is meant to be overridden; DeviceImpl
+		/// provides an efficient implementation.
+
+	virtual std::vector<DeviceProperty> snapshot() const;
+		/// Returns the values of all readable device properties.
+		///
+		/// The default implementation returns the properties
+		/// every device should expose (symbolicName, type, name
+		/// and status), if available. DeviceImpl returns all
+		/// properties added with DeviceImpl::addProperty().
+
 	virtual void setFeature(const std::string& name, bool enable) = 0;
 		/// Enables or disables the feature with the given name.
 		///
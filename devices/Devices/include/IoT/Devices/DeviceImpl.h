@@ -20,9 +20,11 @@
 
 #include "IoT/Devices/Device.h"
 #include "IoT/Devices/DeviceException.h"
+#include "IoT/Devices/NameTable.h"
 #include "Poco/Mutex.h"
 #include "Poco/Any.h"
-#include <map>
+#include <vector>
+#include <typeinfo>
 
 
 namespace IoT {
@@ -32,6 +34,24 @@ namespace Devices {
 template <class Super, class Sub>
 class DeviceImpl: public Super
 	/// A helper class for implementing device features and properties.
+	///
+	/// Features and properties are registered with addFeature() and
+	/// addProperty(), usually in the constructor of the subclass.
+	/// A property getter and setter either pass the value as a Poco::Any,
+	/// or use one of the property types (std::string, int, double, bool)
+	/// directly. The typed variants avoid boxing the value into a Poco::Any
+	/// if the property is read or written with the matching typed
+	/// accessor (e.g., getPropertyDouble()), or with getProperties()
+	/// and snapshot().
+	///
+	/// Every feature and property is assigned a dense index when it is
+	/// registered. Code that repeatedly accesses the same property can
+	/// obtain a handle for it with propertyHandle() or featureHandle()
+	/// once, and then use the accessors taking a handle, which skip
+	/// the lookup by name.
+	///
+	/// All getters and setters are called with the device's mutex
+	/// locked.
 {
 public:
 	typedef void (Sub::*FeatureSetter)(const std::string&, bool);
@@ -46,120 +66,296 @@ public:
 	typedef Poco::Any (Sub::*PropertyGetter)(const std::string&) const;
 		/// The getter method for a property.
 
+	typedef void (Sub::*StringPropertySetter)(const std::string&, const std::string&);
+		/// The setter method for a string property.
+
+	typedef std::string (Sub::*StringPropertyGetter)(const std::string&) const;
+		/// The getter method for a string property.
+
+	typedef void (Sub::*IntPropertySetter)(const std::string&, int);
+		/// The setter method for an int property.
+
+	typedef int (Sub::*IntPropertyGetter)(const std::string&) const;
+		/// The getter method for an int property.
+
+	typedef void (Sub::*DoublePropertySetter)(const std::string&, double);
+		/// The setter method for a double property.
+
+	typedef double (Sub::*DoublePropertyGetter)(const std::string&) const;
+		/// The getter method for a double property.
+
+	typedef void (Sub::*BoolPropertySetter)(const std::string&, bool);
+		/// The setter method for a bool property.
+
+	typedef bool (Sub::*BoolPropertyGetter)(const std::string&) const;
+		/// The getter method for a bool property.
+
+	struct PropertyHandle
+		/// Identifies a property of a device.
+		/// A PropertyHandle is only valid for the
+		/// device it has been obtained from.
+	{
+		explicit PropertyHandle(std::size_t i): index(i) { }
+
+		std::size_t index;
+	};
+
+	struct FeatureHandle
+		/// Identifies a feature of a device.
+		/// A FeatureHandle is only valid for the
+		/// device it has been obtained from.
+	{
+		explicit FeatureHandle(std::size_t i): index(i) { }
+
+		std::size_t index;
+	};
+
 	void setPropertyString(const std::string& name, const std::string& value)
 	{
-		setProperty(name, value);
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		writeStringProperty(findProperty(name), value);
 	}
 	
 	std::string getPropertyString(const std::string& name) const
 	{
-		return Poco::AnyCast<std::string>(getProperty(name));
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return readStringProperty(findProperty(name));
 	}
 
 	void setPropertyInt(const std::string& name, int value)
 	{
-		setProperty(name, value);
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		writeIntProperty(findProperty(name), value);
 	}
 	
 	int getPropertyInt(const std::string& name) const
 	{
-		return Poco::AnyCast<int>(getProperty(name));
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return readIntProperty(findProperty(name));
 	}
 
 	void setPropertyDouble(const std::string& name, double value)
 	{
-		setProperty(name, value);
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		writeDoubleProperty(findProperty(name), value);
 	}
 	
 	double getPropertyDouble(const std::string& name) const
 	{
-		return Poco::AnyCast<double>(getProperty(name));
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return readDoubleProperty(findProperty(name));
 	}
 
 	void setPropertyBool(const std::string& name, bool value)
 	{
-		setProperty(name, value);
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		writeBoolProperty(findProperty(name), value);
 	}
 	
 	bool getPropertyBool(const std::string& name) const
 	{
-		return Poco::AnyCast<bool>(getProperty(name));
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return readBoolProperty(findProperty(name));
 	}
 
 	void setProperty(const std::string& name, const Poco::Any& value)
 	{
 		Poco::Mutex::ScopedLock lock(_mutex);
 
-		typename PropertyMap::const_iterator it = _properties.find(name);
-		if (it != _properties.end())
-		{
-			if (it->second.setter)
-				(static_cast<Sub*>(this)->*it->second.setter)(name, value);
-			else
-				throw NotWritableException(name);
-		}
-		else throw NotSupportedException(name);
+		writeProperty(findProperty(name), value);
 	}
 		
 	Poco::Any getProperty(const std::string& name) const
 	{
 		Poco::Mutex::ScopedLock lock(_mutex);
 
-		typename PropertyMap::const_iterator it = _properties.find(name);
-		if (it != _properties.end())
-		{
-			if (it->second.getter)
-				return (static_cast<const Sub*>(this)->*it->second.getter)(name);
-			else
-				throw NotReadableException(name);
-		}
-		else throw NotSupportedException(name);
+		return readProperty(findProperty(name));
 	}
 		
 	bool hasProperty(const std::string& name) const
 	{
 		Poco::Mutex::ScopedLock lock(_mutex);
 
-		typename PropertyMap::const_iterator it = _properties.find(name);
-		return it != _properties.end();
+		return _propertyNames.find(name) != NameTable::NOT_FOUND;
 	}
-			
-	void setFeature(const std::string& name, bool enable)
+
+	PropertyHandle propertyHandle(const std::string& name) const
+		/// Returns the handle for the property with the given name.
+		///
+		/// Throws a NotSupportedException if the property
+		/// is unknown.
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return PropertyHandle(findProperty(name));
+	}
+
+	void setPropertyString(PropertyHandle handle, const std::string& value)
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		writeStringProperty(checkProperty(handle), value);
+	}
+	
+	std::string getPropertyString(PropertyHandle handle) const
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return readStringProperty(checkProperty(handle));
+	}
+
+	void setPropertyInt(PropertyHandle handle, int value)
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		writeIntProperty(checkProperty(handle), value);
+	}
+	
+	int getPropertyInt(PropertyHandle handle) const
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return readIntProperty(checkProperty(handle));
+	}
+
+	void setPropertyDouble(PropertyHandle handle, double value)
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		writeDoubleProperty(checkProperty(handle), value);
+	}
+	
+	double getPropertyDouble(PropertyHandle handle) const
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return readDoubleProperty(checkProperty(handle));
+	}
+
+	void setPropertyBool(PropertyHandle handle, bool value)
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		writeBoolProperty(checkProperty(handle), value);
+	}
+	
+	bool getPropertyBool(PropertyHandle handle) const
 	{
 		Poco::Mutex::ScopedLock lock(_mutex);
 
-		typename FeatureMap::const_iterator it = _features.find(name);
-		if (it != _features.end())
+		return readBoolProperty(checkProperty(handle));
+	}
+
+	void setProperty(PropertyHandle handle, const Poco::Any& value)
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		writeProperty(checkProperty(handle), value);
+	}
+		
+	Poco::Any getProperty(PropertyHandle handle) const
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return readProperty(checkProperty(handle));
+	}
+
+	std::vector<DeviceProperty> getProperties(const std::vector<std::string>& names) const
+	{
+		std::vector<DeviceProperty> properties(names.size());
+
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		for (std::size_t i = 0; i < names.size(); i++)
 		{
-			if (it->second.setter)
-				(static_cast<Sub*>(this)->*it->second.setter)(name, enable);
+			std::size_t index = _propertyNames.find(names[i]);
+			if (index != NameTable::NOT_FOUND)
+			{
+				readProperty(index, properties[i]);
+			}
 			else
-				throw NotWritableException(name);
+			{
+				properties[i].name = names[i];
+				properties[i].type = DEVICE_PROPERTY_UNKNOWN;
+				properties[i].intValue = 0;
+				properties[i].doubleValue = 0.0;
+				properties[i].boolValue = false;
+			}
 		}
-		else throw NotSupportedException(name);
+		return properties;
 	}
-	
-	bool getFeature(const std::string& name) const
+
+	std::vector<DeviceProperty> snapshot() const
+		/// Returns the values of all readable properties,
+		/// in the order the properties have been added.
 	{
 		Poco::Mutex::ScopedLock lock(_mutex);
 
-		typename FeatureMap::const_iterator it = _features.find(name);
-		if (it != _features.end())
+		std::vector<DeviceProperty> properties;
+		properties.reserve(_properties.size());
+		for (std::size_t index = 0; index < _properties.size(); index++)
 		{
-			if (it->second.getter)
-				return (static_cast<const Sub*>(this)->*it->second.getter)(name);
-			else
-				throw NotReadableException(name);
+			if (_properties[index].readable())
+			{
+				properties.push_back(DeviceProperty());
+				readProperty(index, properties.back());
+			}
 		}
-		else throw NotSupportedException(name);
+		return properties;
+	}
+			
+	void setFeature(const std::string& name, bool enable)
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		writeFeature(findFeature(name), enable);
+	}
+	
+	bool getFeature(const std::string& name) const
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return readFeature(findFeature(name));
 	}
 	
 	bool hasFeature(const std::string& name) const
 	{
 		Poco::Mutex::ScopedLock lock(_mutex);
 
-		typename FeatureMap::const_iterator it = _features.find(name);
-		return it != _features.end();
+		return _featureNames.find(name) != NameTable::NOT_FOUND;
+	}
+
+	FeatureHandle featureHandle(const std::string& name) const
+		/// Returns the handle for the feature with the given name.
+		///
+		/// Throws a NotSupportedException if the feature
+		/// is unknown.
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return FeatureHandle(findFeature(name));
+	}
+
+	void setFeature(FeatureHandle handle, bool enable)
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		writeFeature(checkFeature(handle), enable);
+	}
+	
+	bool getFeature(FeatureHandle handle) const
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		return readFeature(checkFeature(handle));
 	}
 	
 protected:
@@ -169,10 +365,12 @@ protected:
 		/// The setter or getter can be null, in case setting or getting a feature
 		/// is not supported.
 	{
-		Feature feature;
-		feature.getter = getter;
-		feature.setter = setter;
-		_features[name] = feature;
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		std::size_t index = _featureNames.add(name);
+		if (index == _features.size()) _features.push_back(Feature());
+		_features[index].getter = getter;
+		_features[index].setter = setter;
 	}
 		
 	void addProperty(const std::string& name, PropertyGetter getter, PropertySetter setter = 0)
@@ -181,29 +379,370 @@ protected:
 		/// The setter or getter can be null, in case setting or getting a property
 		/// is not supported.
 	{
-		Property property;
+		Property& property = newProperty(name, DEVICE_PROPERTY_UNKNOWN);
 		property.getter = getter;
 		property.setter = setter;
-		_properties[name] = property;
+	}
+
+	void addProperty(const std::string& name, StringPropertyGetter getter, StringPropertySetter setter = 0)
+		/// Adds a string property to the map of supported properties.
+		///
+		/// The setter or getter can be null, in case setting or getting a property
+		/// is not supported.
+	{
+		Property& property = newProperty(name, DEVICE_PROPERTY_STRING);
+		property.stringGetter = getter;
+		property.stringSetter = setter;
+	}
+
+	void addProperty(const std::string& name, IntPropertyGetter getter, IntPropertySetter setter = 0)
+		/// Adds an int property to the map of supported properties.
+		///
+		/// The setter or getter can be null, in case setting or getting a property
+		/// is not supported.
+	{
+		Property& property = newProperty(name, DEVICE_PROPERTY_INT);
+		property.intGetter = getter;
+		property.intSetter = setter;
+	}
+
+	void addProperty(const std::string& name, DoublePropertyGetter getter, DoublePropertySetter setter = 0)
+		/// Adds a double property to the map of supported properties.
+		///
+		/// The setter or getter can be null, in case setting or getting a property
+		/// is not supported.
+	{
+		Property& property = newProperty(name, DEVICE_PROPERTY_DOUBLE);
+		property.doubleGetter = getter;
+		property.doubleSetter = setter;
+	}
+
+	void addProperty(const std::string& name, BoolPropertyGetter getter, BoolPropertySetter setter = 0)
+		/// Adds a bool property to the map of supported properties.
+		///
+		/// The setter or getter can be null, in case setting or getting a property
+		/// is not supported.
+	{
+		Property& property = newProperty(name, DEVICE_PROPERTY_BOOL);
+		property.boolGetter = getter;
+		property.boolSetter = setter;
 	}
 
 	struct Feature
 	{
+		Feature():
+			setter(0),
+			getter(0)
+		{
+		}
+
 		FeatureSetter setter;
 		FeatureGetter getter;
 	};
 	
 	struct Property
 	{
+		Property():
+			type(DEVICE_PROPERTY_UNKNOWN),
+			setter(0),
+			getter(0),
+			stringSetter(0),
+			stringGetter(0),
+			intSetter(0),
+			intGetter(0),
+			doubleSetter(0),
+			doubleGetter(0),
+			boolSetter(0),
+			boolGetter(0)
+		{
+		}
+
+		bool readable() const
+		{
+			return getter || stringGetter || intGetter || doubleGetter || boolGetter;
+		}
+
+		bool writable() const
+		{
+			return setter || stringSetter || intSetter || doubleSetter || boolSetter;
+		}
+
+		int type;
+			/// The DevicePropertyType of the typed getter and setter,
+			/// or DEVICE_PROPERTY_UNKNOWN if getter and setter
+			/// use Poco::Any.
+
 		PropertySetter setter;
 		PropertyGetter getter;
+		StringPropertySetter stringSetter;
+		StringPropertyGetter stringGetter;
+		IntPropertySetter intSetter;
+		IntPropertyGetter intGetter;
+		DoublePropertySetter doubleSetter;
+		DoublePropertyGetter doubleGetter;
+		BoolPropertySetter boolSetter;
+		BoolPropertyGetter boolGetter;
 	};
 	
-	typedef std::map<std::string, Feature>  FeatureMap;
-	typedef std::map<std::string, Property> PropertyMap;
-	
-	FeatureMap  _features;
-	PropertyMap _properties;
+	typedef std::vector<Feature>  FeatureVec;
+	typedef std::vector<Property> PropertyVec;
+
+	Property& newProperty(const std::string& name, int type)
+		/// Adds or replaces the property with the given name
+		/// and returns it.
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		std::size_t index = _propertyNames.add(name);
+		if (index == _properties.size()) _properties.push_back(Property());
+		_properties[index] = Property();
+		_properties[index].type = type;
+		return _properties[index];
+	}
+
+	std::size_t findProperty(const std::string& name) const
+		/// Returns the index of the property with the given name.
+		/// Throws a NotSupportedException if the property is unknown.
+		///
+		/// The mutex must be locked.
+	{
+		std::size_t index = _propertyNames.find(name);
+		if (index == NameTable::NOT_FOUND) throw NotSupportedException(name);
+		return index;
+	}
+
+	std::size_t checkProperty(PropertyHandle handle) const
+		/// Returns the index of the property with the given handle.
+		///
+		/// The mutex must be locked.
+	{
+		if (handle.index >= _properties.size()) throw Poco::InvalidArgumentException("invalid property handle");
+		return handle.index;
+	}
+
+	std::size_t findFeature(const std::string& name) const
+		/// Returns the index of the feature with the given name.
+		/// Throws a NotSupportedException if the feature is unknown.
+		///
+		/// The mutex must be locked.
+	{
+		std::size_t index = _featureNames.find(name);
+		if (index == NameTable::NOT_FOUND) throw NotSupportedException(name);
+		return index;
+	}
+
+	std::size_t checkFeature(FeatureHandle handle) const
+		/// Returns the index of the feature with the given handle.
+		///
+		/// The mutex must be locked.
+	{
+		if (handle.index >= _features.size()) throw Poco::InvalidArgumentException("invalid feature handle");
+		return handle.index;
+	}
+
+	void writeFeature(std::size_t index, bool enable)
+	{
+		const Feature& feature = _features[index];
+		if (feature.setter)
+			(static_cast<Sub*>(this)->*feature.setter)(_featureNames.name(index), enable);
+		else
+			throw NotWritableException(_featureNames.name(index));
+	}
+
+	bool readFeature(std::size_t index) const
+	{
+		const Feature& feature = _features[index];
+		if (feature.getter)
+			return (static_cast<const Sub*>(this)->*feature.getter)(_featureNames.name(index));
+		else
+			throw NotReadableException(_featureNames.name(index));
+	}
+
+	void writeProperty(std::size_t index, const Poco::Any& value)
+		/// Sets the value of the property with the given index.
+		/// For a typed property, the value is unboxed.
+	{
+		const Property& property = _properties[index];
+		const std::string& name = _propertyNames.name(index);
+		Sub* pSub = static_cast<Sub*>(this);
+		if (property.setter)
+			(pSub->*property.setter)(name, value);
+		else if (property.stringSetter)
+			(pSub->*property.stringSetter)(name, Poco::RefAnyCast<std::string>(value));
+		else if (property.intSetter)
+			(pSub->*property.intSetter)(name, Poco::AnyCast<int>(value));
+		else if (property.doubleSetter)
+			(pSub->*property.doubleSetter)(name, Poco::AnyCast<double>(value));
+		else if (property.boolSetter)
+			(pSub->*property.boolSetter)(name, Poco::AnyCast<bool>(value));
+		else
+			throw NotWritableException(name);
+	}
+
+	Poco::Any readProperty(std::size_t index) const
+		/// Returns the value of the property with the given index.
+		/// For a typed property, the value is boxed.
+	{
+		const Property& property = _properties[index];
+		const std::string& name = _propertyNames.name(index);
+		const Sub* pSub = static_cast<const Sub*>(this);
+		if (property.getter)
+			return (pSub->*property.getter)(name);
+		else if (property.stringGetter)
+			return (pSub->*property.stringGetter)(name);
+		else if (property.intGetter)
+			return (pSub->*property.intGetter)(name);
+		else if (property.doubleGetter)
+			return (pSub->*property.doubleGetter)(name);
+		else if (property.boolGetter)
+			return (pSub->*property.boolGetter)(name);
+		else
+			throw NotReadableException(name);
+	}
+
+	void writeStringProperty(std::size_t index, const std::string& value)
+	{
+		const Property& property = _properties[index];
+		if (property.stringSetter)
+			(static_cast<Sub*>(this)->*property.stringSetter)(_propertyNames.name(index), value);
+		else
+			writeProperty(index, value);
+	}
+
+	std::string readStringProperty(std::size_t index) const
+	{
+		const Property& property = _properties[index];
+		if (property.stringGetter)
+			return (static_cast<const Sub*>(this)->*property.stringGetter)(_propertyNames.name(index));
+		else
+			return Poco::AnyCast<std::string>(readProperty(index));
+	}
+
+	void writeIntProperty(std::size_t index, int value)
+	{
+		const Property& property = _properties[index];
+		if (property.intSetter)
+			(static_cast<Sub*>(this)->*property.intSetter)(_propertyNames.name(index), value);
+		else
+			writeProperty(index, value);
+	}
+
+	int readIntProperty(std::size_t index) const
+	{
+		const Property& property = _properties[index];
+		if (property.intGetter)
+			return (static_cast<const Sub*>(this)->*property.intGetter)(_propertyNames.name(index));
+		else
+			return Poco::AnyCast<int>(readProperty(index));
+	}
+
+	void writeDoubleProperty(std::size_t index, double value)
+	{
+		const Property& property = _properties[index];
+		if (property.doubleSetter)
+			(static_cast<Sub*>(this)->*property.doubleSetter)(_propertyNames.name(index), value);
+		else
+			writeProperty(index, value);
+	}
+
+	double readDoubleProperty(std::size_t index) const
+	{
+		const Property& property = _properties[index];
+		if (property.doubleGetter)
+			return (static_cast<const Sub*>(this)->*property.doubleGetter)(_propertyNames.name(index));
+		else
+			return Poco::AnyCast<double>(readProperty(index));
+	}
+
+	void writeBoolProperty(std::size_t index, bool value)
+	{
+		const Property& property = _properties[index];
+		if (property.boolSetter)
+			(static_cast<Sub*>(this)->*property.boolSetter)(_propertyNames.name(index), value);
+		else
+			writeProperty(index, value);
+	}
+
+	bool readBoolProperty(std::size_t index) const
+	{
+		const Property& property = _properties[index];
+		if (property.boolGetter)
+			return (static_cast<const Sub*>(this)->*property.boolGetter)(_propertyNames.name(index));
+		else
+			return Poco::AnyCast<bool>(readProperty(index));
+	}
+
+	void readProperty(std::size_t index, DeviceProperty& result) const
+		/// Reads the value of the property with the given index into result.
+		/// If the property cannot be read, or its value has an
+		/// unsupported type, the type of result is set to
+		/// DEVICE_PROPERTY_UNKNOWN.
+	{
+		const Property& property = _properties[index];
+		const std::string& name = _propertyNames.name(index);
+		const Sub* pSub = static_cast<const Sub*>(this);
+		result.name = name;
+		result.type = DEVICE_PROPERTY_UNKNOWN;
+		result.intValue = 0;
+		result.doubleValue = 0.0;
+		result.boolValue = false;
+		try
+		{
+			if (property.stringGetter)
+			{
+				result.stringValue = (pSub->*property.stringGetter)(name);
+				result.type = DEVICE_PROPERTY_STRING;
+			}
+			else if (property.intGetter)
+			{
+				result.intValue = (pSub->*property.intGetter)(name);
+				result.type = DEVICE_PROPERTY_INT;
+			}
+			else if (property.doubleGetter)
+			{
+				result.doubleValue = (pSub->*property.doubleGetter)(name);
+				result.type = DEVICE_PROPERTY_DOUBLE;
+			}
+			else if (property.boolGetter)
+			{
+				result.boolValue = (pSub->*property.boolGetter)(name);
+				result.type = DEVICE_PROPERTY_BOOL;
+			}
+			else if (property.getter)
+			{
+				Poco::Any value = (pSub->*property.getter)(name);
+				const std::type_info& type = value.type();
+				if (type == typeid(std::string))
+				{
+					result.stringValue = Poco::RefAnyCast<std::string>(value);
+					result.type = DEVICE_PROPERTY_STRING;
+				}
+				else if (type == typeid(int))
+				{
+					result.intValue = Poco::AnyCast<int>(value);
+					result.type = DEVICE_PROPERTY_INT;
+				}
+				else if (type == typeid(double))
+				{
+					result.doubleValue = Poco::AnyCast<double>(value);
+					result.type = DEVICE_PROPERTY_DOUBLE;
+				}
+				else if (type == typeid(bool))
+				{
+					result.boolValue = Poco::AnyCast<bool>(value);
+					result.type = DEVICE_PROPERTY_BOOL;
+				}
+			}
+		}
+		catch (Poco::Exception&)
+		{
+		}
+	}
+
+	NameTable   _featureNames;
+	FeatureVec  _features;
+	NameTable   _propertyNames;
+	PropertyVec _properties;
 	mutable Poco::Mutex _mutex;
 };
 
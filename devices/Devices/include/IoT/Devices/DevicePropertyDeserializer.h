@@ -0,0 +1,68 @@
+//
+// DevicePropertyDeserializer.h
+//
+// Package: Generated
+// Module:  TypeDeserializer
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TypeDeserializer_IoT_Devices_DeviceProperty_INCLUDED
+#define TypeDeserializer_IoT_Devices_DeviceProperty_INCLUDED
+
+
+#include "IoT/Devices/Device.h"
+#include "Poco/RemotingNG/TypeDeserializer.h"
+
+
+namespace Poco {
+namespace RemotingNG {
+
+
+template <>
+class TypeDeserializer<IoT::Devices::DeviceProperty>
+{
+public:
+	static bool deserialize(const std::string& name, bool isMandatory, Deserializer& deser, IoT::Devices::DeviceProperty& value)
+	{
+		bool ret = deser.deserializeStructBegin(name, isMandatory);
+		if (ret)
+		{
+			deserializeImpl(deser, value);
+			deser.deserializeStructEnd(name);
+		}
+		return ret;
+	}
+
+	static void deserializeImpl(Deserializer& deser, IoT::Devices::DeviceProperty& value)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"boolValue","doubleValue","intValue","name","stringValue","type"};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		bool ret = false;
+		TypeDeserializer<bool >::deserialize(REMOTING__NAMES[0], true, deser, value.boolValue);
+		TypeDeserializer<double >::deserialize(REMOTING__NAMES[1], true, deser, value.doubleValue);
+		TypeDeserializer<int >::deserialize(REMOTING__NAMES[2], true, deser, value.intValue);
+		TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[3], true, deser, value.name);
+		TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[4], true, deser, value.stringValue);
+		int gentype;
+		ret = TypeDeserializer<int >::deserialize(REMOTING__NAMES[5], true, deser, gentype);
+		if (ret) value.type = static_cast<IoT::Devices::DevicePropertyType>(gentype);
+	}
+
+};
+
+
+} // namespace RemotingNG
+} // namespace Poco
+
+
+#endif // TypeDeserializer_IoT_Devices_DeviceProperty_INCLUDED
+
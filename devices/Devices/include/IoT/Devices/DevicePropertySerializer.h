@@ -0,0 +1,61 @@
+//
+// DevicePropertySerializer.h
+//
+// Package: Generated
+// Module:  TypeSerializer
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TypeSerializer_IoT_Devices_DeviceProperty_INCLUDED
+#define TypeSerializer_IoT_Devices_DeviceProperty_INCLUDED
+
+
+#include "IoT/Devices/Device.h"
+#include "Poco/RemotingNG/TypeSerializer.h"
+
+
+namespace Poco {
+namespace RemotingNG {
+
+
+template <>
+class TypeSerializer<IoT::Devices::DeviceProperty>
+{
+public:
+	static void serialize(const std::string& name, const IoT::Devices::DeviceProperty& value, Serializer& ser)
+	{
+		ser.serializeStructBegin(name);
+		serializeImpl(value, ser);
+		ser.serializeStructEnd(name);
+	}
+
+	static void serializeImpl(const IoT::Devices::DeviceProperty& value, Serializer& ser)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"boolValue","doubleValue","intValue","name","stringValue","type",""};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		TypeSerializer<bool >::serialize(REMOTING__NAMES[0], value.boolValue, ser);
+		TypeSerializer<double >::serialize(REMOTING__NAMES[1], value.doubleValue, ser);
+		TypeSerializer<int >::serialize(REMOTING__NAMES[2], value.intValue, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[3], value.name, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[4], value.stringValue, ser);
+		TypeSerializer<int >::serialize(REMOTING__NAMES[5], value.type, ser);
+	}
+
+};
+
+
+} // namespace RemotingNG
+} // namespace Poco
+
+
+#endif // TypeSerializer_IoT_Devices_DeviceProperty_INCLUDED
+
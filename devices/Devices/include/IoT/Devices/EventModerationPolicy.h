@@ -19,6 +19,8 @@
 
 
 #include "IoT/Devices/Devices.h"
+#include "IoT/Devices/Sensor.h"
+#include "IoT/Devices/TimerWheel.h"
 #include "Poco/Util/Timer.h"
 #include "Poco/Util/TimerTaskAdapter.h"
 #include "Poco/BasicEvent.h"
@@ -264,6 +266,226 @@ private:
 };
 
 
+template <typename T>
+class WindowedAggregationPolicy: public EventModerationPolicy<T>, protected TimerWheel::Listener
+	/// This event moderation policy collects all values within
+	/// a time window and, at the end of each window, fires an
+	/// aggregate event carrying minimum, maximum, mean and number of
+	/// values in the window, followed by a value event carrying the
+	/// most recent value. No event is fired for a window without
+	/// any values.
+	///
+	/// In contrast to MaximumRateModerationPolicy, no extreme
+	/// value is lost, while the event rate is still bounded
+	/// by the window size.
+	///
+	/// An external TimerWheel, usually shared by all sensors
+	/// of a bundle, must be supplied.
+	///
+	/// This moderation policy can only be used with numeric
+	/// event value types.
+{
+public:
+	typedef Poco::BasicEvent<const T> Event;
+	typedef Poco::BasicEvent<const ValueAggregate> AggregateEvent;
+
+	WindowedAggregationPolicy(Event& event, AggregateEvent& aggregateEvent, long windowMS, TimerWheel& wheel):
+		_pEvent(&event),
+		_pAggregateEvent(&aggregateEvent),
+		_window(windowMS),
+		_wheel(wheel),
+		_last(),
+		_minimum(),
+		_maximum(),
+		_sum(0),
+		_count(0)
+	{
+		_wheel.add(this, windowMS);
+	}
+
+	~WindowedAggregationPolicy()
+	{
+		try
+		{
+			_wheel.remove(this);
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+
+	void valueChanged(const T& value)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		if (_count == 0 || value < _minimum) _minimum = value;
+		if (_count == 0 || value > _maximum) _maximum = value;
+		_sum += static_cast<double>(value);
+		_last = value;
+		_count++;
+	}
+
+	long getWindow() const
+	{
+		return _window;
+	}
+
+protected:
+	void onTimerWheelTick()
+	{
+		ValueAggregate aggregate;
+		T last;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (_count == 0) return;
+			aggregate.minimum = static_cast<double>(_minimum);
+			aggregate.maximum = static_cast<double>(_maximum);
+			aggregate.mean    = _sum/_count;
+			aggregate.count   = _count;
+			last   = _last;
+			_sum   = 0;
+			_count = 0;
+		}
+		(*_pAggregateEvent)(this, aggregate);
+		(*_pEvent)(this, last);
+	}
+
+private:
+	WindowedAggregationPolicy();
+	WindowedAggregationPolicy(const WindowedAggregationPolicy&);
+	WindowedAggregationPolicy& operator = (const WindowedAggregationPolicy&);
+
+	Event* _pEvent;
+	AggregateEvent* _pAggregateEvent;
+	long _window;
+	TimerWheel& _wheel;
+	T _last;
+	T _minimum;
+	T _maximum;
+	double _sum;
+	int _count;
+	Poco::FastMutex _mutex;
+};
+
+
+template <typename T>
+class DeadbandModerationPolicy: public EventModerationPolicy<T>, protected TimerWheel::Listener
+	/// This event moderation policy fires an event whenever the value
+	/// changes by at least the given deadband since the last event,
+	/// like MinimumDeltaModerationPolicy. Additionally, if no event
+	/// has been fired for the given heartbeat interval, the current
+	/// value is sent again, so that subscribers can distinguish
+	/// a stable value from a dead sensor, and the error introduced
+	/// by the deadband never persists longer than the heartbeat interval.
+	///
+	/// An external TimerWheel, usually shared by all sensors
+	/// of a bundle, must be supplied. The heartbeat is checked
+	/// about four times per heartbeat interval, so a heartbeat
+	/// may be sent up to a quarter of the interval early, but
+	/// never late.
+	///
+	/// This moderation policy can only be used with numeric
+	/// event value types.
+{
+public:
+	typedef Poco::BasicEvent<const T> Event;
+
+	DeadbandModerationPolicy(Event& event, T initialValue, T deadband, long heartbeatMS, TimerWheel& wheel):
+		_pEvent(&event),
+		_value(initialValue),
+		_lastSent(initialValue),
+		_deadband(deadband),
+		_heartbeat(heartbeatMS),
+		_interval(heartbeatMS/4 > wheel.resolution() ? (heartbeatMS/4/wheel.resolution())*wheel.resolution() : wheel.resolution()),
+		_idle(0),
+		_wheel(wheel)
+	{
+		_wheel.add(this, _interval);
+	}
+
+	~DeadbandModerationPolicy()
+	{
+		try
+		{
+			_wheel.remove(this);
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+
+	void valueChanged(const T& value)
+	{
+		T sent;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			_value = value;
+			T diff = value - _lastSent;
+			if (diff < 0) diff = -diff;
+			if (diff < _deadband) return;
+			_lastSent = value;
+			_idle = 0;
+			sent = value;
+		}
+		(*_pEvent)(this, sent);
+	}
+
+	T getDeadband() const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _deadband;
+	}
+
+	void setDeadband(T deadband)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_deadband = deadband;
+	}
+
+	long getHeartbeat() const
+	{
+		return _heartbeat;
+	}
+
+protected:
+	void onTimerWheelTick()
+	{
+		T sent;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			_idle += _interval;
+			if (_idle < _heartbeat) return;
+			_lastSent = _value;
+			_idle = 0;
+			sent = _value;
+		}
+		(*_pEvent)(this, sent);
+	}
+
+private:
+	DeadbandModerationPolicy();
+	DeadbandModerationPolicy(const DeadbandModerationPolicy&);
+	DeadbandModerationPolicy& operator = (const DeadbandModerationPolicy&);
+
+	Event* _pEvent;
+	T _value;
+	T _lastSent;
+	T _deadband;
+	long _heartbeat;
+	long _interval;
+	long _idle;
+	TimerWheel& _wheel;
+	mutable Poco::FastMutex _mutex;
+};
+
+
 } } // namespace namespace IoT::Devices
 
 
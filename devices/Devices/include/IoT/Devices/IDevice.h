@@ -77,6 +77,24 @@ public:
 		/// Returns true if the feature with the given name
 		/// is enabled, or false otherwise.
 
+	virtual std::vector < IoT::Devices::DeviceProperty > getProperties(const std::vector < std::string >& names) const = 0;
+		/// Returns the values of the device properties with
+		/// the given names, in the given order.
+		///
+		/// Unlike the getProperty*() methods, this method does not
+		/// throw if a property is unknown or cannot be read. Instead,
+		/// the type of the respective element is set to
+		/// DEVICE_PROPERTY_UNKNOWN.
+		///
+		/// Reading multiple properties with a single call is
+		/// considerably faster for a remote device (or a device
+		/// accessed from JavaScript) than calling the getProperty*()
+		/// methods for each property.
+		///
+		/// The default implementation calls the getProperty*()
+		/// methods and is meant to be overridden; DeviceImpl
+		/// provides an efficient implementation.
+
 	virtual bool getPropertyBool(const std::string& name) const = 0;
 		/// Returns the value of the device property with
 		/// the given name.
@@ -158,6 +176,14 @@ public:
 		/// Which properties are supported is defined by the
 		/// actual device implementation.
 
+	virtual std::vector < IoT::Devices::DeviceProperty > snapshot() const = 0;
+		/// Returns the values of all readable device properties.
+		///
+		/// The default implementation returns the properties
+		/// every device should expose (symbolicName, type, name
+		/// and status), if available. DeviceImpl returns all
+		/// properties added with DeviceImpl::addProperty().
+
 	const std::type_info& type() const;
 		/// Returns the type information for the object's class.
 
@@ -0,0 +1,98 @@
+//
+// ISampleStream.h
+//
+// Library: IoT/Devices
+// Package: Generated
+// Module:  ISampleStream
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Devices_ISampleStream_INCLUDED
+#define IoT_Devices_ISampleStream_INCLUDED
+
+
+#include "IoT/Devices/IDevice.h"
+#include "IoT/Devices/SampleStream.h"
+#include "Poco/RemotingNG/Listener.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+class ISampleStream: public IoT::Devices::IDevice
+	/// The interface for streams of timestamped samples from
+	/// high-rate sensors like accelerometers or gyroscopes.
+	///
+	/// Instead of firing an event for every single sample,
+	/// a SampleStream collects samples into blocks and fires
+	/// the samplesAvailable event once per block. The size of
+	/// a block is controlled by the "blockSize" (maximum number
+	/// of samples per block) and "blockLatency" (maximum age of
+	/// the first sample in a block, in milliseconds) properties.
+	///
+	/// A SampleStream also keeps the most recent samples in
+	/// a ring buffer (the size of which is given by the "bufferSize"
+	/// property), so that a late subscriber can obtain recent
+	/// samples with recentSamples().
+{
+public:
+	typedef Poco::AutoPtr<ISampleStream> Ptr;
+
+	ISampleStream();
+		/// Creates a ISampleStream.
+
+	virtual ~ISampleStream();
+		/// Destroys the ISampleStream.
+
+	virtual std::vector < std::string > channelNames() const = 0;
+		/// Returns the names of the channels (e.g., "x", "y", "z").
+
+	virtual int channels() const = 0;
+		/// Returns the number of values per sample.
+
+	bool isA(const std::type_info& otherType) const;
+		/// Returns true if the class is a subclass of the class given by otherType.
+
+	virtual IoT::Devices::SampleBlock recentSamples(Poco::Int64 sequence) const = 0;
+		/// Returns all samples still in the ring buffer having a
+		/// sequence number greater than or equal to the given one.
+		/// Use a sequence number of 0 to get all buffered samples.
+		///
+		/// A client can compare the sequence number of the returned
+		/// block with the one it asked for to find out whether
+		/// samples have been lost.
+
+	virtual std::string remoting__enableEvents(Poco::RemotingNG::Listener::Ptr pListener, bool enable = bool(true)) = 0;
+		/// Enable or disable delivery of remote events.
+		///
+		/// The given Listener instance must implement the Poco::RemotingNG::EventListener
+		/// interface, otherwise this method will fail with a RemotingException.
+		///
+		/// This method is only used with Proxy objects; calling this method on a
+		/// RemoteObject will do nothing.
+
+	static const Poco::RemotingNG::Identifiable::TypeId& remoting__typeId();
+		/// Returns the TypeId of the class.
+
+	const std::type_info& type() const;
+		/// Returns the type information for the object's class.
+
+	Poco::BasicEvent < const SampleBlock > samplesAvailable;
+};
+
+
+} // namespace Devices
+} // namespace IoT
+
+
+#endif // IoT_Devices_ISampleStream_INCLUDED
+
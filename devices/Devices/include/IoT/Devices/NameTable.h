@@ -0,0 +1,94 @@
+//
+// NameTable.h
+//
+// Library: IoT/Devices
+// Package: Devices
+// Module:  NameTable
+//
+// Definition of the NameTable class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Devices_NameTable_INCLUDED
+#define IoT_Devices_NameTable_INCLUDED
+
+
+#include "IoT/Devices/Devices.h"
+#include <vector>
+#include <string>
+
+
+namespace IoT {
+namespace Devices {
+
+
+class IoTDevices_API NameTable
+	/// A small hash table that assigns dense indexes
+	/// (0, 1, 2, ...) to names, in the order the names
+	/// are added.
+	///
+	/// DeviceImpl uses a NameTable to look up features
+	/// and properties, which are stored in vectors indexed
+	/// by the name's index.
+	///
+	/// This class is not thread-safe.
+{
+public:
+	static const std::size_t NOT_FOUND;
+		/// Returned by find() if the name is not in the table.
+
+	NameTable();
+		/// Creates an empty NameTable.
+
+	~NameTable();
+		/// Destroys the NameTable.
+
+	std::size_t add(const std::string& name);
+		/// Adds the given name to the table, if it is not
+		/// already in the table, and returns its index.
+
+	std::size_t find(const std::string& name) const;
+		/// Returns the index of the given name, or NOT_FOUND
+		/// if the name is not in the table.
+
+	const std::string& name(std::size_t index) const;
+		/// Returns the name with the given index.
+
+	std::size_t size() const;
+		/// Returns the number of names in the table.
+
+private:
+	std::size_t find(const std::string& name, std::size_t hash) const;
+	void rehash();
+
+	std::vector<std::string> _names;
+	std::vector<std::size_t> _hashes;
+	std::vector<std::size_t> _slots;
+	std::size_t _mask;
+};
+
+
+//
+// inlines
+//
+inline const std::string& NameTable::name(std::size_t index) const
+{
+	return _names[index];
+}
+
+
+inline std::size_t NameTable::size() const
+{
+	return _names.size();
+}
+
+
+} } // namespace IoT::Devices
+
+
+#endif // IoT_Devices_NameTable_INCLUDED
@@ -0,0 +1,59 @@
+//
+// SampleBlockSerializer.h
+//
+// Package: Generated
+// Module:  TypeSerializer
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TypeSerializer_IoT_Devices_SampleBlock_INCLUDED
+#define TypeSerializer_IoT_Devices_SampleBlock_INCLUDED
+
+
+#include "IoT/Devices/SampleStream.h"
+#include "Poco/RemotingNG/TypeSerializer.h"
+
+
+namespace Poco {
+namespace RemotingNG {
+
+
+template <>
+class TypeSerializer<IoT::Devices::SampleBlock>
+{
+public:
+	static void serialize(const std::string& name, const IoT::Devices::SampleBlock& value, Serializer& ser)
+	{
+		ser.serializeStructBegin(name);
+		serializeImpl(value, ser);
+		ser.serializeStructEnd(name);
+	}
+
+	static void serializeImpl(const IoT::Devices::SampleBlock& value, Serializer& ser)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"channels","samples","sequence","timestamps",""};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		TypeSerializer<int >::serialize(REMOTING__NAMES[0], value.channels, ser);
+		TypeSerializer<std::vector < double > >::serialize(REMOTING__NAMES[1], value.samples, ser);
+		TypeSerializer<Poco::Int64 >::serialize(REMOTING__NAMES[2], value.sequence, ser);
+		TypeSerializer<std::vector < Poco::Int64 > >::serialize(REMOTING__NAMES[3], value.timestamps, ser);
+	}
+
+};
+
+
+} // namespace RemotingNG
+} // namespace Poco
+
+
+#endif // TypeSerializer_IoT_Devices_SampleBlock_INCLUDED
+
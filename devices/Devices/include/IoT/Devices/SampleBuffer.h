@@ -0,0 +1,204 @@
+//
+// SampleBuffer.h
+//
+// Library: IoT/Devices
+// Package: Devices
+// Module:  SampleBuffer
+//
+// Definition of the SampleBuffer class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Devices_SampleBuffer_INCLUDED
+#define IoT_Devices_SampleBuffer_INCLUDED
+
+
+#include "IoT/Devices/SampleStream.h"
+#include "Poco/Timestamp.h"
+#include <vector>
+
+
+namespace IoT {
+namespace Devices {
+
+
+class IoTDevices_API SampleBuffer
+	/// A ring buffer for multi-channel samples, used for
+	/// implementing a SampleStream.
+	///
+	/// Samples are added one at a time with add(). The buffer
+	/// keeps track of the samples not yet delivered in a block.
+	/// As soon as the block is complete, add() returns true,
+	/// and the block can be obtained with takeBlock().
+	///
+	/// A block is complete if it contains blockSize samples,
+	/// or if the first sample in the block is at least blockLatency
+	/// microseconds older than the most recently added sample.
+	/// Note that the latency is only checked when a sample is added.
+	/// To deliver an incomplete block when a sensor stops producing
+	/// samples, periodically check expired() and use flush().
+	///
+	/// The buffer keeps the most recent capacity samples, which
+	/// can be obtained with recent(). The capacity is always at
+	/// least the block size.
+	///
+	/// This class is not thread-safe.
+{
+public:
+	SampleBuffer(int channels, std::size_t blockSize, Poco::Timestamp::TimeDiff blockLatency, std::size_t capacity);
+		/// Creates the SampleBuffer.
+		///
+		/// Throws a Poco::InvalidArgumentException if channels
+		/// or blockSize is less than 1, or if the buffer
+		/// would be too large.
+
+	~SampleBuffer();
+		/// Destroys the SampleBuffer.
+
+	int channels() const;
+		/// Returns the number of values per sample.
+
+	std::size_t blockSize() const;
+		/// Returns the maximum number of samples in a block.
+
+	void setBlockSize(std::size_t blockSize);
+		/// Sets the maximum number of samples in a block.
+		/// Grows the capacity of the buffer if necessary.
+
+	Poco::Timestamp::TimeDiff blockLatency() const;
+		/// Returns the maximum age of the first sample in
+		/// a block, in microseconds.
+
+	void setBlockLatency(Poco::Timestamp::TimeDiff blockLatency);
+		/// Sets the maximum age of the first sample in a
+		/// block, in microseconds.
+
+	std::size_t capacity() const;
+		/// Returns the number of samples kept in the buffer.
+
+	std::size_t size() const;
+		/// Returns the number of samples currently in the buffer.
+
+	std::size_t pending() const;
+		/// Returns the number of samples added but not
+		/// yet delivered in a block.
+
+	Poco::Int64 nextSequence() const;
+		/// Returns the sequence number the next sample
+		/// added will get.
+
+	bool add(const Poco::Timestamp& timestamp, const double* values);
+		/// Adds a sample. values must point to channels() values.
+		///
+		/// Returns true if the current block is complete.
+
+	bool expired(const Poco::Timestamp& now) const;
+		/// Returns true if there are pending samples and the first
+		/// of them is at least blockLatency microseconds older than
+		/// the given time. Always returns false if blockLatency is 0.
+
+	bool takeBlock(SampleBlock& block);
+		/// Moves all pending samples into block, and starts a new block.
+		///
+		/// Returns false and leaves block unchanged if there
+		/// are no pending samples.
+
+	bool flush(SampleBlock& block);
+		/// Same as takeBlock().
+
+	void recent(Poco::Int64 sequence, SampleBlock& block) const;
+		/// Copies all samples in the buffer with a sequence number
+		/// greater than or equal to the given one into block.
+
+	void clear();
+		/// Removes all samples from the buffer.
+		/// Sequence numbers are not reset.
+
+protected:
+	void copy(Poco::Int64 sequence, SampleBlock& block) const;
+	std::size_t index(Poco::Int64 sequence) const;
+	void resize(std::size_t capacity);
+
+private:
+	SampleBuffer();
+	SampleBuffer(const SampleBuffer&);
+	SampleBuffer& operator = (const SampleBuffer&);
+
+	int _channels;
+	std::size_t _blockSize;
+	Poco::Timestamp::TimeDiff _blockLatency;
+	std::size_t _capacity;
+	std::vector<Poco::Int64> _timestamps;
+	std::vector<double> _values;
+	Poco::Int64 _firstSequence;
+	Poco::Int64 _blockSequence;
+	Poco::Int64 _nextSequence;
+};
+
+
+//
+// inlines
+//
+inline int SampleBuffer::channels() const
+{
+	return _channels;
+}
+
+
+inline std::size_t SampleBuffer::blockSize() const
+{
+	return _blockSize;
+}
+
+
+inline Poco::Timestamp::TimeDiff SampleBuffer::blockLatency() const
+{
+	return _blockLatency;
+}
+
+
+inline std::size_t SampleBuffer::capacity() const
+{
+	return _capacity;
+}
+
+
+inline std::size_t SampleBuffer::size() const
+{
+	return static_cast<std::size_t>(_nextSequence - _firstSequence);
+}
+
+
+inline std::size_t SampleBuffer::pending() const
+{
+	return static_cast<std::size_t>(_nextSequence - _blockSequence);
+}
+
+
+inline Poco::Int64 SampleBuffer::nextSequence() const
+{
+	return _nextSequence;
+}
+
+
+inline bool SampleBuffer::flush(SampleBlock& block)
+{
+	return takeBlock(block);
+}
+
+
+inline std::size_t SampleBuffer::index(Poco::Int64 sequence) const
+{
+	return static_cast<std::size_t>(sequence % static_cast<Poco::Int64>(_capacity));
+}
+
+
+} } // namespace IoT::Devices
+
+
+#endif // IoT_Devices_SampleBuffer_INCLUDED
@@ -0,0 +1,113 @@
+//
+// SampleStream.h
+//
+// Library: IoT/Devices
+// Package: Devices
+// Module:  SampleStream
+//
+// Definition of the SampleStream interface.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Devices_SampleStream_INCLUDED
+#define IoT_Devices_SampleStream_INCLUDED
+
+
+#include "IoT/Devices/Device.h"
+#include "Poco/BasicEvent.h"
+#include <vector>
+
+
+namespace IoT {
+namespace Devices {
+
+
+//@ serialize
+struct SampleBlock
+	/// A block of consecutive samples from a SampleStream.
+	///
+	/// Each sample consists of one value per channel, plus a
+	/// timestamp. Values are stored interleaved, i.e.,
+	/// the value of channel c of the i-th sample in the block
+	/// is samples[i*channels + c].
+{
+	SampleBlock():
+		sequence(0),
+		channels(0)
+	{
+	}
+
+	Poco::Int64 sequence;
+		/// The sequence number of the first sample in the block.
+		/// Every sample produced by a stream gets a sequence
+		/// number one greater than the previous sample.
+
+	int channels;
+		/// The number of values per sample.
+
+	std::vector<Poco::Int64> timestamps;
+		/// The timestamps of the samples, in microseconds
+		/// since the Unix epoch.
+
+	std::vector<double> samples;
+		/// The sample values, timestamps.size()*channels values.
+};
+
+
+//@ remote
+class IoTDevices_API SampleStream: public Device
+	/// The interface for streams of timestamped samples from
+	/// high-rate sensors like accelerometers or gyroscopes.
+	///
+	/// Instead of firing an event for every single sample,
+	/// a SampleStream collects samples into blocks and fires
+	/// the samplesAvailable event once per block. The size of
+	/// a block is controlled by the "blockSize" (maximum number
+	/// of samples per block) and "blockLatency" (maximum age of
+	/// the first sample in a block, in milliseconds) properties.
+	///
+	/// A SampleStream also keeps the most recent samples in
+	/// a ring buffer (the size of which is given by the "bufferSize"
+	/// property), so that a late subscriber can obtain recent
+	/// samples with recentSamples().
+{
+public:
+	Poco::BasicEvent<const SampleBlock> samplesAvailable;
+		/// Fired when a new block of samples is available.
+
+	SampleStream();
+		/// Creates the SampleStream.
+
+	~SampleStream();
+		/// Destroys the SampleStream.
+
+	virtual int channels() const = 0;
+		/// Returns the number of values per sample.
+
+	virtual std::vector<std::string> channelNames() const = 0;
+		/// Returns the names of the channels (e.g., "x", "y", "z").
+
+	virtual SampleBlock recentSamples(Poco::Int64 sequence) const = 0;
+		/// Returns all samples still in the ring buffer having a
+		/// sequence number greater than or equal to the given one.
+		/// Use a sequence number of 0 to get all buffered samples.
+		///
+		/// A client can compare the sequence number of the returned
+		/// block with the one it asked for to find out whether
+		/// samples have been lost.
+
+	static const std::string PROP_BLOCK_SIZE;
+	static const std::string PROP_BLOCK_LATENCY;
+	static const std::string PROP_BUFFER_SIZE;
+};
+
+
+} } // namespace IoT::Devices
+
+
+#endif // IoT_Devices_SampleStream_INCLUDED
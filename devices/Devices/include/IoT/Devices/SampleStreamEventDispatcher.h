@@ -0,0 +1,80 @@
+//
+// SampleStreamEventDispatcher.h
+//
+// Library: IoT/Devices
+// Package: Generated
+// Module:  SampleStreamEventDispatcher
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Devices_SampleStreamEventDispatcher_INCLUDED
+#define IoT_Devices_SampleStreamEventDispatcher_INCLUDED
+
+
+#include "IoT/Devices/SampleStreamRemoteObject.h"
+#include "Poco/RemotingNG/EventDispatcher.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+class SampleStreamEventDispatcher: public Poco::RemotingNG::EventDispatcher
+	/// The interface for streams of timestamped samples from
+	/// high-rate sensors like accelerometers or gyroscopes.
+	///
+	/// Instead of firing an event for every single sample,
+	/// a SampleStream collects samples into blocks and fires
+	/// the samplesAvailable event once per block. The size of
+	/// a block is controlled by the "blockSize" (maximum number
+	/// of samples per block) and "blockLatency" (maximum age of
+	/// the first sample in a block, in milliseconds) properties.
+	///
+	/// A SampleStream also keeps the most recent samples in
+	/// a ring buffer (the size of which is given by the "bufferSize"
+	/// property), so that a late subscriber can obtain recent
+	/// samples with recentSamples().
+{
+public:
+	SampleStreamEventDispatcher(SampleStreamRemoteObject* pRemoteObject, const std::string& protocol);
+		/// Creates a SampleStreamEventDispatcher.
+
+	virtual ~SampleStreamEventDispatcher();
+		/// Destroys the SampleStreamEventDispatcher.
+
+	void event__samplesAvailable(const void* pSender, const IoT::Devices::SampleBlock& data);
+
+	void event__statusChanged(const void* pSender, const IoT::Devices::DeviceStatusChange& data);
+
+	virtual const Poco::RemotingNG::Identifiable::TypeId& remoting__typeId() const;
+
+private:
+	void event__samplesAvailableImpl(const std::string& subscriberURI, const IoT::Devices::SampleBlock& data);
+
+	void event__statusChangedImpl(const std::string& subscriberURI, const IoT::Devices::DeviceStatusChange& data);
+
+	static const std::string DEFAULT_NS;
+	SampleStreamRemoteObject* _pRemoteObject;
+};
+
+
+inline const Poco::RemotingNG::Identifiable::TypeId& SampleStreamEventDispatcher::remoting__typeId() const
+{
+	return ISampleStream::remoting__typeId();
+}
+
+
+} // namespace Devices
+} // namespace IoT
+
+
+#endif // IoT_Devices_SampleStreamEventDispatcher_INCLUDED
+
@@ -0,0 +1,297 @@
+//
+// SampleStreamRemoteObject.h
+//
+// Library: IoT/Devices
+// Package: Generated
+// Module:  SampleStreamRemoteObject
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Devices_SampleStreamRemoteObject_INCLUDED
+#define IoT_Devices_SampleStreamRemoteObject_INCLUDED
+
+
+#include "IoT/Devices/ISampleStream.h"
+#include "Poco/RemotingNG/Identifiable.h"
+#include "Poco/RemotingNG/RemoteObject.h"
+#include "Poco/SharedPtr.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+class SampleStreamRemoteObject: public IoT::Devices::ISampleStream, public Poco::RemotingNG::RemoteObject
+	/// The interface for streams of timestamped samples from
+	/// high-rate sensors like accelerometers or gyroscopes.
+	///
+	/// Instead of firing an event for every single sample,
+	/// a SampleStream collects samples into blocks and fires
+	/// the samplesAvailable event once per block. The size of
+	/// a block is controlled by the "blockSize" (maximum number
+	/// of samples per block) and "blockLatency" (maximum age of
+	/// the first sample in a block, in milliseconds) properties.
+	///
+	/// A SampleStream also keeps the most recent samples in
+	/// a ring buffer (the size of which is given by the "bufferSize"
+	/// property), so that a late subscriber can obtain recent
+	/// samples with recentSamples().
+{
+public:
+	typedef Poco::AutoPtr<SampleStreamRemoteObject> Ptr;
+
+	SampleStreamRemoteObject(const Poco::RemotingNG::Identifiable::ObjectId& oid, Poco::SharedPtr<IoT::Devices::SampleStream> pServiceObject);
+		/// Creates a SampleStreamRemoteObject.
+
+	virtual ~SampleStreamRemoteObject();
+		/// Destroys the SampleStreamRemoteObject.
+
+	virtual std::vector < std::string > channelNames() const;
+		/// Returns the names of the channels (e.g., "x", "y", "z").
+
+	virtual int channels() const;
+		/// Returns the number of values per sample.
+
+	virtual bool getFeature(const std::string& name) const;
+		/// Returns true if the feature with the given name
+		/// is enabled, or false otherwise.
+
+	std::vector < IoT::Devices::DeviceProperty > getProperties(const std::vector < std::string >& names) const;
+		/// Returns the values of the device properties with
+		/// the given names, in the given order.
+		///
+		/// Unlike the getProperty*() methods, this method does not
+		/// throw if a property is unknown or cannot be read. Instead,
+		/// the type of the respective element is set to
+		/// DEVICE_PROPERTY_UNKNOWN.
+		///
+		/// Reading multiple properties with a single call is
+		/// considerably faster for a remote device (or a device
+		/// accessed from JavaScript) than calling the getProperty*()
+		/// methods for each property.
+		///
+		/// The default implementation calls the getProperty*()
+		/// methods and is meant to be overridden; DeviceImpl
+		/// provides an efficient implementation.
+
+	virtual bool getPropertyBool(const std::string& name) const;
+		/// Returns the value of the device property with
+		/// the given name.
+		///
+		/// Throws a Poco::NotFoundException if the property
+		/// with the given name is unknown.
+
+	virtual double getPropertyDouble(const std::string& name) const;
+		/// Returns the value of the device property with
+		/// the given name.
+		///
+		/// Throws a Poco::NotFoundException if the property
+		/// with the given name is unknown.
+
+	virtual int getPropertyInt(const std::string& name) const;
+		/// Returns the value of the device property with
+		/// the given name.
+		///
+		/// Throws a Poco::NotFoundException if the property
+		/// with the given name is unknown.
+
+	virtual std::string getPropertyString(const std::string& name) const;
+		/// Returns the value of the device property with
+		/// the given name.
+		///
+		/// Throws a Poco::NotFoundException if the property
+		/// with the given name is unknown.
+
+	virtual bool hasFeature(const std::string& name) const;
+		/// Returns true if the feature with the given name
+		/// is known, or false otherwise.
+
+	virtual bool hasProperty(const std::string& name) const;
+		/// Returns true if the property with the given name
+		/// exists, or false otherwise.
+
+	IoT::Devices::SampleBlock recentSamples(Poco::Int64 sequence) const;
+		/// Returns all samples still in the ring buffer having a
+		/// sequence number greater than or equal to the given one.
+		/// Use a sequence number of 0 to get all buffered samples.
+		///
+		/// A client can compare the sequence number of the returned
+		/// block with the one it asked for to find out whether
+		/// samples have been lost.
+
+	virtual std::string remoting__enableEvents(Poco::RemotingNG::Listener::Ptr pListener, bool enable = bool(true));
+
+	virtual void remoting__enableRemoteEvents(const std::string& protocol);
+
+	virtual bool remoting__hasEvents() const;
+
+	virtual const Poco::RemotingNG::Identifiable::TypeId& remoting__typeId() const;
+
+	virtual void setFeature(const std::string& name, bool enable);
+		/// Enables or disables the feature with the given name.
+		///
+		/// Which features are supported is defined by the
+		/// actual device implementation.
+
+	virtual void setPropertyBool(const std::string& name, bool value);
+		/// Sets a device property.
+		///
+		/// Which properties are supported is defined by the
+		/// actual device implementation.
+
+	virtual void setPropertyDouble(const std::string& name, double value);
+		/// Sets a device property.
+		///
+		/// Which properties are supported is defined by the
+		/// actual device implementation.
+
+	virtual void setPropertyInt(const std::string& name, int value);
+		/// Sets a device property.
+		///
+		/// Which properties are supported is defined by the
+		/// actual device implementation.
+
+	virtual void setPropertyString(const std::string& name, const std::string& value);
+		/// Sets a device property.
+		///
+		/// Which properties are supported is defined by the
+		/// actual device implementation.
+
+	std::vector < IoT::Devices::DeviceProperty > snapshot() const;
+		/// Returns the values of all readable device properties.
+		///
+		/// The default implementation returns the properties
+		/// every device should expose (symbolicName, type, name
+		/// and status), if available. DeviceImpl returns all
+		/// properties added with DeviceImpl::addProperty().
+
+protected:
+	void event__samplesAvailable(const IoT::Devices::SampleBlock& data);
+
+private:
+	Poco::SharedPtr<IoT::Devices::SampleStream> _pServiceObject;
+};
+
+
+inline std::vector < std::string > SampleStreamRemoteObject::channelNames() const
+{
+	return _pServiceObject->channelNames();
+}
+
+
+inline int SampleStreamRemoteObject::channels() const
+{
+	return _pServiceObject->channels();
+}
+
+
+inline bool SampleStreamRemoteObject::getFeature(const std::string& name) const
+{
+	return _pServiceObject->getFeature(name);
+}
+
+
+inline std::vector < IoT::Devices::DeviceProperty > SampleStreamRemoteObject::getProperties(const std::vector < std::string >& names) const
+{
+	return _pServiceObject->getProperties(names);
+}
+
+
+inline bool SampleStreamRemoteObject::getPropertyBool(const std::string& name) const
+{
+	return _pServiceObject->getPropertyBool(name);
+}
+
+
+inline double SampleStreamRemoteObject::getPropertyDouble(const std::string& name) const
+{
+	return _pServiceObject->getPropertyDouble(name);
+}
+
+
+inline int SampleStreamRemoteObject::getPropertyInt(const std::string& name) const
+{
+	return _pServiceObject->getPropertyInt(name);
+}
+
+
+inline std::string SampleStreamRemoteObject::getPropertyString(const std::string& name) const
+{
+	return _pServiceObject->getPropertyString(name);
+}
+
+
+inline bool SampleStreamRemoteObject::hasFeature(const std::string& name) const
+{
+	return _pServiceObject->hasFeature(name);
+}
+
+
+inline bool SampleStreamRemoteObject::hasProperty(const std::string& name) const
+{
+	return _pServiceObject->hasProperty(name);
+}
+
+
+inline IoT::Devices::SampleBlock SampleStreamRemoteObject::recentSamples(Poco::Int64 sequence) const
+{
+	return _pServiceObject->recentSamples(sequence);
+}
+
+
+inline const Poco::RemotingNG::Identifiable::TypeId& SampleStreamRemoteObject::remoting__typeId() const
+{
+	return ISampleStream::remoting__typeId();
+}
+
+
+inline void SampleStreamRemoteObject::setFeature(const std::string& name, bool enable)
+{
+	_pServiceObject->setFeature(name, enable);
+}
+
+
+inline void SampleStreamRemoteObject::setPropertyBool(const std::string& name, bool value)
+{
+	_pServiceObject->setPropertyBool(name, value);
+}
+
+
+inline void SampleStreamRemoteObject::setPropertyDouble(const std::string& name, double value)
+{
+	_pServiceObject->setPropertyDouble(name, value);
+}
+
+
+inline void SampleStreamRemoteObject::setPropertyInt(const std::string& name, int value)
+{
+	_pServiceObject->setPropertyInt(name, value);
+}
+
+
+inline void SampleStreamRemoteObject::setPropertyString(const std::string& name, const std::string& value)
+{
+	_pServiceObject->setPropertyString(name, value);
+}
+
+
+inline std::vector < IoT::Devices::DeviceProperty > SampleStreamRemoteObject::snapshot() const
+{
+	return _pServiceObject->snapshot();
+}
+
+
+} // namespace Devices
+} // namespace IoT
+
+
+#endif // IoT_Devices_SampleStreamRemoteObject_INCLUDED
+
@@ -0,0 +1,145 @@
+//
+// SampleStreamServerHelper.h
+//
+// Library: IoT/Devices
+// Package: Generated
+// Module:  SampleStreamServerHelper
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Devices_SampleStreamServerHelper_INCLUDED
+#define IoT_Devices_SampleStreamServerHelper_INCLUDED
+
+
+#include "IoT/Devices/ISampleStream.h"
+#include "IoT/Devices/SampleStream.h"
+#include "IoT/Devices/SampleStreamRemoteObject.h"
+#include "Poco/RemotingNG/Identifiable.h"
+#include "Poco/RemotingNG/ORB.h"
+#include "Poco/RemotingNG/ServerHelper.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+class SampleStreamServerHelper
+	/// The interface for streams of timestamped samples from
+	/// high-rate sensors like accelerometers or gyroscopes.
+	///
+	/// Instead of firing an event for every single sample,
+	/// a SampleStream collects samples into blocks and fires
+	/// the samplesAvailable event once per block. The size of
+	/// a block is controlled by the "blockSize" (maximum number
+	/// of samples per block) and "blockLatency" (maximum age of
+	/// the first sample in a block, in milliseconds) properties.
+	///
+	/// A SampleStream also keeps the most recent samples in
+	/// a ring buffer (the size of which is given by the "bufferSize"
+	/// property), so that a late subscriber can obtain recent
+	/// samples with recentSamples().
+{
+public:
+	typedef IoT::Devices::SampleStream Service;
+
+	SampleStreamServerHelper();
+		/// Creates a SampleStreamServerHelper.
+
+	~SampleStreamServerHelper();
+		/// Destroys the SampleStreamServerHelper.
+
+	static Poco::AutoPtr<IoT::Devices::SampleStreamRemoteObject> createRemoteObject(Poco::SharedPtr<IoT::Devices::SampleStream> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid);
+		/// Creates and returns a RemoteObject wrapper for the given IoT::Devices::SampleStream instance.
+
+	static void enableEvents(const std::string& uri, const std::string& protocol);
+		/// Enables remote events for the RemoteObject identified by the given URI.
+		///
+		/// Events will be delivered using the Transport for the given protocol.
+		/// Can be called multiple times for the same URI with different protocols.
+
+	static std::string registerObject(Poco::SharedPtr<IoT::Devices::SampleStream> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid, const std::string& listenerId);
+		/// Creates a RemoteObject wrapper for the given IoT::Devices::SampleStream instance
+		/// and registers it with the ORB and the Listener instance
+		/// uniquely identified by the Listener's ID.
+		/// 
+		///	Returns the URI created for the object.
+
+	static std::string registerRemoteObject(Poco::AutoPtr<IoT::Devices::SampleStreamRemoteObject> pRemoteObject, const std::string& listenerId);
+		/// Registers the given RemoteObject with the ORB and the Listener instance
+		/// uniquely identified by the Listener's ID.
+		/// 
+		///	Returns the URI created for the object.
+
+	static void shutdown();
+		/// Removes the Skeleton for IoT::Devices::SampleStream from the ORB.
+
+	static void unregisterObject(const std::string& uri);
+		/// Unregisters a service object identified by URI from the ORB.
+
+private:
+	static Poco::AutoPtr<IoT::Devices::SampleStreamRemoteObject> createRemoteObjectImpl(Poco::SharedPtr<IoT::Devices::SampleStream> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid);
+
+	void enableEventsImpl(const std::string& uri, const std::string& protocol);
+
+	static SampleStreamServerHelper& instance();
+		/// Returns a static instance of the helper class.
+
+	std::string registerObjectImpl(Poco::AutoPtr<IoT::Devices::SampleStreamRemoteObject> pRemoteObject, const std::string& listenerId);
+
+	void registerSkeleton();
+
+	void unregisterObjectImpl(const std::string& uri);
+
+	void unregisterSkeleton();
+
+	Poco::RemotingNG::ORB* _pORB;
+};
+
+
+inline Poco::AutoPtr<IoT::Devices::SampleStreamRemoteObject> SampleStreamServerHelper::createRemoteObject(Poco::SharedPtr<IoT::Devices::SampleStream> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid)
+{
+	return SampleStreamServerHelper::instance().createRemoteObjectImpl(pServiceObject, oid);
+}
+
+
+inline void SampleStreamServerHelper::enableEvents(const std::string& uri, const std::string& protocol)
+{
+	SampleStreamServerHelper::instance().enableEventsImpl(uri, protocol);
+}
+
+
+inline std::string SampleStreamServerHelper::registerObject(Poco::SharedPtr<IoT::Devices::SampleStream> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid, const std::string& listenerId)
+{
+	return SampleStreamServerHelper::instance().registerObjectImpl(createRemoteObject(pServiceObject, oid), listenerId);
+}
+
+
+inline std::string SampleStreamServerHelper::registerRemoteObject(Poco::AutoPtr<IoT::Devices::SampleStreamRemoteObject> pRemoteObject, const std::string& listenerId)
+{
+	return SampleStreamServerHelper::instance().registerObjectImpl(pRemoteObject, listenerId);
+}
+
+
+inline void SampleStreamServerHelper::unregisterObject(const std::string& uri)
+{
+	SampleStreamServerHelper::instance().unregisterObjectImpl(uri);
+}
+
+
+} // namespace Devices
+} // namespace IoT
+
+
+REMOTING_SPECIALIZE_SERVER_HELPER(IoT::Devices, SampleStream)
+
+
+#endif // IoT_Devices_SampleStreamServerHelper_INCLUDED
+
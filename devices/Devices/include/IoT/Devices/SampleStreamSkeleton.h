@@ -0,0 +1,70 @@
+//
+// SampleStreamSkeleton.h
+//
+// Library: IoT/Devices
+// Package: Generated
+// Module:  SampleStreamSkeleton
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Devices_SampleStreamSkeleton_INCLUDED
+#define IoT_Devices_SampleStreamSkeleton_INCLUDED
+
+
+#include "IoT/Devices/SampleStreamRemoteObject.h"
+#include "Poco/RemotingNG/Skeleton.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+class SampleStreamSkeleton: public Poco::RemotingNG::Skeleton
+	/// The interface for streams of timestamped samples from
+	/// high-rate sensors like accelerometers or gyroscopes.
+	///
+	/// Instead of firing an event for every single sample,
+	/// a SampleStream collects samples into blocks and fires
+	/// the samplesAvailable event once per block. The size of
+	/// a block is controlled by the "blockSize" (maximum number
+	/// of samples per block) and "blockLatency" (maximum age of
+	/// the first sample in a block, in milliseconds) properties.
+	///
+	/// A SampleStream also keeps the most recent samples in
+	/// a ring buffer (the size of which is given by the "bufferSize"
+	/// property), so that a late subscriber can obtain recent
+	/// samples with recentSamples().
+{
+public:
+	SampleStreamSkeleton();
+		/// Creates a SampleStreamSkeleton.
+
+	virtual ~SampleStreamSkeleton();
+		/// Destroys a SampleStreamSkeleton.
+
+	virtual const Poco::RemotingNG::Identifiable::TypeId& remoting__typeId() const;
+
+	static const std::string DEFAULT_NS;
+};
+
+
+inline const Poco::RemotingNG::Identifiable::TypeId& SampleStreamSkeleton::remoting__typeId() const
+{
+	return ISampleStream::remoting__typeId();
+}
+
+
+} // namespace Devices
+} // namespace IoT
+
+
+#endif // IoT_Devices_SampleStreamSkeleton_INCLUDED
+
@@ -27,6 +27,33 @@ namespace IoT {
 namespace Devices {
 
 
+//@ serialize
+struct ValueAggregate
+	/// Aggregated sensor values over a time window,
+	/// as reported by the valueAggregated event.
+{
+	ValueAggregate():
+		minimum(0),
+		maximum(0),
+		mean(0),
+		count(0)
+	{
+	}
+
+	double minimum;
+		/// The smallest value in the window.
+
+	double maximum;
+		/// The largest value in the window.
+
+	double mean;
+		/// The arithmetic mean of all values in the window.
+
+	int count;
+		/// The number of values in the window.
+};
+
+
 //@ remote
 class IoTDevices_API Sensor: public Device
 	/// The base class for analog sensors, such as
@@ -54,6 +81,15 @@ public:
 		/// between fires) are implementation specific
 		/// and can be configured via properties.
 
+	Poco::BasicEvent<const ValueAggregate> valueAggregated;
+		/// Fired at the end of every aggregation window if the
+		/// sensor has been configured to aggregate values (see
+		/// IoT::Devices::WindowedAggregationPolicy), and at least
+		/// one value has been measured within the window.
+		///
+		/// Implementations not supporting aggregation never
+		/// fire this event.
+
 	Sensor();
 		/// Creates the Sensor.
 
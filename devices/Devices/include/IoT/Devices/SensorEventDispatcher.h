@@ -53,6 +53,8 @@ public:
 
 	void event__statusChanged(const void* pSender, const IoT::Devices::DeviceStatusChange& data);
 
+	void event__valueAggregated(const void* pSender, const IoT::Devices::ValueAggregate& data);
+
 	void event__valueChanged(const void* pSender, const double& data);
 
 	virtual const Poco::RemotingNG::Identifiable::TypeId& remoting__typeId() const;
@@ -60,6 +62,8 @@ public:
 private:
 	void event__statusChangedImpl(const std::string& subscriberURI, const IoT::Devices::DeviceStatusChange& data);
 
+	void event__valueAggregatedImpl(const std::string& subscriberURI, const IoT::Devices::ValueAggregate& data);
+
 	void event__valueChangedImpl(const std::string& subscriberURI, const double& data);
 
 	static const std::string DEFAULT_NS;
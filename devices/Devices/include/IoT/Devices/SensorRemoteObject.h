@@ -62,6 +62,24 @@ public:
 		/// Returns true if the feature with the given name
 		/// is enabled, or false otherwise.
 
+	std::vector < IoT::Devices::DeviceProperty > getProperties(const std::vector < std::string >& names) const;
+		/// Returns the values of the device properties with
+		/// the given names, in the given order.
+		///
+		/// Unlike the getProperty*() methods, this method does not
+		/// throw if a property is unknown or cannot be read. Instead,
+		/// the type of the respective element is set to
+		/// DEVICE_PROPERTY_UNKNOWN.
+		///
+		/// Reading multiple properties with a single call is
+		/// considerably faster for a remote device (or a device
+		/// accessed from JavaScript) than calling the getProperty*()
+		/// methods for each property.
+		///
+		/// The default implementation calls the getProperty*()
+		/// methods and is meant to be overridden; DeviceImpl
+		/// provides an efficient implementation.
+
 	virtual bool getPropertyBool(const std::string& name) const;
 		/// Returns the value of the device property with
 		/// the given name.
@@ -163,6 +181,14 @@ public:
 	void setValueChangedMinimumIntervalOrDeltaFilter(const std::string& subscriberURI, long milliseconds, double delta);
 		/// Sets a Poco::RemotingNG::MinimumIntervalOrDeltaFilter for the valueChanged event.
 
+	std::vector < IoT::Devices::DeviceProperty > snapshot() const;
+		/// Returns the values of all readable device properties.
+		///
+		/// The default implementation returns the properties
+		/// every device should expose (symbolicName, type, name
+		/// and status), if available. DeviceImpl returns all
+		/// properties added with DeviceImpl::addProperty().
+
 	virtual double value() const;
 		/// Returns the current value measured by the sensor.
 		///
@@ -171,6 +197,8 @@ public:
 		/// should be called to check if a valid value is available.
 
 protected:
+	void event__valueAggregated(const IoT::Devices::ValueAggregate& data);
+
 	void event__valueChanged(const double& data);
 
 private:
@@ -190,6 +218,12 @@ inline bool SensorRemoteObject::getFeature(const std::string& name) const
 }
 
 
+inline std::vector < IoT::Devices::DeviceProperty > SensorRemoteObject::getProperties(const std::vector < std::string >& names) const
+{
+	return _pServiceObject->getProperties(names);
+}
+
+
 inline bool SensorRemoteObject::getPropertyBool(const std::string& name) const
 {
 	return _pServiceObject->getPropertyBool(name);
@@ -316,6 +350,12 @@ inline void SensorRemoteObject::setValueChangedMinimumIntervalOrDeltaFilter(cons
 }
 
 
+inline std::vector < IoT::Devices::DeviceProperty > SensorRemoteObject::snapshot() const
+{
+	return _pServiceObject->snapshot();
+}
+
+
 inline double SensorRemoteObject::value() const
 {
 	return _pServiceObject->value();
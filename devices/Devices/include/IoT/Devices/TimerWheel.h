@@ -0,0 +1,148 @@
+//
+// TimerWheel.h
+//
+// Library: IoT/Devices
+// Package: Devices
+// Module:  Utilities
+//
+// Definition of the TimerWheel class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Devices_TimerWheel_INCLUDED
+#define IoT_Devices_TimerWheel_INCLUDED
+
+
+#include "IoT/Devices/Devices.h"
+#include "Poco/Util/Timer.h"
+#include "Poco/Util/TimerTask.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/Thread.h"
+#include <vector>
+#include <map>
+
+
+namespace IoT {
+namespace Devices {
+
+
+class IoTDevices_API TimerWheel
+	/// A hashed timer wheel for periodic callbacks.
+	///
+	/// Instead of scheduling a separate Poco::Util::TimerTask for every
+	/// sensor, event moderation policies register a Listener with
+	/// a TimerWheel shared by all sensors of a bundle. The TimerWheel
+	/// uses a single TimerTask that advances the wheel by one slot
+	/// every resolution milliseconds and calls all listeners due
+	/// in that slot.
+	///
+	/// Listener intervals are rounded up to a multiple of the
+	/// resolution.
+{
+public:
+	typedef Poco::SharedPtr<TimerWheel> Ptr;
+
+	class IoTDevices_API Listener
+		/// The interface for TimerWheel listeners.
+	{
+	public:
+		virtual void onTimerWheelTick() = 0;
+			/// Called periodically by the TimerWheel.
+
+		virtual ~Listener();
+	};
+
+	enum
+	{
+		DEFAULT_RESOLUTION = 10,
+		DEFAULT_SLOTS = 256
+	};
+
+	TimerWheel(long resolution = DEFAULT_RESOLUTION, std::size_t slots = DEFAULT_SLOTS);
+		/// Creates the TimerWheel with the given resolution
+		/// (in milliseconds) and number of slots.
+		///
+		/// The TimerWheel does not advance until start() is
+		/// called, or tick() is called explicitly.
+
+	~TimerWheel();
+		/// Destroys the TimerWheel.
+
+	void start(Poco::Util::Timer& timer);
+		/// Starts advancing the wheel, using the given Timer.
+
+	void stop();
+		/// Stops advancing the wheel.
+
+	void add(Listener* pListener, long interval);
+		/// Registers the given listener, which will be called
+		/// every interval milliseconds.
+
+	void remove(Listener* pListener);
+		/// Unregisters the given listener.
+		///
+		/// When remove() returns, the listener is not being called
+		/// and will not be called again. If the listener is currently
+		/// being called by another thread, remove() waits until the
+		/// call has finished. Therefore, remove() must not be called
+		/// while holding a lock the listener may also acquire.
+
+	void tick();
+		/// Advances the wheel by one slot, calling all listeners due.
+		/// Normally called by the TimerTask created by start().
+
+	long resolution() const;
+		/// Returns the resolution of the wheel in milliseconds.
+
+	std::size_t size() const;
+		/// Returns the number of registered listeners.
+
+protected:
+	struct Entry
+	{
+		Poco::UInt64 ticks;
+		Poco::UInt64 due;
+	};
+
+	typedef std::map<Listener*, Entry> ListenerMap;
+	typedef std::vector<Listener*> Slot;
+
+	void schedule(Listener* pListener, Poco::UInt64 due);
+	void unschedule(Listener* pListener, Poco::UInt64 due);
+
+private:
+	TimerWheel(const TimerWheel&);
+	TimerWheel& operator = (const TimerWheel&);
+
+	long _resolution;
+	std::vector<Slot> _slots;
+	ListenerMap _listeners;
+	Poco::UInt64 _tick;
+	Poco::Util::TimerTask::Ptr _pTask;
+	Listener* _pCurrent;
+	Poco::Thread::TID _currentTid;
+	Poco::Condition _currentDone;
+	mutable Poco::Mutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline long TimerWheel::resolution() const
+{
+	return _resolution;
+}
+
+
+} } // namespace IoT::Devices
+
+
+#endif // IoT_Devices_TimerWheel_INCLUDED
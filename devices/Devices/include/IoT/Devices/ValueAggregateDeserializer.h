@@ -0,0 +1,63 @@
+//
+// ValueAggregateDeserializer.h
+//
+// Package: Generated
+// Module:  TypeDeserializer
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TypeDeserializer_IoT_Devices_ValueAggregate_INCLUDED
+#define TypeDeserializer_IoT_Devices_ValueAggregate_INCLUDED
+
+
+#include "IoT/Devices/Sensor.h"
+#include "Poco/RemotingNG/TypeDeserializer.h"
+
+
+namespace Poco {
+namespace RemotingNG {
+
+
+template <>
+class TypeDeserializer<IoT::Devices::ValueAggregate>
+{
+public:
+	static bool deserialize(const std::string& name, bool isMandatory, Deserializer& deser, IoT::Devices::ValueAggregate& value)
+	{
+		bool ret = deser.deserializeStructBegin(name, isMandatory);
+		if (ret)
+		{
+			deserializeImpl(deser, value);
+			deser.deserializeStructEnd(name);
+		}
+		return ret;
+	}
+
+	static void deserializeImpl(Deserializer& deser, IoT::Devices::ValueAggregate& value)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"count","maximum","mean","minimum"};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		TypeDeserializer<int >::deserialize(REMOTING__NAMES[0], true, deser, value.count);
+		TypeDeserializer<double >::deserialize(REMOTING__NAMES[1], true, deser, value.maximum);
+		TypeDeserializer<double >::deserialize(REMOTING__NAMES[2], true, deser, value.mean);
+		TypeDeserializer<double >::deserialize(REMOTING__NAMES[3], true, deser, value.minimum);
+	}
+
+};
+
+
+} // namespace RemotingNG
+} // namespace Poco
+
+
+#endif // TypeDeserializer_IoT_Devices_ValueAggregate_INCLUDED
+
@@ -0,0 +1,59 @@
+//
+// ValueAggregateSerializer.h
+//
+// Package: Generated
+// Module:  TypeSerializer
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TypeSerializer_IoT_Devices_ValueAggregate_INCLUDED
+#define TypeSerializer_IoT_Devices_ValueAggregate_INCLUDED
+
+
+#include "IoT/Devices/Sensor.h"
+#include "Poco/RemotingNG/TypeSerializer.h"
+
+
+namespace Poco {
+namespace RemotingNG {
+
+
+template <>
+class TypeSerializer<IoT::Devices::ValueAggregate>
+{
+public:
+	static void serialize(const std::string& name, const IoT::Devices::ValueAggregate& value, Serializer& ser)
+	{
+		ser.serializeStructBegin(name);
+		serializeImpl(value, ser);
+		ser.serializeStructEnd(name);
+	}
+
+	static void serializeImpl(const IoT::Devices::ValueAggregate& value, Serializer& ser)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"count","maximum","mean","minimum",""};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		TypeSerializer<int >::serialize(REMOTING__NAMES[0], value.count, ser);
+		TypeSerializer<double >::serialize(REMOTING__NAMES[1], value.maximum, ser);
+		TypeSerializer<double >::serialize(REMOTING__NAMES[2], value.mean, ser);
+		TypeSerializer<double >::serialize(REMOTING__NAMES[3], value.minimum, ser);
+	}
+
+};
+
+
+} // namespace RemotingNG
+} // namespace Poco
+
+
+#endif // TypeSerializer_IoT_Devices_ValueAggregate_INCLUDED
+
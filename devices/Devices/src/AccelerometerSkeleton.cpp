@@ -18,6 +18,8 @@
 #include "IoT/Devices/AccelerometerSkeleton.h"
 #include "IoT/Devices/AccelerationDeserializer.h"
 #include "IoT/Devices/AccelerationSerializer.h"
+#include "IoT/Devices/DevicePropertyDeserializer.h"
+#include "IoT/Devices/DevicePropertySerializer.h"
 #include "Poco/RemotingNG/Deserializer.h"
 #include "Poco/RemotingNG/MethodHandler.h"
 #include "Poco/RemotingNG/RemotingException.h"
@@ -89,6 +91,63 @@ public:
 };
 
 
+class AccelerometerGetPropertiesMethodHandler: public Poco::RemotingNG::MethodHandler
+{
+public:
+	void invoke(Poco::RemotingNG::ServerTransport& remoting__trans, Poco::RemotingNG::Deserializer& remoting__deser, Poco::RemotingNG::RemoteObject::Ptr remoting__pRemoteObject)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"getProperties","names"};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		bool remoting__requestSucceeded = false;
+		try
+		{
+			std::vector < std::string > names;
+			remoting__deser.deserializeMessageBegin(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			Poco::RemotingNG::TypeDeserializer<std::vector < std::string > >::deserialize(REMOTING__NAMES[1], true, remoting__deser, names);
+			remoting__deser.deserializeMessageEnd(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			IoT::Devices::AccelerometerRemoteObject* remoting__pCastedRO = static_cast<IoT::Devices::AccelerometerRemoteObject*>(remoting__pRemoteObject.get());
+			std::vector < IoT::Devices::DeviceProperty > remoting__return = remoting__pCastedRO->getProperties(names);
+			remoting__requestSucceeded = true;
+			Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			remoting__staticInitBegin(REMOTING__REPLY_NAME);
+			static const std::string REMOTING__REPLY_NAME("getPropertiesReply");
+			remoting__staticInitEnd(REMOTING__REPLY_NAME);
+			remoting__ser.serializeMessageBegin(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			Poco::RemotingNG::TypeSerializer<std::vector < IoT::Devices::DeviceProperty > >::serialize(Poco::RemotingNG::SerializerBase::RETURN_PARAM, remoting__return, remoting__ser);
+			remoting__ser.serializeMessageEnd(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+		}
+		catch (Poco::Exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], e);
+			}
+		}
+		catch (std::exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc(e.what());
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+		catch (...)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc("Unknown Exception");
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+	}
+
+};
+
+
 class AccelerometerGetPropertyBoolMethodHandler: public Poco::RemotingNG::MethodHandler
 {
 public:
@@ -721,6 +780,61 @@ public:
 };
 
 
+class AccelerometerSnapshotMethodHandler: public Poco::RemotingNG::MethodHandler
+{
+public:
+	void invoke(Poco::RemotingNG::ServerTransport& remoting__trans, Poco::RemotingNG::Deserializer& remoting__deser, Poco::RemotingNG::RemoteObject::Ptr remoting__pRemoteObject)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"snapshot"};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		bool remoting__requestSucceeded = false;
+		try
+		{
+			remoting__deser.deserializeMessageBegin(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			remoting__deser.deserializeMessageEnd(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			IoT::Devices::AccelerometerRemoteObject* remoting__pCastedRO = static_cast<IoT::Devices::AccelerometerRemoteObject*>(remoting__pRemoteObject.get());
+			std::vector < IoT::Devices::DeviceProperty > remoting__return = remoting__pCastedRO->snapshot();
+			remoting__requestSucceeded = true;
+			Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			remoting__staticInitBegin(REMOTING__REPLY_NAME);
+			static const std::string REMOTING__REPLY_NAME("snapshotReply");
+			remoting__staticInitEnd(REMOTING__REPLY_NAME);
+			remoting__ser.serializeMessageBegin(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			Poco::RemotingNG::TypeSerializer<std::vector < IoT::Devices::DeviceProperty > >::serialize(Poco::RemotingNG::SerializerBase::RETURN_PARAM, remoting__return, remoting__ser);
+			remoting__ser.serializeMessageEnd(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+		}
+		catch (Poco::Exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], e);
+			}
+		}
+		catch (std::exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc(e.what());
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+		catch (...)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc("Unknown Exception");
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+	}
+
+};
+
+
 class AccelerometerAccelerationMethodHandler: public Poco::RemotingNG::MethodHandler
 {
 public:
@@ -782,6 +896,7 @@ AccelerometerSkeleton::AccelerometerSkeleton():
 {
 	addMethodHandler("acceleration", new IoT::Devices::AccelerometerAccelerationMethodHandler);
 	addMethodHandler("getFeature", new IoT::Devices::AccelerometerGetFeatureMethodHandler);
+	addMethodHandler("getProperties", new IoT::Devices::AccelerometerGetPropertiesMethodHandler);
 	addMethodHandler("getPropertyBool", new IoT::Devices::AccelerometerGetPropertyBoolMethodHandler);
 	addMethodHandler("getPropertyDouble", new IoT::Devices::AccelerometerGetPropertyDoubleMethodHandler);
 	addMethodHandler("getPropertyInt", new IoT::Devices::AccelerometerGetPropertyIntMethodHandler);
@@ -793,6 +908,7 @@ AccelerometerSkeleton::AccelerometerSkeleton():
 	addMethodHandler("setPropertyDouble", new IoT::Devices::AccelerometerSetPropertyDoubleMethodHandler);
 	addMethodHandler("setPropertyInt", new IoT::Devices::AccelerometerSetPropertyIntMethodHandler);
 	addMethodHandler("setPropertyString", new IoT::Devices::AccelerometerSetPropertyStringMethodHandler);
+	addMethodHandler("snapshot", new IoT::Devices::AccelerometerSnapshotMethodHandler);
 }
 
 
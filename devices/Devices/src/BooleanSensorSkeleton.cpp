@@ -16,6 +16,8 @@
 
 
 #include "IoT/Devices/BooleanSensorSkeleton.h"
+#include "IoT/Devices/DevicePropertyDeserializer.h"
+#include "IoT/Devices/DevicePropertySerializer.h"
 #include "Poco/RemotingNG/Deserializer.h"
 #include "Poco/RemotingNG/MethodHandler.h"
 #include "Poco/RemotingNG/RemotingException.h"
@@ -87,6 +89,63 @@ public:
 };
 
 
+class BooleanSensorGetPropertiesMethodHandler: public Poco::RemotingNG::MethodHandler
+{
+public:
+	void invoke(Poco::RemotingNG::ServerTransport& remoting__trans, Poco::RemotingNG::Deserializer& remoting__deser, Poco::RemotingNG::RemoteObject::Ptr remoting__pRemoteObject)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"getProperties","names"};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		bool remoting__requestSucceeded = false;
+		try
+		{
+			std::vector < std::string > names;
+			remoting__deser.deserializeMessageBegin(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			Poco::RemotingNG::TypeDeserializer<std::vector < std::string > >::deserialize(REMOTING__NAMES[1], true, remoting__deser, names);
+			remoting__deser.deserializeMessageEnd(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			IoT::Devices::BooleanSensorRemoteObject* remoting__pCastedRO = static_cast<IoT::Devices::BooleanSensorRemoteObject*>(remoting__pRemoteObject.get());
+			std::vector < IoT::Devices::DeviceProperty > remoting__return = remoting__pCastedRO->getProperties(names);
+			remoting__requestSucceeded = true;
+			Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			remoting__staticInitBegin(REMOTING__REPLY_NAME);
+			static const std::string REMOTING__REPLY_NAME("getPropertiesReply");
+			remoting__staticInitEnd(REMOTING__REPLY_NAME);
+			remoting__ser.serializeMessageBegin(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			Poco::RemotingNG::TypeSerializer<std::vector < IoT::Devices::DeviceProperty > >::serialize(Poco::RemotingNG::SerializerBase::RETURN_PARAM, remoting__return, remoting__ser);
+			remoting__ser.serializeMessageEnd(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+		}
+		catch (Poco::Exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], e);
+			}
+		}
+		catch (std::exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc(e.what());
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+		catch (...)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc("Unknown Exception");
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+	}
+
+};
+
+
 class BooleanSensorGetPropertyBoolMethodHandler: public Poco::RemotingNG::MethodHandler
 {
 public:
@@ -719,6 +778,61 @@ public:
 };
 
 
+class BooleanSensorSnapshotMethodHandler: public Poco::RemotingNG::MethodHandler
+{
+public:
+	void invoke(Poco::RemotingNG::ServerTransport& remoting__trans, Poco::RemotingNG::Deserializer& remoting__deser, Poco::RemotingNG::RemoteObject::Ptr remoting__pRemoteObject)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"snapshot"};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		bool remoting__requestSucceeded = false;
+		try
+		{
+			remoting__deser.deserializeMessageBegin(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			remoting__deser.deserializeMessageEnd(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			IoT::Devices::BooleanSensorRemoteObject* remoting__pCastedRO = static_cast<IoT::Devices::BooleanSensorRemoteObject*>(remoting__pRemoteObject.get());
+			std::vector < IoT::Devices::DeviceProperty > remoting__return = remoting__pCastedRO->snapshot();
+			remoting__requestSucceeded = true;
+			Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			remoting__staticInitBegin(REMOTING__REPLY_NAME);
+			static const std::string REMOTING__REPLY_NAME("snapshotReply");
+			remoting__staticInitEnd(REMOTING__REPLY_NAME);
+			remoting__ser.serializeMessageBegin(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			Poco::RemotingNG::TypeSerializer<std::vector < IoT::Devices::DeviceProperty > >::serialize(Poco::RemotingNG::SerializerBase::RETURN_PARAM, remoting__return, remoting__ser);
+			remoting__ser.serializeMessageEnd(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+		}
+		catch (Poco::Exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], e);
+			}
+		}
+		catch (std::exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc(e.what());
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+		catch (...)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc("Unknown Exception");
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+	}
+
+};
+
+
 class BooleanSensorStateMethodHandler: public Poco::RemotingNG::MethodHandler
 {
 public:
@@ -779,6 +893,7 @@ BooleanSensorSkeleton::BooleanSensorSkeleton():
 
 {
 	addMethodHandler("getFeature", new IoT::Devices::BooleanSensorGetFeatureMethodHandler);
+	addMethodHandler("getProperties", new IoT::Devices::BooleanSensorGetPropertiesMethodHandler);
 	addMethodHandler("getPropertyBool", new IoT::Devices::BooleanSensorGetPropertyBoolMethodHandler);
 	addMethodHandler("getPropertyDouble", new IoT::Devices::BooleanSensorGetPropertyDoubleMethodHandler);
 	addMethodHandler("getPropertyInt", new IoT::Devices::BooleanSensorGetPropertyIntMethodHandler);
@@ -790,6 +905,7 @@ BooleanSensorSkeleton::BooleanSensorSkeleton():
 	addMethodHandler("setPropertyDouble", new IoT::Devices::BooleanSensorSetPropertyDoubleMethodHandler);
 	addMethodHandler("setPropertyInt", new IoT::Devices::BooleanSensorSetPropertyIntMethodHandler);
 	addMethodHandler("setPropertyString", new IoT::Devices::BooleanSensorSetPropertyStringMethodHandler);
+	addMethodHandler("snapshot", new IoT::Devices::BooleanSensorSnapshotMethodHandler);
 	addMethodHandler("state", new IoT::Devices::BooleanSensorStateMethodHandler);
 }
 
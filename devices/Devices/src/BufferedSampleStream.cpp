@@ -0,0 +1,290 @@
+//
+// BufferedSampleStream.cpp
+//
+// Library: IoT/Devices
+// Package: Devices
+// Module:  BufferedSampleStream
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/Devices/BufferedSampleStream.h"
+#include "Poco/Util/TimerTask.h"
+#include "Poco/RefCountedObject.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+namespace
+{
+	std::size_t checkedSize(int value, const char* name)
+	{
+		if (value < 0) throw Poco::InvalidArgumentException(name, "must not be negative");
+		return static_cast<std::size_t>(value);
+	}
+}
+
+
+class BufferedSampleStream::FlushTarget: public Poco::RefCountedObject
+	/// Refers to the BufferedSampleStream from all FlushTasks
+	/// scheduled for it, until the stream is destroyed.
+{
+public:
+	FlushTarget(BufferedSampleStream& stream):
+		_pStream(&stream)
+	{
+	}
+
+	void flushExpired()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		if (_pStream) _pStream->flushExpired();
+	}
+
+	void detach()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_pStream = 0;
+	}
+
+private:
+	BufferedSampleStream* _pStream;
+	Poco::FastMutex _mutex;
+};
+
+
+class BufferedSampleStream::FlushTask: public Poco::Util::TimerTask
+{
+public:
+	FlushTask(Poco::AutoPtr<FlushTarget> pTarget):
+		_pTarget(pTarget)
+	{
+	}
+
+	void run()
+	{
+		_pTarget->flushExpired();
+	}
+
+private:
+	Poco::AutoPtr<FlushTarget> _pTarget;
+};
+
+
+const std::string BufferedSampleStream::TYPE("io.macchina.sampleStream");
+
+
+BufferedSampleStream::BufferedSampleStream(const Params& params):
+	_name(params.name),
+	_symbolicName(params.symbolicName),
+	_deviceIdentifier(params.deviceIdentifier),
+	_physicalQuantity(params.physicalQuantity),
+	_physicalUnit(params.physicalUnit),
+	_channelNames(params.channelNames),
+	_buffer(static_cast<int>(params.channelNames.size()), checkedSize(params.blockSize, "blockSize"), 1000*static_cast<Poco::Timestamp::TimeDiff>(checkedSize(params.blockLatency, "blockLatency")), checkedSize(params.bufferSize, "bufferSize")),
+	_pTimer(params.pTimer)
+{
+	addProperty("name", &BufferedSampleStream::getName);
+	addProperty("type", &BufferedSampleStream::getType);
+	addProperty("symbolicName", &BufferedSampleStream::getSymbolicName);
+	addProperty("deviceIdentifier", &BufferedSampleStream::getDeviceIdentifier);
+	addProperty("physicalQuantity", &BufferedSampleStream::getPhysicalQuantity);
+	addProperty("physicalUnit", &BufferedSampleStream::getPhysicalUnit);
+	addProperty(PROP_BLOCK_SIZE, &BufferedSampleStream::getBlockSize, &BufferedSampleStream::setBlockSize);
+	addProperty(PROP_BLOCK_LATENCY, &BufferedSampleStream::getBlockLatency, &BufferedSampleStream::setBlockLatency);
+	addProperty(PROP_BUFFER_SIZE, &BufferedSampleStream::getBufferSize);
+
+	if (_pTimer)
+	{
+		_pFlushTarget = new FlushTarget(*this);
+		scheduleFlush(_buffer.blockLatency());
+	}
+}
+
+
+BufferedSampleStream::~BufferedSampleStream()
+{
+	if (_pFlushTarget)
+	{
+		// Waits for a flush in progress.
+		_pFlushTarget->detach();
+		if (_pFlushTask) _pFlushTask->cancel();
+	}
+}
+
+
+void BufferedSampleStream::addSample(const Poco::Timestamp& timestamp, const double* values)
+{
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		if (!_buffer.add(timestamp, values)) return;
+	}
+	deliver(false);
+}
+
+
+void BufferedSampleStream::flush()
+{
+	deliver(false);
+}
+
+
+void BufferedSampleStream::flushExpired()
+{
+	deliver(true);
+}
+
+
+void BufferedSampleStream::deliver(bool expiredOnly)
+{
+	// Blocks are taken and delivered while holding the delivery mutex,
+	// so that a block taken later cannot be delivered before an earlier
+	// one. The event is fired without holding the device mutex, so that
+	// delegates can still access the device.
+	Poco::Mutex::ScopedLock deliveryLock(_deliveryMutex);
+
+	SampleBlock block;
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		if (expiredOnly && !_buffer.expired(Poco::Timestamp())) return;
+		if (!_buffer.takeBlock(block)) return;
+	}
+	samplesAvailable(this, block);
+}
+
+
+void BufferedSampleStream::scheduleFlush(Poco::Timestamp::TimeDiff blockLatency)
+{
+	if (_pFlushTask)
+	{
+		_pFlushTask->cancel();
+		_pFlushTask = 0;
+	}
+	if (blockLatency > 0)
+	{
+		// Checking at half the latency delays an incomplete
+		// block by at most 1.5 times the latency.
+		long interval = static_cast<long>(blockLatency/2000);
+		if (interval < 1) interval = 1;
+		_pFlushTask = new FlushTask(_pFlushTarget);
+		_pTimer->scheduleAtFixedRate(_pFlushTask, interval, interval);
+	}
+}
+
+
+int BufferedSampleStream::channels() const
+{
+	return static_cast<int>(_channelNames.size());
+}
+
+
+std::vector<std::string> BufferedSampleStream::channelNames() const
+{
+	return _channelNames;
+}
+
+
+SampleBlock BufferedSampleStream::recentSamples(Poco::Int64 sequence) const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	SampleBlock block;
+	_buffer.recent(sequence, block);
+	return block;
+}
+
+
+Poco::Any BufferedSampleStream::getName(const std::string&) const
+{
+	return _name;
+}
+
+
+Poco::Any BufferedSampleStream::getType(const std::string&) const
+{
+	return TYPE;
+}
+
+
+Poco::Any BufferedSampleStream::getSymbolicName(const std::string&) const
+{
+	return _symbolicName;
+}
+
+
+Poco::Any BufferedSampleStream::getDeviceIdentifier(const std::string&) const
+{
+	return _deviceIdentifier;
+}
+
+
+Poco::Any BufferedSampleStream::getPhysicalQuantity(const std::string&) const
+{
+	return _physicalQuantity;
+}
+
+
+Poco::Any BufferedSampleStream::getPhysicalUnit(const std::string&) const
+{
+	return _physicalUnit;
+}
+
+
+Poco::Any BufferedSampleStream::getBlockSize(const std::string&) const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	return static_cast<int>(_buffer.blockSize());
+}
+
+
+void BufferedSampleStream::setBlockSize(const std::string&, const Poco::Any& value)
+{
+	int blockSize = Poco::AnyCast<int>(value);
+	if (blockSize < 1) throw Poco::InvalidArgumentException("blockSize must be at least 1");
+
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	_buffer.setBlockSize(blockSize);
+}
+
+
+Poco::Any BufferedSampleStream::getBlockLatency(const std::string&) const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	return static_cast<int>(_buffer.blockLatency()/1000);
+}
+
+
+void BufferedSampleStream::setBlockLatency(const std::string&, const Poco::Any& value)
+{
+	int blockLatency = Poco::AnyCast<int>(value);
+	if (blockLatency < 0) throw Poco::InvalidArgumentException("blockLatency must not be negative");
+
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	_buffer.setBlockLatency(1000*static_cast<Poco::Timestamp::TimeDiff>(blockLatency));
+	if (_pTimer) scheduleFlush(_buffer.blockLatency());
+}
+
+
+Poco::Any BufferedSampleStream::getBufferSize(const std::string&) const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	return static_cast<int>(_buffer.capacity());
+}
+
+
+} } // namespace IoT::Devices
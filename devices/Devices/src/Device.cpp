@@ -13,6 +13,7 @@
 
 
 #include "IoT/Devices/Device.h"
+#include "Poco/Exception.h"
 
 
 namespace IoT {
@@ -29,4 +30,72 @@ Device::~Device()
 }
 
 
+std::vector<DeviceProperty> Device::getProperties(const std::vector<std::string>& names) const
+{
+	std::vector<DeviceProperty> properties(names.size());
+	for (std::size_t i = 0; i < names.size(); i++)
+	{
+		DeviceProperty& property = properties[i];
+		property.name = names[i];
+		property.type = DEVICE_PROPERTY_UNKNOWN;
+		property.intValue = 0;
+		property.doubleValue = 0.0;
+		property.boolValue = false;
+		if (!hasProperty(property.name)) continue;
+
+		// The type of the property is not known here,
+		// so the getters are tried one after the other.
+		try
+		{
+			property.stringValue = getPropertyString(property.name);
+			property.type = DEVICE_PROPERTY_STRING;
+			continue;
+		}
+		catch (Poco::Exception&)
+		{
+		}
+		try
+		{
+			property.intValue = getPropertyInt(property.name);
+			property.type = DEVICE_PROPERTY_INT;
+			continue;
+		}
+		catch (Poco::Exception&)
+		{
+		}
+		try
+		{
+			property.doubleValue = getPropertyDouble(property.name);
+			property.type = DEVICE_PROPERTY_DOUBLE;
+			continue;
+		}
+		catch (Poco::Exception&)
+		{
+		}
+		try
+		{
+			property.boolValue = getPropertyBool(property.name);
+			property.type = DEVICE_PROPERTY_BOOL;
+		}
+		catch (Poco::Exception&)
+		{
+		}
+	}
+	return properties;
+}
+
+
+std::vector<DeviceProperty> Device::snapshot() const
+{
+	static const char* const STANDARD_PROPERTIES[] = {"symbolicName", "type", "name", "status"};
+
+	std::vector<std::string> names;
+	for (std::size_t i = 0; i < sizeof(STANDARD_PROPERTIES)/sizeof(STANDARD_PROPERTIES[0]); i++)
+	{
+		if (hasProperty(STANDARD_PROPERTIES[i])) names.push_back(STANDARD_PROPERTIES[i]);
+	}
+	return getProperties(names);
+}
+
+
 } } // namespace IoT::Devices
@@ -0,0 +1,61 @@
+//
+// ISampleStream.cpp
+//
+// Library: IoT/Devices
+// Package: Generated
+// Module:  ISampleStream
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/Devices/ISampleStream.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+ISampleStream::ISampleStream():
+	IoT::Devices::IDevice(),
+	samplesAvailable()
+{
+}
+
+
+ISampleStream::~ISampleStream()
+{
+}
+
+
+bool ISampleStream::isA(const std::type_info& otherType) const
+{
+	std::string name(type().name());
+	return name == otherType.name();
+}
+
+
+const Poco::RemotingNG::Identifiable::TypeId& ISampleStream::remoting__typeId()
+{
+	remoting__staticInitBegin(REMOTING__TYPE_ID);
+	static const std::string REMOTING__TYPE_ID("IoT.Devices.SampleStream");
+	remoting__staticInitEnd(REMOTING__TYPE_ID);
+	return REMOTING__TYPE_ID;
+}
+
+
+const std::type_info& ISampleStream::type() const
+{
+	return typeid(ISampleStream);
+}
+
+
+} // namespace Devices
+} // namespace IoT
+
@@ -24,6 +24,7 @@ namespace Devices {
 
 ISensor::ISensor():
 	IoT::Devices::IDevice(),
+	valueAggregated(),
 	valueChanged()
 {
 }
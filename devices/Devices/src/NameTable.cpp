@@ -0,0 +1,97 @@
+//
+// NameTable.cpp
+//
+// Library: IoT/Devices
+// Package: Devices
+// Module:  NameTable
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/Devices/NameTable.h"
+#include "Poco/Hash.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+const std::size_t NameTable::NOT_FOUND(static_cast<std::size_t>(-1));
+
+
+NameTable::NameTable():
+	_slots(8, NOT_FOUND),
+	_mask(7)
+{
+}
+
+
+NameTable::~NameTable()
+{
+}
+
+
+std::size_t NameTable::add(const std::string& name)
+{
+	std::size_t hash = Poco::hash(name);
+	std::size_t index = find(name, hash);
+	if (index != NOT_FOUND) return index;
+
+	index = _names.size();
+	_names.push_back(name);
+	_hashes.push_back(hash);
+
+	// keep the load factor at or below 1/2
+	if (2*_names.size() > _slots.size())
+	{
+		rehash();
+	}
+	else
+	{
+		std::size_t slot = hash & _mask;
+		while (_slots[slot] != NOT_FOUND) slot = (slot + 1) & _mask;
+		_slots[slot] = index;
+	}
+	return index;
+}
+
+
+std::size_t NameTable::find(const std::string& name) const
+{
+	return find(name, Poco::hash(name));
+}
+
+
+std::size_t NameTable::find(const std::string& name, std::size_t hash) const
+{
+	std::size_t slot = hash & _mask;
+	std::size_t index = _slots[slot];
+	while (index != NOT_FOUND)
+	{
+		if (_hashes[index] == hash && _names[index] == name) return index;
+		slot = (slot + 1) & _mask;
+		index = _slots[slot];
+	}
+	return NOT_FOUND;
+}
+
+
+void NameTable::rehash()
+{
+	std::vector<std::size_t> slots(2*_slots.size(), NOT_FOUND);
+	_mask = slots.size() - 1;
+	for (std::size_t index = 0; index < _names.size(); index++)
+	{
+		std::size_t slot = _hashes[index] & _mask;
+		while (slots[slot] != NOT_FOUND) slot = (slot + 1) & _mask;
+		slots[slot] = index;
+	}
+	_slots.swap(slots);
+}
+
+
+} } // namespace IoT::Devices
@@ -0,0 +1,156 @@
+//
+// SampleBuffer.cpp
+//
+// Library: IoT/Devices
+// Package: Devices
+// Module:  SampleBuffer
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/Devices/SampleBuffer.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+#include <limits>
+
+
+namespace IoT {
+namespace Devices {
+
+
+SampleBuffer::SampleBuffer(int channels, std::size_t blockSize, Poco::Timestamp::TimeDiff blockLatency, std::size_t capacity):
+	_channels(channels),
+	_blockSize(blockSize),
+	_blockLatency(blockLatency),
+	_capacity(capacity < blockSize ? blockSize : capacity),
+	_firstSequence(0),
+	_blockSequence(0),
+	_nextSequence(0)
+{
+	if (channels < 1) throw Poco::InvalidArgumentException("SampleBuffer requires at least one channel");
+	if (blockSize < 1) throw Poco::InvalidArgumentException("SampleBuffer block size must be at least 1");
+	if (_capacity > std::numeric_limits<std::size_t>::max()/sizeof(double)/channels) throw Poco::InvalidArgumentException("SampleBuffer capacity too large");
+
+	_timestamps.resize(_capacity);
+	_values.resize(_capacity*channels);
+}
+
+
+SampleBuffer::~SampleBuffer()
+{
+}
+
+
+void SampleBuffer::setBlockSize(std::size_t blockSize)
+{
+	if (blockSize < 1) throw Poco::InvalidArgumentException("SampleBuffer block size must be at least 1");
+	if (blockSize > std::numeric_limits<std::size_t>::max()/sizeof(double)/_channels) throw Poco::InvalidArgumentException("SampleBuffer block size too large");
+
+	if (blockSize > _capacity) resize(blockSize);
+	_blockSize = blockSize;
+}
+
+
+void SampleBuffer::setBlockLatency(Poco::Timestamp::TimeDiff blockLatency)
+{
+	_blockLatency = blockLatency;
+}
+
+
+bool SampleBuffer::add(const Poco::Timestamp& timestamp, const double* values)
+{
+	if (size() == _capacity)
+	{
+		// Overwrite the oldest sample. If nobody has taken the
+		// current block, the oldest pending sample is lost as well.
+		if (_blockSequence == _firstSequence) _blockSequence++;
+		_firstSequence++;
+	}
+
+	std::size_t i = index(_nextSequence);
+	_timestamps[i] = timestamp.epochMicroseconds();
+	std::copy(values, values + _channels, _values.begin() + i*_channels);
+	_nextSequence++;
+
+	std::size_t n = pending();
+	if (n >= _blockSize) return true;
+	return _blockLatency > 0 && timestamp.epochMicroseconds() - _timestamps[index(_blockSequence)] >= _blockLatency;
+}
+
+
+bool SampleBuffer::expired(const Poco::Timestamp& now) const
+{
+	return pending() > 0 && _blockLatency > 0 && now.epochMicroseconds() - _timestamps[index(_blockSequence)] >= _blockLatency;
+}
+
+
+bool SampleBuffer::takeBlock(SampleBlock& block)
+{
+	if (pending() == 0) return false;
+
+	copy(_blockSequence, block);
+	_blockSequence = _nextSequence;
+	return true;
+}
+
+
+void SampleBuffer::recent(Poco::Int64 sequence, SampleBlock& block) const
+{
+	copy(sequence < _firstSequence ? _firstSequence : sequence, block);
+}
+
+
+void SampleBuffer::clear()
+{
+	_firstSequence = _nextSequence;
+	_blockSequence = _nextSequence;
+}
+
+
+void SampleBuffer::copy(Poco::Int64 sequence, SampleBlock& block) const
+{
+	block.sequence = sequence;
+	block.channels = _channels;
+	block.timestamps.clear();
+	block.samples.clear();
+	if (sequence >= _nextSequence) return;
+
+	std::size_t n = static_cast<std::size_t>(_nextSequence - sequence);
+	block.timestamps.reserve(n);
+	block.samples.reserve(n*_channels);
+
+	// The samples occupy at most two contiguous ranges of the ring buffer.
+	std::size_t first = index(sequence);
+	std::size_t count = n < _capacity - first ? n : _capacity - first;
+	block.timestamps.insert(block.timestamps.end(), _timestamps.begin() + first, _timestamps.begin() + first + count);
+	block.samples.insert(block.samples.end(), _values.begin() + first*_channels, _values.begin() + (first + count)*_channels);
+	if (count < n)
+	{
+		block.timestamps.insert(block.timestamps.end(), _timestamps.begin(), _timestamps.begin() + (n - count));
+		block.samples.insert(block.samples.end(), _values.begin(), _values.begin() + (n - count)*_channels);
+	}
+}
+
+
+void SampleBuffer::resize(std::size_t capacity)
+{
+	SampleBlock block;
+	copy(_firstSequence, block);
+
+	_capacity = capacity;
+	_timestamps.assign(_capacity, 0);
+	_values.assign(_capacity*_channels, 0.0);
+	for (std::size_t k = 0; k < block.timestamps.size(); k++)
+	{
+		std::size_t i = index(_firstSequence + k);
+		_timestamps[i] = block.timestamps[k];
+		std::copy(block.samples.begin() + k*_channels, block.samples.begin() + (k + 1)*_channels, _values.begin() + i*_channels);
+	}
+}
+
+
+} } // namespace IoT::Devices
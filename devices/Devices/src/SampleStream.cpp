@@ -0,0 +1,37 @@
+//
+// SampleStream.cpp
+//
+// Library: IoT/Devices
+// Package: Devices
+// Module:  SampleStream
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/Devices/SampleStream.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+const std::string SampleStream::PROP_BLOCK_SIZE("blockSize");
+const std::string SampleStream::PROP_BLOCK_LATENCY("blockLatency");
+const std::string SampleStream::PROP_BUFFER_SIZE("bufferSize");
+
+
+SampleStream::SampleStream()
+{
+}
+
+
+SampleStream::~SampleStream()
+{
+}
+
+
+} } // namespace IoT::Devices
@@ -0,0 +1,160 @@
+//
+// SampleStreamEventDispatcher.cpp
+//
+// Library: IoT/Devices
+// Package: Generated
+// Module:  SampleStreamEventDispatcher
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/Devices/SampleStreamEventDispatcher.h"
+#include "IoT/Devices/DeviceStatusChangeDeserializer.h"
+#include "IoT/Devices/DeviceStatusChangeSerializer.h"
+#include "IoT/Devices/SampleBlockDeserializer.h"
+#include "IoT/Devices/SampleBlockSerializer.h"
+#include "Poco/Delegate.h"
+#include "Poco/RemotingNG/Deserializer.h"
+#include "Poco/RemotingNG/RemotingException.h"
+#include "Poco/RemotingNG/Serializer.h"
+#include "Poco/RemotingNG/TypeDeserializer.h"
+#include "Poco/RemotingNG/TypeSerializer.h"
+#include "Poco/RemotingNG/URIUtility.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+SampleStreamEventDispatcher::SampleStreamEventDispatcher(SampleStreamRemoteObject* pRemoteObject, const std::string& protocol):
+	Poco::RemotingNG::EventDispatcher(protocol),
+	_pRemoteObject(pRemoteObject)
+{
+	_pRemoteObject->samplesAvailable += Poco::delegate(this, &SampleStreamEventDispatcher::event__samplesAvailable);
+	_pRemoteObject->statusChanged += Poco::delegate(this, &SampleStreamEventDispatcher::event__statusChanged);
+}
+
+
+SampleStreamEventDispatcher::~SampleStreamEventDispatcher()
+{
+	try
+	{
+		_pRemoteObject->samplesAvailable -= Poco::delegate(this, &SampleStreamEventDispatcher::event__samplesAvailable);
+		_pRemoteObject->statusChanged -= Poco::delegate(this, &SampleStreamEventDispatcher::event__statusChanged);
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void SampleStreamEventDispatcher::event__samplesAvailable(const void* pSender, const IoT::Devices::SampleBlock& data)
+{
+	if (pSender)
+	{
+		Poco::Clock now;
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		SubscriberMap::iterator it = _subscribers.begin();
+		while (it != _subscribers.end())
+		{
+			if (it->second->expireTime != 0 && it->second->expireTime < now)
+			{
+				SubscriberMap::iterator itDel(it++);
+				_subscribers.erase(itDel);
+			}
+			else
+			{
+				try
+				{
+					event__samplesAvailableImpl(it->first, data);
+				}
+				catch (Poco::RemotingNG::RemoteException&)
+				{
+					throw;
+				}
+				catch (Poco::Exception&)
+				{
+				}
+				++it;
+			}
+		}
+	}
+}
+
+
+void SampleStreamEventDispatcher::event__statusChanged(const void* pSender, const IoT::Devices::DeviceStatusChange& data)
+{
+	if (pSender)
+	{
+		Poco::Clock now;
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		SubscriberMap::iterator it = _subscribers.begin();
+		while (it != _subscribers.end())
+		{
+			if (it->second->expireTime != 0 && it->second->expireTime < now)
+			{
+				SubscriberMap::iterator itDel(it++);
+				_subscribers.erase(itDel);
+			}
+			else
+			{
+				try
+				{
+					event__statusChangedImpl(it->first, data);
+				}
+				catch (Poco::RemotingNG::RemoteException&)
+				{
+					throw;
+				}
+				catch (Poco::Exception&)
+				{
+				}
+				++it;
+			}
+		}
+	}
+}
+
+
+void SampleStreamEventDispatcher::event__samplesAvailableImpl(const std::string& subscriberURI, const IoT::Devices::SampleBlock& data)
+{
+	remoting__staticInitBegin(REMOTING__NAMES);
+	static const std::string REMOTING__NAMES[] = {"samplesAvailable","subscriberURI","data"};
+	remoting__staticInitEnd(REMOTING__NAMES);
+	Poco::RemotingNG::Transport& remoting__trans = transportForSubscriber(subscriberURI);
+	Poco::ScopedLock<Poco::RemotingNG::Transport> remoting__lock(remoting__trans);
+	Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.beginMessage(_pRemoteObject->remoting__objectId(), _pRemoteObject->remoting__typeId(), REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+	remoting__ser.serializeMessageBegin(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+	Poco::RemotingNG::TypeSerializer<IoT::Devices::SampleBlock >::serialize(REMOTING__NAMES[2], data, remoting__ser);
+	remoting__ser.serializeMessageEnd(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+	remoting__trans.sendMessage(_pRemoteObject->remoting__objectId(), _pRemoteObject->remoting__typeId(), REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+}
+
+
+void SampleStreamEventDispatcher::event__statusChangedImpl(const std::string& subscriberURI, const IoT::Devices::DeviceStatusChange& data)
+{
+	remoting__staticInitBegin(REMOTING__NAMES);
+	static const std::string REMOTING__NAMES[] = {"statusChanged","subscriberURI","data"};
+	remoting__staticInitEnd(REMOTING__NAMES);
+	Poco::RemotingNG::Transport& remoting__trans = transportForSubscriber(subscriberURI);
+	Poco::ScopedLock<Poco::RemotingNG::Transport> remoting__lock(remoting__trans);
+	Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.beginMessage(_pRemoteObject->remoting__objectId(), _pRemoteObject->remoting__typeId(), REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+	remoting__ser.serializeMessageBegin(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+	Poco::RemotingNG::TypeSerializer<IoT::Devices::DeviceStatusChange >::serialize(REMOTING__NAMES[2], data, remoting__ser);
+	remoting__ser.serializeMessageEnd(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+	remoting__trans.sendMessage(_pRemoteObject->remoting__objectId(), _pRemoteObject->remoting__typeId(), REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+}
+
+
+const std::string SampleStreamEventDispatcher::DEFAULT_NS("");
+} // namespace Devices
+} // namespace IoT
+
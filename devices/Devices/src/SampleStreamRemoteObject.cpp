@@ -0,0 +1,77 @@
+//
+// SampleStreamRemoteObject.cpp
+//
+// Library: IoT/Devices
+// Package: Generated
+// Module:  SampleStreamRemoteObject
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/Devices/SampleStreamRemoteObject.h"
+#include "IoT/Devices/SampleStreamEventDispatcher.h"
+#include "Poco/Delegate.h"
+#include "Poco/RemotingNG/ORB.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+SampleStreamRemoteObject::SampleStreamRemoteObject(const Poco::RemotingNG::Identifiable::ObjectId& oid, Poco::SharedPtr<IoT::Devices::SampleStream> pServiceObject):
+	IoT::Devices::ISampleStream(),
+	Poco::RemotingNG::RemoteObject(oid),
+	_pServiceObject(pServiceObject)
+{
+	_pServiceObject->samplesAvailable += Poco::delegate(this, &SampleStreamRemoteObject::event__samplesAvailable);
+}
+
+
+SampleStreamRemoteObject::~SampleStreamRemoteObject()
+{
+	try
+	{
+		_pServiceObject->samplesAvailable -= Poco::delegate(this, &SampleStreamRemoteObject::event__samplesAvailable);
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+std::string SampleStreamRemoteObject::remoting__enableEvents(Poco::RemotingNG::Listener::Ptr pListener, bool enable)
+{
+	return std::string();
+}
+
+
+void SampleStreamRemoteObject::remoting__enableRemoteEvents(const std::string& protocol)
+{
+	Poco::RemotingNG::EventDispatcher::Ptr pEventDispatcher = new SampleStreamEventDispatcher(this, protocol);
+	Poco::RemotingNG::ORB::instance().registerEventDispatcher(remoting__getURI().toString(), pEventDispatcher);
+}
+
+
+bool SampleStreamRemoteObject::remoting__hasEvents() const
+{
+	return true;
+}
+
+
+void SampleStreamRemoteObject::event__samplesAvailable(const IoT::Devices::SampleBlock& data)
+{
+	samplesAvailable(this, data);
+}
+
+
+} // namespace Devices
+} // namespace IoT
+
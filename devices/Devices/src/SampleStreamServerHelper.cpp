@@ -0,0 +1,105 @@
+//
+// SampleStreamServerHelper.cpp
+//
+// Library: IoT/Devices
+// Package: Generated
+// Module:  SampleStreamServerHelper
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2014-2015, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/Devices/SampleStreamServerHelper.h"
+#include "IoT/Devices/SampleStreamEventDispatcher.h"
+#include "IoT/Devices/SampleStreamSkeleton.h"
+#include "Poco/RemotingNG/URIUtility.h"
+#include "Poco/SingletonHolder.h"
+
+
+namespace IoT {
+namespace Devices {
+
+
+namespace
+{
+	static Poco::SingletonHolder<SampleStreamServerHelper> shSampleStreamServerHelper;
+}
+
+
+SampleStreamServerHelper::SampleStreamServerHelper():
+	_pORB(0)
+{
+	_pORB = &Poco::RemotingNG::ORB::instance();
+	registerSkeleton();
+}
+
+
+SampleStreamServerHelper::~SampleStreamServerHelper()
+{
+}
+
+
+void SampleStreamServerHelper::shutdown()
+{
+	SampleStreamServerHelper::instance().unregisterSkeleton();
+	shSampleStreamServerHelper.reset();
+}
+
+
+Poco::AutoPtr<IoT::Devices::SampleStreamRemoteObject> SampleStreamServerHelper::createRemoteObjectImpl(Poco::SharedPtr<IoT::Devices::SampleStream> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid)
+{
+	return new SampleStreamRemoteObject(oid, pServiceObject);
+}
+
+
+void SampleStreamServerHelper::enableEventsImpl(const std::string& uri, const std::string& protocol)
+{
+	Poco::RemotingNG::Identifiable::Ptr pIdentifiable = _pORB->findObject(uri);
+	Poco::AutoPtr<SampleStreamRemoteObject> pRemoteObject = pIdentifiable.cast<SampleStreamRemoteObject>();
+	if (pRemoteObject)
+	{
+		pRemoteObject->remoting__enableRemoteEvents(protocol);
+	}
+	else throw Poco::NotFoundException("remote object", uri);
+}
+
+
+SampleStreamServerHelper& SampleStreamServerHelper::instance()
+{
+	return *shSampleStreamServerHelper.get();
+}
+
+
+std::string SampleStreamServerHelper::registerObjectImpl(Poco::AutoPtr<IoT::Devices::SampleStreamRemoteObject> pRemoteObject, const std::string& listenerId)
+{
+	return _pORB->registerObject(pRemoteObject, listenerId);
+}
+
+
+void SampleStreamServerHelper::registerSkeleton()
+{
+	_pORB->registerSkeleton("IoT.Devices.SampleStream", new SampleStreamSkeleton);
+}
+
+
+void SampleStreamServerHelper::unregisterObjectImpl(const std::string& uri)
+{
+	_pORB->unregisterObject(uri);
+}
+
+
+void SampleStreamServerHelper::unregisterSkeleton()
+{
+	_pORB->unregisterSkeleton("IoT.Devices.SampleStream", true);
+}
+
+
+} // namespace Devices
+} // namespace IoT
+
@@ -18,6 +18,8 @@
 #include "IoT/Devices/SensorEventDispatcher.h"
 #include "IoT/Devices/DeviceStatusChangeDeserializer.h"
 #include "IoT/Devices/DeviceStatusChangeSerializer.h"
+#include "IoT/Devices/ValueAggregateDeserializer.h"
+#include "IoT/Devices/ValueAggregateSerializer.h"
 #include "Poco/Delegate.h"
 #include "Poco/RemotingNG/Deserializer.h"
 #include "Poco/RemotingNG/RemotingException.h"
@@ -35,6 +37,7 @@ SensorEventDispatcher::SensorEventDispatcher(SensorRemoteObject* pRemoteObject,
 	Poco::RemotingNG::EventDispatcher(protocol),
 	_pRemoteObject(pRemoteObject)
 {
+	_pRemoteObject->valueAggregated += Poco::delegate(this, &SensorEventDispatcher::event__valueAggregated);
 	_pRemoteObject->valueChanged += Poco::delegate(this, &SensorEventDispatcher::event__valueChanged);
 	_pRemoteObject->statusChanged += Poco::delegate(this, &SensorEventDispatcher::event__statusChanged);
 }
@@ -44,6 +47,7 @@ SensorEventDispatcher::~SensorEventDispatcher()
 {
 	try
 	{
+		_pRemoteObject->valueAggregated -= Poco::delegate(this, &SensorEventDispatcher::event__valueAggregated);
 		_pRemoteObject->valueChanged -= Poco::delegate(this, &SensorEventDispatcher::event__valueChanged);
 		_pRemoteObject->statusChanged -= Poco::delegate(this, &SensorEventDispatcher::event__statusChanged);
 	}
@@ -88,6 +92,40 @@ void SensorEventDispatcher::event__statusChanged(const void* pSender, const IoT:
 }
 
 
+void SensorEventDispatcher::event__valueAggregated(const void* pSender, const IoT::Devices::ValueAggregate& data)
+{
+	if (pSender)
+	{
+		Poco::Clock now;
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		SubscriberMap::iterator it = _subscribers.begin();
+		while (it != _subscribers.end())
+		{
+			if (it->second->expireTime != 0 && it->second->expireTime < now)
+			{
+				SubscriberMap::iterator itDel(it++);
+				_subscribers.erase(itDel);
+			}
+			else
+			{
+				try
+				{
+					event__valueAggregatedImpl(it->first, data);
+				}
+				catch (Poco::RemotingNG::RemoteException&)
+				{
+					throw;
+				}
+				catch (Poco::Exception&)
+				{
+				}
+				++it;
+			}
+		}
+	}
+}
+
+
 void SensorEventDispatcher::event__valueChanged(const void* pSender, const double& data)
 {
 	remoting__staticInitBegin(REMOTING__EVENT_NAME);
@@ -143,6 +181,21 @@ void SensorEventDispatcher::event__statusChangedImpl(const std::string& subscrib
 }
 
 
+void SensorEventDispatcher::event__valueAggregatedImpl(const std::string& subscriberURI, const IoT::Devices::ValueAggregate& data)
+{
+	remoting__staticInitBegin(REMOTING__NAMES);
+	static const std::string REMOTING__NAMES[] = {"valueAggregated","subscriberURI","data"};
+	remoting__staticInitEnd(REMOTING__NAMES);
+	Poco::RemotingNG::Transport& remoting__trans = transportForSubscriber(subscriberURI);
+	Poco::ScopedLock<Poco::RemotingNG::Transport> remoting__lock(remoting__trans);
+	Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.beginMessage(_pRemoteObject->remoting__objectId(), _pRemoteObject->remoting__typeId(), REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+	remoting__ser.serializeMessageBegin(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+	Poco::RemotingNG::TypeSerializer<IoT::Devices::ValueAggregate >::serialize(REMOTING__NAMES[2], data, remoting__ser);
+	remoting__ser.serializeMessageEnd(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+	remoting__trans.sendMessage(_pRemoteObject->remoting__objectId(), _pRemoteObject->remoting__typeId(), REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_EVENT);
+}
+
+
 void SensorEventDispatcher::event__valueChangedImpl(const std::string& subscriberURI, const double& data)
 {
 	remoting__staticInitBegin(REMOTING__NAMES);
@@ -30,6 +30,7 @@ SensorRemoteObject::SensorRemoteObject(const Poco::RemotingNG::Identifiable::Obj
 	Poco::RemotingNG::RemoteObject(oid),
 	_pServiceObject(pServiceObject)
 {
+	_pServiceObject->valueAggregated += Poco::delegate(this, &SensorRemoteObject::event__valueAggregated);
 	_pServiceObject->valueChanged += Poco::delegate(this, &SensorRemoteObject::event__valueChanged);
 }
 
@@ -38,6 +39,7 @@ SensorRemoteObject::~SensorRemoteObject()
 {
 	try
 	{
+		_pServiceObject->valueAggregated -= Poco::delegate(this, &SensorRemoteObject::event__valueAggregated);
 		_pServiceObject->valueChanged -= Poco::delegate(this, &SensorRemoteObject::event__valueChanged);
 	}
 	catch (...)
@@ -66,6 +68,12 @@ bool SensorRemoteObject::remoting__hasEvents() const
 }
 
 
+void SensorRemoteObject::event__valueAggregated(const IoT::Devices::ValueAggregate& data)
+{
+	valueAggregated(this, data);
+}
+
+
 void SensorRemoteObject::event__valueChanged(const double& data)
 {
 	valueChanged(this, data);
@@ -0,0 +1,217 @@
+//
+// TimerWheel.cpp
+//
+// Library: IoT/Devices
+// Package: Devices
+// Module:  Utilities
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/Devices/TimerWheel.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+
+
+namespace IoT {
+namespace Devices {
+
+
+namespace
+{
+	class TickTask: public Poco::Util::TimerTask
+	{
+	public:
+		TickTask(TimerWheel& wheel):
+			_wheel(wheel)
+		{
+		}
+
+		void run()
+		{
+			_wheel.tick();
+		}
+
+	private:
+		TimerWheel& _wheel;
+	};
+}
+
+
+TimerWheel::Listener::~Listener()
+{
+}
+
+
+TimerWheel::TimerWheel(long resolution, std::size_t slots):
+	_resolution(resolution),
+	_slots(slots),
+	_tick(0),
+	_pCurrent(0),
+	_currentTid(0)
+{
+	if (resolution < 1) throw Poco::InvalidArgumentException("TimerWheel resolution must be at least 1 ms");
+	if (slots < 1) throw Poco::InvalidArgumentException("TimerWheel requires at least one slot");
+}
+
+
+TimerWheel::~TimerWheel()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void TimerWheel::start(Poco::Util::Timer& timer)
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	if (_pTask) throw Poco::IllegalStateException("TimerWheel already started");
+
+	_pTask = new TickTask(*this);
+	timer.scheduleAtFixedRate(_pTask, _resolution, _resolution);
+}
+
+
+void TimerWheel::stop()
+{
+	Poco::Util::TimerTask::Ptr pTask;
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		pTask.swap(_pTask);
+	}
+	if (pTask) pTask->cancel();
+}
+
+
+void TimerWheel::add(Listener* pListener, long interval)
+{
+	poco_check_ptr (pListener);
+
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	if (_listeners.find(pListener) != _listeners.end()) throw Poco::ExistsException("TimerWheel listener already registered");
+
+	Entry entry;
+	entry.ticks = interval > _resolution ? (interval + _resolution - 1)/_resolution : 1;
+	entry.due = _tick + entry.ticks;
+	_listeners[pListener] = entry;
+	schedule(pListener, entry.due);
+}
+
+
+void TimerWheel::remove(Listener* pListener)
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	ListenerMap::iterator it = _listeners.find(pListener);
+	if (it != _listeners.end())
+	{
+		unschedule(pListener, it->second.due);
+		_listeners.erase(it);
+	}
+	while (_pCurrent == pListener && _currentTid != Poco::Thread::currentTid())
+	{
+		_currentDone.wait(_mutex);
+	}
+}
+
+
+void TimerWheel::tick()
+{
+	Slot due;
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		_tick++;
+		Slot& slot = _slots[_tick % _slots.size()];
+		for (Slot::iterator it = slot.begin(); it != slot.end();)
+		{
+			Entry& entry = _listeners[*it];
+			if (entry.due <= _tick)
+			{
+				due.push_back(*it);
+				entry.due = _tick + entry.ticks;
+				it = slot.erase(it);
+			}
+			else ++it;
+		}
+		for (Slot::const_iterator it = due.begin(); it != due.end(); ++it)
+		{
+			schedule(*it, _listeners[*it].due);
+		}
+	}
+
+	// Listeners are called without holding the mutex, so
+	// that they can add or remove listeners.
+	for (Slot::const_iterator it = due.begin(); it != due.end(); ++it)
+	{
+		{
+			Poco::Mutex::ScopedLock lock(_mutex);
+
+			if (_listeners.find(*it) == _listeners.end()) continue;
+			_pCurrent = *it;
+			_currentTid = Poco::Thread::currentTid();
+		}
+		try
+		{
+			(*it)->onTimerWheelTick();
+		}
+		catch (Poco::Exception& exc)
+		{
+			Poco::ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			Poco::ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			Poco::ErrorHandler::handle();
+		}
+		{
+			Poco::Mutex::ScopedLock lock(_mutex);
+
+			_pCurrent = 0;
+			_currentTid = 0;
+			_currentDone.broadcast();
+		}
+	}
+}
+
+
+std::size_t TimerWheel::size() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	return _listeners.size();
+}
+
+
+void TimerWheel::schedule(Listener* pListener, Poco::UInt64 due)
+{
+	_slots[due % _slots.size()].push_back(pListener);
+}
+
+
+void TimerWheel::unschedule(Listener* pListener, Poco::UInt64 due)
+{
+	Slot& slot = _slots[due % _slots.size()];
+	Slot::iterator it = std::find(slot.begin(), slot.end(), pListener);
+	if (it != slot.end()) slot.erase(it);
+}
+
+
+} } // namespace IoT::Devices
@@ -0,0 +1,65 @@
+//
+// BenchmarkSensor.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "BenchmarkSensor.h"
+
+
+const std::string BenchmarkSensor::TYPE("io.macchina.sensor");
+const std::string BenchmarkSensor::SYMBOLIC_NAME("io.macchina.benchmark.sensor");
+
+
+BenchmarkSensor::BenchmarkSensor():
+	_value(0)
+{
+	addProperty("type", &BenchmarkSensor::getType);
+	addProperty("symbolicName", &BenchmarkSensor::getSymbolicName);
+}
+
+
+BenchmarkSensor::~BenchmarkSensor()
+{
+}
+
+
+void BenchmarkSensor::inject(double value)
+{
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		_value = value;
+	}
+	valueChanged(this, value);
+}
+
+
+double BenchmarkSensor::value() const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	return _value;
+}
+
+
+bool BenchmarkSensor::ready() const
+{
+	return true;
+}
+
+
+Poco::Any BenchmarkSensor::getType(const std::string&) const
+{
+	return TYPE;
+}
+
+
+Poco::Any BenchmarkSensor::getSymbolicName(const std::string&) const
+{
+	return SYMBOLIC_NAME;
+}
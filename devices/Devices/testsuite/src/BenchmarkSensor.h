@@ -0,0 +1,54 @@
+//
+// BenchmarkSensor.h
+//
+// Definition of the BenchmarkSensor class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef BenchmarkSensor_INCLUDED
+#define BenchmarkSensor_INCLUDED
+
+
+#include "IoT/Devices/Sensor.h"
+#include "IoT/Devices/DeviceImpl.h"
+#include "Poco/SharedPtr.h"
+
+
+class BenchmarkSensor: public IoT::Devices::DeviceImpl<IoT::Devices::Sensor, BenchmarkSensor>
+	/// A synthetic Sensor for benchmarks. Every call to inject()
+	/// fires valueChanged with the given value.
+{
+public:
+	typedef Poco::SharedPtr<BenchmarkSensor> Ptr;
+
+	BenchmarkSensor();
+		/// Creates the BenchmarkSensor.
+
+	~BenchmarkSensor();
+		/// Destroys the BenchmarkSensor.
+
+	void inject(double value);
+		/// Sets the sensor value and fires valueChanged.
+
+	// Sensor
+	double value() const;
+	bool ready() const;
+
+	static const std::string TYPE;
+	static const std::string SYMBOLIC_NAME;
+
+protected:
+	Poco::Any getType(const std::string&) const;
+	Poco::Any getSymbolicName(const std::string&) const;
+
+private:
+	double _value;
+};
+
+
+#endif // BenchmarkSensor_INCLUDED
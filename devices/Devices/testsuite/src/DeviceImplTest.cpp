@@ -0,0 +1,432 @@
+//
+// DeviceImplTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "DeviceImplTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "IoT/Devices/Device.h"
+#include "IoT/Devices/DeviceImpl.h"
+#include "IoT/Devices/NameTable.h"
+#include "Poco/NumberFormatter.h"
+
+
+using namespace IoT::Devices;
+
+
+namespace
+{
+	class TestDevice: public DeviceImpl<Device, TestDevice>
+	{
+	public:
+		TestDevice():
+			_anyValue(1.5),
+			_doubleValue(2.5),
+			_intValue(42),
+			_enabled(false)
+		{
+			addProperty("name", &TestDevice::getName);
+			addProperty("anyValue", &TestDevice::getAnyValue, &TestDevice::setAnyValue);
+			addProperty("doubleValue", &TestDevice::getDoubleValue, &TestDevice::setDoubleValue);
+			addProperty("intValue", &TestDevice::getIntValue);
+			addProperty("label", &TestDevice::getLabel, &TestDevice::setLabel);
+			addProperty("enabled", &TestDevice::getEnabled, &TestDevice::setEnabled);
+			addProperty("writeOnly", 0, &TestDevice::setDoubleValue);
+			addFeature("enabled", &TestDevice::getEnabledFeature, &TestDevice::setEnabledFeature);
+			addFeature("readOnly", &TestDevice::getEnabledFeature);
+		}
+
+		Poco::Any getName(const std::string&) const
+		{
+			return std::string("TestDevice");
+		}
+
+		Poco::Any getAnyValue(const std::string&) const
+		{
+			return _anyValue;
+		}
+
+		void setAnyValue(const std::string&, const Poco::Any& value)
+		{
+			_anyValue = Poco::AnyCast<double>(value);
+		}
+
+		double getDoubleValue(const std::string&) const
+		{
+			return _doubleValue;
+		}
+
+		void setDoubleValue(const std::string&, double value)
+		{
+			_doubleValue = value;
+		}
+
+		int getIntValue(const std::string&) const
+		{
+			return _intValue;
+		}
+
+		std::string getLabel(const std::string&) const
+		{
+			return _label;
+		}
+
+		void setLabel(const std::string&, const std::string& label)
+		{
+			_label = label;
+		}
+
+		bool getEnabled(const std::string&) const
+		{
+			return _enabled;
+		}
+
+		void setEnabled(const std::string&, bool enabled)
+		{
+			_enabled = enabled;
+		}
+
+		bool getEnabledFeature(const std::string&) const
+		{
+			return _enabled;
+		}
+
+		void setEnabledFeature(const std::string&, bool enabled)
+		{
+			_enabled = enabled;
+		}
+
+	private:
+		double _anyValue;
+		double _doubleValue;
+		int _intValue;
+		std::string _label;
+		bool _enabled;
+	};
+}
+
+
+DeviceImplTest::DeviceImplTest(const std::string& name):
+	CppUnit::TestCase(name)
+{
+}
+
+
+DeviceImplTest::~DeviceImplTest()
+{
+}
+
+
+void DeviceImplTest::testNameTable()
+{
+	NameTable table;
+	assert (table.size() == 0);
+	assert (table.find("foo") == NameTable::NOT_FOUND);
+
+	for (int i = 0; i < 100; i++)
+	{
+		assert (table.add("name" + Poco::NumberFormatter::format(i)) == static_cast<std::size_t>(i));
+	}
+	assert (table.size() == 100);
+	assert (table.add("name17") == 17);
+	assert (table.size() == 100);
+
+	for (int i = 0; i < 100; i++)
+	{
+		std::string name("name" + Poco::NumberFormatter::format(i));
+		assert (table.find(name) == static_cast<std::size_t>(i));
+		assert (table.name(i) == name);
+	}
+	assert (table.find("name100") == NameTable::NOT_FOUND);
+	assert (table.find("") == NameTable::NOT_FOUND);
+}
+
+
+void DeviceImplTest::testAnyProperties()
+{
+	TestDevice device;
+
+	assert (device.hasProperty("name"));
+	assert (device.getPropertyString("name") == "TestDevice");
+	assert (Poco::AnyCast<std::string>(device.getProperty("name")) == "TestDevice");
+
+	assert (device.getPropertyDouble("anyValue") == 1.5);
+	device.setPropertyDouble("anyValue", 3.5);
+	assert (device.getPropertyDouble("anyValue") == 3.5);
+
+	try
+	{
+		device.getPropertyInt("anyValue");
+		fail("wrong type - must throw");
+	}
+	catch (Poco::BadCastException&)
+	{
+	}
+
+	try
+	{
+		device.setPropertyString("name", "foo");
+		fail("read-only property - must throw");
+	}
+	catch (NotWritableException&)
+	{
+	}
+
+	assert (!device.hasProperty("unknown"));
+	try
+	{
+		device.getPropertyDouble("unknown");
+		fail("unknown property - must throw");
+	}
+	catch (NotSupportedException&)
+	{
+	}
+}
+
+
+void DeviceImplTest::testTypedProperties()
+{
+	TestDevice device;
+
+	assert (device.getPropertyDouble("doubleValue") == 2.5);
+	device.setPropertyDouble("doubleValue", 4.5);
+	assert (device.getPropertyDouble("doubleValue") == 4.5);
+	assert (Poco::AnyCast<double>(device.getProperty("doubleValue")) == 4.5);
+	device.setProperty("doubleValue", 5.5);
+	assert (device.getPropertyDouble("doubleValue") == 5.5);
+
+	assert (device.getPropertyInt("intValue") == 42);
+
+	device.setPropertyString("label", "hello");
+	assert (device.getPropertyString("label") == "hello");
+
+	device.setPropertyBool("enabled", true);
+	assert (device.getPropertyBool("enabled"));
+
+	try
+	{
+		device.getPropertyInt("doubleValue");
+		fail("wrong type - must throw");
+	}
+	catch (Poco::BadCastException&)
+	{
+	}
+
+	try
+	{
+		device.setPropertyInt("doubleValue", 1);
+		fail("wrong type - must throw");
+	}
+	catch (Poco::BadCastException&)
+	{
+	}
+
+	try
+	{
+		device.setPropertyInt("intValue", 1);
+		fail("read-only property - must throw");
+	}
+	catch (NotWritableException&)
+	{
+	}
+
+	try
+	{
+		device.getPropertyDouble("writeOnly");
+		fail("write-only property - must throw");
+	}
+	catch (NotReadableException&)
+	{
+	}
+	device.setPropertyDouble("writeOnly", 6.5);
+	assert (device.getPropertyDouble("doubleValue") == 6.5);
+}
+
+
+void DeviceImplTest::testPropertyHandles()
+{
+	TestDevice device;
+
+	TestDevice::PropertyHandle hDouble = device.propertyHandle("doubleValue");
+	TestDevice::PropertyHandle hAny = device.propertyHandle("anyValue");
+	TestDevice::PropertyHandle hLabel = device.propertyHandle("label");
+
+	assert (device.getPropertyDouble(hDouble) == 2.5);
+	device.setPropertyDouble(hDouble, 7.5);
+	assert (device.getPropertyDouble("doubleValue") == 7.5);
+
+	assert (device.getPropertyDouble(hAny) == 1.5);
+	device.setPropertyDouble(hAny, 8.5);
+	assert (device.getPropertyDouble(hAny) == 8.5);
+
+	device.setPropertyString(hLabel, "world");
+	assert (device.getPropertyString(hLabel) == "world");
+	assert (Poco::AnyCast<std::string>(device.getProperty(hLabel)) == "world");
+
+	try
+	{
+		device.propertyHandle("unknown");
+		fail("unknown property - must throw");
+	}
+	catch (NotSupportedException&)
+	{
+	}
+
+	try
+	{
+		device.getPropertyDouble(TestDevice::PropertyHandle(100));
+		fail("invalid handle - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void DeviceImplTest::testFeatures()
+{
+	TestDevice device;
+
+	assert (device.hasFeature("enabled"));
+	assert (!device.hasFeature("unknown"));
+	assert (!device.getFeature("enabled"));
+	device.setFeature("enabled", true);
+	assert (device.getFeature("enabled"));
+
+	TestDevice::FeatureHandle hEnabled = device.featureHandle("enabled");
+	device.setFeature(hEnabled, false);
+	assert (!device.getFeature(hEnabled));
+	assert (!device.getFeature("readOnly"));
+
+	try
+	{
+		device.setFeature("readOnly", true);
+		fail("read-only feature - must throw");
+	}
+	catch (NotWritableException&)
+	{
+	}
+
+	try
+	{
+		device.getFeature("unknown");
+		fail("unknown feature - must throw");
+	}
+	catch (NotSupportedException&)
+	{
+	}
+}
+
+
+void DeviceImplTest::testSnapshot()
+{
+	TestDevice device;
+	device.setPropertyString("label", "snap");
+
+	std::vector<DeviceProperty> properties = device.snapshot();
+	assert (properties.size() == 6);
+	assert (properties[0].name == "name");
+	assert (properties[0].type == DEVICE_PROPERTY_STRING);
+	assert (properties[0].stringValue == "TestDevice");
+	assert (properties[1].name == "anyValue");
+	assert (properties[1].type == DEVICE_PROPERTY_DOUBLE);
+	assert (properties[1].doubleValue == 1.5);
+	assert (properties[2].name == "doubleValue");
+	assert (properties[2].type == DEVICE_PROPERTY_DOUBLE);
+	assert (properties[2].doubleValue == 2.5);
+	assert (properties[3].name == "intValue");
+	assert (properties[3].type == DEVICE_PROPERTY_INT);
+	assert (properties[3].intValue == 42);
+	assert (properties[4].name == "label");
+	assert (properties[4].type == DEVICE_PROPERTY_STRING);
+	assert (properties[4].stringValue == "snap");
+	assert (properties[5].name == "enabled");
+	assert (properties[5].type == DEVICE_PROPERTY_BOOL);
+	assert (!properties[5].boolValue);
+
+	std::vector<std::string> names;
+	names.push_back("intValue");
+	names.push_back("unknown");
+	names.push_back("writeOnly");
+	properties = device.getProperties(names);
+	assert (properties.size() == 3);
+	assert (properties[0].type == DEVICE_PROPERTY_INT);
+	assert (properties[0].intValue == 42);
+	assert (properties[1].name == "unknown");
+	assert (properties[1].type == DEVICE_PROPERTY_UNKNOWN);
+	assert (properties[2].name == "writeOnly");
+	assert (properties[2].type == DEVICE_PROPERTY_UNKNOWN);
+}
+
+
+void DeviceImplTest::testGetProperties()
+{
+	TestDevice device;
+
+	std::vector<std::string> names;
+	names.push_back("enabled");
+	names.push_back("anyValue");
+	names.push_back("label");
+	names.push_back("enabled");
+	names.push_back("name");
+
+	std::vector<DeviceProperty> properties = device.getProperties(names);
+	assert (properties.size() == 5);
+	assert (properties[0].name == "enabled");
+	assert (properties[0].type == DEVICE_PROPERTY_BOOL);
+	assert (!properties[0].boolValue);
+	assert (properties[1].name == "anyValue");
+	assert (properties[1].type == DEVICE_PROPERTY_DOUBLE);
+	assert (properties[1].doubleValue == 1.5);
+	assert (properties[2].name == "label");
+	assert (properties[2].type == DEVICE_PROPERTY_STRING);
+	assert (properties[2].stringValue.empty());
+	assert (properties[3].name == "enabled");
+	assert (properties[3].type == DEVICE_PROPERTY_BOOL);
+	assert (properties[4].name == "name");
+	assert (properties[4].stringValue == "TestDevice");
+
+	// values are read on every call
+	device.setPropertyBool("enabled", true);
+	device.setPropertyDouble("anyValue", 3.5);
+	device.setPropertyString("label", "changed");
+	properties = device.getProperties(names);
+	assert (properties[0].boolValue);
+	assert (properties[1].doubleValue == 3.5);
+	assert (properties[2].stringValue == "changed");
+	assert (properties[3].boolValue);
+
+	assert (device.getProperties(std::vector<std::string>()).empty());
+}
+
+
+void DeviceImplTest::setUp()
+{
+}
+
+
+void DeviceImplTest::tearDown()
+{
+}
+
+
+CppUnit::Test* DeviceImplTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("DeviceImplTest");
+
+	CppUnit_addTest(pSuite, DeviceImplTest, testNameTable);
+	CppUnit_addTest(pSuite, DeviceImplTest, testAnyProperties);
+	CppUnit_addTest(pSuite, DeviceImplTest, testTypedProperties);
+	CppUnit_addTest(pSuite, DeviceImplTest, testPropertyHandles);
+	CppUnit_addTest(pSuite, DeviceImplTest, testFeatures);
+	CppUnit_addTest(pSuite, DeviceImplTest, testSnapshot);
+	CppUnit_addTest(pSuite, DeviceImplTest, testGetProperties);
+
+	return pSuite;
+}
@@ -0,0 +1,42 @@
+//
+// DeviceImplTest.h
+//
+// Definition of the DeviceImplTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef DeviceImplTest_INCLUDED
+#define DeviceImplTest_INCLUDED
+
+
+#include "IoT/Devices/Devices.h"
+#include "CppUnit/TestCase.h"
+
+
+class DeviceImplTest: public CppUnit::TestCase
+{
+public:
+	DeviceImplTest(const std::string& name);
+	~DeviceImplTest();
+
+	void testNameTable();
+	void testAnyProperties();
+	void testTypedProperties();
+	void testPropertyHandles();
+	void testFeatures();
+	void testSnapshot();
+	void testGetProperties();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // DeviceImplTest_INCLUDED
@@ -0,0 +1,270 @@
+//
+// DeviceTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "DeviceTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "IoT/Devices/Device.h"
+#include "IoT/Devices/DeviceException.h"
+#include "Poco/Any.h"
+#include <map>
+
+
+using namespace IoT::Devices;
+
+
+namespace
+{
+	class MapDevice: public Device
+		/// A Device that does not derive from DeviceImpl, so
+		/// getProperties() and snapshot() use the fallback
+		/// implementations in Device.
+		///
+		/// The typed getters throw a Poco::BadCastException
+		/// if the property has a different type.
+	{
+	public:
+		void add(const std::string& name, const Poco::Any& value)
+		{
+			_properties[name] = value;
+		}
+
+		void addWriteOnly(const std::string& name)
+		{
+			_writeOnly[name] = true;
+		}
+
+		void setPropertyString(const std::string& name, const std::string& value)
+		{
+			set(name, value);
+		}
+
+		std::string getPropertyString(const std::string& name) const
+		{
+			return Poco::AnyCast<std::string>(get(name));
+		}
+
+		void setPropertyInt(const std::string& name, int value)
+		{
+			set(name, value);
+		}
+
+		int getPropertyInt(const std::string& name) const
+		{
+			return Poco::AnyCast<int>(get(name));
+		}
+
+		void setPropertyDouble(const std::string& name, double value)
+		{
+			set(name, value);
+		}
+
+		double getPropertyDouble(const std::string& name) const
+		{
+			return Poco::AnyCast<double>(get(name));
+		}
+
+		void setPropertyBool(const std::string& name, bool value)
+		{
+			set(name, value);
+		}
+
+		bool getPropertyBool(const std::string& name) const
+		{
+			return Poco::AnyCast<bool>(get(name));
+		}
+
+		bool hasProperty(const std::string& name) const
+		{
+			return _properties.find(name) != _properties.end() || _writeOnly.find(name) != _writeOnly.end();
+		}
+
+		void setFeature(const std::string& name, bool enable)
+		{
+			throw NotSupportedException(name);
+		}
+
+		bool getFeature(const std::string& name) const
+		{
+			throw NotSupportedException(name);
+		}
+
+		bool hasFeature(const std::string& name) const
+		{
+			return false;
+		}
+
+	protected:
+		const Poco::Any& get(const std::string& name) const
+		{
+			if (_writeOnly.find(name) != _writeOnly.end()) throw NotReadableException(name);
+			std::map<std::string, Poco::Any>::const_iterator it = _properties.find(name);
+			if (it == _properties.end()) throw NotSupportedException(name);
+			return it->second;
+		}
+
+		void set(const std::string& name, const Poco::Any& value)
+		{
+			_properties[name] = value;
+		}
+
+	private:
+		std::map<std::string, Poco::Any> _properties;
+		std::map<std::string, bool> _writeOnly;
+	};
+}
+
+
+DeviceTest::DeviceTest(const std::string& name):
+	CppUnit::TestCase(name)
+{
+}
+
+
+DeviceTest::~DeviceTest()
+{
+}
+
+
+void DeviceTest::testGetProperties()
+{
+	MapDevice device;
+	device.add("label", std::string("hello"));
+	device.add("count", 42);
+	device.add("value", 2.5);
+	device.add("enabled", true);
+	device.add("position", Poco::Any(static_cast<long>(7)));
+	device.addWriteOnly("writeOnly");
+
+	std::vector<std::string> names;
+	names.push_back("label");
+	names.push_back("count");
+	names.push_back("value");
+	names.push_back("enabled");
+	names.push_back("position");
+	names.push_back("writeOnly");
+	names.push_back("unknown");
+
+	std::vector<DeviceProperty> properties = device.getProperties(names);
+	assert (properties.size() == 7);
+	assert (properties[0].name == "label");
+	assert (properties[0].type == DEVICE_PROPERTY_STRING);
+	assert (properties[0].stringValue == "hello");
+	assert (properties[1].name == "count");
+	assert (properties[1].type == DEVICE_PROPERTY_INT);
+	assert (properties[1].intValue == 42);
+	assert (properties[2].name == "value");
+	assert (properties[2].type == DEVICE_PROPERTY_DOUBLE);
+	assert (properties[2].doubleValue == 2.5);
+	assert (properties[3].name == "enabled");
+	assert (properties[3].type == DEVICE_PROPERTY_BOOL);
+	assert (properties[3].boolValue);
+
+	// a type none of the typed getters supports
+	assert (properties[4].name == "position");
+	assert (properties[4].type == DEVICE_PROPERTY_UNKNOWN);
+	assert (properties[4].intValue == 0);
+	assert (properties[4].doubleValue == 0.0);
+	assert (!properties[4].boolValue);
+
+	assert (properties[5].name == "writeOnly");
+	assert (properties[5].type == DEVICE_PROPERTY_UNKNOWN);
+	assert (properties[6].name == "unknown");
+	assert (properties[6].type == DEVICE_PROPERTY_UNKNOWN);
+}
+
+
+void DeviceTest::testGetPropertiesOrder()
+{
+	MapDevice device;
+	device.add("a", 1);
+	device.add("b", 2);
+
+	std::vector<std::string> names;
+	names.push_back("b");
+	names.push_back("a");
+	names.push_back("b");
+
+	std::vector<DeviceProperty> properties = device.getProperties(names);
+	assert (properties.size() == 3);
+	assert (properties[0].name == "b" && properties[0].intValue == 2);
+	assert (properties[1].name == "a" && properties[1].intValue == 1);
+	assert (properties[2].name == "b" && properties[2].intValue == 2);
+
+	assert (device.getProperties(std::vector<std::string>()).empty());
+}
+
+
+void DeviceTest::testSnapshot()
+{
+	MapDevice device;
+	device.add("status", std::string("ok"));
+	device.add("name", std::string("Map Device"));
+	device.add("type", std::string("io.macchina.sensor"));
+	device.add("symbolicName", std::string("io.macchina.test"));
+	device.add("value", 2.5);
+
+	std::vector<DeviceProperty> properties = device.snapshot();
+	assert (properties.size() == 4);
+	assert (properties[0].name == "symbolicName");
+	assert (properties[0].stringValue == "io.macchina.test");
+	assert (properties[1].name == "type");
+	assert (properties[1].stringValue == "io.macchina.sensor");
+	assert (properties[2].name == "name");
+	assert (properties[2].stringValue == "Map Device");
+	assert (properties[3].name == "status");
+	assert (properties[3].stringValue == "ok");
+	for (std::size_t i = 0; i < properties.size(); i++)
+	{
+		assert (properties[i].type == DEVICE_PROPERTY_STRING);
+	}
+}
+
+
+void DeviceTest::testSnapshotMissingProperties()
+{
+	MapDevice device;
+	device.add("name", std::string("Map Device"));
+	device.add("status", 1);
+
+	std::vector<DeviceProperty> properties = device.snapshot();
+	assert (properties.size() == 2);
+	assert (properties[0].name == "name");
+	assert (properties[0].type == DEVICE_PROPERTY_STRING);
+	assert (properties[1].name == "status");
+	assert (properties[1].type == DEVICE_PROPERTY_INT);
+	assert (properties[1].intValue == 1);
+
+	MapDevice emptyDevice;
+	assert (emptyDevice.snapshot().empty());
+}
+
+
+void DeviceTest::setUp()
+{
+}
+
+
+void DeviceTest::tearDown()
+{
+}
+
+
+CppUnit::Test* DeviceTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("DeviceTest");
+
+	CppUnit_addTest(pSuite, DeviceTest, testGetProperties);
+	CppUnit_addTest(pSuite, DeviceTest, testGetPropertiesOrder);
+	CppUnit_addTest(pSuite, DeviceTest, testSnapshot);
+	CppUnit_addTest(pSuite, DeviceTest, testSnapshotMissingProperties);
+
+	return pSuite;
+}
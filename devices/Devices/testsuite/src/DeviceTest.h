@@ -0,0 +1,39 @@
+//
+// DeviceTest.h
+//
+// Definition of the DeviceTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef DeviceTest_INCLUDED
+#define DeviceTest_INCLUDED
+
+
+#include "IoT/Devices/Devices.h"
+#include "CppUnit/TestCase.h"
+
+
+class DeviceTest: public CppUnit::TestCase
+{
+public:
+	DeviceTest(const std::string& name);
+	~DeviceTest();
+
+	void testGetProperties();
+	void testGetPropertiesOrder();
+	void testSnapshot();
+	void testSnapshotMissingProperties();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // DeviceTest_INCLUDED
@@ -10,6 +10,9 @@
 
 #include "DevicesTestSuite.h"
 #include "EventModerationPolicyTest.h"
+#include "SampleBufferTest.h"
+#include "DeviceImplTest.h"
+#include "DeviceTest.h"
 
 
 CppUnit::Test* DevicesTestSuite::suite()
@@ -17,6 +20,9 @@ CppUnit::Test* DevicesTestSuite::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("DevicesTestSuite");
 
 	pSuite->addTest(EventModerationPolicyTest::suite());
+	pSuite->addTest(SampleBufferTest::suite());
+	pSuite->addTest(DeviceImplTest::suite());
+	pSuite->addTest(DeviceTest::suite());
 
 	return pSuite;
 }
@@ -0,0 +1,321 @@
+//
+// EventLatencyBenchmark.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// An end-to-end latency and throughput benchmark for sensor events.
+//
+// A synthetic Sensor fires valueChanged events carrying a sequence
+// number. Each delivery path (see LatencyPaths.h) carries the events
+// to a subscriber, which reports the sequence number back. All paths
+// run in a single process over the loopback interface, so the
+// benchmark does not need a network, a browser or an MQTT broker.
+//
+// Only the direct and remoting paths use the real delivery code
+// (the generated RemotingNG event dispatcher). The queue, websocket
+// and mqttpacket paths measure a thread hand-off, the WebSocket
+// transport of a WebEvent NOTIFY message and the transport of an
+// MQTT PUBLISH packet; they do not use the JavaScript bridge, the
+// WebEvent service or the MQTT client.
+//
+// For every path, the benchmark first sends events as fast as
+// possible to measure throughput, then sends events at a fixed rate
+// to measure latency percentiles.
+//
+
+
+#include "BenchmarkSensor.h"
+#include "LatencyPaths.h"
+#include "LatencyHistogram.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/Clock.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Event.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Format.h"
+#include <iostream>
+#include <vector>
+#include <set>
+
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::OptionCallback;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+
+
+class LatencyRecorder: public LatencyReceiver
+	/// Records send and receive times for a run of events.
+{
+public:
+	LatencyRecorder():
+		_expected(0),
+		_done(false)
+	{
+	}
+
+	void reset(std::size_t n)
+	{
+		_sendTimes.assign(n, 0);
+		_receiveTimes.assign(n, 0);
+		_expected = n;
+		_received = 0;
+		_done.reset();
+	}
+
+	void sent(Poco::Int64 sequence)
+	{
+		_sendTimes[static_cast<std::size_t>(sequence)] = Poco::Clock().microseconds();
+	}
+
+	void received(Poco::Int64 sequence)
+	{
+		if (sequence < 0 || sequence >= static_cast<Poco::Int64>(_expected)) return;
+
+		_receiveTimes[static_cast<std::size_t>(sequence)] = Poco::Clock().microseconds();
+		if (static_cast<std::size_t>(++_received) == _expected) _done.set();
+	}
+
+	bool wait(long milliseconds)
+	{
+		return _expected == 0 || _done.tryWait(milliseconds);
+	}
+
+	std::size_t receivedCount() const
+	{
+		return static_cast<std::size_t>(_received.value());
+	}
+
+	void collect(LatencyHistogram& histogram) const
+	{
+		histogram.clear();
+		histogram.reserve(_expected);
+		for (std::size_t i = 0; i < _expected; i++)
+		{
+			if (_receiveTimes[i] != 0) histogram.add(_receiveTimes[i] - _sendTimes[i]);
+		}
+	}
+
+private:
+	std::vector<Poco::Int64> _sendTimes;
+	std::vector<Poco::Int64> _receiveTimes;
+	std::size_t _expected;
+	Poco::AtomicCounter _received;
+	Poco::Event _done;
+};
+
+
+class EventLatencyBenchmark: public Application
+{
+public:
+	EventLatencyBenchmark():
+		_helpRequested(false),
+		_showHistogram(false),
+		_events(100000),
+		_rate(10000),
+		_timeout(30)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<EventLatencyBenchmark>(this, &EventLatencyBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("path", "p", "Delivery path to measure (direct, queue, remoting, websocket, mqttpacket). Can be given multiple times. Default is all.")
+				.required(false)
+				.repeatable(true)
+				.argument("<path>")
+				.callback(OptionCallback<EventLatencyBenchmark>(this, &EventLatencyBenchmark::handlePath)));
+
+		options.addOption(
+			Option("events", "n", "Number of events per measurement (default 100000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 100000000))
+				.binding("benchmark.events"));
+
+		options.addOption(
+			Option("rate", "r", "Event rate for the latency measurement, in events per second (default 10000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 10000000))
+				.binding("benchmark.rate"));
+
+		options.addOption(
+			Option("timeout", "t", "Time in seconds to wait for outstanding events (default 30).")
+				.required(false)
+				.repeatable(false)
+				.argument("<s>")
+				.validator(new IntValidator(1, 3600))
+				.binding("benchmark.timeout"));
+
+		options.addOption(
+			Option("histogram", "H", "Print a latency histogram for every path.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<EventLatencyBenchmark>(this, &EventLatencyBenchmark::handleHistogram)));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void handlePath(const std::string& name, const std::string& value)
+	{
+		_paths.insert(value);
+	}
+
+	void handleHistogram(const std::string& name, const std::string& value)
+	{
+		_showHistogram = true;
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("Loopback benchmark measuring latency and throughput of sensor events through the event delivery paths.");
+		helpFormatter.format(std::cout);
+	}
+
+	bool selected(const std::string& path) const
+	{
+		return _paths.empty() || _paths.find(path) != _paths.end();
+	}
+
+	void send(BenchmarkSensor& sensor, LatencyRecorder& recorder, std::size_t n, int rate)
+		/// Sends n events. If rate is 0, events are sent as fast
+		/// as possible, otherwise at the given rate.
+	{
+		recorder.reset(n);
+		Poco::Clock start;
+		for (std::size_t i = 0; i < n; i++)
+		{
+			if (rate > 0)
+			{
+				Poco::Clock::ClockDiff due = static_cast<Poco::Clock::ClockDiff>(i*1000000.0/rate);
+				while (start.elapsed() < due) Poco::Thread::yield();
+			}
+			recorder.sent(i);
+			sensor.inject(static_cast<double>(i));
+		}
+	}
+
+	bool measure(LatencyPath& path)
+		/// Measures the given path and prints the results.
+		/// Returns false if events were lost.
+	{
+		BenchmarkSensor::Ptr pSensor = new BenchmarkSensor;
+		LatencyRecorder recorder;
+		path.open(pSensor, recorder);
+
+		// warm-up
+		send(*pSensor, recorder, std::min<std::size_t>(_events, 1000), 0);
+		recorder.wait(_timeout*1000);
+
+		Poco::Stopwatch sw;
+		sw.start();
+		send(*pSensor, recorder, _events, 0);
+		bool complete = recorder.wait(_timeout*1000);
+		sw.stop();
+		std::size_t throughputLost = _events - recorder.receivedCount();
+		double seconds = static_cast<double>(sw.elapsed())/Poco::Timestamp::resolution();
+
+		send(*pSensor, recorder, _events, _rate);
+		complete = recorder.wait(_timeout*1000) && complete;
+		std::size_t latencyLost = _events - recorder.receivedCount();
+
+		path.close();
+
+		LatencyHistogram histogram;
+		recorder.collect(histogram);
+		std::cout << Poco::format("%-10s %12.0f %8Ld %8Ld %8Ld %8Ld %8.1f %6z",
+			path.name(),
+			seconds > 0 ? (_events - throughputLost)/seconds : 0.0,
+			histogram.percentile(50),
+			histogram.percentile(99),
+			histogram.percentile(99.9),
+			histogram.maximum(),
+			histogram.mean(),
+			throughputLost + latencyLost) << std::endl;
+		if (_showHistogram)
+		{
+			histogram.print(std::cout);
+		}
+		return complete;
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		_events = config().getInt("benchmark.events", _events);
+		_rate = config().getInt("benchmark.rate", _rate);
+		_timeout = config().getInt("benchmark.timeout", _timeout);
+
+		std::vector<LatencyPath::Ptr> paths;
+		paths.push_back(new DirectPath);
+		paths.push_back(new QueuePath);
+		paths.push_back(new RemotingPath);
+		paths.push_back(new WebSocketPath);
+		paths.push_back(new MQTTPacketPath);
+
+		std::cout << Poco::format("%d events per measurement, latency measured at %d events/s, times in microseconds", _events, _rate) << std::endl;
+		std::cout << "path         events/s      p50      p99    p99.9      max     mean   lost" << std::endl;
+
+		int rc = Application::EXIT_OK;
+		for (std::vector<LatencyPath::Ptr>::iterator it = paths.begin(); it != paths.end(); ++it)
+		{
+			if (selected((*it)->name()))
+			{
+				try
+				{
+					if (!measure(**it)) rc = Application::EXIT_SOFTWARE;
+				}
+				catch (Poco::Exception& exc)
+				{
+					std::cerr << (*it)->name() << ": " << exc.displayText() << std::endl;
+					rc = Application::EXIT_SOFTWARE;
+				}
+			}
+		}
+		return rc;
+	}
+
+private:
+	bool _helpRequested;
+	bool _showHistogram;
+	std::set<std::string> _paths;
+	int _events;
+	int _rate;
+	int _timeout;
+};
+
+
+POCO_APP_MAIN(EventLatencyBenchmark)
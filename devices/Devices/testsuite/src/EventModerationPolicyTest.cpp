@@ -24,11 +24,13 @@ EventModerationPolicyTest::EventModerationPolicyTest(const std::string& name):
 	_eventCount(0)
 {
 	event += Poco::delegate(this, &EventModerationPolicyTest::onEvent);
+	aggregateEvent += Poco::delegate(this, &EventModerationPolicyTest::onAggregate);
 }
 
 
 EventModerationPolicyTest::~EventModerationPolicyTest()
 {
+	aggregateEvent -= Poco::delegate(this, &EventModerationPolicyTest::onAggregate);
 	event -= Poco::delegate(this, &EventModerationPolicyTest::onEvent);
 }
 
@@ -96,10 +98,206 @@ void EventModerationPolicyTest::testMaximumRateModerationPolicy()
 }
 
 
+void EventModerationPolicyTest::testWindowedAggregationPolicy()
+{
+	TimerWheel wheel(10);
+	{
+		WindowedAggregationPolicy<int> policy(event, aggregateEvent, 50, wheel);
+		assert (wheel.size() == 1);
+
+		policy.valueChanged(4);
+		policy.valueChanged(-2);
+		policy.valueChanged(7);
+		policy.valueChanged(3);
+		assert (_eventCount == 0);
+		assert (_aggregates.empty());
+
+		for (int i = 0; i < 4; i++) wheel.tick();
+		assert (_eventCount == 0);
+
+		wheel.tick();
+		assert (_eventCount == 1);
+		assert (_eventValue == 3);
+		assert (_aggregates.size() == 1);
+		assert (_aggregates[0].minimum == -2);
+		assert (_aggregates[0].maximum == 7);
+		assert (_aggregates[0].mean == 3);
+		assert (_aggregates[0].count == 4);
+
+		// no values, no events
+		for (int i = 0; i < 5; i++) wheel.tick();
+		assert (_eventCount == 1);
+		assert (_aggregates.size() == 1);
+
+		policy.valueChanged(10);
+		for (int i = 0; i < 5; i++) wheel.tick();
+		assert (_eventCount == 2);
+		assert (_eventValue == 10);
+		assert (_aggregates.size() == 2);
+		assert (_aggregates[1].minimum == 10);
+		assert (_aggregates[1].maximum == 10);
+		assert (_aggregates[1].count == 1);
+	}
+	assert (wheel.size() == 0);
+}
+
+
+void EventModerationPolicyTest::testDeadbandModerationPolicy()
+{
+	TimerWheel wheel(10);
+	{
+		DeadbandModerationPolicy<int> policy(event, 0, 3, 100, wheel);
+
+		policy.valueChanged(2);
+		assert (_eventCount == 0);
+
+		policy.valueChanged(-3);
+		assert (_eventCount == 1);
+		assert (_eventValue == -3);
+
+		policy.valueChanged(-1);
+		assert (_eventCount == 1);
+
+		// heartbeat after 100 ms without an event carries the current value
+		for (int i = 0; i < 9; i++) wheel.tick();
+		assert (_eventCount == 1);
+		wheel.tick();
+		assert (_eventCount == 2);
+		assert (_eventValue == -1);
+
+		// the deadband is relative to the value sent with the heartbeat
+		policy.valueChanged(1);
+		assert (_eventCount == 2);
+		policy.valueChanged(2);
+		assert (_eventCount == 3);
+		assert (_eventValue == 2);
+
+		// an event resets the heartbeat, which then comes
+		// at most 100 ms, but no more than 20 ms early
+		for (int i = 0; i < 5; i++) wheel.tick();
+		policy.valueChanged(6);
+		assert (_eventCount == 4);
+		int ticks = 0;
+		while (_eventCount == 4 && ticks < 20)
+		{
+			wheel.tick();
+			ticks++;
+		}
+		assert (_eventCount == 5);
+		assert (_eventValue == 6);
+		assert (ticks >= 8 && ticks <= 10);
+	}
+	assert (wheel.size() == 0);
+}
+
+
+void EventModerationPolicyTest::testPolicyComparison()
+{
+	// A slowly rising, noisy signal sampled every 10 ms (one wheel
+	// tick) for 10 s, with a single short spike.
+	const int SAMPLES = 1000;
+	const int SPIKE = 503;
+	std::vector<int> signal;
+	for (int i = 0; i < SAMPLES; i++)
+	{
+		signal.push_back(i == SPIKE ? 1000 : 100 + i/20 + (i*7) % 3);
+	}
+	int minimum = signal[0];
+	int maximum = signal[0];
+	double sum = 0;
+	for (int i = 0; i < SAMPLES; i++)
+	{
+		if (signal[i] < minimum) minimum = signal[i];
+		if (signal[i] > maximum) maximum = signal[i];
+		sum += signal[i];
+	}
+
+	// No moderation: one event per sample.
+	{
+		NoModerationPolicy<int> policy(event);
+		for (int i = 0; i < SAMPLES; i++) policy.valueChanged(signal[i]);
+		assert (_eventCount == SAMPLES);
+	}
+
+	// Windowed aggregation over 100 ms: one value and one aggregate
+	// event per window, without losing minimum, maximum or mean.
+	setUp();
+	{
+		TimerWheel wheel(10);
+		WindowedAggregationPolicy<int> policy(event, aggregateEvent, 100, wheel);
+		int maxForwarded = 0;
+		for (int i = 0; i < SAMPLES; i++)
+		{
+			policy.valueChanged(signal[i]);
+			int count = _eventCount;
+			wheel.tick();
+			if (_eventCount != count && _eventValue > maxForwarded) maxForwarded = _eventValue;
+		}
+		assert (_eventCount == SAMPLES/10);
+		assert (_aggregates.size() == SAMPLES/10);
+
+		double aggMin = _aggregates[0].minimum;
+		double aggMax = _aggregates[0].maximum;
+		double aggSum = 0;
+		int aggCount = 0;
+		for (std::vector<ValueAggregate>::const_iterator it = _aggregates.begin(); it != _aggregates.end(); ++it)
+		{
+			if (it->minimum < aggMin) aggMin = it->minimum;
+			if (it->maximum > aggMax) aggMax = it->maximum;
+			aggSum += it->mean*it->count;
+			aggCount += it->count;
+		}
+		assert (aggCount == SAMPLES);
+		assert (aggMin == minimum);
+		assert (aggMax == maximum);
+		assertEqualDelta (sum/SAMPLES, aggSum/aggCount, 1e-9);
+
+		// Forwarding only the last value of each window (what a
+		// rate limit does) loses the spike.
+		assert (maxForwarded < maximum);
+	}
+
+	// Deadband of 3 with a 1 s heartbeat: the error seen by a subscriber
+	// stays below the deadband, the spike is delivered, and the time
+	// between two events never exceeds the heartbeat interval.
+	setUp();
+	{
+		TimerWheel wheel(10);
+		DeadbandModerationPolicy<int> policy(event, signal[0], 3, 1000, wheel);
+		int received = signal[0];
+		int maxError = 0;
+		int maxGap = 0;
+		int lastEvent = 0;
+		bool spikeSeen = false;
+		for (int i = 0; i < SAMPLES; i++)
+		{
+			int count = _eventCount;
+			policy.valueChanged(signal[i]);
+			wheel.tick();
+			if (_eventCount != count)
+			{
+				received = _eventValue;
+				if (received == 1000) spikeSeen = true;
+				if (i - lastEvent > maxGap) maxGap = i - lastEvent;
+				lastEvent = i;
+			}
+			int error = signal[i] - received;
+			if (error < 0) error = -error;
+			if (error > maxError) maxError = error;
+		}
+		assert (_eventCount < SAMPLES/10);
+		assert (maxError < 3);
+		assert (spikeSeen);
+		assert (maxGap <= 100);
+	}
+}
+
+
 void EventModerationPolicyTest::setUp()
 {
 	_eventValue = 0;
 	_eventCount = 0;
+	_aggregates.clear();
 }
 
 
@@ -115,6 +313,12 @@ void EventModerationPolicyTest::onEvent(const void* sender, const int& value)
 }
 
 
+void EventModerationPolicyTest::onAggregate(const void* sender, const ValueAggregate& aggregate)
+{
+	_aggregates.push_back(aggregate);
+}
+
+
 CppUnit::Test* EventModerationPolicyTest::suite()
 {
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("EventModerationPolicyTest");
@@ -122,6 +326,9 @@ CppUnit::Test* EventModerationPolicyTest::suite()
 	CppUnit_addTest(pSuite, EventModerationPolicyTest, testNoModerationPolicy);
 	CppUnit_addTest(pSuite, EventModerationPolicyTest, testMinimumDeltaModerationPolicy);
 	CppUnit_addTest(pSuite, EventModerationPolicyTest, testMaximumRateModerationPolicy);
+	CppUnit_addTest(pSuite, EventModerationPolicyTest, testWindowedAggregationPolicy);
+	CppUnit_addTest(pSuite, EventModerationPolicyTest, testDeadbandModerationPolicy);
+	CppUnit_addTest(pSuite, EventModerationPolicyTest, testPolicyComparison);
 
 	return pSuite;
 }
@@ -15,8 +15,10 @@
 
 
 #include "IoT/Devices/Devices.h"
+#include "IoT/Devices/Sensor.h"
 #include "CppUnit/TestCase.h"
 #include "Poco/BasicEvent.h"
+#include <vector>
 
 
 class EventModerationPolicyTest: public CppUnit::TestCase
@@ -26,10 +28,14 @@ public:
 	~EventModerationPolicyTest();
 	
 	Poco::BasicEvent<const int> event;
+	Poco::BasicEvent<const IoT::Devices::ValueAggregate> aggregateEvent;
 
 	void testNoModerationPolicy();
 	void testMinimumDeltaModerationPolicy();
 	void testMaximumRateModerationPolicy();
+	void testWindowedAggregationPolicy();
+	void testDeadbandModerationPolicy();
+	void testPolicyComparison();
 
 	void setUp();
 	void tearDown();
@@ -38,10 +44,12 @@ public:
 
 protected:
 	void onEvent(const void* sender, const int& value);
+	void onAggregate(const void* sender, const IoT::Devices::ValueAggregate& aggregate);
 	
 private:
 	int _eventValue;
 	int _eventCount;
+	std::vector<IoT::Devices::ValueAggregate> _aggregates;
 };
 
 
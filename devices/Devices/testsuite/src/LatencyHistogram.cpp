@@ -0,0 +1,123 @@
+//
+// LatencyHistogram.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "LatencyHistogram.h"
+#include "Poco/Format.h"
+#include <algorithm>
+#include <cmath>
+
+
+LatencyHistogram::LatencyHistogram():
+	_sorted(true)
+{
+}
+
+
+LatencyHistogram::~LatencyHistogram()
+{
+}
+
+
+void LatencyHistogram::reserve(std::size_t n)
+{
+	_samples.reserve(n);
+}
+
+
+void LatencyHistogram::add(Poco::Int64 latency)
+{
+	_samples.push_back(latency);
+	_sorted = false;
+}
+
+
+void LatencyHistogram::clear()
+{
+	_samples.clear();
+	_sorted = true;
+}
+
+
+Poco::Int64 LatencyHistogram::percentile(double p) const
+{
+	if (_samples.empty()) return 0;
+
+	sort();
+	std::size_t rank = static_cast<std::size_t>(std::ceil(p/100.0*_samples.size()));
+	if (rank < 1) rank = 1;
+	if (rank > _samples.size()) rank = _samples.size();
+	return _samples[rank - 1];
+}
+
+
+Poco::Int64 LatencyHistogram::maximum() const
+{
+	if (_samples.empty()) return 0;
+
+	sort();
+	return _samples.back();
+}
+
+
+double LatencyHistogram::mean() const
+{
+	if (_samples.empty()) return 0;
+
+	double sum = 0;
+	for (std::vector<Poco::Int64>::const_iterator it = _samples.begin(); it != _samples.end(); ++it)
+	{
+		sum += *it;
+	}
+	return sum/_samples.size();
+}
+
+
+void LatencyHistogram::print(std::ostream& ostr) const
+{
+	if (_samples.empty()) return;
+
+	sort();
+	std::vector<std::size_t> buckets;
+	for (std::vector<Poco::Int64>::const_iterator it = _samples.begin(); it != _samples.end(); ++it)
+	{
+		std::size_t bucket = 0;
+		Poco::Int64 limit = 1;
+		while (*it >= limit)
+		{
+			limit *= 2;
+			bucket++;
+		}
+		if (bucket >= buckets.size()) buckets.resize(bucket + 1);
+		buckets[bucket]++;
+	}
+
+	Poco::Int64 lower = 0;
+	Poco::Int64 upper = 1;
+	for (std::size_t i = 0; i < buckets.size(); i++)
+	{
+		if (buckets[i] > 0)
+		{
+			std::size_t width = buckets[i]*50/_samples.size();
+			ostr << Poco::format("  %8Ld - %8Ld us %9z ", lower, upper - 1, buckets[i]) << std::string(width, '#') << std::endl;
+		}
+		lower = upper;
+		upper *= 2;
+	}
+}
+
+
+void LatencyHistogram::sort() const
+{
+	if (!_sorted)
+	{
+		std::sort(_samples.begin(), _samples.end());
+		_sorted = true;
+	}
+}
@@ -0,0 +1,77 @@
+//
+// LatencyHistogram.h
+//
+// Definition of the LatencyHistogram class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef LatencyHistogram_INCLUDED
+#define LatencyHistogram_INCLUDED
+
+
+#include "Poco/Types.h"
+#include <vector>
+#include <ostream>
+
+
+class LatencyHistogram
+	/// Collects latency samples (in microseconds) and computes
+	/// percentiles and a logarithmic histogram.
+	///
+	/// All samples are kept, so percentiles are exact.
+{
+public:
+	LatencyHistogram();
+		/// Creates an empty LatencyHistogram.
+
+	~LatencyHistogram();
+		/// Destroys the LatencyHistogram.
+
+	void reserve(std::size_t n);
+		/// Reserves space for n samples.
+
+	void add(Poco::Int64 latency);
+		/// Adds a sample.
+
+	void clear();
+		/// Removes all samples.
+
+	std::size_t count() const;
+		/// Returns the number of samples.
+
+	Poco::Int64 percentile(double p) const;
+		/// Returns the given percentile (0 - 100), using the
+		/// nearest-rank method. Returns 0 if there are no samples.
+
+	Poco::Int64 maximum() const;
+		/// Returns the largest sample.
+
+	double mean() const;
+		/// Returns the mean of all samples.
+
+	void print(std::ostream& ostr) const;
+		/// Writes a histogram with power-of-two buckets to ostr.
+
+private:
+	void sort() const;
+
+	mutable std::vector<Poco::Int64> _samples;
+	mutable bool _sorted;
+};
+
+
+//
+// inlines
+//
+inline std::size_t LatencyHistogram::count() const
+{
+	return _samples.size();
+}
+
+
+#endif // LatencyHistogram_INCLUDED
@@ -0,0 +1,610 @@
+//
+// LatencyPaths.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "LatencyPaths.h"
+#include "Poco/RemotingNG/Transport.h"
+#include "Poco/RemotingNG/TransportFactory.h"
+#include "Poco/RemotingNG/TransportFactoryManager.h"
+#include "Poco/RemotingNG/BinarySerializer.h"
+#include "Poco/RemotingNG/BinaryDeserializer.h"
+#include "Poco/RemotingNG/TypeDeserializer.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/JSON/Parser.h"
+#include "Poco/JSON/Object.h"
+#include "Poco/Notification.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Delegate.h"
+#include "Poco/URI.h"
+#include <sstream>
+
+
+namespace
+{
+	bool receiveFully(Poco::Net::StreamSocket& socket, char* buffer, int length)
+	{
+		int received = 0;
+		while (received < length)
+		{
+			int n = socket.receiveBytes(buffer + received, length - received);
+			if (n <= 0) return false;
+			received += n;
+		}
+		return true;
+	}
+
+	void sendFully(Poco::Net::StreamSocket& socket, const char* buffer, int length)
+	{
+		int sent = 0;
+		while (sent < length)
+		{
+			sent += socket.sendBytes(buffer + sent, length - sent);
+		}
+	}
+
+	class ValueNotification: public Poco::Notification
+	{
+	public:
+		typedef Poco::AutoPtr<ValueNotification> Ptr;
+
+		ValueNotification(double value):
+			_value(value)
+		{
+		}
+
+		double value() const
+		{
+			return _value;
+		}
+
+	private:
+		double _value;
+	};
+
+	class LoopbackTransport: public Poco::RemotingNG::Transport
+		/// Sends one-way messages as frames consisting of a 32-bit
+		/// big-endian length followed by the binary-serialized message.
+	{
+	public:
+		const std::string& endPoint() const
+		{
+			return _endPoint;
+		}
+
+		void connect(const std::string& endPoint)
+		{
+			Poco::URI uri(endPoint);
+			_socket.connect(Poco::Net::SocketAddress(uri.getHost(), uri.getPort()));
+			_socket.setNoDelay(true);
+			_endPoint = endPoint;
+		}
+
+		void disconnect()
+		{
+			_socket.close();
+			_endPoint.clear();
+		}
+
+		bool connected() const
+		{
+			return !_endPoint.empty();
+		}
+
+		Poco::RemotingNG::Serializer& beginMessage(const Poco::RemotingNG::Identifiable::ObjectId&, const Poco::RemotingNG::Identifiable::TypeId&, const std::string&, Poco::RemotingNG::SerializerBase::MessageType)
+		{
+			_stream.str(std::string(4, '\0'));
+			_stream.seekp(4);
+			_serializer.setup(_stream);
+			return _serializer;
+		}
+
+		void sendMessage(const Poco::RemotingNG::Identifiable::ObjectId&, const Poco::RemotingNG::Identifiable::TypeId&, const std::string&, Poco::RemotingNG::SerializerBase::MessageType)
+		{
+			std::string frame = _stream.str();
+			Poco::UInt32 length = static_cast<Poco::UInt32>(frame.size() - 4);
+			frame[0] = static_cast<char>(length >> 24);
+			frame[1] = static_cast<char>(length >> 16);
+			frame[2] = static_cast<char>(length >> 8);
+			frame[3] = static_cast<char>(length);
+			sendFully(_socket, frame.data(), static_cast<int>(frame.size()));
+		}
+
+		Poco::RemotingNG::Serializer& beginRequest(const Poco::RemotingNG::Identifiable::ObjectId&, const Poco::RemotingNG::Identifiable::TypeId&, const std::string&, Poco::RemotingNG::SerializerBase::MessageType)
+		{
+			throw Poco::NotImplementedException("LoopbackTransport only supports one-way messages");
+		}
+
+		Poco::RemotingNG::Deserializer& sendRequest(const Poco::RemotingNG::Identifiable::ObjectId&, const Poco::RemotingNG::Identifiable::TypeId&, const std::string&, Poco::RemotingNG::SerializerBase::MessageType)
+		{
+			throw Poco::NotImplementedException("LoopbackTransport only supports one-way messages");
+		}
+
+		void endRequest()
+		{
+		}
+
+	private:
+		std::string _endPoint;
+		Poco::Net::StreamSocket _socket;
+		std::ostringstream _stream;
+		Poco::RemotingNG::BinarySerializer _serializer;
+	};
+
+	class LoopbackTransportFactory: public Poco::RemotingNG::TransportFactory
+	{
+	public:
+		Poco::RemotingNG::Transport* createTransport()
+		{
+			return new LoopbackTransport;
+		}
+	};
+
+	class WebSocketRequestHandler: public Poco::Net::HTTPRequestHandler
+	{
+	public:
+		WebSocketRequestHandler(WebSocketPath& path):
+			_path(path)
+		{
+		}
+
+		void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
+		{
+			Poco::Net::WebSocket webSocket(request, response);
+			webSocket.setNoDelay(true);
+			_path.accept(webSocket);
+		}
+
+	private:
+		WebSocketPath& _path;
+	};
+
+	class WebSocketRequestHandlerFactory: public Poco::Net::HTTPRequestHandlerFactory
+	{
+	public:
+		WebSocketRequestHandlerFactory(WebSocketPath& path):
+			_path(path)
+		{
+		}
+
+		Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest&)
+		{
+			return new WebSocketRequestHandler(_path);
+		}
+
+	private:
+		WebSocketPath& _path;
+	};
+}
+
+
+//
+// LatencyReceiver
+//
+
+
+LatencyReceiver::~LatencyReceiver()
+{
+}
+
+
+//
+// LatencyPath
+//
+
+
+LatencyPath::LatencyPath(const std::string& name):
+	_name(name)
+{
+}
+
+
+LatencyPath::~LatencyPath()
+{
+}
+
+
+//
+// DirectPath
+//
+
+
+DirectPath::DirectPath():
+	LatencyPath("direct"),
+	_pReceiver(0)
+{
+}
+
+
+DirectPath::~DirectPath()
+{
+}
+
+
+void DirectPath::open(BenchmarkSensor::Ptr pSensor, LatencyReceiver& receiver)
+{
+	_pSensor = pSensor;
+	_pReceiver = &receiver;
+	_pSensor->valueChanged += Poco::delegate(this, &DirectPath::onValueChanged);
+}
+
+
+void DirectPath::close()
+{
+	_pSensor->valueChanged -= Poco::delegate(this, &DirectPath::onValueChanged);
+	_pSensor = 0;
+}
+
+
+void DirectPath::onValueChanged(const double& value)
+{
+	_pReceiver->received(static_cast<Poco::Int64>(value));
+}
+
+
+//
+// QueuePath
+//
+
+
+QueuePath::QueuePath():
+	LatencyPath("queue"),
+	_pReceiver(0)
+{
+}
+
+
+QueuePath::~QueuePath()
+{
+}
+
+
+void QueuePath::open(BenchmarkSensor::Ptr pSensor, LatencyReceiver& receiver)
+{
+	_pSensor = pSensor;
+	_pReceiver = &receiver;
+	_thread.start(*this);
+	_pSensor->valueChanged += Poco::delegate(this, &QueuePath::onValueChanged);
+}
+
+
+void QueuePath::close()
+{
+	_pSensor->valueChanged -= Poco::delegate(this, &QueuePath::onValueChanged);
+	_queue.wakeUpAll();
+	_thread.join();
+	_pSensor = 0;
+}
+
+
+void QueuePath::onValueChanged(const double& value)
+{
+	_queue.enqueueNotification(new ValueNotification(value));
+}
+
+
+void QueuePath::run()
+{
+	Poco::AutoPtr<Poco::Notification> pNf = _queue.waitDequeueNotification();
+	while (pNf)
+	{
+		ValueNotification::Ptr pValueNf = pNf.cast<ValueNotification>();
+		_pReceiver->received(static_cast<Poco::Int64>(pValueNf->value()));
+		pNf = _queue.waitDequeueNotification();
+	}
+}
+
+
+//
+// RemotingPath
+//
+
+
+const std::string RemotingPath::PROTOCOL("loopback");
+
+
+RemotingPath::RemotingPath():
+	LatencyPath("remoting"),
+	_pReceiver(0)
+{
+}
+
+
+RemotingPath::~RemotingPath()
+{
+}
+
+
+void RemotingPath::open(BenchmarkSensor::Ptr pSensor, LatencyReceiver& receiver)
+{
+	Poco::RemotingNG::TransportFactoryManager& tfm = Poco::RemotingNG::TransportFactoryManager::instance();
+	if (!tfm.hasFactory(PROTOCOL))
+	{
+		tfm.registerFactory(PROTOCOL, new LoopbackTransportFactory);
+	}
+
+	_pSensor = pSensor;
+	_pReceiver = &receiver;
+	_serverSocket.bind(Poco::Net::SocketAddress("127.0.0.1", 0));
+	_serverSocket.listen();
+	_thread.start(*this);
+
+	_pRemoteObject = new IoT::Devices::SensorRemoteObject("sensor", _pSensor);
+	_pEventDispatcher = new IoT::Devices::SensorEventDispatcher(_pRemoteObject, PROTOCOL);
+	_pEventDispatcher->subscribe("subscriber", PROTOCOL + "://127.0.0.1:" + Poco::NumberFormatter::format(_serverSocket.address().port()));
+}
+
+
+void RemotingPath::close()
+{
+	_pEventDispatcher->unsubscribe("subscriber");
+	_thread.join();
+	_pEventDispatcher = 0;
+	_pRemoteObject = 0;
+	_serverSocket.close();
+	_pSensor = 0;
+}
+
+
+void RemotingPath::run()
+{
+	Poco::Net::StreamSocket socket = _serverSocket.acceptConnection();
+	socket.setNoDelay(true);
+
+	Poco::RemotingNG::BinaryDeserializer deserializer;
+	std::string payload;
+	unsigned char header[4];
+	while (receiveFully(socket, reinterpret_cast<char*>(header), 4))
+	{
+		Poco::UInt32 length = (header[0] << 24) | (header[1] << 16) | (header[2] << 8) | header[3];
+		payload.resize(length);
+		if (!receiveFully(socket, &payload[0], static_cast<int>(length))) break;
+
+		std::istringstream istr(payload);
+		deserializer.setup(istr);
+		std::string name;
+		Poco::RemotingNG::SerializerBase::MessageType type = deserializer.findMessage(name);
+		deserializer.deserializeMessageBegin(name, type);
+		double value;
+		Poco::RemotingNG::TypeDeserializer<double>::deserialize("data", true, deserializer, value);
+		deserializer.deserializeMessageEnd(name, type);
+		_pReceiver->received(static_cast<Poco::Int64>(value));
+	}
+}
+
+
+//
+// WebSocketPath
+//
+
+
+const std::string WebSocketPath::SUBJECT("io.macchina.benchmark.sensor.valueChanged");
+
+
+WebSocketPath::Sender::Sender(WebSocketPath& path):
+	_path(path)
+{
+}
+
+
+void WebSocketPath::Sender::run()
+{
+	std::string prefix("NOTIFY ");
+	prefix += SUBJECT;
+	prefix += " WebEvent/1.0\r\n";
+
+	Poco::AutoPtr<Poco::Notification> pNf = _path._queue.waitDequeueNotification();
+	while (pNf)
+	{
+		ValueNotification::Ptr pValueNf = pNf.cast<ValueNotification>();
+		std::string message(prefix);
+		message += "{\"value\":";
+		message += Poco::NumberFormatter::format(static_cast<Poco::Int64>(pValueNf->value()));
+		message += "}";
+		_path._pServerSocket->sendFrame(message.data(), static_cast<int>(message.size()));
+		pNf = _path._queue.waitDequeueNotification();
+	}
+}
+
+
+WebSocketPath::WebSocketPath():
+	LatencyPath("websocket"),
+	_pReceiver(0),
+	_pServerSocket(0),
+	_sender(*this)
+{
+}
+
+
+WebSocketPath::~WebSocketPath()
+{
+}
+
+
+void WebSocketPath::open(BenchmarkSensor::Ptr pSensor, LatencyReceiver& receiver)
+{
+	_pSensor = pSensor;
+	_pReceiver = &receiver;
+	_closed.reset();
+
+	Poco::Net::HTTPServerParams::Ptr pParams = new Poco::Net::HTTPServerParams;
+	pParams->setMaxThreads(1);
+	_pServer = new Poco::Net::HTTPServer(new WebSocketRequestHandlerFactory(*this), Poco::Net::ServerSocket(Poco::Net::SocketAddress("127.0.0.1", 0)), pParams);
+	_pServer->start();
+
+	Poco::Net::HTTPClientSession session("127.0.0.1", _pServer->port());
+	Poco::Net::HTTPRequest request(Poco::Net::HTTPRequest::HTTP_GET, "/webevent", Poco::Net::HTTPRequest::HTTP_1_1);
+	Poco::Net::HTTPResponse response;
+	_pClientSocket = new Poco::Net::WebSocket(session, request, response);
+	_pClientSocket->setNoDelay(true);
+	_connected.wait(5000);
+
+	_senderThread.start(_sender);
+	_receiverThread.start(*this);
+	_pSensor->valueChanged += Poco::delegate(this, &WebSocketPath::onValueChanged);
+}
+
+
+void WebSocketPath::close()
+{
+	_pSensor->valueChanged -= Poco::delegate(this, &WebSocketPath::onValueChanged);
+	_queue.wakeUpAll();
+	_senderThread.join();
+	_pServerSocket->shutdown();
+	_receiverThread.join();
+	_closed.set();
+	_pServer->stopAll(true);
+	_pServer = 0;
+	_pClientSocket = 0;
+	_pSensor = 0;
+}
+
+
+void WebSocketPath::accept(Poco::Net::WebSocket& webSocket)
+{
+	_pServerSocket = &webSocket;
+	_connected.set();
+	_closed.wait();
+	_pServerSocket = 0;
+}
+
+
+void WebSocketPath::onValueChanged(const double& value)
+{
+	_queue.enqueueNotification(new ValueNotification(value));
+}
+
+
+void WebSocketPath::run()
+{
+	Poco::JSON::Parser parser;
+	Poco::Buffer<char> buffer(1024);
+	int flags;
+	int n = _pClientSocket->receiveFrame(buffer.begin(), static_cast<int>(buffer.size()), flags);
+	while (n > 0 && (flags & Poco::Net::WebSocket::FRAME_OP_BITMASK) != Poco::Net::WebSocket::FRAME_OP_CLOSE)
+	{
+		std::string message(buffer.begin(), n);
+		std::string::size_type pos = message.find("\r\n");
+		if (pos != std::string::npos)
+		{
+			parser.reset();
+			Poco::JSON::Object::Ptr pData = parser.parse(message.substr(pos + 2)).extract<Poco::JSON::Object::Ptr>();
+			_pReceiver->received(static_cast<Poco::Int64>(pData->getValue<double>("value")));
+		}
+		n = _pClientSocket->receiveFrame(buffer.begin(), static_cast<int>(buffer.size()), flags);
+	}
+}
+
+
+//
+// MQTTPacketPath
+//
+
+
+const std::string MQTTPacketPath::TOPIC("macchina/benchmark/sensor/value");
+
+
+MQTTPacketPath::MQTTPacketPath():
+	LatencyPath("mqttpacket"),
+	_pReceiver(0)
+{
+}
+
+
+MQTTPacketPath::~MQTTPacketPath()
+{
+}
+
+
+void MQTTPacketPath::open(BenchmarkSensor::Ptr pSensor, LatencyReceiver& receiver)
+{
+	_pSensor = pSensor;
+	_pReceiver = &receiver;
+	_serverSocket.bind(Poco::Net::SocketAddress("127.0.0.1", 0));
+	_serverSocket.listen();
+	_thread.start(*this);
+	_clientSocket.connect(_serverSocket.address());
+	_clientSocket.setNoDelay(true);
+	_pSensor->valueChanged += Poco::delegate(this, &MQTTPacketPath::onValueChanged);
+}
+
+
+void MQTTPacketPath::close()
+{
+	_pSensor->valueChanged -= Poco::delegate(this, &MQTTPacketPath::onValueChanged);
+	_clientSocket.shutdownSend();
+	_thread.join();
+	_clientSocket.close();
+	_serverSocket.close();
+	_pSensor = 0;
+}
+
+
+void MQTTPacketPath::onValueChanged(const double& value)
+{
+	std::string payload = Poco::NumberFormatter::format(static_cast<Poco::Int64>(value));
+	std::size_t remaining = 2 + TOPIC.size() + payload.size();
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_packet.clear();
+	_packet += static_cast<char>(0x30); // PUBLISH, QoS 0
+	do
+	{
+		char byte = static_cast<char>(remaining & 0x7F);
+		remaining >>= 7;
+		if (remaining > 0) byte |= 0x80;
+		_packet += byte;
+	}
+	while (remaining > 0);
+	_packet += static_cast<char>(TOPIC.size() >> 8);
+	_packet += static_cast<char>(TOPIC.size() & 0xFF);
+	_packet += TOPIC;
+	_packet += payload;
+	sendFully(_clientSocket, _packet.data(), static_cast<int>(_packet.size()));
+}
+
+
+void MQTTPacketPath::run()
+{
+	Poco::Net::StreamSocket socket = _serverSocket.acceptConnection();
+	socket.setNoDelay(true);
+
+	std::string body;
+	unsigned char byte;
+	while (receiveFully(socket, reinterpret_cast<char*>(&byte), 1))
+	{
+		if ((byte & 0xF0) != 0x30) throw Poco::Net::NetException("unexpected MQTT packet type");
+
+		std::size_t length = 0;
+		int shift = 0;
+		do
+		{
+			if (!receiveFully(socket, reinterpret_cast<char*>(&byte), 1)) return;
+			length |= static_cast<std::size_t>(byte & 0x7F) << shift;
+			shift += 7;
+		}
+		while (byte & 0x80);
+
+		body.resize(length);
+		if (!receiveFully(socket, &body[0], static_cast<int>(length))) return;
+
+		std::size_t topicLength = (static_cast<unsigned char>(body[0]) << 8) | static_cast<unsigned char>(body[1]);
+		double value = Poco::NumberParser::parseFloat(body.substr(2 + topicLength));
+		_pReceiver->received(static_cast<Poco::Int64>(value));
+	}
+}
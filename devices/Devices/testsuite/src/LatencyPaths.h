@@ -0,0 +1,255 @@
+//
+// LatencyPaths.h
+//
+// Definition of the delivery paths measured by EventLatencyBenchmark.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef LatencyPaths_INCLUDED
+#define LatencyPaths_INCLUDED
+
+
+#include "BenchmarkSensor.h"
+#include "IoT/Devices/SensorRemoteObject.h"
+#include "IoT/Devices/SensorEventDispatcher.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/WebSocket.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/NotificationQueue.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/AutoPtr.h"
+
+
+class LatencyReceiver
+	/// Receives the sequence numbers of delivered events.
+{
+public:
+	virtual void received(Poco::Int64 sequence) = 0;
+		/// Called by a LatencyPath when the event with the given
+		/// sequence number has arrived at the far end.
+
+	virtual ~LatencyReceiver();
+};
+
+
+class LatencyPath
+	/// A delivery path from a Sensor's valueChanged event
+	/// to a subscriber.
+	///
+	/// The sensor value carries the sequence number of the
+	/// event. The subscriber end of a path decodes the value
+	/// and passes it to the LatencyReceiver.
+{
+public:
+	typedef Poco::SharedPtr<LatencyPath> Ptr;
+
+	explicit LatencyPath(const std::string& name);
+		/// Creates the LatencyPath.
+
+	virtual ~LatencyPath();
+		/// Destroys the LatencyPath.
+
+	const std::string& name() const;
+		/// Returns the name of the path.
+
+	virtual void open(BenchmarkSensor::Ptr pSensor, LatencyReceiver& receiver) = 0;
+		/// Connects the sensor to the receiver.
+
+	virtual void close() = 0;
+		/// Disconnects the sensor from the receiver.
+
+private:
+	std::string _name;
+};
+
+
+class DirectPath: public LatencyPath
+	/// A C++ delegate, called synchronously by the sensor.
+	/// This is the baseline for all other paths.
+{
+public:
+	DirectPath();
+	~DirectPath();
+
+	void open(BenchmarkSensor::Ptr pSensor, LatencyReceiver& receiver);
+	void close();
+
+protected:
+	void onValueChanged(const double& value);
+
+private:
+	BenchmarkSensor::Ptr _pSensor;
+	LatencyReceiver* _pReceiver;
+};
+
+
+class QueuePath: public LatencyPath, public Poco::Runnable
+	/// Hands every event over to another thread via a
+	/// Poco::NotificationQueue.
+	///
+	/// This only measures a thread hand-off. It does not use the
+	/// JavaScript bridge and does not run a script, so it is a lower
+	/// bound for the delivery to a JavaScript event handler, not a
+	/// measurement of it.
+{
+public:
+	QueuePath();
+	~QueuePath();
+
+	void open(BenchmarkSensor::Ptr pSensor, LatencyReceiver& receiver);
+	void close();
+
+protected:
+	void onValueChanged(const double& value);
+	void run();
+
+private:
+	BenchmarkSensor::Ptr _pSensor;
+	LatencyReceiver* _pReceiver;
+	Poco::NotificationQueue _queue;
+	Poco::Thread _thread;
+};
+
+
+class RemotingPath: public LatencyPath, public Poco::Runnable
+	/// Delivers events through the RemotingNG event dispatcher
+	/// generated for IoT::Devices::Sensor, to a subscriber at
+	/// the other end of a loopback TCP connection.
+	///
+	/// The events are serialized with the RemotingNG binary
+	/// serializer and sent as length-prefixed frames by a
+	/// minimal loopback Transport. The subscriber deserializes
+	/// the event message. This exercises everything the TCP
+	/// transport does for an event, except its framing and
+	/// connection management.
+{
+public:
+	RemotingPath();
+	~RemotingPath();
+
+	void open(BenchmarkSensor::Ptr pSensor, LatencyReceiver& receiver);
+	void close();
+
+	static const std::string PROTOCOL;
+
+protected:
+	void run();
+
+private:
+	BenchmarkSensor::Ptr _pSensor;
+	LatencyReceiver* _pReceiver;
+	Poco::AutoPtr<IoT::Devices::SensorRemoteObject> _pRemoteObject;
+	Poco::AutoPtr<IoT::Devices::SensorEventDispatcher> _pEventDispatcher;
+	Poco::Net::ServerSocket _serverSocket;
+	Poco::Thread _thread;
+};
+
+
+class WebSocketPath: public LatencyPath, public Poco::Runnable
+	/// Queues every event for a worker thread, which formats a
+	/// WebEvent NOTIFY message with a JSON payload and sends it as
+	/// a WebSocket frame. A WebSocket client on the loopback
+	/// interface receives the frame and parses the payload.
+	///
+	/// This measures the WebSocket transport of a NOTIFY message.
+	/// It does not use the WebEvent service (which needs an OSP
+	/// framework), so subscription handling and the service's
+	/// own queuing are not included.
+{
+public:
+	WebSocketPath();
+	~WebSocketPath();
+
+	void open(BenchmarkSensor::Ptr pSensor, LatencyReceiver& receiver);
+	void close();
+
+	void accept(Poco::Net::WebSocket& webSocket);
+		/// Called by the server's request handler with the
+		/// server end of the WebSocket connection.
+		/// Returns when the path is closed.
+
+	static const std::string SUBJECT;
+
+protected:
+	void onValueChanged(const double& value);
+	void run();
+
+private:
+	class Sender: public Poco::Runnable
+	{
+	public:
+		Sender(WebSocketPath& path);
+		void run();
+
+	private:
+		WebSocketPath& _path;
+	};
+
+	BenchmarkSensor::Ptr _pSensor;
+	LatencyReceiver* _pReceiver;
+	Poco::SharedPtr<Poco::Net::HTTPServer> _pServer;
+	Poco::SharedPtr<Poco::Net::WebSocket> _pClientSocket;
+	Poco::Net::WebSocket* _pServerSocket;
+	Poco::Event _connected;
+	Poco::Event _closed;
+	Poco::NotificationQueue _queue;
+	Sender _sender;
+	Poco::Thread _senderThread;
+	Poco::Thread _receiverThread;
+};
+
+
+class MQTTPacketPath: public LatencyPath, public Poco::Runnable
+	/// Encodes every event as an MQTT 3.1.1 PUBLISH packet (QoS 0)
+	/// and sends it, from the thread firing the event, to a broker
+	/// stand-in on the loopback interface, which decodes the packet
+	/// and the payload.
+	///
+	/// This measures the encoding and transport of a PUBLISH packet.
+	/// It does not use the MQTT client (which needs the Paho library
+	/// and a broker), so the client's own queuing and locking are
+	/// not included.
+{
+public:
+	MQTTPacketPath();
+	~MQTTPacketPath();
+
+	void open(BenchmarkSensor::Ptr pSensor, LatencyReceiver& receiver);
+	void close();
+
+	static const std::string TOPIC;
+
+protected:
+	void onValueChanged(const double& value);
+	void run();
+
+private:
+	BenchmarkSensor::Ptr _pSensor;
+	LatencyReceiver* _pReceiver;
+	Poco::Net::ServerSocket _serverSocket;
+	Poco::Net::StreamSocket _clientSocket;
+	std::string _packet;
+	Poco::FastMutex _mutex;
+	Poco::Thread _thread;
+};
+
+
+//
+// inlines
+//
+inline const std::string& LatencyPath::name() const
+{
+	return _name;
+}
+
+
+#endif // LatencyPaths_INCLUDED
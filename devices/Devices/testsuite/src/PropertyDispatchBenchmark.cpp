@@ -0,0 +1,278 @@
+//
+// PropertyDispatchBenchmark.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// A microbenchmark for DeviceImpl property and feature dispatch.
+//
+// The benchmark device has a typical set of properties, some with
+// Poco::Any getters (like most existing devices), and one with a
+// typed getter. For comparison, the benchmark also includes the
+// dispatch DeviceImpl used before properties were stored in a
+// NameTable (a std::map lookup followed by a Poco::Any getter).
+//
+
+
+#include "IoT/Devices/Sensor.h"
+#include "IoT/Devices/DeviceImpl.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Format.h"
+#include <iostream>
+#include <map>
+
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::OptionCallback;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using namespace IoT::Devices;
+
+
+class DispatchSensor: public DeviceImpl<Sensor, DispatchSensor>
+	/// A Sensor with the properties of a typical device.
+{
+public:
+	DispatchSensor():
+		_value(21.5),
+		_enabled(true)
+	{
+		addProperty("displayValue", &DispatchSensor::getDisplayValue);
+		addProperty("physicalQuantity", &DispatchSensor::getPhysicalQuantity);
+		addProperty("physicalUnit", &DispatchSensor::getPhysicalUnit);
+		addProperty("valueChangedPeriod", &DispatchSensor::getAnyInt);
+		addProperty("valueChangedDelta", &DispatchSensor::getAnyValue);
+		addProperty("deviceIdentifier", &DispatchSensor::getAnyString);
+		addProperty("symbolicName", &DispatchSensor::getAnyString);
+		addProperty("name", &DispatchSensor::getAnyString);
+		addProperty("type", &DispatchSensor::getAnyString);
+		addProperty("value", &DispatchSensor::getAnyValue);
+		addProperty("typedValue", &DispatchSensor::getTypedValue);
+		addFeature("enabled", &DispatchSensor::getEnabled);
+	}
+
+	double value() const
+	{
+		return _value;
+	}
+
+	bool ready() const
+	{
+		return true;
+	}
+
+	Poco::Any getAnyValue(const std::string&) const
+	{
+		return _value;
+	}
+
+	double getTypedValue(const std::string&) const
+	{
+		return _value;
+	}
+
+	Poco::Any getAnyInt(const std::string&) const
+	{
+		return 0;
+	}
+
+	Poco::Any getAnyString(const std::string&) const
+	{
+		return std::string("sensor");
+	}
+
+	Poco::Any getDisplayValue(const std::string&) const
+	{
+		return std::string("21.5");
+	}
+
+	Poco::Any getPhysicalQuantity(const std::string&) const
+	{
+		return std::string("temperature");
+	}
+
+	Poco::Any getPhysicalUnit(const std::string&) const
+	{
+		return std::string("Cel");
+	}
+
+	bool getEnabled(const std::string&) const
+	{
+		return _enabled;
+	}
+
+private:
+	double _value;
+	bool _enabled;
+};
+
+
+class MapDispatch
+	/// The previous DeviceImpl property dispatch, for comparison.
+{
+public:
+	typedef Poco::Any (DispatchSensor::*Getter)(const std::string&) const;
+
+	MapDispatch(const DispatchSensor& sensor):
+		_sensor(sensor)
+	{
+		_getters["displayValue"] = &DispatchSensor::getDisplayValue;
+		_getters["physicalQuantity"] = &DispatchSensor::getPhysicalQuantity;
+		_getters["physicalUnit"] = &DispatchSensor::getPhysicalUnit;
+		_getters["valueChangedPeriod"] = &DispatchSensor::getAnyInt;
+		_getters["valueChangedDelta"] = &DispatchSensor::getAnyValue;
+		_getters["deviceIdentifier"] = &DispatchSensor::getAnyString;
+		_getters["symbolicName"] = &DispatchSensor::getAnyString;
+		_getters["name"] = &DispatchSensor::getAnyString;
+		_getters["type"] = &DispatchSensor::getAnyString;
+		_getters["value"] = &DispatchSensor::getAnyValue;
+	}
+
+	double getPropertyDouble(const std::string& name) const
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		std::map<std::string, Getter>::const_iterator it = _getters.find(name);
+		if (it != _getters.end())
+			return Poco::AnyCast<double>((_sensor.*it->second)(name));
+		else
+			throw NotSupportedException(name);
+	}
+
+private:
+	const DispatchSensor& _sensor;
+	std::map<std::string, Getter> _getters;
+	mutable Poco::Mutex _mutex;
+};
+
+
+class PropertyDispatchBenchmark: public Application
+{
+public:
+	PropertyDispatchBenchmark():
+		_helpRequested(false),
+		_calls(10000000)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<PropertyDispatchBenchmark>(this, &PropertyDispatchBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("calls", "n", "Number of calls per measurement (default 10000000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 1000000000))
+				.binding("benchmark.calls"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("Microbenchmark measuring the cost of DeviceImpl property and feature dispatch.");
+		helpFormatter.format(std::cout);
+	}
+
+	void report(const std::string& what, const Poco::Stopwatch& sw, double sum)
+	{
+		double ns = 1000.0*sw.elapsed()/_calls;
+		std::cout << Poco::format("%-48s %8.1f", what, ns);
+		// keep the compiler from optimizing the calls away
+		std::cout << (sum == 0.5 ? " " : "") << std::endl;
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		_calls = config().getInt("benchmark.calls", _calls);
+
+		DispatchSensor sensor;
+		MapDispatch mapDispatch(sensor);
+		const std::string value("value");
+		const std::string typedValue("typedValue");
+		const std::string enabled("enabled");
+		DispatchSensor::PropertyHandle hValue = sensor.propertyHandle(value);
+		DispatchSensor::PropertyHandle hTypedValue = sensor.propertyHandle(typedValue);
+		DispatchSensor::FeatureHandle hEnabled = sensor.featureHandle(enabled);
+
+		std::cout << Poco::format("%d calls per measurement, times in nanoseconds per call", _calls) << std::endl;
+
+		Poco::Stopwatch sw;
+		double sum = 0;
+
+		sw.start();
+		for (int i = 0; i < _calls; i++) sum += mapDispatch.getPropertyDouble(value);
+		sw.stop();
+		report("getPropertyDouble(name), std::map, Poco::Any", sw, sum);
+
+		sw.restart();
+		for (int i = 0; i < _calls; i++) sum += sensor.getPropertyDouble(value);
+		sw.stop();
+		report("getPropertyDouble(name), Poco::Any", sw, sum);
+
+		sw.restart();
+		for (int i = 0; i < _calls; i++) sum += sensor.getPropertyDouble(hValue);
+		sw.stop();
+		report("getPropertyDouble(handle), Poco::Any", sw, sum);
+
+		sw.restart();
+		for (int i = 0; i < _calls; i++) sum += sensor.getPropertyDouble(typedValue);
+		sw.stop();
+		report("getPropertyDouble(name), typed", sw, sum);
+
+		sw.restart();
+		for (int i = 0; i < _calls; i++) sum += sensor.getPropertyDouble(hTypedValue);
+		sw.stop();
+		report("getPropertyDouble(handle), typed", sw, sum);
+
+		sw.restart();
+		for (int i = 0; i < _calls; i++) sum += sensor.getFeature(enabled);
+		sw.stop();
+		report("getFeature(name)", sw, sum);
+
+		sw.restart();
+		for (int i = 0; i < _calls; i++) sum += sensor.getFeature(hEnabled);
+		sw.stop();
+		report("getFeature(handle)", sw, sum);
+
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+	int _calls;
+};
+
+
+POCO_APP_MAIN(PropertyDispatchBenchmark)
@@ -0,0 +1,505 @@
+//
+// SampleBufferTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "SampleBufferTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "IoT/Devices/SampleBuffer.h"
+#include "IoT/Devices/BufferedSampleStream.h"
+#include "Poco/Delegate.h"
+#include "Poco/Exception.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+
+
+using namespace IoT::Devices;
+
+
+namespace
+{
+	void addSample(SampleBuffer& buffer, Poco::Timestamp::TimeVal time, double value, bool expectComplete)
+	{
+		double values[2] = {value, -value};
+		bool complete = buffer.add(Poco::Timestamp(time), values);
+		poco_assert (complete == expectComplete);
+	}
+
+	BufferedSampleStream::Params streamParams(int blockSize, int blockLatency)
+	{
+		BufferedSampleStream::Params params;
+		params.name = "Test Stream";
+		params.symbolicName = "io.macchina.test.stream";
+		params.channelNames.push_back("x");
+		params.blockSize = blockSize;
+		params.blockLatency = blockLatency;
+		params.bufferSize = 64;
+		return params;
+	}
+
+	class SampleProducer: public Poco::Runnable
+	{
+	public:
+		SampleProducer(BufferedSampleStream& stream, int samples):
+			_stream(stream),
+			_samples(samples)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _samples; i++)
+			{
+				double value = i;
+				_stream.addSample(Poco::Timestamp(), &value);
+			}
+		}
+
+	private:
+		BufferedSampleStream& _stream;
+		int _samples;
+	};
+}
+
+
+SampleBufferTest::SampleBufferTest(const std::string& name):
+	CppUnit::TestCase(name)
+{
+}
+
+
+SampleBufferTest::~SampleBufferTest()
+{
+}
+
+
+void SampleBufferTest::testBlockSize()
+{
+	SampleBuffer buffer(2, 3, 0, 8);
+	SampleBlock block;
+
+	assert (!buffer.takeBlock(block));
+
+	addSample(buffer, 1000, 1, false);
+	addSample(buffer, 2000, 2, false);
+	addSample(buffer, 3000, 3, true);
+	assert (buffer.pending() == 3);
+
+	assert (buffer.takeBlock(block));
+	assert (block.sequence == 0);
+	assert (block.channels == 2);
+	assert (block.timestamps.size() == 3);
+	assert (block.timestamps[0] == 1000);
+	assert (block.timestamps[2] == 3000);
+	assert (block.samples.size() == 6);
+	assert (block.samples[0] == 1);
+	assert (block.samples[1] == -1);
+	assert (block.samples[4] == 3);
+	assert (block.samples[5] == -3);
+	assert (buffer.pending() == 0);
+	assert (buffer.size() == 3);
+
+	addSample(buffer, 4000, 4, false);
+	assert (buffer.flush(block));
+	assert (block.sequence == 3);
+	assert (block.timestamps.size() == 1);
+	assert (block.samples[0] == 4);
+	assert (!buffer.flush(block));
+}
+
+
+void SampleBufferTest::testBlockLatency()
+{
+	SampleBuffer buffer(2, 100, 5000, 200);
+	SampleBlock block;
+
+	addSample(buffer, 10000, 1, false);
+	addSample(buffer, 12000, 2, false);
+	addSample(buffer, 14999, 3, false);
+	addSample(buffer, 15000, 4, true);
+
+	assert (buffer.takeBlock(block));
+	assert (block.sequence == 0);
+	assert (block.timestamps.size() == 4);
+
+	addSample(buffer, 16000, 5, false);
+	addSample(buffer, 21000, 6, true);
+}
+
+
+void SampleBufferTest::testRecent()
+{
+	SampleBuffer buffer(2, 2, 0, 4);
+	SampleBlock block;
+
+	buffer.recent(0, block);
+	assert (block.timestamps.empty());
+
+	addSample(buffer, 1000, 1, false);
+	addSample(buffer, 2000, 2, true);
+	addSample(buffer, 3000, 3, true);
+
+	buffer.recent(0, block);
+	assert (block.sequence == 0);
+	assert (block.timestamps.size() == 3);
+
+	buffer.recent(2, block);
+	assert (block.sequence == 2);
+	assert (block.timestamps.size() == 1);
+	assert (block.samples[0] == 3);
+
+	buffer.recent(3, block);
+	assert (block.sequence == 3);
+	assert (block.timestamps.empty());
+
+	buffer.clear();
+	buffer.recent(0, block);
+	assert (block.sequence == 3);
+	assert (block.timestamps.empty());
+	assert (buffer.nextSequence() == 3);
+}
+
+
+void SampleBufferTest::testOverflow()
+{
+	SampleBuffer buffer(2, 2, 0, 4);
+	SampleBlock block;
+
+	for (int i = 0; i < 6; i++)
+	{
+		double values[2] = {i*1.0, -i*1.0};
+		buffer.add(Poco::Timestamp(1000*i), values);
+		buffer.takeBlock(block);
+	}
+	assert (buffer.size() == 4);
+
+	// The oldest samples have been overwritten, and the
+	// buffered samples wrap around the end of the ring.
+	buffer.recent(0, block);
+	assert (block.sequence == 2);
+	assert (block.timestamps.size() == 4);
+	for (int i = 0; i < 4; i++)
+	{
+		assert (block.timestamps[i] == 1000*(i + 2));
+		assert (block.samples[2*i] == i + 2);
+		assert (block.samples[2*i + 1] == -(i + 2));
+	}
+
+	// Pending samples not taken are overwritten, too.
+	for (int i = 6; i < 12; i++)
+	{
+		double values[2] = {i*1.0, -i*1.0};
+		buffer.add(Poco::Timestamp(1000*i), values);
+	}
+	assert (buffer.pending() == 4);
+	assert (buffer.takeBlock(block));
+	assert (block.sequence == 8);
+	assert (block.samples[0] == 8);
+}
+
+
+void SampleBufferTest::testSetBlockSize()
+{
+	SampleBuffer buffer(2, 2, 0, 2);
+	SampleBlock block;
+
+	addSample(buffer, 1000, 1, false);
+	addSample(buffer, 2000, 2, true);
+	assert (buffer.takeBlock(block));
+	addSample(buffer, 3000, 3, false);
+
+	buffer.setBlockSize(4);
+	assert (buffer.capacity() == 4);
+	assert (buffer.size() == 2);
+	assert (buffer.pending() == 1);
+
+	addSample(buffer, 4000, 4, false);
+	addSample(buffer, 5000, 5, false);
+	addSample(buffer, 6000, 6, true);
+
+	buffer.recent(0, block);
+	assert (block.sequence == 2);
+	assert (block.timestamps.size() == 4);
+	assert (block.samples[0] == 3);
+	assert (block.samples[6] == 6);
+
+	try
+	{
+		buffer.setBlockSize(0);
+		fail("block size must be at least 1");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void SampleBufferTest::testBufferedSampleStream()
+{
+	BufferedSampleStream::Params params;
+	params.name = "Test Stream";
+	params.symbolicName = "io.macchina.test.stream";
+	params.channelNames.push_back("x");
+	params.channelNames.push_back("y");
+	params.blockSize = 2;
+	params.blockLatency = 0;
+	params.bufferSize = 8;
+
+	BufferedSampleStream stream(params);
+	stream.samplesAvailable += Poco::delegate(this, &SampleBufferTest::onSamplesAvailable);
+
+	assert (stream.channels() == 2);
+	assert (stream.getPropertyString("type") == BufferedSampleStream::TYPE);
+	assert (stream.getPropertyInt(SampleStream::PROP_BLOCK_SIZE) == 2);
+
+	double values[2] = {1, 2};
+	stream.addSample(Poco::Timestamp(1000), values);
+	assert (_blocks.empty());
+	stream.addSample(Poco::Timestamp(2000), values);
+	assert (_blocks.size() == 1);
+	assert (_blocks[0].timestamps.size() == 2);
+
+	stream.setPropertyInt(SampleStream::PROP_BLOCK_SIZE, 3);
+	stream.addSample(Poco::Timestamp(3000), values);
+	stream.addSample(Poco::Timestamp(4000), values);
+	assert (_blocks.size() == 1);
+	stream.flush();
+	assert (_blocks.size() == 2);
+	assert (_blocks[1].sequence == 2);
+	assert (_blocks[1].timestamps.size() == 2);
+
+	SampleBlock recent = stream.recentSamples(1);
+	assert (recent.sequence == 1);
+	assert (recent.timestamps.size() == 3);
+
+	stream.samplesAvailable -= Poco::delegate(this, &SampleBufferTest::onSamplesAvailable);
+}
+
+
+void SampleBufferTest::testInvalidParams()
+{
+	try
+	{
+		SampleBuffer buffer(0, 4, 0, 16);
+		fail("no channels - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	try
+	{
+		SampleBuffer buffer(-1, 4, 0, 16);
+		fail("negative channels - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	try
+	{
+		SampleBuffer buffer(2, 0, 0, 16);
+		fail("block size 0 - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	BufferedSampleStream::Params params = streamParams(-1, 0);
+	try
+	{
+		BufferedSampleStream stream(params);
+		fail("negative block size - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	params = streamParams(4, -1);
+	try
+	{
+		BufferedSampleStream stream(params);
+		fail("negative block latency - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	params = streamParams(4, 0);
+	params.bufferSize = -1;
+	try
+	{
+		BufferedSampleStream stream(params);
+		fail("negative buffer size - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	params = streamParams(4, 0);
+	params.channelNames.clear();
+	try
+	{
+		BufferedSampleStream stream(params);
+		fail("no channels - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void SampleBufferTest::testExpired()
+{
+	SampleBuffer buffer(2, 4, 1000, 16);
+	assert (!buffer.expired(Poco::Timestamp(100000)));
+
+	addSample(buffer, 10000, 1, false);
+	assert (!buffer.expired(Poco::Timestamp(10999)));
+	assert (buffer.expired(Poco::Timestamp(11000)));
+
+	SampleBlock block;
+	assert (buffer.flush(block));
+	assert (!buffer.expired(Poco::Timestamp(20000)));
+
+	buffer.setBlockLatency(0);
+	addSample(buffer, 30000, 2, false);
+	assert (!buffer.expired(Poco::Timestamp(100000)));
+}
+
+
+void SampleBufferTest::testTimedFlush()
+{
+	BufferedSampleStream::Params params = streamParams(100, 50);
+	params.pTimer = new Poco::Util::Timer;
+	{
+		BufferedSampleStream stream(params);
+		stream.samplesAvailable += Poco::delegate(this, &SampleBufferTest::onSamplesAvailable);
+
+		double value = 1;
+		stream.addSample(Poco::Timestamp(), &value);
+		stream.addSample(Poco::Timestamp(), &value);
+		Poco::Thread::sleep(300);
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			assert (_blocks.size() == 1);
+			assert (_blocks[0].sequence == 0);
+			assert (_blocks[0].timestamps.size() == 2);
+		}
+
+		// no further block without new samples
+		Poco::Thread::sleep(100);
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			assert (_blocks.size() == 1);
+		}
+
+		// without a latency limit, nothing is flushed
+		stream.setPropertyInt(SampleStream::PROP_BLOCK_LATENCY, 0);
+		stream.addSample(Poco::Timestamp(), &value);
+		Poco::Thread::sleep(150);
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			assert (_blocks.size() == 1);
+		}
+
+		stream.setPropertyInt(SampleStream::PROP_BLOCK_LATENCY, 20);
+		Poco::Thread::sleep(150);
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			assert (_blocks.size() == 2);
+			assert (_blocks[1].sequence == 2);
+		}
+
+		stream.samplesAvailable -= Poco::delegate(this, &SampleBufferTest::onSamplesAvailable);
+	}
+	params.pTimer->cancel(true);
+}
+
+
+void SampleBufferTest::testConcurrentOrder()
+{
+	const int THREADS = 4;
+	const int SAMPLES = 5000;
+
+	BufferedSampleStream::Params params = streamParams(7, 0);
+	BufferedSampleStream stream(params);
+	stream.samplesAvailable += Poco::delegate(this, &SampleBufferTest::onSamplesAvailable);
+
+	std::vector<SampleProducer*> producers;
+	std::vector<Poco::Thread*> threads;
+	for (int i = 0; i < THREADS; i++)
+	{
+		producers.push_back(new SampleProducer(stream, SAMPLES));
+		threads.push_back(new Poco::Thread);
+	}
+	for (int i = 0; i < THREADS; i++)
+	{
+		threads[i]->start(*producers[i]);
+	}
+	for (int i = 0; i < THREADS; i++)
+	{
+		threads[i]->join();
+		delete threads[i];
+		delete producers[i];
+	}
+	stream.flush();
+	stream.samplesAvailable -= Poco::delegate(this, &SampleBufferTest::onSamplesAvailable);
+
+	// blocks must be delivered in sequence order, without gaps
+	Poco::Int64 sequence = 0;
+	for (std::vector<SampleBlock>::const_iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+	{
+		assert (it->sequence == sequence);
+		sequence += static_cast<Poco::Int64>(it->timestamps.size());
+	}
+	assert (sequence == THREADS*SAMPLES);
+}
+
+
+void SampleBufferTest::setUp()
+{
+	_blocks.clear();
+}
+
+
+void SampleBufferTest::tearDown()
+{
+}
+
+
+void SampleBufferTest::onSamplesAvailable(const void* sender, const IoT::Devices::SampleBlock& block)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_blocks.push_back(block);
+}
+
+
+CppUnit::Test* SampleBufferTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SampleBufferTest");
+
+	CppUnit_addTest(pSuite, SampleBufferTest, testBlockSize);
+	CppUnit_addTest(pSuite, SampleBufferTest, testBlockLatency);
+	CppUnit_addTest(pSuite, SampleBufferTest, testRecent);
+	CppUnit_addTest(pSuite, SampleBufferTest, testOverflow);
+	CppUnit_addTest(pSuite, SampleBufferTest, testSetBlockSize);
+	CppUnit_addTest(pSuite, SampleBufferTest, testBufferedSampleStream);
+	CppUnit_addTest(pSuite, SampleBufferTest, testInvalidParams);
+	CppUnit_addTest(pSuite, SampleBufferTest, testExpired);
+	CppUnit_addTest(pSuite, SampleBufferTest, testTimedFlush);
+	CppUnit_addTest(pSuite, SampleBufferTest, testConcurrentOrder);
+
+	return pSuite;
+}
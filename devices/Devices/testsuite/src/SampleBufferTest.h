@@ -0,0 +1,54 @@
+//
+// SampleBufferTest.h
+//
+// Definition of the SampleBufferTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef SampleBufferTest_INCLUDED
+#define SampleBufferTest_INCLUDED
+
+
+#include "IoT/Devices/Devices.h"
+#include "IoT/Devices/SampleStream.h"
+#include "CppUnit/TestCase.h"
+#include "Poco/Mutex.h"
+
+
+class SampleBufferTest: public CppUnit::TestCase
+{
+public:
+	SampleBufferTest(const std::string& name);
+	~SampleBufferTest();
+
+	void testBlockSize();
+	void testBlockLatency();
+	void testRecent();
+	void testOverflow();
+	void testSetBlockSize();
+	void testBufferedSampleStream();
+	void testInvalidParams();
+	void testExpired();
+	void testTimedFlush();
+	void testConcurrentOrder();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+protected:
+	void onSamplesAvailable(const void* sender, const IoT::Devices::SampleBlock& block);
+
+private:
+	std::vector<IoT::Devices::SampleBlock> _blocks;
+	Poco::FastMutex _mutex;
+};
+
+
+#endif // SampleBufferTest_INCLUDED
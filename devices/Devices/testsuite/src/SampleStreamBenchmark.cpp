@@ -0,0 +1,202 @@
+//
+// SampleStreamBenchmark.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// A microbenchmark comparing the in-process cost of delivering
+// three-channel samples with one event per sample (like the
+// accelerationChanged event of an Accelerometer) and in blocks
+// with a BufferedSampleStream.
+//
+// Both variants have a single local subscriber, which adds up
+// all values it receives. Remote subscribers are not included.
+//
+
+
+#include "IoT/Devices/Accelerometer.h"
+#include "IoT/Devices/BufferedSampleStream.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/BasicEvent.h"
+#include "Poco/Delegate.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Format.h"
+#include <iostream>
+
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::OptionCallback;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using namespace IoT::Devices;
+
+
+class SampleSubscriber
+	/// Counts the events and adds up all values received.
+{
+public:
+	SampleSubscriber():
+		events(0),
+		sum(0)
+	{
+	}
+
+	void onAccelerationChanged(const Acceleration& acceleration)
+	{
+		events++;
+		sum += acceleration.x + acceleration.y + acceleration.z;
+	}
+
+	void onSamplesAvailable(const SampleBlock& block)
+	{
+		events++;
+		for (std::vector<double>::const_iterator it = block.samples.begin(); it != block.samples.end(); ++it)
+		{
+			sum += *it;
+		}
+	}
+
+	int events;
+	double sum;
+};
+
+
+class SampleStreamBenchmark: public Application
+{
+public:
+	SampleStreamBenchmark():
+		_helpRequested(false),
+		_samples(2000000)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<SampleStreamBenchmark>(this, &SampleStreamBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("samples", "n", "Number of samples per measurement (default 2000000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 1000000000))
+				.binding("benchmark.samples"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("Microbenchmark comparing events per sample with a BufferedSampleStream.");
+		helpFormatter.format(std::cout);
+	}
+
+	void report(const std::string& what, const Poco::Stopwatch& sw, const SampleSubscriber& subscriber)
+	{
+		double ns = 1000.0*sw.elapsed()/_samples;
+		std::cout << Poco::format("%-24s %8.1f ns/sample %10d events", what, ns, subscriber.events);
+		// keep the compiler from optimizing the work away
+		std::cout << (subscriber.sum == 0.5 ? " " : "") << std::endl;
+	}
+
+	void measureEvents()
+	{
+		Poco::BasicEvent<const Acceleration> accelerationChanged;
+		SampleSubscriber subscriber;
+		accelerationChanged += Poco::delegate(&subscriber, &SampleSubscriber::onAccelerationChanged);
+
+		Poco::Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < _samples; i++)
+		{
+			Acceleration acceleration;
+			acceleration.x = i;
+			acceleration.y = -i;
+			acceleration.z = 1.0;
+			accelerationChanged(this, acceleration);
+		}
+		sw.stop();
+
+		accelerationChanged -= Poco::delegate(&subscriber, &SampleSubscriber::onAccelerationChanged);
+		report("event per sample", sw, subscriber);
+	}
+
+	void measureStream(int blockSize)
+	{
+		BufferedSampleStream::Params params;
+		params.name = "Benchmark Stream";
+		params.symbolicName = "io.macchina.benchmark.stream";
+		params.channelNames.push_back("x");
+		params.channelNames.push_back("y");
+		params.channelNames.push_back("z");
+		params.blockSize = blockSize;
+		params.blockLatency = 0;
+
+		BufferedSampleStream stream(params);
+		SampleSubscriber subscriber;
+		stream.samplesAvailable += Poco::delegate(&subscriber, &SampleSubscriber::onSamplesAvailable);
+
+		// Taking the time is left out, as drivers do this for both variants.
+		Poco::Timestamp timestamp;
+		Poco::Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < _samples; i++)
+		{
+			double values[3] = {static_cast<double>(i), static_cast<double>(-i), 1.0};
+			stream.addSample(timestamp, values);
+		}
+		stream.flush();
+		sw.stop();
+
+		stream.samplesAvailable -= Poco::delegate(&subscriber, &SampleSubscriber::onSamplesAvailable);
+		report(Poco::format("block size %d", blockSize), sw, subscriber);
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		_samples = config().getInt("benchmark.samples", _samples);
+
+		std::cout << Poco::format("%d samples, 3 channels, one local subscriber", _samples) << std::endl;
+		measureEvents();
+		measureStream(8);
+		measureStream(32);
+		measureStream(128);
+
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+	int _samples;
+};
+
+
+POCO_APP_MAIN(SampleStreamBenchmark)
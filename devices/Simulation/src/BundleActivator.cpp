@@ -19,6 +19,9 @@
 #include "Poco/Util/Timer.h"
 #include "IoT/Devices/SensorServerHelper.h"
 #include "IoT/Devices/GNSSSensorServerHelper.h"
+#include "IoT/Devices/SampleStreamServerHelper.h"
+#include "IoT/Devices/BufferedSampleStream.h"
+#include "IoT/Devices/TimerWheel.h"
 #include "Poco/Delegate.h"
 #include "Poco/ClassLibrary.h"
 #include "Poco/Format.h"
@@ -26,7 +29,10 @@
 #include "Poco/SharedPtr.h"
 #include "SimulatedSensor.h"
 #include "SimulatedGNSSSensor.h"
+#include "SimulationEngine.h"
+#include "SimulationTrace.h"
 #include <vector>
+#include <map>
 
 
 using Poco::OSP::BundleContext;
@@ -52,11 +58,19 @@ public:
 	{
 	}
 	
-	void createSensor(const SimulatedSensor::Params& params)
+	Poco::SharedPtr<SimulatedSensor> createSensor(const SimulatedSensor::Params& params, const std::string& baseKey)
 	{
 		typedef Poco::RemotingNG::ServerHelper<IoT::Devices::Sensor> ServerHelper;
 		
-		Poco::SharedPtr<SimulatedSensor> pSensor = new SimulatedSensor(params, *_pTimer);
+		Poco::SharedPtr<SimulatedSensor> pSensor = new SimulatedSensor(params, *_pTimer, *_pTimerWheel);
+		if (_pPrefs->configuration()->has(baseKey + ".valueChangedDelta"))
+		{
+			pSensor->setPropertyDouble("valueChangedDelta", _pPrefs->configuration()->getDouble(baseKey + ".valueChangedDelta"));
+		}
+		if (_pPrefs->configuration()->has(baseKey + ".valueChangedPeriod"))
+		{
+			pSensor->setPropertyInt("valueChangedPeriod", _pPrefs->configuration()->getInt(baseKey + ".valueChangedPeriod"));
+		}
 		ServerHelper::RemoteObjectPtr pSensorRemoteObject = ServerHelper::createRemoteObject(pSensor, params.id);
 		
 		Properties props;
@@ -69,6 +83,58 @@ public:
 		
 		ServiceRef::Ptr pServiceRef = _pContext->registry().registerService(params.id, pSensorRemoteObject, props);
 		_serviceRefs.push_back(pServiceRef);
+
+		if (_pPrefs->configuration()->getBool(baseKey + ".sampleStream.enable", false))
+		{
+			pSensor->setSampleStream(createSampleStream(params, baseKey));
+		}
+		return pSensor;
+	}
+
+	SimulationTrace::Ptr loadTrace(const std::string& path)
+	{
+		std::map<std::string, SimulationTrace::Ptr>::iterator it = _traces.find(path);
+		if (it != _traces.end()) return it->second;
+
+		SimulationTrace::Ptr pTrace = new SimulationTrace(path);
+		_traces[path] = pTrace;
+		return pTrace;
+	}
+
+	IoT::Devices::BufferedSampleStream::Ptr createSampleStream(const SimulatedSensor::Params& params, const std::string& baseKey)
+	{
+		typedef Poco::RemotingNG::ServerHelper<IoT::Devices::SampleStream> ServerHelper;
+
+		IoT::Devices::BufferedSampleStream::Params streamParams;
+		streamParams.name = SimulatedSensor::NAME + " Stream";
+		streamParams.symbolicName = SimulatedSensor::SYMBOLIC_NAME + ".stream";
+		streamParams.deviceIdentifier = params.id;
+		streamParams.physicalQuantity = params.physicalQuantity;
+		streamParams.physicalUnit = params.physicalUnit;
+		streamParams.channelNames.push_back("value");
+		streamParams.blockSize = _pPrefs->configuration()->getInt(baseKey + ".sampleStream.blockSize", IoT::Devices::BufferedSampleStream::DEFAULT_BLOCK_SIZE);
+		streamParams.blockLatency = _pPrefs->configuration()->getInt(baseKey + ".sampleStream.blockLatency", IoT::Devices::BufferedSampleStream::DEFAULT_BLOCK_LATENCY);
+		streamParams.bufferSize = _pPrefs->configuration()->getInt(baseKey + ".sampleStream.bufferSize", IoT::Devices::BufferedSampleStream::DEFAULT_BUFFER_SIZE);
+		streamParams.pTimer = _pTimer;
+
+		IoT::Devices::BufferedSampleStream::Ptr pSampleStream = new IoT::Devices::BufferedSampleStream(streamParams);
+		std::string oid(params.id);
+		oid += ".stream";
+		ServerHelper::RemoteObjectPtr pSampleStreamRemoteObject = ServerHelper::createRemoteObject(pSampleStream, oid);
+
+		Properties props;
+		props.set("io.macchina.device", streamParams.symbolicName);
+		props.set("io.macchina.deviceType", IoT::Devices::BufferedSampleStream::TYPE);
+		if (!params.physicalQuantity.empty())
+		{
+			props.set("io.macchina.physicalQuantity", params.physicalQuantity);
+		}
+
+		// Kept separately, as the number of sensor services
+		// determines the IDs of the simulated sensors.
+		ServiceRef::Ptr pServiceRef = _pContext->registry().registerService(oid, pSampleStreamRemoteObject, props);
+		_sampleStreamRefs.push_back(pServiceRef);
+		return pSampleStream;
 	}
 
 	void createGNSSSensor(const SimulatedGNSSSensor::Params& params)
@@ -89,45 +155,87 @@ public:
 	void start(BundleContext::Ptr pContext)
 	{
 		_pTimer = new Poco::Util::Timer;
+		_pTimerWheel = new IoT::Devices::TimerWheel;
+		_pTimerWheel->start(*_pTimer);
 		_pContext = pContext;
 		_pPrefs = ServiceFinder::find<PreferencesService>(pContext);
+
+		long resolution = _pPrefs->configuration()->getInt("simulation.engine.resolution", SimulationEngine::DEFAULT_RESOLUTION);
+		Poco::UInt32 seed = _pPrefs->configuration()->getUInt("simulation.engine.seed", 0);
+		_pEngine = new SimulationEngine(resolution, seed);
+		pContext->logger().information(Poco::format("Simulation engine seed: %u", _pEngine->seed()));
 		
 		Poco::Util::AbstractConfiguration::Keys keys;
 		_pPrefs->configuration()->keys("simulation.sensors", keys);
-		int index = 0;
 		for (std::vector<std::string>::const_iterator it = keys.begin(); it != keys.end(); ++it)
 		{
 			std::string baseKey = "simulation.sensors.";
 			baseKey += *it;
 
 			SimulatedSensor::Params params;
-			params.id = SimulatedSensor::SYMBOLIC_NAME;
-			params.id += "#";
-			params.id += Poco::NumberFormatter::format(_serviceRefs.size());
-			
 			params.physicalQuantity = _pPrefs->configuration()->getString(baseKey + ".physicalQuantity", "");
 			params.physicalUnit     = _pPrefs->configuration()->getString(baseKey + ".physicalUnit", "");
 			params.initialValue     = _pPrefs->configuration()->getDouble(baseKey + ".initialValue", 0.0);
 			params.delta            = _pPrefs->configuration()->getDouble(baseKey + ".delta", 0.0);
 			params.cycles           = _pPrefs->configuration()->getInt(baseKey + ".cycles", 0);
 			params.updateRate       = _pPrefs->configuration()->getDouble(baseKey + ".updateRate", 0.0);
-			
-			std::string mode = _pPrefs->configuration()->getString(baseKey + ".mode", "linear");
-			if (mode == "linear")
-				params.mode = SimulatedSensor::SIM_LINEAR;
-			else if (mode == "random")
-				params.mode = SimulatedSensor::SIM_RANDOM;
+			int instances           = _pPrefs->configuration()->getInt(baseKey + ".instances", 1);
 
 			try
 			{
-				createSensor(params);
+				SimulationTrace::Ptr pTrace;
+				int column = 0;
+				std::string mode = _pPrefs->configuration()->getString(baseKey + ".mode", "linear");
+				if (mode == "linear")
+				{
+					params.mode = SimulatedSensor::SIM_LINEAR;
+				}
+				else if (mode == "random")
+				{
+					params.mode = SimulatedSensor::SIM_RANDOM;
+				}
+				else if (mode == "replay")
+				{
+					params.mode = SimulatedSensor::SIM_REPLAY;
+					pTrace = loadTrace(_pPrefs->configuration()->getString(baseKey + ".tracePath"));
+					column = pTrace->column(_pPrefs->configuration()->getString(baseKey + ".traceColumn", "1"));
+				}
+				else throw Poco::InvalidArgumentException("simulation mode", mode);
+				double speedUp = _pPrefs->configuration()->getDouble(baseKey + ".speedUp", 1.0);
+				bool loopReplay = _pPrefs->configuration()->getBool(baseKey + ".loopReplay", true);
+
+				if (!pTrace && params.updateRate != 0)
+				{
+					// Rejects rates the engine cannot handle before any sensor is created.
+					Poco::UInt64 period = _pEngine->updatePeriod(params.updateRate);
+					double effectiveRate = 1000.0/(period*resolution);
+					double deviation = effectiveRate - params.updateRate;
+					if (deviation > 0.01*params.updateRate || -deviation > 0.01*params.updateRate)
+					{
+						pContext->logger().warning(Poco::format("Simulated sensor %s: updateRate %.2f rounded to %.2f updates/sec. at an engine resolution of %ld ms", *it, params.updateRate, effectiveRate, resolution));
+					}
+				}
+
+				for (int i = 0; i < instances; i++)
+				{
+					params.id = SimulatedSensor::SYMBOLIC_NAME;
+					params.id += "#";
+					params.id += Poco::NumberFormatter::format(_serviceRefs.size());
+
+					Poco::SharedPtr<SimulatedSensor> pSensor = createSensor(params, baseKey);
+					if (pTrace)
+						_pEngine->addReplay(pSensor, pTrace, column, speedUp, loopReplay);
+					else
+						_pEngine->addGenerator(pSensor, params);
+				}
 			}
 			catch (Poco::Exception& exc)
 			{
 				pContext->logger().error(Poco::format("Cannot create simulated sensor: %s", exc.displayText())); 
 			}
-			index++;
 		}
+		_traces.clear();
+		_pEngine->start(*_pTimer);
 		
 		std::string gpxPath = _pPrefs->configuration()->getString("simulation.gnss.gpxPath", "");
 		if (!gpxPath.empty())
@@ -151,6 +259,8 @@ public:
 		
 	void stop(BundleContext::Ptr pContext)
 	{
+		_pEngine->stop();
+		_pTimerWheel->stop();
 		_pTimer->cancel(true);
 		_pTimer = 0;
 
@@ -160,15 +270,30 @@ public:
 		}
 		_serviceRefs.clear();
 
+		for (std::vector<ServiceRef::Ptr>::iterator it = _sampleStreamRefs.begin(); it != _sampleStreamRefs.end(); ++it)
+		{
+			_pContext->registry().unregisterService(*it);
+		}
+		_sampleStreamRefs.clear();
+
+		_pEngine = 0;
+
+		// The sensors' event policies are registered with the
+		// TimerWheel, so it must outlive the sensors.
+		_pTimerWheel = 0;
 		_pPrefs = 0;
 		_pContext = 0;
 	}
 	
 private:
 	Poco::SharedPtr<Poco::Util::Timer> _pTimer;
+	IoT::Devices::TimerWheel::Ptr _pTimerWheel;
+	SimulationEngine::Ptr _pEngine;
+	std::map<std::string, SimulationTrace::Ptr> _traces;
 	BundleContext::Ptr _pContext;
 	PreferencesService::Ptr _pPrefs;
 	std::vector<ServiceRef::Ptr> _serviceRefs;
+	std::vector<ServiceRef::Ptr> _sampleStreamRefs;
 };
 
 
@@ -11,83 +11,31 @@
 #include "SimulatedSensor.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/Util/TimerTask.h"
-#include "Poco/Random.h"
 
 
 namespace IoT {
 namespace Simulation {
 
 
-class LinearUpdateTimerTask: public Poco::Util::TimerTask
+class DisposeEventPolicyTask: public Poco::Util::TimerTask
+	/// Releases a replaced event moderation policy in the timer
+	/// thread, which also drives the TimerWheel, so that
+	/// unregistering the policy from the TimerWheel never
+	/// has to wait for a running policy callback.
 {
 public:
-	LinearUpdateTimerTask(SimulatedSensor& sensor, double initialValue, double delta, int cycles):
-		_sensor(sensor),
-		_initialValue(initialValue),
-		_delta(delta),
-		_cycles(cycles),
-		_count(0)
+	DisposeEventPolicyTask(Poco::SharedPtr<IoT::Devices::EventModerationPolicy<double> > pPolicy):
+		_pPolicy(pPolicy)
 	{
 	}
-	
-	void run()
-	{
-		if (++_count == _cycles)
-		{
-			_sensor.update(_initialValue);
-			_count = 0;
-		}
-		else
-		{
-			double value = _sensor.value();
-			value += _delta;
-			_sensor.update(value);
-		}
-	}
-	
-private:
-	SimulatedSensor& _sensor;
-	double _initialValue;
-	double _delta;
-	int _cycles;
-	int _count;
-};
-
 
-class RandomUpdateTimerTask: public Poco::Util::TimerTask
-{
-public:
-	RandomUpdateTimerTask(SimulatedSensor& sensor, double initialValue, double delta, int cycles):
-		_sensor(sensor),
-		_initialValue(initialValue),
-		_delta(delta),
-		_cycles(cycles),
-		_count(0)
-	{
-	}
-	
 	void run()
 	{
-		if (++_count == _cycles)
-		{
-			_sensor.update(_initialValue);
-			_count = 0;
-		}
-		else
-		{
-			double value = _sensor.value();
-			value += _delta*_random.nextDouble()*2 - _delta;
-			_sensor.update(value);
-		}
+		_pPolicy = 0;
 	}
-	
+
 private:
-	SimulatedSensor& _sensor;
-	double _initialValue;
-	double _delta;
-	int _cycles;
-	int _count;
-	Poco::Random _random;
+	Poco::SharedPtr<IoT::Devices::EventModerationPolicy<double> > _pPolicy;
 };
 
 
@@ -96,7 +44,7 @@ const std::string SimulatedSensor::TYPE("io.macchina.sensor");
 const std::string SimulatedSensor::SYMBOLIC_NAME("io.macchina.simulation.sensor");
 
 
-SimulatedSensor::SimulatedSensor(const Params& params, Poco::Util::Timer& timer):
+SimulatedSensor::SimulatedSensor(const Params& params, Poco::Util::Timer& timer, IoT::Devices::TimerWheel& wheel):
 	_value(params.initialValue),
 	_valueChangedPeriod(0.0),
 	_valueChangedDelta(0.0),
@@ -104,7 +52,8 @@ SimulatedSensor::SimulatedSensor(const Params& params, Poco::Util::Timer& timer)
 	_deviceIdentifier(params.id),
 	_physicalQuantity(params.physicalQuantity),
 	_physicalUnit(params.physicalUnit),
-	_timer(timer)
+	_timer(timer),
+	_wheel(wheel)
 {
 	addProperty("displayValue", &SimulatedSensor::getDisplayValue);
 	addProperty("valueChangedPeriod", &SimulatedSensor::getValueChangedPeriod, &SimulatedSensor::setValueChangedPeriod);
@@ -115,19 +64,6 @@ SimulatedSensor::SimulatedSensor(const Params& params, Poco::Util::Timer& timer)
 	addProperty("type", &SimulatedSensor::getType);
 	addProperty("physicalQuantity", &SimulatedSensor::getPhysicalQuantity);
 	addProperty("physicalUnit", &SimulatedSensor::getPhysicalUnit);
-	
-	if (params.updateRate > 0)
-	{
-		long interval = 1000/params.updateRate;
-		if (params.mode == SIM_LINEAR)
-		{
-			_timer.scheduleAtFixedRate(new LinearUpdateTimerTask(*this, params.initialValue, params.delta, params.cycles), interval, interval);
-		}
-		else
-		{
-			_timer.scheduleAtFixedRate(new RandomUpdateTimerTask(*this, params.initialValue, params.delta, params.cycles), interval, interval);
-		}
-	}
 }
 
 	
@@ -163,17 +99,11 @@ void SimulatedSensor::setValueChangedPeriod(const std::string&, const Poco::Any&
 	Poco::Mutex::ScopedLock lock(_mutex);
 
 	int period = Poco::AnyCast<int>(value);
+	if (period < 0) throw Poco::InvalidArgumentException("valueChangedPeriod must not be negative");
 	if (period != _valueChangedPeriod)
 	{
-		if (period == 0)
-		{
-			_pEventPolicy = new IoT::Devices::NoModerationPolicy<double>(valueChanged);
-		}
-		else
-		{
-			_pEventPolicy = new IoT::Devices::MaximumRateModerationPolicy<double>(valueChanged, _value, period, _timer);
-		}
 		_valueChangedPeriod = period;
+		updateEventPolicy();
 	}
 }
 
@@ -191,18 +121,36 @@ void SimulatedSensor::setValueChangedDelta(const std::string&, const Poco::Any&
 	Poco::Mutex::ScopedLock lock(_mutex);
 
 	double delta = Poco::AnyCast<double>(value);
+	if (delta < 0) throw Poco::InvalidArgumentException("valueChangedDelta must not be negative");
 	if (delta != _valueChangedDelta)
 	{
-		if (delta == 0)
-		{
-			_pEventPolicy = new IoT::Devices::NoModerationPolicy<double>(valueChanged);
-		}
-		else
-		{
-			_pEventPolicy = new IoT::Devices::MinimumDeltaModerationPolicy<double>(valueChanged, _value, delta);
-		}
 		_valueChangedDelta = delta;
+		updateEventPolicy();
+	}
+}
+
+
+void SimulatedSensor::updateEventPolicy()
+{
+	Poco::SharedPtr<IoT::Devices::EventModerationPolicy<double> > pOldPolicy = _pEventPolicy;
+	if (_valueChangedPeriod > 0 && _valueChangedDelta > 0)
+	{
+		// deadband with heartbeat
+		_pEventPolicy = new IoT::Devices::DeadbandModerationPolicy<double>(valueChanged, _value, _valueChangedDelta, _valueChangedPeriod, _wheel);
+	}
+	else if (_valueChangedPeriod > 0)
+	{
+		_pEventPolicy = new IoT::Devices::WindowedAggregationPolicy<double>(valueChanged, valueAggregated, _valueChangedPeriod, _wheel);
 	}
+	else if (_valueChangedDelta > 0)
+	{
+		_pEventPolicy = new IoT::Devices::MinimumDeltaModerationPolicy<double>(valueChanged, _value, _valueChangedDelta);
+	}
+	else
+	{
+		_pEventPolicy = new IoT::Devices::NoModerationPolicy<double>(valueChanged);
+	}
+	_timer.schedule(new DisposeEventPolicyTask(pOldPolicy), Poco::Timestamp());
 }
 
 
@@ -248,14 +196,30 @@ Poco::Any SimulatedSensor::getPhysicalUnit(const std::string&) const
 }
 
 
-void SimulatedSensor::update(double value)
+void SimulatedSensor::setSampleStream(IoT::Devices::BufferedSampleStream::Ptr pSampleStream)
 {
 	Poco::Mutex::ScopedLock lock(_mutex);
 
-	if (_value != value)
+	_pSampleStream = pSampleStream;
+}
+
+
+void SimulatedSensor::update(double value)
+{
+	IoT::Devices::BufferedSampleStream::Ptr pSampleStream;
+	{
+		Poco::Mutex::ScopedLock lock(_mutex);
+
+		if (_value != value)
+		{
+			_value = value;
+			_pEventPolicy->valueChanged(value);
+		}
+		pSampleStream = _pSampleStream;
+	}
+	if (pSampleStream)
 	{
-		_value = value;
-		_pEventPolicy->valueChanged(value);
+		pSampleStream->addSample(Poco::Timestamp(), &value);
 	}
 }
 
@@ -15,6 +15,8 @@
 #include "IoT/Devices/Sensor.h"
 #include "IoT/Devices/DeviceImpl.h"
 #include "IoT/Devices/EventModerationPolicy.h"
+#include "IoT/Devices/BufferedSampleStream.h"
+#include "IoT/Devices/TimerWheel.h"
 #include "Poco/Util/Timer.h"
 
 
@@ -28,7 +30,8 @@ public:
 	enum Mode
 	{
 		SIM_LINEAR, /// linear function
-		SIM_RANDOM  /// random function
+		SIM_RANDOM, /// random function
+		SIM_REPLAY  /// replay from a SimulationTrace
 	};
 	
 	struct Params
@@ -58,15 +61,26 @@ public:
 			/// The rate at which the sensor value is updated (updates/sec.).
 			
 		Mode mode;
-			/// Mode - linear or random.
+			/// Mode - linear, random or replay.
 	};
 	
-	SimulatedSensor(const Params& params, Poco::Util::Timer& timer);
+	SimulatedSensor(const Params& params, Poco::Util::Timer& timer, IoT::Devices::TimerWheel& wheel);
 		/// Creates a SimulatedSensor.
+		///
+		/// The sensor value is updated by the SimulationEngine
+		/// the sensor is added to.
+		///
+		/// The TimerWheel, which must be driven by the given Timer,
+		/// is used by the event moderation policies selected
+		/// with the valueChangedPeriod property.
 		
 	~SimulatedSensor();
 		/// Destroys the SimulatedSensor.
 	
+	void setSampleStream(IoT::Devices::BufferedSampleStream::Ptr pSampleStream);
+		/// Sets the SampleStream that receives every
+		/// simulated value.
+
 	// Sensor
 	double value() const;
 	bool ready() const;
@@ -88,6 +102,7 @@ protected:
 	Poco::Any getPhysicalQuantity(const std::string&) const;
 	Poco::Any getPhysicalUnit(const std::string&) const;
 	void update(double value);
+	void updateEventPolicy();
 
 private:
 	double _value;
@@ -99,10 +114,11 @@ private:
 	Poco::Any _name;
 	Poco::Any _physicalQuantity;
 	Poco::Any _physicalUnit;
+	IoT::Devices::BufferedSampleStream::Ptr _pSampleStream;
 	Poco::Util::Timer& _timer;
+	IoT::Devices::TimerWheel& _wheel;
 	
-	friend class LinearUpdateTimerTask;
-	friend class RandomUpdateTimerTask;
+	friend class SimulationEngine;
 };
 
 
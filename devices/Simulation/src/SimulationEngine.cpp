@@ -0,0 +1,298 @@
+//
+// SimulationEngine.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "SimulationEngine.h"
+#include "Poco/Random.h"
+#include "Poco/Exception.h"
+#include "Poco/Format.h"
+
+
+namespace IoT {
+namespace Simulation {
+
+
+namespace
+{
+	class TickTask: public Poco::Util::TimerTask
+	{
+	public:
+		TickTask(SimulationEngine& engine):
+			_engine(engine)
+		{
+		}
+
+		void run()
+		{
+			_engine.tick();
+		}
+
+	private:
+		SimulationEngine& _engine;
+	};
+}
+
+
+SimulationEngine::SimulationEngine(long resolution, Poco::UInt32 seed):
+	_resolution(resolution),
+	_seed(seed),
+	_tick(0)
+{
+	if (resolution < 1) throw Poco::InvalidArgumentException("SimulationEngine resolution must be at least 1 ms");
+
+	if (_seed == 0)
+	{
+		Poco::Random rnd;
+		rnd.seed();
+		do
+		{
+			_seed = rnd.next();
+		}
+		while (_seed == 0);
+	}
+	_seedState = _seed;
+}
+
+
+SimulationEngine::~SimulationEngine()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void SimulationEngine::addGenerator(Poco::SharedPtr<SimulatedSensor> pSensor, const SimulatedSensor::Params& params)
+{
+	if (params.mode != SimulatedSensor::SIM_LINEAR && params.mode != SimulatedSensor::SIM_RANDOM) throw Poco::InvalidArgumentException("generator mode must be linear or random");
+	if (params.updateRate == 0) return;
+
+	Poco::UInt64 period = updatePeriod(params.updateRate);
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	std::vector<Batch>::iterator it = _batches.begin();
+	while (it != _batches.end() && it->period != period) ++it;
+	if (it == _batches.end())
+	{
+		_batches.push_back(Batch());
+		it = _batches.end() - 1;
+		it->period = period;
+		it->due = _tick + period;
+	}
+
+	it->sensors.push_back(pSensor);
+	it->value.push_back(params.initialValue);
+	it->initialValue.push_back(params.initialValue);
+	it->delta.push_back(params.delta);
+	it->scale.push_back(params.mode == SimulatedSensor::SIM_RANDOM ? 2.0 : 0.0);
+	it->offset.push_back(params.mode == SimulatedSensor::SIM_RANDOM ? -1.0 : 1.0);
+	it->cycles.push_back(params.cycles > 0 ? params.cycles : 0);
+	it->count.push_back(0);
+	it->random.push_back(nextSeed());
+}
+
+
+void SimulationEngine::addReplay(Poco::SharedPtr<SimulatedSensor> pSensor, SimulationTrace::Ptr pTrace, int column, double speedUp, bool loop)
+{
+	poco_check_ptr (pTrace);
+
+	if (column < 0 || column >= static_cast<int>(pTrace->columns())) throw Poco::InvalidArgumentException("trace column out of range");
+	if (speedUp <= 0) throw Poco::InvalidArgumentException("speedUp must be positive");
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	std::vector<Replay>::iterator it = _replays.begin();
+	while (it != _replays.end() && !(it->pTrace == pTrace && it->speedUp == speedUp && it->loop == loop && it->start == _tick && it->row == 0)) ++it;
+	if (it == _replays.end())
+	{
+		_replays.push_back(Replay());
+		it = _replays.end() - 1;
+		it->pTrace = pTrace;
+		it->speedUp = speedUp;
+		it->loop = loop;
+		it->done = false;
+		it->start = _tick;
+		it->row = 0;
+	}
+
+	it->sensors.push_back(pSensor);
+	it->columns.push_back(column);
+}
+
+
+void SimulationEngine::start(Poco::Util::Timer& timer)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	if (_pTask) throw Poco::IllegalStateException("SimulationEngine already started");
+
+	_pTask = new TickTask(*this);
+	timer.scheduleAtFixedRate(_pTask, _resolution, _resolution);
+}
+
+
+void SimulationEngine::stop()
+{
+	Poco::Util::TimerTask::Ptr pTask;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		pTask.swap(_pTask);
+	}
+	if (pTask) pTask->cancel();
+}
+
+
+void SimulationEngine::tick()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_tick++;
+	for (std::vector<Batch>::iterator it = _batches.begin(); it != _batches.end(); ++it)
+	{
+		if (it->due <= _tick)
+		{
+			updateBatch(*it);
+			it->due += it->period;
+		}
+	}
+	for (std::vector<Replay>::iterator it = _replays.begin(); it != _replays.end(); ++it)
+	{
+		if (!it->done) updateReplay(*it);
+	}
+}
+
+
+void SimulationEngine::clear()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_batches.clear();
+	_replays.clear();
+}
+
+
+Poco::UInt64 SimulationEngine::updatePeriod(double updateRate) const
+{
+	if (!(updateRate > 0)) throw Poco::InvalidArgumentException("updateRate must be positive");
+
+	double period = 1000/updateRate/_resolution;
+	if (period < 1) throw Poco::InvalidArgumentException(Poco::format("updateRate must not exceed %ld updates/sec. at a resolution of %ld ms", 1000/_resolution, _resolution));
+	return static_cast<Poco::UInt64>(period + 0.5);
+}
+
+
+Poco::UInt64 SimulationEngine::ticks() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _tick;
+}
+
+
+std::size_t SimulationEngine::size() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	std::size_t n = 0;
+	for (std::vector<Batch>::const_iterator it = _batches.begin(); it != _batches.end(); ++it)
+	{
+		n += it->sensors.size();
+	}
+	for (std::vector<Replay>::const_iterator it = _replays.begin(); it != _replays.end(); ++it)
+	{
+		n += it->sensors.size();
+	}
+	return n;
+}
+
+
+void SimulationEngine::updateBatch(Batch& batch)
+{
+	const std::size_t n = batch.sensors.size();
+	double* value = &batch.value[0];
+	const double* initialValue = &batch.initialValue[0];
+	const double* delta = &batch.delta[0];
+	const double* scale = &batch.scale[0];
+	const double* offset = &batch.offset[0];
+	const Poco::UInt32* cycles = &batch.cycles[0];
+	Poco::UInt32* count = &batch.count[0];
+	Poco::UInt32* random = &batch.random[0];
+
+	// Keep this loop free of branches and function calls,
+	// so that it can be vectorized.
+	for (std::size_t i = 0; i < n; i++)
+	{
+		Poco::UInt32 x = random[i];
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		random[i] = x;
+		double u = x*(1.0/4294967296.0);
+		double next = value[i] + delta[i]*(scale[i]*u + offset[i]);
+		Poco::UInt32 c = count[i] + 1;
+		bool reset = cycles[i] != 0 && c >= cycles[i];
+		value[i] = reset ? initialValue[i] : next;
+		count[i] = reset ? 0 : c;
+	}
+
+	for (std::size_t i = 0; i < n; i++)
+	{
+		batch.sensors[i]->update(value[i]);
+	}
+}
+
+
+void SimulationEngine::updateReplay(Replay& replay)
+{
+	const SimulationTrace& trace = *replay.pTrace;
+	const std::size_t rows = trace.rows();
+	double time = (_tick - replay.start)*_resolution*replay.speedUp/1000.0;
+
+	std::size_t row = replay.row;
+	while (row < rows && trace.time(row) <= time) row++;
+	if (row != replay.row)
+	{
+		replay.row = row;
+		for (std::size_t i = 0; i < replay.sensors.size(); i++)
+		{
+			replay.sensors[i]->update(trace.value(row - 1, replay.columns[i]));
+		}
+	}
+	if (replay.row == rows)
+	{
+		if (replay.loop)
+		{
+			replay.start = _tick;
+			replay.row = 0;
+		}
+		else replay.done = true;
+	}
+}
+
+
+Poco::UInt32 SimulationEngine::nextSeed()
+{
+	// Derive per-sensor seeds from the engine seed (splitmix32),
+	// so that every sensor gets an independent sequence.
+	Poco::UInt32 z = (_seedState += 0x9E3779B9);
+	z = (z ^ (z >> 16))*0x85EBCA6B;
+	z = (z ^ (z >> 13))*0xC2B2AE35;
+	z ^= z >> 16;
+	return z != 0 ? z : 0x9E3779B9;
+}
+
+
+} } // namespace IoT::Simulation
@@ -0,0 +1,184 @@
+//
+// SimulationEngine.h
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Simulation_SimulationEngine_INCLUDED
+#define IoT_Simulation_SimulationEngine_INCLUDED
+
+
+#include "SimulatedSensor.h"
+#include "SimulationTrace.h"
+#include "Poco/Util/Timer.h"
+#include "Poco/Util/TimerTask.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
+#include <vector>
+
+
+namespace IoT {
+namespace Simulation {
+
+
+class SimulationEngine
+	/// The SimulationEngine updates all SimulatedSensor instances
+	/// of the bundle from a single TimerTask.
+	///
+	/// Time advances in ticks of a fixed resolution. Generated
+	/// (linear and random) sensors with the same update interval are
+	/// kept in a batch, with their state stored in parallel arrays.
+	/// When a batch is due, the new values for all its sensors are
+	/// computed in one branch-free loop, which the compiler can
+	/// vectorize, before the sensors are updated and fire their
+	/// events. Random values come from a xorshift generator per
+	/// sensor, seeded from a single engine seed, so that a simulation
+	/// run is reproducible.
+	///
+	/// Replayed sensors take their values from a SimulationTrace.
+	/// All sensors replaying the same trace with the same settings
+	/// share a cursor, so every row is looked up only once.
+	///
+	/// Because simulation time is derived from the tick count, not
+	/// from the system clock, tick() can also be called directly,
+	/// e.g., to run a simulation faster than real time.
+{
+public:
+	typedef Poco::SharedPtr<SimulationEngine> Ptr;
+
+	enum
+	{
+		DEFAULT_RESOLUTION = 10
+	};
+
+	SimulationEngine(long resolution = DEFAULT_RESOLUTION, Poco::UInt32 seed = 0);
+		/// Creates the SimulationEngine with the given resolution
+		/// in milliseconds. If seed is 0, a random seed is used.
+
+	~SimulationEngine();
+		/// Destroys the SimulationEngine.
+
+	void addGenerator(Poco::SharedPtr<SimulatedSensor> pSensor, const SimulatedSensor::Params& params);
+		/// Adds a sensor updated by a linear or random function,
+		/// as specified by params.
+		///
+		/// The sensor is updated every updatePeriod(params.updateRate)
+		/// ticks. A sensor with an updateRate of 0 is never updated.
+		/// Throws a Poco::InvalidArgumentException if the updateRate
+		/// is negative or higher than one update per tick.
+
+	void addReplay(Poco::SharedPtr<SimulatedSensor> pSensor, SimulationTrace::Ptr pTrace, int column, double speedUp, bool loop);
+		/// Adds a sensor that replays the given column of a trace,
+		/// with the given speed-up factor. If loop is true, the
+		/// replay restarts after the last row.
+
+	void start(Poco::Util::Timer& timer);
+		/// Starts the simulation, using the given Timer.
+
+	void stop();
+		/// Stops the simulation.
+
+	void tick();
+		/// Advances the simulation by one tick.
+
+	void clear();
+		/// Removes all sensors.
+
+	Poco::UInt64 updatePeriod(double updateRate) const;
+		/// Returns the number of ticks between two updates of a sensor
+		/// with the given updateRate (updates/sec.), rounded to the
+		/// nearest tick.
+		///
+		/// Throws a Poco::InvalidArgumentException if the updateRate
+		/// is not positive or higher than one update per tick.
+
+	long resolution() const;
+		/// Returns the resolution in milliseconds.
+
+	Poco::UInt32 seed() const;
+		/// Returns the seed used for the random generators.
+
+	Poco::UInt64 ticks() const;
+		/// Returns the number of ticks since the engine was created.
+
+	std::size_t size() const;
+		/// Returns the number of sensors.
+
+protected:
+	struct Batch
+		/// Generated sensors with the same update interval.
+		///
+		/// Linear and random sensors are computed with the same
+		/// formula: value += delta*(scale*u + offset), where u
+		/// is a random number in [0, 1). Linear sensors have
+		/// scale 0 and offset 1, random sensors have scale 2
+		/// and offset -1.
+	{
+		Poco::UInt64 period;
+		Poco::UInt64 due;
+		std::vector<Poco::SharedPtr<SimulatedSensor> > sensors;
+		std::vector<double> value;
+		std::vector<double> initialValue;
+		std::vector<double> delta;
+		std::vector<double> scale;
+		std::vector<double> offset;
+		std::vector<Poco::UInt32> cycles;
+		std::vector<Poco::UInt32> count;
+		std::vector<Poco::UInt32> random;
+	};
+
+	struct Replay
+		/// Sensors replaying the same trace with the same settings.
+	{
+		SimulationTrace::Ptr pTrace;
+		double speedUp;
+		bool loop;
+		bool done;
+		Poco::UInt64 start;
+		std::size_t row;
+		std::vector<Poco::SharedPtr<SimulatedSensor> > sensors;
+		std::vector<int> columns;
+	};
+
+	void updateBatch(Batch& batch);
+	void updateReplay(Replay& replay);
+	Poco::UInt32 nextSeed();
+
+private:
+	SimulationEngine(const SimulationEngine&);
+	SimulationEngine& operator = (const SimulationEngine&);
+
+	long _resolution;
+	Poco::UInt32 _seed;
+	Poco::UInt32 _seedState;
+	Poco::UInt64 _tick;
+	std::vector<Batch> _batches;
+	std::vector<Replay> _replays;
+	Poco::Util::TimerTask::Ptr _pTask;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline long SimulationEngine::resolution() const
+{
+	return _resolution;
+}
+
+
+inline Poco::UInt32 SimulationEngine::seed() const
+{
+	return _seed;
+}
+
+
+} } // namespace IoT::Simulation
+
+
+#endif // IoT_Simulation_SimulationEngine_INCLUDED
@@ -0,0 +1,112 @@
+//
+// SimulationTrace.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "SimulationTrace.h"
+#include "Poco/FileStream.h"
+#include "Poco/StringTokenizer.h"
+#include "Poco/NumberParser.h"
+#include "Poco/String.h"
+#include "Poco/Format.h"
+#include "Poco/Exception.h"
+
+
+namespace IoT {
+namespace Simulation {
+
+
+SimulationTrace::SimulationTrace(const std::string& path):
+	_columns(0)
+{
+	Poco::FileInputStream istr(path);
+	try
+	{
+		load(istr);
+	}
+	catch (Poco::Exception& exc)
+	{
+		throw Poco::DataFormatException(Poco::format("Invalid trace file %s", path), exc.displayText());
+	}
+}
+
+
+SimulationTrace::SimulationTrace(std::istream& istr):
+	_columns(0)
+{
+	load(istr);
+}
+
+
+SimulationTrace::~SimulationTrace()
+{
+}
+
+
+int SimulationTrace::column(const std::string& nameOrIndex) const
+{
+	int index;
+	if (Poco::NumberParser::tryParse(nameOrIndex, index))
+	{
+		if (index >= 1 && index <= static_cast<int>(_columns)) return index - 1;
+	}
+	else
+	{
+		for (std::size_t i = 0; i < _names.size(); i++)
+		{
+			if (_names[i] == nameOrIndex) return static_cast<int>(i);
+		}
+	}
+	throw Poco::NotFoundException("trace column", nameOrIndex);
+}
+
+
+void SimulationTrace::load(std::istream& istr)
+{
+	double startTime = 0;
+	int lineNumber = 0;
+	std::string line;
+	while (std::getline(istr, line))
+	{
+		lineNumber++;
+		Poco::trimInPlace(line);
+		if (line.empty() || line[0] == '#') continue;
+
+		Poco::StringTokenizer tok(line, ",;", Poco::StringTokenizer::TOK_TRIM);
+		if (tok.count() < 2) throw Poco::DataFormatException(Poco::format("line %d: at least two fields expected", lineNumber));
+
+		double time;
+		if (!Poco::NumberParser::tryParseFloat(tok[0], time))
+		{
+			if (_columns == 0 && _names.empty())
+			{
+				_names.assign(tok.begin() + 1, tok.end());
+				_columns = _names.size();
+				continue;
+			}
+			throw Poco::DataFormatException(Poco::format("line %d: invalid time", lineNumber));
+		}
+
+		if (_columns == 0) _columns = tok.count() - 1;
+		if (tok.count() - 1 != _columns) throw Poco::DataFormatException(Poco::format("line %d: %z values expected", lineNumber, _columns));
+
+		if (_times.empty()) startTime = time;
+		time -= startTime;
+		if (!_times.empty() && time < _times.back()) throw Poco::DataFormatException(Poco::format("line %d: time must not decrease", lineNumber));
+		_times.push_back(time);
+
+		for (std::size_t i = 1; i < tok.count(); i++)
+		{
+			_values.push_back(Poco::NumberParser::parseFloat(tok[i]));
+		}
+	}
+	if (_times.empty()) throw Poco::DataFormatException("trace contains no data");
+}
+
+
+} } // namespace IoT::Simulation
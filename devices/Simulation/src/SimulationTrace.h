@@ -0,0 +1,125 @@
+//
+// SimulationTrace.h
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Simulation_SimulationTrace_INCLUDED
+#define IoT_Simulation_SimulationTrace_INCLUDED
+
+
+#include "Poco/SharedPtr.h"
+#include <vector>
+#include <istream>
+
+
+namespace IoT {
+namespace Simulation {
+
+
+class SimulationTrace
+	/// A recorded trace of sensor values, loaded from a CSV file,
+	/// for replay by the SimulationEngine.
+	///
+	/// Every line of the file contains a time in seconds, followed by
+	/// one or more values, separated by commas or semicolons. Times must
+	/// be increasing. Empty lines and lines starting with '#' are ignored.
+	/// If the first field of the first remaining line is not a number,
+	/// that line is taken as header containing the column names.
+	///
+	/// Example:
+	///     time,temperature,humidity
+	///     0.0,21.5,40.2
+	///     0.5,21.6,40.1
+	///
+	/// Values are stored row by row in a single contiguous array,
+	/// so that replaying many columns of the same trace touches
+	/// only one row at a time.
+{
+public:
+	typedef Poco::SharedPtr<SimulationTrace> Ptr;
+
+	explicit SimulationTrace(const std::string& path);
+		/// Loads the trace from the CSV file with the given path.
+
+	explicit SimulationTrace(std::istream& istr);
+		/// Loads the trace from the given stream.
+
+	~SimulationTrace();
+		/// Destroys the SimulationTrace.
+
+	std::size_t rows() const;
+		/// Returns the number of rows.
+
+	std::size_t columns() const;
+		/// Returns the number of value columns (not counting time).
+
+	int column(const std::string& nameOrIndex) const;
+		/// Returns the index of the column with the given name, or,
+		/// if nameOrIndex is a number, the 1-based column index
+		/// converted to 0-based. Throws a Poco::NotFoundException if
+		/// no such column exists.
+
+	double time(std::size_t row) const;
+		/// Returns the time of the given row, in seconds relative
+		/// to the first row.
+
+	double value(std::size_t row, std::size_t column) const;
+		/// Returns the value in the given row and column.
+
+	double duration() const;
+		/// Returns the time of the last row, in seconds
+		/// relative to the first row.
+
+protected:
+	void load(std::istream& istr);
+
+private:
+	std::vector<std::string> _names;
+	std::vector<double> _times;
+	std::vector<double> _values;
+	std::size_t _columns;
+};
+
+
+//
+// inlines
+//
+inline std::size_t SimulationTrace::rows() const
+{
+	return _times.size();
+}
+
+
+inline std::size_t SimulationTrace::columns() const
+{
+	return _columns;
+}
+
+
+inline double SimulationTrace::time(std::size_t row) const
+{
+	return _times[row];
+}
+
+
+inline double SimulationTrace::value(std::size_t row, std::size_t column) const
+{
+	return _values[row*_columns + column];
+}
+
+
+inline double SimulationTrace::duration() const
+{
+	return _times.empty() ? 0.0 : _times.back();
+}
+
+
+} } // namespace IoT::Simulation
+
+
+#endif // IoT_Simulation_SimulationTrace_INCLUDED
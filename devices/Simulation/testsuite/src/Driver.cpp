@@ -0,0 +1,17 @@
+//
+// Driver.cpp
+//
+// Console-based test driver for IoT Simulation.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "CppUnit/TestRunner.h"
+#include "SimulationTestSuite.h"
+
+
+CppUnitMain(SimulationTestSuite)
@@ -0,0 +1,197 @@
+//
+// SimulationBenchmark.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// A microbenchmark for the SimulationEngine.
+//
+// A number of simulated sensors, all updated with every tick,
+// are added to a SimulationEngine, which is then advanced by
+// calling tick() directly, i.e., as fast as possible. Every sensor
+// has one local valueChanged subscriber, so the measured time per
+// sensor update includes computing the value, updating the sensor
+// and dispatching the event. Remote subscribers are not included.
+//
+
+
+#include "SimulationEngine.h"
+#include "IoT/Devices/TimerWheel.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/Util/Timer.h"
+#include "Poco/Delegate.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Format.h"
+#include <vector>
+#include <iostream>
+
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::OptionCallback;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using IoT::Simulation::SimulationEngine;
+using IoT::Simulation::SimulatedSensor;
+
+
+class ValueSubscriber
+	/// Counts the events and adds up all values received.
+{
+public:
+	ValueSubscriber():
+		events(0),
+		sum(0)
+	{
+	}
+
+	void onValueChanged(const double& value)
+	{
+		events++;
+		sum += value;
+	}
+
+	Poco::UInt64 events;
+	double sum;
+};
+
+
+class SimulationBenchmark: public Application
+{
+public:
+	SimulationBenchmark():
+		_helpRequested(false)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<SimulationBenchmark>(this, &SimulationBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("sensors", "n", "Number of simulated sensors (default 10000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 10000000))
+				.binding("benchmark.sensors"));
+
+		options.addOption(
+			Option("ticks", "t", "Number of ticks (default 1000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 100000000))
+				.binding("benchmark.ticks"));
+
+		options.addOption(
+			Option("seed", "s", "Seed for the random generators (default 12345).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 0x7FFFFFFF))
+				.binding("benchmark.seed"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("Microbenchmark for the SimulationEngine.");
+		helpFormatter.format(std::cout);
+	}
+
+	void measure(SimulatedSensor::Mode mode, int sensors, int ticks, Poco::UInt32 seed)
+	{
+		Poco::Util::Timer timer;
+		IoT::Devices::TimerWheel wheel;
+		SimulationEngine engine(SimulationEngine::DEFAULT_RESOLUTION, seed);
+
+		SimulatedSensor::Params params;
+		params.id = SimulatedSensor::SYMBOLIC_NAME;
+		params.initialValue = 20;
+		params.delta = 0.1;
+		params.cycles = 100;
+		params.updateRate = 1000.0/engine.resolution();
+		params.mode = mode;
+
+		ValueSubscriber subscriber;
+		std::vector<Poco::SharedPtr<SimulatedSensor> > simulatedSensors;
+		for (int i = 0; i < sensors; i++)
+		{
+			Poco::SharedPtr<SimulatedSensor> pSensor = new SimulatedSensor(params, timer, wheel);
+			pSensor->valueChanged += Poco::delegate(&subscriber, &ValueSubscriber::onValueChanged);
+			engine.addGenerator(pSensor, params);
+			simulatedSensors.push_back(pSensor);
+		}
+
+		Poco::Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < ticks; i++)
+		{
+			engine.tick();
+		}
+		sw.stop();
+
+		for (std::vector<Poco::SharedPtr<SimulatedSensor> >::iterator it = simulatedSensors.begin(); it != simulatedSensors.end(); ++it)
+		{
+			(*it)->valueChanged -= Poco::delegate(&subscriber, &ValueSubscriber::onValueChanged);
+		}
+
+		double updates = double(sensors)*ticks;
+		std::cout
+			<< Poco::format("%-8s %8.1f ns/update %12.0f events  checksum %.6f",
+				std::string(mode == SimulatedSensor::SIM_RANDOM ? "random" : "linear"),
+				1000.0*sw.elapsed()/updates,
+				double(subscriber.events),
+				subscriber.sum)
+			<< std::endl;
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		int sensors = config().getInt("benchmark.sensors", 10000);
+		int ticks = config().getInt("benchmark.ticks", 1000);
+		Poco::UInt32 seed = config().getInt("benchmark.seed", 12345);
+
+		// The checksum of the random run only depends on the seed.
+		std::cout << Poco::format("%d sensors, %d ticks, seed %u", sensors, ticks, seed) << std::endl;
+		measure(SimulatedSensor::SIM_LINEAR, sensors, ticks, seed);
+		measure(SimulatedSensor::SIM_RANDOM, sensors, ticks, seed);
+
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+};
+
+
+POCO_APP_MAIN(SimulationBenchmark)
@@ -0,0 +1,339 @@
+//
+// SimulationEngineTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "SimulationEngineTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "SimulationEngine.h"
+#include "SimulationTrace.h"
+#include "Poco/Exception.h"
+#include <sstream>
+#include <vector>
+
+
+using IoT::Simulation::SimulationEngine;
+using IoT::Simulation::SimulationTrace;
+using IoT::Simulation::SimulatedSensor;
+
+
+namespace
+{
+	SimulationTrace::Ptr createTrace()
+	{
+		// rows at 0 ms, 100 ms and 250 ms
+		std::istringstream istr(
+			"time,a,b\n"
+			"0.0,1,10\n"
+			"0.1,2,20\n"
+			"0.25,3,30\n");
+		return new SimulationTrace(istr);
+	}
+
+	void tick(SimulationEngine& engine, int n)
+	{
+		for (int i = 0; i < n; i++) engine.tick();
+	}
+}
+
+
+SimulationEngineTest::SimulationEngineTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+SimulationEngineTest::~SimulationEngineTest()
+{
+}
+
+
+void SimulationEngineTest::testLinear()
+{
+	SimulationEngine engine(10, 1);
+	Poco::SharedPtr<SimulatedSensor> pSensor = createSensor(params(SimulatedSensor::SIM_LINEAR, 10));
+	engine.addGenerator(pSensor, params(SimulatedSensor::SIM_LINEAR, 10));
+	assert (engine.size() == 1);
+
+	// 10 updates/sec. at 10 ms resolution: one update every 10 ticks
+	tick(engine, 9);
+	assert (pSensor->value() == 5.0);
+	engine.tick();
+	assert (pSensor->value() == 5.5);
+	tick(engine, 10);
+	assert (pSensor->value() == 6.0);
+	assert (engine.ticks() == 20);
+}
+
+
+void SimulationEngineTest::testCycles()
+{
+	SimulationEngine engine(10, 1);
+	SimulatedSensor::Params p = params(SimulatedSensor::SIM_LINEAR, 100);
+	p.cycles = 3;
+	Poco::SharedPtr<SimulatedSensor> pSensor = createSensor(p);
+	engine.addGenerator(pSensor, p);
+
+	engine.tick();
+	assert (pSensor->value() == 5.5);
+	engine.tick();
+	assert (pSensor->value() == 6.0);
+	engine.tick();
+	assert (pSensor->value() == 5.0);
+	engine.tick();
+	assert (pSensor->value() == 5.5);
+}
+
+
+void SimulationEngineTest::testUpdateRate()
+{
+	SimulationEngine engine(10, 1);
+
+	assert (engine.updatePeriod(100) == 1);
+	assert (engine.updatePeriod(10) == 10);
+	assert (engine.updatePeriod(0.5) == 200);
+	// 30 updates/sec. are rounded to one update every 3 ticks
+	assert (engine.updatePeriod(30) == 3);
+
+	SimulatedSensor::Params p = params(SimulatedSensor::SIM_RANDOM, 200);
+	Poco::SharedPtr<SimulatedSensor> pSensor = createSensor(p);
+	try
+	{
+		engine.addGenerator(pSensor, p);
+		fail("updateRate higher than one update per tick - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	p.updateRate = -1;
+	try
+	{
+		engine.addGenerator(pSensor, p);
+		fail("negative updateRate - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+	assert (engine.size() == 0);
+
+	// a sensor with updateRate 0 is never updated
+	p.updateRate = 0;
+	engine.addGenerator(pSensor, p);
+	assert (engine.size() == 0);
+	tick(engine, 10);
+	assert (pSensor->value() == 5.0);
+}
+
+
+void SimulationEngineTest::testSameSeed()
+{
+	SimulationEngine engine1(10, 12345);
+	SimulationEngine engine2(10, 12345);
+	assert (engine1.seed() == 12345);
+
+	std::vector<Poco::SharedPtr<SimulatedSensor> > sensors1;
+	std::vector<Poco::SharedPtr<SimulatedSensor> > sensors2;
+	for (int i = 0; i < 20; i++)
+	{
+		// two batches with different update periods
+		SimulatedSensor::Params p = params(SimulatedSensor::SIM_RANDOM, i % 2 ? 100 : 50);
+		sensors1.push_back(createSensor(p));
+		engine1.addGenerator(sensors1.back(), p);
+		sensors2.push_back(createSensor(p));
+		engine2.addGenerator(sensors2.back(), p);
+	}
+
+	for (int t = 0; t < 50; t++)
+	{
+		engine1.tick();
+		engine2.tick();
+		for (std::size_t i = 0; i < sensors1.size(); i++)
+		{
+			assert (sensors1[i]->value() == sensors2[i]->value());
+		}
+	}
+
+	// every sensor gets its own sequence
+	assert (sensors1[1]->value() != sensors1[3]->value());
+	for (std::size_t i = 0; i < sensors1.size(); i++)
+	{
+		assert (sensors1[i]->value() != 5.0);
+		assert (sensors1[i]->value() >= 5.0 - 50*0.5 && sensors1[i]->value() <= 5.0 + 50*0.5);
+	}
+}
+
+
+void SimulationEngineTest::testDifferentSeed()
+{
+	SimulationEngine engine1(10, 1);
+	SimulationEngine engine2(10, 2);
+
+	SimulatedSensor::Params p = params(SimulatedSensor::SIM_RANDOM, 100);
+	Poco::SharedPtr<SimulatedSensor> pSensor1 = createSensor(p);
+	engine1.addGenerator(pSensor1, p);
+	Poco::SharedPtr<SimulatedSensor> pSensor2 = createSensor(p);
+	engine2.addGenerator(pSensor2, p);
+
+	tick(engine1, 10);
+	tick(engine2, 10);
+	assert (pSensor1->value() != pSensor2->value());
+
+	SimulationEngine engine3(10, 0);
+	assert (engine3.seed() != 0);
+}
+
+
+void SimulationEngineTest::testReplay()
+{
+	SimulationEngine engine(10, 1);
+	SimulationTrace::Ptr pTrace = createTrace();
+	Poco::SharedPtr<SimulatedSensor> pSensorA = createSensor(params(SimulatedSensor::SIM_REPLAY, 0));
+	Poco::SharedPtr<SimulatedSensor> pSensorB = createSensor(params(SimulatedSensor::SIM_REPLAY, 0));
+	engine.addReplay(pSensorA, pTrace, 0, 1.0, false);
+	engine.addReplay(pSensorB, pTrace, 1, 1.0, false);
+	assert (engine.size() == 2);
+
+	// the first row is replayed with the first tick
+	engine.tick();
+	assert (pSensorA->value() == 1.0);
+	assert (pSensorB->value() == 10.0);
+
+	// 100 ms
+	tick(engine, 8);
+	assert (pSensorA->value() == 1.0);
+	engine.tick();
+	assert (pSensorA->value() == 2.0);
+	assert (pSensorB->value() == 20.0);
+
+	// 250 ms
+	tick(engine, 14);
+	assert (pSensorA->value() == 2.0);
+	engine.tick();
+	assert (pSensorA->value() == 3.0);
+	assert (pSensorB->value() == 30.0);
+
+	try
+	{
+		engine.addReplay(pSensorA, pTrace, 2, 1.0, false);
+		fail("column out of range - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	try
+	{
+		engine.addReplay(pSensorA, pTrace, 0, 0.0, false);
+		fail("speedUp must be positive - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void SimulationEngineTest::testReplaySpeedUp()
+{
+	SimulationEngine engine(10, 1);
+	Poco::SharedPtr<SimulatedSensor> pSensor = createSensor(params(SimulatedSensor::SIM_REPLAY, 0));
+	engine.addReplay(pSensor, createTrace(), 0, 5.0, false);
+
+	// at 5x speed, each tick advances the trace by 50 ms
+	engine.tick();
+	assert (pSensor->value() == 1.0);
+	engine.tick();
+	assert (pSensor->value() == 2.0);
+	tick(engine, 2);
+	assert (pSensor->value() == 2.0);
+	engine.tick();
+	assert (pSensor->value() == 3.0);
+}
+
+
+void SimulationEngineTest::testReplayLoop()
+{
+	SimulationEngine engine(10, 1);
+	Poco::SharedPtr<SimulatedSensor> pSensor = createSensor(params(SimulatedSensor::SIM_REPLAY, 0));
+	engine.addReplay(pSensor, createTrace(), 0, 5.0, true);
+
+	tick(engine, 5);
+	assert (pSensor->value() == 3.0);
+
+	// the replay restarts with the tick after the last row
+	engine.tick();
+	assert (pSensor->value() == 1.0);
+	engine.tick();
+	assert (pSensor->value() == 2.0);
+	tick(engine, 3);
+	assert (pSensor->value() == 3.0);
+	engine.tick();
+	assert (pSensor->value() == 1.0);
+}
+
+
+void SimulationEngineTest::testReplayNoLoop()
+{
+	SimulationEngine engine(10, 1);
+	Poco::SharedPtr<SimulatedSensor> pSensor = createSensor(params(SimulatedSensor::SIM_REPLAY, 0));
+	engine.addReplay(pSensor, createTrace(), 0, 5.0, false);
+
+	tick(engine, 5);
+	assert (pSensor->value() == 3.0);
+	tick(engine, 100);
+	assert (pSensor->value() == 3.0);
+}
+
+
+SimulatedSensor::Params SimulationEngineTest::params(SimulatedSensor::Mode mode, double updateRate)
+{
+	SimulatedSensor::Params params;
+	params.id = "io.macchina.simulation.sensor#test";
+	params.physicalQuantity = "temperature";
+	params.physicalUnit = "Cel";
+	params.initialValue = 5.0;
+	params.delta = 0.5;
+	params.cycles = 0;
+	params.updateRate = updateRate;
+	params.mode = mode;
+	return params;
+}
+
+
+Poco::SharedPtr<SimulatedSensor> SimulationEngineTest::createSensor(const SimulatedSensor::Params& params)
+{
+	return new SimulatedSensor(params, _timer, _wheel);
+}
+
+
+void SimulationEngineTest::setUp()
+{
+}
+
+
+void SimulationEngineTest::tearDown()
+{
+}
+
+
+CppUnit::Test* SimulationEngineTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SimulationEngineTest");
+
+	CppUnit_addTest(pSuite, SimulationEngineTest, testLinear);
+	CppUnit_addTest(pSuite, SimulationEngineTest, testCycles);
+	CppUnit_addTest(pSuite, SimulationEngineTest, testUpdateRate);
+	CppUnit_addTest(pSuite, SimulationEngineTest, testSameSeed);
+	CppUnit_addTest(pSuite, SimulationEngineTest, testDifferentSeed);
+	CppUnit_addTest(pSuite, SimulationEngineTest, testReplay);
+	CppUnit_addTest(pSuite, SimulationEngineTest, testReplaySpeedUp);
+	CppUnit_addTest(pSuite, SimulationEngineTest, testReplayLoop);
+	CppUnit_addTest(pSuite, SimulationEngineTest, testReplayNoLoop);
+
+	return pSuite;
+}
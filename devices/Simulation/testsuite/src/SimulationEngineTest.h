@@ -0,0 +1,54 @@
+//
+// SimulationEngineTest.h
+//
+// Definition of the SimulationEngineTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef SimulationEngineTest_INCLUDED
+#define SimulationEngineTest_INCLUDED
+
+
+#include "SimulatedSensor.h"
+#include "IoT/Devices/TimerWheel.h"
+#include "Poco/Util/Timer.h"
+#include "Poco/SharedPtr.h"
+#include "CppUnit/TestCase.h"
+
+
+class SimulationEngineTest: public CppUnit::TestCase
+{
+public:
+	SimulationEngineTest(const std::string& name);
+	~SimulationEngineTest();
+
+	void testLinear();
+	void testCycles();
+	void testUpdateRate();
+	void testSameSeed();
+	void testDifferentSeed();
+	void testReplay();
+	void testReplaySpeedUp();
+	void testReplayLoop();
+	void testReplayNoLoop();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+	IoT::Simulation::SimulatedSensor::Params params(IoT::Simulation::SimulatedSensor::Mode mode, double updateRate);
+	Poco::SharedPtr<IoT::Simulation::SimulatedSensor> createSensor(const IoT::Simulation::SimulatedSensor::Params& params);
+
+	Poco::Util::Timer _timer;
+	IoT::Devices::TimerWheel _wheel;
+};
+
+
+#endif // SimulationEngineTest_INCLUDED
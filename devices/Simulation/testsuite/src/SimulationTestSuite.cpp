@@ -0,0 +1,24 @@
+//
+// SimulationTestSuite.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "SimulationTestSuite.h"
+#include "SimulationTraceTest.h"
+#include "SimulationEngineTest.h"
+
+
+CppUnit::Test* SimulationTestSuite::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SimulationTestSuite");
+
+	pSuite->addTest(SimulationTraceTest::suite());
+	pSuite->addTest(SimulationEngineTest::suite());
+
+	return pSuite;
+}
@@ -0,0 +1,27 @@
+//
+// SimulationTestSuite.h
+//
+// Definition of the SimulationTestSuite class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef SimulationTestSuite_INCLUDED
+#define SimulationTestSuite_INCLUDED
+
+
+#include "CppUnit/TestSuite.h"
+
+
+class SimulationTestSuite
+{
+public:
+	static CppUnit::Test* suite();
+};
+
+
+#endif // SimulationTestSuite_INCLUDED
@@ -0,0 +1,177 @@
+//
+// SimulationTraceTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "SimulationTraceTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "SimulationTrace.h"
+#include "Poco/Exception.h"
+#include <sstream>
+
+
+using IoT::Simulation::SimulationTrace;
+
+
+SimulationTraceTest::SimulationTraceTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+SimulationTraceTest::~SimulationTraceTest()
+{
+}
+
+
+void SimulationTraceTest::testHeader()
+{
+	std::istringstream istr(
+		"# recorded trace\n"
+		"time,temperature,humidity\n"
+		"\n"
+		"10.0,21.5,40.2\n"
+		"10.5; 21.6; 40.1\n"
+		"# comment between rows\n"
+		"  12.0 , 21.7 , 40.0  \n");
+	SimulationTrace trace(istr);
+
+	assert (trace.rows() == 3);
+	assert (trace.columns() == 2);
+	assert (trace.time(0) == 0.0);
+	assert (trace.time(1) == 0.5);
+	assert (trace.time(2) == 2.0);
+	assert (trace.duration() == 2.0);
+	assert (trace.value(0, 0) == 21.5);
+	assert (trace.value(0, 1) == 40.2);
+	assert (trace.value(1, 0) == 21.6);
+	assert (trace.value(2, 1) == 40.0);
+}
+
+
+void SimulationTraceTest::testNoHeader()
+{
+	std::istringstream istr(
+		"0,1\n"
+		"1,2\n"
+		"1,3\n");
+	SimulationTrace trace(istr);
+
+	assert (trace.rows() == 3);
+	assert (trace.columns() == 1);
+	assert (trace.time(1) == 1.0);
+	assert (trace.time(2) == 1.0);
+	assert (trace.value(2, 0) == 3.0);
+}
+
+
+void SimulationTraceTest::testColumn()
+{
+	std::istringstream istr(
+		"time,temperature,humidity\n"
+		"0,21.5,40.2\n");
+	SimulationTrace trace(istr);
+
+	assert (trace.column("temperature") == 0);
+	assert (trace.column("humidity") == 1);
+	assert (trace.column("1") == 0);
+	assert (trace.column("2") == 1);
+
+	try
+	{
+		trace.column("pressure");
+		fail("no such column - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+
+	try
+	{
+		trace.column("3");
+		fail("column index out of range - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+
+	try
+	{
+		trace.column("0");
+		fail("column indexes are 1-based - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+}
+
+
+void SimulationTraceTest::testParseErrors()
+{
+	// no data
+	assertInvalid("");
+	assertInvalid("# comment only\n\n");
+	assertInvalid("time,temperature\n");
+
+	// fewer than two fields
+	assertInvalid("0\n");
+
+	// header after data, or a second header
+	assertInvalid("0,1\ntime,value\n");
+	assertInvalid("time,value\ntime,value\n0,1\n");
+
+	// inconsistent number of values
+	assertInvalid("0,1,2\n1,3\n");
+	assertInvalid("time,a,b\n0,1\n");
+
+	// decreasing time
+	assertInvalid("0,1\n2,2\n1,3\n");
+
+	// invalid value
+	assertInvalid("0,1\n1,x\n");
+}
+
+
+void SimulationTraceTest::assertInvalid(const std::string& csv)
+{
+	std::istringstream istr(csv);
+	try
+	{
+		SimulationTrace trace(istr);
+		failmsg("invalid trace must throw: " + csv);
+	}
+	catch (Poco::SyntaxException&)
+	{
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+}
+
+
+void SimulationTraceTest::setUp()
+{
+}
+
+
+void SimulationTraceTest::tearDown()
+{
+}
+
+
+CppUnit::Test* SimulationTraceTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SimulationTraceTest");
+
+	CppUnit_addTest(pSuite, SimulationTraceTest, testHeader);
+	CppUnit_addTest(pSuite, SimulationTraceTest, testNoHeader);
+	CppUnit_addTest(pSuite, SimulationTraceTest, testColumn);
+	CppUnit_addTest(pSuite, SimulationTraceTest, testParseErrors);
+
+	return pSuite;
+}
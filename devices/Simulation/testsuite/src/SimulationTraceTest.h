@@ -0,0 +1,41 @@
+//
+// SimulationTraceTest.h
+//
+// Definition of the SimulationTraceTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef SimulationTraceTest_INCLUDED
+#define SimulationTraceTest_INCLUDED
+
+
+#include "CppUnit/TestCase.h"
+
+
+class SimulationTraceTest: public CppUnit::TestCase
+{
+public:
+	SimulationTraceTest(const std::string& name);
+	~SimulationTraceTest();
+
+	void testHeader();
+	void testNoHeader();
+	void testColumn();
+	void testParseErrors();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+	void assertInvalid(const std::string& csv);
+};
+
+
+#endif // SimulationTraceTest_INCLUDED
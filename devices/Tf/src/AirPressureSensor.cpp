@@ -19,13 +19,14 @@ namespace Tf {
 
 AirPressureSensor::AirPressureSensor(MasterConnection::Ptr pMasterConn, const std::string& uid):
 	BrickletType("io.macchina.tf.barometer", "Tinkerforge Barometer Bricklet", "io.macchina.sensor", "AirPressure", IoT::Devices::Sensor::PHYSICAL_UNIT_MBAR),
+	_pMasterConn(pMasterConn.cast<MasterConnectionImpl>()),
 	_eventPolicy(this->valueChanged, 0.0, 0.0)
 {
 	addProperty("displayValue", &AirPressureSensor::getDisplayValue);
 	addProperty("valueChangedPeriod", &AirPressureSensor::getValueChangedPeriod, &AirPressureSensor::setValueChangedPeriod);
 	addProperty("valueChangedDelta", &AirPressureSensor::getValueChangedDelta, &AirPressureSensor::setValueChangedDelta);
 
-	IPConnection *ipcon = pMasterConn.cast<MasterConnectionImpl>()->ipcon();
+	IPConnection *ipcon = _pMasterConn->ipcon();
 	barometer_create(&_barometer, uid.c_str(), ipcon);
 	
 	char deviceUID[8];
@@ -40,13 +41,15 @@ AirPressureSensor::AirPressureSensor(MasterConnection::Ptr pMasterConn, const st
 	}
 	
 	barometer_register_callback(&_barometer, BAROMETER_CALLBACK_AIR_PRESSURE, reinterpret_cast<void*>(onAirPressureChanged), this);
-	barometer_set_air_pressure_callback_period(&_barometer, 1000);
+	_pMasterConn->scheduler().schedule(this, 1000);
 }
 
 	
 AirPressureSensor::~AirPressureSensor()
 {
+	_pMasterConn->scheduler().remove(this);
 	barometer_destroy(&_barometer);
+	_pMasterConn->dispatcher().remove(this);
 }
 
 
@@ -81,7 +84,7 @@ Poco::Any AirPressureSensor::getValueChangedPeriod(const std::string&) const
 void AirPressureSensor::setValueChangedPeriod(const std::string&, const Poco::Any& value)
 {
 	Poco::UInt32 period = static_cast<Poco::UInt32>(Poco::AnyCast<int>(value));
-	barometer_set_air_pressure_callback_period(&_barometer, period);
+	_pMasterConn->scheduler().schedule(this, period);
 }
 
 
@@ -109,7 +112,7 @@ void AirPressureSensor::onAirPressureChanged(Poco::Int32 airPressure, void* user
 	try
 	{
 		AirPressureSensor* pThis = reinterpret_cast<AirPressureSensor*>(userData);
-		pThis->_eventPolicy.valueChanged(airPressure/1000.0);
+		pThis->_pMasterConn->dispatcher().post(pThis, airPressure/1000.0);
 	}
 	catch (...)
 	{
@@ -117,4 +120,16 @@ void AirPressureSensor::onAirPressureChanged(Poco::Int32 airPressure, void* user
 }
 
 
+void AirPressureSensor::dispatchValue(double value)
+{
+	_eventPolicy.valueChanged(value);
+}
+
+
+void AirPressureSensor::startCallbacks(Poco::UInt32 period)
+{
+	barometer_set_air_pressure_callback_period(&_barometer, period);
+}
+
+
 } } // namespace IoT::Tf
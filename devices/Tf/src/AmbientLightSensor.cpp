@@ -19,13 +19,14 @@ namespace Tf {
 
 AmbientLightSensor::AmbientLightSensor(MasterConnection::Ptr pMasterConn, const std::string& uid):
 	BrickletType("io.macchina.tf.ambientlight", "Tinkerforge Ambient Light Bricklet", "io.macchina.sensor", "illuminance", IoT::Devices::Sensor::PHYSICAL_UNIT_LUX),
+	_pMasterConn(pMasterConn.cast<MasterConnectionImpl>()),
 	_eventPolicy(this->valueChanged, 0.0, 0.0)
 {
 	addProperty("displayValue", &AmbientLightSensor::getDisplayValue);
 	addProperty("valueChangedPeriod", &AmbientLightSensor::getValueChangedPeriod, &AmbientLightSensor::setValueChangedPeriod);
 	addProperty("valueChangedDelta", &AmbientLightSensor::getValueChangedDelta, &AmbientLightSensor::setValueChangedDelta);
 
-	IPConnection *ipcon = pMasterConn.cast<MasterConnectionImpl>()->ipcon();
+	IPConnection *ipcon = _pMasterConn->ipcon();
 	ambient_light_create(&_ambientLight, uid.c_str(), ipcon);
 
 	char deviceUID[8];
@@ -40,13 +41,15 @@ AmbientLightSensor::AmbientLightSensor(MasterConnection::Ptr pMasterConn, const
 	}
 	
 	ambient_light_register_callback(&_ambientLight, AMBIENT_LIGHT_CALLBACK_ILLUMINANCE, reinterpret_cast<void*>(onIlluminanceChanged), this);
-	ambient_light_set_illuminance_callback_period(&_ambientLight, 1000);
+	_pMasterConn->scheduler().schedule(this, 1000);
 }
 
 	
 AmbientLightSensor::~AmbientLightSensor()
 {
+	_pMasterConn->scheduler().remove(this);
 	ambient_light_destroy(&_ambientLight);
+	_pMasterConn->dispatcher().remove(this);
 }
 
 
@@ -81,7 +84,7 @@ Poco::Any AmbientLightSensor::getValueChangedPeriod(const std::string&) const
 void AmbientLightSensor::setValueChangedPeriod(const std::string&, const Poco::Any& value)
 {
 	Poco::UInt32 period = static_cast<Poco::UInt32>(Poco::AnyCast<int>(value));
-	ambient_light_set_illuminance_callback_period(&_ambientLight, period);
+	_pMasterConn->scheduler().schedule(this, period);
 }
 
 
@@ -109,7 +112,7 @@ void AmbientLightSensor::onIlluminanceChanged(Poco::UInt16 illuminance, void* us
 	try
 	{
 		AmbientLightSensor* pThis = reinterpret_cast<AmbientLightSensor*>(userData);
-		pThis->_eventPolicy.valueChanged(illuminance/10.0);
+		pThis->_pMasterConn->dispatcher().post(pThis, illuminance/10.0);
 	}
 	catch (...)
 	{
@@ -117,4 +120,16 @@ void AmbientLightSensor::onIlluminanceChanged(Poco::UInt16 illuminance, void* us
 }
 
 
+void AmbientLightSensor::dispatchValue(double value)
+{
+	_eventPolicy.valueChanged(value);
+}
+
+
+void AmbientLightSensor::startCallbacks(Poco::UInt32 period)
+{
+	ambient_light_set_illuminance_callback_period(&_ambientLight, period);
+}
+
+
 } } // namespace IoT::Tf
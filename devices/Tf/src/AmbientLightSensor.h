@@ -18,6 +18,7 @@
 #include "IoT/Devices/EventModerationPolicy.h"
 #include "IoT/Tf/MasterConnection.h"
 #include "BrickletImpl.h"
+#include "MasterConnectionImpl.h"
 #include "bricklet_ambient_light.h"
 
 
@@ -25,7 +26,7 @@ namespace IoT {
 namespace Tf {
 
 
-class IoTTf_API AmbientLightSensor: public BrickletImpl<IoT::Devices::Sensor, AmbientLightSensor>
+class IoTTf_API AmbientLightSensor: public BrickletImpl<IoT::Devices::Sensor, AmbientLightSensor>, private CallbackDispatcher::Target, private BrickletScheduler::Bricklet
 {
 public:
 	enum
@@ -52,7 +53,14 @@ protected:
 
 	static void onIlluminanceChanged(Poco::UInt16 temperature, void* userData);
 
+	// CallbackDispatcher::Target
+	void dispatchValue(double value);
+
+	// BrickletScheduler::Bricklet
+	void startCallbacks(Poco::UInt32 period);
+
 private:
+	Poco::AutoPtr<MasterConnectionImpl> _pMasterConn;
 	mutable AmbientLight _ambientLight;
 	IoT::Devices::MinimumDeltaModerationPolicy<double> _eventPolicy;
 };
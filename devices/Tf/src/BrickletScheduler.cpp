@@ -0,0 +1,172 @@
+//
+// BrickletScheduler.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "BrickletScheduler.h"
+#include "Poco/Util/TimerTask.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+
+
+namespace IoT {
+namespace Tf {
+
+
+class BrickletScheduler::StartTask: public Poco::Util::TimerTask
+{
+public:
+	StartTask(BrickletScheduler& scheduler, Bricklet* pBricklet, Poco::UInt32 generation):
+		_scheduler(scheduler),
+		_pBricklet(pBricklet),
+		_generation(generation)
+	{
+	}
+
+	void run()
+	{
+		try
+		{
+			_scheduler.start(_pBricklet, _generation);
+		}
+		catch (Poco::Exception& exc)
+		{
+			Poco::ErrorHandler::handle(exc);
+		}
+	}
+
+private:
+	BrickletScheduler& _scheduler;
+	Bricklet* _pBricklet;
+	Poco::UInt32 _generation;
+};
+
+
+BrickletScheduler::Bricklet::~Bricklet()
+{
+}
+
+
+BrickletScheduler::BrickletScheduler():
+	_generation(0)
+{
+}
+
+
+BrickletScheduler::~BrickletScheduler()
+{
+	try
+	{
+		_timer.cancel(true);
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void BrickletScheduler::schedule(Bricklet* pBricklet, Poco::UInt32 period)
+{
+	poco_check_ptr (pBricklet);
+
+	if (period == 0)
+	{
+		remove(pBricklet);
+		pBricklet->startCallbacks(0);
+		return;
+	}
+
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	_schedules.erase(pBricklet);
+	if (_schedules.empty())
+	{
+		_epoch.update();
+	}
+
+	std::vector<Poco::UInt32> phases;
+	for (ScheduleMap::const_iterator it = _schedules.begin(); it != _schedules.end(); ++it)
+	{
+		if (it->second.period == period)
+		{
+			phases.push_back(it->second.phase);
+		}
+	}
+
+	Schedule& sched = _schedules[pBricklet];
+	sched.period = period;
+	sched.phase = phase(phases, period);
+	sched.generation = ++_generation;
+
+	// start at the next time the bricklet's phase begins
+	Poco::Timestamp::TimeDiff now = _epoch.elapsed()/1000;
+	Poco::Timestamp::TimeDiff delay = (sched.phase + period - now % period) % period;
+	_timer.schedule(new StartTask(*this, pBricklet, sched.generation), Poco::Timestamp() + 1000*delay);
+}
+
+
+void BrickletScheduler::remove(Bricklet* pBricklet)
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	_schedules.erase(pBricklet);
+}
+
+
+Poco::UInt32 BrickletScheduler::phase(Bricklet* pBricklet) const
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	ScheduleMap::const_iterator it = _schedules.find(pBricklet);
+	if (it != _schedules.end())
+		return it->second.phase;
+	else
+		throw Poco::NotFoundException("bricklet not scheduled");
+}
+
+
+Poco::UInt32 BrickletScheduler::phase(std::vector<Poco::UInt32> phases, Poco::UInt32 period)
+{
+	if (phases.empty()) return 0;
+
+	std::sort(phases.begin(), phases.end());
+
+	// find the largest gap, including the one
+	// between the last and (wrapped around) first phase
+	std::size_t gapStart = phases.size() - 1;
+	Poco::UInt32 gap = phases[0] + period - phases.back();
+	for (std::size_t i = 0; i + 1 < phases.size(); i++)
+	{
+		Poco::UInt32 g = phases[i + 1] - phases[i];
+		if (g > gap)
+		{
+			gapStart = i;
+			gap = g;
+		}
+	}
+	return (phases[gapStart] + gap/2) % period;
+}
+
+
+void BrickletScheduler::start(Bricklet* pBricklet, Poco::UInt32 generation)
+{
+	// The mutex is held while the bricklet is called,
+	// so that remove() waits until the call is complete.
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	ScheduleMap::const_iterator it = _schedules.find(pBricklet);
+	if (it != _schedules.end() && it->second.generation == generation)
+	{
+		pBricklet->startCallbacks(it->second.period);
+	}
+}
+
+
+} } // namespace IoT::Tf
@@ -0,0 +1,128 @@
+//
+// BrickletScheduler.h
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Tf_BrickletScheduler_INCLUDED
+#define IoT_Tf_BrickletScheduler_INCLUDED
+
+
+#include "IoT/Tf/Tf.h"
+#include "Poco/Util/Timer.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Mutex.h"
+#include <vector>
+#include <map>
+
+
+namespace IoT {
+namespace Tf {
+
+
+class IoTTf_API BrickletScheduler
+	/// BrickletScheduler staggers the callback periods of the
+	/// bricklets connected to a master.
+	///
+	/// A bricklet starts its callback timer when it receives
+	/// the callback period. If all bricklets receive their
+	/// period at the same time (e.g., after enumeration), their
+	/// callbacks arrive at the same time, too, and have to be
+	/// queued by the master and the ip_connection callback thread.
+	///
+	/// BrickletScheduler therefore delays setting the callback
+	/// period of a bricklet, so that the callbacks of all
+	/// bricklets with the same period are evenly spread across
+	/// that period. Each new bricklet is placed in the middle of
+	/// the largest gap between the phases of the bricklets
+	/// already scheduled with the same period.
+	///
+	/// This class is thread-safe.
+{
+public:
+	class IoTTf_API Bricklet
+		/// The interface that must be implemented by
+		/// a bricklet scheduled by the BrickletScheduler.
+	{
+	public:
+		virtual void startCallbacks(Poco::UInt32 period) = 0;
+			/// Sets the bricklet's callback period (in milliseconds)
+			/// on the device.
+
+	protected:
+		virtual ~Bricklet();
+	};
+
+	BrickletScheduler();
+		/// Creates the BrickletScheduler.
+
+	~BrickletScheduler();
+		/// Destroys the BrickletScheduler and cancels all
+		/// pending schedules.
+
+	void schedule(Bricklet* pBricklet, Poco::UInt32 period);
+		/// Schedules the given bricklet to start its callbacks
+		/// with the given period (in milliseconds).
+		///
+		/// The bricklet's startCallbacks() is called from the
+		/// scheduler's timer thread, at the start of the
+		/// bricklet's phase. If the bricklet has been scheduled
+		/// before, the previous schedule is replaced.
+		///
+		/// A period of 0 disables callbacks. In this case,
+		/// startCallbacks() is called immediately from the
+		/// calling thread.
+
+	void remove(Bricklet* pBricklet);
+		/// Removes the given bricklet from the scheduler.
+		///
+		/// When remove() returns, the scheduler will no
+		/// longer call the bricklet, so the bricklet can be
+		/// safely destroyed. Must be called by every bricklet
+		/// before it is destroyed.
+
+	Poco::UInt32 phase(Bricklet* pBricklet) const;
+		/// Returns the phase (in milliseconds) assigned to the
+		/// given bricklet.
+		///
+		/// Throws a Poco::NotFoundException if the bricklet has
+		/// not been scheduled.
+
+	static Poco::UInt32 phase(std::vector<Poco::UInt32> phases, Poco::UInt32 period);
+		/// Returns the phase for a new bricklet with the given
+		/// period, given the phases of the bricklets already
+		/// scheduled with the same period.
+
+protected:
+	struct Schedule
+	{
+		Poco::UInt32 period;
+		Poco::UInt32 phase;
+		Poco::UInt32 generation;
+	};
+
+	void start(Bricklet* pBricklet, Poco::UInt32 generation);
+
+private:
+	typedef std::map<Bricklet*, Schedule> ScheduleMap;
+
+	class StartTask;
+
+	ScheduleMap _schedules;
+	Poco::UInt32 _generation;
+	Poco::Timestamp _epoch;
+	Poco::Util::Timer _timer;
+	mutable Poco::Mutex _mutex;
+
+	friend class StartTask;
+};
+
+
+} } // namespace IoT::Tf
+
+
+#endif // IoT_Tf_BrickletScheduler_INCLUDED
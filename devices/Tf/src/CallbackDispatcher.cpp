@@ -0,0 +1,217 @@
+//
+// CallbackDispatcher.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "CallbackDispatcher.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include <set>
+
+
+namespace IoT {
+namespace Tf {
+
+
+CallbackDispatcher::Target::~Target()
+{
+}
+
+
+CallbackDispatcher::CallbackDispatcher():
+	_batches(0),
+	_posted(0),
+	_coalesced(0),
+	_stopped(true),
+	_thread("IoT.Tf.CallbackDispatcher")
+{
+}
+
+
+CallbackDispatcher::~CallbackDispatcher()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void CallbackDispatcher::start()
+{
+	Poco::FastMutex::ScopedLock lock(_queueMutex);
+
+	if (_stopped)
+	{
+		_stopped = false;
+		_thread.start(*this);
+	}
+}
+
+
+void CallbackDispatcher::stop()
+{
+	{
+		Poco::FastMutex::ScopedLock lock(_queueMutex);
+
+		if (_stopped) return;
+		_stopped = true;
+		_queueNotEmpty.broadcast();
+	}
+	_thread.join();
+
+	Poco::FastMutex::ScopedLock lock(_queueMutex);
+	_queue.clear();
+}
+
+
+void CallbackDispatcher::post(Target* pTarget, double value)
+{
+	poco_check_ptr (pTarget);
+
+	Poco::FastMutex::ScopedLock lock(_queueMutex);
+
+	_queue.push_back(Queue::value_type(pTarget, value));
+	_posted++;
+	if (_queue.size() == 1)
+	{
+		_queueNotEmpty.signal();
+	}
+}
+
+
+void CallbackDispatcher::remove(Target* pTarget)
+{
+	// Holding the dispatch mutex ensures that a batch that
+	// may contain the target is not being delivered by
+	// the dispatcher thread, unless we are called from within
+	// a callback (the mutex is recursive). In that case,
+	// the remaining entries for the target in the current
+	// batch are skipped by clearing their target.
+	Poco::Mutex::ScopedLock dispatchLock(_dispatchMutex);
+
+	for (Queue::iterator it = _batch.begin(); it != _batch.end(); ++it)
+	{
+		if (it->first == pTarget) it->first = 0;
+	}
+
+	Poco::FastMutex::ScopedLock lock(_queueMutex);
+
+	Queue::iterator it = _queue.begin();
+	while (it != _queue.end())
+	{
+		if (it->first == pTarget)
+			it = _queue.erase(it);
+		else
+			++it;
+	}
+}
+
+
+Poco::UInt64 CallbackDispatcher::batches() const
+{
+	Poco::FastMutex::ScopedLock lock(_queueMutex);
+
+	return _batches;
+}
+
+
+Poco::UInt64 CallbackDispatcher::posted() const
+{
+	Poco::FastMutex::ScopedLock lock(_queueMutex);
+
+	return _posted;
+}
+
+
+Poco::UInt64 CallbackDispatcher::coalesced() const
+{
+	Poco::FastMutex::ScopedLock lock(_queueMutex);
+
+	return _coalesced;
+}
+
+
+void CallbackDispatcher::run()
+{
+	for (;;)
+	{
+		{
+			Poco::FastMutex::ScopedLock lock(_queueMutex);
+
+			while (_queue.empty() && !_stopped)
+			{
+				_queueNotEmpty.wait(_queueMutex);
+			}
+			if (_stopped) return;
+		}
+
+		Poco::Mutex::ScopedLock dispatchLock(_dispatchMutex);
+		{
+			Poco::FastMutex::ScopedLock lock(_queueMutex);
+
+			if (_stopped) return;
+			_batch.swap(_queue);
+		}
+		dispatch();
+		_batch.clear();
+	}
+}
+
+
+void CallbackDispatcher::dispatch()
+{
+	// Only deliver the newest value for each target.
+	// Older values are marked by clearing their target.
+	Poco::UInt64 coalesced = 0;
+	std::set<Target*> seen;
+	for (Queue::reverse_iterator it = _batch.rbegin(); it != _batch.rend(); ++it)
+	{
+		if (!seen.insert(it->first).second)
+		{
+			it->first = 0;
+			coalesced++;
+		}
+	}
+
+	// Targets may be cleared by remove() while the batch is
+	// being delivered, so check before every call.
+	for (Queue::iterator it = _batch.begin(); it != _batch.end(); ++it)
+	{
+		if (it->first)
+		{
+			try
+			{
+				it->first->dispatchValue(it->second);
+			}
+			catch (Poco::Exception& exc)
+			{
+				Poco::ErrorHandler::handle(exc);
+			}
+			catch (std::exception& exc)
+			{
+				Poco::ErrorHandler::handle(exc);
+			}
+			catch (...)
+			{
+				Poco::ErrorHandler::handle();
+			}
+		}
+	}
+
+	Poco::FastMutex::ScopedLock lock(_queueMutex);
+	_batches++;
+	_coalesced += coalesced;
+}
+
+
+} } // namespace IoT::Tf
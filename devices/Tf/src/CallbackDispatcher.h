@@ -0,0 +1,119 @@
+//
+// CallbackDispatcher.h
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_Tf_CallbackDispatcher_INCLUDED
+#define IoT_Tf_CallbackDispatcher_INCLUDED
+
+
+#include "IoT/Tf/Tf.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include <vector>
+
+
+namespace IoT {
+namespace Tf {
+
+
+class IoTTf_API CallbackDispatcher: public Poco::Runnable
+	/// CallbackDispatcher decouples the delivery of bricklet value
+	/// callbacks from the ip_connection callback thread.
+	///
+	/// Bricklet callbacks only post() their value, which is cheap,
+	/// and return immediately. A separate dispatcher thread takes
+	/// all values queued since the last batch and delivers them to
+	/// their targets. If a target has more than one value queued
+	/// in a batch, only the newest value is delivered, as the
+	/// older values are already outdated.
+	///
+	/// This way, a slow valueChanged event handler delays
+	/// neither the callbacks of other bricklets nor the
+	/// responses to requests to the master.
+{
+public:
+	class IoTTf_API Target
+		/// The interface that must be implemented by
+		/// a bricklet receiving values from the CallbackDispatcher.
+	{
+	public:
+		virtual void dispatchValue(double value) = 0;
+			/// Delivers the given value to the bricklet.
+			/// Called from the dispatcher thread.
+
+	protected:
+		virtual ~Target();
+	};
+
+	CallbackDispatcher();
+		/// Creates the CallbackDispatcher.
+
+	~CallbackDispatcher();
+		/// Stops the dispatcher thread and destroys the CallbackDispatcher.
+
+	void start();
+		/// Starts the dispatcher thread.
+
+	void stop();
+		/// Stops the dispatcher thread. Values queued,
+		/// but not yet delivered, are discarded.
+
+	void post(Target* pTarget, double value);
+		/// Queues the given value for delivery to the given target.
+
+	void remove(Target* pTarget);
+		/// Discards all values queued for the given target.
+		///
+		/// When remove() returns, the dispatcher thread will no
+		/// longer call the target, so the target can be safely
+		/// destroyed. Must be called by every target before it
+		/// is destroyed.
+		///
+		/// Can also be called from within Target::dispatchValue(),
+		/// e.g. by a handler destroying another bricklet. In this
+		/// case, values for the target that are part of the batch
+		/// currently being delivered are discarded as well.
+
+	Poco::UInt64 batches() const;
+		/// Returns the number of batches delivered.
+
+	Poco::UInt64 posted() const;
+		/// Returns the number of values posted.
+
+	Poco::UInt64 coalesced() const;
+		/// Returns the number of values that have been discarded
+		/// because a newer value for the same target was in
+		/// the same batch.
+
+protected:
+	typedef std::vector<std::pair<Target*, double> > Queue;
+
+	void run();
+	void dispatch();
+
+private:
+	Queue _queue;
+	Queue _batch;
+	Poco::UInt64 _batches;
+	Poco::UInt64 _posted;
+	Poco::UInt64 _coalesced;
+	bool _stopped;
+	Poco::Thread _thread;
+	mutable Poco::FastMutex _queueMutex;
+	Poco::Condition _queueNotEmpty;
+	Poco::Mutex _dispatchMutex;
+};
+
+
+} } // namespace IoT::Tf
+
+
+#endif // IoT_Tf_CallbackDispatcher_INCLUDED
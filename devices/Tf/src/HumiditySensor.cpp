@@ -19,13 +19,14 @@ namespace Tf {
 
 HumiditySensor::HumiditySensor(MasterConnection::Ptr pMasterConn, const std::string& uid):
 	BrickletType("io.macchina.tf.humidity", "Tinkerforge Humidity Bricklet", "io.macchina.sensor", "humidity", "%"),
+	_pMasterConn(pMasterConn.cast<MasterConnectionImpl>()),
 	_eventPolicy(this->valueChanged, 0.0, 0.0)
 {
 	addProperty("displayValue", &HumiditySensor::getDisplayValue);
 	addProperty("valueChangedPeriod", &HumiditySensor::getValueChangedPeriod, &HumiditySensor::setValueChangedPeriod);
 	addProperty("valueChangedDelta", &HumiditySensor::getValueChangedDelta, &HumiditySensor::setValueChangedDelta);
 
-	IPConnection *ipcon = pMasterConn.cast<MasterConnectionImpl>()->ipcon();
+	IPConnection *ipcon = _pMasterConn->ipcon();
 	humidity_create(&_humidity, uid.c_str(), ipcon);
 
 	char deviceUID[8];
@@ -40,13 +41,15 @@ HumiditySensor::HumiditySensor(MasterConnection::Ptr pMasterConn, const std::str
 	}
 
 	humidity_register_callback(&_humidity, HUMIDITY_CALLBACK_HUMIDITY, reinterpret_cast<void*>(onHumidityChanged), this);
-	humidity_set_humidity_callback_period(&_humidity, 1000);
+	_pMasterConn->scheduler().schedule(this, 1000);
 }
 
 
 HumiditySensor::~HumiditySensor()
 {
+	_pMasterConn->scheduler().remove(this);
 	humidity_destroy(&_humidity);
+	_pMasterConn->dispatcher().remove(this);
 }
 
 
@@ -81,7 +84,7 @@ Poco::Any HumiditySensor::getValueChangedPeriod(const std::string&) const
 void HumiditySensor::setValueChangedPeriod(const std::string&, const Poco::Any& value)
 {
 	Poco::UInt32 period = static_cast<Poco::UInt32>(Poco::AnyCast<int>(value));
-	humidity_set_humidity_callback_period(&_humidity, period);
+	_pMasterConn->scheduler().schedule(this, period);
 }
 
 
@@ -109,7 +112,7 @@ void HumiditySensor::onHumidityChanged(Poco::UInt16 humidity, void* userData)
 	try
 	{
 		HumiditySensor* pThis = reinterpret_cast<HumiditySensor*>(userData);
-		pThis->_eventPolicy.valueChanged(humidity/10.0);
+		pThis->_pMasterConn->dispatcher().post(pThis, humidity/10.0);
 	}
 	catch (...)
 	{
@@ -117,4 +120,16 @@ void HumiditySensor::onHumidityChanged(Poco::UInt16 humidity, void* userData)
 }
 
 
+void HumiditySensor::dispatchValue(double value)
+{
+	_eventPolicy.valueChanged(value);
+}
+
+
+void HumiditySensor::startCallbacks(Poco::UInt32 period)
+{
+	humidity_set_humidity_callback_period(&_humidity, period);
+}
+
+
 } } // namespace IoT::Tf
@@ -18,6 +18,7 @@
 #include "IoT/Devices/EventModerationPolicy.h"
 #include "IoT/Tf/MasterConnection.h"
 #include "BrickletImpl.h"
+#include "MasterConnectionImpl.h"
 #include "bricklet_humidity.h"
 
 
@@ -25,7 +26,7 @@ namespace IoT {
 namespace Tf {
 
 
-class IoTTf_API HumiditySensor: public BrickletImpl<IoT::Devices::Sensor, HumiditySensor>
+class IoTTf_API HumiditySensor: public BrickletImpl<IoT::Devices::Sensor, HumiditySensor>, private CallbackDispatcher::Target, private BrickletScheduler::Bricklet
 {
 public:
 	enum
@@ -52,7 +53,14 @@ protected:
 
 	static void onHumidityChanged(Poco::UInt16 humidity, void* userData);
 
+	// CallbackDispatcher::Target
+	void dispatchValue(double value);
+
+	// BrickletScheduler::Bricklet
+	void startCallbacks(Poco::UInt32 period);
+
 private:
+	Poco::AutoPtr<MasterConnectionImpl> _pMasterConn;
 	mutable Humidity _humidity;
 	IoT::Devices::MinimumDeltaModerationPolicy<double> _eventPolicy;
 };
@@ -18,6 +18,7 @@ namespace Tf {
 MasterConnectionImpl::MasterConnectionImpl()
 {
 	ipcon_create(&_ipcon);
+	_dispatcher.start();
 }
 
 	
@@ -25,6 +26,7 @@ MasterConnectionImpl::~MasterConnectionImpl()
 {
 	disconnect();
 	ipcon_destroy(&_ipcon);
+	_dispatcher.stop();
 }
 
 	
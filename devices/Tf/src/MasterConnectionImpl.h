@@ -13,6 +13,8 @@
 
 
 #include "IoT/Tf/MasterConnection.h"
+#include "CallbackDispatcher.h"
+#include "BrickletScheduler.h"
 #include "ip_connection.h"
 
 
@@ -33,6 +35,14 @@ public:
 		
 	IPConnection* ipcon();
 		/// Returns the underlying ip_connection.
+
+	CallbackDispatcher& dispatcher();
+		/// Returns the CallbackDispatcher that delivers
+		/// bricklet callbacks.
+
+	BrickletScheduler& scheduler();
+		/// Returns the BrickletScheduler that staggers
+		/// bricklet callback periods.
 		
 	// MasterConnection
 	void connect(const std::string& host, Poco::UInt16 port);
@@ -52,6 +62,8 @@ protected:
         
 private:
 	IPConnection _ipcon;
+	CallbackDispatcher _dispatcher;
+	BrickletScheduler _scheduler;
 };
 
 
@@ -64,6 +76,18 @@ inline IPConnection* MasterConnectionImpl::ipcon()
 }
 
 
+inline CallbackDispatcher& MasterConnectionImpl::dispatcher()
+{
+	return _dispatcher;
+}
+
+
+inline BrickletScheduler& MasterConnectionImpl::scheduler()
+{
+	return _scheduler;
+}
+
+
 } } // namespace IoT::Tf
 
 
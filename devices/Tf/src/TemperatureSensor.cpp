@@ -19,13 +19,14 @@ namespace Tf {
 
 TemperatureSensor::TemperatureSensor(MasterConnection::Ptr pMasterConn, const std::string& uid):
 	BrickletType("io.macchina.tf.temperature", "Tinkerforge Temperature Bricklet", "io.macchina.sensor", "temperature", IoT::Devices::Sensor::PHYSICAL_UNIT_DEGREES_CELSIUS),
+	_pMasterConn(pMasterConn.cast<MasterConnectionImpl>()),
 	_eventPolicy(this->valueChanged, 0.0, 0.0)
 {
 	addProperty("displayValue", &TemperatureSensor::getDisplayValue);
 	addProperty("valueChangedPeriod", &TemperatureSensor::getValueChangedPeriod, &TemperatureSensor::setValueChangedPeriod);
 	addProperty("valueChangedDelta", &TemperatureSensor::getValueChangedDelta, &TemperatureSensor::setValueChangedDelta);
 
-	IPConnection *ipcon = pMasterConn.cast<MasterConnectionImpl>()->ipcon();
+	IPConnection *ipcon = _pMasterConn->ipcon();
 	temperature_create(&_temperature, uid.c_str(), ipcon);
 	
 	char deviceUID[8];
@@ -40,13 +41,15 @@ TemperatureSensor::TemperatureSensor(MasterConnection::Ptr pMasterConn, const st
 	}
 	
 	temperature_register_callback(&_temperature, TEMPERATURE_CALLBACK_TEMPERATURE, reinterpret_cast<void*>(onTemperatureChanged), this);
-	temperature_set_temperature_callback_period(&_temperature, 1000);
+	_pMasterConn->scheduler().schedule(this, 1000);
 }
 
 	
 TemperatureSensor::~TemperatureSensor()
 {
+	_pMasterConn->scheduler().remove(this);
 	temperature_destroy(&_temperature);
+	_pMasterConn->dispatcher().remove(this);
 }
 
 
@@ -81,7 +84,7 @@ Poco::Any TemperatureSensor::getValueChangedPeriod(const std::string&) const
 void TemperatureSensor::setValueChangedPeriod(const std::string&, const Poco::Any& value)
 {
 	Poco::UInt32 period = static_cast<Poco::UInt32>(Poco::AnyCast<int>(value));
-	temperature_set_temperature_callback_period(&_temperature, period);
+	_pMasterConn->scheduler().schedule(this, period);
 }
 
 
@@ -109,7 +112,7 @@ void TemperatureSensor::onTemperatureChanged(Poco::Int16 temperature, void* user
 	try
 	{
 		TemperatureSensor* pThis = reinterpret_cast<TemperatureSensor*>(userData);
-		pThis->_eventPolicy.valueChanged(temperature/100.0);
+		pThis->_pMasterConn->dispatcher().post(pThis, temperature/100.0);
 	}
 	catch (...)
 	{
@@ -117,4 +120,16 @@ void TemperatureSensor::onTemperatureChanged(Poco::Int16 temperature, void* user
 }
 
 
+void TemperatureSensor::dispatchValue(double value)
+{
+	_eventPolicy.valueChanged(value);
+}
+
+
+void TemperatureSensor::startCallbacks(Poco::UInt32 period)
+{
+	temperature_set_temperature_callback_period(&_temperature, period);
+}
+
+
 } } // namespace IoT::Tf
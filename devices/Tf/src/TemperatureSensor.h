@@ -18,6 +18,7 @@
 #include "IoT/Devices/EventModerationPolicy.h"
 #include "IoT/Tf/MasterConnection.h"
 #include "BrickletImpl.h"
+#include "MasterConnectionImpl.h"
 #include "bricklet_temperature.h"
 
 
@@ -25,7 +26,7 @@ namespace IoT {
 namespace Tf {
 
 
-class IoTTf_API TemperatureSensor: public BrickletImpl<IoT::Devices::Sensor, TemperatureSensor>
+class IoTTf_API TemperatureSensor: public BrickletImpl<IoT::Devices::Sensor, TemperatureSensor>, private CallbackDispatcher::Target, private BrickletScheduler::Bricklet
 {
 public:
 	enum
@@ -51,8 +52,15 @@ protected:
 	Poco::Any getDisplayValue(const std::string&) const;
 
 	static void onTemperatureChanged(Poco::Int16 temperature, void* userData);
+
+	// CallbackDispatcher::Target
+	void dispatchValue(double value);
+
+	// BrickletScheduler::Bricklet
+	void startCallbacks(Poco::UInt32 period);
 	
 private:
+	Poco::AutoPtr<MasterConnectionImpl> _pMasterConn;
 	mutable Temperature _temperature;
 	IoT::Devices::MinimumDeltaModerationPolicy<double> _eventPolicy;
 };
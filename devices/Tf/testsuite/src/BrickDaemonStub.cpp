@@ -0,0 +1,260 @@
+//
+// BrickDaemonStub.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "BrickDaemonStub.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Timespan.h"
+#include "Poco/Exception.h"
+
+
+namespace
+{
+	const char BASE58_ALPHABET[] = "123456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWXYZ";
+
+	const Poco::UInt8 ENUMERATION_TYPE_AVAILABLE = 0;
+	const std::size_t HEADER_SIZE = 8;
+
+	Poco::UInt32 readUInt32(const std::string& data, std::size_t pos)
+	{
+		Poco::UInt32 value = 0;
+		for (int i = 3; i >= 0; i--)
+		{
+			value = (value << 8) | static_cast<unsigned char>(data[pos + i]);
+		}
+		return value;
+	}
+
+	void appendUInt16(std::string& data, Poco::UInt16 value)
+	{
+		data += static_cast<char>(value & 0xFF);
+		data += static_cast<char>(value >> 8);
+	}
+
+	void appendUInt32(std::string& data, Poco::UInt32 value)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			data += static_cast<char>((value >> (8*i)) & 0xFF);
+		}
+	}
+
+	void appendUID(std::string& data, const std::string& uid)
+	{
+		std::string padded(uid, 0, 8);
+		padded.resize(8, '\0');
+		data += padded;
+	}
+}
+
+
+BrickDaemonStub::BrickDaemonStub():
+	_serverSocket(Poco::Net::SocketAddress("127.0.0.1", 0)),
+	_stopped(true)
+{
+}
+
+
+BrickDaemonStub::~BrickDaemonStub()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+Poco::UInt16 BrickDaemonStub::port() const
+{
+	return _serverSocket.address().port();
+}
+
+
+void BrickDaemonStub::addBricklet(const std::string& uid, Poco::UInt16 deviceIdentifier)
+{
+	Bricklet bricklet;
+	bricklet.uid = uid;
+	bricklet.numericUID = numericUID(uid);
+	bricklet.deviceIdentifier = deviceIdentifier;
+	_bricklets.push_back(bricklet);
+}
+
+
+void BrickDaemonStub::start()
+{
+	_stopped = false;
+	_thread.start(*this);
+}
+
+
+void BrickDaemonStub::stop()
+{
+	if (!_stopped)
+	{
+		_stopped = true;
+		_thread.join();
+		_socket.close();
+	}
+}
+
+
+void BrickDaemonStub::sendCallback(const std::string& uid, Poco::UInt8 functionID, const std::string& payload)
+{
+	sendPacket(numericUID(uid), functionID, 0, payload);
+}
+
+
+std::vector<BrickDaemonStub::Request> BrickDaemonStub::requests(Poco::UInt8 functionID) const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	std::vector<Request> result;
+	for (std::vector<Request>::const_iterator it = _requests.begin(); it != _requests.end(); ++it)
+	{
+		if (it->functionID == functionID) result.push_back(*it);
+	}
+	return result;
+}
+
+
+Poco::UInt32 BrickDaemonStub::numericUID(const std::string& uid)
+{
+	Poco::UInt64 value = 0;
+	for (std::string::const_iterator it = uid.begin(); it != uid.end(); ++it)
+	{
+		const char* p = BASE58_ALPHABET;
+		while (*p && *p != *it) ++p;
+		if (!*p) throw Poco::InvalidArgumentException("invalid UID", uid);
+		value = value*58 + (p - BASE58_ALPHABET);
+	}
+	if (value > 0xFFFFFFFF) throw Poco::InvalidArgumentException("UID out of range", uid);
+	return static_cast<Poco::UInt32>(value);
+}
+
+
+void BrickDaemonStub::run()
+{
+	while (!_stopped)
+	{
+		if (_serverSocket.poll(Poco::Timespan(0, 100000), Poco::Net::Socket::SELECT_READ))
+		{
+			Poco::FastMutex::ScopedLock lock(_sendMutex);
+			_socket = _serverSocket.acceptConnection();
+			break;
+		}
+	}
+
+	std::string buffer;
+	char data[512];
+	while (!_stopped)
+	{
+		if (!_socket.poll(Poco::Timespan(0, 100000), Poco::Net::Socket::SELECT_READ)) continue;
+
+		int n = _socket.receiveBytes(data, sizeof(data));
+		if (n <= 0) break;
+		buffer.append(data, n);
+
+		while (buffer.size() >= HEADER_SIZE)
+		{
+			std::size_t length = static_cast<unsigned char>(buffer[4]);
+			if (length < HEADER_SIZE) return;
+			if (buffer.size() < length) break;
+			handlePacket(buffer.substr(0, length));
+			buffer.erase(0, length);
+		}
+	}
+}
+
+
+void BrickDaemonStub::handlePacket(const std::string& packet)
+{
+	Poco::UInt32 uid = readUInt32(packet, 0);
+	Poco::UInt8 functionID = static_cast<Poco::UInt8>(packet[5]);
+	Poco::UInt8 sequenceNumber = (static_cast<Poco::UInt8>(packet[6]) >> 4) & 0x0F;
+	bool responseExpected = (packet[6] & 0x08) != 0;
+	const Bricklet* pBricklet = findBricklet(uid);
+
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		Request request;
+		request.uid = pBricklet ? pBricklet->uid : std::string();
+		request.functionID = functionID;
+		request.payload.assign(packet, HEADER_SIZE, std::string::npos);
+		_requests.push_back(request);
+	}
+
+	switch (functionID)
+	{
+	case FUNCTION_ENUMERATE:
+		for (std::vector<Bricklet>::const_iterator it = _bricklets.begin(); it != _bricklets.end(); ++it)
+		{
+			std::string payload = identity(*it);
+			payload += static_cast<char>(ENUMERATION_TYPE_AVAILABLE);
+			sendPacket(0, CALLBACK_ENUMERATE, 0, payload);
+		}
+		break;
+
+	case FUNCTION_GET_IDENTITY:
+		if (pBricklet)
+		{
+			sendPacket(uid, functionID, sequenceNumber, identity(*pBricklet));
+		}
+		break;
+
+	default:
+		if (responseExpected)
+		{
+			sendPacket(uid, functionID, sequenceNumber, std::string());
+		}
+		break;
+	}
+}
+
+
+void BrickDaemonStub::sendPacket(Poco::UInt32 uid, Poco::UInt8 functionID, Poco::UInt8 sequenceNumber, const std::string& payload)
+{
+	std::string packet;
+	appendUInt32(packet, uid);
+	packet += static_cast<char>(HEADER_SIZE + payload.size());
+	packet += static_cast<char>(functionID);
+	packet += static_cast<char>(sequenceNumber << 4);
+	packet += '\0';
+	packet += payload;
+
+	Poco::FastMutex::ScopedLock lock(_sendMutex);
+	_socket.sendBytes(packet.data(), static_cast<int>(packet.size()));
+}
+
+
+const BrickDaemonStub::Bricklet* BrickDaemonStub::findBricklet(Poco::UInt32 uid) const
+{
+	for (std::vector<Bricklet>::const_iterator it = _bricklets.begin(); it != _bricklets.end(); ++it)
+	{
+		if (it->numericUID == uid) return &*it;
+	}
+	return 0;
+}
+
+
+std::string BrickDaemonStub::identity(const Bricklet& bricklet)
+{
+	std::string data;
+	appendUID(data, bricklet.uid);
+	appendUID(data, "6qzRzc");
+	data += 'a';
+	data += '\1'; data += '\1'; data += '\0';
+	data += '\2'; data += '\0'; data += '\1';
+	appendUInt16(data, bricklet.deviceIdentifier);
+	return data;
+}
@@ -0,0 +1,117 @@
+//
+// BrickDaemonStub.h
+//
+// Definition of the BrickDaemonStub class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef BrickDaemonStub_INCLUDED
+#define BrickDaemonStub_INCLUDED
+
+
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Mutex.h"
+#include "Poco/Timestamp.h"
+#include <vector>
+#include <string>
+
+
+class BrickDaemonStub: public Poco::Runnable
+	/// A minimal stand-in for the Tinkerforge brick daemon (brickd),
+	/// listening on a TCP port on the loopback interface.
+	///
+	/// The stub accepts a single connection from an ip_connection
+	/// and handles the following requests:
+	///   - Enumerate: answered with an enumerate callback for
+	///     every bricklet added with addBricklet().
+	///   - Get Identity: answered with the bricklet's identity.
+	///   - Any other request: answered with an empty response,
+	///     if the request expects a response.
+	///
+	/// All requests are logged, together with the time
+	/// they were received, and can be obtained with requests().
+	///
+	/// Bricklet callbacks can be sent with sendCallback().
+{
+public:
+	struct Request
+	{
+		std::string uid;
+		Poco::UInt8 functionID;
+		std::string payload;
+		Poco::Timestamp time;
+	};
+
+	enum
+	{
+		FUNCTION_DISCONNECT_PROBE = 128,
+		CALLBACK_ENUMERATE        = 253,
+		FUNCTION_ENUMERATE        = 254,
+		FUNCTION_GET_IDENTITY     = 255
+	};
+
+	BrickDaemonStub();
+		/// Creates the BrickDaemonStub, listening on
+		/// an ephemeral port.
+
+	~BrickDaemonStub();
+		/// Stops and destroys the BrickDaemonStub.
+
+	Poco::UInt16 port() const;
+		/// Returns the port the stub is listening on.
+
+	void addBricklet(const std::string& uid, Poco::UInt16 deviceIdentifier);
+		/// Adds a bricklet with the given UID and device identifier.
+		/// Must be called before the stub is started.
+
+	void start();
+		/// Starts the stub thread.
+
+	void stop();
+		/// Stops the stub thread and closes the connection.
+
+	void sendCallback(const std::string& uid, Poco::UInt8 functionID, const std::string& payload);
+		/// Sends a callback packet for the given bricklet.
+
+	std::vector<Request> requests(Poco::UInt8 functionID) const;
+		/// Returns all requests with the given function ID
+		/// received so far.
+
+	static Poco::UInt32 numericUID(const std::string& uid);
+		/// Decodes the given base58 encoded UID.
+
+protected:
+	struct Bricklet
+	{
+		std::string uid;
+		Poco::UInt32 numericUID;
+		Poco::UInt16 deviceIdentifier;
+	};
+
+	void run();
+	void handlePacket(const std::string& packet);
+	void sendPacket(Poco::UInt32 uid, Poco::UInt8 functionID, Poco::UInt8 sequenceNumber, const std::string& payload);
+	const Bricklet* findBricklet(Poco::UInt32 uid) const;
+	static std::string identity(const Bricklet& bricklet);
+
+private:
+	Poco::Net::ServerSocket _serverSocket;
+	Poco::Net::StreamSocket _socket;
+	std::vector<Bricklet> _bricklets;
+	std::vector<Request> _requests;
+	bool _stopped;
+	Poco::Thread _thread;
+	mutable Poco::FastMutex _mutex;
+	Poco::FastMutex _sendMutex;
+};
+
+
+#endif // BrickDaemonStub_INCLUDED
@@ -0,0 +1,207 @@
+//
+// BrickletSchedulerTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "BrickletSchedulerTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "BrickletScheduler.h"
+#include "Poco/Thread.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Mutex.h"
+#include "Poco/Exception.h"
+#include <vector>
+
+
+using IoT::Tf::BrickletScheduler;
+
+
+namespace
+{
+	class TestBricklet: public BrickletScheduler::Bricklet
+	{
+	public:
+		struct Start
+		{
+			Poco::UInt32 period;
+			Poco::Timestamp time;
+		};
+
+		void startCallbacks(Poco::UInt32 period)
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			Start start;
+			start.period = period;
+			_starts.push_back(start);
+		}
+
+		std::vector<Start> starts() const
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			return _starts;
+		}
+
+	private:
+		std::vector<Start> _starts;
+		mutable Poco::FastMutex _mutex;
+	};
+
+	std::vector<Poco::UInt32> phases(Poco::UInt32 p1)
+	{
+		std::vector<Poco::UInt32> result;
+		result.push_back(p1);
+		return result;
+	}
+
+	std::vector<Poco::UInt32> phases(Poco::UInt32 p1, Poco::UInt32 p2)
+	{
+		std::vector<Poco::UInt32> result = phases(p1);
+		result.push_back(p2);
+		return result;
+	}
+
+	std::vector<Poco::UInt32> phases(Poco::UInt32 p1, Poco::UInt32 p2, Poco::UInt32 p3)
+	{
+		std::vector<Poco::UInt32> result = phases(p1, p2);
+		result.push_back(p3);
+		return result;
+	}
+}
+
+
+BrickletSchedulerTest::BrickletSchedulerTest(const std::string& name):
+	CppUnit::TestCase(name)
+{
+}
+
+
+BrickletSchedulerTest::~BrickletSchedulerTest()
+{
+}
+
+
+void BrickletSchedulerTest::testPhase()
+{
+	assert (BrickletScheduler::phase(std::vector<Poco::UInt32>(), 1000) == 0);
+	assert (BrickletScheduler::phase(phases(0), 1000) == 500);
+	assert (BrickletScheduler::phase(phases(0, 500), 1000) == 750);
+	assert (BrickletScheduler::phase(phases(0, 500, 750), 1000) == 250);
+	assert (BrickletScheduler::phase(phases(500, 250), 1000) == 875);
+	assert (BrickletScheduler::phase(phases(0), 1) == 0);
+}
+
+
+void BrickletSchedulerTest::testSchedule()
+{
+	const Poco::UInt32 period = 400;
+
+	BrickletScheduler scheduler;
+	TestBricklet bricklets[4];
+	for (int i = 0; i < 4; i++)
+	{
+		scheduler.schedule(&bricklets[i], period);
+	}
+	assert (scheduler.phase(&bricklets[0]) == 0);
+	assert (scheduler.phase(&bricklets[1]) == 200);
+	assert (scheduler.phase(&bricklets[2]) == 300);
+	assert (scheduler.phase(&bricklets[3]) == 100);
+
+	Poco::Thread::sleep(2*period);
+
+	std::vector<TestBricklet::Start> first = bricklets[0].starts();
+	assert (first.size() == 1);
+	for (int i = 0; i < 4; i++)
+	{
+		std::vector<TestBricklet::Start> starts = bricklets[i].starts();
+		assert (starts.size() == 1);
+		assert (starts[0].period == period);
+
+		Poco::Timestamp::TimeDiff offset = (starts[0].time - first[0].time)/1000;
+		Poco::Timestamp::TimeDiff expected = scheduler.phase(&bricklets[i]);
+		assert (offset > expected - 50 && offset < expected + 50);
+	}
+}
+
+
+void BrickletSchedulerTest::testReschedule()
+{
+	BrickletScheduler scheduler;
+	TestBricklet a;
+	TestBricklet b;
+
+	scheduler.schedule(&a, 400);
+	scheduler.schedule(&b, 400);
+	assert (scheduler.phase(&b) == 200);
+
+	// disabling callbacks takes effect immediately
+	scheduler.schedule(&b, 0);
+	assert (b.starts().size() == 1);
+	assert (b.starts()[0].period == 0);
+
+	// a bricklet alone with its period gets phase 0
+	scheduler.schedule(&b, 1000);
+	assert (scheduler.phase(&b) == 0);
+
+	Poco::Thread::sleep(1200);
+
+	assert (a.starts().size() == 1);
+	assert (a.starts()[0].period == 400);
+	assert (b.starts().size() == 2);
+	assert (b.starts()[1].period == 1000);
+}
+
+
+void BrickletSchedulerTest::testRemove()
+{
+	BrickletScheduler scheduler;
+	TestBricklet a;
+	TestBricklet b;
+
+	scheduler.schedule(&a, 400);
+	scheduler.schedule(&b, 400);
+	scheduler.remove(&b);
+
+	Poco::Thread::sleep(400);
+
+	assert (a.starts().size() == 1);
+	assert (b.starts().empty());
+
+	try
+	{
+		scheduler.phase(&b);
+		fail("bricklet removed - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+}
+
+
+void BrickletSchedulerTest::setUp()
+{
+}
+
+
+void BrickletSchedulerTest::tearDown()
+{
+}
+
+
+CppUnit::Test* BrickletSchedulerTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("BrickletSchedulerTest");
+
+	CppUnit_addTest(pSuite, BrickletSchedulerTest, testPhase);
+	CppUnit_addTest(pSuite, BrickletSchedulerTest, testSchedule);
+	CppUnit_addTest(pSuite, BrickletSchedulerTest, testReschedule);
+	CppUnit_addTest(pSuite, BrickletSchedulerTest, testRemove);
+
+	return pSuite;
+}
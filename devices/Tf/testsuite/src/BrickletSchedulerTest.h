@@ -0,0 +1,39 @@
+//
+// BrickletSchedulerTest.h
+//
+// Definition of the BrickletSchedulerTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef BrickletSchedulerTest_INCLUDED
+#define BrickletSchedulerTest_INCLUDED
+
+
+#include "IoT/Tf/Tf.h"
+#include "CppUnit/TestCase.h"
+
+
+class BrickletSchedulerTest: public CppUnit::TestCase
+{
+public:
+	BrickletSchedulerTest(const std::string& name);
+	~BrickletSchedulerTest();
+
+	void testPhase();
+	void testSchedule();
+	void testReschedule();
+	void testRemove();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // BrickletSchedulerTest_INCLUDED
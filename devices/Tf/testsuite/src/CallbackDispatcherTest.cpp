@@ -0,0 +1,302 @@
+//
+// CallbackDispatcherTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "CallbackDispatcherTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "CallbackDispatcher.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+#include <vector>
+
+
+using IoT::Tf::CallbackDispatcher;
+
+
+namespace
+{
+	class TestTarget: public CallbackDispatcher::Target
+	{
+	public:
+		TestTarget():
+			_block(false)
+		{
+		}
+
+		void dispatchValue(double value)
+		{
+			bool block;
+			{
+				Poco::FastMutex::ScopedLock lock(_mutex);
+				_values.push_back(value);
+				block = _block;
+				_block = false;
+			}
+			_dispatched.set();
+			if (block) _released.wait();
+		}
+
+		void block()
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			_block = true;
+			_dispatched.reset();
+		}
+
+		void release()
+		{
+			_released.set();
+		}
+
+		void waitDispatched()
+		{
+			_dispatched.wait(2000);
+		}
+
+		bool waitValues(std::size_t n)
+		{
+			for (int i = 0; i < 200; i++)
+			{
+				if (values().size() >= n) return true;
+				Poco::Thread::sleep(10);
+			}
+			return false;
+		}
+
+		std::vector<double> values() const
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			return _values;
+		}
+
+	private:
+		std::vector<double> _values;
+		bool _block;
+		Poco::Event _dispatched;
+		Poco::Event _released;
+		mutable Poco::FastMutex _mutex;
+	};
+
+	class RemovingTarget: public CallbackDispatcher::Target
+		/// Removes another target from within its callback, like a
+		/// valueChanged handler destroying another bricklet.
+	{
+	public:
+		RemovingTarget(CallbackDispatcher& dispatcher, CallbackDispatcher::Target* pTarget):
+			_dispatcher(dispatcher),
+			_pTarget(pTarget),
+			_dispatched(0)
+		{
+		}
+
+		void dispatchValue(double value)
+		{
+			_dispatcher.remove(_pTarget);
+			_dispatched++;
+		}
+
+		int dispatched() const
+		{
+			return _dispatched;
+		}
+
+	private:
+		CallbackDispatcher& _dispatcher;
+		CallbackDispatcher::Target* _pTarget;
+		int _dispatched;
+	};
+
+	class Remover: public Poco::Runnable
+	{
+	public:
+		Remover(CallbackDispatcher& dispatcher, CallbackDispatcher::Target* pTarget):
+			_dispatcher(dispatcher),
+			_pTarget(pTarget)
+		{
+		}
+
+		void run()
+		{
+			_dispatcher.remove(_pTarget);
+			_removed.set();
+		}
+
+		bool removed(long milliseconds)
+		{
+			return _removed.tryWait(milliseconds);
+		}
+
+	private:
+		CallbackDispatcher& _dispatcher;
+		CallbackDispatcher::Target* _pTarget;
+		Poco::Event _removed;
+	};
+}
+
+
+CallbackDispatcherTest::CallbackDispatcherTest(const std::string& name):
+	CppUnit::TestCase(name)
+{
+}
+
+
+CallbackDispatcherTest::~CallbackDispatcherTest()
+{
+}
+
+
+void CallbackDispatcherTest::testDispatch()
+{
+	CallbackDispatcher dispatcher;
+	TestTarget a;
+	TestTarget b;
+	dispatcher.start();
+
+	dispatcher.post(&a, 1.0);
+	assert (a.waitValues(1));
+	dispatcher.post(&b, 2.0);
+	assert (b.waitValues(1));
+	dispatcher.post(&a, 3.0);
+	assert (a.waitValues(2));
+
+	dispatcher.stop();
+
+	assert (a.values().size() == 2);
+	assert (a.values()[0] == 1.0);
+	assert (a.values()[1] == 3.0);
+	assert (b.values().size() == 1);
+	assert (b.values()[0] == 2.0);
+	assert (dispatcher.posted() == 3);
+	assert (dispatcher.batches() == 3);
+	assert (dispatcher.coalesced() == 0);
+}
+
+
+void CallbackDispatcherTest::testCoalesce()
+{
+	CallbackDispatcher dispatcher;
+	TestTarget a;
+	TestTarget b;
+	dispatcher.start();
+
+	// keep the dispatcher busy, so that the following values
+	// are delivered in a single batch
+	a.block();
+	dispatcher.post(&a, 1.0);
+	a.waitDispatched();
+
+	dispatcher.post(&a, 2.0);
+	dispatcher.post(&a, 3.0);
+	dispatcher.post(&b, 10.0);
+	dispatcher.post(&b, 11.0);
+	dispatcher.post(&a, 4.0);
+	a.release();
+
+	assert (a.waitValues(2));
+	assert (b.waitValues(1));
+	dispatcher.stop();
+
+	assert (a.values().size() == 2);
+	assert (a.values()[0] == 1.0);
+	assert (a.values()[1] == 4.0);
+	assert (b.values().size() == 1);
+	assert (b.values()[0] == 11.0);
+	assert (dispatcher.posted() == 6);
+	assert (dispatcher.batches() == 2);
+	assert (dispatcher.coalesced() == 3);
+}
+
+
+void CallbackDispatcherTest::testRemove()
+{
+	CallbackDispatcher dispatcher;
+	TestTarget a;
+	TestTarget b;
+
+	dispatcher.post(&b, 1.0);
+	dispatcher.post(&a, 2.0);
+	dispatcher.remove(&b);
+	dispatcher.start();
+
+	assert (a.waitValues(1));
+	Poco::Thread::sleep(50);
+	assert (b.values().empty());
+
+	// remove() must wait until a batch containing the target is delivered
+	a.block();
+	dispatcher.post(&a, 3.0);
+	a.waitDispatched();
+
+	Remover remover(dispatcher, &a);
+	Poco::Thread thread;
+	thread.start(remover);
+	assert (!remover.removed(100));
+	a.release();
+	assert (remover.removed(2000));
+	thread.join();
+
+	dispatcher.stop();
+	assert (a.values().size() == 2);
+}
+
+
+void CallbackDispatcherTest::testRemoveFromCallback()
+{
+	CallbackDispatcher dispatcher;
+	TestTarget a;
+	TestTarget b;
+	RemovingTarget remover(dispatcher, &b);
+	dispatcher.start();
+
+	// keep the dispatcher busy, so that the following values
+	// are delivered in a single batch
+	a.block();
+	dispatcher.post(&a, 1.0);
+	a.waitDispatched();
+
+	dispatcher.post(&remover, 2.0);
+	dispatcher.post(&b, 3.0);
+	dispatcher.post(&a, 4.0);
+	a.release();
+
+	assert (a.waitValues(2));
+	dispatcher.stop();
+
+	assert (remover.dispatched() == 1);
+	assert (b.values().empty());
+	assert (a.values().size() == 2);
+	assert (a.values()[1] == 4.0);
+	assert (dispatcher.batches() == 2);
+}
+
+
+void CallbackDispatcherTest::setUp()
+{
+}
+
+
+void CallbackDispatcherTest::tearDown()
+{
+}
+
+
+CppUnit::Test* CallbackDispatcherTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("CallbackDispatcherTest");
+
+	CppUnit_addTest(pSuite, CallbackDispatcherTest, testDispatch);
+	CppUnit_addTest(pSuite, CallbackDispatcherTest, testCoalesce);
+	CppUnit_addTest(pSuite, CallbackDispatcherTest, testRemove);
+	CppUnit_addTest(pSuite, CallbackDispatcherTest, testRemoveFromCallback);
+
+	return pSuite;
+}
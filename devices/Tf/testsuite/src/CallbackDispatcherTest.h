@@ -0,0 +1,39 @@
+//
+// CallbackDispatcherTest.h
+//
+// Definition of the CallbackDispatcherTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef CallbackDispatcherTest_INCLUDED
+#define CallbackDispatcherTest_INCLUDED
+
+
+#include "IoT/Tf/Tf.h"
+#include "CppUnit/TestCase.h"
+
+
+class CallbackDispatcherTest: public CppUnit::TestCase
+{
+public:
+	CallbackDispatcherTest(const std::string& name);
+	~CallbackDispatcherTest();
+
+	void testDispatch();
+	void testCoalesce();
+	void testRemove();
+	void testRemoveFromCallback();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // CallbackDispatcherTest_INCLUDED
@@ -0,0 +1,324 @@
+//
+// TemperatureSensorTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "TemperatureSensorTest.h"
+#include "BrickDaemonStub.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "MasterConnectionImpl.h"
+#include "TemperatureSensor.h"
+#include "Poco/Delegate.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include <algorithm>
+#include <vector>
+#include <set>
+
+
+using namespace IoT::Tf;
+
+
+namespace
+{
+	const int BRICKLETS = 4;
+
+	std::string brickletUID(int i)
+	{
+		std::string uid("dX");
+		uid += static_cast<char>('a' + i);
+		return uid;
+	}
+
+	std::string temperaturePayload(Poco::Int16 temperature)
+	{
+		std::string payload;
+		payload += static_cast<char>(temperature & 0xFF);
+		payload += static_cast<char>((temperature >> 8) & 0xFF);
+		return payload;
+	}
+
+	Poco::UInt32 periodFromPayload(const std::string& payload)
+	{
+		Poco::UInt32 period = 0;
+		for (int i = 3; i >= 0; i--)
+		{
+			period = (period << 8) | static_cast<unsigned char>(payload[i]);
+		}
+		return period;
+	}
+
+	class DeviceListener
+	{
+	public:
+		void onDeviceStateChanged(const MasterConnection::DeviceEvent& event)
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			_events.push_back(event);
+		}
+
+		std::vector<MasterConnection::DeviceEvent> events() const
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			return _events;
+		}
+
+	private:
+		std::vector<MasterConnection::DeviceEvent> _events;
+		mutable Poco::FastMutex _mutex;
+	};
+
+	class ValueListener
+	{
+	public:
+		ValueListener():
+			_delay(0)
+		{
+		}
+
+		void onValueChanged(const double& value)
+		{
+			{
+				Poco::FastMutex::ScopedLock lock(_mutex);
+				_values.push_back(value);
+			}
+			if (_delay) Poco::Thread::sleep(_delay);
+		}
+
+		void setDelay(long delay)
+		{
+			_delay = delay;
+		}
+
+		bool waitValue(double value)
+		{
+			for (int i = 0; i < 500; i++)
+			{
+				std::vector<double> v = values();
+				if (!v.empty() && v.back() == value) return true;
+				Poco::Thread::sleep(10);
+			}
+			return false;
+		}
+
+		std::vector<double> values() const
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			return _values;
+		}
+
+	private:
+		std::vector<double> _values;
+		long _delay;
+		mutable Poco::FastMutex _mutex;
+	};
+}
+
+
+TemperatureSensorTest::TemperatureSensorTest(const std::string& name):
+	CppUnit::TestCase(name)
+{
+}
+
+
+TemperatureSensorTest::~TemperatureSensorTest()
+{
+}
+
+
+void TemperatureSensorTest::testEnumerate()
+{
+	BrickDaemonStub stub;
+	for (int i = 0; i < BRICKLETS; i++)
+	{
+		stub.addBricklet(brickletUID(i), TemperatureSensor::DEVICE_IDENTIFIER);
+	}
+	stub.start();
+
+	DeviceListener listener;
+	MasterConnection::Ptr pMasterConn = new MasterConnectionImpl;
+	pMasterConn->deviceStateChanged += Poco::delegate(&listener, &DeviceListener::onDeviceStateChanged);
+	pMasterConn->connect("127.0.0.1", stub.port());
+	assert (pMasterConn->connected());
+
+	for (int i = 0; i < 200 && listener.events().size() < BRICKLETS; i++)
+	{
+		Poco::Thread::sleep(10);
+	}
+
+	std::vector<MasterConnection::DeviceEvent> events = listener.events();
+	assert (events.size() == BRICKLETS);
+	for (int i = 0; i < BRICKLETS; i++)
+	{
+		assert (events[i].state == MasterConnection::DEVICE_AVAILABLE);
+		assert (events[i].uid == brickletUID(i));
+		assert (events[i].type == TemperatureSensor::DEVICE_IDENTIFIER);
+	}
+
+	pMasterConn->deviceStateChanged -= Poco::delegate(&listener, &DeviceListener::onDeviceStateChanged);
+	pMasterConn->disconnect();
+}
+
+
+void TemperatureSensorTest::testStaggeredPeriods()
+{
+	BrickDaemonStub stub;
+	for (int i = 0; i < BRICKLETS; i++)
+	{
+		stub.addBricklet(brickletUID(i), TemperatureSensor::DEVICE_IDENTIFIER);
+	}
+	stub.start();
+
+	MasterConnection::Ptr pMasterConn = new MasterConnectionImpl;
+	pMasterConn->connect("127.0.0.1", stub.port());
+
+	std::vector<Poco::SharedPtr<TemperatureSensor> > sensors;
+	for (int i = 0; i < BRICKLETS; i++)
+	{
+		sensors.push_back(new TemperatureSensor(pMasterConn, brickletUID(i)));
+		assert (sensors.back()->getPropertyString("uid") == brickletUID(i));
+	}
+
+	Poco::Thread::sleep(1200);
+
+	// the callback periods are set a quarter period apart
+	std::vector<BrickDaemonStub::Request> requests = stub.requests(TEMPERATURE_FUNCTION_SET_TEMPERATURE_CALLBACK_PERIOD);
+	assert (requests.size() == BRICKLETS);
+	std::set<std::string> uids;
+	std::vector<Poco::Timestamp::TimeDiff> offsets;
+	for (std::vector<BrickDaemonStub::Request>::const_iterator it = requests.begin(); it != requests.end(); ++it)
+	{
+		assert (periodFromPayload(it->payload) == 1000);
+		uids.insert(it->uid);
+		offsets.push_back((it->time - requests[0].time)/1000);
+	}
+	assert (uids.size() == BRICKLETS);
+	std::sort(offsets.begin(), offsets.end());
+	for (int i = 0; i < BRICKLETS; i++)
+	{
+		assert (offsets[i] > 250*i - 100 && offsets[i] < 250*i + 100);
+	}
+
+	// disabling callbacks takes effect immediately
+	sensors[1]->setPropertyInt("valueChangedPeriod", 0);
+	requests = stub.requests(TEMPERATURE_FUNCTION_SET_TEMPERATURE_CALLBACK_PERIOD);
+	assert (requests.size() == BRICKLETS + 1);
+	assert (requests.back().uid == brickletUID(1));
+	assert (periodFromPayload(requests.back().payload) == 0);
+
+	sensors.clear();
+	pMasterConn->disconnect();
+}
+
+
+void TemperatureSensorTest::testValueChanged()
+{
+	BrickDaemonStub stub;
+	stub.addBricklet(brickletUID(0), TemperatureSensor::DEVICE_IDENTIFIER);
+	stub.start();
+
+	MasterConnection::Ptr pMasterConn = new MasterConnectionImpl;
+	pMasterConn->connect("127.0.0.1", stub.port());
+
+	ValueListener listener;
+	Poco::SharedPtr<TemperatureSensor> pSensor = new TemperatureSensor(pMasterConn, brickletUID(0));
+	pSensor->valueChanged += Poco::delegate(&listener, &ValueListener::onValueChanged);
+
+	stub.sendCallback(brickletUID(0), TEMPERATURE_CALLBACK_TEMPERATURE, temperaturePayload(2150));
+	assert (listener.waitValue(21.5));
+	stub.sendCallback(brickletUID(0), TEMPERATURE_CALLBACK_TEMPERATURE, temperaturePayload(-425));
+	assert (listener.waitValue(-4.25));
+	assert (listener.values().size() == 2);
+
+	pSensor->valueChanged -= Poco::delegate(&listener, &ValueListener::onValueChanged);
+	pSensor = 0;
+	pMasterConn->disconnect();
+}
+
+
+void TemperatureSensorTest::testBatching()
+{
+	const int CALLBACKS = 50;
+
+	BrickDaemonStub stub;
+	for (int i = 0; i < BRICKLETS; i++)
+	{
+		stub.addBricklet(brickletUID(i), TemperatureSensor::DEVICE_IDENTIFIER);
+	}
+	stub.start();
+
+	Poco::AutoPtr<MasterConnectionImpl> pMasterConn = new MasterConnectionImpl;
+	pMasterConn->connect("127.0.0.1", stub.port());
+
+	std::vector<Poco::SharedPtr<TemperatureSensor> > sensors;
+	ValueListener listeners[BRICKLETS];
+	for (int i = 0; i < BRICKLETS; i++)
+	{
+		sensors.push_back(new TemperatureSensor(pMasterConn, brickletUID(i)));
+		sensors.back()->valueChanged += Poco::delegate(&listeners[i], &ValueListener::onValueChanged);
+		listeners[i].setDelay(5);
+	}
+
+	// a slow valueChanged handler must not hold up the callbacks
+	for (int k = 0; k < CALLBACKS; k++)
+	{
+		for (int i = 0; i < BRICKLETS; i++)
+		{
+			stub.sendCallback(brickletUID(i), TEMPERATURE_CALLBACK_TEMPERATURE, temperaturePayload(2000 + k));
+		}
+	}
+
+	for (int i = 0; i < BRICKLETS; i++)
+	{
+		assert (listeners[i].waitValue((2000 + CALLBACKS - 1)/100.0));
+	}
+	Poco::Thread::sleep(100);
+
+	std::size_t delivered = 0;
+	for (int i = 0; i < BRICKLETS; i++)
+	{
+		delivered += listeners[i].values().size();
+	}
+
+	assert (pMasterConn->dispatcher().posted() == BRICKLETS*CALLBACKS);
+	assert (pMasterConn->dispatcher().coalesced() > 0);
+	assert (delivered + pMasterConn->dispatcher().coalesced() == BRICKLETS*CALLBACKS);
+	assert (pMasterConn->dispatcher().batches() < BRICKLETS*CALLBACKS);
+
+	for (int i = 0; i < BRICKLETS; i++)
+	{
+		sensors[i]->valueChanged -= Poco::delegate(&listeners[i], &ValueListener::onValueChanged);
+	}
+	sensors.clear();
+	pMasterConn->disconnect();
+}
+
+
+void TemperatureSensorTest::setUp()
+{
+}
+
+
+void TemperatureSensorTest::tearDown()
+{
+}
+
+
+CppUnit::Test* TemperatureSensorTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TemperatureSensorTest");
+
+	CppUnit_addTest(pSuite, TemperatureSensorTest, testEnumerate);
+	CppUnit_addTest(pSuite, TemperatureSensorTest, testStaggeredPeriods);
+	CppUnit_addTest(pSuite, TemperatureSensorTest, testValueChanged);
+	CppUnit_addTest(pSuite, TemperatureSensorTest, testBatching);
+
+	return pSuite;
+}
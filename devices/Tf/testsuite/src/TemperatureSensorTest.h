@@ -0,0 +1,39 @@
+//
+// TemperatureSensorTest.h
+//
+// Definition of the TemperatureSensorTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TemperatureSensorTest_INCLUDED
+#define TemperatureSensorTest_INCLUDED
+
+
+#include "IoT/Tf/Tf.h"
+#include "CppUnit/TestCase.h"
+
+
+class TemperatureSensorTest: public CppUnit::TestCase
+{
+public:
+	TemperatureSensorTest(const std::string& name);
+	~TemperatureSensorTest();
+
+	void testEnumerate();
+	void testStaggeredPeriods();
+	void testValueChanged();
+	void testBatching();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // TemperatureSensorTest_INCLUDED
@@ -0,0 +1,26 @@
+//
+// TfTestSuite.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "TfTestSuite.h"
+#include "CallbackDispatcherTest.h"
+#include "BrickletSchedulerTest.h"
+#include "TemperatureSensorTest.h"
+
+
+CppUnit::Test* TfTestSuite::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TfTestSuite");
+
+	pSuite->addTest(CallbackDispatcherTest::suite());
+	pSuite->addTest(BrickletSchedulerTest::suite());
+	pSuite->addTest(TemperatureSensorTest::suite());
+
+	return pSuite;
+}
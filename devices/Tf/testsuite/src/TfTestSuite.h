@@ -0,0 +1,27 @@
+//
+// TfTestSuite.h
+//
+// Definition of the TfTestSuite class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TfTestSuite_INCLUDED
+#define TfTestSuite_INCLUDED
+
+
+#include "CppUnit/TestSuite.h"
+
+
+class TfTestSuite
+{
+public:
+	static CppUnit::Test* suite();
+};
+
+
+#endif // TfTestSuite_INCLUDED
@@ -23,6 +23,8 @@
 #include "IoT/Devices/GyroscopeServerHelper.h"
 #include "IoT/Devices/MagnetometerServerHelper.h"
 #include "IoT/Devices/TriggerServerHelper.h"
+#include "IoT/Devices/SampleStreamServerHelper.h"
+#include "IoT/Devices/BufferedSampleStream.h"
 #include "IoT/BtLE/PeripheralFactory.h"
 #include "Poco/Delegate.h"
 #include "Poco/ClassLibrary.h"
@@ -177,6 +179,38 @@ public:
 		return pSensor;
 	}
 
+	IoT::Devices::BufferedSampleStream::Ptr createSampleStream(BtLE::Peripheral::Ptr pPeripheral, const std::string& name, const std::string& symbolicName, const std::string& physicalQuantity, const std::string& physicalUnit)
+	{
+		typedef Poco::RemotingNG::ServerHelper<IoT::Devices::SampleStream> ServerHelper;
+
+		IoT::Devices::BufferedSampleStream::Params params;
+		params.name = name + " Stream";
+		params.symbolicName = symbolicName + ".stream";
+		params.deviceIdentifier = pPeripheral->address();
+		params.physicalQuantity = physicalQuantity;
+		params.physicalUnit = physicalUnit;
+		params.channelNames.push_back("x");
+		params.channelNames.push_back("y");
+		params.channelNames.push_back("z");
+		params.blockSize = _pPrefs->configuration()->getInt("xdk.sampleStream.blockSize", IoT::Devices::BufferedSampleStream::DEFAULT_BLOCK_SIZE);
+		params.blockLatency = _pPrefs->configuration()->getInt("xdk.sampleStream.blockLatency", IoT::Devices::BufferedSampleStream::DEFAULT_BLOCK_LATENCY);
+		params.bufferSize = _pPrefs->configuration()->getInt("xdk.sampleStream.bufferSize", IoT::Devices::BufferedSampleStream::DEFAULT_BUFFER_SIZE);
+		params.pTimer = _pTimer;
+
+		IoT::Devices::BufferedSampleStream::Ptr pSampleStream = new IoT::Devices::BufferedSampleStream(params);
+		std::string oid(params.symbolicName);
+		oid += '#';
+		oid += pPeripheral->address();
+		ServerHelper::RemoteObjectPtr pSampleStreamRemoteObject = ServerHelper::createRemoteObject(pSampleStream, oid);
+		Properties props;
+		props.set("io.macchina.device", params.symbolicName);
+		props.set("io.macchina.deviceType", IoT::Devices::BufferedSampleStream::TYPE);
+		props.set("io.macchina.btle.address", pPeripheral->address());
+		ServiceRef::Ptr pServiceRef = _pContext->registry().registerService(oid, pSampleStreamRemoteObject, props);
+		_serviceRefs.push_back(pServiceRef);
+		return pSampleStream;
+	}
+
 	Poco::SharedPtr<HighRateAccelerometer> createHighRateAccelerometer(BtLE::Peripheral::Ptr pPeripheral)
 	{
 		typedef Poco::RemotingNG::ServerHelper<IoT::Devices::Accelerometer> ServerHelper;
@@ -191,6 +225,10 @@ public:
 		props.set("io.macchina.btle.address", pPeripheral->address());
 		ServiceRef::Ptr pServiceRef = _pContext->registry().registerService(oid, pAccelerometerRemoteObject, props);
 		_serviceRefs.push_back(pServiceRef);
+		if (_useSampleStreams)
+		{
+			pAccelerometer->setSampleStream(createSampleStream(pPeripheral, HighRateAccelerometer::NAME, HighRateAccelerometer::SYMBOLIC_NAME, "acceleration", "g"));
+		}
 		return pAccelerometer;
 	}
 
@@ -208,6 +246,10 @@ public:
 		props.set("io.macchina.btle.address", pPeripheral->address());
 		ServiceRef::Ptr pServiceRef = _pContext->registry().registerService(oid, pGyroscopeRemoteObject, props);
 		_serviceRefs.push_back(pServiceRef);
+		if (_useSampleStreams)
+		{
+			pGyroscope->setSampleStream(createSampleStream(pPeripheral, HighRateGyroscope::NAME, HighRateGyroscope::SYMBOLIC_NAME, "angularVelocity", "deg/s"));
+		}
 		return pGyroscope;
 	}
 
@@ -225,6 +267,10 @@ public:
 		props.set("io.macchina.btle.address", pPeripheral->address());
 		ServiceRef::Ptr pServiceRef = _pContext->registry().registerService(oid, pMagnetometerRemoteObject, props);
 		_serviceRefs.push_back(pServiceRef);
+		if (_useSampleStreams)
+		{
+			pMagnetometer->setSampleStream(createSampleStream(pPeripheral, HighRateMagnetometer::NAME, HighRateMagnetometer::SYMBOLIC_NAME, "magneticFluxDensity", "mT"));
+		}
 		return pMagnetometer;
 	}
 
@@ -495,6 +541,7 @@ public:
 		_pTimer = new Poco::Util::Timer;
 
 		_useHighRateService = _pPrefs->configuration()->getBool("xdk.useHighRateDataService", true);
+		_useSampleStreams = _pPrefs->configuration()->getBool("xdk.sampleStream.enable", true);
 
 		Poco::Util::AbstractConfiguration::Keys keys;
 		_pPrefs->configuration()->keys("xdk.sensors", keys);
@@ -682,6 +729,7 @@ private:
 	std::vector<PeripheralInfo> _peripherals;
 	std::vector<ServiceRef::Ptr> _serviceRefs;
 	bool _useHighRateService;
+	bool _useSampleStreams;
 
 	Poco::SharedPtr<HighRateSensor> _pHumiditySensor;
 	Poco::SharedPtr<HighRateSensor> _pTemperatureSensor;
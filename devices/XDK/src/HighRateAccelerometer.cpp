@@ -136,18 +136,33 @@ void HighRateAccelerometer::update(const IoT::Devices::Acceleration& acceleratio
 
 	if (_enabled)
 	{
-		if (!_ready || acceleration.x != _acceleration.x || acceleration.y != _acceleration.y || acceleration.z != _acceleration.z)
-		{
-			_ready = true;
-			_acceleration = acceleration;
-			lock.unlock();
+		bool changed = !_ready || acceleration.x != _acceleration.x || acceleration.y != _acceleration.y || acceleration.z != _acceleration.z;
+		_ready = true;
+		_acceleration = acceleration;
+		IoT::Devices::BufferedSampleStream::Ptr pSampleStream = _pSampleStream;
+		lock.unlock();
 
+		if (pSampleStream)
+		{
+			double values[3] = {acceleration.x, acceleration.y, acceleration.z};
+			pSampleStream->addSample(Poco::Timestamp(), values);
+		}
+		if (changed)
+		{
 			accelerationChanged(this, acceleration);
 		}
 	}
 }
 
 
+void HighRateAccelerometer::setSampleStream(IoT::Devices::BufferedSampleStream::Ptr pSampleStream)
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	_pSampleStream = pSampleStream;
+}
+
+
 void HighRateAccelerometer::init()
 {
 	enable(true);
@@ -136,18 +136,33 @@ void HighRateGyroscope::update(const IoT::Devices::Rotation& rotation)
 
 	if (_enabled)
 	{
-		if (!_ready || rotation.x != _rotation.x || rotation.y != _rotation.y || rotation.z != _rotation.z)
-		{
-			_ready = true;
-			_rotation = rotation;
-			lock.unlock();
+		bool changed = !_ready || rotation.x != _rotation.x || rotation.y != _rotation.y || rotation.z != _rotation.z;
+		_ready = true;
+		_rotation = rotation;
+		IoT::Devices::BufferedSampleStream::Ptr pSampleStream = _pSampleStream;
+		lock.unlock();
 
+		if (pSampleStream)
+		{
+			double values[3] = {rotation.x, rotation.y, rotation.z};
+			pSampleStream->addSample(Poco::Timestamp(), values);
+		}
+		if (changed)
+		{
 			rotationChanged(this, rotation);
 		}
 	}
 }
 
 
+void HighRateGyroscope::setSampleStream(IoT::Devices::BufferedSampleStream::Ptr pSampleStream)
+{
+	Poco::Mutex::ScopedLock lock(_mutex);
+
+	_pSampleStream = pSampleStream;
+}
+
+
 void HighRateGyroscope::init()
 {
 	enable(true);
@@ -14,6 +14,7 @@
 
 #include "IoT/Devices/Magnetometer.h"
 #include "IoT/Devices/DeviceImpl.h"
+#include "IoT/Devices/BufferedSampleStream.h"
 #include "IoT/BtLE/Peripheral.h"
 #include "Poco/SharedPtr.h"
 
@@ -39,6 +40,10 @@ public:
 	void update(const IoT::Devices::MagneticFieldStrength& fieldStrength);
 		/// Updates the field strength.
 
+	void setSampleStream(IoT::Devices::BufferedSampleStream::Ptr pSampleStream);
+		/// Sets the SampleStream that receives every sample,
+		/// whether or not it differs from the previous one.
+
 	// Magnetometer
 	IoT::Devices::MagneticFieldStrength fieldStrength() const;
 
@@ -66,6 +71,7 @@ protected:
 	bool _ready;
 	IoT::Devices::MagneticFieldStrength _fieldStrength;
 	Poco::Any _deviceIdentifier;
+	IoT::Devices::BufferedSampleStream::Ptr _pSampleStream;
 };
 
 
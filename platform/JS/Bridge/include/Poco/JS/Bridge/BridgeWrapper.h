@@ -19,6 +19,7 @@
 
 
 #include "Poco/JS/Bridge/Bridge.h"
+#include "Poco/JS/Bridge/Serializer.h"
 #include "Poco/JS/Core/Wrapper.h"
 #include "Poco/JS/Core/JSExecutor.h"
 #include "Poco/RemotingNG/EventDispatcher.h"
@@ -80,6 +81,15 @@ public:
 		
 	bool handleEvent(const std::string& event);
 		/// Returns true if the given event is handled.
+
+	void setBinaryType(Serializer::BinaryType binaryType);
+		/// Sets the type of the JavaScript objects binary data
+		/// (std::vector<char>) in return values and events
+		/// is passed as.
+
+	Serializer::BinaryType getBinaryType() const;
+		/// Returns the type of the JavaScript objects binary data
+		/// is passed as.
 		
 	static Ptr find(const std::string& subscriberURI);
 		/// Finds the Holder in the global holder map.
@@ -103,6 +113,7 @@ private:
 	v8::Persistent<v8::Object> _persistent;
 	Poco::RemotingNG::EventDispatcher::Ptr _pEventDispatcher;
 	std::set<std::string> _handledEvents;
+	Serializer::BinaryType _binaryType;
 	
 	static Poco::AtomicCounter _counter;
 	static HolderMap _holderMap;
@@ -139,6 +150,9 @@ protected:
 	static void bridgeFunction(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void on(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void toJSON(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+	static const std::string BINARY_TYPE_BUFFER;
+	static const std::string BINARY_TYPE_UINT8ARRAY;
 };
 
 
@@ -165,6 +179,18 @@ inline v8::Persistent<v8::Object>& BridgeHolder::getPersistent()
 }
 
 
+inline void BridgeHolder::setBinaryType(Serializer::BinaryType binaryType)
+{
+	_binaryType = binaryType;
+}
+
+
+inline Serializer::BinaryType BridgeHolder::getBinaryType() const
+{
+	return _binaryType;
+}
+
+
 } } } // namespace Poco::JS::Bridge
 
 
@@ -95,7 +95,17 @@ class JSBridge_API Serializer: public Poco::RemotingNG::Serializer
 	/// This Serializer serializes to a V8 JavaScript object.
 {
 public:
-	Serializer(v8::Isolate* pIsolate);
+	enum BinaryType
+		/// Specifies the type of the JavaScript objects
+		/// binary data (std::vector<char>) is serialized to.
+	{
+		BINARY_BUFFER,
+			/// Serialize binary data to Buffer objects (default).
+		BINARY_UINT8ARRAY
+			/// Serialize binary data to Uint8Array objects.
+	};
+
+	Serializer(v8::Isolate* pIsolate, BinaryType binaryType = BINARY_BUFFER);
 		/// Creates a Serializer.
 
 	~Serializer();
@@ -113,6 +123,10 @@ public:
 		
 	int totalSerialized() const;
 		/// Returns the number of serialized values.
+
+	BinaryType binaryType() const;
+		/// Returns the type of the JavaScript objects
+		/// binary data is serialized to.
 		
 	// Serializer
 	void serializeMessageBegin(const std::string& name, SerializerBase::MessageType type);
@@ -152,6 +166,7 @@ protected:
 	
 private:
 	v8::Isolate* _pIsolate;
+	BinaryType _binaryType;
 	PersistentValueStack<v8::Object> _jsObjectStack;
 	std::vector<int> _jsIndexStack;
 	std::string _messageName;
@@ -189,6 +204,12 @@ inline int Serializer::totalSerialized() const
 }
 
 
+inline Serializer::BinaryType Serializer::binaryType() const
+{
+	return _binaryType;
+}
+
+
 } } } // namespace Poco::JS::Bridge
 
 
@@ -36,8 +36,9 @@ class JSBridge_API TaggedBinaryReader
 	/// by TaggedBinarySerializer.
 {
 public:
-	TaggedBinaryReader(v8::Isolate* pIsolate);
-		/// Creates the TaggedBinaryReader.
+	TaggedBinaryReader(v8::Isolate* pIsolate, Serializer::BinaryType binaryType = Serializer::BINARY_BUFFER);
+		/// Creates the TaggedBinaryReader, using the given binaryType
+		/// for binary data.
 		
 	~TaggedBinaryReader();
 		/// Destroys the TaggedBinaryReader.
@@ -207,11 +207,12 @@ private:
 class EventTask: public Poco::Util::TimerTask
 {
 public:
-	EventTask(Poco::JS::Core::TimedJSExecutor::Ptr pExecutor, v8::Persistent<v8::Object>& jsObject, const std::string& event, const std::string& args):
+	EventTask(Poco::JS::Core::TimedJSExecutor::Ptr pExecutor, v8::Persistent<v8::Object>& jsObject, const std::string& event, const std::string& args, Serializer::BinaryType binaryType):
 		_pExecutor(pExecutor),
 		_jsObject(jsObject),
 		_event(event),
-		_args(args)
+		_args(args),
+		_binaryType(binaryType)
 	{
 	}
 
@@ -231,7 +232,7 @@ public:
 		v8::Context::Scope contextScope(context);
 
 		{
-			TaggedBinaryReader reader(pIsolate);
+			TaggedBinaryReader reader(pIsolate, _binaryType);
 			Poco::MemoryInputStream istr(_args.data(), _args.size());
 			v8::Handle<v8::Value> args[1];
 			args[0] = v8::Local<v8::Object>::New(pIsolate, reader.read(istr));
@@ -244,6 +245,7 @@ private:
 	v8::Persistent<v8::Object>& _jsObject;
 	std::string _event;
 	std::string _args;
+	Serializer::BinaryType _binaryType;
 };
 
 
@@ -259,7 +261,8 @@ Poco::FastMutex BridgeHolder::_holderMapMutex;
 
 BridgeHolder::BridgeHolder(const std::string& uri):
 	_pExecutor(Poco::JS::Core::JSExecutor::current()),
-	_uri(uri)
+	_uri(uri),
+	_binaryType(Serializer::BINARY_BUFFER)
 {
 	_subscriberURI += "jsbridge://local/jsbridge/Bridge/";
 	int id = ++_counter;
@@ -321,7 +324,7 @@ void BridgeHolder::fireEvent(const std::string& event, const std::string& args)
 		Poco::JS::Core::TimedJSExecutor::Ptr pTimedExecutor = _pExecutor.cast<Poco::JS::Core::TimedJSExecutor>();
 		if (pTimedExecutor)
 		{
-			EventTask::Ptr pEventTask = new EventTask(pTimedExecutor, _persistent, event, args);
+			EventTask::Ptr pEventTask = new EventTask(pTimedExecutor, _persistent, event, args, _binaryType);
 			pTimedExecutor->schedule(pEventTask);
 		}
 	}
@@ -424,6 +427,10 @@ bool BridgeHolder::handleEvent(const std::string& event)
 //
 
 
+const std::string BridgeWrapper::BINARY_TYPE_BUFFER("Buffer");
+const std::string BridgeWrapper::BINARY_TYPE_UINT8ARRAY("Uint8Array");
+
+
 BridgeWrapper::BridgeWrapper()
 {
 }
@@ -537,6 +544,12 @@ void BridgeWrapper::getProperty(v8::Local<v8::String> property, const v8::Proper
 			const std::string& uri = pHolder->uri();
 			info.GetReturnValue().Set(v8::String::NewFromUtf8(info.GetIsolate(), uri.c_str(), v8::String::kNormalString, static_cast<int>(uri.size())));
 		}
+		else if (prop == "$binaryType")
+		{
+			BridgeHolder* pHolder = Wrapper::unwrapNative<BridgeHolder>(info);
+			const std::string& binaryType = pHolder->getBinaryType() == Serializer::BINARY_UINT8ARRAY ? BINARY_TYPE_UINT8ARRAY : BINARY_TYPE_BUFFER;
+			info.GetReturnValue().Set(v8::String::NewFromUtf8(info.GetIsolate(), binaryType.c_str(), v8::String::kNormalString, static_cast<int>(binaryType.size())));
+		}
 		else
 		{
 			v8::Local<v8::Function> function = v8::Function::New(info.GetIsolate(), bridgeFunction);
@@ -552,6 +565,28 @@ void BridgeWrapper::getProperty(v8::Local<v8::String> property, const v8::Proper
 
 void BridgeWrapper::setProperty(v8::Local<v8::String> name, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<v8::Value>& info)
 {
+	if (toString(name) == "$binaryType")
+	{
+		BridgeHolder* pHolder = Wrapper::unwrapNative<BridgeHolder>(info);
+		try
+		{
+			poco_check_ptr (pHolder);
+			std::string binaryType = toString(value);
+			if (binaryType == BINARY_TYPE_BUFFER)
+				pHolder->setBinaryType(Serializer::BINARY_BUFFER);
+			else if (binaryType == BINARY_TYPE_UINT8ARRAY)
+				pHolder->setBinaryType(Serializer::BINARY_UINT8ARRAY);
+			else
+				throw Poco::InvalidArgumentException("$binaryType must be \"Buffer\" or \"Uint8Array\"", binaryType);
+			info.GetReturnValue().Set(value);
+		}
+		catch (Poco::Exception& exc)
+		{
+			returnException(info, exc);
+		}
+		return;
+	}
+
 	v8::Local<v8::Object> object = info.Holder();
 	object->ForceSet(info.GetIsolate()->GetCurrentContext(), name, value);
 	if (value->IsFunction())
@@ -606,7 +641,7 @@ void BridgeWrapper::bridgeFunction(const v8::FunctionCallbackInfo<v8::Value>& ar
 			scopedContext.context()->setValue("uri", pHolder->uri());
 
 			Deserializer deserializer(method, Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST, args.GetIsolate(), argsArray);
-			Serializer serializer(args.GetIsolate());
+			Serializer serializer(args.GetIsolate(), pHolder->getBinaryType());
 			ServerTransport transport(deserializer, serializer);
 			Listener listener;
 			if (!Poco::RemotingNG::ORB::instance().invoke(listener, pHolder->uri(), transport))
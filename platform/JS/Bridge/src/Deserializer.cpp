@@ -373,6 +373,20 @@ bool Deserializer::deserialize(const std::string& name, bool /*isMandatory*/, st
 		value.assign(pArgBuffer->begin(), pArgBuffer->end());
 		return true;
 	}
+	else if (jsValue->IsArrayBufferView())
+	{
+		v8::Local<v8::ArrayBufferView> view = jsValue.As<v8::ArrayBufferView>();
+		value.resize(view->ByteLength());
+		if (!value.empty()) view->CopyContents(&value[0], value.size());
+		return true;
+	}
+	else if (jsValue->IsArrayBuffer())
+	{
+		v8::ArrayBuffer::Contents contents = jsValue.As<v8::ArrayBuffer>()->GetContents();
+		const char* pData = static_cast<const char*>(contents.Data());
+		value.assign(pData, pData + contents.ByteLength());
+		return true;
+	}
 	else throw Poco::RemotingNG::DeserializerException("value is not a buffer");
 }
 
@@ -21,8 +21,9 @@ namespace JS {
 namespace Bridge {
 
 
-Serializer::Serializer(v8::Isolate* pIsolate):
+Serializer::Serializer(v8::Isolate* pIsolate, BinaryType binaryType):
 	_pIsolate(pIsolate),
+	_binaryType(binaryType),
 	_jsObjectStack(pIsolate),
 	_pException(0),
 	_totalSerialized(0)
@@ -206,6 +207,14 @@ void Serializer::serialize(const std::string& name, const std::string& value)
 
 void Serializer::serialize(const std::string& name, const std::vector<char>& value)
 {
+	if (_binaryType == BINARY_UINT8ARRAY)
+	{
+		// Copy the data directly into the V8-managed backing store.
+		v8::Local<v8::ArrayBuffer> arrayBuffer = Poco::JS::Core::BufferWrapper::newArrayBuffer(_pIsolate, value.empty() ? 0 : &value[0], value.size());
+		serializeValue(name, v8::Uint8Array::New(arrayBuffer, 0, value.size()));
+		return;
+	}
+
 	Poco::JS::Core::BufferWrapper::Buffer* pBuffer = new Poco::JS::Core::BufferWrapper::Buffer(&value[0], value.size());
 	Poco::JS::Core::BufferWrapper wrapper;
 	v8::Persistent<v8::Object>& bufferObject(wrapper.wrapNativePersistent(_pIsolate, pBuffer));
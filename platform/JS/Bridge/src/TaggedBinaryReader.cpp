@@ -20,8 +20,8 @@ namespace JS {
 namespace Bridge {
 
 
-TaggedBinaryReader::TaggedBinaryReader(v8::Isolate* pIsolate):
-	_serializer(pIsolate)
+TaggedBinaryReader::TaggedBinaryReader(v8::Isolate* pIsolate, Serializer::BinaryType binaryType):
+	_serializer(pIsolate, binaryType)
 {
 	_containerStack.reserve(32);
 }
@@ -48,6 +48,29 @@ public:
 	static void isBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
 		/// Checks whether the given argument is a Buffer.
 
+	static bool appendBinary(Buffer* pBuffer, const v8::Local<v8::Value>& value);
+		/// If value is a JavaScript ArrayBuffer or ArrayBufferView (typed array or
+		/// DataView), appends its contents to the given Buffer with a single
+		/// block copy and returns true. Otherwise, returns false.
+
+	static v8::Local<v8::ArrayBuffer> newArrayBuffer(v8::Isolate* pIsolate, const char* data, std::size_t size);
+		/// Creates a new JavaScript ArrayBuffer containing a copy of the given data.
+
+	static v8::Local<v8::ArrayBuffer> viewArrayBuffer(v8::Isolate* pIsolate, const v8::Local<v8::Object>& bufferObject, std::size_t length);
+		/// Returns a JavaScript ArrayBuffer sharing the first length bytes of
+		/// memory with the Buffer wrapped by bufferObject, without copying.
+		/// The length must not exceed the Buffer's capacity.
+		///
+		/// The ArrayBuffer keeps the Buffer alive. If the Buffer's memory is
+		/// reallocated (e.g., by growing the Buffer), all ArrayBuffers
+		/// obtained from the Buffer are detached (neutered), so that their
+		/// byteLength becomes 0.
+
+	static void detachViews(v8::Isolate* pIsolate, const v8::Local<v8::Object>& bufferObject);
+		/// Detaches all ArrayBuffers obtained from viewArrayBuffer() from
+		/// the Buffer wrapped by bufferObject. Must be called before the
+		/// Buffer's memory is released.
+
 	// Wrapper
 	v8::Handle<v8::ObjectTemplate> objectTemplate(v8::Isolate* pIsolate);
 	
@@ -70,6 +93,10 @@ protected:
 	static void push(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void pop(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void makeString(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void toArrayBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void toUint8Array(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static void fromArrayBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
+	static v8::Local<v8::Private> privateKey(v8::Isolate* pIsolate, const char* name);
 	static std::size_t calculatePackBufferSize(const std::string& format);
 
 	static void encode(Buffer* pBuffer, const v8::Local<v8::Value>& str, const std::string& encoding);
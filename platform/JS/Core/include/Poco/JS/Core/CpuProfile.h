@@ -0,0 +1,143 @@
+//
+// CpuProfile.h
+//
+// Library: JS/Core
+// Package: Execution
+// Module:  CpuProfile
+//
+// Definition of the CpuProfile class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef JS_Core_CpuProfile_INCLUDED
+#define JS_Core_CpuProfile_INCLUDED
+
+
+#include "Poco/JS/Core/Core.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "v8-profiler.h"
+#include <vector>
+#include <ostream>
+
+
+namespace Poco {
+namespace JS {
+namespace Core {
+
+
+class JSCore_API CpuProfile: public Poco::RefCountedObject
+	/// A CpuProfile holds the result of a V8 CPU profiler run
+	/// of a script, in a form that no longer depends on V8.
+	///
+	/// The profile can be written in the format used by the
+	/// Chrome DevTools (.cpuprofile), and as collapsed stacks,
+	/// the input format for flame graph tools.
+{
+public:
+	typedef Poco::AutoPtr<CpuProfile> Ptr;
+
+	struct Node
+	{
+		unsigned id;
+			/// V8 node ID, unique within the profile.
+		int parent;
+			/// Index of the parent node in nodes(), or -1 for the root node.
+		std::string functionName;
+		std::string url;
+		int scriptId;
+		int lineNumber;
+			/// 1-based line number, or 0 if not available.
+		int columnNumber;
+			/// 1-based column number, or 0 if not available.
+		unsigned hitCount;
+			/// Number of samples with this node on top of the stack.
+		std::vector<unsigned> children;
+			/// Node IDs of the child nodes.
+	};
+
+	CpuProfile(const std::string& uri, const v8::CpuProfile& profile);
+		/// Creates the CpuProfile for the script with the given URI
+		/// from the given V8 profile.
+
+	const std::string& uri() const;
+		/// Returns the URI of the profiled script.
+
+	const std::vector<Node>& nodes() const;
+		/// Returns the nodes of the call tree. The root node
+		/// is always the first node.
+
+	Poco::Int64 startTime() const;
+		/// Returns the start time of the profile in microseconds.
+
+	Poco::Int64 endTime() const;
+		/// Returns the end time of the profile in microseconds.
+
+	void writeCpuProfile(std::ostream& ostr) const;
+		/// Writes the profile in the JSON format used by the
+		/// Chrome DevTools (.cpuprofile).
+
+	void writeCollapsedStacks(std::ostream& ostr) const;
+		/// Writes the profile as collapsed stacks, one line per
+		/// distinct stack, consisting of the semicolon-separated
+		/// frames (outermost first), followed by a space and the
+		/// number of samples. This is the input format for
+		/// flamegraph.pl and compatible tools.
+
+protected:
+	~CpuProfile();
+		/// Destroys the CpuProfile.
+
+	void addNode(const v8::CpuProfileNode* pNode, int parent);
+	std::string frameName(const Node& node) const;
+
+private:
+	CpuProfile();
+	CpuProfile(const CpuProfile&);
+	CpuProfile& operator = (const CpuProfile&);
+
+	std::string _uri;
+	std::vector<Node> _nodes;
+	std::vector<unsigned> _samples;
+	std::vector<Poco::Int64> _timestamps;
+	Poco::Int64 _startTime;
+	Poco::Int64 _endTime;
+};
+
+
+//
+// inlines
+//
+inline const std::string& CpuProfile::uri() const
+{
+	return _uri;
+}
+
+
+inline const std::vector<CpuProfile::Node>& CpuProfile::nodes() const
+{
+	return _nodes;
+}
+
+
+inline Poco::Int64 CpuProfile::startTime() const
+{
+	return _startTime;
+}
+
+
+inline Poco::Int64 CpuProfile::endTime() const
+{
+	return _endTime;
+}
+
+
+} } } // namespace Poco::JS::Core
+
+
+#endif // JS_Core_CpuProfile_INCLUDED
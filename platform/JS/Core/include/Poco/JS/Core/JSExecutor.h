@@ -25,14 +25,20 @@
 #include "Poco/SharedPtr.h"
 #include "Poco/URI.h"
 #include "Poco/BasicEvent.h"
+#include "Poco/Clock.h"
+#include "Poco/Mutex.h"
 #include "Poco/Util/Timer.h"
 #include "Poco/Util/TimerTask.h"
 #include "Poco/JS/Core/PooledIsolate.h"
 #include "Poco/JS/Core/ModuleRegistry.h"
 #include "Poco/JS/Core/Module.h"
+#include "Poco/JS/Core/TimerPool.h"
+#include "Poco/JS/Core/ModuleCache.h"
+#include "Poco/JS/Core/CpuProfile.h"
 #include "v8.h"
 #include <vector>
 #include <set>
+#include <deque>
 
 
 namespace Poco {
@@ -50,7 +56,8 @@ public:
 
 	enum 
 	{
-		DEFAULT_MEMORY_LIMIT = 1024*1024
+		DEFAULT_MEMORY_LIMIT = 1024*1024,
+		DEFAULT_SAMPLING_INTERVAL = 1000
 	};
 	
 	struct ErrorInfo
@@ -60,6 +67,52 @@ public:
 		int lineNo;
 	};
 
+	struct Statistics
+		/// Runtime statistics of a JSExecutor.
+		///
+		/// All times are in microseconds, all memory sizes in bytes.
+		/// Script and garbage collection times are CPU times of
+		/// the thread executing the script, timer lag is wall
+		/// clock time.
+	{
+		Statistics();
+
+		std::string uri;
+			/// The script's source URI.
+		Poco::UInt64 callbacks;
+			/// Number of times script code has been entered
+			/// (initial run, timer callbacks, event callbacks, etc.).
+		Poco::UInt64 scriptTime;
+			/// Cumulative CPU time spent executing script code.
+		Poco::UInt64 scriptTimeMax;
+			/// Largest CPU time used by a single execution of script code.
+		Poco::UInt64 timerCallbacks;
+			/// Number of timer callbacks (setTimeout(), setInterval(), etc.) run.
+		Poco::UInt64 timerLagTotal;
+			/// Cumulative delay between the scheduled and actual start
+			/// of timer callbacks.
+		Poco::UInt64 timerLagMax;
+			/// Longest delay between the scheduled and actual start
+			/// of a timer callback.
+		Poco::UInt64 gcCount;
+			/// Number of garbage collection pauses.
+		Poco::UInt64 gcTime;
+			/// Cumulative CPU time spent in garbage collection pauses.
+		Poco::UInt64 gcTimeMax;
+			/// Largest CPU time used by a single garbage collection pause.
+		Poco::UInt64 heapTotal;
+			/// Total size of the V8 heap.
+		Poco::UInt64 heapUsed;
+			/// Used size of the V8 heap.
+		Poco::UInt64 heapLimit;
+			/// Size limit of the V8 heap.
+		Poco::UInt64 mallocedMemory;
+			/// Memory allocated by V8 outside of the heap.
+		bool profiling;
+			/// True if the V8 CPU profiler has been requested
+			/// to start, or is running.
+	};
+
 	Poco::BasicEvent<void> stopped;
 		/// Fired when the executor has been stopped.
 	
@@ -162,6 +215,51 @@ public:
 		///
 		/// Module registries must be added before the script
 		/// is executed.
+
+	Statistics statistics() const;
+		/// Returns the current runtime statistics of the executor.
+		///
+		/// Heap statistics are sampled at most once per second,
+		/// after script code has been executed.
+
+	static void allStatistics(std::vector<Statistics>& statistics);
+		/// Returns the runtime statistics of all currently
+		/// existing JSExecutor instances.
+
+	void startProfiling(int samplingInterval = DEFAULT_SAMPLING_INTERVAL);
+		/// Requests the V8 CPU profiler to be started for the executor's
+		/// isolate, using the given sampling interval in microseconds.
+		///
+		/// As the V8 profiler samples the thread it has been started in,
+		/// the profiler is actually started the next time script code
+		/// is executed, in the thread executing it. Note that this means
+		/// that for executors being called from different threads
+		/// (e.g., servlets), only code running in that thread is sampled.
+		///
+		/// Does nothing if the profiler is already running.
+
+	CpuProfile::Ptr stopProfiling();
+		/// Stops the V8 CPU profiler and returns the recorded profile,
+		/// or null if the profiler has not been started.
+		///
+		/// If the script is currently running in another thread,
+		/// waits until the script releases the isolate.
+
+	bool isProfiling() const;
+		/// Returns true if the V8 CPU profiler has been requested
+		/// to start, or is running.
+
+	static std::size_t startProfiling(const std::string& uri, int samplingInterval);
+		/// Starts the V8 CPU profiler for all currently existing
+		/// JSExecutor instances with the given script URI.
+		/// If the given URI ends with a slash, all executors with
+		/// a script URI starting with the given URI are profiled.
+		/// Returns the number of executors profiled.
+
+	static void stopProfiling(const std::string& uri, std::vector<CpuProfile::Ptr>& profiles);
+		/// Stops the V8 CPU profiler for all currently existing JSExecutor
+		/// instances with the given script URI (or URI prefix, see above)
+		/// and returns the recorded profiles.
 		
 	// Poco::Runnable
 	void run();
@@ -206,19 +304,48 @@ protected:
 	void importModule(const v8::FunctionCallbackInfo<v8::Value>& args, const std::string& uri, Module::Ptr pModule);
 		/// Imports a native module.
 
-	Poco::SharedPtr<std::istream> resolveModule(const std::string& uri, Poco::URI& resolvedURI);
+	CachedModule::Ptr resolveModule(const std::string& uri, Poco::URI& resolvedURI);
 		/// Tries to locate the script identified by uri (which may be a relative, partial URI),
-		/// and returns a stream for reading the script source if the module has not been
-		/// imported yet, or null if the module has already been imported.
+		/// and returns the module (from the ModuleCache, or loaded from the resolved URI)
+		/// if the module has not been imported yet, or null if the module has already been imported.
 		/// If the module URI has been successfully resolved, resolvedURI will contain
 		/// the fully-qualified URI. If the module URI cannot be successfully resolved,
 		/// a Poco::NotFoundException will be thrown.
 
+	CachedModule::Ptr loadModule(const Poco::URI& uri);
+		/// Loads the module with the given fully-qualified URI, using the
+		/// default ModuleCache if moduleCacheTag() returns a non-empty tag for the URI.
+		/// Throws an exception if the module cannot be opened.
+
+	virtual std::string moduleCacheTag(const Poco::URI& uri);
+		/// Returns the tag used to identify the current version of the module
+		/// with the given fully-qualified URI in the ModuleCache. The tag must
+		/// change whenever the module's source code may have changed.
+		/// An empty tag means that the module must not be cached.
+		///
+		/// The default implementation returns the modification time and
+		/// size of the file for "file" URIs, and an empty string otherwise.
+		/// Can be overridden by subclasses supporting other URI schemes.
+
+	void compileModule(CachedModule& module, v8::Local<v8::String> source, v8::ScriptOrigin& origin, v8::Local<v8::Script>& script);
+		/// Compiles the given module source, consuming or producing
+		/// V8 code cache data stored in the given CachedModule.
+
 	void attachToCurrentThread();
 		/// Attaches the JSExecutor to the current thread. Must be called before
 		/// any JavaScript code is executed if the JSExecutor is invoked
 		/// from a different thread it was created in.
 
+	void recordTimerLag(Poco::Clock::ClockDiff lag);
+		/// Adds the delay between the scheduled and actual start
+		/// of a timer callback to the executor's statistics.
+
+	void enterScript();
+	void leaveScript();
+	static void onGCPrologue(v8::Isolate* pIsolate, v8::GCType type, v8::GCCallbackFlags flags, void* data);
+	static void onGCEpilogue(v8::Isolate* pIsolate, v8::GCType type, v8::GCCallbackFlags flags, void* data);
+	void startProfilerImpl();
+
 	void runImpl();
 	void setup();
 	void cleanup();
@@ -247,9 +374,27 @@ protected:
 	std::set<std::string> _imports;
 	Poco::AtomicCounter _running;
 	static Poco::ThreadLocal<JSExecutor*> _pCurrentExecutor;
+
+private:
+	class Handle;
+
+	static void findHandles(const std::string& uri, std::vector<Poco::AutoPtr<Handle> >& handles);
+
+	Statistics _statistics;
+	int _scriptDepth;
+	Poco::UInt64 _scriptStart;
+	Poco::UInt64 _gcStart;
+	Poco::Clock _heapSampled;
+	mutable Poco::FastMutex _statisticsMutex;
+	Poco::AtomicCounter _samplingInterval;
+	v8::CpuProfiler* _pProfiler;
+	Poco::AutoPtr<Handle> _pHandle;
+	static std::set<JSExecutor*> _executors;
+	static Poco::FastMutex _executorsMutex;
 	
 	friend class RunScriptTask;
 	friend class CallFunctionTask;
+	friend class ScopedScriptStatistics;
 };
 
 
@@ -259,12 +404,22 @@ class JSCore_API TimedJSExecutor: public JSExecutor
 	///
 	/// Scripts can use the setTimeout() and setInterval() JavaScript functions to
 	/// define timer-based callbacks.
+	///
+	/// By default, every TimedJSExecutor has its own timer and thus its own thread.
+	/// Alternatively, a TimedJSExecutor can be bound to one of the timers of a
+	/// shared TimerPool. In this case, timer events first put the corresponding
+	/// task into the executor's run queue, which is then processed in turns
+	/// of at most TimerPool::taskBudget() tasks.
 {
 public:
 	typedef Poco::AutoPtr<TimedJSExecutor> Ptr;
 
 	TimedJSExecutor(const std::string& source, const Poco::URI& sourceURI, const std::vector<std::string>& moduleSearchPaths, Poco::UInt64 memoryLimit = JSExecutor::DEFAULT_MEMORY_LIMIT);
-		/// Creates the TimedJSExecutor.
+		/// Creates the TimedJSExecutor, using its own timer.
+
+	TimedJSExecutor(const std::string& source, const Poco::URI& sourceURI, const std::vector<std::string>& moduleSearchPaths, TimerPool::Ptr pTimerPool, Poco::UInt64 memoryLimit = JSExecutor::DEFAULT_MEMORY_LIMIT);
+		/// Creates the TimedJSExecutor, using a timer from the given TimerPool.
+		/// If pTimerPool is null, the TimedJSExecutor uses its own timer.
 		
 	~TimedJSExecutor();
 		/// Destroys the TimedJSExecutor.
@@ -274,6 +429,10 @@ public:
 			
 	void schedule(Poco::Util::TimerTask::Ptr pTask, const Poco::Clock& clock);
 		/// Schedules a task using the timer-based event loop.
+
+	TimerPool::Ptr timerPool() const;
+		/// Returns the TimerPool the executor's timer has been taken from,
+		/// or null if the executor uses its own timer.
 	
 	// JSExecutor
 	void run();
@@ -282,25 +441,49 @@ public:
 
 	void stop();
 		/// Stops the executor and cancels all timer events.
+		///
+		/// If called from a thread of the executor's TimerPool (e.g., from
+		/// another script), stop() does not wait for a currently running script
+		/// to terminate. In this case, the stopped event is fired
+		/// later in the executor's timer thread.
 	
 protected:
 	Poco::Util::Timer& timer();	
 		/// Returns the executor's timer.
+		///
+		/// Note that if the executor uses a timer from a TimerPool,
+		/// the timer is shared with other executors. Tasks should
+		/// therefore always be scheduled using schedule().
 
 	void setupGlobalObjectTemplate(v8::Local<v8::ObjectTemplate>& global, v8::Isolate* pIsolate);
 	static void setImmediate(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void setTimeout(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void setInterval(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void cancelTimer(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+	void scheduleImpl(Poco::Util::TimerTask::Ptr pTask, const Poco::Clock& clock);
+	void scheduleAtFixedRateImpl(Poco::Util::TimerTask::Ptr pTask, long delay, long interval);
+	void enqueueReady(Poco::Util::TimerTask::Ptr pTask);
+	void dispatchReady();
+	void releasePooledTask(Poco::Util::TimerTask* pTask);
+	void cancelPooledTasks();
+	bool markStopped();
 	
 private:
-	Poco::Util::Timer _timer;
+	TimerPool::Ptr _pTimerPool;
+	Poco::Util::Timer* _pTimer;
 	bool _stopped;
+	std::deque<Poco::Util::TimerTask::Ptr> _readyQueue;
+	std::set<Poco::Util::TimerTask::Ptr> _pooledTasks;
+	bool _dispatchScheduled;
 	Poco::FastMutex _mutex;
 	
 	friend class RunScriptTask;
 	friend class StopScriptTask;
+	friend class CompleteStopTask;
 	friend class CallFunctionTask;
+	friend class ReadyTask;
+	friend class DispatchReadyTask;
 };
 
 
@@ -337,9 +520,21 @@ inline bool JSExecutor::isRunning() const
 }
 
 
+inline bool JSExecutor::isProfiling() const
+{
+	return _samplingInterval.value() > 0;
+}
+
+
 inline Poco::Util::Timer& TimedJSExecutor::timer()
 {
-	return _timer;
+	return *_pTimer;
+}
+
+
+inline TimerPool::Ptr TimedJSExecutor::timerPool() const
+{
+	return _pTimerPool;
 }
 
 
@@ -0,0 +1,130 @@
+//
+// ModuleCache.h
+//
+// Library: JS/Core
+// Package: Execution
+// Module:  ModuleCache
+//
+// Definition of the ModuleCache class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef JS_Core_ModuleCache_INCLUDED
+#define JS_Core_ModuleCache_INCLUDED
+
+
+#include "Poco/JS/Core/Core.h"
+#include "Poco/LRUCache.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
+
+
+namespace Poco {
+namespace JS {
+namespace Core {
+
+
+class JSCore_API CachedModule
+	/// CachedModule holds the source code of a JavaScript module,
+	/// together with the V8 code cache data produced when the
+	/// module has been compiled for the first time.
+{
+public:
+	typedef Poco::SharedPtr<CachedModule> Ptr;
+
+	explicit CachedModule(const std::string& source);
+		/// Creates the CachedModule with the given source code.
+
+	~CachedModule();
+		/// Destroys the CachedModule.
+
+	const std::string& source() const;
+		/// Returns the module's source code.
+
+	std::string codeCache() const;
+		/// Returns a copy of the V8 code cache data, or an
+		/// empty string if no code cache data is available.
+
+	void setCodeCache(const char* data, std::size_t size);
+		/// Sets the V8 code cache data.
+
+	void clearCodeCache();
+		/// Discards the V8 code cache data, e.g. after
+		/// it has been rejected by V8.
+
+private:
+	CachedModule();
+	CachedModule(const CachedModule&);
+	CachedModule& operator = (const CachedModule&);
+
+	std::string _source;
+	std::string _codeCache;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+class JSCore_API ModuleCache
+	/// ModuleCache is a process-wide cache for JavaScript modules
+	/// imported with require(), shared by all JSExecutor instances.
+	///
+	/// Modules are identified by their fully resolved URI and a tag,
+	/// which must change whenever the module source may have changed
+	/// (e.g., a bundle version or a file modification time).
+	///
+	/// Besides the source code, the cache keeps the V8 code cache data
+	/// produced by the first compilation of a module, so that subsequent
+	/// imports of the same module in other executors can skip parsing.
+{
+public:
+	enum
+	{
+		DEFAULT_CAPACITY = 256
+	};
+
+	explicit ModuleCache(long capacity = DEFAULT_CAPACITY);
+		/// Creates the ModuleCache, holding at most capacity modules.
+
+	~ModuleCache();
+		/// Destroys the ModuleCache.
+
+	CachedModule::Ptr find(const std::string& uri, const std::string& tag);
+		/// Returns the cached module for the given URI and tag,
+		/// or null if the module is not in the cache.
+
+	void add(const std::string& uri, const std::string& tag, CachedModule::Ptr pModule);
+		/// Adds the given module to the cache.
+
+	void clear();
+		/// Removes all modules from the cache.
+
+	static ModuleCache& defaultCache();
+		/// Returns the process-wide default ModuleCache.
+
+private:
+	ModuleCache(const ModuleCache&);
+	ModuleCache& operator = (const ModuleCache&);
+
+	static std::string makeKey(const std::string& uri, const std::string& tag);
+
+	Poco::LRUCache<std::string, CachedModule> _cache;
+};
+
+
+//
+// inlines
+//
+inline const std::string& CachedModule::source() const
+{
+	return _source;
+}
+
+
+} } } // namespace Poco::JS::Core
+
+
+#endif // JS_Core_ModuleCache_INCLUDED
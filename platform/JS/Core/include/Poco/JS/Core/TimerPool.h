@@ -0,0 +1,125 @@
+//
+// TimerPool.h
+//
+// Library: JS/Core
+// Package: Execution
+// Module:  TimerPool
+//
+// Definition of the TimerPool class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef JS_Core_TimerPool_INCLUDED
+#define JS_Core_TimerPool_INCLUDED
+
+
+#include "Poco/JS/Core/Core.h"
+#include "Poco/Util/Timer.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
+#include "Poco/Thread.h"
+#include <vector>
+
+
+namespace Poco {
+namespace JS {
+namespace Core {
+
+
+class JSCore_API TimerPool: public Poco::RefCountedObject
+	/// A fixed-size pool of Poco::Util::Timer objects (each one
+	/// having its own thread) that is shared by many TimedJSExecutor
+	/// instances.
+	///
+	/// Without a TimerPool, every TimedJSExecutor runs its own
+	/// timer thread. With a TimerPool, M executors are multiplexed
+	/// over the N threads of the pool. Each executor is bound to
+	/// the least loaded timer at construction time, so all script
+	/// code of a single executor still runs in one thread.
+	///
+	/// To prevent a busy executor from starving others sharing the same
+	/// thread, each executor only runs up to taskBudget() ready tasks
+	/// in one turn before giving up the thread to the next executor.
+{
+public:
+	typedef Poco::AutoPtr<TimerPool> Ptr;
+
+	enum
+	{
+		DEFAULT_TASK_BUDGET = 16
+	};
+
+	explicit TimerPool(std::size_t size, std::size_t taskBudget = DEFAULT_TASK_BUDGET);
+		/// Creates the TimerPool with the given number of timers (threads)
+		/// and the given per-executor task budget.
+
+	~TimerPool();
+		/// Destroys the TimerPool.
+
+	Poco::Util::Timer& acquireTimer();
+		/// Returns the timer with the least number of executors bound to it
+		/// and increments its usage count.
+
+	void releaseTimer(Poco::Util::Timer& timer);
+		/// Decrements the usage count of the given timer, which must
+		/// have been obtained by a call to acquireTimer().
+
+	std::size_t size() const;
+		/// Returns the number of timers (threads) in the pool.
+
+	std::size_t used() const;
+		/// Returns the total number of executors currently bound to
+		/// timers in the pool.
+
+	std::size_t taskBudget() const;
+		/// Returns the maximum number of ready tasks an executor
+		/// runs in one turn.
+
+	bool isTimerThread() const;
+		/// Returns true if the calling thread is the thread of
+		/// one of the pool's timers.
+
+private:
+	TimerPool();
+	TimerPool(const TimerPool&);
+	TimerPool& operator = (const TimerPool&);
+
+	struct PooledTimer
+	{
+		Poco::SharedPtr<Poco::Util::Timer> pTimer;
+		std::size_t usage;
+		Poco::Thread::TID tid;
+	};
+
+	std::vector<PooledTimer> _timers;
+	std::size_t _taskBudget;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline std::size_t TimerPool::size() const
+{
+	return _timers.size();
+}
+
+
+inline std::size_t TimerPool::taskBudget() const
+{
+	return _taskBudget;
+}
+
+
+} } } // namespace Poco::JS::Core
+
+
+#endif // JS_Core_TimerPool_INCLUDED
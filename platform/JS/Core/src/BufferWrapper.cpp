@@ -30,6 +30,8 @@
 #include "Poco/Format.h"
 #include <sstream>
 #include <cstdlib>
+#include <cstring>
+#include <vector>
 
 
 namespace Poco {
@@ -37,6 +39,39 @@ namespace JS {
 namespace Core {
 
 
+namespace
+{
+	class ReallocationGuard
+		/// Detaches the ArrayBuffer views of a Buffer if the
+		/// Buffer's memory has been reallocated while the
+		/// guard was active.
+	{
+	public:
+		ReallocationGuard(v8::Isolate* pIsolate, const v8::Local<v8::Object>& bufferObject, BufferWrapper::Buffer* pBuffer):
+			_pIsolate(pIsolate),
+			_bufferObject(bufferObject),
+			_pBuffer(pBuffer),
+			_pMemory(pBuffer->begin())
+		{
+		}
+
+		~ReallocationGuard()
+		{
+			if (_pBuffer->begin() != _pMemory)
+			{
+				BufferWrapper::detachViews(_pIsolate, _bufferObject);
+			}
+		}
+
+	private:
+		v8::Isolate* _pIsolate;
+		v8::Local<v8::Object> _bufferObject;
+		BufferWrapper::Buffer* _pBuffer;
+		const char* _pMemory;
+	};
+}
+
+
 const std::string BufferWrapper::ENCODING_UTF8("UTF-8");
 const std::string BufferWrapper::ENCODING_UTF16("UTF-16");
 const std::string BufferWrapper::ENCODING_ASCII("ASCII");
@@ -58,6 +93,7 @@ v8::Handle<v8::FunctionTemplate> BufferWrapper::constructor(v8::Isolate* pIsolat
 	v8::EscapableHandleScope handleScope(pIsolate);
 	v8::Local<v8::FunctionTemplate> funcTemplate = v8::FunctionTemplate::New(pIsolate, construct);
 	funcTemplate->Set(v8::String::NewFromUtf8(pIsolate, "isBuffer"), v8::FunctionTemplate::New(pIsolate, isBuffer));
+	funcTemplate->Set(v8::String::NewFromUtf8(pIsolate, "fromArrayBuffer"), v8::FunctionTemplate::New(pIsolate, fromArrayBuffer));
 	funcTemplate->Set(v8::String::NewFromUtf8(pIsolate, "UTF8"), v8::String::NewFromUtf8(pIsolate, ENCODING_UTF8.c_str()));
 	funcTemplate->Set(v8::String::NewFromUtf8(pIsolate, "UTF16"), v8::String::NewFromUtf8(pIsolate, ENCODING_UTF16.c_str()));
 	funcTemplate->Set(v8::String::NewFromUtf8(pIsolate, "ASCII"), v8::String::NewFromUtf8(pIsolate, ENCODING_ASCII.c_str()));
@@ -91,6 +127,8 @@ v8::Handle<v8::ObjectTemplate> BufferWrapper::objectTemplate(v8::Isolate* pIsola
 		objectTemplate->Set(v8::String::NewFromUtf8(pIsolate, "slice"), v8::FunctionTemplate::New(pIsolate, slice));
 		objectTemplate->Set(v8::String::NewFromUtf8(pIsolate, "push"), v8::FunctionTemplate::New(pIsolate, push));
 		objectTemplate->Set(v8::String::NewFromUtf8(pIsolate, "pop"), v8::FunctionTemplate::New(pIsolate, pop));
+		objectTemplate->Set(v8::String::NewFromUtf8(pIsolate, "toArrayBuffer"), v8::FunctionTemplate::New(pIsolate, toArrayBuffer));
+		objectTemplate->Set(v8::String::NewFromUtf8(pIsolate, "toUint8Array"), v8::FunctionTemplate::New(pIsolate, toUint8Array));
 		pooledObjectTemplate.Reset(pIsolate, objectTemplate);
 	}
 	v8::Local<v8::ObjectTemplate> bufferTemplate = v8::Local<v8::ObjectTemplate>::New(pIsolate, pooledObjectTemplate);
@@ -134,6 +172,11 @@ void BufferWrapper::construct(const v8::FunctionCallbackInfo<v8::Value>& args)
 					}
 				}
 			}
+			else if (args[0]->IsArrayBuffer() || args[0]->IsArrayBufferView())
+			{
+				pBuffer = new Buffer(0);
+				appendBinary(pBuffer, args[0]);
+			}
 			else if (args[0]->IsObject())
 			{
 				if (Wrapper::isWrapper<Buffer>(args.GetIsolate(), args[0]))
@@ -212,6 +255,147 @@ void BufferWrapper::isBuffer(const v8::FunctionCallbackInfo<v8::Value>& args)
 }
 
 
+bool BufferWrapper::appendBinary(Buffer* pBuffer, const v8::Local<v8::Value>& value)
+{
+	if (value->IsArrayBufferView())
+	{
+		v8::Local<v8::ArrayBufferView> view = value.As<v8::ArrayBufferView>();
+		std::size_t size = view->ByteLength();
+		if (size > 0)
+		{
+			std::size_t offset = pBuffer->size();
+			if (view->HasBuffer() && view->Buffer()->IsExternal())
+			{
+				// The view may share memory with pBuffer, which
+				// can be reallocated by resize().
+				std::vector<char> data(size);
+				view->CopyContents(&data[0], size);
+				pBuffer->append(&data[0], size);
+			}
+			else
+			{
+				pBuffer->resize(offset + size);
+				view->CopyContents(pBuffer->begin() + offset, size);
+			}
+		}
+		return true;
+	}
+	else if (value->IsArrayBuffer())
+	{
+		v8::Local<v8::ArrayBuffer> arrayBuffer = value.As<v8::ArrayBuffer>();
+		v8::ArrayBuffer::Contents contents = arrayBuffer->GetContents();
+		if (contents.ByteLength() > 0)
+		{
+			const char* pData = static_cast<const char*>(contents.Data());
+			if (arrayBuffer->IsExternal())
+			{
+				std::vector<char> data(pData, pData + contents.ByteLength());
+				pBuffer->append(&data[0], data.size());
+			}
+			else
+			{
+				pBuffer->append(pData, contents.ByteLength());
+			}
+		}
+		return true;
+	}
+	else return false;
+}
+
+
+v8::Local<v8::ArrayBuffer> BufferWrapper::newArrayBuffer(v8::Isolate* pIsolate, const char* data, std::size_t size)
+{
+	v8::EscapableHandleScope handleScope(pIsolate);
+
+	v8::Local<v8::ArrayBuffer> arrayBuffer = v8::ArrayBuffer::New(pIsolate, size);
+	if (size > 0)
+	{
+		std::memcpy(arrayBuffer->GetContents().Data(), data, size);
+	}
+	return handleScope.Escape(arrayBuffer);
+}
+
+
+v8::Local<v8::ArrayBuffer> BufferWrapper::viewArrayBuffer(v8::Isolate* pIsolate, const v8::Local<v8::Object>& bufferObject, std::size_t length)
+{
+	v8::EscapableHandleScope handleScope(pIsolate);
+
+	Buffer* pBuffer = Wrapper::unwrapNativeObject<Buffer>(bufferObject);
+	poco_check_ptr (pBuffer);
+	poco_assert (length <= pBuffer->capacity());
+
+	if (length == 0)
+	{
+		return handleScope.Escape(v8::ArrayBuffer::New(pIsolate, 0));
+	}
+
+	v8::Local<v8::Context> context = pIsolate->GetCurrentContext();
+	v8::Local<v8::Private> viewsKey = privateKey(pIsolate, "Poco::Buffer::views");
+	v8::Local<v8::Array> views;
+	v8::MaybeLocal<v8::Value> maybeViews = bufferObject->GetPrivate(context, viewsKey);
+	if (!maybeViews.IsEmpty() && maybeViews.ToLocalChecked()->IsArray())
+	{
+		views = maybeViews.ToLocalChecked().As<v8::Array>();
+
+		// Reuse an existing view of the same memory, if there is one.
+		for (uint32_t i = 0; i < views->Length(); i++)
+		{
+			v8::Local<v8::Value> view = views->Get(i);
+			if (view->IsArrayBuffer())
+			{
+				v8::Local<v8::ArrayBuffer> arrayBuffer = view.As<v8::ArrayBuffer>();
+				v8::ArrayBuffer::Contents contents = arrayBuffer->GetContents();
+				if (contents.Data() == pBuffer->begin() && contents.ByteLength() == length)
+				{
+					return handleScope.Escape(arrayBuffer);
+				}
+			}
+		}
+	}
+	else
+	{
+		views = v8::Array::New(pIsolate);
+		bufferObject->SetPrivate(context, viewsKey, views);
+	}
+
+	// The memory is owned by the Buffer, which the ArrayBuffer keeps alive.
+	v8::Local<v8::ArrayBuffer> arrayBuffer = v8::ArrayBuffer::New(pIsolate, pBuffer->begin(), length, v8::ArrayBufferCreationMode::kExternalized);
+	arrayBuffer->SetPrivate(context, privateKey(pIsolate, "Poco::Buffer::owner"), bufferObject);
+	views->Set(views->Length(), arrayBuffer);
+	return handleScope.Escape(arrayBuffer);
+}
+
+
+void BufferWrapper::detachViews(v8::Isolate* pIsolate, const v8::Local<v8::Object>& bufferObject)
+{
+	v8::HandleScope handleScope(pIsolate);
+
+	v8::Local<v8::Context> context = pIsolate->GetCurrentContext();
+	v8::Local<v8::Private> viewsKey = privateKey(pIsolate, "Poco::Buffer::views");
+	v8::MaybeLocal<v8::Value> maybeViews = bufferObject->GetPrivate(context, viewsKey);
+	if (!maybeViews.IsEmpty() && maybeViews.ToLocalChecked()->IsArray())
+	{
+		v8::Local<v8::Array> views = maybeViews.ToLocalChecked().As<v8::Array>();
+		for (uint32_t i = 0; i < views->Length(); i++)
+		{
+			v8::Local<v8::Value> view = views->Get(i);
+			if (view->IsArrayBuffer())
+			{
+				v8::Local<v8::ArrayBuffer> arrayBuffer = view.As<v8::ArrayBuffer>();
+				if (arrayBuffer->IsNeuterable()) arrayBuffer->Neuter();
+			}
+		}
+		bufferObject->DeletePrivate(context, viewsKey);
+	}
+}
+
+
+v8::Local<v8::Private> BufferWrapper::privateKey(v8::Isolate* pIsolate, const char* name)
+{
+	return v8::Private::ForApi(pIsolate, v8::String::NewFromUtf8(pIsolate, name));
+}
+
+
 void BufferWrapper::getLength(v8::Local<v8::String> name, const v8::PropertyCallbackInfo<v8::Value>& info)
 {
 	Buffer* pBuffer = Wrapper::unwrapNative<Buffer>(info);
@@ -225,6 +409,7 @@ void BufferWrapper::setLength(v8::Local<v8::String> name, v8::Local<v8::Value> v
 	Poco::UInt32 size = value->Uint32Value();
 	try
 	{
+		ReallocationGuard guard(info.GetIsolate(), info.Holder(), pBuffer);
 		pBuffer->resize(size);
 	}
 	catch (Poco::Exception& exc)
@@ -251,6 +436,7 @@ void BufferWrapper::setCapacity(v8::Local<v8::String> name, v8::Local<v8::Value>
 	Poco::UInt32 size = value->Uint32Value();
 	try
 	{
+		ReallocationGuard guard(info.GetIsolate(), info.Holder(), pBuffer);
 		pBuffer->setCapacity(size);
 	}
 	catch (Poco::Exception& exc)
@@ -326,6 +512,7 @@ void BufferWrapper::fromBase64(const v8::FunctionCallbackInfo<v8::Value>& args)
 			std::string base64String = toString(args[0]);
 			int size = static_cast<int>(base64String.size());
 			int decodedSize = 3*size/4 + 16;
+			ReallocationGuard guard(args.GetIsolate(), args.Holder(), pBuffer);
 			pBuffer->resize(decodedSize, false);
 			Poco::MemoryInputStream istr(base64String.data(), static_cast<std::streamsize>(size));
 			Poco::MemoryOutputStream ostr(pBuffer->begin(), pBuffer->size());
@@ -381,6 +568,7 @@ void BufferWrapper::encodeString(const v8::FunctionCallbackInfo<v8::Value>& args
 		else
 			encoding = ENCODING_UTF8;
 
+		ReallocationGuard guard(args.GetIsolate(), args.Holder(), pBuffer);
 		encode(pBuffer, args[0], encoding);
 	}
 	catch (Poco::Exception& exc)
@@ -406,6 +594,7 @@ void BufferWrapper::pack(const v8::FunctionCallbackInfo<v8::Value>& args)
 		v8::Local<v8::Array> array = v8::Local<v8::Array>::Cast(args[1]);
 		std::string format(toString(args[0]));
 		std::size_t size = calculatePackBufferSize(format);
+		ReallocationGuard guard(args.GetIsolate(), args.Holder(), pBuffer);
 		pBuffer->resize(size, false);
 		Poco::BinaryWriter::StreamByteOrder byteOrder = Poco::BinaryWriter::NATIVE_BYTE_ORDER;
 		std::string::const_iterator it = format.begin();
@@ -880,6 +1069,7 @@ void BufferWrapper::concat(const v8::FunctionCallbackInfo<v8::Value>& args)
 	Buffer* pBuffer = Wrapper::unwrapNative<Buffer>(args);
 	try
 	{
+		ReallocationGuard guard(args.GetIsolate(), args.Holder(), pBuffer);
 		for (int i = 0; i < args.Length(); i++)
 		{
 			if (Wrapper::isWrapper<Buffer>(args.GetIsolate(), args[i]))
@@ -887,11 +1077,92 @@ void BufferWrapper::concat(const v8::FunctionCallbackInfo<v8::Value>& args)
 				Buffer* pArgBuffer = Wrapper::unwrapNativeObject<Buffer>(args[i]);
 				pBuffer->append(pArgBuffer->begin(), pArgBuffer->size());
 			}
-			else throw Poco::InvalidArgumentException("Attempt to concat something that's not a Buffer");
+			else if (!appendBinary(pBuffer, args[i]))
+			{
+				throw Poco::InvalidArgumentException("Attempt to concat something that's not a Buffer, ArrayBuffer or typed array");
+			}
+		}
+	}
+	catch (Poco::Exception& exc)
+	{
+		returnException(args, exc);
+	}
+	catch (std::exception&)
+	{
+		returnException(args, std::string("Out of memory"));
+	}
+}
+
+
+void BufferWrapper::toArrayBuffer(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	Buffer* pBuffer = Wrapper::unwrapNative<Buffer>(args);
+	args.GetReturnValue().Set(viewArrayBuffer(args.GetIsolate(), args.Holder(), pBuffer->size()));
+}
+
+
+void BufferWrapper::toUint8Array(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	Buffer* pBuffer = Wrapper::unwrapNative<Buffer>(args);
+
+	// The view covers the whole capacity, so that all typed arrays
+	// obtained from the Buffer until it is reallocated share
+	// a single ArrayBuffer.
+	v8::Local<v8::ArrayBuffer> arrayBuffer = viewArrayBuffer(args.GetIsolate(), args.Holder(), pBuffer->capacity());
+	args.GetReturnValue().Set(v8::Uint8Array::New(arrayBuffer, 0, pBuffer->size()));
+}
+
+
+void BufferWrapper::fromArrayBuffer(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+	Buffer* pBuffer = 0;
+	try
+	{
+		v8::Local<v8::ArrayBuffer> arrayBuffer;
+		std::size_t offset = 0;
+		std::size_t length = 0;
+		if (args.Length() > 0 && args[0]->IsArrayBufferView())
+		{
+			v8::Local<v8::ArrayBufferView> view = args[0].As<v8::ArrayBufferView>();
+			// Buffer() moves the contents of small typed arrays
+			// out of the V8 heap, so they won't be moved by the GC.
+			arrayBuffer = view->Buffer();
+			offset = view->ByteOffset();
+			length = view->ByteLength();
+		}
+		else if (args.Length() > 0 && args[0]->IsArrayBuffer())
+		{
+			arrayBuffer = args[0].As<v8::ArrayBuffer>();
+			length = arrayBuffer->ByteLength();
+		}
+		else throw Poco::InvalidArgumentException("Buffer.fromArrayBuffer() requires an ArrayBuffer or typed array");
+
+		bool share = length > 0 && !arrayBuffer->IsExternal();
+		char* pData = static_cast<char*>(arrayBuffer->GetContents().Data()) + offset;
+		if (share)
+		{
+			// Memory of an internal ArrayBuffer is released by V8 only after
+			// the ArrayBuffer has been garbage-collected, which the Buffer prevents.
+			pBuffer = new Buffer(pData, length);
 		}
+		else
+		{
+			// Memory of an external ArrayBuffer (e.g., a view of another
+			// Buffer) may be released at any time, so it must be copied.
+			pBuffer = new Buffer(static_cast<const char*>(pData), length);
+		}
+		BufferWrapper wrapper;
+		v8::Persistent<v8::Object>& bufferObject(wrapper.wrapNativePersistent(args.GetIsolate(), pBuffer));
+		v8::Local<v8::Object> localBufferObject = v8::Local<v8::Object>::New(args.GetIsolate(), bufferObject);
+		if (share)
+		{
+			localBufferObject->SetPrivate(args.GetIsolate()->GetCurrentContext(), privateKey(args.GetIsolate(), "Poco::Buffer::arrayBuffer"), arrayBuffer);
+		}
+		args.GetReturnValue().Set(localBufferObject);
 	}
 	catch (Poco::Exception& exc)
 	{
+		delete pBuffer;
 		returnException(args, exc);
 	}
 	catch (std::exception&)
@@ -964,6 +1235,7 @@ void BufferWrapper::push(const v8::FunctionCallbackInfo<v8::Value>& args)
 		{
 			if (args[0]->IsNumber())
 			{
+				ReallocationGuard guard(args.GetIsolate(), args.Holder(), pBuffer);
 				pBuffer->append(static_cast<char>(args[0]->Uint32Value()));
 			}
 			else throw Poco::InvalidArgumentException("Push to a Buffer requires a byte value");
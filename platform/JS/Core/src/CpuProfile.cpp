@@ -0,0 +1,164 @@
+//
+// CpuProfile.cpp
+//
+// Library: JS/Core
+// Package: Execution
+// Module:  CpuProfile
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/JS/Core/CpuProfile.h"
+#include "Poco/UTF8String.h"
+#include "Poco/NumberFormatter.h"
+
+
+namespace Poco {
+namespace JS {
+namespace Core {
+
+
+CpuProfile::CpuProfile(const std::string& uri, const v8::CpuProfile& profile):
+	_uri(uri),
+	_startTime(profile.GetStartTime()),
+	_endTime(profile.GetEndTime())
+{
+	addNode(profile.GetTopDownRoot(), -1);
+
+	int samplesCount = profile.GetSamplesCount();
+	_samples.reserve(samplesCount);
+	_timestamps.reserve(samplesCount);
+	for (int i = 0; i < samplesCount; i++)
+	{
+		_samples.push_back(profile.GetSample(i)->GetNodeId());
+		_timestamps.push_back(profile.GetSampleTimestamp(i));
+	}
+}
+
+
+CpuProfile::~CpuProfile()
+{
+}
+
+
+void CpuProfile::addNode(const v8::CpuProfileNode* pNode, int parent)
+{
+	int index = static_cast<int>(_nodes.size());
+	_nodes.push_back(Node());
+	Node& node = _nodes.back();
+	node.id = pNode->GetNodeId();
+	node.parent = parent;
+	node.functionName = pNode->GetFunctionNameStr();
+	node.url = pNode->GetScriptResourceNameStr();
+	node.scriptId = pNode->GetScriptId();
+	node.lineNumber = pNode->GetLineNumber();
+	node.columnNumber = pNode->GetColumnNumber();
+	node.hitCount = pNode->GetHitCount();
+
+	int childrenCount = pNode->GetChildrenCount();
+	for (int i = 0; i < childrenCount; i++)
+	{
+		const v8::CpuProfileNode* pChild = pNode->GetChild(i);
+		_nodes[index].children.push_back(pChild->GetNodeId());
+		addNode(pChild, index);
+	}
+}
+
+
+void CpuProfile::writeCpuProfile(std::ostream& ostr) const
+{
+	// The Chrome DevTools format uses 0-based line and column numbers.
+	ostr << "{\"nodes\":[";
+	for (std::vector<Node>::const_iterator it = _nodes.begin(); it != _nodes.end(); ++it)
+	{
+		if (it != _nodes.begin()) ostr << ",";
+		ostr
+			<< "{\"id\":" << it->id
+			<< ",\"callFrame\":{"
+			<< "\"functionName\":\"" << Poco::UTF8::escape(it->functionName) << "\""
+			<< ",\"scriptId\":\"" << it->scriptId << "\""
+			<< ",\"url\":\"" << Poco::UTF8::escape(it->url) << "\""
+			<< ",\"lineNumber\":" << it->lineNumber - 1
+			<< ",\"columnNumber\":" << it->columnNumber - 1
+			<< "},\"hitCount\":" << it->hitCount
+			<< ",\"children\":[";
+		for (std::vector<unsigned>::const_iterator itc = it->children.begin(); itc != it->children.end(); ++itc)
+		{
+			if (itc != it->children.begin()) ostr << ",";
+			ostr << *itc;
+		}
+		ostr << "]}";
+	}
+	ostr << "],\"startTime\":" << _startTime << ",\"endTime\":" << _endTime << ",\"samples\":[";
+	for (std::vector<unsigned>::const_iterator it = _samples.begin(); it != _samples.end(); ++it)
+	{
+		if (it != _samples.begin()) ostr << ",";
+		ostr << *it;
+	}
+	ostr << "],\"timeDeltas\":[";
+	Poco::Int64 last = _startTime;
+	for (std::vector<Poco::Int64>::const_iterator it = _timestamps.begin(); it != _timestamps.end(); ++it)
+	{
+		if (it != _timestamps.begin()) ostr << ",";
+		ostr << *it - last;
+		last = *it;
+	}
+	ostr << "]}";
+}
+
+
+void CpuProfile::writeCollapsedStacks(std::ostream& ostr) const
+{
+	// Every node of the top-down call tree represents a distinct stack,
+	// so each node with samples yields exactly one line.
+	std::vector<std::string> frames;
+	for (std::vector<Node>::const_iterator it = _nodes.begin(); it != _nodes.end(); ++it)
+	{
+		if (it->hitCount == 0) continue;
+
+		frames.clear();
+		const Node* pNode = &*it;
+		while (pNode->parent >= 0)
+		{
+			frames.push_back(frameName(*pNode));
+			pNode = &_nodes[pNode->parent];
+		}
+		if (frames.empty()) continue;
+
+		for (std::vector<std::string>::const_reverse_iterator itf = frames.rbegin(); itf != frames.rend(); ++itf)
+		{
+			if (itf != frames.rbegin()) ostr << ';';
+			ostr << *itf;
+		}
+		ostr << ' ' << it->hitCount << '\n';
+	}
+}
+
+
+std::string CpuProfile::frameName(const Node& node) const
+{
+	std::string name(node.functionName.empty() ? "(anonymous)" : node.functionName);
+	if (!node.url.empty())
+	{
+		name += ' ';
+		name += node.url;
+		if (node.lineNumber > 0)
+		{
+			name += ':';
+			Poco::NumberFormatter::append(name, node.lineNumber);
+		}
+	}
+	for (std::string::iterator it = name.begin(); it != name.end(); ++it)
+	{
+		if (*it == ';') *it = ',';
+		else if (*it == '\n' || *it == '\r') *it = ' ';
+	}
+	return name;
+}
+
+
+} } } // namespace Poco::JS::Core
@@ -23,10 +23,19 @@
 #include "Poco/JS/Core/BufferWrapper.h"
 #include "Poco/JS/Core/JSException.h"
 #include "Poco/Delegate.h"
+#include "Poco/ErrorHandler.h"
 #include "Poco/URIStreamOpener.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/File.h"
+#include "Poco/Condition.h"
 #include "libplatform/libplatform.h"
 #include <memory>
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#include "Poco/UnWindows.h"
+#else
+#include <time.h>
+#endif
 
 
 namespace Poco {
@@ -34,6 +43,35 @@ namespace JS {
 namespace Core {
 
 
+namespace
+{
+	Poco::UInt64 threadCPUTime()
+		/// Returns the CPU time consumed by the calling thread,
+		/// in microseconds.
+	{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+		FILETIME creationTime;
+		FILETIME exitTime;
+		FILETIME kernelTime;
+		FILETIME userTime;
+		if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+		{
+			Poco::UInt64 kernel = (static_cast<Poco::UInt64>(kernelTime.dwHighDateTime) << 32) + kernelTime.dwLowDateTime;
+			Poco::UInt64 user = (static_cast<Poco::UInt64>(userTime.dwHighDateTime) << 32) + userTime.dwLowDateTime;
+			return (kernel + user)/10;
+		}
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+		struct timespec ts;
+		if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+		{
+			return static_cast<Poco::UInt64>(ts.tv_sec)*1000000 + ts.tv_nsec/1000;
+		}
+#endif
+		return static_cast<Poco::UInt64>(Poco::Clock().raw());
+	}
+}
+
+
 //
 // ScopedRunningCounter
 //
@@ -58,18 +96,136 @@ private:
 };
 
 
+//
+// ScopedScriptStatistics
+//
+
+
+class ScopedScriptStatistics
+	/// Measures the time spent executing script code.
+	/// Must be created while holding the isolate's lock.
+{
+public:
+	ScopedScriptStatistics(JSExecutor& executor):
+		_executor(executor)
+	{
+		_executor.enterScript();
+	}
+
+	~ScopedScriptStatistics()
+	{
+		_executor.leaveScript();
+	}
+
+private:
+	JSExecutor& _executor;
+};
+
+
+//
+// JSExecutor::Handle
+//
+
+
+class JSExecutor::Handle: public Poco::RefCountedObject
+	/// Gives other threads safe access to an executor found in
+	/// the registry of executors, even if the executor is
+	/// being destroyed concurrently.
+	///
+	/// The executor pointer must only be used between a successful
+	/// call to acquire() and the matching call to release().
+	/// The executor's destructor waits in reset() until all
+	/// users have released the handle. The handle's mutex is
+	/// not held while the executor is used, so that waiting for
+	/// the executor's isolate does not block other threads
+	/// accessing the handle.
+{
+public:
+	typedef Poco::AutoPtr<Handle> Ptr;
+
+	Handle(JSExecutor* pExecutor):
+		_pExecutor(pExecutor),
+		_users(0)
+	{
+	}
+
+	JSExecutor* acquire()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		if (_pExecutor) _users++;
+		return _pExecutor;
+	}
+
+	void release()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		if (--_users == 0) _released.broadcast();
+	}
+
+	void reset()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_pExecutor = 0;
+		while (_users > 0)
+		{
+			_released.wait(_mutex);
+		}
+	}
+
+private:
+	JSExecutor* _pExecutor;
+	int _users;
+	Poco::FastMutex _mutex;
+	Poco::Condition _released;
+};
+
+
+//
+// JSExecutor::Statistics
+//
+
+
+JSExecutor::Statistics::Statistics():
+	callbacks(0),
+	scriptTime(0),
+	scriptTimeMax(0),
+	timerCallbacks(0),
+	timerLagTotal(0),
+	timerLagMax(0),
+	gcCount(0),
+	gcTime(0),
+	gcTimeMax(0),
+	heapTotal(0),
+	heapUsed(0),
+	heapLimit(0),
+	mallocedMemory(0),
+	profiling(false)
+{
+}
+
+
 //
 // JSExecutor
 //
 
 
 Poco::ThreadLocal<JSExecutor*> JSExecutor::_pCurrentExecutor;
+std::set<JSExecutor*> JSExecutor::_executors;
+Poco::FastMutex JSExecutor::_executorsMutex;
 
 
 JSExecutor::JSExecutor(const std::string& source, const Poco::URI& sourceURI, Poco::UInt64 memoryLimit):
 	_source(source),
 	_sourceURI(sourceURI),
-	_pooledIso(memoryLimit)
+	_pooledIso(memoryLimit),
+	_scriptDepth(0),
+	_scriptStart(0),
+	_gcStart(0),
+	_heapSampled(0),
+	_pProfiler(0)
 {
 	init();
 }
@@ -79,7 +235,12 @@ JSExecutor::JSExecutor(const std::string& source, const Poco::URI& sourceURI, co
 	_source(source),
 	_sourceURI(sourceURI),
 	_moduleSearchPaths(moduleSearchPaths),
-	_pooledIso(memoryLimit)
+	_pooledIso(memoryLimit),
+	_scriptDepth(0),
+	_scriptStart(0),
+	_gcStart(0),
+	_heapSampled(0),
+	_pProfiler(0)
 {
 	init();
 }
@@ -87,6 +248,12 @@ JSExecutor::JSExecutor(const std::string& source, const Poco::URI& sourceURI, co
 
 JSExecutor::~JSExecutor()
 {
+	{
+		Poco::FastMutex::ScopedLock lock(_executorsMutex);
+		_executors.erase(this);
+	}
+	_pHandle->reset();
+
 	_script.Reset();
 	_scriptContext.Reset();
 	_globalContext.Reset();
@@ -100,12 +267,34 @@ JSExecutor::~JSExecutor()
 	{
 		poco_unexpected();
 	}
+
+	v8::Isolate* pIsolate = _pooledIso.isolate();
+	v8::Locker locker(pIsolate);
+	if (_pProfiler)
+	{
+		v8::Isolate::Scope isoScope(pIsolate);
+		_pProfiler->Dispose();
+	}
+	pIsolate->RemoveGCPrologueCallback(onGCPrologue, this);
+	pIsolate->RemoveGCEpilogueCallback(onGCEpilogue, this);
 }
 
 
 void JSExecutor::init()
 {
 	_importStack.push_back(_sourceURI);
+	_statistics.uri = _sourceURI.toString();
+	_pHandle = new Handle(this);
+
+	v8::Isolate* pIsolate = _pooledIso.isolate();
+	{
+		v8::Locker locker(pIsolate);
+		pIsolate->AddGCPrologueCallback(onGCPrologue, this);
+		pIsolate->AddGCEpilogueCallback(onGCEpilogue, this);
+	}
+
+	Poco::FastMutex::ScopedLock lock(_executorsMutex);
+	_executors.insert(this);
 }
 
 
@@ -161,6 +350,211 @@ void JSExecutor::addModuleRegistry(ModuleRegistry::Ptr pRegistry)
 }
 
 
+JSExecutor::Statistics JSExecutor::statistics() const
+{
+	Poco::FastMutex::ScopedLock lock(_statisticsMutex);
+
+	Statistics statistics(_statistics);
+	statistics.profiling = isProfiling();
+	return statistics;
+}
+
+
+void JSExecutor::allStatistics(std::vector<Statistics>& statistics)
+{
+	Poco::FastMutex::ScopedLock lock(_executorsMutex);
+
+	statistics.clear();
+	statistics.reserve(_executors.size());
+	for (std::set<JSExecutor*>::const_iterator it = _executors.begin(); it != _executors.end(); ++it)
+	{
+		statistics.push_back((*it)->statistics());
+	}
+}
+
+
+void JSExecutor::startProfiling(int samplingInterval)
+{
+	poco_assert (samplingInterval > 0);
+
+	_samplingInterval = samplingInterval;
+}
+
+
+CpuProfile::Ptr JSExecutor::stopProfiling()
+{
+	CpuProfile::Ptr pProfile;
+
+	v8::Isolate* pIsolate = _pooledIso.isolate();
+	v8::Locker locker(pIsolate);
+	v8::Isolate::Scope isoScope(pIsolate);
+	v8::HandleScope handleScope(pIsolate);
+
+	_samplingInterval = 0;
+	if (_pProfiler)
+	{
+		v8::CpuProfile* pV8Profile = _pProfiler->StopProfiling(v8::String::NewFromUtf8(pIsolate, _statistics.uri.c_str()));
+		if (pV8Profile)
+		{
+			pProfile = new CpuProfile(_statistics.uri, *pV8Profile);
+			pV8Profile->Delete();
+		}
+		_pProfiler->Dispose();
+		_pProfiler = 0;
+	}
+	return pProfile;
+}
+
+
+void JSExecutor::startProfilerImpl()
+{
+	v8::Isolate* pIsolate = _pooledIso.isolate();
+	v8::HandleScope handleScope(pIsolate);
+
+	_pProfiler = v8::CpuProfiler::New(pIsolate);
+	_pProfiler->SetSamplingInterval(_samplingInterval.value());
+	_pProfiler->StartProfiling(v8::String::NewFromUtf8(pIsolate, _statistics.uri.c_str()), true);
+}
+
+
+void JSExecutor::findHandles(const std::string& uri, std::vector<Handle::Ptr>& handles)
+{
+	Poco::FastMutex::ScopedLock lock(_executorsMutex);
+
+	for (std::set<JSExecutor*>::const_iterator it = _executors.begin(); it != _executors.end(); ++it)
+	{
+		const std::string& scriptURI = (*it)->_statistics.uri;
+		if (scriptURI == uri || (!uri.empty() && uri[uri.size() - 1] == '/' && scriptURI.compare(0, uri.size(), uri) == 0))
+		{
+			handles.push_back((*it)->_pHandle);
+		}
+	}
+}
+
+
+std::size_t JSExecutor::startProfiling(const std::string& uri, int samplingInterval)
+{
+	std::vector<Handle::Ptr> handles;
+	findHandles(uri, handles);
+
+	std::size_t count = 0;
+	for (std::vector<Handle::Ptr>::iterator it = handles.begin(); it != handles.end(); ++it)
+	{
+		JSExecutor* pExecutor = (*it)->acquire();
+		if (pExecutor)
+		{
+			pExecutor->startProfiling(samplingInterval);
+			(*it)->release();
+			count++;
+		}
+	}
+	return count;
+}
+
+
+void JSExecutor::stopProfiling(const std::string& uri, std::vector<CpuProfile::Ptr>& profiles)
+{
+	std::vector<Handle::Ptr> handles;
+	findHandles(uri, handles);
+
+	for (std::vector<Handle::Ptr>::iterator it = handles.begin(); it != handles.end(); ++it)
+	{
+		JSExecutor* pExecutor = (*it)->acquire();
+		if (pExecutor)
+		{
+			CpuProfile::Ptr pProfile;
+			try
+			{
+				pProfile = pExecutor->stopProfiling();
+			}
+			catch (...)
+			{
+				(*it)->release();
+				throw;
+			}
+			(*it)->release();
+			if (pProfile) profiles.push_back(pProfile);
+		}
+	}
+}
+
+
+void JSExecutor::recordTimerLag(Poco::Clock::ClockDiff lag)
+{
+	if (lag < 0) lag = 0;
+
+	Poco::FastMutex::ScopedLock lock(_statisticsMutex);
+
+	_statistics.timerCallbacks++;
+	_statistics.timerLagTotal += lag;
+	if (static_cast<Poco::UInt64>(lag) > _statistics.timerLagMax) _statistics.timerLagMax = lag;
+}
+
+
+void JSExecutor::enterScript()
+{
+	if (_scriptDepth++ == 0)
+	{
+		if (!_pProfiler && _samplingInterval.value() > 0)
+		{
+			startProfilerImpl();
+		}
+		_scriptStart = threadCPUTime();
+	}
+}
+
+
+void JSExecutor::leaveScript()
+{
+	if (--_scriptDepth == 0)
+	{
+		Poco::UInt64 now = threadCPUTime();
+		Poco::UInt64 elapsed = now > _scriptStart ? now - _scriptStart : 0;
+		bool sampleHeap = _heapSampled.isElapsed(1000000);
+		v8::HeapStatistics heapStatistics;
+		if (sampleHeap)
+		{
+			_pooledIso.isolate()->GetHeapStatistics(&heapStatistics);
+			_heapSampled.update();
+		}
+
+		Poco::FastMutex::ScopedLock lock(_statisticsMutex);
+
+		_statistics.callbacks++;
+		_statistics.scriptTime += elapsed;
+		if (elapsed > _statistics.scriptTimeMax) _statistics.scriptTimeMax = elapsed;
+		if (sampleHeap)
+		{
+			_statistics.heapTotal = heapStatistics.total_heap_size();
+			_statistics.heapUsed = heapStatistics.used_heap_size();
+			_statistics.heapLimit = heapStatistics.heap_size_limit();
+			_statistics.mallocedMemory = heapStatistics.malloced_memory();
+		}
+	}
+}
+
+
+void JSExecutor::onGCPrologue(v8::Isolate* pIsolate, v8::GCType type, v8::GCCallbackFlags flags, void* data)
+{
+	JSExecutor* pThis = reinterpret_cast<JSExecutor*>(data);
+	pThis->_gcStart = threadCPUTime();
+}
+
+
+void JSExecutor::onGCEpilogue(v8::Isolate* pIsolate, v8::GCType type, v8::GCCallbackFlags flags, void* data)
+{
+	JSExecutor* pThis = reinterpret_cast<JSExecutor*>(data);
+	Poco::UInt64 now = threadCPUTime();
+	Poco::UInt64 elapsed = now > pThis->_gcStart ? now - pThis->_gcStart : 0;
+
+	Poco::FastMutex::ScopedLock lock(pThis->_statisticsMutex);
+
+	pThis->_statistics.gcCount++;
+	pThis->_statistics.gcTime += elapsed;
+	if (elapsed > pThis->_statistics.gcTimeMax) pThis->_statistics.gcTimeMax = elapsed;
+}
+
+
 void JSExecutor::setup()
 {
 	v8::Isolate* pIsolate = _pooledIso.isolate();
@@ -219,6 +613,7 @@ void JSExecutor::runImpl()
 	v8::Locker locker(pIsolate);
 	v8::Isolate::Scope isoScope(pIsolate);
 	v8::HandleScope handleScope(pIsolate);
+	ScopedScriptStatistics sss(*this);
 
 	if (_globalObjectTemplate.IsEmpty())
 	{
@@ -280,6 +675,7 @@ void JSExecutor::call(v8::Handle<v8::Function>& function, v8::Handle<v8::Value>&
 	v8::Locker locker(pIsolate);
 	v8::Isolate::Scope isoScope(pIsolate);
 	v8::HandleScope handleScope(pIsolate);
+	ScopedScriptStatistics sss(*this);
 
 	v8::Local<v8::Context> context(v8::Local<v8::Context>::New(pIsolate, _scriptContext));
 	v8::Context::Scope contextScope(context);
@@ -295,6 +691,8 @@ void JSExecutor::callInContext(v8::Handle<v8::Function>& function, v8::Handle<v8
 	attachToCurrentThread();
 
 	v8::Isolate* pIsolate = _pooledIso.isolate();
+	poco_assert_dbg (v8::Locker::IsLocked(pIsolate));
+	ScopedScriptStatistics sss(*this);
 	v8::TryCatch tryCatch(pIsolate);
 	function->Call(receiver, argc, argv);
 	if (tryCatch.HasCaught())
@@ -311,6 +709,8 @@ void JSExecutor::callInContext(v8::Persistent<v8::Object>& jsObject, const std::
 	attachToCurrentThread();
 
 	v8::Isolate* pIsolate = _pooledIso.isolate();
+	poco_assert_dbg (v8::Locker::IsLocked(pIsolate));
+	ScopedScriptStatistics sss(*this);
 
 	v8::HandleScope handleScope(pIsolate);
 
@@ -347,6 +747,7 @@ void JSExecutor::call(v8::Persistent<v8::Object>& jsObject, const std::string& m
 	v8::Locker locker(pIsolate);
 	v8::Isolate::Scope isoScope(pIsolate);
 	v8::HandleScope handleScope(pIsolate);
+	ScopedScriptStatistics sss(*this);
 
 	v8::Local<v8::Context> context(v8::Local<v8::Context>::New(pIsolate, _scriptContext));
 	v8::Context::Scope contextScope(context);
@@ -397,6 +798,7 @@ void JSExecutor::call(v8::Persistent<v8::Function>& function)
 	v8::Locker locker(pIsolate);
 	v8::Isolate::Scope isoScope(pIsolate);
 	v8::HandleScope handleScope(pIsolate);
+	ScopedScriptStatistics sss(*this);
 
 	v8::Local<v8::Context> context(v8::Local<v8::Context>::New(pIsolate, _scriptContext));
 	v8::Context::Scope contextScope(context);
@@ -425,6 +827,7 @@ void JSExecutor::call(v8::Persistent<v8::Function>& function, v8::Persistent<v8:
 	v8::Locker locker(pIsolate);
 	v8::Isolate::Scope isoScope(pIsolate);
 	v8::HandleScope handleScope(pIsolate);
+	ScopedScriptStatistics sss(*this);
 
 	v8::Local<v8::Context> context(v8::Local<v8::Context>::New(pIsolate, _scriptContext));
 	v8::Context::Scope contextScope(context);
@@ -656,7 +1059,7 @@ void JSExecutor::importModule(const v8::FunctionCallbackInfo<v8::Value>& args, c
 
 	// Resolve URI
 	Poco::URI moduleURI;
-	Poco::SharedPtr<std::istream> pStream = resolveModule(uri, moduleURI);
+	CachedModule::Ptr pCachedModule = resolveModule(uri, moduleURI);
 	ImportScope importScope(_importStack, moduleURI);
 	std::string moduleURIString = moduleURI.toString();
 
@@ -678,12 +1081,12 @@ void JSExecutor::importModule(const v8::FunctionCallbackInfo<v8::Value>& args, c
 	v8::Local<v8::String> jsModuleURI = v8::String::NewFromUtf8(pIsolate, moduleURIString.c_str());
 	if (globalImports->Has(jsModuleURI))
 	{
-		poco_assert (!pStream);
+		poco_assert (!pCachedModule);
 		args.GetReturnValue().Set(globalImports->Get(jsModuleURI));
 	}
 	else
 	{
-		poco_assert (pStream);
+		poco_assert (pCachedModule);
 
 		// Create context for import
 		v8::Local<v8::ObjectTemplate> moduleTemplate(v8::Local<v8::ObjectTemplate>::New(pIsolate, _globalObjectTemplate));
@@ -704,13 +1107,11 @@ void JSExecutor::importModule(const v8::FunctionCallbackInfo<v8::Value>& args, c
 
 		globalImports->Set(jsModuleURI, exportsObject);
 
-		std::string source;
-		Poco::StreamCopier::copyToString(*pStream, source);
-
-		v8::Local<v8::String> sourceObject = v8::String::NewFromUtf8(pIsolate, source.c_str());
+		v8::Local<v8::String> sourceObject = v8::String::NewFromUtf8(pIsolate, pCachedModule->source().c_str());
 		v8::TryCatch tryCatch(pIsolate);
 		v8::ScriptOrigin scriptOrigin(jsModuleURI);
-		v8::Local<v8::Script> scriptObject = v8::Script::Compile(sourceObject, &scriptOrigin);
+		v8::Local<v8::Script> scriptObject;
+		compileModule(*pCachedModule, sourceObject, scriptOrigin, scriptObject);
 		if (scriptObject.IsEmpty() || tryCatch.HasCaught())
 		{
 			args.GetReturnValue().Set(tryCatch.ReThrow());
@@ -766,24 +1167,24 @@ void JSExecutor::importModule(const v8::FunctionCallbackInfo<v8::Value>& args, c
 }
 
 
-Poco::SharedPtr<std::istream> JSExecutor::resolveModule(const std::string& uri, Poco::URI& resolvedURI)
+CachedModule::Ptr JSExecutor::resolveModule(const std::string& uri, Poco::URI& resolvedURI)
 {
 	poco_assert (!_importStack.empty());
 
-	Poco::SharedPtr<std::istream> pStream;
+	CachedModule::Ptr pModule;
 
 	resolvedURI = _importStack.back();
 	resolvedURI.resolve(uri);
 	std::string resolvedURIString = resolvedURI.toString();
 
 	if (_imports.find(resolvedURIString) != _imports.end())
-		return pStream;
+		return pModule;
 
 	try
 	{
-		pStream = Poco::URIStreamOpener::defaultOpener().open(resolvedURIString);
+		pModule = loadModule(resolvedURI);
 		_imports.insert(resolvedURIString);
-		return pStream;
+		return pModule;
 	}
 	catch (Poco::Exception&)
 	{
@@ -800,13 +1201,13 @@ Poco::SharedPtr<std::istream> JSExecutor::resolveModule(const std::string& uri,
 		resolvedURIString = resolvedURI.toString();
 
 		if (_imports.find(resolvedURIString) != _imports.end())
-			return pStream;
+			return pModule;
 
 		try
 		{
-			pStream = Poco::URIStreamOpener::defaultOpener().open(resolvedURIString);
+			pModule = loadModule(resolvedURI);
 			_imports.insert(resolvedURIString);
-			return pStream;
+			return pModule;
 		}
 		catch (Poco::Exception&)
 		{
@@ -817,6 +1218,83 @@ Poco::SharedPtr<std::istream> JSExecutor::resolveModule(const std::string& uri,
 }
 
 
+CachedModule::Ptr JSExecutor::loadModule(const Poco::URI& uri)
+{
+	std::string uriString = uri.toString();
+	std::string tag = moduleCacheTag(uri);
+	CachedModule::Ptr pModule;
+	if (!tag.empty())
+	{
+		pModule = ModuleCache::defaultCache().find(uriString, tag);
+		if (pModule) return pModule;
+	}
+
+#if __cplusplus < 201103L
+	std::auto_ptr<std::istream> pStream(Poco::URIStreamOpener::defaultOpener().open(uri));
+#else
+	std::unique_ptr<std::istream> pStream(Poco::URIStreamOpener::defaultOpener().open(uri));
+#endif
+	std::string source;
+	Poco::StreamCopier::copyToString(*pStream, source);
+	pModule = new CachedModule(source);
+
+	if (!tag.empty())
+	{
+		ModuleCache::defaultCache().add(uriString, tag, pModule);
+	}
+	return pModule;
+}
+
+
+std::string JSExecutor::moduleCacheTag(const Poco::URI& uri)
+{
+	std::string tag;
+	if (uri.getScheme() == "file")
+	{
+		try
+		{
+			Poco::File file(uri.getPath());
+			tag = Poco::NumberFormatter::format(file.getLastModified().epochMicroseconds());
+			tag += ':';
+			tag += Poco::NumberFormatter::format(file.getSize());
+		}
+		catch (Poco::Exception&)
+		{
+		}
+	}
+	return tag;
+}
+
+
+void JSExecutor::compileModule(CachedModule& module, v8::Local<v8::String> source, v8::ScriptOrigin& origin, v8::Local<v8::Script>& script)
+{
+	v8::Isolate* pIsolate = _pooledIso.isolate();
+	v8::Local<v8::Context> context = pIsolate->GetCurrentContext();
+
+	std::string codeCache = module.codeCache();
+	if (!codeCache.empty())
+	{
+		v8::ScriptCompiler::CachedData* pCachedData = new v8::ScriptCompiler::CachedData(reinterpret_cast<const uint8_t*>(codeCache.data()), static_cast<int>(codeCache.size()));
+		v8::ScriptCompiler::Source scriptSource(source, origin, pCachedData);
+		v8::ScriptCompiler::Compile(context, &scriptSource, v8::ScriptCompiler::kConsumeCodeCache).ToLocal(&script);
+		if (scriptSource.GetCachedData()->rejected)
+		{
+			module.clearCodeCache();
+		}
+	}
+	else
+	{
+		v8::ScriptCompiler::Source scriptSource(source, origin);
+		v8::ScriptCompiler::Compile(context, &scriptSource, v8::ScriptCompiler::kProduceCodeCache).ToLocal(&script);
+		const v8::ScriptCompiler::CachedData* pCachedData = scriptSource.GetCachedData();
+		if (!script.IsEmpty() && pCachedData && pCachedData->length > 0)
+		{
+			module.setCodeCache(reinterpret_cast<const char*>(pCachedData->data), pCachedData->length);
+		}
+	}
+}
+
+
 //
 // RunScriptTask
 //
@@ -859,7 +1337,10 @@ public:
 
 	void run()
 	{
-		_pExecutor->_timer.cancel(false);
+		if (_pExecutor->_pTimerPool)
+			_pExecutor->cancelPooledTasks();
+		else
+			_pExecutor->_pTimer->cancel(false);
 		_stopped.set();
 	}
 
@@ -878,6 +1359,41 @@ private:
 };
 
 
+//
+// CompleteStopTask
+//
+
+
+class CompleteStopTask: public Poco::Util::TimerTask
+	/// Used by TimedJSExecutor::stop() if called from a thread
+	/// of the executor's TimerPool. Fires the stopped event
+	/// and cleans up in the executor's timer thread, after
+	/// the currently running script (if any) has terminated.
+{
+public:
+	typedef Poco::AutoPtr<CompleteStopTask> Ptr;
+
+	CompleteStopTask(TimedJSExecutor* pExecutor):
+		_pExecutor(pExecutor, true)
+	{
+	}
+
+	void run()
+	{
+		TimedJSExecutor::Ptr pExecutor = _pExecutor;
+		_pExecutor = 0;
+		if (pExecutor)
+		{
+			pExecutor->stopped(pExecutor.get());
+			pExecutor->cleanup();
+		}
+	}
+
+private:
+	TimedJSExecutor::Ptr _pExecutor;
+};
+
+
 //
 // CallFunctionTask
 //
@@ -890,7 +1406,8 @@ public:
 
 	CallFunctionTask(v8::Isolate* pIsolate, TimedJSExecutor* pExecutor, v8::Handle<v8::Function> function):
 		_pExecutor(pExecutor, true),
-		_function(pIsolate, function)
+		_function(pIsolate, function),
+		_interval(0)
 	{
 		_pExecutor->stopped += Poco::delegate(this, &CallFunctionTask::onExecutorStopped);
 	}
@@ -898,7 +1415,8 @@ public:
 	CallFunctionTask(v8::Isolate* pIsolate, TimedJSExecutor* pExecutor, v8::Handle<v8::Function> function, v8::Handle<v8::Array> arguments):
 		_pExecutor(pExecutor, true),
 		_function(pIsolate, function),
-		_arguments(pIsolate, arguments)
+		_arguments(pIsolate, arguments),
+		_interval(0)
 	{
 		_pExecutor->stopped += Poco::delegate(this, &CallFunctionTask::onExecutorStopped);
 	}
@@ -926,10 +1444,21 @@ public:
 		TimedJSExecutor::Ptr pExecutor = _pExecutor;
 		if (pExecutor)
 		{
+			pExecutor->recordTimerLag(_due.elapsed());
+			if (_interval > 0) _due += _interval;
 			pExecutor->call(_function, _arguments);
 		}
 	}
 
+	void setDue(const Poco::Clock& due, Poco::Clock::ClockDiff interval = 0)
+		/// Sets the time the task is scheduled to run first and, for
+		/// periodic tasks, the interval (in microseconds). Used to
+		/// compute the timer lag.
+	{
+		_due = due;
+		_interval = interval;
+	}
+
 	void onExecutorStopped()
 	{
 		if (_pExecutor)
@@ -943,6 +1472,112 @@ private:
 	TimedJSExecutor::Ptr _pExecutor;
 	v8::Persistent<v8::Function> _function;
 	v8::Persistent<v8::Array> _arguments;
+	Poco::Clock _due;
+	Poco::Clock::ClockDiff _interval;
+};
+
+
+//
+// ReadyTask
+//
+
+
+class ReadyTask: public Poco::Util::TimerTask
+	/// Used by a TimedJSExecutor bound to a pooled timer.
+	/// Moves the wrapped task to the executor's run queue
+	/// as soon as it becomes due.
+	///
+	/// A periodic task puts itself into the run queue, so that
+	/// it is not queued again while the previous run is still
+	/// pending, e.g. because the executor is busy with a
+	/// long-running script or other executors use up the timer.
+{
+public:
+	typedef Poco::AutoPtr<ReadyTask> Ptr;
+
+	ReadyTask(TimedJSExecutor* pExecutor, Poco::Util::TimerTask::Ptr pTask, bool periodic):
+		_pExecutor(pExecutor),
+		_pTask(pTask),
+		_periodic(periodic),
+		_pending(false)
+	{
+	}
+
+	void run()
+	{
+		Poco::Util::TimerTask::Ptr pTask = _pTask;
+		if (!pTask || pTask->isCancelled())
+		{
+			cancel();
+			_pExecutor->releasePooledTask(this);
+		}
+		else if (_periodic)
+		{
+			_pExecutor->enqueueReady(Poco::Util::TimerTask::Ptr(this, true));
+		}
+		else
+		{
+			_pExecutor->releasePooledTask(this);
+			_pExecutor->enqueueReady(pTask);
+		}
+	}
+
+	Poco::Util::TimerTask::Ptr task() const
+	{
+		return _pTask;
+	}
+
+	void reset()
+	{
+		_pTask = 0;
+	}
+
+	bool isPending() const
+		/// Must be called with the executor's mutex locked.
+	{
+		return _pending;
+	}
+
+	void setPending(bool pending)
+		/// Must be called with the executor's mutex locked.
+	{
+		_pending = pending;
+	}
+
+private:
+	TimedJSExecutor* _pExecutor;
+	Poco::Util::TimerTask::Ptr _pTask;
+	bool _periodic;
+	bool _pending;
+};
+
+
+//
+// DispatchReadyTask
+//
+
+
+class DispatchReadyTask: public Poco::Util::TimerTask
+	/// Used by a TimedJSExecutor bound to a pooled timer.
+	/// Runs the tasks in the executor's run queue, up to
+	/// the task budget given by the TimerPool.
+{
+public:
+	typedef Poco::AutoPtr<DispatchReadyTask> Ptr;
+
+	DispatchReadyTask(TimedJSExecutor* pExecutor):
+		_pExecutor(pExecutor)
+	{
+	}
+
+	void run()
+	{
+		_pExecutor->releasePooledTask(this);
+		_pExecutor->dispatchReady();
+	}
+
+private:
+	TimedJSExecutor* _pExecutor;
 };
 
 
@@ -953,7 +1588,19 @@ private:
 
 TimedJSExecutor::TimedJSExecutor(const std::string& source, const Poco::URI& sourceURI, const std::vector<std::string>& moduleSearchPaths, Poco::UInt64 memoryLimit):
 	JSExecutor(source, sourceURI, moduleSearchPaths, memoryLimit),
-	_stopped(false)
+	_pTimer(new Poco::Util::Timer),
+	_stopped(false),
+	_dispatchScheduled(false)
+{
+}
+
+
+TimedJSExecutor::TimedJSExecutor(const std::string& source, const Poco::URI& sourceURI, const std::vector<std::string>& moduleSearchPaths, TimerPool::Ptr pTimerPool, Poco::UInt64 memoryLimit):
+	JSExecutor(source, sourceURI, moduleSearchPaths, memoryLimit),
+	_pTimerPool(pTimerPool),
+	_pTimer(pTimerPool ? &pTimerPool->acquireTimer() : new Poco::Util::Timer),
+	_stopped(false),
+	_dispatchScheduled(false)
 {
 }
 
@@ -962,7 +1609,24 @@ TimedJSExecutor::~TimedJSExecutor()
 {
 	try
 	{
-		stop();
+		if (_pTimerPool && _pTimerPool->isTimerThread())
+		{
+			// No script of the executor can be running, as running tasks
+			// hold a reference to the executor, so there is no need to
+			// wait for a StopScriptTask (which could also deadlock).
+			if (markStopped())
+			{
+				cancelPooledTasks();
+				stopped(this);
+				cleanup();
+			}
+		}
+		else stop();
+
+		if (_pTimerPool)
+			_pTimerPool->releaseTimer(*_pTimer);
+		else
+			delete _pTimer;
 	}
 	catch (...)
 	{
@@ -973,7 +1637,7 @@ TimedJSExecutor::~TimedJSExecutor()
 
 void TimedJSExecutor::run()
 {
-	_timer.schedule(new RunScriptTask(this), Poco::Timestamp());
+	scheduleImpl(new RunScriptTask(this), Poco::Clock());
 }
 
 
@@ -991,39 +1655,192 @@ void TimedJSExecutor::setupGlobalObjectTemplate(v8::Local<v8::ObjectTemplate>& g
 
 
 void TimedJSExecutor::schedule(Poco::Util::TimerTask::Ptr pTask)
+{
+	scheduleImpl(pTask, Poco::Clock());
+}
+
+
+void TimedJSExecutor::schedule(Poco::Util::TimerTask::Ptr pTask, const Poco::Clock& clock)
+{
+	scheduleImpl(pTask, clock);
+}
+
+
+void TimedJSExecutor::scheduleImpl(Poco::Util::TimerTask::Ptr pTask, const Poco::Clock& clock)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	if (!_stopped)
+	{
+		if (_pTimerPool)
+		{
+			ReadyTask::Ptr pReadyTask = new ReadyTask(this, pTask, false);
+			_pooledTasks.insert(pReadyTask);
+			_pTimer->schedule(pReadyTask, clock);
+		}
+		else
+		{
+			_pTimer->schedule(pTask, clock);
+		}
+	}
+}
+
+
+void TimedJSExecutor::scheduleAtFixedRateImpl(Poco::Util::TimerTask::Ptr pTask, long delay, long interval)
 {
 	Poco::FastMutex::ScopedLock lock(_mutex);
 
 	if (!_stopped)
 	{
-		_timer.schedule(pTask, Poco::Clock());
+		if (_pTimerPool)
+		{
+			ReadyTask::Ptr pReadyTask = new ReadyTask(this, pTask, true);
+			_pooledTasks.insert(pReadyTask);
+			_pTimer->scheduleAtFixedRate(pReadyTask, delay, interval);
+		}
+		else
+		{
+			_pTimer->scheduleAtFixedRate(pTask, delay, interval);
+		}
 	}
 }
 
 
-void TimedJSExecutor::schedule(Poco::Util::TimerTask::Ptr pTask, const Poco::Clock& clock)
+void TimedJSExecutor::enqueueReady(Poco::Util::TimerTask::Ptr pTask)
 {
 	Poco::FastMutex::ScopedLock lock(_mutex);
 
 	if (!_stopped)
 	{
-		_timer.schedule(pTask, clock);
+		ReadyTask::Ptr pReadyTask = pTask.cast<ReadyTask>();
+		if (pReadyTask)
+		{
+			// periodic task - skip if the previous run is still queued
+			if (pReadyTask->isPending()) return;
+			pReadyTask->setPending(true);
+		}
+		_readyQueue.push_back(pTask);
+		if (!_dispatchScheduled)
+		{
+			DispatchReadyTask::Ptr pDispatchTask = new DispatchReadyTask(this);
+			_pooledTasks.insert(pDispatchTask);
+			_pTimer->schedule(pDispatchTask, Poco::Clock());
+			_dispatchScheduled = true;
+		}
 	}
 }
 
 
-void TimedJSExecutor::stop()
+void TimedJSExecutor::dispatchReady()
 {
+	std::size_t budget = _pTimerPool->taskBudget();
+	while (budget-- > 0)
+	{
+		Poco::Util::TimerTask::Ptr pTask;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (_stopped || _readyQueue.empty())
+			{
+				_dispatchScheduled = false;
+				return;
+			}
+			pTask = _readyQueue.front();
+			_readyQueue.pop_front();
+
+			ReadyTask::Ptr pReadyTask = pTask.cast<ReadyTask>();
+			if (pReadyTask)
+			{
+				pReadyTask->setPending(false);
+				pTask = pReadyTask->task();
+			}
+		}
+		if (pTask && !pTask->isCancelled())
+		{
+			try
+			{
+				pTask->run();
+			}
+			catch (Poco::Exception& exc)
+			{
+				Poco::ErrorHandler::handle(exc);
+			}
+			catch (std::exception& exc)
+			{
+				Poco::ErrorHandler::handle(exc);
+			}
+			catch (...)
+			{
+				Poco::ErrorHandler::handle();
+			}
+		}
+	}
+
+	// Budget exhausted - give other executors sharing the timer a turn
+	// by putting the next dispatch at the end of the timer's queue.
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	if (!_stopped && !_readyQueue.empty())
+	{
+		DispatchReadyTask::Ptr pDispatchTask = new DispatchReadyTask(this);
+		_pooledTasks.insert(pDispatchTask);
+		_pTimer->schedule(pDispatchTask, Poco::Clock());
+	}
+	else
+	{
+		_dispatchScheduled = false;
+	}
+}
+
+
+void TimedJSExecutor::releasePooledTask(Poco::Util::TimerTask* pTask)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_pooledTasks.erase(Poco::Util::TimerTask::Ptr(pTask, true));
+}
+
+
+void TimedJSExecutor::cancelPooledTasks()
+{
+	std::vector<Poco::Util::TimerTask::Ptr> pooledTasks;
+	std::deque<Poco::Util::TimerTask::Ptr> readyQueue;
 	{
 		Poco::FastMutex::ScopedLock lock(_mutex);
 
-		if (_stopped) return;
+		pooledTasks.assign(_pooledTasks.begin(), _pooledTasks.end());
+		_pooledTasks.clear();
+		std::swap(readyQueue, _readyQueue);
+		_dispatchScheduled = false;
+	}
 
-		_stopped = true;
+	for (std::vector<Poco::Util::TimerTask::Ptr>::iterator it = pooledTasks.begin(); it != pooledTasks.end(); ++it)
+	{
+		(*it)->cancel();
+		ReadyTask::Ptr pReadyTask = it->cast<ReadyTask>();
+		if (pReadyTask) pReadyTask->reset();
+	}
+}
+
+
+void TimedJSExecutor::stop()
+{
+	if (!markStopped()) return;
+
+	if (_pTimerPool && _pTimerPool->isTimerThread())
+	{
+		// Called from a thread of the TimerPool, e.g. by a script stopping
+		// another executor or a bundle. Waiting for a StopScriptTask would
+		// deadlock if it must run in the current thread, or in another
+		// pool thread that is itself waiting for the current thread.
+		cancelPooledTasks();
+		terminate();
+		_pTimer->schedule(new CompleteStopTask(this), Poco::Clock());
+		return;
 	}
 
 	StopScriptTask::Ptr pStopTask = new StopScriptTask(this);
-	_timer.schedule(pStopTask, Poco::Clock());
+	_pTimer->schedule(pStopTask, Poco::Clock());
 	pStopTask->wait();
 	pStopTask = 0;
 
@@ -1033,6 +1850,17 @@ void TimedJSExecutor::stop()
 }
 
 
+bool TimedJSExecutor::markStopped()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	if (_stopped) return false;
+
+	_stopped = true;
+	return true;
+}
+
+
 void TimedJSExecutor::setImmediate(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
 	v8::EscapableHandleScope handleScope(args.GetIsolate());
@@ -1056,8 +1884,7 @@ void TimedJSExecutor::setImmediate(const v8::FunctionCallbackInfo<v8::Value>& ar
 	TimedJSExecutor* pThis = static_cast<TimedJSExecutor*>(pCurrentExecutor);
 
 	CallFunctionTask::Ptr pTask = new CallFunctionTask(args.GetIsolate(), pThis, function, argsArray);
-	Poco::Timestamp ts;
-	pThis->_timer.schedule(pTask, ts);
+	pThis->scheduleImpl(pTask, Poco::Clock());
 	TimerWrapper wrapper;
 	v8::Persistent<v8::Object> timerObject(args.GetIsolate(), wrapper.wrapNativePersistent(args.GetIsolate(), pTask));
 	args.GetReturnValue().Set(timerObject);
@@ -1089,9 +1916,10 @@ void TimedJSExecutor::setTimeout(const v8::FunctionCallbackInfo<v8::Value>& args
 	TimedJSExecutor* pThis = static_cast<TimedJSExecutor*>(pCurrentExecutor);
 
 	CallFunctionTask::Ptr pTask = new CallFunctionTask(args.GetIsolate(), pThis, function, argsArray);
-	Poco::Timestamp ts;
-	ts += static_cast<Poco::Timestamp::TimeDiff>(millisecs*1000);
-	pThis->_timer.schedule(pTask, ts);
+	Poco::Clock clock;
+	clock += static_cast<Poco::Clock::ClockDiff>(millisecs*1000);
+	pTask->setDue(clock);
+	pThis->scheduleImpl(pTask, clock);
 	TimerWrapper wrapper;
 	v8::Persistent<v8::Object> timerObject(args.GetIsolate(), wrapper.wrapNativePersistent(args.GetIsolate(), pTask));
 	args.GetReturnValue().Set(timerObject);
@@ -1123,7 +1951,10 @@ void TimedJSExecutor::setInterval(const v8::FunctionCallbackInfo<v8::Value>& arg
 	TimedJSExecutor* pThis = static_cast<TimedJSExecutor*>(pCurrentExecutor);
 
 	CallFunctionTask::Ptr pTask = new CallFunctionTask(args.GetIsolate(), pThis, function, argsArray);
-	pThis->_timer.scheduleAtFixedRate(pTask, static_cast<long>(millisecs), static_cast<long>(millisecs));
+	Poco::Clock clock;
+	clock += static_cast<Poco::Clock::ClockDiff>(millisecs)*1000;
+	pTask->setDue(clock, static_cast<Poco::Clock::ClockDiff>(millisecs)*1000);
+	pThis->scheduleAtFixedRateImpl(pTask, static_cast<long>(millisecs), static_cast<long>(millisecs));
 	TimerWrapper wrapper;
 	v8::Persistent<v8::Object> timerObject(args.GetIsolate(), wrapper.wrapNativePersistent(args.GetIsolate(), pTask));
 	args.GetReturnValue().Set(timerObject);
@@ -0,0 +1,121 @@
+//
+// ModuleCache.cpp
+//
+// Library: JS/Core
+// Package: Execution
+// Module:  ModuleCache
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/JS/Core/ModuleCache.h"
+#include "Poco/SingletonHolder.h"
+
+
+namespace Poco {
+namespace JS {
+namespace Core {
+
+
+//
+// CachedModule
+//
+
+
+CachedModule::CachedModule(const std::string& source):
+	_source(source)
+{
+}
+
+
+CachedModule::~CachedModule()
+{
+}
+
+
+std::string CachedModule::codeCache() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _codeCache;
+}
+
+
+void CachedModule::setCodeCache(const char* data, std::size_t size)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_codeCache.assign(data, size);
+}
+
+
+void CachedModule::clearCodeCache()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_codeCache.clear();
+}
+
+
+//
+// ModuleCache
+//
+
+
+ModuleCache::ModuleCache(long capacity):
+	_cache(capacity)
+{
+}
+
+
+ModuleCache::~ModuleCache()
+{
+}
+
+
+CachedModule::Ptr ModuleCache::find(const std::string& uri, const std::string& tag)
+{
+	return _cache.get(makeKey(uri, tag));
+}
+
+
+void ModuleCache::add(const std::string& uri, const std::string& tag, CachedModule::Ptr pModule)
+{
+	_cache.add(makeKey(uri, tag), pModule);
+}
+
+
+void ModuleCache::clear()
+{
+	_cache.clear();
+}
+
+
+std::string ModuleCache::makeKey(const std::string& uri, const std::string& tag)
+{
+	std::string key;
+	key.reserve(uri.size() + tag.size() + 1);
+	key += uri;
+	key += '#';
+	key += tag;
+	return key;
+}
+
+
+namespace
+{
+	static Poco::SingletonHolder<ModuleCache> sh;
+}
+
+
+ModuleCache& ModuleCache::defaultCache()
+{
+	return *sh.get();
+}
+
+
+} } } // namespace Poco::JS::Core
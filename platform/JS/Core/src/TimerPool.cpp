@@ -0,0 +1,145 @@
+//
+// TimerPool.cpp
+//
+// Library: JS/Core
+// Package: Execution
+// Module:  TimerPool
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/JS/Core/TimerPool.h"
+#include "Poco/Util/TimerTask.h"
+#include "Poco/Event.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+namespace JS {
+namespace Core {
+
+
+class TimerThreadTask: public Poco::Util::TimerTask
+	/// Determines the thread ID of a timer.
+{
+public:
+	typedef Poco::AutoPtr<TimerThreadTask> Ptr;
+
+	TimerThreadTask():
+		_tid()
+	{
+	}
+
+	void run()
+	{
+		_tid = Poco::Thread::currentTid();
+		_done.set();
+	}
+
+	Poco::Thread::TID tid()
+	{
+		_done.wait();
+		return _tid;
+	}
+
+private:
+	Poco::Thread::TID _tid;
+	Poco::Event _done;
+};
+
+
+TimerPool::TimerPool(std::size_t size, std::size_t taskBudget):
+	_taskBudget(taskBudget)
+{
+	poco_assert (size > 0);
+
+	if (_taskBudget == 0) _taskBudget = 1;
+
+	_timers.resize(size);
+	for (std::vector<PooledTimer>::iterator it = _timers.begin(); it != _timers.end(); ++it)
+	{
+		it->pTimer = new Poco::Util::Timer;
+		it->usage = 0;
+		TimerThreadTask::Ptr pTask = new TimerThreadTask;
+		it->pTimer->schedule(pTask, Poco::Clock());
+		it->tid = pTask->tid();
+	}
+}
+
+
+TimerPool::~TimerPool()
+{
+	try
+	{
+		for (std::vector<PooledTimer>::iterator it = _timers.begin(); it != _timers.end(); ++it)
+		{
+			it->pTimer->cancel(true);
+		}
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+Poco::Util::Timer& TimerPool::acquireTimer()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	std::vector<PooledTimer>::iterator itMin = _timers.begin();
+	for (std::vector<PooledTimer>::iterator it = _timers.begin(); it != _timers.end(); ++it)
+	{
+		if (it->usage < itMin->usage) itMin = it;
+	}
+	itMin->usage++;
+	return *itMin->pTimer;
+}
+
+
+void TimerPool::releaseTimer(Poco::Util::Timer& timer)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	for (std::vector<PooledTimer>::iterator it = _timers.begin(); it != _timers.end(); ++it)
+	{
+		if (it->pTimer.get() == &timer)
+		{
+			poco_assert (it->usage > 0);
+			it->usage--;
+			return;
+		}
+	}
+	throw Poco::NotFoundException("Timer does not belong to this TimerPool");
+}
+
+
+std::size_t TimerPool::used() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	std::size_t total = 0;
+	for (std::vector<PooledTimer>::const_iterator it = _timers.begin(); it != _timers.end(); ++it)
+	{
+		total += it->usage;
+	}
+	return total;
+}
+
+
+bool TimerPool::isTimerThread() const
+{
+	Poco::Thread::TID tid = Poco::Thread::currentTid();
+	for (std::vector<PooledTimer>::const_iterator it = _timers.begin(); it != _timers.end(); ++it)
+	{
+		if (it->tid == tid) return true;
+	}
+	return false;
+}
+
+
+} } } // namespace Poco::JS::Core
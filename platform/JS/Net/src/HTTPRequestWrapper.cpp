@@ -18,9 +18,10 @@
 #include "Poco/JS/Core/JSExecutor.h"
 #include "Poco/JS/Core/BufferWrapper.h"
 #include "Poco/Net/HTTPClientSession.h"
-#include "Poco/Net/HTTPSessionFactory.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
 #include "Poco/Net/HTTPResponse.h"
 #include "Poco/Net/HTTPBasicCredentials.h"
+#include "Poco/Net/NetException.h"
 #include "Poco/Util/TimerTask.h"
 #include "Poco/URI.h"
 #include "Poco/SharedPtr.h"
@@ -37,6 +38,47 @@ namespace Net {
 static Poco::AtomicCounter _cnt;
 
 
+static void sendPooledRequest(const Poco::URI& uri, const Poco::Timespan& timeout, Poco::Net::HTTPRequest& request, const std::string& body, Poco::Net::HTTPResponse& response, std::string& responseBody)
+	/// Sends the request using a session from the default HTTPClientSessionPool
+	/// and reads the complete response. An idempotent request that fails because
+	/// the server has closed a reused keep-alive connection is sent once more
+	/// on a new session.
+{
+	Poco::Net::HTTPClientSessionPool& pool = Poco::Net::HTTPClientSessionPool::defaultPool();
+	Poco::Net::HTTPClientSessionPool::SessionPtr pCS = pool.acquire(uri);
+	try
+	{
+		std::istream* pResponseStream = 0;
+		try
+		{
+			pCS->setTimeout(timeout);
+			pCS->sendRequest(request).write(body.data(), body.size());
+			pResponseStream = &pCS->receiveResponse(response);
+		}
+		catch (Poco::Net::NetException&)
+		{
+			pCS = pool.reconnect(pCS, request.getMethod());
+			if (!pCS) throw;
+			pCS->setTimeout(timeout);
+			pCS->sendRequest(request).write(body.data(), body.size());
+			pResponseStream = &pCS->receiveResponse(response);
+		}
+		std::streamsize contentLength = response.getContentLength();
+		if (contentLength != Poco::Net::HTTPMessage::UNKNOWN_CONTENT_LENGTH)
+		{
+			responseBody.reserve(static_cast<std::size_t>(contentLength));
+		}
+		Poco::StreamCopier::copyToString(*pResponseStream, responseBody);
+		pool.release(pCS);
+	}
+	catch (...)
+	{
+		if (pCS) pool.discard(pCS);
+		throw;
+	}
+}
+
+
 RequestHolder::RequestHolder():
 	_timeout(30, 0)
 {
@@ -364,20 +406,11 @@ void HTTPRequestWrapper::sendBlocking(const v8::FunctionCallbackInfo<v8::Value>&
 		std::string uriPath = uri.getPathEtc();
 		if (uriPath.empty()) uriPath = "/";
 		pRequestHolder->request().setURI(uriPath);
-		Poco::SharedPtr<Poco::Net::HTTPClientSession> pCS = Poco::Net::HTTPSessionFactory::defaultFactory().createClientSession(uri);
 		if (pRequestHolder->request().getMethod() == Poco::Net::HTTPRequest::HTTP_PUT || pRequestHolder->request().getMethod() == Poco::Net::HTTPRequest::HTTP_POST || pRequestHolder->request().getMethod() == Poco::Net::HTTPRequest::HTTP_PATCH)
 		{
 			pRequestHolder->request().setContentLength(pRequestHolder->content().length());
 		}
-		pCS->setTimeout(pRequestHolder->getTimeout());
-		pCS->sendRequest(pRequestHolder->request()).write(pRequestHolder->content().data(), pRequestHolder->content().size());
-		std::istream& istr = pCS->receiveResponse(pResponseHolder->response());
-		std::streamsize contentLength = pResponseHolder->response().getContentLength();
-		if (contentLength != Poco::Net::HTTPMessage::UNKNOWN_CONTENT_LENGTH)
-		{
-			pResponseHolder->content().reserve(static_cast<std::size_t>(contentLength));
-		}
-		Poco::StreamCopier::copyToString(istr, pResponseHolder->content());
+		sendPooledRequest(uri, pRequestHolder->getTimeout(), pRequestHolder->request(), pRequestHolder->content(), pResponseHolder->response(), pResponseHolder->content());
 		HTTPResponseWrapper wrapper;
 		v8::Persistent<v8::Object>& responseObject(wrapper.wrapNativePersistent(args.GetIsolate(), pResponseHolder));
 		args.GetReturnValue().Set(responseObject);
@@ -490,10 +523,11 @@ private:
 class AsyncRequest: public Poco::Runnable
 {
 public:
-	AsyncRequest(v8::Isolate* pIsolate, Poco::JS::Core::JSExecutor::Ptr pExecutor, Poco::SharedPtr<Poco::Net::HTTPClientSession> pSession, Poco::SharedPtr<Poco::Net::HTTPRequest> pRequest, const std::string& body, v8::Local<v8::Function>& function):
+	AsyncRequest(v8::Isolate* pIsolate, Poco::JS::Core::JSExecutor::Ptr pExecutor, const Poco::URI& uri, const Poco::Timespan& timeout, Poco::SharedPtr<Poco::Net::HTTPRequest> pRequest, const std::string& body, v8::Local<v8::Function>& function):
 		_pIsolate(pIsolate),
 		_pExecutor(pExecutor),
-		_pSession(pSession),
+		_uri(uri),
+		_timeout(timeout),
 		_pRequest(pRequest),
 		_body(body),
 		_function(pIsolate, function)
@@ -510,16 +544,11 @@ public:
 		Poco::JS::Core::TimedJSExecutor::Ptr pTimedJSExecutor = _pExecutor.cast<Poco::JS::Core::TimedJSExecutor>();
 		try
 		{
-			_pSession->sendRequest(*_pRequest).write(_body.data(), _body.size());
+			// The session is acquired here rather than in sendAsync(), as
+			// acquire() may block until a session for the host is available.
 			Poco::SharedPtr<Poco::Net::HTTPResponse> pResponse = new Poco::Net::HTTPResponse;
-			std::istream& istr = _pSession->receiveResponse(*pResponse);
 			std::string responseBody;
-			std::streamsize contentLength = pResponse->getContentLength();
-			if (contentLength != Poco::Net::HTTPMessage::UNKNOWN_CONTENT_LENGTH)
-			{
-				responseBody.reserve(static_cast<std::size_t>(contentLength));
-			}
-			Poco::StreamCopier::copyToString(istr, responseBody);
+			sendPooledRequest(_uri, _timeout, *_pRequest, _body, *pResponse, responseBody);
 			if (pTimedJSExecutor)
 			{
 				pTimedJSExecutor->schedule(new AsyncRequestCompletionTask(_pIsolate, _pExecutor, pResponse, responseBody, _function));
@@ -542,7 +571,8 @@ public:
 private:
 	v8::Isolate* _pIsolate;
 	Poco::JS::Core::JSExecutor::Ptr _pExecutor;
-	Poco::SharedPtr<Poco::Net::HTTPClientSession> _pSession;
+	Poco::URI _uri;
+	Poco::Timespan _timeout;
 	Poco::SharedPtr<Poco::Net::HTTPRequest> _pRequest;
 	std::string _body;
 	v8::Persistent<v8::Function> _function;
@@ -563,15 +593,13 @@ void HTTPRequestWrapper::sendAsync(const v8::FunctionCallbackInfo<v8::Value>& ar
 		pRequestHolder->request().setURI(uriPath);
 		Poco::SharedPtr<Poco::Net::HTTPRequest> pRequest = new Poco::Net::HTTPRequest(pRequestHolder->request().getMethod(), uriPath, pRequestHolder->request().getVersion());
 		static_cast<Poco::Net::MessageHeader&>(*pRequest) = pRequestHolder->request();
-		Poco::SharedPtr<Poco::Net::HTTPClientSession> pCS = Poco::Net::HTTPSessionFactory::defaultFactory().createClientSession(uri);
 		if (pRequest->getMethod() == Poco::Net::HTTPRequest::HTTP_PUT || pRequest->getMethod() == Poco::Net::HTTPRequest::HTTP_POST)
 		{
 			pRequest->setContentLength(pRequestHolder->content().length());
 		}
-		pCS->setTimeout(pRequestHolder->getTimeout());
 
 		Poco::JS::Core::JSExecutor::Ptr pExecutor = Poco::JS::Core::JSExecutor::current();
-		AsyncRequest* pAsyncRequest = new AsyncRequest(args.GetIsolate(), pExecutor, pCS, pRequest, pRequestHolder->content(), function);
+		AsyncRequest* pAsyncRequest = new AsyncRequest(args.GetIsolate(), pExecutor, uri, pRequestHolder->getTimeout(), pRequest, pRequestHolder->content(), function);
 		try
 		{
 			Poco::ThreadPool::defaultPool().start(*pAsyncRequest);
@@ -0,0 +1,221 @@
+//
+// TimerPoolBenchmark.cpp
+//
+// This sample measures the effect of running TimedJSExecutors on a
+// shared TimerPool.
+//
+// A number of executors each run a small script that sets up an
+// interval timer. This is done first with every executor having its
+// own timer thread, then with all executors sharing the timers of a
+// TimerPool. For both, the number of threads and the resident set size
+// of the process (Linux only, from /proc/self/status), as well as the
+// average and maximum timer lag (jitter) of the interval callbacks
+// are reported.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/JS/Core/JSExecutor.h"
+#include "Poco/JS/Core/TimerPool.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/FileStream.h"
+#include "Poco/String.h"
+#include "Poco/Thread.h"
+#include "Poco/Format.h"
+#include "Poco/URI.h"
+#include <vector>
+#include <iostream>
+
+
+using Poco::JS::Core::TimedJSExecutor;
+using Poco::JS::Core::JSExecutor;
+using Poco::JS::Core::TimerPool;
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+
+
+class TimerPoolBenchmark: public Application
+	/// Try TimerPoolBenchmark --help (on Unix platforms) or
+	/// TimerPoolBenchmark /help (elsewhere) for more information.
+{
+public:
+	TimerPoolBenchmark():
+		_helpRequested(false)
+	{
+	}
+
+protected:
+	void initialize(Application& self)
+	{
+		Application::initialize(self);
+		Poco::JS::Core::initialize();
+	}
+
+	void uninitialize()
+	{
+		Application::uninitialize();
+		Poco::JS::Core::uninitialize();
+	}
+
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(Poco::Util::OptionCallback<TimerPoolBenchmark>(this, &TimerPoolBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("executors", "e", "Specify the number of executors (default 200).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 100000))
+				.binding("benchmark.executors"));
+
+		options.addOption(
+			Option("pool", "p", "Specify the number of threads in the TimerPool (default 4).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 1024))
+				.binding("benchmark.pool"));
+
+		options.addOption(
+			Option("interval", "i", "Specify the script timer interval in milliseconds (default 100).")
+				.required(false)
+				.repeatable(false)
+				.argument("<ms>")
+				.validator(new IntValidator(1, 60000))
+				.binding("benchmark.interval"));
+
+		options.addOption(
+			Option("duration", "d", "Specify the duration of each measurement in seconds (default 10).")
+				.required(false)
+				.repeatable(false)
+				.argument("<s>")
+				.validator(new IntValidator(1, 3600))
+				.binding("benchmark.duration"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("A benchmark for TimedJSExecutors sharing a TimerPool.");
+		helpFormatter.format(std::cout);
+	}
+
+	static std::string processStatus(const std::string& key)
+		/// Returns the value of the given key from /proc/self/status,
+		/// or an empty string if not available.
+	{
+		try
+		{
+			Poco::FileInputStream istr("/proc/self/status");
+			std::string line;
+			while (std::getline(istr, line))
+			{
+				if (line.compare(0, key.size(), key) == 0 && line.size() > key.size() && line[key.size()] == ':')
+				{
+					return Poco::trim(line.substr(key.size() + 1));
+				}
+			}
+		}
+		catch (Poco::Exception&)
+		{
+		}
+		return std::string();
+	}
+
+	void measure(const std::string& title, TimerPool::Ptr pTimerPool, int executors, int interval, int duration)
+	{
+		std::string script = Poco::format(
+			"setInterval(function() { var x = 0; for (var i = 0; i < 100; i++) x += i; }, %d);",
+			interval);
+		std::vector<std::string> moduleSearchPaths;
+
+		std::vector<TimedJSExecutor::Ptr> jsExecutors;
+		for (int i = 0; i < executors; i++)
+		{
+			Poco::URI uri(Poco::format("benchmark:executor%d.js", i));
+			TimedJSExecutor::Ptr pExecutor = new TimedJSExecutor(script, uri, moduleSearchPaths, pTimerPool);
+			pExecutor->run();
+			jsExecutors.push_back(pExecutor);
+		}
+
+		Poco::Thread::sleep(duration*1000);
+
+		std::string threads = processStatus("Threads");
+		std::string rss = processStatus("VmRSS");
+
+		Poco::UInt64 callbacks = 0;
+		Poco::UInt64 lagTotal = 0;
+		Poco::UInt64 lagMax = 0;
+		for (std::vector<TimedJSExecutor::Ptr>::iterator it = jsExecutors.begin(); it != jsExecutors.end(); ++it)
+		{
+			JSExecutor::Statistics stats = (*it)->statistics();
+			callbacks += stats.timerCallbacks;
+			lagTotal += stats.timerLagTotal;
+			if (stats.timerLagMax > lagMax) lagMax = stats.timerLagMax;
+			(*it)->stop();
+		}
+		jsExecutors.clear();
+
+		std::cout
+			<< Poco::format("%-20s threads: %5s  RSS: %12s  callbacks: %8Lu  lag avg: %8.1f us  max: %8Lu us",
+				title,
+				threads.empty() ? std::string("n/a") : threads,
+				rss.empty() ? std::string("n/a") : rss,
+				callbacks,
+				callbacks > 0 ? double(lagTotal)/callbacks : 0.0,
+				lagMax)
+			<< std::endl;
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		int executors = config().getInt("benchmark.executors", 200);
+		int poolSize = config().getInt("benchmark.pool", 4);
+		int interval = config().getInt("benchmark.interval", 100);
+		int duration = config().getInt("benchmark.duration", 10);
+
+		std::cout << Poco::format("%d executors, %d ms interval, %d s per measurement", executors, interval, duration) << std::endl;
+		measure("Own timer", 0, executors, interval, duration);
+		measure(Poco::format("TimerPool (%d)", poolSize), new TimerPool(poolSize), executors, interval, duration);
+
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+};
+
+
+POCO_APP_MAIN(TimerPoolBenchmark)
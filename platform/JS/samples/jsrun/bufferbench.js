@@ -0,0 +1,64 @@
+//
+// bufferbench.js
+//
+// Measures the throughput of decoding binary frames held in a Buffer,
+// using Buffer indexed properties, a Uint8Array view obtained with
+// toUint8Array(), and a Buffer created with Buffer.fromArrayBuffer().
+//
+// Usage: jsrun bufferbench.js [<frames> [<frameSize>]]
+//
+
+var frames = $args.length > 0 ? parseInt($args[0]) : 20000;
+var frameSize = $args.length > 1 ? parseInt($args[1]) : 64;
+
+var data = [];
+for (var i = 0; i < frameSize; i++) data.push(i & 0xFF);
+var buffer = new Buffer(data);
+
+function decodeBuffer(buf)
+{
+	var sum = 0;
+	for (var i = 0; i < buf.length; i++) sum += buf[i];
+	return sum;
+}
+
+function decodeUint8Array(arr)
+{
+	var sum = 0;
+	for (var i = 0; i < arr.length; i++) sum += arr[i];
+	return sum;
+}
+
+function measure(title, fn)
+{
+	var check = 0;
+	var start = Date.now();
+	for (var i = 0; i < frames; i++) check += fn();
+	var elapsed = Date.now() - start;
+	var mbs = elapsed > 0 ? (frames*frameSize/1048576)/(elapsed/1000) : 0;
+	console.log('%s: %d ms, %d frames/s, %d MB/s (checksum %d)',
+		title,
+		elapsed,
+		elapsed > 0 ? Math.round(frames*1000/elapsed) : 0,
+		Math.round(mbs*10)/10,
+		check);
+}
+
+console.log('%d frames, %d bytes/frame', frames, frameSize);
+
+measure('Buffer indexed access', function() {
+	return decodeBuffer(buffer);
+});
+
+measure('Buffer.toUint8Array()', function() {
+	return decodeUint8Array(buffer.toUint8Array());
+});
+
+var typedArray = new Uint8Array(data);
+measure('Buffer.fromArrayBuffer()', function() {
+	return decodeBuffer(Buffer.fromArrayBuffer(typedArray));
+});
+
+measure('new Buffer(typedArray)', function() {
+	return new Buffer(typedArray).length;
+});
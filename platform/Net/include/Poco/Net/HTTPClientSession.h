@@ -317,6 +317,7 @@ private:
 	HTTPClientSession& operator = (const HTTPClientSession&);
 
 	friend class WebSocket;
+	friend class HTTPClientSessionPool;
 };
 
 
@@ -0,0 +1,284 @@
+//
+// HTTPClientSessionPool.h
+//
+// Library: Net
+// Package: HTTPClient
+// Module:  HTTPClientSessionPool
+//
+// Definition of the HTTPClientSessionPool class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_HTTPClientSessionPool_INCLUDED
+#define Net_HTTPClientSessionPool_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/URI.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Timespan.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Condition.h"
+#include "Poco/Mutex.h"
+#include "Poco/Event.h"
+#include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
+#include <vector>
+#include <map>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API HTTPClientSessionPool
+	/// A pool of persistent (keep-alive) HTTPClientSession objects.
+	///
+	/// Sessions are pooled by URI scheme, host and port, as well as
+	/// proxy configuration. A session obtained with acquire() must
+	/// be given back to the pool with release() after the response
+	/// has been read completely, or with discard() if the session
+	/// must not be reused (e.g., after an error, or if the
+	/// response has not been read completely).
+	///
+	/// Idle sessions are closed after the idle timeout has expired.
+	/// Before an idle session is handed out again, it is checked
+	/// whether the connection is still open and has not received
+	/// any unexpected data (e.g., because the server has closed
+	/// the connection). Idle sessions are also checked and
+	/// removed with every call to acquire(), release() or purge(),
+	/// and periodically by a background thread, which runs as
+	/// long as the pool holds idle sessions.
+	///
+	/// As the server may still close an idle connection after it
+	/// has been handed out, sending a request on a reused session
+	/// can fail. In this case, an idempotent request can be sent
+	/// again on a new session obtained from reconnect().
+	///
+	/// The number of sessions per host (in use and idle) is limited.
+	/// If the limit has been reached, acquire() waits until another
+	/// session for the same host becomes available.
+	///
+	/// New sessions are created with the default HTTPSessionFactory,
+	/// if an instantiator for the URI scheme has been registered
+	/// (this is required for https). For http, a HTTPClientSession
+	/// is created directly otherwise.
+{
+public:
+	typedef Poco::SharedPtr<HTTPClientSession> SessionPtr;
+
+	enum
+	{
+		DEFAULT_MAX_SESSIONS = 16,
+			/// Default maximum number of sessions per host.
+		DEFAULT_MAX_IDLE_SESSIONS = 4,
+			/// Default maximum number of idle sessions per host.
+		DEFAULT_IDLE_TIMEOUT = 8,
+			/// Default idle timeout in seconds.
+		DEFAULT_ACQUIRE_TIMEOUT = 30,
+			/// Default timeout in seconds for acquire() to wait
+			/// for a session if the limit has been reached.
+		DEFAULT_PURGE_INTERVAL = 2
+			/// Default interval in seconds at which idle sessions
+			/// are purged in the background.
+	};
+
+	HTTPClientSessionPool();
+		/// Creates the HTTPClientSessionPool with default settings.
+
+	~HTTPClientSessionPool();
+		/// Destroys the HTTPClientSessionPool and closes all idle sessions.
+
+	SessionPtr acquire(const Poco::URI& uri);
+		/// Returns a session for the scheme, host and port given
+		/// in uri, using the proxy configuration of the default
+		/// HTTPSessionFactory, or the global proxy configuration
+		/// of HTTPClientSession if the factory has no proxy.
+		///
+		/// Returns an idle session if one is available. Otherwise
+		/// creates a new session with keep-alive enabled.
+		///
+		/// Throws a Poco::TimeoutException if the session limit for
+		/// the host has been reached and no session becomes available
+		/// within the acquire timeout. Throws a Poco::UnknownURISchemeException
+		/// if no session can be created for the URI scheme.
+
+	SessionPtr acquire(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig);
+		/// Returns a session for the scheme, host and port given
+		/// in uri, using the given proxy configuration.
+		///
+		/// See acquire(const Poco::URI&) for more information.
+
+	void release(SessionPtr pSession);
+		/// Returns a session obtained from acquire() to the pool.
+		///
+		/// The response to the last request must have been read
+		/// completely. The session is kept for reuse unless it has
+		/// been disconnected, the server has not agreed to keep the
+		/// connection open, or the maximum number of idle sessions
+		/// for the host has been reached.
+
+	void discard(SessionPtr pSession);
+		/// Removes a session obtained from acquire() from the pool
+		/// without reusing it.
+
+	SessionPtr reconnect(SessionPtr pSession, const std::string& method);
+		/// Must be called if sending a request with the given method,
+		/// or receiving its response, has failed on a session obtained
+		/// from acquire() with a Poco::Net::NetException.
+		///
+		/// If the session has been reused and the method is idempotent,
+		/// the server has most likely closed the connection while the
+		/// session was idle. The session is discarded and a new session
+		/// for the same host and proxy configuration is returned, so that
+		/// the request can be sent once more. The new session never
+		/// is a reused one, so a second failure is reported to the caller.
+		///
+		/// Otherwise, the session is discarded and a null pointer
+		/// is returned.
+
+	bool isReused(SessionPtr pSession) const;
+		/// Returns true if the given session, obtained from acquire(),
+		/// is an idle session that has been reused.
+
+	static bool isIdempotent(const std::string& method);
+		/// Returns true if a request with the given method can
+		/// safely be sent again (GET, HEAD, PUT, DELETE, OPTIONS
+		/// and TRACE, see RFC 7231, section 4.2.2).
+
+	void purge();
+		/// Closes all idle sessions that have expired or whose
+		/// connection is no longer usable.
+		///
+		/// Called periodically by the background purge thread.
+
+	void clear();
+		/// Closes all idle sessions.
+
+	void setMaxSessions(int maxSessions);
+		/// Sets the maximum number of sessions (in use and idle) per host.
+
+	int getMaxSessions() const;
+		/// Returns the maximum number of sessions per host.
+
+	void setMaxIdleSessions(int maxIdleSessions);
+		/// Sets the maximum number of idle sessions kept per host.
+		/// Setting this to zero disables reuse of sessions.
+
+	int getMaxIdleSessions() const;
+		/// Returns the maximum number of idle sessions kept per host.
+
+	void setIdleTimeout(const Poco::Timespan& timeout);
+		/// Sets the time after which an idle session is closed.
+
+	Poco::Timespan getIdleTimeout() const;
+		/// Returns the time after which an idle session is closed.
+
+	void setAcquireTimeout(const Poco::Timespan& timeout);
+		/// Sets the maximum time acquire() waits for a session
+		/// if the session limit for a host has been reached.
+
+	Poco::Timespan getAcquireTimeout() const;
+		/// Returns the maximum time acquire() waits for a session.
+
+	void setPurgeInterval(const Poco::Timespan& interval);
+		/// Sets the interval at which idle sessions are purged
+		/// in the background. Setting this to zero disables the
+		/// background purge thread.
+
+	Poco::Timespan getPurgeInterval() const;
+		/// Returns the interval at which idle sessions are purged
+		/// in the background.
+
+	int idle() const;
+		/// Returns the number of idle sessions.
+
+	int active() const;
+		/// Returns the number of sessions currently in use.
+
+	int created() const;
+		/// Returns the number of sessions that have been created.
+
+	int reused() const;
+		/// Returns the number of times an idle session has been reused.
+
+	static HTTPClientSessionPool& defaultPool();
+		/// Returns a reference to the default HTTPClientSessionPool,
+		/// which is used by the HTTPStreamFactory.
+
+protected:
+	struct IdleSession
+	{
+		SessionPtr pSession;
+		Poco::Timestamp idleSince;
+	};
+
+	struct HostEntry
+	{
+		HostEntry();
+
+		std::vector<IdleSession> idle;
+		int active;
+	};
+
+	struct ActiveSession
+	{
+		std::string key;
+		Poco::URI uri;
+		HTTPClientSession::ProxyConfig proxyConfig;
+		bool reused;
+	};
+
+	typedef std::map<std::string, HostEntry> HostMap;
+	typedef std::map<HTTPClientSession*, ActiveSession> ActiveMap;
+
+	SessionPtr createSession(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig);
+		/// Creates a new session for the given URI and proxy configuration.
+
+	bool usable(const IdleSession& idleSession, const Poco::Timestamp& now) const;
+		/// Returns true if the idle session has not expired and its
+		/// connection is still open.
+
+	void purgeImpl();
+	void returnSession(SessionPtr pSession, bool reuse);
+	void startPurgeThread();
+	void runPurgeThread();
+
+	static std::string key(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig);
+		/// Returns the key identifying sessions for the given URI
+		/// and proxy configuration.
+
+private:
+	HTTPClientSessionPool(const HTTPClientSessionPool&);
+	HTTPClientSessionPool& operator = (const HTTPClientSessionPool&);
+
+	int _maxSessions;
+	int _maxIdleSessions;
+	Poco::Timespan _idleTimeout;
+	Poco::Timespan _acquireTimeout;
+	Poco::Timespan _purgeInterval;
+	HostMap _hosts;
+	ActiveMap _active;
+	int _idle;
+	int _created;
+	int _reused;
+	mutable Poco::FastMutex _mutex;
+	Poco::Condition _available;
+	Poco::RunnableAdapter<HTTPClientSessionPool> _purgeRunnable;
+	Poco::Thread _purgeThread;
+	Poco::Event _purgeWakeUp;
+	bool _purging;
+	bool _stopping;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPClientSessionPool_INCLUDED
@@ -21,6 +21,7 @@
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPResponse.h"
 #include "Poco/UnbufferedStreamBuf.h"
+#include "Poco/SharedPtr.h"
 
 
 namespace Poco {
@@ -28,6 +29,7 @@ namespace Net {
 
 
 class HTTPClientSession;
+class HTTPClientSessionPool;
 
 
 class Net_API HTTPResponseStreamBuf: public Poco::UnbufferedStreamBuf
@@ -74,11 +76,25 @@ class Net_API HTTPResponseStream: public HTTPResponseIOS, public std::istream
 {
 public:
 	HTTPResponseStream(std::istream& istr, HTTPClientSession* pSession);
+		/// Creates the HTTPResponseStream, which takes ownership
+		/// of the given session.
+
+	HTTPResponseStream(std::istream& istr, Poco::SharedPtr<HTTPClientSession> pSession, HTTPClientSessionPool* pPool);
+		/// Creates the HTTPResponseStream, which shares ownership
+		/// of the given session.
+		///
+		/// If pPool is not null, the session must have been obtained
+		/// from that pool. When the stream is destroyed, the session
+		/// is returned to the pool if the response has been read
+		/// completely, or discarded otherwise.
 		
 	~HTTPResponseStream();
 	
 private:
+	std::istream& _istr;
 	HTTPClientSession* _pSession;
+	HTTPClientSessionPool* _pPool;
+	Poco::SharedPtr<HTTPClientSession> _pSharedSession;
 };
 
 
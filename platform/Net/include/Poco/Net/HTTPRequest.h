@@ -133,6 +133,15 @@ public:
 	void read(std::istream& istr);
 		/// Reads the HTTP request from the
 		/// given input stream.
+
+	void parse(const char* pBegin, const char* pEnd);
+		/// Parses the HTTP request line and header from the given
+		/// buffer, which must contain the complete request header,
+		/// including the terminating empty line.
+		///
+		/// Performs the same checks as read(), but avoids reading
+		/// the request header character by character from a stream.
+		/// See MessageHeader::parse() for more information.
 		
 	static const std::string HTTP_GET;
 	static const std::string HTTP_HEAD;
@@ -152,6 +161,10 @@ public:
 	static const std::string EXPECT;
 
 protected:
+	static const char* skipLine(const char* p, const char* pEnd);
+		/// Returns a pointer to the beginning of the next line,
+		/// or pEnd if there is no next line.
+
 	void getCredentials(const std::string& header, std::string& scheme, std::string& authInfo) const;
 		/// Returns the authentication scheme and additional authentication
 		/// information contained in the given header of request.
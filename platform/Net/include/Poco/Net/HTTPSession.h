@@ -160,6 +160,20 @@ protected:
 
 	void refill();
 		/// Refills the internal buffer.
+
+	bool peekHeader(const char*& pBegin, const char*& pEnd);
+		/// Checks whether the internal buffer contains a complete
+		/// message header, terminated by an empty line. If so, sets
+		/// pBegin and pEnd to the beginning and end (just past the empty
+		/// line) of the header in the buffer and returns true. The header
+		/// is not removed from the buffer; use skip() for that.
+		///
+		/// If the buffer is empty, it is refilled first. Otherwise, no
+		/// data is received, so false is also returned if the header has
+		/// only partially been received yet.
+
+	void skip(std::streamsize length);
+		/// Removes the given number of bytes from the internal buffer.
 		
 	virtual void connect(const SocketAddress& address);
 		/// Connects the underlying socket to the given address
@@ -203,6 +217,7 @@ private:
 	friend class HTTPHeaderStreamBuf;
 	friend class HTTPFixedLengthStreamBuf;
 	friend class HTTPChunkedStreamBuf;
+	friend class HTTPServerRequestImpl;
 };
 
 
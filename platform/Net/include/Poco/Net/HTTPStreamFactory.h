@@ -64,6 +64,10 @@ public:
 		/// UnsupportedRedirectException exception is thrown.
 		/// The offending URI can then be obtained via the message()
 		/// method of UnsupportedRedirectException.
+		///
+		/// Sessions are obtained from the default HTTPClientSessionPool.
+		/// The session is returned to the pool when the stream is
+		/// destroyed after the response has been read completely.
 		
 	static void registerFactory();
 		/// Registers the HTTPStreamFactory with the
@@ -86,6 +86,21 @@ public:
 		///
 		/// Throws a MessageException if the input stream is
 		/// malformed.
+
+	const char* parse(const char* pBegin, const char* pEnd);
+		/// Parses the message header from the given buffer.
+		///
+		/// Accepts the same format and performs the same sanity
+		/// checks as read(), but locates line ends and separators
+		/// with memchr() and creates the name and value strings
+		/// directly from the buffer, instead of reading the header
+		/// character by character from a stream.
+		///
+		/// Parsing stops at the first empty line, or at the end of
+		/// the buffer. Returns a pointer to the first character of
+		/// the empty line, or pEnd.
+		///
+		/// Throws a MessageException if the header is malformed.
 		
 	int getFieldLimit() const;
 		/// Returns the maximum number of header fields
@@ -149,6 +164,13 @@ public:
 	static std::string decodeWord(const std::string& text, const std::string& charset = "UTF-8");
 	        /// Decode RFC2047 string.
 
+protected:
+	void addField(const std::string& name, const std::string& value);
+		/// Adds the given field, decoding RFC 2047 encoded words
+		/// in the value, if there are any.
+
+	static const char* parseValue(const char* p, const char* pEnd, std::string& value, bool folded);
+		/// Parses a (possibly folded) field value line for parse().
 		
 private:
 	enum Limits
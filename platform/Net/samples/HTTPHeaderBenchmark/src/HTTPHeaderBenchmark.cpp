@@ -0,0 +1,241 @@
+//
+// HTTPHeaderBenchmark.cpp
+//
+// This sample measures the throughput of the HTTP request header parser.
+//
+// First, a typical browser request header is parsed repeatedly, both
+// with HTTPRequest::read() from a stream, and with HTTPRequest::parse()
+// from a buffer, which is what HTTPServer uses if the complete request
+// header has been received. Then, requests/second are measured end-to-end
+// with a HTTPServer and a single persistent HTTPClientSession on the
+// loopback interface.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/NullStream.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Format.h"
+#include <sstream>
+#include <iostream>
+
+
+using Poco::Net::HTTPServer;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::HTTPClientSession;
+using Poco::Net::HTTPRequest;
+using Poco::Net::HTTPResponse;
+using Poco::Net::HTTPMessage;
+using Poco::Net::ServerSocket;
+using Poco::Net::SocketAddress;
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	const std::string REQUEST_HEADER(
+		"GET /macchina/launcher/index.html?lang=en HTTP/1.1\r\n"
+		"Host: localhost:22080\r\n"
+		"Connection: keep-alive\r\n"
+		"Upgrade-Insecure-Requests: 1\r\n"
+		"User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/67.0.3396.99 Safari/537.36\r\n"
+		"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/webp,image/apng,*/*;q=0.8\r\n"
+		"Referer: http://localhost:22080/macchina/launcher/\r\n"
+		"Accept-Encoding: gzip, deflate, br\r\n"
+		"Accept-Language: en-US,en;q=0.9,de;q=0.8\r\n"
+		"Cookie: osp.web.session.com.appinf.osp.launcher=8f3a2c91d04b6e57a1c9f0e2d3b4a5c6\r\n"
+		"\r\n");
+}
+
+
+class NullRequestHandler: public HTTPRequestHandler
+{
+public:
+	void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+	{
+		response.setContentLength(0);
+		response.send();
+	}
+};
+
+
+class NullRequestHandlerFactory: public HTTPRequestHandlerFactory
+{
+public:
+	HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
+	{
+		return new NullRequestHandler;
+	}
+};
+
+
+class HTTPHeaderBenchmark: public Application
+	/// Try HTTPHeaderBenchmark --help (on Unix platforms) or
+	/// HTTPHeaderBenchmark /help (elsewhere) for more information.
+{
+public:
+	HTTPHeaderBenchmark():
+		_helpRequested(false)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(Poco::Util::OptionCallback<HTTPHeaderBenchmark>(this, &HTTPHeaderBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("iterations", "n", "Specify the number of request headers to parse (default 200000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 100000000))
+				.binding("benchmark.iterations"));
+
+		options.addOption(
+			Option("requests", "r", "Specify the number of HTTP requests to send to the server (default 10000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 100000000))
+				.binding("benchmark.requests"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("A benchmark for the HTTP request header parser.");
+		helpFormatter.format(std::cout);
+	}
+
+	double parseStream(int iterations)
+	{
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < iterations; i++)
+		{
+			std::istringstream istr(REQUEST_HEADER);
+			HTTPRequest request;
+			request.read(istr);
+		}
+		sw.stop();
+		return double(sw.elapsed())/iterations;
+	}
+
+	double parseBuffer(int iterations)
+	{
+		const char* pBegin = REQUEST_HEADER.data();
+		const char* pEnd = pBegin + REQUEST_HEADER.size();
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < iterations; i++)
+		{
+			HTTPRequest request;
+			request.parse(pBegin, pEnd);
+		}
+		sw.stop();
+		return double(sw.elapsed())/iterations;
+	}
+
+	double serve(int requests)
+	{
+		ServerSocket socket(SocketAddress("127.0.0.1", 0));
+		HTTPServerParams::Ptr pParams = new HTTPServerParams;
+		pParams->setKeepAlive(true);
+		pParams->setMaxKeepAliveRequests(requests + 1);
+		HTTPServer server(new NullRequestHandlerFactory, socket, pParams);
+		server.start();
+
+		HTTPClientSession session("127.0.0.1", socket.address().port());
+		session.setKeepAlive(true);
+		HTTPRequest request;
+		std::istringstream istr(REQUEST_HEADER);
+		request.read(istr);
+		Poco::NullOutputStream nos;
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < requests; i++)
+		{
+			session.sendRequest(request);
+			HTTPResponse response;
+			std::istream& rs = session.receiveResponse(response);
+			Poco::StreamCopier::copyStream(rs, nos);
+		}
+		sw.stop();
+		server.stop();
+		return requests/(double(sw.elapsed())/Poco::Timestamp::resolution());
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		int iterations = config().getInt("benchmark.iterations", 200000);
+		int requests = config().getInt("benchmark.requests", 10000);
+
+		double streamTime = parseStream(iterations);
+		double bufferTime = parseBuffer(iterations);
+		std::cout << Poco::format("Request header: %z bytes, %d iterations", REQUEST_HEADER.size(), iterations) << std::endl;
+		std::cout << Poco::format("HTTPRequest::read():  %7.3f us/request, %10.0f requests/s", streamTime, 1000000.0/streamTime) << std::endl;
+		std::cout << Poco::format("HTTPRequest::parse(): %7.3f us/request, %10.0f requests/s", bufferTime, 1000000.0/bufferTime) << std::endl;
+
+		double rate = serve(requests);
+		std::cout << Poco::format("HTTPServer (loopback, keep-alive): %d requests, %.0f requests/s", requests, rate) << std::endl;
+
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+};
+
+
+POCO_APP_MAIN(HTTPHeaderBenchmark)
@@ -0,0 +1,217 @@
+//
+// HTTPSessionPoolBenchmark.cpp
+//
+// This sample measures the effect of the HTTPClientSessionPool.
+//
+// A HTTPServer on the loopback interface receives a number of small
+// POST requests, first sent with a new HTTPClientSession for every
+// request, then with sessions obtained from a HTTPClientSessionPool.
+// For both, the average request latency and the number of TCP
+// connections accepted by the server are reported.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/NullStream.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Thread.h"
+#include "Poco/URI.h"
+#include "Poco/Format.h"
+#include <iostream>
+
+
+using Poco::Net::HTTPServer;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::HTTPClientSession;
+using Poco::Net::HTTPClientSessionPool;
+using Poco::Net::HTTPRequest;
+using Poco::Net::HTTPResponse;
+using Poco::Net::HTTPMessage;
+using Poco::Net::ServerSocket;
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	const std::string TELEMETRY("{\"sensor\":\"temperature\",\"value\":21.5,\"unit\":\"Cel\"}");
+}
+
+
+class TelemetryRequestHandler: public HTTPRequestHandler
+{
+public:
+	void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+	{
+		Poco::NullOutputStream nos;
+		Poco::StreamCopier::copyStream(request.stream(), nos);
+		response.setStatusAndReason(HTTPResponse::HTTP_NO_CONTENT);
+		response.send();
+	}
+};
+
+
+class TelemetryRequestHandlerFactory: public HTTPRequestHandlerFactory
+{
+public:
+	HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
+	{
+		return new TelemetryRequestHandler;
+	}
+};
+
+
+class HTTPSessionPoolBenchmark: public Application
+	/// Try HTTPSessionPoolBenchmark --help (on Unix platforms) or
+	/// HTTPSessionPoolBenchmark /help (elsewhere) for more information.
+{
+public:
+	HTTPSessionPoolBenchmark():
+		_helpRequested(false)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(Poco::Util::OptionCallback<HTTPSessionPoolBenchmark>(this, &HTTPSessionPoolBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("requests", "n", "Specify the number of requests to send (default 2000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 10000000))
+				.binding("benchmark.requests"));
+
+		options.addOption(
+			Option("interval", "i", "Specify the interval between two requests in milliseconds (default 0).")
+				.required(false)
+				.repeatable(false)
+				.argument("<ms>")
+				.validator(new IntValidator(0, 60000))
+				.binding("benchmark.interval"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("A benchmark for the HTTPClientSessionPool.");
+		helpFormatter.format(std::cout);
+	}
+
+	void post(HTTPClientSession& session)
+	{
+		HTTPRequest request(HTTPRequest::HTTP_POST, "/telemetry", HTTPMessage::HTTP_1_1);
+		request.setContentType("application/json");
+		request.setContentLength(TELEMETRY.size());
+		session.sendRequest(request) << TELEMETRY;
+		HTTPResponse response;
+		std::istream& rs = session.receiveResponse(response);
+		Poco::NullOutputStream nos;
+		Poco::StreamCopier::copyStream(rs, nos);
+	}
+
+	void measure(const std::string& title, bool pooled, int requests, long interval)
+	{
+		ServerSocket socket(0);
+		HTTPServerParams::Ptr pParams = new HTTPServerParams;
+		pParams->setKeepAlive(true);
+		pParams->setKeepAliveTimeout(Poco::Timespan(10, 0));
+		HTTPServer server(new TelemetryRequestHandlerFactory, socket, pParams);
+		server.start();
+
+		Poco::URI uri("http://127.0.0.1");
+		uri.setPort(socket.address().port());
+		HTTPClientSessionPool pool;
+		Stopwatch sw;
+		for (int i = 0; i < requests; i++)
+		{
+			if (interval > 0) Poco::Thread::sleep(interval);
+			sw.start();
+			if (pooled)
+			{
+				HTTPClientSessionPool::SessionPtr pSession = pool.acquire(uri);
+				post(*pSession);
+				pool.release(pSession);
+			}
+			else
+			{
+				HTTPClientSession session(uri.getHost(), uri.getPort());
+				post(session);
+			}
+			sw.stop();
+		}
+		pool.clear();
+
+		std::cout << Poco::format("%-20s %10.1f us/request %8d connections", title, double(sw.elapsed())/requests, server.totalConnections()) << std::endl;
+		server.stop();
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		int requests = config().getInt("benchmark.requests", 2000);
+		long interval = config().getInt("benchmark.interval", 0);
+
+		std::cout << Poco::format("%d requests, %ld ms interval", requests, interval) << std::endl;
+		measure("New session", false, requests, interval);
+		measure("HTTPClientSessionPool", true, requests, interval);
+
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+};
+
+
+POCO_APP_MAIN(HTTPSessionPoolBenchmark)
@@ -0,0 +1,520 @@
+//
+// HTTPClientSessionPool.cpp
+//
+// Library: Net
+// Package: HTTPClient
+// Module:  HTTPClientSessionPool
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPClientSessionPool.h"
+#include "Poco/Net/HTTPSessionFactory.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/Socket.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/SingletonHolder.h"
+#include "Poco/Exception.h"
+
+
+using Poco::FastMutex;
+
+
+namespace Poco {
+namespace Net {
+
+
+HTTPClientSessionPool::HostEntry::HostEntry():
+	active(0)
+{
+}
+
+
+HTTPClientSessionPool::HTTPClientSessionPool():
+	_maxSessions(DEFAULT_MAX_SESSIONS),
+	_maxIdleSessions(DEFAULT_MAX_IDLE_SESSIONS),
+	_idleTimeout(DEFAULT_IDLE_TIMEOUT, 0),
+	_acquireTimeout(DEFAULT_ACQUIRE_TIMEOUT, 0),
+	_purgeInterval(DEFAULT_PURGE_INTERVAL, 0),
+	_idle(0),
+	_created(0),
+	_reused(0),
+	_purgeRunnable(*this, &HTTPClientSessionPool::runPurgeThread),
+	_purgeThread("HTTPClientSessionPool"),
+	_purging(false),
+	_stopping(false)
+{
+}
+
+
+HTTPClientSessionPool::~HTTPClientSessionPool()
+{
+	try
+	{
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			_stopping = true;
+		}
+		_purgeWakeUp.set();
+		_purgeThread.join();
+		clear();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+HTTPClientSessionPool::SessionPtr HTTPClientSessionPool::acquire(const Poco::URI& uri)
+{
+	HTTPSessionFactory& factory = HTTPSessionFactory::defaultFactory();
+	if (!factory.proxyHost().empty())
+	{
+		HTTPClientSession::ProxyConfig proxyConfig;
+		proxyConfig.host = factory.proxyHost();
+		proxyConfig.port = factory.proxyPort();
+		proxyConfig.username = factory.proxyUsername();
+		proxyConfig.password = factory.proxyPassword();
+		return acquire(uri, proxyConfig);
+	}
+	else return acquire(uri, HTTPClientSession::getGlobalProxyConfig());
+}
+
+
+HTTPClientSessionPool::SessionPtr HTTPClientSessionPool::acquire(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig)
+{
+	const std::string k = key(uri, proxyConfig);
+	Poco::Timestamp start;
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	purgeImpl();
+	for (;;)
+	{
+		HostEntry& entry = _hosts[k];
+		Poco::Timestamp now;
+		while (!entry.idle.empty())
+		{
+			IdleSession idleSession = entry.idle.back();
+			entry.idle.pop_back();
+			_idle--;
+			if (usable(idleSession, now))
+			{
+				entry.active++;
+				ActiveSession& activeSession = _active[idleSession.pSession.get()];
+				activeSession.key = k;
+				activeSession.uri = uri;
+				activeSession.proxyConfig = proxyConfig;
+				activeSession.reused = true;
+				_reused++;
+				return idleSession.pSession;
+			}
+		}
+		if (entry.active < _maxSessions) break;
+
+		long remaining = static_cast<long>(_acquireTimeout.totalMilliseconds() - start.elapsed()/1000);
+		if (remaining <= 0 || !_available.tryWait(_mutex, remaining))
+			throw Poco::TimeoutException("No HTTP session available", k);
+	}
+
+	SessionPtr pSession = createSession(uri, proxyConfig);
+	_hosts[k].active++;
+	ActiveSession& activeSession = _active[pSession.get()];
+	activeSession.key = k;
+	activeSession.uri = uri;
+	activeSession.proxyConfig = proxyConfig;
+	activeSession.reused = false;
+	_created++;
+	return pSession;
+}
+
+
+void HTTPClientSessionPool::release(SessionPtr pSession)
+{
+	bool reuse = pSession->connected() && !pSession->networkException() && !pSession->mustReconnect();
+	returnSession(pSession, reuse);
+}
+
+
+void HTTPClientSessionPool::discard(SessionPtr pSession)
+{
+	returnSession(pSession, false);
+}
+
+
+HTTPClientSessionPool::SessionPtr HTTPClientSessionPool::reconnect(SessionPtr pSession, const std::string& method)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	ActiveMap::iterator it = _active.find(pSession.get());
+	if (it == _active.end()) throw Poco::InvalidArgumentException("Session has not been acquired from this pool");
+
+	if (it->second.reused && isIdempotent(method))
+	{
+		// The new session takes the place of the discarded one,
+		// so the number of active sessions for the host is unchanged.
+		SessionPtr pNewSession = createSession(it->second.uri, it->second.proxyConfig);
+		ActiveSession activeSession(it->second);
+		activeSession.reused = false;
+		_active.erase(it);
+		_active[pNewSession.get()] = activeSession;
+		_created++;
+		return pNewSession;
+	}
+	else
+	{
+		_hosts[it->second.key].active--;
+		_active.erase(it);
+		purgeImpl();
+		_available.broadcast();
+		return SessionPtr();
+	}
+}
+
+
+bool HTTPClientSessionPool::isReused(SessionPtr pSession) const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	ActiveMap::const_iterator it = _active.find(pSession.get());
+	if (it == _active.end()) throw Poco::InvalidArgumentException("Session has not been acquired from this pool");
+
+	return it->second.reused;
+}
+
+
+bool HTTPClientSessionPool::isIdempotent(const std::string& method)
+{
+	return method == HTTPRequest::HTTP_GET
+		|| method == HTTPRequest::HTTP_HEAD
+		|| method == HTTPRequest::HTTP_PUT
+		|| method == HTTPRequest::HTTP_DELETE
+		|| method == HTTPRequest::HTTP_OPTIONS
+		|| method == HTTPRequest::HTTP_TRACE;
+}
+
+
+void HTTPClientSessionPool::purge()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	Poco::Timestamp now;
+	for (HostMap::iterator it = _hosts.begin(); it != _hosts.end(); ++it)
+	{
+		std::vector<IdleSession>& idle = it->second.idle;
+		std::vector<IdleSession>::iterator itIdle = idle.begin();
+		while (itIdle != idle.end())
+		{
+			if (!usable(*itIdle, now))
+			{
+				itIdle = idle.erase(itIdle);
+				_idle--;
+			}
+			else ++itIdle;
+		}
+	}
+	purgeImpl();
+}
+
+
+void HTTPClientSessionPool::clear()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (HostMap::iterator it = _hosts.begin(); it != _hosts.end(); ++it)
+	{
+		it->second.idle.clear();
+	}
+	_idle = 0;
+	purgeImpl();
+}
+
+
+void HTTPClientSessionPool::setMaxSessions(int maxSessions)
+{
+	poco_assert (maxSessions > 0);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	_maxSessions = maxSessions;
+	_available.broadcast();
+}
+
+
+int HTTPClientSessionPool::getMaxSessions() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _maxSessions;
+}
+
+
+void HTTPClientSessionPool::setMaxIdleSessions(int maxIdleSessions)
+{
+	poco_assert (maxIdleSessions >= 0);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	_maxIdleSessions = maxIdleSessions;
+}
+
+
+int HTTPClientSessionPool::getMaxIdleSessions() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _maxIdleSessions;
+}
+
+
+void HTTPClientSessionPool::setIdleTimeout(const Poco::Timespan& timeout)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_idleTimeout = timeout;
+}
+
+
+Poco::Timespan HTTPClientSessionPool::getIdleTimeout() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _idleTimeout;
+}
+
+
+void HTTPClientSessionPool::setAcquireTimeout(const Poco::Timespan& timeout)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_acquireTimeout = timeout;
+}
+
+
+Poco::Timespan HTTPClientSessionPool::getAcquireTimeout() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _acquireTimeout;
+}
+
+
+void HTTPClientSessionPool::setPurgeInterval(const Poco::Timespan& interval)
+{
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		_purgeInterval = interval;
+		if (_idle > 0) startPurgeThread();
+	}
+	_purgeWakeUp.set();
+}
+
+
+Poco::Timespan HTTPClientSessionPool::getPurgeInterval() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _purgeInterval;
+}
+
+
+int HTTPClientSessionPool::idle() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _idle;
+}
+
+
+int HTTPClientSessionPool::active() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return static_cast<int>(_active.size());
+}
+
+
+int HTTPClientSessionPool::created() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _created;
+}
+
+
+int HTTPClientSessionPool::reused() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _reused;
+}
+
+
+HTTPClientSessionPool::SessionPtr HTTPClientSessionPool::createSession(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig)
+{
+	HTTPSessionFactory& factory = HTTPSessionFactory::defaultFactory();
+	SessionPtr pSession;
+	if (factory.supportsProtocol(uri.getScheme()))
+		pSession = factory.createClientSession(uri);
+	else if (uri.getScheme() == "http")
+		pSession = new HTTPClientSession(uri.getHost(), uri.getPort());
+	else
+		throw Poco::UnknownURISchemeException(uri.toString());
+
+	pSession->setProxyConfig(proxyConfig);
+	pSession->setKeepAlive(true);
+	return pSession;
+}
+
+
+bool HTTPClientSessionPool::usable(const IdleSession& idleSession, const Poco::Timestamp& now) const
+{
+	if (now - idleSession.idleSince >= _idleTimeout.totalMicroseconds()) return false;
+	SessionPtr pSession(idleSession.pSession);
+	if (!pSession->connected()) return false;
+	try
+	{
+		// An idle connection must not have anything to read. If it has,
+		// the server has closed the connection or sent unexpected data.
+		return !pSession->socket().poll(Poco::Timespan(0), Socket::SELECT_READ | Socket::SELECT_ERROR);
+	}
+	catch (Poco::Exception&)
+	{
+		return false;
+	}
+}
+
+
+void HTTPClientSessionPool::purgeImpl()
+{
+	Poco::Timestamp now;
+	HostMap::iterator it = _hosts.begin();
+	while (it != _hosts.end())
+	{
+		std::vector<IdleSession>& idle = it->second.idle;
+		std::vector<IdleSession>::iterator itIdle = idle.begin();
+		while (itIdle != idle.end())
+		{
+			if (now - itIdle->idleSince >= _idleTimeout.totalMicroseconds())
+			{
+				itIdle = idle.erase(itIdle);
+				_idle--;
+			}
+			else ++itIdle;
+		}
+		if (idle.empty() && it->second.active == 0)
+			_hosts.erase(it++);
+		else
+			++it;
+	}
+}
+
+
+void HTTPClientSessionPool::returnSession(SessionPtr pSession, bool reuse)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	ActiveMap::iterator it = _active.find(pSession.get());
+	if (it == _active.end()) throw Poco::InvalidArgumentException("Session has not been acquired from this pool");
+
+	HostEntry& entry = _hosts[it->second.key];
+	entry.active--;
+	if (reuse && static_cast<int>(entry.idle.size()) < _maxIdleSessions)
+	{
+		IdleSession idleSession;
+		idleSession.pSession = pSession;
+		entry.idle.push_back(idleSession);
+		_idle++;
+	}
+	_active.erase(it);
+	purgeImpl();
+	if (_idle > 0) startPurgeThread();
+	_available.broadcast();
+}
+
+
+void HTTPClientSessionPool::startPurgeThread()
+{
+	if (_purging || _stopping || _purgeInterval.totalMilliseconds() <= 0) return;
+
+	try
+	{
+		// The previous purge thread, if any, has already left
+		// runPurgeThread(), as _purging is false.
+		_purgeThread.join();
+		_purgeThread.start(_purgeRunnable);
+		_purging = true;
+	}
+	catch (Poco::Exception&)
+	{
+		// no thread available - idle sessions are still
+		// purged with every call to acquire() and release().
+	}
+}
+
+
+void HTTPClientSessionPool::runPurgeThread()
+{
+	for (;;)
+	{
+		long interval;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+
+			interval = static_cast<long>(_purgeInterval.totalMilliseconds());
+			if (_stopping || interval <= 0 || _idle == 0)
+			{
+				_purging = false;
+				return;
+			}
+		}
+		if (!_purgeWakeUp.tryWait(interval))
+		{
+			purge();
+		}
+	}
+}
+
+
+std::string HTTPClientSessionPool::key(const Poco::URI& uri, const HTTPClientSession::ProxyConfig& proxyConfig)
+{
+	std::string result(uri.getScheme());
+	result += "://";
+	result += uri.getHost();
+	result += ':';
+	Poco::NumberFormatter::append(result, uri.getPort());
+	if (!proxyConfig.host.empty())
+	{
+		result += " via ";
+		result += proxyConfig.host;
+		result += ':';
+		Poco::NumberFormatter::append(result, proxyConfig.port);
+		if (!proxyConfig.username.empty())
+		{
+			result += ' ';
+			result += proxyConfig.username;
+		}
+	}
+	return result;
+}
+
+
+namespace
+{
+	static Poco::SingletonHolder<HTTPClientSessionPool> sh;
+}
+
+
+HTTPClientSessionPool& HTTPClientSessionPool::defaultPool()
+{
+	return *sh.get();
+}
+
+
+} } // namespace Poco::Net
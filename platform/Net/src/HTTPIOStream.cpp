@@ -14,6 +14,7 @@
 
 #include "Poco/Net/HTTPIOStream.h"
 #include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
 
 
 using Poco::UnbufferedStreamBuf;
@@ -51,14 +52,41 @@ HTTPResponseIOS::~HTTPResponseIOS()
 HTTPResponseStream::HTTPResponseStream(std::istream& istr, HTTPClientSession* pSession):
 	HTTPResponseIOS(istr),
 	std::istream(&_buf),
-	_pSession(pSession)
+	_istr(istr),
+	_pSession(pSession),
+	_pPool(0)
+{
+}
+
+
+HTTPResponseStream::HTTPResponseStream(std::istream& istr, Poco::SharedPtr<HTTPClientSession> pSession, HTTPClientSessionPool* pPool):
+	HTTPResponseIOS(istr),
+	std::istream(&_buf),
+	_istr(istr),
+	_pSession(0),
+	_pPool(pPool),
+	_pSharedSession(pSession)
 {
 }
 
 
 HTTPResponseStream::~HTTPResponseStream()
 {
-	delete _pSession;
+	if (_pPool)
+	{
+		try
+		{
+			if (_istr.eof() && !_istr.bad())
+				_pPool->release(_pSharedSession);
+			else
+				_pPool->discard(_pSharedSession);
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+	else delete _pSession;
 }
 
 
@@ -18,6 +18,7 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/Ascii.h"
 #include "Poco/String.h"
+#include <cstring>
 
 
 using Poco::NumberFormatter;
@@ -231,6 +232,41 @@ void HTTPRequest::read(std::istream& istr)
 }
 
 
+void HTTPRequest::parse(const char* pBegin, const char* pEnd)
+{
+	const char* p = pBegin;
+	while (p < pEnd && Poco::Ascii::isSpace(*p)) ++p;
+	if (p == pEnd) throw MessageException("No HTTP request header");
+	const char* pMethod = p;
+	while (p < pEnd && !Poco::Ascii::isSpace(*p) && p - pMethod < MAX_METHOD_LENGTH) ++p;
+	if (p == pEnd || !Poco::Ascii::isSpace(*p)) throw MessageException("HTTP request method invalid or too long");
+	const char* pMethodEnd = p;
+	while (p < pEnd && Poco::Ascii::isSpace(*p)) ++p;
+	const char* pURI = p;
+	while (p < pEnd && !Poco::Ascii::isSpace(*p) && p - pURI < MAX_URI_LENGTH) ++p;
+	if (p == pEnd || !Poco::Ascii::isSpace(*p)) throw MessageException("HTTP request URI invalid or too long");
+	const char* pURIEnd = p;
+	while (p < pEnd && Poco::Ascii::isSpace(*p)) ++p;
+	const char* pVersion = p;
+	while (p < pEnd && !Poco::Ascii::isSpace(*p) && p - pVersion < MAX_VERSION_LENGTH) ++p;
+	if (p == pEnd || !Poco::Ascii::isSpace(*p)) throw MessageException("Invalid HTTP version string");
+	const char* pVersionEnd = p;
+	p = skipLine(p, pEnd);
+	p = HTTPMessage::parse(p, pEnd);
+	skipLine(p, pEnd);
+	setMethod(std::string(pMethod, pMethodEnd));
+	setURI(std::string(pURI, pURIEnd));
+	setVersion(std::string(pVersion, pVersionEnd));
+}
+
+
+const char* HTTPRequest::skipLine(const char* p, const char* pEnd)
+{
+	const char* pEol = static_cast<const char*>(std::memchr(p, '\n', pEnd - p));
+	return pEol ? pEol + 1 : pEnd;
+}
+
+
 void HTTPRequest::getCredentials(const std::string& header, std::string& scheme, std::string& authInfo) const
 {
 	scheme.clear();
@@ -39,8 +39,24 @@ HTTPServerRequestImpl::HTTPServerRequestImpl(HTTPServerResponseImpl& response, H
 {
 	response.attachRequest(this);
 
-	HTTPHeaderInputStream hs(session);
-	read(hs);
+	// Usually, the complete request header has been received with
+	// the first packet and can be parsed directly from the session's
+	// buffer. Otherwise, fall back to reading it from a stream.
+	// The header is removed from the buffer before parsing, so that
+	// a malformed header is not parsed again; the buffer contents
+	// remain valid until the buffer is refilled.
+	const char* pBegin;
+	const char* pEnd;
+	if (session.peekHeader(pBegin, pEnd))
+	{
+		session.skip(pEnd - pBegin);
+		parse(pBegin, pEnd);
+	}
+	else
+	{
+		HTTPHeaderInputStream hs(session);
+		read(hs);
+	}
 	
 	// Now that we know socket is still connected, obtain addresses
 	_clientAddress = session.clientAddress();
@@ -15,6 +15,7 @@
 #include "Poco/Net/HTTPSession.h"
 #include "Poco/Net/HTTPBufferAllocator.h"
 #include "Poco/Net/NetException.h"
+#include "Poco/Ascii.h"
 #include <cstring>
 
 
@@ -185,6 +186,44 @@ void HTTPSession::refill()
 }
 
 
+bool HTTPSession::peekHeader(const char*& pBegin, const char*& pEnd)
+{
+	if (_pCurrent == _pEnd)
+		refill();
+
+	const char* p = _pCurrent;
+	while (p < _pEnd && Poco::Ascii::isSpace(*p)) ++p;
+	if (p == _pEnd) return false;
+
+	for (;;)
+	{
+		const char* pEol = static_cast<const char*>(std::memchr(p, '\n', _pEnd - p));
+		if (!pEol) return false;
+		p = pEol + 1;
+		if (p < _pEnd && *p == '\n')
+		{
+			pEnd = p + 1;
+			break;
+		}
+		if (p + 1 < _pEnd && p[0] == '\r' && p[1] == '\n')
+		{
+			pEnd = p + 2;
+			break;
+		}
+	}
+	pBegin = _pCurrent;
+	return true;
+}
+
+
+void HTTPSession::skip(std::streamsize length)
+{
+	poco_assert (length <= _pEnd - _pCurrent);
+
+	_pCurrent += length;
+}
+
+
 bool HTTPSession::connected() const
 {
 	return _socket.impl()->initialized();
@@ -14,6 +14,7 @@
 
 #include "Poco/Net/HTTPStreamFactory.h"
 #include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
 #include "Poco/Net/HTTPIOStream.h"
 #include "Poco/Net/HTTPRequest.h"
 #include "Poco/Net/HTTPResponse.h"
@@ -71,7 +72,8 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 
 	URI resolvedURI(uri);
 	URI proxyUri;
-	HTTPClientSession* pSession = 0;
+	HTTPClientSessionPool& pool = HTTPClientSessionPool::defaultPool();
+	HTTPClientSessionPool::SessionPtr pSession;
 	HTTPResponse res;
 	bool retry = false;
 	bool authorize = false;
@@ -84,24 +86,28 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 		{
 			if (!pSession)
 			{
-				pSession = new HTTPClientSession(resolvedURI.getHost(), resolvedURI.getPort());
-			
+				HTTPClientSession::ProxyConfig proxyConfig(HTTPClientSession::getGlobalProxyConfig());
 				if (proxyUri.empty())
 				{
 					if (!_proxyHost.empty())
 					{
-						pSession->setProxy(_proxyHost, _proxyPort);
-						pSession->setProxyCredentials(_proxyUsername, _proxyPassword);
+						proxyConfig.host = _proxyHost;
+						proxyConfig.port = _proxyPort;
+						proxyConfig.username = _proxyUsername;
+						proxyConfig.password = _proxyPassword;
 					}
 				}
 				else
 				{
-					pSession->setProxy(proxyUri.getHost(), proxyUri.getPort());
+					proxyConfig.host = proxyUri.getHost();
+					proxyConfig.port = proxyUri.getPort();
 					if (!_proxyUsername.empty())
 					{
-						pSession->setProxyCredentials(_proxyUsername, _proxyPassword);
+						proxyConfig.username = _proxyUsername;
+						proxyConfig.password = _proxyPassword;
 					}
 				}
+				pSession = pool.acquire(resolvedURI, proxyConfig);
 			}
 						
 			std::string path = resolvedURI.getPathAndQuery();
@@ -121,8 +127,22 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 				(POCO_VERSION >> 8) & 0xFF));
 			req.set("Accept", "*/*");
 			
-			pSession->sendRequest(req);
-			std::istream& rs = pSession->receiveResponse(res);
+			std::istream* pResponseStream = 0;
+			try
+			{
+				pSession->sendRequest(req);
+				pResponseStream = &pSession->receiveResponse(res);
+			}
+			catch (NetException&)
+			{
+				// The server may have closed a reused keep-alive
+				// connection, so the request is sent once more.
+				pSession = pool.reconnect(pSession, req.getMethod());
+				if (!pSession) throw;
+				pSession->sendRequest(req);
+				pResponseStream = &pSession->receiveResponse(res);
+			}
+			std::istream& rs = *pResponseStream;
 			bool moved = (res.getStatus() == HTTPResponse::HTTP_MOVED_PERMANENTLY || 
 						  res.getStatus() == HTTPResponse::HTTP_FOUND || 
 						  res.getStatus() == HTTPResponse::HTTP_SEE_OTHER ||
@@ -138,7 +158,7 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 			}
 			else if (res.getStatus() == HTTPResponse::HTTP_OK)
 			{
-				return new HTTPResponseStream(rs, pSession);
+				return new HTTPResponseStream(rs, pSession, &pool);
 			}
 			else if (res.getStatus() == HTTPResponse::HTTP_USE_PROXY && !retry)
 			{
@@ -148,7 +168,7 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 				// single request via the proxy. 305 responses MUST only be generated by origin servers.
 				// only use for one single request!
 				proxyUri.resolve(res.get("Location"));
-				delete pSession; 
+				pool.discard(pSession);
 				pSession = 0;
 				retry = true; // only allow useproxy once
 			}
@@ -166,7 +186,7 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 	}
 	catch (...)
 	{
-		delete pSession;
+		if (pSession) pool.discard(pSession);
 		throw;
 	}
 }
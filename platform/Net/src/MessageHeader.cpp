@@ -21,6 +21,7 @@
 #include "Poco/Base64Decoder.h"
 #include "Poco/UTF8Encoding.h"
 #include <sstream>
+#include <cstring>
 
 
 namespace Poco {
@@ -101,13 +102,48 @@ void MessageHeader::read(std::istream& istr)
 				throw MessageException("Folded field value too long/no CRLF found");
 		}
 		Poco::trimRightInPlace(value);
-		add(name, decodeWord(value));
+		addField(name, value);
 		++fields;
 	}
 	istr.putback(ch);
 }
 
 
+const char* MessageHeader::parse(const char* pBegin, const char* pEnd)
+{
+	std::string name;
+	std::string value;
+	const char* p = pBegin;
+	int fields = 0;
+	while (p < pEnd && *p != '\r' && *p != '\n')
+	{
+		if (_fieldLimit > 0 && fields == _fieldLimit)
+			throw MessageException("Too many header fields");
+		const char* pEol = static_cast<const char*>(std::memchr(p, '\n', pEnd - p));
+		const char* pLineEnd = pEol ? pEol : pEnd;
+		const char* pNameEnd = pLineEnd - p <= MAX_NAME_LENGTH ? pLineEnd : p + MAX_NAME_LENGTH + 1;
+		const char* pColon = static_cast<const char*>(std::memchr(p, ':', pNameEnd - p));
+		if (!pColon)
+		{
+			if (pEol && pEol <= p + MAX_NAME_LENGTH) { p = pEol + 1; continue; } // ignore invalid header lines
+			throw MessageException("Field name too long/no colon found");
+		}
+		name.assign(p, pColon);
+		p = pColon + 1;
+		while (p < pLineEnd && Poco::Ascii::isSpace(*p) && *p != '\r') ++p;
+		p = parseValue(p, pEnd, value, false);
+		while (p < pEnd && (*p == ' ' || *p == '\t')) // folding
+		{
+			p = parseValue(p, pEnd, value, true);
+		}
+		Poco::trimRightInPlace(value);
+		addField(name, value);
+		++fields;
+	}
+	return p;
+}
+
+
 int MessageHeader::getFieldLimit() const
 {
 	return _fieldLimit;
@@ -243,6 +279,41 @@ void MessageHeader::splitParameters(const std::string::const_iterator& begin, co
 }
 
 
+void MessageHeader::addField(const std::string& name, const std::string& value)
+{
+	if (value.find("=?") == std::string::npos)
+		add(name, value);
+	else
+		add(name, decodeWord(value));
+}
+
+
+const char* MessageHeader::parseValue(const char* p, const char* pEnd, std::string& value, bool folded)
+{
+	const char* pValueEnd = static_cast<const char*>(std::memchr(p, '\n', pEnd - p));
+	if (!pValueEnd) pValueEnd = pEnd;
+	const char* pCR = static_cast<const char*>(std::memchr(p, '\r', pValueEnd - p));
+	if (pCR) pValueEnd = pCR;
+
+	std::size_t length = pValueEnd - p;
+	std::size_t maxLength = MAX_VALUE_LENGTH - (folded ? value.length() : 0);
+	if (length > maxLength)
+		throw MessageException(folded ? "Folded field value too long/no CRLF found" : "Field value too long/no CRLF found");
+	if (folded)
+		value.append(p, length);
+	else
+		value.assign(p, length);
+
+	p = pValueEnd;
+	if (p < pEnd && *p == '\r') ++p;
+	if (p < pEnd && *p == '\n')
+		++p;
+	else if (p < pEnd)
+		throw MessageException(folded ? "Folded field value too long/no CRLF found" : "Field value too long/no CRLF found");
+	return p;
+}
+
+
 void MessageHeader::quote(const std::string& value, std::string& result, bool allowSpace)
 {
 	bool mustQuote = false;
@@ -0,0 +1,444 @@
+//
+// HTTPClientSessionPoolTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "HTTPClientSessionPoolTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
+#include "Poco/Net/HTTPStreamFactory.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/Thread.h"
+#include "Poco/Exception.h"
+#include "Poco/URI.h"
+#include <sstream>
+#include <memory>
+
+
+using Poco::Net::HTTPClientSessionPool;
+using Poco::Net::HTTPClientSession;
+using Poco::Net::HTTPStreamFactory;
+using Poco::Net::HTTPServer;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::HTTPRequest;
+using Poco::Net::HTTPResponse;
+using Poco::Net::HTTPMessage;
+using Poco::Net::ServerSocket;
+using Poco::StreamCopier;
+using Poco::URI;
+
+
+namespace
+{
+	const std::string BODY("Hello, world!");
+
+	class BodyRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			if (request.getURI() == "/close") response.setKeepAlive(false);
+			response.setContentType("text/plain");
+			response.setContentLength(BODY.length());
+			response.send() << BODY;
+		}
+	};
+
+	class RequestHandlerFactory: public HTTPRequestHandlerFactory
+	{
+	public:
+		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
+		{
+			return new BodyRequestHandler;
+		}
+	};
+
+	HTTPServerParams* createParams()
+	{
+		HTTPServerParams* pParams = new HTTPServerParams;
+		pParams->setKeepAlive(true);
+		pParams->setKeepAliveTimeout(Poco::Timespan(2, 0));
+		return pParams;
+	}
+
+	URI serverURI(const ServerSocket& socket, const std::string& path = "/")
+	{
+		URI uri("http://127.0.0.1");
+		uri.setPort(socket.address().port());
+		uri.setPath(path);
+		return uri;
+	}
+
+	std::string get(HTTPClientSession& session, const std::string& path = "/")
+	{
+		HTTPRequest request(HTTPRequest::HTTP_GET, path, HTTPMessage::HTTP_1_1);
+		session.sendRequest(request);
+		HTTPResponse response;
+		std::istream& rs = session.receiveResponse(response);
+		std::ostringstream ostr;
+		StreamCopier::copyStream(rs, ostr);
+		return ostr.str();
+	}
+}
+
+
+HTTPClientSessionPoolTest::HTTPClientSessionPoolTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+HTTPClientSessionPoolTest::~HTTPClientSessionPoolTest()
+{
+}
+
+
+void HTTPClientSessionPoolTest::testReuse()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool;
+	URI uri = serverURI(svs);
+	for (int i = 0; i < 5; i++)
+	{
+		HTTPClientSessionPool::SessionPtr pSession = pool.acquire(uri);
+		assert (pSession->getKeepAlive());
+		assert (pool.active() == 1);
+		assert (get(*pSession) == BODY);
+		pool.release(pSession);
+		assert (pool.active() == 0);
+		assert (pool.idle() == 1);
+	}
+	assert (pool.created() == 1);
+	assert (pool.reused() == 4);
+	assert (srv.totalConnections() == 1);
+}
+
+
+void HTTPClientSessionPoolTest::testNoKeepAlive()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool;
+	URI uri = serverURI(svs);
+	HTTPClientSessionPool::SessionPtr pSession = pool.acquire(uri);
+	assert (get(*pSession, "/close") == BODY);
+	pool.release(pSession);
+	assert (pool.idle() == 0);
+
+	pSession = pool.acquire(uri);
+	assert (get(*pSession) == BODY);
+	pool.release(pSession);
+	assert (pool.idle() == 1);
+	assert (pool.created() == 2);
+	assert (pool.reused() == 0);
+}
+
+
+void HTTPClientSessionPoolTest::testServerClose()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = createParams();
+	pParams->setKeepAliveTimeout(Poco::Timespan(0, 100000));
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSessionPool pool;
+	URI uri = serverURI(svs);
+	HTTPClientSessionPool::SessionPtr pSession = pool.acquire(uri);
+	assert (get(*pSession) == BODY);
+	pool.release(pSession);
+	assert (pool.idle() == 1);
+
+	// the server closes the idle connection
+	Poco::Thread::sleep(500);
+
+	HTTPClientSessionPool::SessionPtr pSession2 = pool.acquire(uri);
+	assert (pSession2.get() != pSession.get());
+	assert (get(*pSession2) == BODY);
+	pool.release(pSession2);
+	assert (pool.created() == 2);
+	assert (pool.reused() == 0);
+	assert (srv.totalConnections() == 2);
+}
+
+
+void HTTPClientSessionPoolTest::testIdleTimeout()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool;
+	pool.setIdleTimeout(Poco::Timespan(0, 100000));
+	URI uri = serverURI(svs);
+	HTTPClientSessionPool::SessionPtr pSession = pool.acquire(uri);
+	assert (get(*pSession) == BODY);
+	pool.release(pSession);
+	assert (pool.idle() == 1);
+
+	Poco::Thread::sleep(200);
+	pool.purge();
+	assert (pool.idle() == 0);
+
+	pSession = pool.acquire(uri);
+	assert (get(*pSession) == BODY);
+	pool.release(pSession);
+	assert (pool.created() == 2);
+	assert (pool.reused() == 0);
+}
+
+
+void HTTPClientSessionPoolTest::testPurgeThread()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool;
+	pool.setIdleTimeout(Poco::Timespan(0, 100000));
+	pool.setPurgeInterval(Poco::Timespan(0, 50000));
+	URI uri = serverURI(svs);
+	HTTPClientSessionPool::SessionPtr pSession = pool.acquire(uri);
+	assert (get(*pSession) == BODY);
+	pool.release(pSession);
+	assert (pool.idle() == 1);
+
+	// no call to purge(), acquire() or release()
+	Poco::Thread::sleep(500);
+	assert (pool.idle() == 0);
+
+	// the purge thread is started again for the next idle session
+	pSession = pool.acquire(uri);
+	assert (get(*pSession) == BODY);
+	pool.release(pSession);
+	assert (pool.idle() == 1);
+	Poco::Thread::sleep(500);
+	assert (pool.idle() == 0);
+}
+
+
+void HTTPClientSessionPoolTest::testMaxSessions()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool;
+	pool.setMaxSessions(1);
+	pool.setAcquireTimeout(Poco::Timespan(0, 100000));
+	URI uri = serverURI(svs);
+	HTTPClientSessionPool::SessionPtr pSession = pool.acquire(uri);
+	try
+	{
+		pool.acquire(uri);
+		fail("session limit reached - must throw");
+	}
+	catch (Poco::TimeoutException&)
+	{
+	}
+
+	// other hosts are not affected
+	URI otherURI(uri);
+	otherURI.setHost("localhost");
+	HTTPClientSessionPool::SessionPtr pOtherSession = pool.acquire(otherURI);
+	pool.discard(pOtherSession);
+
+	assert (get(*pSession) == BODY);
+	pool.release(pSession);
+	pSession = pool.acquire(uri);
+	assert (pool.reused() == 1);
+	pool.release(pSession);
+}
+
+
+void HTTPClientSessionPoolTest::testMaxIdleSessions()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool;
+	pool.setMaxIdleSessions(1);
+	URI uri = serverURI(svs);
+	HTTPClientSessionPool::SessionPtr pSession1 = pool.acquire(uri);
+	HTTPClientSessionPool::SessionPtr pSession2 = pool.acquire(uri);
+	assert (pool.active() == 2);
+	assert (get(*pSession1) == BODY);
+	assert (get(*pSession2) == BODY);
+	pool.release(pSession1);
+	pool.release(pSession2);
+	assert (pool.active() == 0);
+	assert (pool.idle() == 1);
+}
+
+
+void HTTPClientSessionPoolTest::testDiscard()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool;
+	URI uri = serverURI(svs);
+	HTTPClientSessionPool::SessionPtr pSession = pool.acquire(uri);
+	assert (get(*pSession) == BODY);
+	pool.discard(pSession);
+	assert (pool.active() == 0);
+	assert (pool.idle() == 0);
+
+	try
+	{
+		pool.release(pSession);
+		fail("session not acquired from pool - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void HTTPClientSessionPoolTest::testReconnect()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = createParams();
+	pParams->setKeepAliveTimeout(Poco::Timespan(0, 200000));
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	assert (HTTPClientSessionPool::isIdempotent(HTTPRequest::HTTP_GET));
+	assert (HTTPClientSessionPool::isIdempotent(HTTPRequest::HTTP_PUT));
+	assert (!HTTPClientSessionPool::isIdempotent(HTTPRequest::HTTP_POST));
+	assert (!HTTPClientSessionPool::isIdempotent(HTTPRequest::HTTP_PATCH));
+
+	HTTPClientSessionPool pool;
+	URI uri = serverURI(svs);
+	HTTPClientSessionPool::SessionPtr pSession = pool.acquire(uri);
+	assert (!pool.isReused(pSession));
+	assert (get(*pSession) == BODY);
+	pool.release(pSession);
+
+	// the server closes the connection after it has been handed out again
+	pSession = pool.acquire(uri);
+	assert (pool.isReused(pSession));
+	Poco::Thread::sleep(500);
+	try
+	{
+		get(*pSession);
+		fail("connection closed by server - must throw");
+	}
+	catch (Poco::Net::NetException&)
+	{
+		pSession = pool.reconnect(pSession, HTTPRequest::HTTP_GET);
+	}
+	assert (!pSession.isNull());
+	assert (!pool.isReused(pSession));
+	assert (pool.active() == 1);
+	assert (get(*pSession) == BODY);
+
+	// a new session is not replaced
+	assert (pool.reconnect(pSession, HTTPRequest::HTTP_GET).isNull());
+	assert (pool.active() == 0);
+	assert (pool.created() == 2);
+
+	// a non-idempotent request is not sent again
+	pSession = pool.acquire(uri);
+	assert (get(*pSession) == BODY);
+	pool.release(pSession);
+	pSession = pool.acquire(uri);
+	assert (pool.isReused(pSession));
+	assert (pool.reconnect(pSession, HTTPRequest::HTTP_POST).isNull());
+	assert (pool.active() == 0);
+	assert (pool.idle() == 0);
+}
+
+
+void HTTPClientSessionPoolTest::testStreamFactory()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool& pool = HTTPClientSessionPool::defaultPool();
+	int created = pool.created();
+	HTTPStreamFactory factory;
+	URI uri = serverURI(svs, "/stream");
+	for (int i = 0; i < 3; i++)
+	{
+#ifndef POCO_ENABLE_CPP11
+		std::auto_ptr<std::istream> pStr(factory.open(uri));
+#else
+		std::unique_ptr<std::istream> pStr(factory.open(uri));
+#endif // POCO_ENABLE_CPP11
+		std::ostringstream ostr;
+		StreamCopier::copyStream(*pStr.get(), ostr);
+		assert (ostr.str() == BODY);
+	}
+	assert (pool.created() == created + 1);
+	assert (srv.totalConnections() == 1);
+
+	// a partially read response must not be reused
+	{
+#ifndef POCO_ENABLE_CPP11
+		std::auto_ptr<std::istream> pStr(factory.open(uri));
+#else
+		std::unique_ptr<std::istream> pStr(factory.open(uri));
+#endif // POCO_ENABLE_CPP11
+		assert (pStr->get() == 'H');
+	}
+	assert (pool.active() == 0);
+	assert (pool.created() == created + 1);
+	pool.clear();
+}
+
+
+void HTTPClientSessionPoolTest::setUp()
+{
+}
+
+
+void HTTPClientSessionPoolTest::tearDown()
+{
+}
+
+
+CppUnit::Test* HTTPClientSessionPoolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPClientSessionPoolTest");
+
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testReuse);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testNoKeepAlive);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testServerClose);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testIdleTimeout);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testPurgeThread);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testMaxSessions);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testMaxIdleSessions);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testDiscard);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testReconnect);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testStreamFactory);
+
+	return pSuite;
+}
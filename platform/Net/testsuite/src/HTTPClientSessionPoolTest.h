@@ -0,0 +1,47 @@
+//
+// HTTPClientSessionPoolTest.h
+//
+// Definition of the HTTPClientSessionPoolTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef HTTPClientSessionPoolTest_INCLUDED
+#define HTTPClientSessionPoolTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "CppUnit/TestCase.h"
+
+
+class HTTPClientSessionPoolTest: public CppUnit::TestCase
+{
+public:
+	HTTPClientSessionPoolTest(const std::string& name);
+	~HTTPClientSessionPoolTest();
+
+	void testReuse();
+	void testNoKeepAlive();
+	void testServerClose();
+	void testIdleTimeout();
+	void testPurgeThread();
+	void testMaxSessions();
+	void testMaxIdleSessions();
+	void testDiscard();
+	void testReconnect();
+	void testStreamFactory();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // HTTPClientSessionPoolTest_INCLUDED
@@ -236,6 +236,58 @@ void HTTPRequestTest::testCookies()
 }
 
 
+void HTTPRequestTest::testParse()
+{
+	std::string s("\r\nPOST /test.cgi HTTP/1.1\r\nConnection: Close\r\nContent-Length:   100  \r\nContent-Type: text/plain\r\nHost: localhost:8000\r\nUser-Agent: Poco\r\n\r\n");
+	HTTPRequest request;
+	request.parse(s.data(), s.data() + s.size());
+	assert (request.getMethod() == HTTPRequest::HTTP_POST);
+	assert (request.getURI() == "/test.cgi");
+	assert (request.getVersion() == HTTPMessage::HTTP_1_1);
+	assert (request.size() == 5);
+	assert (request["Connection"] == "Close");
+	assert (request["Host"] == "localhost:8000");
+	assert (request["User-Agent"] == "Poco");
+	assert (request.getContentType() == "text/plain");
+	assert (request.getContentLength() == 100);
+
+	std::string s2("GET / HTTP/1.0\n\n");
+	HTTPRequest request2;
+	request2.parse(s2.data(), s2.data() + s2.size());
+	assert (request2.getMethod() == HTTPRequest::HTTP_GET);
+	assert (request2.getURI() == "/");
+	assert (request2.getVersion() == HTTPMessage::HTTP_1_0);
+	assert (request2.size() == 0);
+}
+
+
+void HTTPRequestTest::testParseInvalid()
+{
+	const std::string invalid[] =
+	{
+		"",
+		" \r\n",
+		std::string(256, 'x'),
+		"GET " + std::string(20000, 'x') + " HTTP/1.1\r\n\r\n",
+		"GET / HTTP/1.1111111111111\r\n\r\n",
+		"GET /\r\n\r\n",
+		"GET / HTTP/1.1\r\nHost: " + std::string(9000, 'x') + "\r\n\r\n"
+	};
+	for (std::size_t i = 0; i < sizeof(invalid)/sizeof(invalid[0]); i++)
+	{
+		HTTPRequest request;
+		try
+		{
+			request.parse(invalid[i].data(), invalid[i].data() + invalid[i].size());
+			fail("invalid request - must throw");
+		}
+		catch (MessageException&)
+		{
+		}
+	}
+}
+
+
 void HTTPRequestTest::setUp()
 {
 }
@@ -262,6 +314,8 @@ CppUnit::Test* HTTPRequestTest::suite()
 	CppUnit_addTest(pSuite, HTTPRequestTest, testInvalid2);
 	CppUnit_addTest(pSuite, HTTPRequestTest, testInvalid3);
 	CppUnit_addTest(pSuite, HTTPRequestTest, testCookies);
+	CppUnit_addTest(pSuite, HTTPRequestTest, testParse);
+	CppUnit_addTest(pSuite, HTTPRequestTest, testParseInvalid);
 
 	return pSuite;
 }
@@ -21,6 +21,63 @@ using Poco::Net::NameValueCollection;
 using Poco::Net::MessageException;
 
 
+namespace
+{
+	bool readThrows(const std::string& s, int fieldLimit)
+	{
+		std::istringstream istr(s);
+		MessageHeader mh;
+		mh.setFieldLimit(fieldLimit);
+		try
+		{
+			mh.read(istr);
+			return false;
+		}
+		catch (MessageException&)
+		{
+			return true;
+		}
+	}
+
+	bool parseThrows(const std::string& s, int fieldLimit)
+	{
+		MessageHeader mh;
+		mh.setFieldLimit(fieldLimit);
+		try
+		{
+			mh.parse(s.data(), s.data() + s.size());
+			return false;
+		}
+		catch (MessageException&)
+		{
+			return true;
+		}
+	}
+
+	bool parseEqualsRead(const std::string& s)
+	{
+		std::istringstream istr(s);
+		MessageHeader mhRead;
+		mhRead.read(istr);
+		std::string restRead;
+		std::getline(istr, restRead, '\0');
+
+		MessageHeader mhParse;
+		const char* p = mhParse.parse(s.data(), s.data() + s.size());
+		std::string restParse(p, s.data() + s.size());
+
+		if (mhRead.size() != mhParse.size() || restRead != restParse) return false;
+		NameValueCollection::ConstIterator itRead = mhRead.begin();
+		NameValueCollection::ConstIterator itParse = mhParse.begin();
+		for (; itRead != mhRead.end(); ++itRead, ++itParse)
+		{
+			if (itRead->first != itParse->first || itRead->second != itParse->second) return false;
+		}
+		return true;
+	}
+}
+
+
 MessageHeaderTest::MessageHeaderTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -377,6 +434,61 @@ void MessageHeaderTest::testDecodeWord()
 
 
 
+void MessageHeaderTest::testParse()
+{
+	std::string s("name1: value1\r\nname2: value2\r\nname3: value3\r\n\r\nbody");
+	MessageHeader mh;
+	const char* p = mh.parse(s.data(), s.data() + s.size());
+	assert (std::string(p, s.data() + s.size()) == "\r\nbody");
+	assert (mh.size() == 3);
+	assert (mh["name1"] == "value1");
+	assert (mh["name2"] == "value2");
+	assert (mh["name3"] == "value3");
+
+	assert (parseEqualsRead(""));
+	assert (parseEqualsRead("\r\n"));
+	assert (parseEqualsRead("name1: value1\r\nname2: value2\r\nname3: value3\r\n"));
+	assert (parseEqualsRead("name1: value1\nname2: value2\nname3: value3\n\nbody"));
+	assert (parseEqualsRead("name1:value1\r\nname2:    value2\r\nname3: value3  \r\n"));
+	assert (parseEqualsRead("name1: value1\r\nname2: value2\r\nname3: value3"));
+	assert (parseEqualsRead("name1: \r\nname2: \t\r\nname3:\r\n"));
+	assert (parseEqualsRead("name1: value1\r\ninvalid\r\nname2: value2\r\n"));
+	assert (parseEqualsRead("name1: value1:value2\r\n"));
+	assert (parseEqualsRead("name1: value1\r\nname2: value21\r\n value22\r\nname3: value3\r\n"));
+	assert (parseEqualsRead("name1: value1\r\nname2: value21\r\n value22\r\n\tvalue23\r\n\r\n"));
+	assert (parseEqualsRead("name1: value1\nname2: value21\n value22\nname3: value3\n"));
+	assert (parseEqualsRead("name1: value1\r\nname2: =?ISO-8859-1?Q?Keld_J=F8rn_Simonsen?=\r\n"));
+	assert (parseEqualsRead(std::string(256, 'n') + ": value\r\n"));
+	assert (parseEqualsRead(std::string(255, 'n') + "\r\nname: value\r\n"));
+	assert (parseEqualsRead("name: " + std::string(8192, 'v') + "\r\n"));
+}
+
+
+void MessageHeaderTest::testParseInvalid()
+{
+	const std::string invalid[] =
+	{
+		"name1: value1\r\nname2: value21\r\n value22\r\n value23\r\n" + std::string(300, 'x'),
+		"name1: value1\r\nname2: " + std::string(9000, 'x') + "\r\n",
+		"name1: value1\r\nname2: value21\r\n " + std::string(9000, 'x') + "\r\n",
+		"name1: value1\rname2: value2\r\n",
+		std::string(257, 'n') + ": value\r\n",
+		std::string(256, 'n') + "\r\n",
+		"name1"
+	};
+	for (std::size_t i = 0; i < sizeof(invalid)/sizeof(invalid[0]); i++)
+	{
+		assert (readThrows(invalid[i], 100));
+		assert (parseThrows(invalid[i], 100));
+	}
+
+	std::string s("name1: value1\r\nname2: value2\r\nname3: value3\r\n");
+	assert (readThrows(s, 2));
+	assert (parseThrows(s, 2));
+	assert (!parseThrows(s, 3));
+}
+
+
 void MessageHeaderTest::setUp()
 {
 }
@@ -408,6 +520,8 @@ CppUnit::Test* MessageHeaderTest::suite()
 	CppUnit_addTest(pSuite, MessageHeaderTest, testSplitParameters);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testFieldLimit);
 	CppUnit_addTest(pSuite, MessageHeaderTest, testDecodeWord);
+	CppUnit_addTest(pSuite, MessageHeaderTest, testParse);
+	CppUnit_addTest(pSuite, MessageHeaderTest, testParseInvalid);
 
 	return pSuite;
 }
@@ -41,6 +41,8 @@ public:
 	void testSplitParameters();
 	void testFieldLimit();
 	void testDecodeWord();
+	void testParse();
+	void testParseInvalid();
 
 	void setUp();
 	void tearDown();
@@ -22,10 +22,16 @@
 #include "Poco/Net/SocketDefs.h"
 #include "Poco/Crypto/X509Certificate.h"
 #include "Poco/Crypto/RSAKey.h"
+#include "Poco/Net/Session.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Mutex.h"
 #include <openssl/ssl.h>
 #include <cstdlib>
+#include <map>
+#include <deque>
 
 
 namespace Poco {
@@ -41,6 +47,20 @@ class NetSSL_API Context: public Poco::RefCountedObject
 	///
 	/// The Context class is also used to control
 	/// SSL session caching on the server and client side.
+	///
+	/// On the client side, if session caching is enabled,
+	/// sessions received from a server are stored in the Context,
+	/// keyed by the server's host name (or address) and port.
+	/// A subsequent connection to the same host and port
+	/// made with the same Context will automatically attempt
+	/// to resume the cached session, avoiding a full handshake.
+	///
+	/// On the server side, stateless session resumption
+	/// (RFC 5077 session tickets) can use ticket keys that
+	/// are rotated periodically (see setSessionTicketKeyRotation()).
+	///
+	/// The Context also counts completed handshakes and resumed
+	/// handshakes for all sockets using it.
 {
 public:
 	typedef Poco::AutoPtr<Context> Ptr;
@@ -281,19 +301,29 @@ public:
 		/// Returns true iff the session cache is enabled.
 
 	void setSessionCacheSize(std::size_t size);
-		/// Sets the maximum size of the server session cache, in number of
-		/// sessions. The default size (according to OpenSSL documentation)
+		/// Sets the maximum size of the session cache, in number of
+		/// sessions.
+		///
+		/// For a server, the default size (according to OpenSSL documentation)
 		/// is 1024*20, which may be too large for many applications,
 		/// especially on embedded platforms with limited memory.
 		///
+		/// For a client, the cache holds at most one session per
+		/// host and port, and the default size is DEFAULT_CLIENT_SESSION_CACHE_SIZE.
+		///
 		/// Specifying a size of 0 will set an unlimited cache size.
 		///
-		/// This method may only be called on SERVER_USE Context objects.
+		/// Note: Earlier versions only allowed this method to be called
+		/// on SERVER_USE Context objects, and asserted otherwise. For
+		/// CLIENT_USE Context objects, it now sets the size of the client
+		/// session cache, discarding cached sessions if the cache
+		/// holds more sessions than the new size allows.
 
 	std::size_t getSessionCacheSize() const;
-		/// Returns the current maximum size of the server session cache.
+		/// Returns the current maximum size of the session cache.
 		///
-		/// This method may only be called on SERVER_USE Context objects.
+		/// For CLIENT_USE Context objects, returns the maximum size
+		/// of the client session cache.
 
 	void setSessionTimeout(long seconds);
 		/// Sets the timeout (in seconds) of cached sessions on the server.
@@ -308,10 +338,73 @@ public:
 		/// This method may only be called on SERVER_USE Context objects.
 
 	void flushSessionCache();
-		/// Flushes the SSL session cache on the server.
+		/// Flushes the SSL session cache.
+		///
+		/// On the server, expired sessions are removed from the cache.
+		/// On the client, all cached sessions are removed.
+
+	Session::Ptr findClientSession(const std::string& key);
+		/// Returns the cached client session for the given key
+		/// (host:port), or a null pointer if no resumable session
+		/// is cached for the key.
+		///
+		/// A TLS 1.3 session is removed from the cache when it
+		/// is returned, as TLS 1.3 session tickets should only
+		/// be used once. The server usually sends a fresh ticket
+		/// with the resumed connection.
+		///
+		/// This method may only be called on client Context objects.
+
+	void addClientSession(const std::string& key, Session::Ptr pSession);
+		/// Adds the given session to the client session cache,
+		/// replacing any session cached for the same key.
+		///
+		/// This method may only be called on client Context objects.
+
+	void removeClientSession(const std::string& key);
+		/// Removes the cached client session for the given key.
+		///
+		/// This method may only be called on client Context objects.
+
+	std::size_t clientSessionCount() const;
+		/// Returns the number of sessions in the client session cache.
+
+	void setSessionTicketKeyRotation(long seconds);
+		/// Enables rotation of the keys used to encrypt and authenticate
+		/// RFC 5077 session tickets (stateless session resumption).
+		///
+		/// By default, OpenSSL generates a random ticket key when the
+		/// SSL_CTX is created and uses it for the lifetime of the context.
+		/// With key rotation enabled, a new key is generated every
+		/// given number of seconds. Tickets encrypted with an older key
+		/// are still accepted (and renewed) until they expire, i.e. for
+		/// the rotation interval plus the session timeout.
+		///
+		/// Specifying 0 seconds disables key rotation and
+		/// restores the OpenSSL default behavior.
 		///
 		/// This method may only be called on SERVER_USE Context objects.
 
+	long getSessionTicketKeyRotation() const;
+		/// Returns the session ticket key rotation interval
+		/// in seconds, or 0 if key rotation is disabled.
+
+	Poco::UInt64 handshakeCount() const;
+		/// Returns the number of TLS handshakes completed by
+		/// sockets using this Context.
+
+	Poco::UInt64 resumedHandshakeCount() const;
+		/// Returns the number of completed TLS handshakes that
+		/// resumed a previous session (abbreviated handshakes).
+
+	double resumptionRatio() const;
+		/// Returns the ratio of resumed handshakes to all
+		/// handshakes (0.0 to 1.0), or 0.0 if no handshake
+		/// has been completed yet.
+
+	void resetHandshakeStatistics();
+		/// Resets the handshake counters to zero.
+
 	void enableExtendedCertificateVerification(bool flag = true);
 		/// Enable or disable the automatic post-connection
 		/// extended certificate verification.
@@ -342,7 +435,23 @@ public:
 		/// preferences. When called, the SSL/TLS server will choose following its own
 		/// preferences.
 
+	enum
+	{
+		DEFAULT_CLIENT_SESSION_CACHE_SIZE = 64
+	};
+
 private:
+	struct TicketKey
+	{
+		unsigned char name[16];
+		unsigned char aesKey[32];
+		unsigned char hmacKey[32];
+		Poco::Timestamp created;
+	};
+
+	typedef std::map<std::string, Session::Ptr> ClientSessionMap;
+	typedef std::deque<TicketKey> TicketKeyList;
+
 	void init(const Params& params);
 		/// Initializes the Context with the given parameters.
 
@@ -356,10 +465,50 @@ private:
 	void createSSLContext();
 		/// Create a SSL_CTX object according to Context configuration.
 
+	void handshakeCompleted(bool resumed);
+		/// Updates the handshake counters. Called by SecureSocketImpl.
+
+	bool findTicketKey(const unsigned char* name, TicketKey& key, bool& current);
+		/// Finds the ticket key with the given name. Returns false
+		/// if no such key exists (any more).
+
+	const TicketKey& currentTicketKey();
+		/// Returns the current ticket key, rotating keys if necessary.
+		/// Must be called with _ticketKeyMutex locked.
+
+	static Context* fromSSLContext(SSL_CTX* pSSLContext);
+		/// Returns the Context owning the given SSL_CTX.
+
+	static int contextIndex();
+		/// Returns the SSL_CTX ex_data index for the Context pointer.
+
+	static int sessionKeyIndex();
+		/// Returns the SSL ex_data index for the client session key.
+
+	static int onNewClientSession(SSL* pSSL, SSL_SESSION* pSession);
+		/// OpenSSL callback for storing new client sessions.
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	static int onSessionTicketKey(SSL* pSSL, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* pCipherCtx, EVP_MAC_CTX* pMacCtx, int enc);
+#else
+	static int onSessionTicketKey(SSL* pSSL, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* pCipherCtx, HMAC_CTX* pMacCtx, int enc);
+#endif
+		/// OpenSSL callback for encrypting and decrypting session tickets.
+
 	Usage _usage;
 	VerificationMode _mode;
 	SSL_CTX* _pSSLContext;
 	bool _extendedCertificateVerification;
+	ClientSessionMap _clientSessions;
+	std::size_t _clientSessionCacheSize;
+	mutable Poco::FastMutex _clientSessionMutex;
+	Poco::Timestamp::TimeDiff _ticketKeyRotation;
+	TicketKeyList _ticketKeys;
+	Poco::FastMutex _ticketKeyMutex;
+	Poco::AtomicCounter _handshakes;
+	Poco::AtomicCounter _resumedHandshakes;
+
+	friend class SecureSocketImpl;
 };
 
 
@@ -399,6 +548,24 @@ inline bool Context::extendedCertificateVerificationEnabled() const
 }
 
 
+inline long Context::getSessionTicketKeyRotation() const
+{
+	return static_cast<long>(_ticketKeyRotation/Poco::Timestamp::resolution());
+}
+
+
+inline Poco::UInt64 Context::handshakeCount() const
+{
+	return static_cast<Poco::UInt64>(_handshakes.value());
+}
+
+
+inline Poco::UInt64 Context::resumedHandshakeCount() const
+{
+	return static_cast<Poco::UInt64>(_resumedHandshakes.value());
+}
+
+
 } } // namespace Poco::Net
 
 
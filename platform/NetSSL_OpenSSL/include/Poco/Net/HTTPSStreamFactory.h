@@ -55,6 +55,11 @@ public:
 		/// The URI must be a https://... URI.
 		///
 		/// Throws a NetException if anything goes wrong.
+		///
+		/// Sessions are obtained from the default HTTPClientSessionPool,
+		/// provided that the HTTPSSessionInstantiator has been registered.
+		/// The session is returned to the pool when the stream is
+		/// destroyed after the response has been read completely.
 		
 	static void registerFactory();
 		/// Registers the HTTPSStreamFactory with the
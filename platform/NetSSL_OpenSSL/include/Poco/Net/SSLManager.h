@@ -87,8 +87,9 @@ class NetSSL_API SSLManager
 	///            </invalidCertificateHandler>
 	///            <cacheSessions>true|false</cacheSessions>
 	///            <sessionIdContext>someString</sessionIdContext> <!-- server only -->
-	///            <sessionCacheSize>0..n</sessionCacheSize>       <!-- server only -->
+	///            <sessionCacheSize>0..n</sessionCacheSize>
 	///            <sessionTimeout>0..n</sessionTimeout>           <!-- server only -->
+	///            <sessionTicketKeyRotation>0..n</sessionTicketKeyRotation> <!-- server only -->
 	///            <extendedVerification>true|false</extendedVerification>
 	///            <requireTLSv1>true|false</requireTLSv1>
 	///            <requireTLSv1_1>true|false</requireTLSv1_1>
@@ -127,17 +128,24 @@ class NetSSL_API SSLManager
 	///    - invalidCertificateHandler.name: The name of the class (subclass of CertificateHandler)
 	///      used for confirming invalid certificates.
 	///    - cacheSessions (boolean): Enables or disables session caching.
+	///      On the client side, sessions are cached per server host and port and
+	///      automatically resumed by subsequent connections using the same Context.
 	///    - sessionIdContext (string): contains the application's unique session ID context, which becomes 
 	///      part of each session identifier generated by the server. Can be an arbitrary sequence 
 	///      of bytes with a maximum length of SSL_MAX_SSL_SESSION_ID_LENGTH. Should be specified
 	///      for a server to enable session caching. Should be specified even if session caching
 	///      is disabled to avoid problems with clients that request session caching (e.g. Firefox 3.6).
 	///      If not specified, defaults to ${application.name}.
-	///    - sessionCacheSize (integer): Sets the maximum size of the server session cache, in number of
-	///      sessions. The default size (according to OpenSSL documentation) is 1024*20, which may be too 
+	///    - sessionCacheSize (integer): Sets the maximum size of the session cache, in number of
+	///      sessions. The default size for a server (according to OpenSSL documentation) is 1024*20, which may be too 
 	///      large for many applications, especially on embedded platforms with limited memory.
+	///      The default size for a client is 64.
 	///      Specifying a size of 0 will set an unlimited cache size.
 	///    - sessionTimeout (integer):  Sets the timeout (in seconds) of cached sessions on the server.
+	///    - sessionTicketKeyRotation (integer): Sets the interval (in seconds) after which the server
+	///      generates a new key for encrypting session tickets (stateless session resumption).
+	///      Tickets encrypted with a previous key are accepted until they expire.
+	///      Defaults to 0, which uses a single OpenSSL-generated key for the lifetime of the server.
 	///    - extendedVerification (boolean): Enable or disable the automatic post-connection
 	///      extended certificate verification.
 	///    - requireTLSv1 (boolean): Require a TLSv1 connection.
@@ -329,6 +337,7 @@ private:
 	static const std::string CFG_SESSION_ID_CONTEXT;
 	static const std::string CFG_SESSION_CACHE_SIZE;
 	static const std::string CFG_SESSION_TIMEOUT;
+	static const std::string CFG_SESSION_TICKET_KEY_ROTATION;
 	static const std::string CFG_EXTENDED_VERIFICATION;
 	static const std::string CFG_REQUIRE_TLSV1;
 	static const std::string CFG_REQUIRE_TLSV1_1;
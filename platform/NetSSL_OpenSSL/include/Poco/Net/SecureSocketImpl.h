@@ -187,6 +187,17 @@ protected:
 	void connectSSL(bool performHandshake);
 		/// Performs a client-side SSL handshake and establishes a secure 
 		/// connection over an already existing TCP connection.
+		///
+		/// If no session has been set with useSession() and session
+		/// caching is enabled in the Context, a session cached for
+		/// the peer's host and port is resumed.
+
+	void setSessionKey(const SocketAddress& address);
+		/// Sets the key (host:port) for the client session cache,
+		/// using the peer host name, if set, or the given address.
+
+	void handshakeCompleted();
+		/// Updates the Context's handshake statistics.
 	
 	long verifyPeerCertificateImpl(const std::string& hostName);
 		/// Performs post-connect (or post-accept) peer certificate validation.
@@ -230,6 +241,7 @@ private:
 	Context::Ptr _pContext;
 	bool _needHandshake;
 	std::string _peerHostName;
+	std::string _sessionKey;
 	Session::Ptr _pSession;
 	
 	friend class SecureStreamSocketImpl;
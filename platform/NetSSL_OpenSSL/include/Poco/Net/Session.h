@@ -35,6 +35,9 @@ class NetSSL_API Session: public Poco::RefCountedObject
 	/// For session caching to work, a client must
 	/// save the session object from an existing connection,
 	/// if it wants to reuse it with a future connection.
+	/// Alternatively, if session caching is enabled in the
+	/// client Context, sessions are cached automatically
+	/// per host and port (see Context).
 {
 public:
 	typedef Poco::AutoPtr<Session> Ptr;
@@ -61,6 +64,7 @@ private:
 	SSL_SESSION* _pSession;
 	
 	friend class SecureSocketImpl;
+	friend class Context;
 };
 
 
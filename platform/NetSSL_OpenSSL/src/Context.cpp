@@ -20,16 +20,38 @@
 #include "Poco/File.h"
 #include "Poco/Path.h"
 #include "Poco/Timestamp.h"
+#include "Poco/Exception.h"
 #include <openssl/bio.h>
 #include <openssl/err.h>
 #include <openssl/ssl.h>
 #include <openssl/x509v3.h>
+#include <openssl/rand.h>
+#include <openssl/evp.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#else
+#include <openssl/hmac.h>
+#endif
+#include <cstring>
 
 
 namespace Poco {
 namespace Net {
 
 
+namespace
+{
+	bool isResumable(SSL_SESSION* pSession, long now)
+	{
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L && !defined(LIBRESSL_VERSION_NUMBER)
+		if (!SSL_SESSION_is_resumable(pSession)) return false;
+#endif
+		return static_cast<long>(SSL_SESSION_get_time(pSession)) + static_cast<long>(SSL_SESSION_get_timeout(pSession)) > now;
+	}
+}
+
+
 Context::Params::Params():
 	verificationMode(VERIFY_RELAXED),
 	verificationDepth(9),
@@ -43,7 +65,9 @@ Context::Context(Usage usage, const Params& params):
 	_usage(usage),
 	_mode(params.verificationMode),
 	_pSSLContext(0),
-	_extendedCertificateVerification(true)
+	_extendedCertificateVerification(true),
+	_clientSessionCacheSize(DEFAULT_CLIENT_SESSION_CACHE_SIZE),
+	_ticketKeyRotation(0)
 {
 	init(params);
 }
@@ -61,7 +85,9 @@ Context::Context(
 	_usage(usage),
 	_mode(verificationMode),
 	_pSSLContext(0),
-	_extendedCertificateVerification(true)
+	_extendedCertificateVerification(true),
+	_clientSessionCacheSize(DEFAULT_CLIENT_SESSION_CACHE_SIZE),
+	_ticketKeyRotation(0)
 {
 	Params params;
 	params.privateKeyFile = privateKeyFile;
@@ -85,7 +111,9 @@ Context::Context(
 	_usage(usage),
 	_mode(verificationMode),
 	_pSSLContext(0),
-	_extendedCertificateVerification(true)
+	_extendedCertificateVerification(true),
+	_clientSessionCacheSize(DEFAULT_CLIENT_SESSION_CACHE_SIZE),
+	_ticketKeyRotation(0)
 {
 	Params params;
 	params.caLocation = caLocation;
@@ -101,6 +129,7 @@ Context::~Context()
 {
 	try
 	{
+		_clientSessions.clear();
 		SSL_CTX_free(_pSSLContext);
 		Poco::Crypto::OpenSSLInitializer::uninitialize();
 	}
@@ -173,6 +202,11 @@ void Context::init(const Params& params)
 		SSL_CTX_set_verify_depth(_pSSLContext, params.verificationDepth);
 		SSL_CTX_set_mode(_pSSLContext, SSL_MODE_AUTO_RETRY);
 		SSL_CTX_set_session_cache_mode(_pSSLContext, SSL_SESS_CACHE_OFF);
+		SSL_CTX_set_ex_data(_pSSLContext, contextIndex(), this);
+		if (!isForServerUse())
+		{
+			SSL_CTX_sess_set_new_cb(_pSSLContext, &Context::onNewClientSession);
+		}
 
 		initDH(params.dhParamsFile);
 		initECDH(params.ecdhCurve);
@@ -241,11 +275,14 @@ void Context::enableSessionCache(bool flag)
 {
 	if (flag)
 	{
-		SSL_CTX_set_session_cache_mode(_pSSLContext, isForServerUse() ? SSL_SESS_CACHE_SERVER : SSL_SESS_CACHE_CLIENT);
+		// Client sessions are kept in our own cache, keyed by host and port,
+		// so OpenSSL's internal cache would only hold redundant copies.
+		SSL_CTX_set_session_cache_mode(_pSSLContext, isForServerUse() ? SSL_SESS_CACHE_SERVER : (SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE));
 	}
 	else
 	{
 		SSL_CTX_set_session_cache_mode(_pSSLContext, SSL_SESS_CACHE_OFF);
+		if (!isForServerUse()) flushSessionCache();
 	}
 }
 
@@ -278,17 +315,35 @@ bool Context::sessionCacheEnabled() const
 
 void Context::setSessionCacheSize(std::size_t size)
 {
-	poco_assert (isForServerUse());
+	if (isForServerUse())
+	{
+		SSL_CTX_sess_set_cache_size(_pSSLContext, static_cast<long>(size));
+	}
+	else
+	{
+		Poco::FastMutex::ScopedLock lock(_clientSessionMutex);
 
-	SSL_CTX_sess_set_cache_size(_pSSLContext, static_cast<long>(size));
+		_clientSessionCacheSize = size;
+		while (_clientSessionCacheSize > 0 && _clientSessions.size() > _clientSessionCacheSize)
+		{
+			_clientSessions.erase(_clientSessions.begin());
+		}
+	}
 }
 
 
 std::size_t Context::getSessionCacheSize() const
 {
-	poco_assert (isForServerUse());
+	if (isForServerUse())
+	{
+		return static_cast<std::size_t>(SSL_CTX_sess_get_cache_size(_pSSLContext));
+	}
+	else
+	{
+		Poco::FastMutex::ScopedLock lock(_clientSessionMutex);
 
-	return static_cast<std::size_t>(SSL_CTX_sess_get_cache_size(_pSSLContext));
+		return _clientSessionCacheSize;
+	}
 }
 
 
@@ -309,11 +364,276 @@ long Context::getSessionTimeout() const
 
 
 void Context::flushSessionCache()
+{
+	if (isForServerUse())
+	{
+		Poco::Timestamp now;
+		SSL_CTX_flush_sessions(_pSSLContext, static_cast<long>(now.epochTime()));
+	}
+	else
+	{
+		Poco::FastMutex::ScopedLock lock(_clientSessionMutex);
+
+		_clientSessions.clear();
+	}
+}
+
+
+Session::Ptr Context::findClientSession(const std::string& key)
+{
+	poco_assert (!isForServerUse());
+
+	Poco::FastMutex::ScopedLock lock(_clientSessionMutex);
+
+	ClientSessionMap::iterator it = _clientSessions.find(key);
+	if (it != _clientSessions.end())
+	{
+		Session::Ptr pSession = it->second;
+		Poco::Timestamp now;
+		if (isResumable(pSession->sslSession(), static_cast<long>(now.epochTime())))
+		{
+#if defined(TLS1_3_VERSION)
+			if (SSL_SESSION_get_protocol_version(pSession->sslSession()) >= TLS1_3_VERSION)
+			{
+				_clientSessions.erase(it);
+			}
+#endif
+			return pSession;
+		}
+		_clientSessions.erase(it);
+	}
+	return 0;
+}
+
+
+void Context::addClientSession(const std::string& key, Session::Ptr pSession)
+{
+	poco_assert (!isForServerUse());
+	poco_check_ptr (pSession);
+
+	Poco::FastMutex::ScopedLock lock(_clientSessionMutex);
+
+	if (_clientSessionCacheSize > 0 && _clientSessions.size() >= _clientSessionCacheSize && _clientSessions.find(key) == _clientSessions.end())
+	{
+		Poco::Timestamp now;
+		long epoch = static_cast<long>(now.epochTime());
+		ClientSessionMap::iterator itOldest = _clientSessions.end();
+		ClientSessionMap::iterator it = _clientSessions.begin();
+		while (it != _clientSessions.end())
+		{
+			if (!isResumable(it->second->sslSession(), epoch))
+			{
+				_clientSessions.erase(it++);
+			}
+			else
+			{
+				if (itOldest == _clientSessions.end() || SSL_SESSION_get_time(it->second->sslSession()) < SSL_SESSION_get_time(itOldest->second->sslSession()))
+					itOldest = it;
+				++it;
+			}
+		}
+		if (_clientSessions.size() >= _clientSessionCacheSize && itOldest != _clientSessions.end())
+		{
+			_clientSessions.erase(itOldest);
+		}
+	}
+	_clientSessions[key] = pSession;
+}
+
+
+void Context::removeClientSession(const std::string& key)
+{
+	poco_assert (!isForServerUse());
+
+	Poco::FastMutex::ScopedLock lock(_clientSessionMutex);
+
+	_clientSessions.erase(key);
+}
+
+
+std::size_t Context::clientSessionCount() const
+{
+	Poco::FastMutex::ScopedLock lock(_clientSessionMutex);
+
+	return _clientSessions.size();
+}
+
+
+void Context::setSessionTicketKeyRotation(long seconds)
 {
 	poco_assert (isForServerUse());
+	poco_assert (seconds >= 0);
+
+	Poco::FastMutex::ScopedLock lock(_ticketKeyMutex);
+
+	_ticketKeyRotation = Poco::Timestamp::TimeDiff(seconds)*Poco::Timestamp::resolution();
+	_ticketKeys.clear();
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	SSL_CTX_set_tlsext_ticket_key_evp_cb(_pSSLContext, seconds > 0 ? &Context::onSessionTicketKey : 0);
+#elif defined(SSL_CTRL_SET_TLSEXT_TICKET_KEY_CB)
+	if (seconds > 0)
+		SSL_CTX_set_tlsext_ticket_key_cb(_pSSLContext, &Context::onSessionTicketKey);
+	else
+		SSL_CTX_callback_ctrl(_pSSLContext, SSL_CTRL_SET_TLSEXT_TICKET_KEY_CB, 0);
+#else
+	if (seconds > 0) throw Poco::NotImplementedException("Session ticket key rotation is not supported by this OpenSSL version");
+#endif
+}
+
+
+double Context::resumptionRatio() const
+{
+	Poco::UInt64 handshakes = handshakeCount();
+	if (handshakes > 0)
+		return static_cast<double>(resumedHandshakeCount())/handshakes;
+	else
+		return 0.0;
+}
+
+
+void Context::resetHandshakeStatistics()
+{
+	_handshakes = 0;
+	_resumedHandshakes = 0;
+}
+
+
+void Context::handshakeCompleted(bool resumed)
+{
+	++_handshakes;
+	if (resumed) ++_resumedHandshakes;
+}
+
+
+const Context::TicketKey& Context::currentTicketKey()
+{
+	if (_ticketKeys.empty() || _ticketKeys.front().created.isElapsed(_ticketKeyRotation))
+	{
+		TicketKey key;
+		if (RAND_bytes(key.name, sizeof(key.name)) != 1 ||
+		    RAND_bytes(key.aesKey, sizeof(key.aesKey)) != 1 ||
+		    RAND_bytes(key.hmacKey, sizeof(key.hmacKey)) != 1)
+		{
+			std::string msg = Utility::getLastError();
+			throw SSLContextException("Cannot generate session ticket key", msg);
+		}
+		_ticketKeys.push_front(key);
+	}
+
+	// A ticket may have been issued with a key just before the key was
+	// replaced, and must be accepted until the session times out.
+	Poco::Timestamp::TimeDiff maxAge = _ticketKeyRotation + Poco::Timestamp::TimeDiff(SSL_CTX_get_timeout(_pSSLContext))*Poco::Timestamp::resolution();
+	while (_ticketKeys.size() > 1 && _ticketKeys.back().created.isElapsed(maxAge))
+	{
+		_ticketKeys.pop_back();
+	}
+	return _ticketKeys.front();
+}
+
+
+bool Context::findTicketKey(const unsigned char* name, TicketKey& key, bool& current)
+{
+	Poco::FastMutex::ScopedLock lock(_ticketKeyMutex);
+
+	currentTicketKey();
+	for (TicketKeyList::const_iterator it = _ticketKeys.begin(); it != _ticketKeys.end(); ++it)
+	{
+		if (std::memcmp(it->name, name, sizeof(it->name)) == 0)
+		{
+			key = *it;
+			current = (it == _ticketKeys.begin());
+			return true;
+		}
+	}
+	return false;
+}
+
 
-	Poco::Timestamp now;
-	SSL_CTX_flush_sessions(_pSSLContext, static_cast<long>(now.epochTime()));
+Context* Context::fromSSLContext(SSL_CTX* pSSLContext)
+{
+	return reinterpret_cast<Context*>(SSL_CTX_get_ex_data(pSSLContext, contextIndex()));
+}
+
+
+int Context::contextIndex()
+{
+	static const int index = SSL_CTX_get_ex_new_index(0, 0, 0, 0, 0);
+	return index;
+}
+
+
+int Context::sessionKeyIndex()
+{
+	static const int index = SSL_get_ex_new_index(0, 0, 0, 0, 0);
+	return index;
+}
+
+
+int Context::onNewClientSession(SSL* pSSL, SSL_SESSION* pSession)
+{
+	Context* pContext = fromSSLContext(SSL_get_SSL_CTX(pSSL));
+	const std::string* pKey = reinterpret_cast<const std::string*>(SSL_get_ex_data(pSSL, sessionKeyIndex()));
+	if (pContext && pKey && !pKey->empty())
+	{
+		try
+		{
+			// Session takes over the reference passed to us; returning 1 tells OpenSSL so.
+			pContext->addClientSession(*pKey, new Session(pSession));
+			return 1;
+		}
+		catch (...)
+		{
+		}
+	}
+	return 0;
+}
+
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+int Context::onSessionTicketKey(SSL* pSSL, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* pCipherCtx, EVP_MAC_CTX* pMacCtx, int enc)
+#else
+int Context::onSessionTicketKey(SSL* pSSL, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* pCipherCtx, HMAC_CTX* pMacCtx, int enc)
+#endif
+{
+	Context* pContext = fromSSLContext(SSL_get_SSL_CTX(pSSL));
+	if (!pContext) return -1;
+
+	try
+	{
+		TicketKey key;
+		bool current = true;
+		if (enc)
+		{
+			{
+				Poco::FastMutex::ScopedLock lock(pContext->_ticketKeyMutex);
+				key = pContext->currentTicketKey();
+			}
+			if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1) return -1;
+			std::memcpy(name, key.name, sizeof(key.name));
+			if (EVP_EncryptInit_ex(pCipherCtx, EVP_aes_256_cbc(), 0, key.aesKey, iv) != 1) return -1;
+		}
+		else
+		{
+			// unknown (e.g., expired) key: fall back to a full handshake
+			if (!pContext->findTicketKey(name, key, current)) return 0;
+			if (EVP_DecryptInit_ex(pCipherCtx, EVP_aes_256_cbc(), 0, key.aesKey, iv) != 1) return -1;
+		}
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+		OSSL_PARAM params[3];
+		params[0] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key.hmacKey, sizeof(key.hmacKey));
+		params[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>("SHA256"), 0);
+		params[2] = OSSL_PARAM_construct_end();
+		if (EVP_MAC_CTX_set_params(pMacCtx, params) != 1) return -1;
+#else
+		if (HMAC_Init_ex(pMacCtx, key.hmacKey, sizeof(key.hmacKey), EVP_sha256(), 0) != 1) return -1;
+#endif
+		// 2 tells OpenSSL to accept the ticket, but issue a new one with the current key
+		return current ? 1 : 2;
+	}
+	catch (...)
+	{
+		return -1;
+	}
 }
 
 
@@ -14,6 +14,8 @@
 
 #include "Poco/Net/HTTPSStreamFactory.h"
 #include "Poco/Net/HTTPSClientSession.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
+#include "Poco/Net/HTTPSessionFactory.h"
 #include "Poco/Net/HTTPIOStream.h"
 #include "Poco/Net/HTTPRequest.h"
 #include "Poco/Net/HTTPResponse.h"
@@ -71,7 +73,9 @@ std::istream* HTTPSStreamFactory::open(const URI& uri)
 
 	URI resolvedURI(uri);
 	URI proxyUri;
-	HTTPClientSession* pSession = 0;
+	HTTPClientSessionPool& pool = HTTPClientSessionPool::defaultPool();
+	HTTPClientSessionPool::SessionPtr pSession;
+	bool pooled = false;
 	HTTPResponse res;
 	try
 	{
@@ -85,27 +89,40 @@ std::istream* HTTPSStreamFactory::open(const URI& uri)
 		{
 			if (!pSession)
 			{
-				if (resolvedURI.getScheme() != "http")
-					pSession = new HTTPSClientSession(resolvedURI.getHost(), resolvedURI.getPort());
-				else
-					pSession = new HTTPClientSession(resolvedURI.getHost(), resolvedURI.getPort());
-
+				HTTPClientSession::ProxyConfig proxyConfig(HTTPClientSession::getGlobalProxyConfig());
 				if (proxyUri.empty())
 				{
 					if (!_proxyHost.empty())
 					{
-						pSession->setProxy(_proxyHost, _proxyPort);
-						pSession->setProxyCredentials(_proxyUsername, _proxyPassword);
+						proxyConfig.host = _proxyHost;
+						proxyConfig.port = _proxyPort;
+						proxyConfig.username = _proxyUsername;
+						proxyConfig.password = _proxyPassword;
 					}
 				}
 				else
 				{
-					pSession->setProxy(proxyUri.getHost(), proxyUri.getPort());
+					proxyConfig.host = proxyUri.getHost();
+					proxyConfig.port = proxyUri.getPort();
 					if (!_proxyUsername.empty())
 					{
-						pSession->setProxyCredentials(_proxyUsername, _proxyPassword);
+						proxyConfig.username = _proxyUsername;
+						proxyConfig.password = _proxyPassword;
 					}
 				}
+
+				// https sessions can only be pooled if the HTTPSSessionInstantiator
+				// has been registered with the default HTTPSessionFactory.
+				pooled = resolvedURI.getScheme() == "http" || HTTPSessionFactory::defaultFactory().supportsProtocol(resolvedURI.getScheme());
+				if (pooled)
+				{
+					pSession = pool.acquire(resolvedURI, proxyConfig);
+				}
+				else
+				{
+					pSession = new HTTPSClientSession(resolvedURI.getHost(), resolvedURI.getPort());
+					pSession->setProxyConfig(proxyConfig);
+				}
 			}
 			std::string path = resolvedURI.getPathAndQuery();
 			if (path.empty()) path = "/";
@@ -124,8 +141,23 @@ std::istream* HTTPSStreamFactory::open(const URI& uri)
 				(POCO_VERSION >> 8) & 0xFF));
 			req.set("Accept", "*/*");
 
-			pSession->sendRequest(req);
-			std::istream& rs = pSession->receiveResponse(res);
+			std::istream* pResponseStream = 0;
+			try
+			{
+				pSession->sendRequest(req);
+				pResponseStream = &pSession->receiveResponse(res);
+			}
+			catch (NetException&)
+			{
+				// The server may have closed a reused keep-alive
+				// connection, so the request is sent once more.
+				if (!pooled) throw;
+				pSession = pool.reconnect(pSession, req.getMethod());
+				if (!pSession) throw;
+				pSession->sendRequest(req);
+				pResponseStream = &pSession->receiveResponse(res);
+			}
+			std::istream& rs = *pResponseStream;
 			bool moved = (res.getStatus() == HTTPResponse::HTTP_MOVED_PERMANENTLY || 
 			              res.getStatus() == HTTPResponse::HTTP_FOUND || 
 			              res.getStatus() == HTTPResponse::HTTP_SEE_OTHER ||
@@ -138,14 +170,14 @@ std::istream* HTTPSStreamFactory::open(const URI& uri)
 					resolvedURI.setUserInfo(username + ":" + password);
 					authorize = false;
 				}
-				delete pSession; 
+				if (pooled) pool.discard(pSession);
 				pSession = 0;
 				++redirects;
 				retry = true;
 			}
 			else if (res.getStatus() == HTTPResponse::HTTP_OK)
 			{
-				return new HTTPResponseStream(rs, pSession);
+				return new HTTPResponseStream(rs, pSession, pooled ? &pool : 0);
 			}
 			else if (res.getStatus() == HTTPResponse::HTTP_USEPROXY && !retry)
 			{
@@ -155,7 +187,7 @@ std::istream* HTTPSStreamFactory::open(const URI& uri)
 				// single request via the proxy. 305 responses MUST only be generated by origin servers.
 				// only use for one single request!
 				proxyUri.resolve(res.get("Location"));
-				delete pSession; 
+				if (pooled) pool.discard(pSession);
 				pSession = 0;
 				retry = true; // only allow useproxy once
 			}
@@ -173,7 +205,7 @@ std::istream* HTTPSStreamFactory::open(const URI& uri)
 	}
 	catch (...)
 	{
-		delete pSession;
+		if (pSession && pooled) pool.discard(pSession);
 		throw;
 	}
 }
@@ -53,6 +53,7 @@ const std::string SSLManager::CFG_CACHE_SESSIONS("cacheSessions");
 const std::string SSLManager::CFG_SESSION_ID_CONTEXT("sessionIdContext");
 const std::string SSLManager::CFG_SESSION_CACHE_SIZE("sessionCacheSize");
 const std::string SSLManager::CFG_SESSION_TIMEOUT("sessionTimeout");
+const std::string SSLManager::CFG_SESSION_TICKET_KEY_ROTATION("sessionTicketKeyRotation");
 const std::string SSLManager::CFG_EXTENDED_VERIFICATION("extendedVerification");
 const std::string SSLManager::CFG_REQUIRE_TLSV1("requireTLSv1");
 const std::string SSLManager::CFG_REQUIRE_TLSV1_1("requireTLSv1_1");
@@ -345,10 +346,20 @@ void SSLManager::initDefaultContext(bool server)
 			int timeout = config.getInt(prefix + CFG_SESSION_TIMEOUT);
 			_ptrDefaultServerContext->setSessionTimeout(timeout);
 		}
+		int ticketKeyRotation = config.getInt(prefix + CFG_SESSION_TICKET_KEY_ROTATION, 0);
+		if (ticketKeyRotation > 0)
+		{
+			_ptrDefaultServerContext->setSessionTicketKeyRotation(ticketKeyRotation);
+		}
 	}
 	else
 	{
 		_ptrDefaultClientContext->enableSessionCache(cacheSessions);
+		if (config.hasProperty(prefix + CFG_SESSION_CACHE_SIZE))
+		{
+			int cacheSize = config.getInt(prefix + CFG_SESSION_CACHE_SIZE);
+			_ptrDefaultClientContext->setSessionCacheSize(cacheSize);
+		}
 	}
 	bool extendedVerification = config.getBool(prefix + CFG_EXTENDED_VERIFICATION, false);
 	if (server)
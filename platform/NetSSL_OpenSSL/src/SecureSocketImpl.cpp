@@ -108,6 +108,7 @@ void SecureSocketImpl::connect(const SocketAddress& address, bool performHandsha
 	poco_assert (!_pSSL);
 
 	_pSocket->connect(address);
+	setSessionKey(address);
 	connectSSL(performHandshake);
 }
 
@@ -123,6 +124,7 @@ void SecureSocketImpl::connect(const SocketAddress& address, const Poco::Timespa
 	Poco::Timespan sendTimeout = _pSocket->getSendTimeout();
 	_pSocket->setReceiveTimeout(timeout);
 	_pSocket->setSendTimeout(timeout);
+	setSessionKey(address);
 	connectSSL(performHandshake);
 	_pSocket->setReceiveTimeout(receiveTimeout);
 	_pSocket->setSendTimeout(sendTimeout);
@@ -136,6 +138,7 @@ void SecureSocketImpl::connectNB(const SocketAddress& address)
 	poco_assert (!_pSSL);
 
 	_pSocket->connectNB(address);
+	setSessionKey(address);
 	connectSSL(false);
 }
 
@@ -164,10 +167,18 @@ void SecureSocketImpl::connectSSL(bool performHandshake)
 	}
 #endif
 
-	if (_pSession)
+	Session::Ptr pSession = _pSession;
+	bool cachedSession = false;
+	if (!pSession && !_sessionKey.empty() && _pContext->sessionCacheEnabled())
 	{
-		SSL_set_session(_pSSL, _pSession->sslSession());
+		pSession = _pContext->findClientSession(_sessionKey);
+		cachedSession = !pSession.isNull();
 	}
+	if (pSession)
+	{
+		SSL_set_session(_pSSL, pSession->sslSession());
+	}
+	SSL_set_ex_data(_pSSL, Context::sessionKeyIndex(), &_sessionKey);
 
 	try
 	{
@@ -175,6 +186,7 @@ void SecureSocketImpl::connectSSL(bool performHandshake)
 		{
 			int ret = SSL_connect(_pSSL);
 			handleError(ret);
+			handshakeCompleted();
 			verifyPeerCertificate();
 		}
 		else
@@ -185,6 +197,8 @@ void SecureSocketImpl::connectSSL(bool performHandshake)
 	}
 	catch (...)
 	{
+		// don't try the cached session again if the handshake failed
+		if (cachedSession) _pContext->removeClientSession(_sessionKey);
 		SSL_free(_pSSL);
 		_pSSL = 0;
 		throw;
@@ -192,6 +206,27 @@ void SecureSocketImpl::connectSSL(bool performHandshake)
 }
 
 
+void SecureSocketImpl::setSessionKey(const SocketAddress& address)
+{
+	if (_pContext->isForServerUse())
+	{
+		_sessionKey.clear();
+	}
+	else
+	{
+		_sessionKey = _peerHostName.empty() ? address.host().toString() : _peerHostName;
+		_sessionKey += ':';
+		NumberFormatter::append(_sessionKey, address.port());
+	}
+}
+
+
+void SecureSocketImpl::handshakeCompleted()
+{
+	_pContext->handshakeCompleted(SSL_session_reused(_pSSL) != 0);
+}
+
+
 void SecureSocketImpl::bind(const SocketAddress& address, bool reuseAddress)
 {
 	poco_check_ptr (_pSocket);
@@ -329,6 +364,7 @@ int SecureSocketImpl::completeHandshake()
 		return handleError(rc);
 	}
 	_needHandshake = false;
+	handshakeCompleted();
 	return rc;
 }
 
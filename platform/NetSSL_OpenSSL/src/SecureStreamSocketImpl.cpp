@@ -85,6 +85,7 @@ void SecureStreamSocketImpl::connectNB(const SocketAddress& address)
 
 void SecureStreamSocketImpl::connectSSL()
 {
+	_impl.setSessionKey(peerAddress());
 	_impl.connectSSL(!_lazyHandshake);
 }
 	
@@ -413,6 +413,120 @@ void HTTPSClientSessionTest::testCachedSession()
 }
 
 
+void HTTPSClientSessionTest::testAutoCachedSession()
+{
+	Context::Ptr pServerContext = new Context(
+		Context::SERVER_USE,
+		Application::instance().config().getString("openSSL.server.privateKeyFile"),
+		Application::instance().config().getString("openSSL.server.privateKeyFile"),
+		Application::instance().config().getString("openSSL.server.caConfig"),
+		Context::VERIFY_NONE,
+		9,
+		true,
+		"ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
+	pServerContext->enableSessionCache(true, "TestSuite");
+
+	HTTPSTestServer srv(pServerContext);
+
+	Context::Ptr pClientContext = new Context(
+		Context::CLIENT_USE,
+		Application::instance().config().getString("openSSL.client.privateKeyFile"),
+		Application::instance().config().getString("openSSL.client.privateKeyFile"),
+		Application::instance().config().getString("openSSL.client.caConfig"),
+		Context::VERIFY_RELAXED,
+		9,
+		true,
+		"ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
+	pClientContext->enableSessionCache(true);
+
+	for (int i = 0; i < 3; i++)
+	{
+		HTTPSClientSession s("127.0.0.1", srv.port(), pClientContext);
+		HTTPRequest request(HTTPRequest::HTTP_GET, "/small");
+		s.sendRequest(request);
+		HTTPResponse response;
+		std::istream& rs = s.receiveResponse(response);
+		std::ostringstream ostr;
+		StreamCopier::copyStream(rs, ostr);
+		assert (ostr.str() == HTTPSTestServer::SMALL_BODY);
+		assert (pClientContext->clientSessionCount() == 1);
+	}
+
+	assert (pClientContext->handshakeCount() == 3);
+	assert (pClientContext->resumedHandshakeCount() == 2);
+	assert (pServerContext->handshakeCount() == 3);
+	assert (pServerContext->resumedHandshakeCount() == 2);
+
+	pClientContext->flushSessionCache();
+	assert (pClientContext->clientSessionCount() == 0);
+
+	HTTPSClientSession s("127.0.0.1", srv.port(), pClientContext);
+	HTTPRequest request(HTTPRequest::HTTP_GET, "/small");
+	s.sendRequest(request);
+	HTTPResponse response;
+	std::istream& rs = s.receiveResponse(response);
+	std::ostringstream ostr;
+	StreamCopier::copyStream(rs, ostr);
+	assert (ostr.str() == HTTPSTestServer::SMALL_BODY);
+
+	assert (pClientContext->handshakeCount() == 4);
+	assert (pClientContext->resumedHandshakeCount() == 2);
+}
+
+
+void HTTPSClientSessionTest::testSessionTicketKeyRotation()
+{
+	Context::Ptr pServerContext = new Context(
+		Context::SERVER_USE,
+		Application::instance().config().getString("openSSL.server.privateKeyFile"),
+		Application::instance().config().getString("openSSL.server.privateKeyFile"),
+		Application::instance().config().getString("openSSL.server.caConfig"),
+		Context::VERIFY_NONE,
+		9,
+		true,
+		"ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
+	pServerContext->setSessionTicketKeyRotation(1);
+	assert (pServerContext->getSessionTicketKeyRotation() == 1);
+
+	HTTPSTestServer srv(pServerContext);
+
+	Context::Ptr pClientContext = new Context(
+		Context::CLIENT_USE,
+		Application::instance().config().getString("openSSL.client.privateKeyFile"),
+		Application::instance().config().getString("openSSL.client.privateKeyFile"),
+		Application::instance().config().getString("openSSL.client.caConfig"),
+		Context::VERIFY_RELAXED,
+		9,
+		true,
+		"ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
+	pClientContext->enableSessionCache(true);
+
+	for (int i = 0; i < 2; i++)
+	{
+		// the ticket from the first connection has been encrypted with
+		// a key that has been rotated out, but must still be accepted
+		if (i > 0) Thread::sleep(1500);
+
+		HTTPSClientSession s("127.0.0.1", srv.port(), pClientContext);
+		HTTPRequest request(HTTPRequest::HTTP_GET, "/small");
+		s.sendRequest(request);
+		HTTPResponse response;
+		std::istream& rs = s.receiveResponse(response);
+		std::ostringstream ostr;
+		StreamCopier::copyStream(rs, ostr);
+		assert (ostr.str() == HTTPSTestServer::SMALL_BODY);
+	}
+
+	assert (pServerContext->handshakeCount() == 2);
+	assert (pServerContext->resumedHandshakeCount() == 1);
+	assert (pServerContext->resumptionRatio() == 0.5);
+
+	pServerContext->resetHandshakeStatistics();
+	assert (pServerContext->handshakeCount() == 0);
+	assert (pServerContext->resumptionRatio() == 0.0);
+}
+
+
 void HTTPSClientSessionTest::testUnknownContentLength()
 {
 	HTTPSTestServer srv;
@@ -473,6 +587,8 @@ CppUnit::Test* HTTPSClientSessionTest::suite()
 	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testInterop);
 	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testProxy);
 	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testCachedSession);
+	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testAutoCachedSession);
+	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testSessionTicketKeyRotation);
 	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testUnknownContentLength);
 	CppUnit_addTest(pSuite, HTTPSClientSessionTest, testServerAbort);
 
@@ -36,6 +36,8 @@ public:
 	void testInterop();
 	void testProxy();
 	void testCachedSession();
+	void testAutoCachedSession();
+	void testSessionTicketKeyRotation();
 	void testUnknownContentLength();
 	void testServerAbort();
 
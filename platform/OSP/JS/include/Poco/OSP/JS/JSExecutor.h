@@ -70,10 +70,25 @@ public:
 	static Poco::UInt64 getDefaultMemoryLimit();
 		/// Returns the global default memory limit for scripts.
 
+	static void setTimerPool(Poco::JS::Core::TimerPool::Ptr pTimerPool);
+		/// Sets the global TimerPool used by TimedJSExecutor instances
+		/// created afterwards. If null (default), every TimedJSExecutor
+		/// has its own timer thread.
+
+	static Poco::JS::Core::TimerPool::Ptr getTimerPool();
+		/// Returns the global TimerPool, or null if none has been set.
+
 protected:
 	void setupGlobalObjectTemplate(v8::Local<v8::ObjectTemplate>& global, v8::Isolate* pIsolate);
 	void setupGlobalObject(v8::Local<v8::Object>& global, v8::Isolate* pIsolate);
 	void handleError(const ErrorInfo& errorInfo);
+	std::string moduleCacheTag(const Poco::URI& uri);
+
+	static std::string bundleModuleCacheTag(Poco::OSP::BundleContext::Ptr pContext, const Poco::URI& uri);
+		/// Returns the ModuleCache tag for a module loaded from a bundle ("bndl" URI).
+		/// The tag consists of the bundle's version and the modification
+		/// time of the bundle file. Modules from bundle directories are not cached,
+		/// as their contents may change without notice during development.
 
 private:	
 	Poco::OSP::BundleContext::Ptr _pContext;
@@ -82,6 +97,9 @@ private:
 	static std::vector<std::string> _globalModuleSearchPaths;
 	static Poco::JS::Core::ModuleRegistry::Ptr _globalModuleRegistry;
 	static Poco::UInt64 _defaultMemoryLimit;
+	static Poco::JS::Core::TimerPool::Ptr _pTimerPool;
+
+	friend class TimedJSExecutor;
 };
 
 
@@ -92,6 +110,9 @@ class OSPJS_API TimedJSExecutor: public Poco::JS::Core::TimedJSExecutor
 	/// Will stop the executing JavaScript when the containing bundle
 	/// is stopped.
 	///
+	/// If a global TimerPool has been set with JSExecutor::setTimerPool(),
+	/// the executor uses a timer from that pool instead of its own timer.
+	///
 	/// Adds the following global JavaScript objects:
 	///   - bundle (Poco::OSP::Bundle wrapper)
 	///   - properties (bundle properties wrapper)
@@ -119,6 +140,7 @@ protected:
 	void setupGlobalObjectTemplate(v8::Local<v8::ObjectTemplate>& global, v8::Isolate* pIsolate);
 	void setupGlobalObject(v8::Local<v8::Object>& global, v8::Isolate* pIsolate);
 	void handleError(const ErrorInfo& errorInfo);
+	std::string moduleCacheTag(const Poco::URI& uri);
 	void onBundleStopped(const void* pSender, Poco::OSP::BundleEvent& ev);
 
 private:	
@@ -154,6 +176,12 @@ inline Poco::JS::Core::ModuleRegistry::Ptr JSExecutor::getGlobalModuleRegistry()
 }
 
 
+inline Poco::JS::Core::TimerPool::Ptr JSExecutor::getTimerPool()
+{
+	return _pTimerPool;
+}
+
+
 inline Poco::OSP::Bundle::Ptr TimedJSExecutor::bundle() const
 {
 	return _pBundle;
@@ -0,0 +1,96 @@
+//
+// JSProfilerService.h
+//
+// Library: OSP/JS
+// Package: Execution
+// Module:  JSProfilerService
+//
+// Definition of the JSProfilerService class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef OSP_JS_JSProfilerService_INCLUDED
+#define OSP_JS_JSProfilerService_INCLUDED
+
+
+#include "Poco/OSP/JS/JS.h"
+#include "Poco/OSP/ScriptProfilerService.h"
+#include "Poco/JS/Core/CpuProfile.h"
+#include "Poco/Mutex.h"
+#include <vector>
+#include <map>
+
+
+namespace Poco {
+namespace OSP {
+namespace JS {
+
+
+class OSPJS_API JSProfilerService: public Poco::OSP::ScriptProfilerService
+	/// The JSProfilerService implements the ScriptProfilerService
+	/// interface using the V8 CPU profiler.
+	///
+	/// The service name of the JSProfilerService
+	/// is "com.appinf.osp.js.profiler".
+{
+public:
+	typedef Poco::AutoPtr<JSProfilerService> Ptr;
+	typedef Poco::JS::Core::CpuProfile::Ptr ProfilePtr;
+
+	explicit JSProfilerService(int defaultSamplingInterval);
+		/// Creates the JSProfilerService, using the given default
+		/// sampling interval (in microseconds).
+
+	void profiles(const std::string& uri, std::vector<ProfilePtr>& profiles) const;
+		/// Returns the profiles recorded by the last call to
+		/// stop() for the given URI.
+
+	void clear();
+		/// Discards all recorded profiles.
+
+	int defaultSamplingInterval() const;
+		/// Returns the default sampling interval in microseconds.
+
+	static const std::string SERVICE_NAME;
+
+	// ScriptProfilerService
+	std::size_t start(const std::string& uri, int samplingInterval = 0);
+	std::size_t stop(const std::string& uri);
+	std::size_t writeProfiles(const std::string& uri, ProfileFormat format, std::ostream& ostr) const;
+	std::size_t profileCount(const std::string& uri) const;
+
+	// Service
+	const std::type_info& type() const;
+	bool isA(const std::type_info& otherType) const;
+
+protected:
+	~JSProfilerService();
+		/// Destroys the JSProfilerService.
+
+private:
+	typedef std::map<std::string, std::vector<ProfilePtr> > ProfileMap;
+
+	int _defaultSamplingInterval;
+	ProfileMap _profiles;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline int JSProfilerService::defaultSamplingInterval() const
+{
+	return _defaultSamplingInterval;
+}
+
+
+} } } // namespace Poco::OSP::JS
+
+
+#endif // OSP_JS_JSProfilerService_INCLUDED
@@ -0,0 +1,64 @@
+//
+// JSStatisticsService.h
+//
+// Library: OSP/JS
+// Package: Execution
+// Module:  JSStatisticsService
+//
+// Definition of the JSStatisticsService class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef OSP_JS_JSStatisticsService_INCLUDED
+#define OSP_JS_JSStatisticsService_INCLUDED
+
+
+#include "Poco/OSP/JS/JS.h"
+#include "Poco/OSP/ScriptStatisticsService.h"
+
+
+namespace Poco {
+namespace OSP {
+namespace JS {
+
+
+class OSPJS_API JSStatisticsService: public Poco::OSP::ScriptStatisticsService
+	/// The JSStatisticsService implements the ScriptStatisticsService
+	/// interface for all JavaScript executors running in the application.
+	///
+	/// The statistics are collected by the executors themselves
+	/// and are always available.
+	///
+	/// The service name of the JSStatisticsService
+	/// is "com.appinf.osp.js.statistics".
+{
+public:
+	typedef Poco::AutoPtr<JSStatisticsService> Ptr;
+
+	JSStatisticsService();
+		/// Creates the JSStatisticsService.
+
+	static const std::string SERVICE_NAME;
+
+	// ScriptStatisticsService
+	void statistics(std::vector<Statistics>& statistics) const;
+
+	// Service
+	const std::type_info& type() const;
+	bool isA(const std::type_info& otherType) const;
+
+protected:
+	~JSStatisticsService();
+		/// Destroys the JSStatisticsService.
+};
+
+
+} } } // namespace Poco::OSP::JS
+
+
+#endif // OSP_JS_JSStatisticsService_INCLUDED
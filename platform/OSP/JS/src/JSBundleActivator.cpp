@@ -25,6 +25,8 @@
 #include "Poco/OSP/JS/JSExecutor.h"
 #include "Poco/OSP/JS/JSExtensionPoint.h"
 #include "Poco/OSP/JS/ModuleExtensionPoint.h"
+#include "Poco/OSP/JS/JSStatisticsService.h"
+#include "Poco/OSP/JS/JSProfilerService.h"
 #include "v8.h"
 
 
@@ -89,13 +91,33 @@ public:
 		
 		Poco::UInt64 memoryLimit = _pPrefs->configuration()->getUInt64("osp.js.memoryLimit", 1024*1024);
 		JSExecutor::setDefaultMemoryLimit(memoryLimit);
+
+		int eventLoopThreads = _pPrefs->configuration()->getInt("osp.js.eventLoop.threads", 0);
+		if (eventLoopThreads > 0)
+		{
+			int taskBudget = _pPrefs->configuration()->getInt("osp.js.eventLoop.taskBudget", Poco::JS::Core::TimerPool::DEFAULT_TASK_BUDGET);
+			JSExecutor::setTimerPool(new Poco::JS::Core::TimerPool(eventLoopThreads, taskBudget));
+			_pContext->logger().information("Using %d shared event loop threads for scripts.", eventLoopThreads);
+		}
 		
 		std::string v8Version =  v8::V8::GetVersion();
 		_pContext->logger().information("Using V8 version: %s", v8Version);
+
+		JSStatisticsService::Ptr pStatisticsService = new JSStatisticsService;
+		_pStatisticsServiceRef = pContext->registry().registerService(JSStatisticsService::SERVICE_NAME, pStatisticsService, Properties());
+
+		int samplingInterval = _pPrefs->configuration()->getInt("osp.js.profiler.samplingInterval", Poco::JS::Core::JSExecutor::DEFAULT_SAMPLING_INTERVAL);
+		JSProfilerService::Ptr pProfilerService = new JSProfilerService(samplingInterval);
+		_pProfilerServiceRef = pContext->registry().registerService(JSProfilerService::SERVICE_NAME, pProfilerService, Properties());
 	}
 		
 	void stop(BundleContext::Ptr pContext)
 	{
+		pContext->registry().unregisterService(_pProfilerServiceRef);
+		_pProfilerServiceRef = 0;
+		pContext->registry().unregisterService(_pStatisticsServiceRef);
+		_pStatisticsServiceRef = 0;
+
 		_pXPS->unregisterExtensionPoint("com.appinf.osp.js");
 		_pXPS = 0;
 		_pPrefs = 0;
@@ -107,6 +129,8 @@ public:
 		pContext->registry().serviceUnregistered -= Poco::delegate(this, &JSBundleActivator::handleServiceUnregistered);
 
 		_pContext = 0;
+
+		JSExecutor::setTimerPool(0);
 		
 		Poco::JS::Core::uninitialize();
 	}
@@ -145,6 +169,8 @@ private:
 	Poco::OSP::BundleContext::Ptr _pContext;
 	Poco::OSP::ExtensionPointService::Ptr _pXPS;
 	Poco::OSP::PreferencesService::Ptr _pPrefs;
+	Poco::OSP::ServiceRef::Ptr _pStatisticsServiceRef;
+	Poco::OSP::ServiceRef::Ptr _pProfilerServiceRef;
 	std::string _jsBridgeListenerId;
 };
 
@@ -17,6 +17,8 @@
 #include "Poco/OSP/BundleEvents.h"
 #include "Poco/Delegate.h"
 #include "Poco/Format.h"
+#include "Poco/File.h"
+#include "Poco/NumberFormatter.h"
 
 
 namespace Poco {
@@ -27,6 +29,7 @@ namespace JS {
 std::vector<std::string> JSExecutor::_globalModuleSearchPaths;
 Poco::JS::Core::ModuleRegistry::Ptr JSExecutor::_globalModuleRegistry;
 Poco::UInt64 JSExecutor::_defaultMemoryLimit(1024*1024);
+Poco::JS::Core::TimerPool::Ptr JSExecutor::_pTimerPool;
 
 
 JSExecutor::JSExecutor(Poco::OSP::BundleContext::Ptr pContext, Poco::OSP::Bundle::Ptr pBundle, const std::string& source, const Poco::URI& sourceURI, const std::vector<std::string>& moduleSearchPaths, Poco::UInt64 memoryLimit):
@@ -105,6 +108,39 @@ void JSExecutor::handleError(const ErrorInfo& errorInfo)
 }
 
 
+std::string JSExecutor::moduleCacheTag(const Poco::URI& uri)
+{
+	if (uri.getScheme() == "bndl")
+		return bundleModuleCacheTag(_pContext, uri);
+	else
+		return Poco::JS::Core::JSExecutor::moduleCacheTag(uri);
+}
+
+
+std::string JSExecutor::bundleModuleCacheTag(Poco::OSP::BundleContext::Ptr pContext, const Poco::URI& uri)
+{
+	std::string tag;
+	Poco::OSP::Bundle::ConstPtr pBundle = pContext->findBundle(uri.getAuthority());
+	if (pBundle)
+	{
+		try
+		{
+			Poco::File bundleFile(pBundle->path());
+			if (bundleFile.isFile())
+			{
+				tag = pBundle->version().toString();
+				tag += ':';
+				tag += Poco::NumberFormatter::format(bundleFile.getLastModified().epochMicroseconds());
+			}
+		}
+		catch (Poco::Exception&)
+		{
+		}
+	}
+	return tag;
+}
+
+
 void JSExecutor::setGlobalModuleSearchPaths(const std::vector<std::string>& searchPaths)
 {
 	_globalModuleSearchPaths = searchPaths;
@@ -129,8 +165,14 @@ Poco::UInt64 JSExecutor::getDefaultMemoryLimit()
 }
 
 
+void JSExecutor::setTimerPool(Poco::JS::Core::TimerPool::Ptr pTimerPool)
+{
+	_pTimerPool = pTimerPool;
+}
+
+
 TimedJSExecutor::TimedJSExecutor(Poco::OSP::BundleContext::Ptr pContext, Poco::OSP::Bundle::Ptr pBundle, const std::string& source, const Poco::URI& sourceURI, const std::vector<std::string>& moduleSearchPaths, Poco::UInt64 memoryLimit):
-	Poco::JS::Core::TimedJSExecutor(source, sourceURI, moduleSearchPaths, memoryLimit),
+	Poco::JS::Core::TimedJSExecutor(source, sourceURI, moduleSearchPaths, Poco::OSP::JS::JSExecutor::getTimerPool(), memoryLimit),
 	_pContext(pContext),
 	_pBundle(pBundle)
 {
@@ -216,6 +258,15 @@ void TimedJSExecutor::handleError(const ErrorInfo& errorInfo)
 }
 
 
+std::string TimedJSExecutor::moduleCacheTag(const Poco::URI& uri)
+{
+	if (uri.getScheme() == "bndl")
+		return Poco::OSP::JS::JSExecutor::bundleModuleCacheTag(_pContext, uri);
+	else
+		return Poco::JS::Core::TimedJSExecutor::moduleCacheTag(uri);
+}
+
+
 void TimedJSExecutor::onBundleStopped(const void* pSender, Poco::OSP::BundleEvent& ev)
 {
 	if (ev.bundle() == _pBundle)
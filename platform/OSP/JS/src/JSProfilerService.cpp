@@ -0,0 +1,120 @@
+//
+// JSProfilerService.cpp
+//
+// Library: OSP/JS
+// Package: Execution
+// Module:  JSProfilerService
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/OSP/JS/JSProfilerService.h"
+#include "Poco/JS/Core/JSExecutor.h"
+
+
+namespace Poco {
+namespace OSP {
+namespace JS {
+
+
+const std::string JSProfilerService::SERVICE_NAME("com.appinf.osp.js.profiler");
+
+
+JSProfilerService::JSProfilerService(int defaultSamplingInterval):
+	_defaultSamplingInterval(defaultSamplingInterval > 0 ? defaultSamplingInterval : Poco::JS::Core::JSExecutor::DEFAULT_SAMPLING_INTERVAL)
+{
+}
+
+
+JSProfilerService::~JSProfilerService()
+{
+}
+
+
+std::size_t JSProfilerService::start(const std::string& uri, int samplingInterval)
+{
+	return Poco::JS::Core::JSExecutor::startProfiling(uri, samplingInterval > 0 ? samplingInterval : _defaultSamplingInterval);
+}
+
+
+std::size_t JSProfilerService::stop(const std::string& uri)
+{
+	std::vector<ProfilePtr> profiles;
+	Poco::JS::Core::JSExecutor::stopProfiling(uri, profiles);
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_profiles[uri].swap(profiles);
+	return _profiles[uri].size();
+}
+
+
+void JSProfilerService::profiles(const std::string& uri, std::vector<ProfilePtr>& profiles) const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	ProfileMap::const_iterator it = _profiles.find(uri);
+	if (it != _profiles.end())
+		profiles = it->second;
+	else
+		profiles.clear();
+}
+
+
+std::size_t JSProfilerService::writeProfiles(const std::string& uri, ProfileFormat format, std::ostream& ostr) const
+{
+	std::vector<ProfilePtr> uriProfiles;
+	profiles(uri, uriProfiles);
+	if (!uriProfiles.empty())
+	{
+		if (format == FORMAT_COLLAPSED_STACKS)
+		{
+			for (std::vector<ProfilePtr>::const_iterator it = uriProfiles.begin(); it != uriProfiles.end(); ++it)
+			{
+				(*it)->writeCollapsedStacks(ostr);
+			}
+		}
+		else
+		{
+			uriProfiles.front()->writeCpuProfile(ostr);
+		}
+	}
+	return uriProfiles.size();
+}
+
+
+std::size_t JSProfilerService::profileCount(const std::string& uri) const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	ProfileMap::const_iterator it = _profiles.find(uri);
+	return it != _profiles.end() ? it->second.size() : 0;
+}
+
+
+void JSProfilerService::clear()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_profiles.clear();
+}
+
+
+const std::type_info& JSProfilerService::type() const
+{
+	return typeid(JSProfilerService);
+}
+
+
+bool JSProfilerService::isA(const std::type_info& otherType) const
+{
+	std::string name(typeid(JSProfilerService).name());
+	return name == otherType.name() || ScriptProfilerService::isA(otherType);
+}
+
+
+} } } // namespace Poco::OSP::JS
@@ -0,0 +1,80 @@
+//
+// JSStatisticsService.cpp
+//
+// Library: OSP/JS
+// Package: Execution
+// Module:  JSStatisticsService
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/OSP/JS/JSStatisticsService.h"
+#include "Poco/JS/Core/JSExecutor.h"
+
+
+namespace Poco {
+namespace OSP {
+namespace JS {
+
+
+const std::string JSStatisticsService::SERVICE_NAME("com.appinf.osp.js.statistics");
+
+
+JSStatisticsService::JSStatisticsService()
+{
+}
+
+
+JSStatisticsService::~JSStatisticsService()
+{
+}
+
+
+void JSStatisticsService::statistics(std::vector<Statistics>& statistics) const
+{
+	std::vector<Poco::JS::Core::JSExecutor::Statistics> executorStatistics;
+	Poco::JS::Core::JSExecutor::allStatistics(executorStatistics);
+
+	statistics.clear();
+	statistics.reserve(executorStatistics.size());
+	for (std::vector<Poco::JS::Core::JSExecutor::Statistics>::const_iterator it = executorStatistics.begin(); it != executorStatistics.end(); ++it)
+	{
+		Statistics stats;
+		stats.uri            = it->uri;
+		stats.callbacks      = it->callbacks;
+		stats.scriptTime     = it->scriptTime;
+		stats.scriptTimeMax  = it->scriptTimeMax;
+		stats.timerCallbacks = it->timerCallbacks;
+		stats.timerLagTotal  = it->timerLagTotal;
+		stats.timerLagMax    = it->timerLagMax;
+		stats.gcCount        = it->gcCount;
+		stats.gcTime         = it->gcTime;
+		stats.gcTimeMax      = it->gcTimeMax;
+		stats.heapTotal      = it->heapTotal;
+		stats.heapUsed       = it->heapUsed;
+		stats.heapLimit      = it->heapLimit;
+		stats.mallocedMemory = it->mallocedMemory;
+		stats.profiling      = it->profiling;
+		statistics.push_back(stats);
+	}
+}
+
+
+const std::type_info& JSStatisticsService::type() const
+{
+	return typeid(JSStatisticsService);
+}
+
+
+bool JSStatisticsService::isA(const std::type_info& otherType) const
+{
+	std::string name(typeid(JSStatisticsService).name());
+	return name == otherType.name() || ScriptStatisticsService::isA(otherType);
+}
+
+
+} } } // namespace Poco::OSP::JS
@@ -0,0 +1,133 @@
+//
+// PasswordHashUtility.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/OSP/Auth/PasswordHash.h"
+#include "Poco/Exception.h"
+#include <iostream>
+
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::HelpFormatter;
+using Poco::Util::OptionCallback;
+using Poco::Util::IntValidator;
+using Poco::OSP::Auth::PasswordHash;
+
+
+namespace Poco {
+namespace OSP {
+
+
+class PasswordHashUtility: public Application
+{
+public:
+	PasswordHashUtility():
+		_showHelp(false)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<PasswordHashUtility>(this, &PasswordHashUtility::handleHelp)));
+
+		options.addOption(
+			Option("iterations", "i", "Specify the PBKDF2 iteration count (default 10000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(PasswordHash::MIN_ITERATIONS, PasswordHash::MAX_ITERATIONS))
+				.binding("pwhash.iterations"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_showHelp = true;
+		stopOptionsProcessing();
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("[<option>] [<password>]");
+		helpFormatter.setHeader(
+			"\n"
+			"The Applied Informatics OSP Password Hash Utility.\n"
+			"Copyright (c) 2018 by Applied Informatics Software Engineering GmbH.\n"
+			"All rights reserved.\n\n"
+			"This program prints a PBKDF2 password hash "
+			"($pbkdf2-sha1$<iterations>$<salt>$<hash>) for the given password, "
+			"suitable for the auth.simple.<user>.passwordHash setting "
+			"of the SimpleAuthService. If no password is given on the command "
+			"line, it is read from the first line of standard input, which "
+			"keeps it out of the shell history.\n"
+			"The following command line options are supported:"
+		);
+		helpFormatter.setFooter(
+			"For more information, please see the Open Service Platform "
+			"documentation at <http://docs.appinf.com>."
+		);
+		helpFormatter.setIndent(8);
+		helpFormatter.format(std::cout);
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_showHelp || args.size() > 1)
+		{
+			displayHelp();
+			return _showHelp ? Application::EXIT_OK : Application::EXIT_USAGE;
+		}
+
+		std::string password;
+		if (args.empty())
+		{
+			std::getline(std::cin, password);
+			if (!password.empty() && password[password.size() - 1] == '\r')
+				password.resize(password.size() - 1);
+		}
+		else password = args[0];
+
+		try
+		{
+			int iterations = config().getInt("pwhash.iterations", PasswordHash::DEFAULT_ITERATIONS);
+			std::cout << PasswordHash::create(password, iterations) << std::endl;
+		}
+		catch (Poco::Exception& exc)
+		{
+			std::cerr << exc.displayText() << std::endl;
+			return Application::EXIT_SOFTWARE;
+		}
+
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _showHelp;
+};
+
+
+} } // namespace Poco::OSP
+
+
+POCO_APP_MAIN(Poco::OSP::PasswordHashUtility)
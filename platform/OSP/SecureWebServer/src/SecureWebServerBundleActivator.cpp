@@ -19,6 +19,8 @@
 #include "Poco/Net/HTTPServer.h"
 #include "Poco/Net/HTTPServerParams.h"
 #include "Poco/Net/SecureServerSocket.h"
+#include "Poco/Net/SSLManager.h"
+#include "Poco/Net/Context.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/ThreadPool.h"
 #include "Poco/Format.h"
@@ -37,6 +39,8 @@ using Poco::OSP::Web::WebServerService;
 using Poco::Net::HTTPServer;
 using Poco::Net::HTTPServerParams;
 using Poco::Net::SecureServerSocket;
+using Poco::Net::SSLManager;
+using Poco::Net::Context;
 using Poco::AutoPtr;
 using Poco::ThreadPool;
 using Poco::format;
@@ -158,6 +162,7 @@ public:
 			bool defaultKeepAlive     = pContext->thisBundle()->properties().getBool("keepAlive", true);
 			int defaultKeepAliveTime  = pContext->thisBundle()->properties().getInt("keepAliveTime", 10);
 			int defaultMaxKeepAlive   = pContext->thisBundle()->properties().getInt("maxKeepAlive", 10);
+			int defaultTicketKeyRotation = pContext->thisBundle()->properties().getInt("sessionTicketKeyRotation", 0);
 			
 			// get parameters from global configuration file
 			std::string host  = pPrefs->configuration()->getString("osp.web.server.secureHost", defaultHost);
@@ -167,6 +172,7 @@ public:
 			bool keepAlive    = pPrefs->configuration()->getBool("osp.web.server.keepAlive", defaultKeepAlive);
 			int keepAliveTime = pPrefs->configuration()->getInt("osp.web.server.keepAliveTime", defaultKeepAliveTime);
 			int maxKeepAlive  = pPrefs->configuration()->getInt("osp.web.server.maxKeepAlive", defaultMaxKeepAlive);
+			int ticketKeyRotation = pPrefs->configuration()->getInt("osp.web.server.sessionTicketKeyRotation", defaultTicketKeyRotation);
 			
 			if (port != 0)
 			{
@@ -183,8 +189,15 @@ public:
 				
 				pContext->logger().information(format("Starting HTTPS server on port %d.", port));
 				
+				_pSSLContext = SSLManager::instance().defaultServerContext();
+				if (ticketKeyRotation > 0 && _pSSLContext->getSessionTicketKeyRotation() == 0)
+				{
+					// an interval configured for the SSLManager (openSSL.server.sessionTicketKeyRotation) takes precedence
+					_pSSLContext->setSessionTicketKeyRotation(ticketKeyRotation);
+				}
+
 				Poco::Net::SocketAddress addr(host, port); 
-				SecureServerSocket svs(addr);
+				SecureServerSocket svs(addr, 64, _pSSLContext);
 				_pHTTPServer = new HTTPServer(new WebServerRequestHandlerFactory(*pWebServerDispatcher, true), pWebServerDispatcher->threadPool(), svs, pParams);
 				_pHTTPServer->start();
 				
@@ -209,12 +222,17 @@ public:
 			pContext->registry().unregisterService(_pService);
 			_pService = 0;
 			_pHTTPServer->stopAll();
+			pContext->logger().information(format("TLS handshakes: %Lu, resumed: %Lu (%.1f%%).",
+				_pSSLContext->handshakeCount(),
+				_pSSLContext->resumedHandshakeCount(),
+				100*_pSSLContext->resumptionRatio()));
 		}
 	}
 	
 private:
 	HTTPServer* _pHTTPServer;
 	ServiceRef::Ptr _pService;
+	Context::Ptr _pSSLContext;
 };
 
 
@@ -9,6 +9,8 @@
 
 
 #include "Poco/OSP/Auth/AuthService.h"
+#include "Poco/OSP/Auth/PasswordHash.h"
+#include "Poco/OSP/Auth/CredentialCache.h"
 #include "Poco/OSP/BundleActivator.h"
 #include "Poco/OSP/BundleContext.h"
 #include "Poco/OSP/Bundle.h"
@@ -18,6 +20,7 @@
 #include "Poco/StringTokenizer.h"
 #include "Poco/ClassLibrary.h"
 #include "Poco/MD5Engine.h"
+#include "Poco/SharedPtr.h"
 #include <set>
 
 
@@ -28,6 +31,8 @@ using Poco::OSP::Properties;
 using Poco::OSP::Service;
 using Poco::OSP::ServiceRef;
 using Poco::OSP::PreferencesService;
+using Poco::OSP::Auth::PasswordHash;
+using Poco::OSP::Auth::CredentialCache;
 using Poco::AutoPtr;
 using Poco::StringTokenizer;
 
@@ -42,10 +47,22 @@ class SimpleAuthService: public Poco::OSP::Auth::AuthService
 	/// "admin" and "user", respectively.
 	///
 	/// The password for "admin" and "user" can be set in the global 
-	/// application configuration file as salted MD5 hashes with the
-	/// "auth.simple.admin.passwordHash" and "auth.simple.user.passwordHash" 
-	/// properties. The (optional) salt can be specified with
-	/// the "auth.simple.salt" property.
+	/// application configuration file with the "auth.simple.admin.passwordHash"
+	/// and "auth.simple.user.passwordHash" properties. The password hash
+	/// should be a PBKDF2 hash created with Poco::OSP::Auth::PasswordHash,
+	/// in the form "$pbkdf2-sha1$<iterations>$<salt>$<hash>".
+	/// Such a hash can be printed with the pwhash utility
+	/// (platform/OSP/PasswordHashUtility), which reads the
+	/// password from standard input.
+	/// For compatibility, salted MD5 hashes are still accepted. The (optional)
+	/// salt for MD5 hashes can be specified with the "auth.simple.salt" property.
+	///
+	/// As verifying a PBKDF2 hash is deliberately expensive, successfully
+	/// verified credentials are kept in a Poco::OSP::Auth::CredentialCache.
+	/// The maximum number of cached credentials and the time after which
+	/// cached credentials must be verified again can be set with the
+	/// "auth.simple.cache.size" (default 64, 0 disables the cache) and
+	/// "auth.simple.cache.expire" (seconds, default 300) properties.
 	/// 
 	/// The "admin" user has all permissions. The set of permissions
 	/// for "user" can be set in the global configuration file,
@@ -53,7 +70,7 @@ class SimpleAuthService: public Poco::OSP::Auth::AuthService
 	/// specified as a comma-separated list.
 {
 public:
-	SimpleAuthService(const std::string& adminName, const std::string& adminPasswordHash, const std::string& userName, const std::string& userPasswordHash, const std::set<std::string>& userPermissions, const std::string& salt):
+	SimpleAuthService(const std::string& adminName, const std::string& adminPasswordHash, const std::string& userName, const std::string& userPasswordHash, const std::set<std::string>& userPermissions, const std::string& salt, int cacheSize, int cacheExpire):
 		_adminName(adminName),
 		_adminPasswordHash(adminPasswordHash),
 		_userName(userName),
@@ -61,6 +78,10 @@ public:
 		_userPermissions(userPermissions),
 		_salt(salt)
 	{
+		if (cacheSize > 0)
+		{
+			_pCache = new CredentialCache(cacheSize, cacheExpire);
+		}
 	}
 	
 	~SimpleAuthService()
@@ -70,8 +91,19 @@ public:
 	// AuthService
 	bool authenticate(const std::string& userName, const std::string& credentials) const
 	{
-		return (userName == _userName && hashCredentials(credentials) == _userPasswordHash)
-		    || (userName == _adminName && hashCredentials(credentials) == _adminPasswordHash);
+		const std::string* pPasswordHash = 0;
+		if (userName == _adminName)
+			pPasswordHash = &_adminPasswordHash;
+		else if (userName == _userName)
+			pPasswordHash = &_userPasswordHash;
+		else
+			return false;
+
+		if (_pCache && _pCache->verified(userName, credentials)) return true;
+
+		bool authenticated = verifyCredentials(credentials, *pPasswordHash);
+		if (authenticated && _pCache) _pCache->add(userName, credentials);
+		return authenticated;
 	}
 
 	bool authorize(const std::string& userName, const std::string& permission) const
@@ -92,6 +124,16 @@ public:
 	}
 	
 protected:
+	bool verifyCredentials(const std::string& credentials, const std::string& passwordHash) const
+	{
+		if (passwordHash.empty())
+			return false;
+		else if (PasswordHash::isPasswordHash(passwordHash))
+			return PasswordHash::verify(credentials, passwordHash);
+		else
+			return PasswordHash::equals(hashCredentials(credentials), passwordHash);
+	}
+
 	std::string hashCredentials(const std::string& credentials) const
 	{
 		Poco::MD5Engine md5;
@@ -107,6 +149,7 @@ private:
 	std::string _userPasswordHash;
 	std::set<std::string> _userPermissions;
 	std::string _salt;
+	mutable Poco::SharedPtr<CredentialCache> _pCache;
 };
 
 
@@ -134,6 +177,8 @@ public:
 		std::string userPasswordHash = pPrefs->configuration()->getString("auth.simple.user.passwordHash", "");
 		std::string salt = pPrefs->configuration()->getString("auth.simple.salt", "");
 		std::string perms = pPrefs->configuration()->getString("auth.simple.user.permissions", "");
+		int cacheSize = pPrefs->configuration()->getInt("auth.simple.cache.size", CredentialCache::DEFAULT_SIZE);
+		int cacheExpire = pPrefs->configuration()->getInt("auth.simple.cache.expire", CredentialCache::DEFAULT_EXPIRE);
 		StringTokenizer tok(perms, ",;", StringTokenizer::TOK_TRIM | StringTokenizer::TOK_IGNORE_EMPTY);
 		std::set<std::string> userPermissions;
 		for (StringTokenizer::Iterator it = tok.begin(); it != tok.end(); ++it)
@@ -141,7 +186,10 @@ public:
 			userPermissions.insert(*it);
 		}
 		
-		AutoPtr<SimpleAuthService> pService = new SimpleAuthService(adminName, adminPasswordHash, userName, userPasswordHash, userPermissions, salt);
+		checkPasswordHash(pContext, "auth.simple.admin.passwordHash", adminPasswordHash);
+		checkPasswordHash(pContext, "auth.simple.user.passwordHash", userPasswordHash);
+
+		AutoPtr<SimpleAuthService> pService = new SimpleAuthService(adminName, adminPasswordHash, userName, userPasswordHash, userPermissions, salt, cacheSize, cacheExpire);
 		_pService = pContext->registry().registerService("osp.auth", pService, Properties());
 	}
 		
@@ -150,6 +198,15 @@ public:
 		pContext->registry().unregisterService(_pService);
 	}
 	
+protected:
+	void checkPasswordHash(BundleContext::Ptr pContext, const std::string& property, const std::string& passwordHash)
+	{
+		if (!passwordHash.empty() && !PasswordHash::isPasswordHash(passwordHash))
+		{
+			pContext->logger().warning(property + " is not a PBKDF2 password hash. Salted MD5 password hashes are insecure and should be replaced.");
+		}
+	}
+
 private:
 	ServiceRef::Ptr _pService;
 };
@@ -69,6 +69,10 @@ public:
 	WebSession(const std::string& id, int timeoutSeconds, const Poco::Net::IPAddress& clientAddress, BundleContext::Ptr pContext);
 		/// Creates a new WebSession with the given ID and time out.
 
+	WebSession(const std::string& id, int timeoutSeconds, const Poco::Timestamp& created, const Poco::Timestamp& expiration, const Poco::Net::IPAddress& clientAddress, BundleContext::Ptr pContext);
+		/// Creates a WebSession with the given ID, time out, creation and
+		/// expiration time. Used for restoring a previously saved session.
+
 	virtual ~WebSession();
 		/// Fires a sessionEnds event and destroys the WebSession.
 
@@ -140,12 +144,18 @@ public:
 		
 	void clear();
 		/// Erases all attributes.	
+
+	Attributes attributes() const;
+		/// Returns a copy of all attributes.
 		
 	int timeout() const;
 		/// Returns the timeout of the session in seconds.
 		
 	const Poco::Net::IPAddress& clientAddress() const;
 		/// Returns the IP address of the client holding the session.
+
+	BundleContext::Ptr context() const;
+		/// Returns the BundleContext of the bundle that created the session.
 		
 	// UniqueExpireCache support
 	const Poco::Timestamp& getExpiration() const;
@@ -209,6 +219,12 @@ inline const Poco::Net::IPAddress& WebSession::clientAddress() const
 }
 
 
+inline BundleContext::Ptr WebSession::context() const
+{
+	return _pContext;
+}
+
+
 inline const Poco::Timestamp& WebSession::getExpiration() const
 {
 	return _expiration;
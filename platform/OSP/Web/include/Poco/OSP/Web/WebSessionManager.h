@@ -21,9 +21,16 @@
 #include "Poco/OSP/Web/Web.h"
 #include "Poco/OSP/Web/WebSession.h"
 #include "Poco/OSP/Web/WebSessionService.h"
+#include "Poco/OSP/SystemEvents.h"
 #include "Poco/Net/HTTPServerRequest.h"
-#include "Poco/UniqueExpireCache.h"
+#include "Poco/Timer.h"
+#include "Poco/Timestamp.h"
+#include "Poco/AtomicCounter.h"
 #include "Poco/Mutex.h"
+#include <vector>
+#include <map>
+#include <istream>
+#include <ostream>
 
 
 namespace Poco {
@@ -46,6 +53,24 @@ class OSPWeb_API WebSessionManager: public WebSessionService<Poco::Net::HTTPServ
 	/// will send the session cookie to all hosts with names in the appinf.com
 	/// domain. If a domain is not given, the session cookie will only be available
 	/// to the host that has originally set it.
+	///
+	/// Sessions are kept in a number of shards, selected by a hash of
+	/// the session ID. Every shard has its own lock, so concurrent
+	/// requests for different sessions rarely contend for the same lock.
+	///
+	/// Expired sessions are removed by a background timer, using a
+	/// timer wheel with one slot per second. A session is placed in
+	/// the slot for its expiration time. When a slot is due, sessions
+	/// that have been accessed in the meantime are moved to the slot
+	/// for their new expiration time, all others are removed. Accessing
+	/// a session therefore does not require the timer wheel to be updated.
+	/// An expired session is also never returned by find(), even if
+	/// it has not been removed yet.
+	///
+	/// Sessions can be saved to a stream with saveSessions() and
+	/// restored with loadSessions(), so that users do not have to log
+	/// in again after a restart. With enablePersistence(), this is
+	/// done automatically using a file.
 {
 public:
 	typedef Poco::AutoPtr<WebSessionManager> Ptr;
@@ -56,6 +81,14 @@ public:
 		COOKIE_PERSISTENT = 2  /// Session cookies are persistent (kept in browser until they expire).
 	};
 
+	enum
+	{
+		SHARD_COUNT = 16,
+			/// Number of shards sessions are distributed over.
+		WHEEL_SLOTS = 256
+			/// Number of one-second slots in the expiration timer wheel.
+	};
+
 	WebSessionManager();
 		/// Creates the SessionManager.
 
@@ -82,6 +115,61 @@ public:
 	CookiePersistence getCookiePersistence() const;
 		/// Returns the cookie persistence.
 
+	std::size_t sessionCount() const;
+		/// Returns the number of sessions currently managed,
+		/// including expired sessions that have not been removed yet.
+
+	void expireSessions();
+		/// Removes all sessions whose timer wheel slots are due.
+		///
+		/// Called every second by the session manager's timer.
+
+	int saveSessions(std::ostream& ostr) const;
+		/// Writes all sessions that have not expired to the given stream
+		/// and returns the number of sessions written.
+		///
+		/// For every session, the ID, time out, creation and expiration time,
+		/// client address and the symbolic name of the bundle that created
+		/// the session are written, together with all attributes having a
+		/// std::string, int, bool or double value. Other attributes are
+		/// not saved.
+		///
+		/// Note that the saved data includes the session IDs, which
+		/// give access to the sessions, and must be protected accordingly.
+
+	int loadSessions(std::istream& istr, BundleContext::Ptr pContext);
+		/// Restores the sessions previously saved with saveSessions().
+		///
+		/// The given BundleContext is used to find the bundles that
+		/// created the sessions. Sessions that have expired in the meantime,
+		/// or whose bundle is no longer available, are not restored.
+		///
+		/// Returns the number of restored sessions.
+		/// Throws a Poco::DataFormatException if the stream does
+		/// not contain saved sessions.
+
+	int enablePersistence(const std::string& path, BundleContext::Ptr pContext);
+		/// Restores the sessions saved in the file with the given path,
+		/// if it exists, and removes the file. Then arranges for all sessions
+		/// to be saved to the file when the OSP framework shuts down.
+		///
+		/// Sessions are saved when SystemEvents::systemShuttingDown is
+		/// fired, before any bundle is stopped. Bundles using sessions
+		/// depend on the Web bundle and are stopped before it, which clears
+		/// the attributes (including the login) of their sessions, so
+		/// saving the sessions when the Web bundle is stopped would be
+		/// useless. For the same reason, sessions are not saved if only
+		/// the Web bundle is stopped.
+		///
+		/// The file is only readable by its owner (on POSIX platforms)
+		/// and replaced atomically. Errors are logged with the logger of
+		/// the given BundleContext.
+		///
+		/// Returns the number of restored sessions.
+
+	void disablePersistence();
+		/// Stops saving sessions when the OSP framework shuts down.
+
 	// WebSessionService
 	WebSession::Ptr find(const std::string& appName, const Poco::Net::HTTPServerRequest& request);
 	WebSession::Ptr get(const std::string& appName, const Poco::Net::HTTPServerRequest& request, int expireSeconds, BundleContext::Ptr pContext);
@@ -95,6 +183,40 @@ public:
 	static const std::string SERVICE_NAME;
 
 protected:
+	typedef std::map<std::string, WebSession::Ptr> SessionMap;
+	typedef std::vector<std::string> Slot;
+
+	struct Shard
+	{
+		Shard();
+
+		mutable Poco::FastMutex mutex;
+		SessionMap sessions;
+		std::vector<Slot> wheel;
+	};
+
+	Shard& shardFor(const std::string& id);
+		/// Returns the shard for the session with the given ID.
+
+	void add(WebSession::Ptr pSession);
+		/// Adds the given session to its shard and schedules its expiration.
+
+	static void schedule(Shard& shard, const WebSession& session);
+		/// Places the session in the timer wheel slot for its expiration time.
+		/// The shard must be locked.
+
+	void onTimer(Poco::Timer& timer);
+	void onSystemShuttingDown(const void* pSender, SystemEvents::EventKind& kind);
+
+	void saveSessionsFile(const std::string& path);
+		/// Saves all sessions to the file with the given path, which is
+		/// replaced atomically.
+
+	static void createPrivateFile(const std::string& path);
+		/// Creates an empty file with the given path that can only
+		/// be read and written by the owner (on POSIX platforms).
+		/// An existing file with the same path is replaced.
+
 	std::string getId(const std::string& appName, const Poco::Net::HTTPServerRequest& request);
 	void addCookie(const std::string& appName, const Poco::Net::HTTPServerRequest& request, WebSession::Ptr ptrSes);
 	std::string createSessionId(const Poco::Net::HTTPServerRequest& request);
@@ -105,12 +227,17 @@ protected:
 private:
 	static const std::string COOKIE_NAME;
 
-	Poco::FastMutex _mutex;
-	Poco::UInt32 _serial;
-	Poco::UniqueExpireCache<std::string, WebSession> _cache;
+	Shard _shards[SHARD_COUNT];
+	Poco::AtomicCounter _serial;
+	Poco::Timestamp::TimeVal _lastExpireSlot;
+	Poco::FastMutex _expireMutex;
+	Poco::Timer _timer;
 	std::string _defaultDomain;
 	std::string _defaultPath;
 	CookiePersistence _cookiePersistence;
+	std::string _persistencePath;
+	BundleContext::Ptr _pPersistenceContext;
+	Poco::FastMutex _persistenceMutex;
 };
 
 
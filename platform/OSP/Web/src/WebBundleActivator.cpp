@@ -22,6 +22,7 @@
 #include "Poco/StringTokenizer.h"
 #include "Poco/Format.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/Path.h"
 #include "Poco/ClassLibrary.h"
 #include <memory>
 #include <istream>
@@ -78,6 +79,7 @@ public:
 		bool compressResponse(pContext->thisBundle()->properties().getBool("compressResponses", false));
 		std::string compressedMediaTypesString(pContext->thisBundle()->properties().getString("compressedMediaTypes", ""));
 		std::string sessionCookiePersistence(pContext->thisBundle()->properties().getString("cookiePersistence", "persistent"));
+		bool persistSessions(pContext->thisBundle()->properties().getBool("persistSessions", false));
 		if (pPrefsSvcRef)
 		{
 			Poco::AutoPtr<PreferencesService> pPrefsSvc = pPrefsSvcRef->castedInstance<PreferencesService>();
@@ -86,6 +88,7 @@ public:
 			compressResponse = pPrefsSvc->configuration()->getBool("osp.web.compressResponses", compressResponse);
 			compressedMediaTypesString = pPrefsSvc->configuration()->getString("osp.web.compressedMediaTypes", compressedMediaTypesString);
 			sessionCookiePersistence = pPrefsSvc->configuration()->getString("osp.web.sessionManager.cookiePersistence", sessionCookiePersistence);
+			persistSessions = pPrefsSvc->configuration()->getBool("osp.web.sessionManager.persistSessions", persistSessions);
 		}
 
 		Poco::StringTokenizer tok(compressedMediaTypesString, ",", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
@@ -102,6 +105,12 @@ public:
 		
 		AutoPtr<WebSessionManager> pWebSessionManager = new WebSessionManager;
 		pWebSessionManager->setCookiePersistence(cookiePersistence);
+		if (persistSessions)
+		{
+			Poco::Path sessionsPath(pContext->persistentDirectory(), "sessions.dat");
+			pWebSessionManager->enablePersistence(sessionsPath.toString(), pContext);
+			_pWebSessionManager = pWebSessionManager;
+		}
 		_pWebSessionManagerSvc = pContext->registry().registerService(WebSessionManager::SERVICE_NAME, pWebSessionManager, Properties());
 
 		ServiceRef::Ptr pXPSRef = pContext->registry().findByName("osp.core.xp");
@@ -122,6 +131,13 @@ public:
 		
 	void stop(BundleContext::Ptr pContext)
 	{
+		if (_pWebSessionManager)
+		{
+			// Sessions have already been saved when the framework
+			// started shutting down, if it did.
+			_pWebSessionManager->disablePersistence();
+			_pWebSessionManager = 0;
+		}
 		pContext->registry().unregisterService(_pWebSessionManagerSvc);
 		pContext->registry().unregisterService(_pWebServerDispatcherSvc);
 		pContext->registry().unregisterService(_pMediaTypeMapperSvc);
@@ -138,6 +154,7 @@ private:
 	ServiceRef::Ptr _pWebSessionManagerSvc;
 	AutoPtr<WebServerExtensionPoint> _pWebServerExtensionPoint;
 	AutoPtr<WebFilterExtensionPoint> _pWebFilterExtensionPoint;
+	WebSessionManager::Ptr _pWebSessionManager;
 };
 
 
@@ -41,6 +41,18 @@ WebSession::WebSession(const std::string& id, int timeoutSeconds, const Poco::Ne
 }
 
 
+WebSession::WebSession(const std::string& id, int timeoutSeconds, const Poco::Timestamp& created, const Poco::Timestamp& expiration, const Poco::Net::IPAddress& clientAddress, BundleContext::Ptr pContext):
+	_id(id),
+	_timeout(timeoutSeconds, 0),
+	_pContext(pContext),
+	_created(created),
+	_expiration(expiration),
+	_clientAddress(clientAddress)
+{
+	_pContext->events().bundleStopping += Delegate<WebSession, BundleEvent>(this, &WebSession::onBundleStopping);
+}
+
+
 WebSession::~WebSession()
 {
 	try
@@ -101,6 +113,14 @@ void WebSession::clear()
 }
 
 
+WebSession::Attributes WebSession::attributes() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _attrs;
+}
+
+
 void WebSession::access()
 {
 	_expiration.update();
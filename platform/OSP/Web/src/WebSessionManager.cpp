@@ -16,16 +16,35 @@
 #include "Poco/Net/HTTPServerRequest.h"
 #include "Poco/Net/HTTPServerResponse.h"
 #include "Poco/Net/NameValueCollection.h"
+#include "Poco/OSP/Bundle.h"
 #include "Poco/StringTokenizer.h"
 #include "Poco/NumberParser.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/SHA1Engine.h"
 #include "Poco/RandomStream.h"
+#include "Poco/BinaryReader.h"
+#include "Poco/BinaryWriter.h"
+#include "Poco/Hash.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Delegate.h"
+#include "Poco/FileStream.h"
+#include "Poco/File.h"
+#include "Poco/Format.h"
+#include "Poco/Error.h"
+#include "Poco/Exception.h"
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 
 using Poco::Net::NameValueCollection;
 using Poco::FastMutex;
 using Poco::NumberFormatter;
+using Poco::BinaryReader;
+using Poco::BinaryWriter;
 
 
 namespace Poco {
@@ -37,15 +56,52 @@ const std::string WebSessionManager::COOKIE_NAME("osp.web.session");
 const std::string WebSessionManager::SERVICE_NAME("osp.web.session");
 
 
+namespace
+{
+	const Poco::UInt32 SESSIONS_MAGIC   = 0x4F575353; // "OWSS"
+	const Poco::UInt32 SESSIONS_VERSION = 1;
+
+	enum AttributeType
+	{
+		ATTR_STRING = 1,
+		ATTR_INT    = 2,
+		ATTR_BOOL   = 3,
+		ATTR_DOUBLE = 4
+	};
+
+	Poco::Timestamp::TimeVal slotTime(const Poco::Timestamp& ts)
+	{
+		return ts.epochMicroseconds()/Poco::Timestamp::resolution();
+	}
+}
+
+
+WebSessionManager::Shard::Shard():
+	wheel(WHEEL_SLOTS)
+{
+}
+
+
 WebSessionManager::WebSessionManager():
-	_serial(0),
+	_lastExpireSlot(slotTime(Poco::Timestamp())),
+	_timer(1000, 1000),
 	_cookiePersistence(COOKIE_PERSISTENT)
 {
+	_timer.start(Poco::TimerCallback<WebSessionManager>(*this, &WebSessionManager::onTimer));
 }
 
 
 WebSessionManager::~WebSessionManager()
 {
+	try
+	{
+		disablePersistence();
+		_timer.stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
 }
 
 
@@ -100,24 +156,40 @@ bool WebSessionManager::isA(const std::type_info& otherType) const
 
 WebSession::Ptr WebSessionManager::find(const std::string& appName, const Poco::Net::HTTPServerRequest& request)
 {
-	FastMutex::ScopedLock lock(_mutex);
-	
-	WebSession::Ptr pSession(_cache.get(getId(appName, request)));
-	if (pSession)
+	std::string id(getId(appName, request));
+	if (id.empty()) return 0;
+
+	WebSession::Ptr pSession;
+	WebSession::Ptr pRemoved; // destroyed after the shard lock has been released
+	Shard& shard = shardFor(id);
 	{
-		if (pSession->clientAddress() == request.clientAddress().host())
-		{
-			pSession->access();
-			_cache.add(pSession->id(), pSession);
-			addCookie(appName, request, pSession);
-		}
-		else 
+		FastMutex::ScopedLock lock(shard.mutex);
+
+		SessionMap::iterator it = shard.sessions.find(id);
+		if (it != shard.sessions.end())
 		{
-			// possible attack: same session ID from different host - invalidate session
-			_cache.remove(pSession->id());
-			return 0;
+			if (it->second->getExpiration() <= Poco::Timestamp())
+			{
+				pRemoved = it->second;
+				shard.sessions.erase(it);
+			}
+			else if (it->second->clientAddress() == request.clientAddress().host())
+			{
+				pSession = it->second;
+				pSession->access();
+			}
+			else
+			{
+				// possible attack: same session ID from different host - invalidate session
+				pRemoved = it->second;
+				shard.sessions.erase(it);
+			}
 		}
 	}
+	if (pSession)
+	{
+		addCookie(appName, request, pSession);
+	}
 	return pSession;
 }
 
@@ -133,19 +205,390 @@ WebSession::Ptr WebSessionManager::get(const std::string& appName, const Poco::N
 
 WebSession::Ptr WebSessionManager::create(const std::string& appName, const Poco::Net::HTTPServerRequest& request, int expireSeconds, BundleContext::Ptr pContext)
 {
-	FastMutex::ScopedLock lock(_mutex);
 	WebSession::Ptr pSession(new WebSession(createSessionId(request), expireSeconds, request.clientAddress().host(), pContext));
-	_cache.add(pSession->id(), pSession);
-	addCookie(appName, request, pSession);
 	pSession->setValue(WebSession::CSRF_TOKEN, createSessionId(request));
+	add(pSession);
+	addCookie(appName, request, pSession);
 	return pSession;
 }
 
 
 void WebSessionManager::remove(WebSession::Ptr pSession)
 {
-	FastMutex::ScopedLock lock(_mutex);
-	_cache.remove(pSession->id());
+	WebSession::Ptr pRemoved; // destroyed after the shard lock has been released
+	Shard& shard = shardFor(pSession->id());
+	{
+		FastMutex::ScopedLock lock(shard.mutex);
+
+		SessionMap::iterator it = shard.sessions.find(pSession->id());
+		if (it != shard.sessions.end())
+		{
+			pRemoved = it->second;
+			shard.sessions.erase(it);
+		}
+	}
+}
+
+
+std::size_t WebSessionManager::sessionCount() const
+{
+	std::size_t count = 0;
+	for (int i = 0; i < SHARD_COUNT; i++)
+	{
+		FastMutex::ScopedLock lock(_shards[i].mutex);
+
+		count += _shards[i].sessions.size();
+	}
+	return count;
+}
+
+
+void WebSessionManager::expireSessions()
+{
+	FastMutex::ScopedLock expireLock(_expireMutex);
+
+	Poco::Timestamp now;
+	Poco::Timestamp::TimeVal nowSlot = slotTime(now);
+	Poco::Timestamp::TimeVal firstSlot = _lastExpireSlot + 1;
+	if (nowSlot - firstSlot >= WHEEL_SLOTS) firstSlot = nowSlot - WHEEL_SLOTS + 1;
+
+	std::vector<WebSession::Ptr> expired;
+	for (int i = 0; i < SHARD_COUNT; i++)
+	{
+		Shard& shard = _shards[i];
+		FastMutex::ScopedLock lock(shard.mutex);
+
+		for (Poco::Timestamp::TimeVal t = firstSlot; t <= nowSlot; t++)
+		{
+			Slot due;
+			due.swap(shard.wheel[static_cast<std::size_t>(t % WHEEL_SLOTS)]);
+			for (Slot::const_iterator itId = due.begin(); itId != due.end(); ++itId)
+			{
+				SessionMap::iterator it = shard.sessions.find(*itId);
+				if (it == shard.sessions.end()) continue;
+
+				if (it->second->getExpiration() <= now)
+				{
+					expired.push_back(it->second);
+					shard.sessions.erase(it);
+				}
+				else
+				{
+					schedule(shard, *it->second);
+				}
+			}
+		}
+	}
+	if (nowSlot > _lastExpireSlot) _lastExpireSlot = nowSlot;
+
+	// expired sessions are destroyed here, outside of the shard locks,
+	// as their destructors fire the sessionEnds event
+}
+
+
+int WebSessionManager::saveSessions(std::ostream& ostr) const
+{
+	typedef std::vector<std::pair<WebSession::Ptr, Poco::Timestamp> > Sessions;
+	Sessions sessions;
+	for (int i = 0; i < SHARD_COUNT; i++)
+	{
+		FastMutex::ScopedLock lock(_shards[i].mutex);
+
+		for (SessionMap::const_iterator it = _shards[i].sessions.begin(); it != _shards[i].sessions.end(); ++it)
+		{
+			sessions.push_back(Sessions::value_type(it->second, it->second->getExpiration()));
+		}
+	}
+
+	Poco::Timestamp now;
+	int count = 0;
+	BinaryWriter writer(ostr, BinaryWriter::NETWORK_BYTE_ORDER);
+	writer << SESSIONS_MAGIC << SESSIONS_VERSION;
+	for (Sessions::const_iterator it = sessions.begin(); it != sessions.end(); ++it)
+	{
+		const WebSession& session = *it->first;
+		const Poco::Timestamp& expiration = it->second;
+		if (expiration <= now) continue;
+
+		writer << true;
+		writer << session.id() << session.context()->thisBundle()->symbolicName();
+		writer << static_cast<Poco::Int32>(session.timeout());
+		writer << session.created().epochMicroseconds() << expiration.epochMicroseconds();
+		writer << session.clientAddress().toString();
+
+		WebSession::Attributes attrs = session.attributes();
+		for (WebSession::Attributes::const_iterator itAttr = attrs.begin(); itAttr != attrs.end(); ++itAttr)
+		{
+			const std::type_info& type = itAttr->second.type();
+			if (type == typeid(std::string))
+			{
+				writer << static_cast<Poco::UInt8>(ATTR_STRING) << itAttr->first << Poco::AnyCast<std::string>(itAttr->second);
+			}
+			else if (type == typeid(int))
+			{
+				writer << static_cast<Poco::UInt8>(ATTR_INT) << itAttr->first << static_cast<Poco::Int32>(Poco::AnyCast<int>(itAttr->second));
+			}
+			else if (type == typeid(bool))
+			{
+				writer << static_cast<Poco::UInt8>(ATTR_BOOL) << itAttr->first << Poco::AnyCast<bool>(itAttr->second);
+			}
+			else if (type == typeid(double))
+			{
+				writer << static_cast<Poco::UInt8>(ATTR_DOUBLE) << itAttr->first << Poco::AnyCast<double>(itAttr->second);
+			}
+		}
+		writer << static_cast<Poco::UInt8>(0);
+		count++;
+	}
+	writer << false;
+	writer.flush();
+	return count;
+}
+
+
+int WebSessionManager::loadSessions(std::istream& istr, BundleContext::Ptr pContext)
+{
+	BinaryReader reader(istr, BinaryReader::NETWORK_BYTE_ORDER);
+	Poco::UInt32 magic = 0;
+	Poco::UInt32 version = 0;
+	reader >> magic >> version;
+	if (!reader.good() || magic != SESSIONS_MAGIC || version != SESSIONS_VERSION)
+		throw Poco::DataFormatException("No saved sessions found");
+
+	Poco::Timestamp now;
+	int count = 0;
+	bool more = false;
+	reader >> more;
+	while (more && reader.good())
+	{
+		std::string id;
+		std::string bundleName;
+		Poco::Int32 timeout;
+		Poco::Timestamp::TimeVal created;
+		Poco::Timestamp::TimeVal expiration;
+		std::string clientAddress;
+		reader >> id >> bundleName >> timeout >> created >> expiration >> clientAddress;
+
+		WebSession::Attributes attrs;
+		Poco::UInt8 type = 0;
+		reader >> type;
+		while (type != 0 && reader.good())
+		{
+			std::string name;
+			reader >> name;
+			switch (type)
+			{
+			case ATTR_STRING:
+				{
+					std::string value;
+					reader >> value;
+					attrs[name] = value;
+				}
+				break;
+			case ATTR_INT:
+				{
+					Poco::Int32 value;
+					reader >> value;
+					attrs[name] = static_cast<int>(value);
+				}
+				break;
+			case ATTR_BOOL:
+				{
+					bool value;
+					reader >> value;
+					attrs[name] = value;
+				}
+				break;
+			case ATTR_DOUBLE:
+				{
+					double value;
+					reader >> value;
+					attrs[name] = value;
+				}
+				break;
+			default:
+				throw Poco::DataFormatException("Invalid session attribute type");
+			}
+			reader >> type;
+		}
+		reader >> more;
+		if (!reader.good()) throw Poco::DataFormatException("Truncated session data");
+
+		if (Poco::Timestamp(expiration) <= now) continue;
+
+		Bundle::ConstPtr pBundle = pContext->findBundle(bundleName);
+		if (!pBundle) continue;
+
+		WebSession::Ptr pSession(new WebSession(id, timeout, Poco::Timestamp(created), Poco::Timestamp(expiration), Poco::Net::IPAddress(clientAddress), pContext->contextForBundle(pBundle)));
+		for (WebSession::Attributes::const_iterator it = attrs.begin(); it != attrs.end(); ++it)
+		{
+			pSession->set(it->first, it->second);
+		}
+		add(pSession);
+		count++;
+	}
+	return count;
+}
+
+
+int WebSessionManager::enablePersistence(const std::string& path, BundleContext::Ptr pContext)
+{
+	disablePersistence();
+
+	int count = 0;
+	Poco::File sessionsFile(path);
+	if (sessionsFile.exists())
+	{
+		try
+		{
+			Poco::FileInputStream istr(path);
+			count = loadSessions(istr, pContext);
+			pContext->logger().information(Poco::format("Restored %d session(s).", count));
+		}
+		catch (Poco::Exception& exc)
+		{
+			pContext->logger().warning("Cannot restore sessions: " + exc.displayText());
+		}
+
+		// Sessions are only restored once. This makes sure that
+		// sessions ended in the meantime (e.g., by a logout) are
+		// not restored after a crash.
+		try
+		{
+			sessionsFile.remove();
+		}
+		catch (Poco::Exception& exc)
+		{
+			pContext->logger().warning("Cannot remove saved sessions: " + exc.displayText());
+		}
+	}
+
+	FastMutex::ScopedLock lock(_persistenceMutex);
+
+	_persistencePath = path;
+	_pPersistenceContext = pContext;
+	_pPersistenceContext->systemEvents().systemShuttingDown += Poco::delegate(this, &WebSessionManager::onSystemShuttingDown);
+	return count;
+}
+
+
+void WebSessionManager::disablePersistence()
+{
+	FastMutex::ScopedLock lock(_persistenceMutex);
+
+	if (_pPersistenceContext)
+	{
+		_pPersistenceContext->systemEvents().systemShuttingDown -= Poco::delegate(this, &WebSessionManager::onSystemShuttingDown);
+		_pPersistenceContext = 0;
+		_persistencePath.clear();
+	}
+}
+
+
+void WebSessionManager::onSystemShuttingDown(const void* pSender, SystemEvents::EventKind& kind)
+{
+	FastMutex::ScopedLock lock(_persistenceMutex);
+
+	if (_pPersistenceContext)
+	{
+		saveSessionsFile(_persistencePath);
+	}
+}
+
+
+void WebSessionManager::saveSessionsFile(const std::string& path)
+{
+	// The saved sessions allow anyone who can read them to take
+	// over a session. They are written to a temporary file that only
+	// the owner can access, which then replaces the sessions file,
+	// so that a crash never leaves a partially written file behind.
+	std::string tempPath(path);
+	tempPath += ".tmp";
+	try
+	{
+		createPrivateFile(tempPath);
+		Poco::FileOutputStream ostr(tempPath);
+		int count = saveSessions(ostr);
+		ostr.close();
+		if (!ostr.good()) throw Poco::WriteFileException(tempPath);
+		Poco::File(tempPath).renameTo(path);
+		_pPersistenceContext->logger().information(Poco::format("Saved %d session(s).", count));
+	}
+	catch (Poco::Exception& exc)
+	{
+		_pPersistenceContext->logger().warning("Cannot save sessions: " + exc.displayText());
+		try
+		{
+			Poco::File(tempPath).remove();
+		}
+		catch (...)
+		{
+		}
+	}
+}
+
+
+void WebSessionManager::createPrivateFile(const std::string& path)
+{
+	Poco::File file(path);
+	if (file.exists()) file.remove();
+#if defined(POCO_OS_FAMILY_UNIX)
+	int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+	if (fd == -1) throw Poco::CreateFileException(path, Poco::Error::getMessage(Poco::Error::last()));
+	::close(fd);
+#else
+	file.createFile();
+#endif
+}
+
+
+WebSessionManager::Shard& WebSessionManager::shardFor(const std::string& id)
+{
+	return _shards[Poco::hash(id) % SHARD_COUNT];
+}
+
+
+void WebSessionManager::add(WebSession::Ptr pSession)
+{
+	WebSession::Ptr pReplaced; // destroyed after the shard lock has been released
+	Shard& shard = shardFor(pSession->id());
+	{
+		FastMutex::ScopedLock lock(shard.mutex);
+
+		WebSession::Ptr& pEntry = shard.sessions[pSession->id()];
+		pReplaced = pEntry;
+		pEntry = pSession;
+		schedule(shard, *pSession);
+	}
+}
+
+
+void WebSessionManager::schedule(Shard& shard, const WebSession& session)
+{
+	// round up, so that the session has expired when its slot is due
+	Poco::Timestamp::TimeVal slot = slotTime(session.getExpiration()) + 1;
+	shard.wheel[static_cast<std::size_t>(slot % WHEEL_SLOTS)].push_back(session.id());
+}
+
+
+void WebSessionManager::onTimer(Poco::Timer& timer)
+{
+	try
+	{
+		expireSessions();
+	}
+	catch (Poco::Exception& exc)
+	{
+		Poco::ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		Poco::ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		Poco::ErrorHandler::handle();
+	}
 }
 
 
@@ -179,10 +622,10 @@ void WebSessionManager::addCookie(const std::string& appName, const Poco::Net::H
 
 std::string WebSessionManager::createSessionId(const Poco::Net::HTTPServerRequest& request)
 {
-	++_serial;
+	Poco::UInt32 serial = static_cast<Poco::UInt32>(++_serial);
 	
 	Poco::SHA1Engine sha1;
-	sha1.update(&_serial, sizeof(_serial));
+	sha1.update(&serial, sizeof(serial));
 	Poco::Timestamp::TimeVal tv = Poco::Timestamp().epochMicroseconds();
 	sha1.update(&tv, sizeof(tv));
 	Poco::RandomInputStream ris;
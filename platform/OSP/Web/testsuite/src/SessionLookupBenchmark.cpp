@@ -0,0 +1,338 @@
+//
+// SessionLookupBenchmark.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// A benchmark for concurrent session lookups with the WebSessionManager.
+//
+// A number of threads repeatedly look up sessions with find(), as
+// is done by the web server for every request carrying a session
+// cookie. For comparison, the benchmark also includes the lookup
+// WebSessionManager used before sessions were kept in shards
+// (a single mutex protecting a Poco::UniqueExpireCache).
+//
+
+
+#include "TestServerRequest.h"
+#include "Poco/OSP/Web/WebSessionManager.h"
+#include "Poco/OSP/BundleFactory.h"
+#include "Poco/OSP/BundleContextFactory.h"
+#include "Poco/OSP/BundleLoader.h"
+#include "Poco/OSP/CodeCache.h"
+#include "Poco/OSP/ServiceRegistry.h"
+#include "Poco/OSP/LanguageTag.h"
+#include "Poco/OSP/SystemEvents.h"
+#include "Poco/Net/HTTPCookie.h"
+#include "Poco/Net/NameValueCollection.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/UniqueExpireCache.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/FileStream.h"
+#include "Poco/File.h"
+#include "Poco/Path.h"
+#include "Poco/Process.h"
+#include "Poco/Format.h"
+#include <iostream>
+#include <vector>
+
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::OptionCallback;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using namespace Poco::OSP::Web;
+using namespace Poco::OSP;
+
+
+namespace
+{
+	const std::string APP_NAME("bench");
+	const std::string COOKIE_NAME("osp.web.session.bench");
+	const std::string CLIENT_ADDRESS("192.168.1.10:40000");
+}
+
+
+class LegacySessionManager
+	/// The previous WebSessionManager session lookup, for comparison.
+{
+public:
+	void add(WebSession::Ptr pSession)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_cache.add(pSession->id(), pSession);
+	}
+
+	WebSession::Ptr find(const std::string& appName, const Poco::Net::HTTPServerRequest& request)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		WebSession::Ptr pSession(_cache.get(getId(request)));
+		if (pSession)
+		{
+			if (pSession->clientAddress() == request.clientAddress().host())
+			{
+				pSession->access();
+				_cache.add(pSession->id(), pSession);
+				addCookie(request, pSession);
+			}
+			else
+			{
+				_cache.remove(pSession->id());
+				return 0;
+			}
+		}
+		return pSession;
+	}
+
+protected:
+	std::string getId(const Poco::Net::HTTPServerRequest& request)
+	{
+		Poco::Net::NameValueCollection cookies;
+		request.getCookies(cookies);
+		return cookies.get(COOKIE_NAME, "");
+	}
+
+	void addCookie(const Poco::Net::HTTPServerRequest& request, WebSession::Ptr pSession)
+	{
+		Poco::Net::HTTPCookie cookie(COOKIE_NAME, pSession->id());
+		cookie.setMaxAge(pSession->timeout());
+		cookie.setPath("/");
+		cookie.setHttpOnly();
+		request.response().addCookie(cookie);
+	}
+
+private:
+	Poco::FastMutex _mutex;
+	Poco::UniqueExpireCache<std::string, WebSession> _cache;
+};
+
+
+template <class M>
+class LookupWorker: public Poco::Runnable
+	/// Looks up the given sessions in turn, starting at
+	/// an offset, so that threads access different sessions.
+{
+public:
+	LookupWorker(M& sessionManager, const std::vector<std::string>& ids, std::size_t offset, int lookups):
+		_sessionManager(sessionManager),
+		_offset(offset),
+		_lookups(lookups),
+		_failed(0)
+	{
+		for (std::vector<std::string>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+		{
+			Poco::SharedPtr<TestServerRequest> pRequest = new TestServerRequest(CLIENT_ADDRESS);
+			pRequest->setCookie(COOKIE_NAME, *it);
+			_requests.push_back(pRequest);
+		}
+	}
+
+	void run()
+	{
+		std::size_t n = _requests.size();
+		for (int i = 0; i < _lookups; i++)
+		{
+			TestServerRequest& request = *_requests[(_offset + 7*i) % n];
+			if (!_sessionManager.find(APP_NAME, request)) _failed++;
+			request.response().erase(Poco::Net::HTTPResponse::SET_COOKIE);
+		}
+	}
+
+	int failed() const
+	{
+		return _failed;
+	}
+
+private:
+	M& _sessionManager;
+	std::vector<Poco::SharedPtr<TestServerRequest> > _requests;
+	std::size_t _offset;
+	int _lookups;
+	int _failed;
+};
+
+
+class SessionLookupBenchmark: public Application
+{
+public:
+	SessionLookupBenchmark():
+		_helpRequested(false),
+		_lookups(200000),
+		_sessions(1000),
+		_threads(8)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<SessionLookupBenchmark>(this, &SessionLookupBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("lookups", "n", "Number of lookups per thread (default 200000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 1000000000))
+				.binding("benchmark.lookups"));
+
+		options.addOption(
+			Option("sessions", "s", "Number of sessions (default 1000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 1000000))
+				.binding("benchmark.sessions"));
+
+		options.addOption(
+			Option("threads", "t", "Maximum number of threads (default 8).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 256))
+				.binding("benchmark.threads"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("Benchmark measuring concurrent WebSessionManager session lookups.");
+		helpFormatter.format(std::cout);
+	}
+
+	template <class M>
+	double measure(M& sessionManager, const std::vector<std::string>& ids, int threadCount)
+	{
+		std::vector<LookupWorker<M>*> workers;
+		std::vector<Poco::Thread*> threads;
+		for (int i = 0; i < threadCount; i++)
+		{
+			workers.push_back(new LookupWorker<M>(sessionManager, ids, i*ids.size()/threadCount, _lookups));
+			threads.push_back(new Poco::Thread);
+		}
+
+		Poco::Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < threadCount; i++)
+		{
+			threads[i]->start(*workers[i]);
+		}
+		int failed = 0;
+		for (int i = 0; i < threadCount; i++)
+		{
+			threads[i]->join();
+			failed += workers[i]->failed();
+		}
+		sw.stop();
+
+		for (int i = 0; i < threadCount; i++)
+		{
+			delete threads[i];
+			delete workers[i];
+		}
+		if (failed) logger().warning(Poco::format("%d lookups failed.", failed));
+
+		return static_cast<double>(threadCount)*_lookups*sw.resolution()/sw.elapsed();
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		_lookups = config().getInt("benchmark.lookups", _lookups);
+		_sessions = config().getInt("benchmark.sessions", _sessions);
+		_threads = config().getInt("benchmark.threads", _threads);
+
+		// WebSession requires the BundleContext of the bundle creating it.
+		Poco::Path bundlePath(Poco::Path::temp());
+		bundlePath.pushDirectory(Poco::format("SessionLookupBenchmark%lu", static_cast<unsigned long>(Poco::Process::id())));
+		Poco::File(bundlePath.toString() + "META-INF").createDirectories();
+		{
+			Poco::FileOutputStream manifest(bundlePath.toString() + "META-INF/manifest.mf");
+			manifest
+				<< "Manifest-Version: 1.0\n"
+				<< "Bundle-Name: Session Lookup Benchmark\n"
+				<< "Bundle-SymbolicName: com.appinf.osp.sessionbench\n"
+				<< "Bundle-Version: 1.0.0\n";
+		}
+
+		CodeCache codeCache(bundlePath.toString() + "codeCache");
+		ServiceRegistry registry;
+		Poco::OSP::SystemEvents systemEvents;
+		BundleFactory::Ptr pBundleFactory(new BundleFactory(LanguageTag("en", "US")));
+		BundleContextFactory::Ptr pBundleContextFactory(new BundleContextFactory(registry, systemEvents));
+		BundleLoader loader(codeCache, pBundleFactory, pBundleContextFactory);
+		Bundle::Ptr pBundle = loader.createBundle(bundlePath.toString());
+		loader.loadBundle(pBundle);
+		BundleContext::Ptr pContext = loader.contextForBundle(pBundle);
+
+		{
+			WebSessionManager::Ptr pSessionManager = new WebSessionManager;
+			LegacySessionManager legacySessionManager;
+			std::vector<std::string> ids;
+			for (int i = 0; i < _sessions; i++)
+			{
+				TestServerRequest request(CLIENT_ADDRESS);
+				WebSession::Ptr pSession = pSessionManager->create(APP_NAME, request, 3600, pContext);
+				legacySessionManager.add(pSession);
+				ids.push_back(pSession->id());
+			}
+
+			std::cout << Poco::format("%d sessions, %d lookups per thread, lookups per second", _sessions, _lookups) << std::endl;
+			std::cout << Poco::format("%-8s %14s %14s %8s", std::string("threads"), std::string("single mutex"), std::string("sharded"), std::string("speedup")) << std::endl;
+			for (int threadCount = 1; threadCount <= _threads; threadCount *= 2)
+			{
+				double legacy = measure(legacySessionManager, ids, threadCount);
+				double sharded = measure(*pSessionManager, ids, threadCount);
+				std::cout << Poco::format("%-8d %14.0f %14.0f %7.2fx", threadCount, legacy, sharded, sharded/legacy) << std::endl;
+			}
+		}
+
+		pContext = 0;
+		loader.unloadAllBundles();
+		Poco::File(bundlePath).remove(true);
+
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+	int _lookups;
+	int _sessions;
+	int _threads;
+};
+
+
+POCO_APP_MAIN(SessionLookupBenchmark)
@@ -0,0 +1,123 @@
+//
+// TestServerRequest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "TestServerRequest.h"
+
+
+TestServerResponse::TestServerResponse():
+	_sent(false)
+{
+}
+
+
+TestServerResponse::~TestServerResponse()
+{
+}
+
+
+void TestServerResponse::sendContinue()
+{
+}
+
+
+std::ostream& TestServerResponse::send()
+{
+	_sent = true;
+	return _stream;
+}
+
+
+void TestServerResponse::sendFile(const std::string& path, const std::string& mediaType)
+{
+	_sent = true;
+}
+
+
+void TestServerResponse::sendBuffer(const void* pBuffer, std::size_t length)
+{
+	_stream.write(static_cast<const char*>(pBuffer), static_cast<std::streamsize>(length));
+	_sent = true;
+}
+
+
+void TestServerResponse::redirect(const std::string& uri, HTTPStatus status)
+{
+	setStatusAndReason(status);
+	set("Location", uri);
+	_sent = true;
+}
+
+
+void TestServerResponse::requireAuthentication(const std::string& realm)
+{
+	setStatusAndReason(HTTP_UNAUTHORIZED);
+	_sent = true;
+}
+
+
+bool TestServerResponse::sent() const
+{
+	return _sent;
+}
+
+
+TestServerRequest::TestServerRequest(const std::string& clientAddress):
+	_clientAddress(clientAddress),
+	_serverAddress("127.0.0.1:8080"),
+	_pParams(new Poco::Net::HTTPServerParams)
+{
+}
+
+
+TestServerRequest::~TestServerRequest()
+{
+}
+
+
+void TestServerRequest::setCookie(const std::string& name, const std::string& value)
+{
+	set("Cookie", name + "=" + value);
+}
+
+
+std::istream& TestServerRequest::stream()
+{
+	return _stream;
+}
+
+
+const Poco::Net::SocketAddress& TestServerRequest::clientAddress() const
+{
+	return _clientAddress;
+}
+
+
+const Poco::Net::SocketAddress& TestServerRequest::serverAddress() const
+{
+	return _serverAddress;
+}
+
+
+const Poco::Net::HTTPServerParams& TestServerRequest::serverParams() const
+{
+	return *_pParams;
+}
+
+
+Poco::Net::HTTPServerResponse& TestServerRequest::response() const
+{
+	return _response;
+}
+
+
+bool TestServerRequest::secure() const
+{
+	return false;
+}
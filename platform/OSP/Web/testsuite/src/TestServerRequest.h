@@ -0,0 +1,75 @@
+//
+// TestServerRequest.h
+//
+// Definition of the TestServerRequest and TestServerResponse classes.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TestServerRequest_INCLUDED
+#define TestServerRequest_INCLUDED
+
+
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/SocketAddress.h"
+#include <sstream>
+
+
+class TestServerResponse: public Poco::Net::HTTPServerResponse
+	/// A HTTPServerResponse that is not connected to a socket.
+{
+public:
+	TestServerResponse();
+	~TestServerResponse();
+
+	void sendContinue();
+	std::ostream& send();
+	void sendFile(const std::string& path, const std::string& mediaType);
+	void sendBuffer(const void* pBuffer, std::size_t length);
+	void redirect(const std::string& uri, HTTPStatus status = HTTP_FOUND);
+	void requireAuthentication(const std::string& realm);
+	bool sent() const;
+
+private:
+	std::ostringstream _stream;
+	bool _sent;
+};
+
+
+class TestServerRequest: public Poco::Net::HTTPServerRequest
+	/// A HTTPServerRequest that is not connected to a socket,
+	/// for testing request handlers and session management.
+{
+public:
+	TestServerRequest(const std::string& clientAddress);
+		/// Creates the TestServerRequest for a client with the
+		/// given address (host:port).
+
+	~TestServerRequest();
+
+	void setCookie(const std::string& name, const std::string& value);
+		/// Sets the Cookie header to contain the single given cookie.
+
+	std::istream& stream();
+	const Poco::Net::SocketAddress& clientAddress() const;
+	const Poco::Net::SocketAddress& serverAddress() const;
+	const Poco::Net::HTTPServerParams& serverParams() const;
+	Poco::Net::HTTPServerResponse& response() const;
+	bool secure() const;
+
+private:
+	std::istringstream _stream;
+	Poco::Net::SocketAddress _clientAddress;
+	Poco::Net::SocketAddress _serverAddress;
+	Poco::Net::HTTPServerParams::Ptr _pParams;
+	mutable TestServerResponse _response;
+};
+
+
+#endif // TestServerRequest_INCLUDED
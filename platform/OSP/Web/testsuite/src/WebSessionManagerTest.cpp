@@ -0,0 +1,475 @@
+//
+// WebSessionManagerTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "WebSessionManagerTest.h"
+#include "TestServerRequest.h"
+#include "Poco/OSP/Web/WebSessionManager.h"
+#include "Poco/OSP/Bundle.h"
+#include "Poco/OSP/BundleFactory.h"
+#include "Poco/OSP/BundleContextFactory.h"
+#include "Poco/OSP/BundleLoader.h"
+#include "Poco/OSP/CodeCache.h"
+#include "Poco/OSP/ServiceRegistry.h"
+#include "Poco/OSP/LanguageTag.h"
+#include "Poco/OSP/SystemEvents.h"
+#include "Poco/OSP/BundleEvents.h"
+#include "Poco/Net/HTTPCookie.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/FileStream.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include <sstream>
+#include <vector>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <sys/stat.h>
+#endif
+
+
+using namespace Poco::OSP::Web;
+using namespace Poco::OSP;
+
+
+namespace
+{
+	const std::string APP_NAME("test");
+	const std::string COOKIE_NAME("osp.web.session.test");
+	const std::string BUNDLE_PATH("sessionTestBundle");
+	const std::string CLIENT_ADDRESS("192.168.1.10:40000");
+
+	class TestBundleEnvironment
+		/// Creates the objects required for obtaining
+		/// a BundleContext for the test bundle.
+	{
+	public:
+		TestBundleEnvironment():
+			_codeCache("codeCache"),
+			_language("en", "US"),
+			_pBundleFactory(new BundleFactory(_language)),
+			_pBundleContextFactory(new BundleContextFactory(_registry, _systemEvents)),
+			_loader(_codeCache, _pBundleFactory, _pBundleContextFactory)
+		{
+			_pBundle = _loader.createBundle(BUNDLE_PATH);
+			_loader.loadBundle(_pBundle);
+		}
+
+		~TestBundleEnvironment()
+		{
+			_loader.unloadAllBundles();
+		}
+
+		BundleContext::Ptr context() const
+		{
+			return _loader.contextForBundle(_pBundle);
+		}
+
+		void stopBundle()
+			/// Fires the bundleStopping event for the test bundle,
+			/// as the BundleLoader does when stopping it.
+		{
+			BundleEvent event(_pBundle, BundleEvent::EV_BUNDLE_STOPPING);
+			context()->events().bundleStopping(this, event);
+		}
+
+		void shutDown()
+			/// Fires the systemShuttingDown event and then stops the
+			/// test bundle, like the OSPSubsystem does for the bundles
+			/// depending on the Web bundle.
+		{
+			SystemEvents::EventKind kind = SystemEvents::EV_SYSTEM_SHUTTING_DOWN;
+			_systemEvents.systemShuttingDown(this, kind);
+			stopBundle();
+		}
+
+	private:
+		CodeCache _codeCache;
+		ServiceRegistry _registry;
+		LanguageTag _language;
+		Poco::OSP::SystemEvents _systemEvents;
+		BundleFactory::Ptr _pBundleFactory;
+		BundleContextFactory::Ptr _pBundleContextFactory;
+		BundleLoader _loader;
+		Bundle::Ptr _pBundle;
+	};
+
+	std::string sessionCookie(const TestServerRequest& request)
+	{
+		std::vector<Poco::Net::HTTPCookie> cookies;
+		request.response().getCookies(cookies);
+		for (std::vector<Poco::Net::HTTPCookie>::const_iterator it = cookies.begin(); it != cookies.end(); ++it)
+		{
+			if (it->getName() == COOKIE_NAME) return it->getValue();
+		}
+		return std::string();
+	}
+
+	class SessionFinder: public Poco::Runnable
+	{
+	public:
+		SessionFinder(WebSessionManager& sessionManager, const std::vector<std::string>& ids, int rounds):
+			_sessionManager(sessionManager),
+			_ids(ids),
+			_rounds(rounds)
+		{
+		}
+
+		void run()
+		{
+			for (int k = 0; k < _rounds; k++)
+			{
+				for (std::vector<std::string>::const_iterator it = _ids.begin(); it != _ids.end(); ++it)
+				{
+					TestServerRequest request(CLIENT_ADDRESS);
+					request.setCookie(COOKIE_NAME, *it);
+					WebSession::Ptr pSession = _sessionManager.find(APP_NAME, request);
+					if (!pSession || pSession->id() != *it) _failed++;
+				}
+			}
+		}
+
+		int failed() const
+		{
+			return _failed.value();
+		}
+
+	private:
+		WebSessionManager& _sessionManager;
+		const std::vector<std::string>& _ids;
+		int _rounds;
+		Poco::AtomicCounter _failed;
+	};
+}
+
+
+WebSessionManagerTest::WebSessionManagerTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+WebSessionManagerTest::~WebSessionManagerTest()
+{
+}
+
+
+void WebSessionManagerTest::testCreateFind()
+{
+	TestBundleEnvironment env;
+	WebSessionManager::Ptr pSessionManager = new WebSessionManager;
+
+	TestServerRequest createRequest(CLIENT_ADDRESS);
+	WebSession::Ptr pSession = pSessionManager->create(APP_NAME, createRequest, 60, env.context());
+	assert (!pSession->id().empty());
+	assert (pSession->has(WebSession::CSRF_TOKEN));
+	assert (pSession->clientAddress().toString() == "192.168.1.10");
+	assert (sessionCookie(createRequest) == pSession->id());
+	assert (pSessionManager->sessionCount() == 1);
+
+	TestServerRequest findRequest(CLIENT_ADDRESS);
+	findRequest.setCookie(COOKIE_NAME, pSession->id());
+	assert (pSessionManager->find(APP_NAME, findRequest) == pSession);
+	assert (sessionCookie(findRequest) == pSession->id());
+
+	assert (pSessionManager->get(APP_NAME, findRequest, 60, env.context()) == pSession);
+
+	TestServerRequest otherRequest(CLIENT_ADDRESS);
+	otherRequest.setCookie(COOKIE_NAME, "0123456789");
+	assert (!pSessionManager->find(APP_NAME, otherRequest));
+
+	TestServerRequest noCookieRequest(CLIENT_ADDRESS);
+	assert (!pSessionManager->find(APP_NAME, noCookieRequest));
+	WebSession::Ptr pOtherSession = pSessionManager->get(APP_NAME, noCookieRequest, 60, env.context());
+	assert (pOtherSession && pOtherSession != pSession);
+	assert (pSessionManager->sessionCount() == 2);
+}
+
+
+void WebSessionManagerTest::testClientAddress()
+{
+	TestBundleEnvironment env;
+	WebSessionManager::Ptr pSessionManager = new WebSessionManager;
+
+	TestServerRequest createRequest(CLIENT_ADDRESS);
+	WebSession::Ptr pSession = pSessionManager->create(APP_NAME, createRequest, 60, env.context());
+
+	// same session ID from a different host invalidates the session
+	TestServerRequest otherHostRequest("192.168.1.11:40000");
+	otherHostRequest.setCookie(COOKIE_NAME, pSession->id());
+	assert (!pSessionManager->find(APP_NAME, otherHostRequest));
+	assert (pSessionManager->sessionCount() == 0);
+
+	TestServerRequest findRequest(CLIENT_ADDRESS);
+	findRequest.setCookie(COOKIE_NAME, pSession->id());
+	assert (!pSessionManager->find(APP_NAME, findRequest));
+}
+
+
+void WebSessionManagerTest::testRemove()
+{
+	TestBundleEnvironment env;
+	WebSessionManager::Ptr pSessionManager = new WebSessionManager;
+
+	TestServerRequest createRequest(CLIENT_ADDRESS);
+	WebSession::Ptr pSession = pSessionManager->create(APP_NAME, createRequest, 60, env.context());
+	assert (pSessionManager->sessionCount() == 1);
+
+	pSessionManager->remove(pSession);
+	assert (pSessionManager->sessionCount() == 0);
+
+	TestServerRequest findRequest(CLIENT_ADDRESS);
+	findRequest.setCookie(COOKIE_NAME, pSession->id());
+	assert (!pSessionManager->find(APP_NAME, findRequest));
+
+	// removing a session twice is harmless
+	pSessionManager->remove(pSession);
+}
+
+
+void WebSessionManagerTest::testManySessions()
+{
+	const int SESSIONS = 1000;
+
+	TestBundleEnvironment env;
+	WebSessionManager::Ptr pSessionManager = new WebSessionManager;
+
+	std::vector<WebSession::Ptr> sessions;
+	for (int i = 0; i < SESSIONS; i++)
+	{
+		TestServerRequest request(CLIENT_ADDRESS);
+		sessions.push_back(pSessionManager->create(APP_NAME, request, 60, env.context()));
+	}
+	assert (pSessionManager->sessionCount() == SESSIONS);
+
+	for (int i = 0; i < SESSIONS; i++)
+	{
+		TestServerRequest request(CLIENT_ADDRESS);
+		request.setCookie(COOKIE_NAME, sessions[i]->id());
+		assert (pSessionManager->find(APP_NAME, request) == sessions[i]);
+	}
+
+	for (int i = 0; i < SESSIONS; i += 2)
+	{
+		pSessionManager->remove(sessions[i]);
+	}
+	assert (pSessionManager->sessionCount() == SESSIONS/2);
+}
+
+
+void WebSessionManagerTest::testConcurrentFind()
+{
+	const int SESSIONS = 200;
+	const int THREADS = 4;
+
+	TestBundleEnvironment env;
+	WebSessionManager::Ptr pSessionManager = new WebSessionManager;
+
+	std::vector<std::string> ids;
+	for (int i = 0; i < SESSIONS; i++)
+	{
+		TestServerRequest request(CLIENT_ADDRESS);
+		ids.push_back(pSessionManager->create(APP_NAME, request, 60, env.context())->id());
+	}
+
+	std::vector<SessionFinder*> finders;
+	std::vector<Poco::Thread*> threads;
+	for (int i = 0; i < THREADS; i++)
+	{
+		finders.push_back(new SessionFinder(*pSessionManager, ids, 20));
+		threads.push_back(new Poco::Thread);
+		threads.back()->start(*finders.back());
+	}
+	for (int i = 0; i < THREADS; i++)
+	{
+		threads[i]->join();
+		assert (finders[i]->failed() == 0);
+		delete threads[i];
+		delete finders[i];
+	}
+	assert (pSessionManager->sessionCount() == SESSIONS);
+}
+
+
+void WebSessionManagerTest::testExpire()
+{
+	TestBundleEnvironment env;
+	WebSessionManager::Ptr pSessionManager = new WebSessionManager;
+
+	TestServerRequest createRequest(CLIENT_ADDRESS);
+	WebSession::Ptr pExpiring = pSessionManager->create(APP_NAME, createRequest, 1, env.context());
+	WebSession::Ptr pAccessed = pSessionManager->create(APP_NAME, createRequest, 1, env.context());
+	WebSession::Ptr pLasting = pSessionManager->create(APP_NAME, createRequest, 60, env.context());
+	assert (pSessionManager->sessionCount() == 3);
+
+	// keep one of the short sessions alive by accessing it
+	for (int i = 0; i < 10; i++)
+	{
+		Poco::Thread::sleep(250);
+		TestServerRequest findRequest(CLIENT_ADDRESS);
+		findRequest.setCookie(COOKIE_NAME, pAccessed->id());
+		assert (pSessionManager->find(APP_NAME, findRequest) == pAccessed);
+	}
+
+	// an expired session is never returned, even if it has not been removed yet
+	TestServerRequest findRequest(CLIENT_ADDRESS);
+	findRequest.setCookie(COOKIE_NAME, pExpiring->id());
+	assert (!pSessionManager->find(APP_NAME, findRequest));
+
+	// the timer removes expired sessions
+	Poco::Thread::sleep(2500);
+	assert (pSessionManager->sessionCount() == 1);
+
+	findRequest.setCookie(COOKIE_NAME, pLasting->id());
+	assert (pSessionManager->find(APP_NAME, findRequest) == pLasting);
+}
+
+
+void WebSessionManagerTest::testPersistence()
+{
+	TestBundleEnvironment env;
+	std::stringstream stream;
+	std::string id;
+	std::string csrfToken;
+	Poco::Timestamp created;
+	{
+		WebSessionManager::Ptr pSessionManager = new WebSessionManager;
+
+		TestServerRequest createRequest(CLIENT_ADDRESS);
+		WebSession::Ptr pSession = pSessionManager->create(APP_NAME, createRequest, 60, env.context());
+		pSession->set("username", std::string("admin"));
+		pSession->set("count", 42);
+		pSession->set("authenticated", true);
+		pSession->set("ratio", 0.25);
+		pSession->set("unsupported", Poco::Timestamp());
+		id = pSession->id();
+		csrfToken = pSession->getValue<std::string>(WebSession::CSRF_TOKEN);
+		created = pSession->created();
+
+		WebSession::Ptr pExpired = pSessionManager->create(APP_NAME, createRequest, 0, env.context());
+
+		assert (pSessionManager->saveSessions(stream) == 1);
+	}
+
+	WebSessionManager::Ptr pSessionManager = new WebSessionManager;
+	assert (pSessionManager->loadSessions(stream, env.context()) == 1);
+	assert (pSessionManager->sessionCount() == 1);
+
+	TestServerRequest findRequest(CLIENT_ADDRESS);
+	findRequest.setCookie(COOKIE_NAME, id);
+	WebSession::Ptr pSession = pSessionManager->find(APP_NAME, findRequest);
+	assert (pSession);
+	assert (pSession->id() == id);
+	assert (pSession->timeout() == 60);
+	assert (pSession->created() == created);
+	assert (pSession->clientAddress().toString() == "192.168.1.10");
+	assert (pSession->context()->thisBundle()->symbolicName() == "com.appinf.osp.sessiontest");
+	assert (pSession->getValue<std::string>(WebSession::CSRF_TOKEN) == csrfToken);
+	assert (pSession->getValue<std::string>("username") == "admin");
+	assert (pSession->getValue<int>("count") == 42);
+	assert (pSession->getValue<bool>("authenticated"));
+	assert (pSession->getValue<double>("ratio") == 0.25);
+	assert (!pSession->has("unsupported"));
+
+	std::istringstream invalid("invalid");
+	try
+	{
+		pSessionManager->loadSessions(invalid, env.context());
+		fail("invalid data - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+}
+
+
+void WebSessionManagerTest::testPersistenceOnShutdown()
+{
+	TestBundleEnvironment env;
+	const std::string path("sessions.dat");
+	Poco::File sessionsFile(path);
+	if (sessionsFile.exists()) sessionsFile.remove();
+
+	std::string id;
+	{
+		WebSessionManager::Ptr pSessionManager = new WebSessionManager;
+		assert (pSessionManager->enablePersistence(path, env.context()) == 0);
+
+		TestServerRequest createRequest(CLIENT_ADDRESS);
+		WebSession::Ptr pSession = pSessionManager->create(APP_NAME, createRequest, 60, env.context());
+		pSession->set("username", std::string("admin"));
+		id = pSession->id();
+
+		// the bundle that created the session depends on the Web bundle,
+		// so it is stopped (and clears its sessions) before the Web bundle
+		env.shutDown();
+		assert (!pSession->has("username"));
+		pSessionManager->disablePersistence();
+	}
+	assert (sessionsFile.exists());
+#if defined(POCO_OS_FAMILY_UNIX)
+	struct stat st;
+	assert (::stat(path.c_str(), &st) == 0);
+	assert ((st.st_mode & (S_IRWXG | S_IRWXO)) == 0);
+#endif
+
+	WebSessionManager::Ptr pSessionManager = new WebSessionManager;
+	assert (pSessionManager->enablePersistence(path, env.context()) == 1);
+	assert (!sessionsFile.exists());
+
+	TestServerRequest findRequest(CLIENT_ADDRESS);
+	findRequest.setCookie(COOKIE_NAME, id);
+	WebSession::Ptr pSession = pSessionManager->find(APP_NAME, findRequest);
+	assert (pSession);
+	assert (pSession->getValue<std::string>("username") == "admin");
+
+	// stopping bundles without shutting down does not save sessions
+	env.stopBundle();
+	pSessionManager->disablePersistence();
+	assert (!sessionsFile.exists());
+}
+
+
+void WebSessionManagerTest::setUp()
+{
+	Poco::File metaInf(BUNDLE_PATH + "/META-INF");
+	metaInf.createDirectories();
+	Poco::FileOutputStream manifest(BUNDLE_PATH + "/META-INF/manifest.mf");
+	manifest
+		<< "Manifest-Version: 1.0\n"
+		<< "Bundle-Name: Session Test Bundle\n"
+		<< "Bundle-SymbolicName: com.appinf.osp.sessiontest\n"
+		<< "Bundle-Version: 1.0.0\n"
+		<< "Bundle-Vendor: Applied Informatics\n";
+}
+
+
+void WebSessionManagerTest::tearDown()
+{
+	Poco::File bundleDir(BUNDLE_PATH);
+	if (bundleDir.exists()) bundleDir.remove(true);
+}
+
+
+CppUnit::Test* WebSessionManagerTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("WebSessionManagerTest");
+
+	CppUnit_addTest(pSuite, WebSessionManagerTest, testCreateFind);
+	CppUnit_addTest(pSuite, WebSessionManagerTest, testClientAddress);
+	CppUnit_addTest(pSuite, WebSessionManagerTest, testRemove);
+	CppUnit_addTest(pSuite, WebSessionManagerTest, testManySessions);
+	CppUnit_addTest(pSuite, WebSessionManagerTest, testConcurrentFind);
+	CppUnit_addTest(pSuite, WebSessionManagerTest, testExpire);
+	CppUnit_addTest(pSuite, WebSessionManagerTest, testPersistence);
+	CppUnit_addTest(pSuite, WebSessionManagerTest, testPersistenceOnShutdown);
+
+	return pSuite;
+}
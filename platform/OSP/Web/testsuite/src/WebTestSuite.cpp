@@ -11,6 +11,7 @@
 #include "WebTestSuite.h"
 #include "WebServerDispatcherTest.h"
 #include "MediaTypeMapperTest.h"
+#include "WebSessionManagerTest.h"
 
 
 CppUnit::Test* WebTestSuite::suite()
@@ -19,6 +20,7 @@ CppUnit::Test* WebTestSuite::suite()
 
 	pSuite->addTest(WebServerDispatcherTest::suite());
 	pSuite->addTest(MediaTypeMapperTest::suite());
+	pSuite->addTest(WebSessionManagerTest::suite());
 
 	return pSuite;
 }
@@ -0,0 +1,99 @@
+//
+// CredentialCache.h
+//
+// Library: OSP
+// Package: Auth
+// Module:  CredentialCache
+//
+// Definition of the CredentialCache class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef OSP_Auth_CredentialCache_INCLUDED
+#define OSP_Auth_CredentialCache_INCLUDED
+
+
+#include "Poco/OSP/OSP.h"
+#include "Poco/ExpireLRUCache.h"
+#include "Poco/Timestamp.h"
+
+
+namespace Poco {
+namespace OSP {
+namespace Auth {
+
+
+class OSP_API CredentialCache
+	/// CredentialCache remembers successfully verified user name
+	/// and credentials combinations for a limited time.
+	///
+	/// An AuthService that stores password hashes created with an
+	/// expensive key derivation function (see PasswordHash) can use
+	/// a CredentialCache to avoid repeating the key derivation for
+	/// every request, e.g. when a client uses HTTP Basic authentication
+	/// for a series of REST API calls.
+	///
+	/// Entries are keyed by a HMAC-SHA1 of the user name and credentials,
+	/// using a random key generated when the cache is created. Plain
+	/// credentials are therefore never stored in the cache, and the keys
+	/// cannot be used to look up credentials in other processes.
+	///
+	/// The number of entries is bounded; if the cache is full, the least
+	/// recently used entry is removed. Entries expire a fixed time after
+	/// they have been added, even if they are used in the meantime.
+	///
+	/// All member functions are thread safe.
+{
+public:
+	enum
+	{
+		DEFAULT_SIZE = 64,
+			/// Default maximum number of entries.
+		DEFAULT_EXPIRE = 300
+			/// Default time in seconds after which entries expire.
+	};
+
+	CredentialCache(long size = DEFAULT_SIZE, int expireSeconds = DEFAULT_EXPIRE);
+		/// Creates the CredentialCache with the given maximum
+		/// size and expiration time.
+
+	~CredentialCache();
+		/// Destroys the CredentialCache.
+
+	bool verified(const std::string& userName, const std::string& credentials) const;
+		/// Returns true if the given user name and credentials have
+		/// been added to the cache and the entry has not expired yet.
+
+	void add(const std::string& userName, const std::string& credentials);
+		/// Adds the given user name and credentials, which must have
+		/// been successfully verified, to the cache.
+
+	void clear();
+		/// Removes all entries from the cache, e.g. after a password
+		/// has been changed.
+
+	std::size_t size() const;
+		/// Returns the number of entries in the cache, including
+		/// expired entries that have not been removed yet.
+
+protected:
+	std::string key(const std::string& userName, const std::string& credentials) const;
+
+private:
+	CredentialCache(const CredentialCache&);
+	CredentialCache& operator = (const CredentialCache&);
+
+	std::string _secret;
+	mutable Poco::ExpireLRUCache<std::string, std::string> _cache;
+};
+
+
+} } } // namespace Poco::OSP::Auth
+
+
+#endif // OSP_Auth_CredentialCache_INCLUDED
@@ -0,0 +1,94 @@
+//
+// PasswordHash.h
+//
+// Library: OSP
+// Package: Auth
+// Module:  PasswordHash
+//
+// Definition of the PasswordHash class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef OSP_Auth_PasswordHash_INCLUDED
+#define OSP_Auth_PasswordHash_INCLUDED
+
+
+#include "Poco/OSP/OSP.h"
+
+
+namespace Poco {
+namespace OSP {
+namespace Auth {
+
+
+class OSP_API PasswordHash
+	/// PasswordHash creates and verifies password hashes using
+	/// the PBKDF2 key derivation function (RFC 2898) with HMAC-SHA1.
+	///
+	/// A password hash is stored as a string in the following format:
+	///
+	///     $pbkdf2-sha1$<iterations>$<salt>$<hash>
+	///
+	/// where <iterations> is the decimal iteration count, and <salt> and
+	/// <hash> are hex-encoded. As the iteration count and salt are part
+	/// of the hash string, the iteration count can be increased for new
+	/// hashes without invalidating existing ones.
+{
+public:
+	enum
+	{
+		DEFAULT_ITERATIONS = 10000,
+			/// Default iteration count for new password hashes.
+		SALT_LENGTH = 16,
+			/// Length of the random salt in bytes.
+		MIN_ITERATIONS = 1000,
+			/// Minimum accepted iteration count.
+		MAX_ITERATIONS = 10000000
+			/// Maximum accepted iteration count.
+	};
+
+	static std::string create(const std::string& password, int iterations = DEFAULT_ITERATIONS);
+		/// Creates a password hash for the given password, using
+		/// a random salt and the given iteration count.
+		///
+		/// Throws a Poco::InvalidArgumentException if the iteration count
+		/// is not between MIN_ITERATIONS and MAX_ITERATIONS.
+
+	static std::string create(const std::string& password, const std::string& salt, int iterations);
+		/// Creates a password hash for the given password, using
+		/// the given (binary) salt and iteration count.
+
+	static bool verify(const std::string& password, const std::string& hash);
+		/// Returns true if the given password matches the given
+		/// password hash, otherwise false.
+		///
+		/// Returns false if the hash is not a valid password hash.
+
+	static bool isPasswordHash(const std::string& hash);
+		/// Returns true if the given string has the format
+		/// of a password hash created by create().
+
+	static bool equals(const std::string& s1, const std::string& s2);
+		/// Compares two strings in a time that does not depend on
+		/// the position of the first difference.
+
+	static const std::string SCHEME;
+		/// The scheme prefix of a password hash ("$pbkdf2-sha1$").
+
+protected:
+	static bool parse(const std::string& hash, int& iterations, std::string& salt, std::string& digest);
+
+private:
+	PasswordHash();
+};
+
+
+} } } // namespace Poco::OSP::Auth
+
+
+#endif // OSP_Auth_PasswordHash_INCLUDED
@@ -20,6 +20,7 @@
 
 #include "Poco/OSP/OSP.h"
 #include "Poco/OSP/LanguageTag.h"
+#include "Poco/OSP/BundleStorage.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/AutoPtr.h"
 
@@ -48,6 +49,11 @@ public:
 		/// the bundle stored in the given path, using
 		/// the given BundleLoader.
 
+	virtual Bundle* createBundle(BundleLoader& loader, BundleStorage::Ptr pStorage);
+		/// Creates and returns a new Bundle object for
+		/// the bundle stored in the given BundleStorage,
+		/// using the given BundleLoader.
+
 protected:
 	~BundleFactory();
 		/// Destroys the BundleFactory.
@@ -48,6 +48,9 @@ public:
 	Poco::Timestamp lastModified(const std::string& path) const;	
 	std::string path() const;
 
+	const Poco::Zip::ZipArchive& archive() const;
+		/// Returns the ZipArchive for the bundle file.
+
 protected:
 	bool isSubdirectoryOf(const std::string& dir, const std::string& parent) const;
 		/// Returns true iff dir is a subdirectory of parent.
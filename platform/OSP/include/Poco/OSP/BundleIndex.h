@@ -0,0 +1,201 @@
+//
+// BundleIndex.h
+//
+// Library: OSP
+// Package: Bundle
+// Module:  BundleIndex
+//
+// Definition of the BundleIndex class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef OSP_BundleIndex_INCLUDED
+#define OSP_BundleIndex_INCLUDED
+
+
+#include "Poco/OSP/OSP.h"
+#include "Poco/OSP/BundleStorage.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Mutex.h"
+#include <map>
+#include <istream>
+#include <ostream>
+
+
+namespace Poco {
+namespace OSP {
+
+
+class OSP_API BundleIndex: public Poco::RefCountedObject
+	/// BundleIndex is a persistent index of the bundle files
+	/// in a bundle repository. It is used by the BundleRepository
+	/// to avoid opening and scanning every bundle file at startup.
+	///
+	/// For every bundle file (bundle directories are not indexed),
+	/// the index stores the directory of the bundle's Zip archive,
+	/// together with the contents of the bundle's manifest,
+	/// its bundle.properties files and its extensions.xml file.
+	///
+	/// An index entry is only used if the size, the modification
+	/// date and the checksum of the Zip central directory of the
+	/// bundle file still match the values stored in the index.
+	/// Otherwise, the bundle file is opened and scanned as usual,
+	/// and the index entry is replaced.
+	///
+	/// The storage returned for an indexed bundle serves the
+	/// cached resources and directory listings from memory. The
+	/// bundle file is only opened if another resource (e.g.,
+	/// a shared library or a web resource) is requested.
+	///
+	/// Cached resources are stored as they are. The manifest
+	/// and the extensions.xml file are still parsed when the
+	/// bundle is loaded or started, respectively.
+	///
+	/// The index is stored in a single file, protected with
+	/// a checksum. If the index file cannot be read, or its
+	/// checksum does not match, the index starts out empty and
+	/// all bundles are scanned.
+{
+public:
+	typedef Poco::AutoPtr<BundleIndex> Ptr;
+
+	BundleIndex(const std::string& path);
+		/// Creates the BundleIndex, using the given
+		/// path for the index file. The index file is
+		/// not read until load() is called.
+
+	bool load();
+		/// Loads the index from the index file.
+		///
+		/// Returns true if the index has been loaded, or false
+		/// if the index file does not exist or is invalid.
+		/// In the latter case, the index is empty.
+
+	void save();
+		/// Saves the index to the index file, if it has
+		/// been changed since it has been loaded.
+		///
+		/// Only entries for bundles that have been requested with
+		/// storageFor() since the index has been loaded are saved.
+		///
+		/// The index file is written to a temporary file first,
+		/// which is then renamed.
+
+	BundleStorage::Ptr storageFor(const std::string& path);
+		/// Returns a BundleStorage for the bundle file with the given path.
+		///
+		/// If the index contains a valid entry for the bundle file,
+		/// returns a storage that uses the cached entry.
+		/// Otherwise, opens the bundle file, adds an entry for it
+		/// to the index and returns a BundleFile.
+		///
+		/// Returns a null pointer if the path does not specify
+		/// a file (e.g., for bundle directories).
+
+	const std::string& path() const;
+		/// Returns the path of the index file.
+
+	int hits() const;
+		/// Returns the number of storageFor() calls that
+		/// have been served from the index.
+
+	int misses() const;
+		/// Returns the number of storageFor() calls that
+		/// required the bundle file to be scanned.
+
+	static bool isCachedResource(const std::string& path);
+		/// Returns true if a resource with the given path
+		/// is cached in the index.
+
+	enum
+	{
+		MAX_CACHED_RESOURCE_SIZE = 65536
+			/// Cached resources larger than this are not stored
+			/// in the index, but read from the bundle file.
+	};
+
+	struct FileEntry
+	{
+		enum Flags
+		{
+			HAS_HEADER = 0x01,
+				/// The Zip archive has a local file header for the entry.
+			IS_FILE    = 0x02,
+				/// The entry denotes a file (not a directory).
+			HAS_INFO   = 0x04
+				/// The Zip central directory has an entry for the file.
+		};
+
+		int flags;
+		Poco::Timestamp::TimeVal modified;
+	};
+
+	struct Entry
+	{
+		typedef std::map<std::string, FileEntry> Files;
+		typedef std::map<std::string, std::string> Resources;
+
+		Entry();
+
+		Poco::UInt64 size;
+		Poco::Timestamp::TimeVal modified;
+		Poco::UInt32 directoryChecksum;
+		Files files;
+			/// The directory of the Zip archive.
+		Resources resources;
+			/// Contents of cached resources.
+		bool used;
+	};
+
+	typedef Poco::SharedPtr<Entry> EntryPtr;
+
+protected:
+	~BundleIndex();
+		/// Destroys the BundleIndex.
+
+	bool read(std::istream& istr);
+	void write(std::ostream& ostr) const;
+	BundleStorage::Ptr scan(const std::string& path, Poco::UInt64 size, Poco::Timestamp::TimeVal modified);
+
+	static bool directoryChecksum(const std::string& path, Poco::UInt64 size, Poco::UInt32& checksum);
+		/// Computes the CRC-32 checksum of the central directory
+		/// of the given Zip file. Returns false if the central
+		/// directory cannot be located.
+
+private:
+	BundleIndex();
+	BundleIndex(const BundleIndex&);
+	BundleIndex& operator = (const BundleIndex&);
+
+	typedef std::map<std::string, EntryPtr> EntryMap;
+
+	std::string _path;
+	EntryMap _entries;
+	bool _changed;
+	int _hits;
+	int _misses;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline const std::string& BundleIndex::path() const
+{
+	return _path;
+}
+
+
+} } // namespace Poco::OSP
+
+
+#endif // OSP_BundleIndex_INCLUDED
@@ -106,6 +106,13 @@ public:
 		/// and the Bundle's state is BUNDLE_INSTALLED.
 		/// The bundle is not added to the bundle map.
 
+	Bundle::Ptr createBundle(BundleStorage::Ptr pStorage);
+		/// Creates a bundle from the given BundleStorage.
+		///
+		/// A new Bundle object is created for the bundle,
+		/// and the Bundle's state is BUNDLE_INSTALLED.
+		/// The bundle is not added to the bundle map.
+
 	Bundle::Ptr loadBundle(const std::string& path);
 		/// Loads a bundle from the given path.
 		/// A new Bundle object is created for the bundle,
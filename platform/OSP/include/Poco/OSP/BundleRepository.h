@@ -21,6 +21,7 @@
 #include "Poco/OSP/OSP.h"
 #include "Poco/OSP/Bundle.h"
 #include "Poco/OSP/BundleFilter.h"
+#include "Poco/OSP/BundleIndex.h"
 #include "Poco/Logger.h"
 #include <vector>
 #include <map>
@@ -84,7 +85,20 @@ public:
 		/// If two or more versions of a bundle are found,
 		/// the latest version of the bundle is loaded
 		/// and a warning message is logged.
+		///
+		/// If a BundleIndex has been set, the index is loaded
+		/// first and bundle files with a valid index entry are
+		/// loaded from the index, without being scanned. The
+		/// updated index is saved after all bundles have been loaded.
 		
+	void setIndex(BundleIndex::Ptr pIndex);
+		/// Sets the BundleIndex used by loadBundles().
+		/// Specify a null pointer to disable the index.
+
+	BundleIndex::Ptr getIndex() const;
+		/// Returns the BundleIndex used by loadBundles(),
+		/// or a null pointer if no index is used.
+
 	Bundle::Ptr installBundle(std::istream& istr);
 		/// Reads a bundle archive file from the given stream
 		/// and installs it in the primary path.
@@ -179,6 +193,7 @@ private:
 	std::vector<std::string> _paths;
 	BundleLoader&            _loader;
 	BundleFilter::Ptr        _pFilter;
+	BundleIndex::Ptr         _pIndex;
 	Poco::Logger&            _logger;
 };
 
@@ -192,6 +207,12 @@ inline const std::vector<std::string>& BundleRepository::paths() const
 }
 
 
+inline BundleIndex::Ptr BundleRepository::getIndex() const
+{
+	return _pIndex;
+}
+
+
 } } // namespace Poco::OSP
 
 
@@ -54,6 +54,9 @@ class OSP_API OSPSubsystem: public Poco::Util::Subsystem
 	///   - osp.sharedCodeCache:     allow using the same code cache directory for
 	///                              multiple processes, causing certain operations
 	///                              to be guarded by a global lock
+	///   - osp.useBundleIndex:      keep an index of all bundle files (stored
+	///                              in the code cache directory) to speed up
+	///                              loading bundles at startup (defaults to true)
 	///   - osp.language:            language used for localization (overrides
 	///                              the system default)
 	///   - osp.data                 the directory where temporary and persistent
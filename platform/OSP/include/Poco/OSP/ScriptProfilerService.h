@@ -0,0 +1,95 @@
+//
+// ScriptProfilerService.h
+//
+// Library: OSP
+// Package: Service
+// Module:  ScriptProfilerService
+//
+// Definition of the ScriptProfilerService service interface class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef OSP_ScriptProfilerService_INCLUDED
+#define OSP_ScriptProfilerService_INCLUDED
+
+
+#include "Poco/OSP/Service.h"
+#include "Poco/AutoPtr.h"
+#include <ostream>
+
+
+namespace Poco {
+namespace OSP {
+
+
+class OSP_API ScriptProfilerService: public Poco::OSP::Service
+	/// The ScriptProfilerService allows to start and stop a CPU
+	/// profiler for the scripts with a given URI, e.g. a bundle's
+	/// script or a servlet. If the URI ends with a slash, all scripts
+	/// with URIs starting with that URI (e.g., all scripts of a bundle,
+	/// "bndl://com.example.bundle/") are profiled.
+	///
+	/// The profiles recorded by the last stop() call for a
+	/// URI are kept and can be written with writeProfiles().
+	///
+	/// This is a service interface only. The implementation is
+	/// provided by the bundle hosting the script engine, so that
+	/// users of the service do not depend on the script engine.
+{
+public:
+	typedef Poco::AutoPtr<ScriptProfilerService> Ptr;
+
+	enum ProfileFormat
+	{
+		FORMAT_CPUPROFILE,
+			/// Chrome DevTools (.cpuprofile) format. This format
+			/// can hold a single profile only. If more than one
+			/// profile has been recorded for a URI, the first one
+			/// is written.
+		FORMAT_COLLAPSED_STACKS
+			/// Collapsed stacks, the input format for flame graph tools.
+			/// All profiles recorded for a URI are written.
+	};
+
+	ScriptProfilerService();
+		/// Creates the ScriptProfilerService.
+
+	~ScriptProfilerService();
+		/// Destroys the ScriptProfilerService.
+
+	virtual std::size_t start(const std::string& uri, int samplingInterval = 0) = 0;
+		/// Starts profiling all scripts with the given URI, using the given
+		/// sampling interval (in microseconds), or the default sampling interval
+		/// if 0. Returns the number of scripts being profiled.
+
+	virtual std::size_t stop(const std::string& uri) = 0;
+		/// Stops profiling all scripts with the given URI.
+		/// The recorded profiles replace any previously
+		/// recorded profiles for the URI.
+		/// Returns the number of profiles recorded.
+
+	virtual std::size_t writeProfiles(const std::string& uri, ProfileFormat format, std::ostream& ostr) const = 0;
+		/// Writes the profiles recorded by the last call to stop()
+		/// for the given URI to the given stream, using the given format.
+		/// Returns the number of profiles available for the URI.
+		/// Nothing is written if no profiles are available.
+
+	virtual std::size_t profileCount(const std::string& uri) const = 0;
+		/// Returns the number of profiles recorded by the last call
+		/// to stop() for the given URI.
+
+	// Service
+	const std::type_info& type() const;
+	bool isA(const std::type_info& otherType) const;
+};
+
+
+} } // namespace Poco::OSP
+
+
+#endif // OSP_ScriptProfilerService_INCLUDED
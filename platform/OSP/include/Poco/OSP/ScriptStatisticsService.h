@@ -0,0 +1,103 @@
+//
+// ScriptStatisticsService.h
+//
+// Library: OSP
+// Package: Service
+// Module:  ScriptStatisticsService
+//
+// Definition of the ScriptStatisticsService service interface class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef OSP_ScriptStatisticsService_INCLUDED
+#define OSP_ScriptStatisticsService_INCLUDED
+
+
+#include "Poco/OSP/Service.h"
+#include "Poco/AutoPtr.h"
+#include <vector>
+
+
+namespace Poco {
+namespace OSP {
+
+
+class OSP_API ScriptStatisticsService: public Poco::OSP::Service
+	/// The ScriptStatisticsService provides access to the runtime
+	/// statistics (script execution time, number of callbacks,
+	/// timer lag, heap usage and garbage collection pauses)
+	/// of all scripts running in the application.
+	///
+	/// This is a service interface only. The implementation is
+	/// provided by the bundle hosting the script engine, so that
+	/// users of the service do not depend on the script engine.
+{
+public:
+	typedef Poco::AutoPtr<ScriptStatisticsService> Ptr;
+
+	struct Statistics
+		/// Runtime statistics of a single script.
+		///
+		/// All times are in microseconds, all memory sizes in bytes.
+	{
+		Statistics();
+
+		std::string uri;
+			/// The script's source URI.
+		Poco::UInt64 callbacks;
+			/// Number of times script code has been entered.
+		Poco::UInt64 scriptTime;
+			/// Cumulative CPU time spent executing script code.
+		Poco::UInt64 scriptTimeMax;
+			/// Largest CPU time used by a single execution of script code.
+		Poco::UInt64 timerCallbacks;
+			/// Number of timer callbacks run.
+		Poco::UInt64 timerLagTotal;
+			/// Cumulative delay between the scheduled and actual start
+			/// of timer callbacks.
+		Poco::UInt64 timerLagMax;
+			/// Longest delay between the scheduled and actual start
+			/// of a timer callback.
+		Poco::UInt64 gcCount;
+			/// Number of garbage collection pauses.
+		Poco::UInt64 gcTime;
+			/// Cumulative CPU time spent in garbage collection pauses.
+		Poco::UInt64 gcTimeMax;
+			/// Largest CPU time used by a single garbage collection pause.
+		Poco::UInt64 heapTotal;
+			/// Total size of the heap.
+		Poco::UInt64 heapUsed;
+			/// Used size of the heap.
+		Poco::UInt64 heapLimit;
+			/// Size limit of the heap.
+		Poco::UInt64 mallocedMemory;
+			/// Memory allocated outside of the heap.
+		bool profiling;
+			/// True if the script is being profiled.
+	};
+
+	ScriptStatisticsService();
+		/// Creates the ScriptStatisticsService.
+
+	~ScriptStatisticsService();
+		/// Destroys the ScriptStatisticsService.
+
+	virtual void statistics(std::vector<Statistics>& statistics) const = 0;
+		/// Returns the runtime statistics of all currently
+		/// running scripts.
+
+	// Service
+	const std::type_info& type() const;
+	bool isA(const std::type_info& otherType) const;
+};
+
+
+} } // namespace Poco::OSP
+
+
+#endif // OSP_ScriptStatisticsService_INCLUDED
@@ -47,6 +47,12 @@ Bundle* BundleFactory::createBundle(BundleLoader& loader, const std::string& pat
 	else
 		throw BundleLoadException("Attempted to load a bundle from something that is neither a file nor a directory", path);
 		
+	return createBundle(loader, pStorage);
+}
+
+
+Bundle* BundleFactory::createBundle(BundleLoader& loader, BundleStorage::Ptr pStorage)
+{
 	return new Bundle(loader.nextBundleId(), loader, pStorage, _language);
 }
 
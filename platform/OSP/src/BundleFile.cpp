@@ -156,6 +156,14 @@ std::string BundleFile::path() const
 }
 
 
+const ZipArchive& BundleFile::archive() const
+{
+	poco_assert (_pArchive);
+
+	return *_pArchive;
+}
+
+
 bool BundleFile::isSubdirectoryOf(const std::string& dir, const std::string& parent) const
 {
 	if (dir.size() > parent.size())
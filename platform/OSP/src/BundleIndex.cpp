@@ -0,0 +1,514 @@
+//
+// BundleIndex.cpp
+//
+// Library: OSP
+// Package: Bundle
+// Module:  BundleIndex
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/OSP/BundleIndex.h"
+#include "Poco/OSP/BundleFile.h"
+#include "Poco/Zip/ZipArchive.h"
+#include "Poco/BinaryReader.h"
+#include "Poco/BinaryWriter.h"
+#include "Poco/Checksum.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/FileStream.h"
+#include "Poco/Process.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Buffer.h"
+#include "Poco/MemoryStream.h"
+#include "Poco/Path.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
+#include <sstream>
+#include <set>
+#include <memory>
+
+
+using Poco::Path;
+using Poco::File;
+using Poco::BinaryReader;
+using Poco::BinaryWriter;
+using Poco::Zip::ZipArchive;
+
+
+namespace Poco {
+namespace OSP {
+
+
+namespace
+{
+	const Poco::UInt32 INDEX_MAGIC   = 0x4F534249; // "OSBI"
+	const Poco::UInt32 INDEX_VERSION = 1;
+
+	const Poco::UInt32 EOCD_SIGNATURE  = 0x06054B50;
+	const std::size_t  EOCD_SIZE       = 22;
+	const std::size_t  EOCD_MAX_SEARCH = EOCD_SIZE + 65535;
+
+	Poco::UInt32 readUInt32LE(const char* p)
+	{
+		const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+		return u[0] | (u[1] << 8) | (u[2] << 16) | (static_cast<Poco::UInt32>(u[3]) << 24);
+	}
+
+	bool isSubdirectoryOf(const std::string& dir, const std::string& parent)
+	{
+		if (dir.size() > parent.size())
+			return dir.compare(0, parent.size(), parent) == 0;
+		else
+			return false;
+	}
+
+	void readString(BinaryReader& reader, std::string& value)
+		/// Reads a string written with BinaryWriter::operator << (const std::string&),
+		/// without going through the stream for every single character.
+	{
+		Poco::UInt32 size = 0;
+		reader.read7BitEncoded(size);
+		value.resize(size);
+		if (size > 0) reader.readRaw(&value[0], size);
+	}
+
+	class IndexedBundleFile: public BundleStorage
+		/// The BundleStorage for a bundle file that has a valid
+		/// entry in the BundleIndex.
+	{
+	public:
+		typedef BundleIndex::FileEntry FileEntry;
+		typedef BundleIndex::Entry::Files Files;
+
+		IndexedBundleFile(const std::string& path, BundleIndex::EntryPtr pEntry):
+			_path(path),
+			_pEntry(pEntry)
+		{
+		}
+
+		std::istream* getResource(const std::string& path) const
+		{
+			BundleIndex::Entry::Resources::const_iterator itRes = _pEntry->resources.find(path);
+			if (itRes != _pEntry->resources.end())
+				return new std::istringstream(itRes->second);
+
+			Files::const_iterator it = _pEntry->files.find(path);
+			if (it != _pEntry->files.end() && (it->second.flags & FileEntry::HAS_HEADER) && (it->second.flags & FileEntry::IS_FILE))
+				return bundleFile().getResource(path);
+			else
+				return 0;
+		}
+
+		void list(const std::string& path, std::vector<std::string>& files) const
+		{
+			// same as BundleFile::list(), but using the index entry
+			files.clear();
+			int depth = 0;
+			std::string parent;
+			if (!path.empty())
+			{
+				Path parentPath(path, Path::PATH_UNIX);
+				parentPath.makeDirectory();
+				parent = parentPath.toString(Path::PATH_UNIX);
+			}
+			Files::const_iterator it;
+			Files::const_iterator end(_pEntry->files.end());
+			if (path.empty())
+			{
+				it = _pEntry->files.begin();
+			}
+			else
+			{
+				it = _pEntry->files.find(parent);
+				if (it != end && (it->second.flags & FileEntry::HAS_HEADER))
+					++it;
+				else
+					it = end;
+				depth = Path(parent).depth();
+			}
+
+			std::set<std::string> fileSet;
+			while (it != end && isSubdirectoryOf(it->first, parent))
+			{
+				if (it->second.flags & FileEntry::HAS_HEADER)
+				{
+					Path p(it->first, Path::PATH_UNIX);
+					p.makeFile();
+					if (p.depth() == depth)
+					{
+						std::string name = p.getFileName();
+						if (fileSet.find(name) == fileSet.end())
+						{
+							files.push_back(name);
+							fileSet.insert(name);
+						}
+					}
+				}
+				++it;
+			}
+		}
+
+		Poco::Timestamp lastModified(const std::string& path) const
+		{
+			Files::const_iterator it = _pEntry->files.find(path);
+			if (it != _pEntry->files.end() && (it->second.flags & FileEntry::HAS_INFO))
+				return Poco::Timestamp(it->second.modified);
+			else
+				throw Poco::NotFoundException(path);
+		}
+
+		std::string path() const
+		{
+			return _path;
+		}
+
+	protected:
+		~IndexedBundleFile()
+		{
+		}
+
+		BundleStorage& bundleFile() const
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (!_pBundleFile) _pBundleFile = new BundleFile(_path);
+			return *_pBundleFile;
+		}
+
+	private:
+		std::string _path;
+		BundleIndex::EntryPtr _pEntry;
+		mutable BundleStorage::Ptr _pBundleFile;
+		mutable Poco::FastMutex _mutex;
+	};
+}
+
+
+BundleIndex::Entry::Entry():
+	size(0),
+	modified(0),
+	directoryChecksum(0),
+	used(false)
+{
+}
+
+
+BundleIndex::BundleIndex(const std::string& path):
+	_path(path),
+	_changed(false),
+	_hits(0),
+	_misses(0)
+{
+}
+
+
+BundleIndex::~BundleIndex()
+{
+}
+
+
+bool BundleIndex::load()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_entries.clear();
+	_changed = false;
+	_hits = 0;
+	_misses = 0;
+	File f(_path);
+	if (!f.exists()) return false;
+
+	bool ok = false;
+	try
+	{
+		Poco::FileInputStream istr(_path);
+		ok = read(istr);
+	}
+	catch (Poco::Exception&)
+	{
+	}
+	if (!ok)
+	{
+		_entries.clear();
+		_changed = true;
+	}
+	return ok;
+}
+
+
+void BundleIndex::save()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end();)
+	{
+		if (!it->second->used)
+		{
+			_entries.erase(it++);
+			_changed = true;
+		}
+		else ++it;
+	}
+	if (!_changed) return;
+
+	Path indexDir(_path);
+	indexDir.setFileName("");
+	if (!indexDir.toString().empty())
+	{
+		File(indexDir).createDirectories();
+	}
+	std::string tempPath(_path);
+	tempPath += ".";
+	tempPath += Poco::NumberFormatter::format(Poco::Process::id());
+	try
+	{
+		Poco::FileOutputStream ostr(tempPath);
+		write(ostr);
+		ostr.close();
+		if (!ostr.good()) throw Poco::WriteFileException(tempPath);
+		File(tempPath).renameTo(_path);
+	}
+	catch (...)
+	{
+		try
+		{
+			File(tempPath).remove();
+		}
+		catch (...)
+		{
+		}
+		throw;
+	}
+	_changed = false;
+}
+
+
+BundleStorage::Ptr BundleIndex::storageFor(const std::string& path)
+{
+	File f(path);
+	if (!f.isFile()) return 0;
+
+	Poco::UInt64 size = f.getSize();
+	Poco::Timestamp::TimeVal modified = f.getLastModified().epochMicroseconds();
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	EntryMap::iterator it = _entries.find(path);
+	if (it != _entries.end() && it->second->size == size && it->second->modified == modified)
+	{
+		Poco::UInt32 checksum;
+		if (directoryChecksum(path, size, checksum) && checksum == it->second->directoryChecksum)
+		{
+			it->second->used = true;
+			_hits++;
+			return new IndexedBundleFile(path, it->second);
+		}
+	}
+	_misses++;
+	return scan(path, size, modified);
+}
+
+
+int BundleIndex::hits() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _hits;
+}
+
+
+int BundleIndex::misses() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _misses;
+}
+
+
+bool BundleIndex::isCachedResource(const std::string& path)
+{
+	std::string::size_type pos = path.rfind('/');
+	std::string name(path, pos == std::string::npos ? 0 : pos + 1);
+	return path == "META-INF/manifest.mf" || name == "bundle.properties" || name == "extensions.xml";
+}
+
+
+BundleStorage::Ptr BundleIndex::scan(const std::string& path, Poco::UInt64 size, Poco::Timestamp::TimeVal modified)
+{
+	_entries.erase(path);
+	_changed = true;
+
+	Poco::AutoPtr<BundleFile> pBundleFile = new BundleFile(path);
+	EntryPtr pEntry = new Entry;
+	pEntry->size = size;
+	pEntry->modified = modified;
+	pEntry->used = true;
+	if (!directoryChecksum(path, size, pEntry->directoryChecksum)) return pBundleFile;
+
+	const ZipArchive& archive = pBundleFile->archive();
+	for (ZipArchive::FileHeaders::const_iterator it = archive.headerBegin(); it != archive.headerEnd(); ++it)
+	{
+		FileEntry& file = pEntry->files[it->first];
+		file.flags = FileEntry::HAS_HEADER;
+		file.modified = 0;
+		if (it->second.isFile())
+		{
+			file.flags |= FileEntry::IS_FILE;
+			if (isCachedResource(it->first) && it->second.getUncompressedSize() <= MAX_CACHED_RESOURCE_SIZE)
+			{
+#if __cplusplus < 201103L
+				std::auto_ptr<std::istream> pStream(pBundleFile->getResource(it->first));
+#else
+				std::unique_ptr<std::istream> pStream(pBundleFile->getResource(it->first));
+#endif
+				if (pStream.get())
+				{
+					Poco::StreamCopier::copyToString(*pStream, pEntry->resources[it->first]);
+				}
+			}
+		}
+	}
+	for (ZipArchive::FileInfos::const_iterator it = archive.fileInfoBegin(); it != archive.fileInfoEnd(); ++it)
+	{
+		Entry::Files::iterator itFile = pEntry->files.find(it->first);
+		if (itFile == pEntry->files.end())
+		{
+			itFile = pEntry->files.insert(Entry::Files::value_type(it->first, FileEntry())).first;
+			itFile->second.flags = 0;
+		}
+		itFile->second.flags |= FileEntry::HAS_INFO;
+		itFile->second.modified = it->second.lastModifiedAt().timestamp().epochMicroseconds();
+	}
+	_entries[path] = pEntry;
+	return pBundleFile;
+}
+
+
+bool BundleIndex::read(std::istream& istr)
+{
+	BinaryReader reader(istr, BinaryReader::NETWORK_BYTE_ORDER);
+	Poco::UInt32 magic = 0;
+	Poco::UInt32 version = 0;
+	Poco::UInt32 bodySize = 0;
+	reader >> magic >> version >> bodySize;
+	if (!reader.good() || magic != INDEX_MAGIC || version != INDEX_VERSION) return false;
+	if (bodySize > File(_path).getSize()) return false;
+
+	std::string body(bodySize, '\0');
+	if (bodySize > 0) reader.readRaw(&body[0], bodySize);
+	Poco::UInt32 checksum = 0;
+	reader >> checksum;
+	if (!reader.good()) return false;
+
+	Poco::Checksum crc(Poco::Checksum::TYPE_CRC32);
+	crc.update(body);
+	if (crc.checksum() != checksum) return false;
+
+	Poco::MemoryInputStream bodyStream(body.data(), body.size());
+	BinaryReader bodyReader(bodyStream, BinaryReader::NETWORK_BYTE_ORDER);
+	Poco::UInt32 count = 0;
+	bodyReader >> count;
+	for (Poco::UInt32 i = 0; i < count && bodyReader.good(); i++)
+	{
+		std::string bundlePath;
+		EntryPtr pEntry = new Entry;
+		Poco::UInt32 n = 0;
+		readString(bodyReader, bundlePath);
+		bodyReader >> pEntry->size >> pEntry->modified >> pEntry->directoryChecksum;
+		bodyReader >> n;
+		std::string name;
+		for (Poco::UInt32 k = 0; k < n && bodyReader.good(); k++)
+		{
+			FileEntry file;
+			readString(bodyReader, name);
+			bodyReader >> file.flags >> file.modified;
+			pEntry->files.insert(pEntry->files.end(), Entry::Files::value_type(name, file));
+		}
+		bodyReader >> n;
+		for (Poco::UInt32 k = 0; k < n && bodyReader.good(); k++)
+		{
+			readString(bodyReader, name);
+			readString(bodyReader, pEntry->resources[name]);
+		}
+		_entries[bundlePath] = pEntry;
+	}
+	return bodyReader.good();
+}
+
+
+void BundleIndex::write(std::ostream& ostr) const
+{
+	std::ostringstream bodyStream;
+	BinaryWriter bodyWriter(bodyStream, BinaryWriter::NETWORK_BYTE_ORDER);
+	bodyWriter << static_cast<Poco::UInt32>(_entries.size());
+	for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it)
+	{
+		const Entry& entry = *it->second;
+		bodyWriter << it->first << entry.size << entry.modified << entry.directoryChecksum;
+		bodyWriter << static_cast<Poco::UInt32>(entry.files.size());
+		for (Entry::Files::const_iterator itF = entry.files.begin(); itF != entry.files.end(); ++itF)
+		{
+			bodyWriter << itF->first << itF->second.flags << itF->second.modified;
+		}
+		bodyWriter << static_cast<Poco::UInt32>(entry.resources.size());
+		for (Entry::Resources::const_iterator itR = entry.resources.begin(); itR != entry.resources.end(); ++itR)
+		{
+			bodyWriter << itR->first << itR->second;
+		}
+	}
+	bodyWriter.flush();
+	std::string body = bodyStream.str();
+
+	Poco::Checksum crc(Poco::Checksum::TYPE_CRC32);
+	crc.update(body);
+
+	BinaryWriter writer(ostr, BinaryWriter::NETWORK_BYTE_ORDER);
+	writer << INDEX_MAGIC << INDEX_VERSION << static_cast<Poco::UInt32>(body.size());
+	writer.writeRaw(body);
+	writer << crc.checksum();
+	writer.flush();
+}
+
+
+bool BundleIndex::directoryChecksum(const std::string& path, Poco::UInt64 size, Poco::UInt32& checksum)
+{
+	if (size < EOCD_SIZE) return false;
+
+	std::size_t tailSize = static_cast<std::size_t>(size < EOCD_MAX_SEARCH ? size : EOCD_MAX_SEARCH);
+	Poco::Buffer<char> tail(tailSize);
+	Poco::FileInputStream istr(path);
+	istr.seekg(static_cast<std::streamoff>(size - tailSize));
+	istr.read(tail.begin(), static_cast<std::streamsize>(tailSize));
+	if (istr.gcount() != static_cast<std::streamsize>(tailSize)) return false;
+
+	// search backwards for the end of central directory record
+	for (std::size_t pos = tailSize - EOCD_SIZE + 1; pos-- > 0;)
+	{
+		if (readUInt32LE(tail.begin() + pos) == EOCD_SIGNATURE)
+		{
+			Poco::UInt32 directorySize   = readUInt32LE(tail.begin() + pos + 12);
+			Poco::UInt32 directoryOffset = readUInt32LE(tail.begin() + pos + 16);
+			if (directorySize == 0xFFFFFFFF || directoryOffset == 0xFFFFFFFF) return false; // Zip64
+			if (static_cast<Poco::UInt64>(directoryOffset) + directorySize > size) return false;
+
+			Poco::Buffer<char> directory(directorySize);
+			istr.clear();
+			istr.seekg(directoryOffset);
+			istr.read(directory.begin(), directorySize);
+			if (istr.gcount() != static_cast<std::streamsize>(directorySize)) return false;
+
+			Poco::Checksum crc(Poco::Checksum::TYPE_CRC32);
+			crc.update(directory.begin(), directorySize);
+			checksum = crc.checksum();
+			return true;
+		}
+	}
+	return false;
+}
+
+
+} } // namespace Poco::OSP
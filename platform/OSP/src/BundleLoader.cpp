@@ -125,6 +125,12 @@ Bundle::Ptr BundleLoader::createBundle(const std::string& path)
 }
 
 
+Bundle::Ptr BundleLoader::createBundle(BundleStorage::Ptr pStorage)
+{
+	return _pBundleFactory->createBundle(*this, pStorage);
+}
+
+
 Bundle::Ptr BundleLoader::loadBundle(const std::string& path)
 {
 	Bundle::Ptr pBundle(createBundle(path));
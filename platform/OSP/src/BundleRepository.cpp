@@ -26,6 +26,7 @@
 #include "Poco/Mutex.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/String.h"
+#include "Poco/Format.h"
 #include "Poco/Exception.h"
 #include <map>
 #include <set>
@@ -81,6 +82,11 @@ BundleRepository::~BundleRepository()
 
 void BundleRepository::loadBundles()
 {
+	if (_pIndex && !_pIndex->load())
+	{
+		_logger.information(std::string("Bundle index not found or invalid, scanning all bundles: ") + _pIndex->path());
+	}
+
 	BundleMap bundles;
 	for (std::vector<std::string>::const_iterator it = _paths.begin(); it != _paths.end(); ++it)
 	{
@@ -109,6 +115,28 @@ void BundleRepository::loadBundles()
 				+ it->second->version().toString());
 		}
 	}
+
+	if (_pIndex)
+	{
+		if (_logger.information())
+		{
+			_logger.information(Poco::format("Bundle index: %d bundle(s) loaded from index, %d bundle(s) scanned", _pIndex->hits(), _pIndex->misses()));
+		}
+		try
+		{
+			_pIndex->save();
+		}
+		catch (Poco::Exception& exc)
+		{
+			_logger.warning(std::string("Failed to save bundle index: ") + exc.displayText());
+		}
+	}
+}
+
+
+void BundleRepository::setIndex(BundleIndex::Ptr pIndex)
+{
+	_pIndex = pIndex;
 }
 
 
@@ -194,7 +222,13 @@ void BundleRepository::loadBundles(const std::string& path, BundleMap& bundles)
 
 void BundleRepository::loadBundle(const std::string& path, BundleMap& bundles)
 {
-	Bundle::Ptr pBundle(_loader.createBundle(path));
+	Bundle::Ptr pBundle;
+	BundleStorage::Ptr pStorage;
+	if (_pIndex) pStorage = _pIndex->storageFor(path);
+	if (pStorage)
+		pBundle = _loader.createBundle(pStorage);
+	else
+		pBundle = _loader.createBundle(path);
 
 	if (_pFilter && !_pFilter->accept(pBundle))
 	{
@@ -0,0 +1,81 @@
+//
+// CredentialCache.cpp
+//
+// Library: OSP
+// Package: Auth
+// Module:  CredentialCache
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/OSP/Auth/CredentialCache.h"
+#include "Poco/HMACEngine.h"
+#include "Poco/SHA1Engine.h"
+#include "Poco/RandomStream.h"
+#include "Poco/ByteOrder.h"
+
+
+namespace Poco {
+namespace OSP {
+namespace Auth {
+
+
+CredentialCache::CredentialCache(long size, int expireSeconds):
+	_cache(size, static_cast<Poco::Timestamp::TimeDiff>(expireSeconds)*1000)
+{
+	Poco::RandomInputStream ris;
+	for (int i = 0; i < Poco::SHA1Engine::DIGEST_SIZE; i++)
+	{
+		_secret += static_cast<char>(ris.get());
+	}
+}
+
+
+CredentialCache::~CredentialCache()
+{
+}
+
+
+bool CredentialCache::verified(const std::string& userName, const std::string& credentials) const
+{
+	Poco::SharedPtr<std::string> pUserName = _cache.get(key(userName, credentials));
+	return pUserName && *pUserName == userName;
+}
+
+
+void CredentialCache::add(const std::string& userName, const std::string& credentials)
+{
+	_cache.add(key(userName, credentials), userName);
+}
+
+
+void CredentialCache::clear()
+{
+	_cache.clear();
+}
+
+
+std::size_t CredentialCache::size() const
+{
+	return _cache.size();
+}
+
+
+std::string CredentialCache::key(const std::string& userName, const std::string& credentials) const
+{
+	Poco::HMACEngine<Poco::SHA1Engine> hmac(_secret);
+	// the length prefix makes the key unambiguous for any user name
+	Poco::UInt32 length = Poco::ByteOrder::toNetwork(static_cast<Poco::UInt32>(userName.size()));
+	hmac.update(&length, sizeof(length));
+	hmac.update(userName);
+	hmac.update(credentials);
+	const Poco::DigestEngine::Digest& digest = hmac.digest();
+	return std::string(digest.begin(), digest.end());
+}
+
+
+} } } // namespace Poco::OSP::Auth
@@ -80,6 +80,7 @@ void OSPSubsystem::initialize(Poco::Util::Application& app)
 	std::string dataPath         = app.config().getString("osp.data", app.config().expand("${application.dir}data"));
 	bool autoUpdateCodeCache     = app.config().getBool("osp.autoUpdateCodeCache", true);
 	bool sharedCodeCache         = app.config().getBool("osp.sharedCodeCache", false);
+	bool useBundleIndex          = app.config().getBool("osp.useBundleIndex", true);
 
 	if (!_bundles.empty())
 	{
@@ -114,6 +115,10 @@ void OSPSubsystem::initialize(Poco::Util::Application& app)
 	BundleContextFactory::Ptr pBundleContextFactory(new BundleContextFactory(*_pServiceRegistry, _systemEvents, dataPath));
 	_pBundleLoader     = new BundleLoader(*_pCodeCache, pBundleFactory, pBundleContextFactory, autoUpdateCodeCache);
 	_pBundleRepository = new BundleRepository(bundleRepository, *_pBundleLoader, _pBundleFilter);
+	if (useBundleIndex)
+	{
+		_pBundleRepository->setIndex(new BundleIndex(_pCodeCache->pathFor("bundles.idx", false)));
+	}
 	
 	BundleStreamFactory::registerFactory(*_pBundleLoader);
 	
@@ -0,0 +1,156 @@
+//
+// PasswordHash.cpp
+//
+// Library: OSP
+// Package: Auth
+// Module:  PasswordHash
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/OSP/Auth/PasswordHash.h"
+#include "Poco/PBKDF2Engine.h"
+#include "Poco/HMACEngine.h"
+#include "Poco/SHA1Engine.h"
+#include "Poco/RandomStream.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+namespace OSP {
+namespace Auth {
+
+
+const std::string PasswordHash::SCHEME("$pbkdf2-sha1$");
+
+
+namespace
+{
+	typedef Poco::PBKDF2Engine<Poco::HMACEngine<Poco::SHA1Engine> > PBKDF2SHA1Engine;
+
+	std::string hexToBinary(const std::string& hex)
+	{
+		if (hex.size() % 2 != 0) throw Poco::DataFormatException("Odd number of hex digits");
+
+		std::string result;
+		result.reserve(hex.size()/2);
+		for (std::string::size_type i = 0; i < hex.size(); i += 2)
+		{
+			unsigned value;
+			if (!Poco::NumberParser::tryParseHex(hex.substr(i, 2), value))
+				throw Poco::DataFormatException("Invalid hex digit");
+			result += static_cast<char>(value);
+		}
+		return result;
+	}
+
+	std::string binaryToHex(const std::string& binary)
+	{
+		return Poco::DigestEngine::digestToHex(Poco::DigestEngine::Digest(binary.begin(), binary.end()));
+	}
+
+	std::string derive(const std::string& password, const std::string& salt, int iterations)
+	{
+		PBKDF2SHA1Engine pbkdf2(salt, static_cast<unsigned>(iterations));
+		pbkdf2.update(password);
+		const Poco::DigestEngine::Digest& digest = pbkdf2.digest();
+		return std::string(digest.begin(), digest.end());
+	}
+}
+
+
+std::string PasswordHash::create(const std::string& password, int iterations)
+{
+	std::string salt;
+	salt.reserve(SALT_LENGTH);
+	Poco::RandomInputStream ris;
+	for (int i = 0; i < SALT_LENGTH; i++)
+	{
+		salt += static_cast<char>(ris.get());
+	}
+	return create(password, salt, iterations);
+}
+
+
+std::string PasswordHash::create(const std::string& password, const std::string& salt, int iterations)
+{
+	if (iterations < MIN_ITERATIONS || iterations > MAX_ITERATIONS)
+		throw Poco::InvalidArgumentException("Iteration count out of range", Poco::NumberFormatter::format(iterations));
+	if (salt.empty())
+		throw Poco::InvalidArgumentException("Empty salt");
+
+	std::string hash(SCHEME);
+	Poco::NumberFormatter::append(hash, iterations);
+	hash += '$';
+	hash += binaryToHex(salt);
+	hash += '$';
+	hash += binaryToHex(derive(password, salt, iterations));
+	return hash;
+}
+
+
+bool PasswordHash::verify(const std::string& password, const std::string& hash)
+{
+	int iterations;
+	std::string salt;
+	std::string digest;
+	if (!parse(hash, iterations, salt, digest)) return false;
+
+	return equals(derive(password, salt, iterations), digest);
+}
+
+
+bool PasswordHash::isPasswordHash(const std::string& hash)
+{
+	int iterations;
+	std::string salt;
+	std::string digest;
+	return parse(hash, iterations, salt, digest);
+}
+
+
+bool PasswordHash::equals(const std::string& s1, const std::string& s2)
+{
+	if (s1.size() != s2.size()) return false;
+
+	unsigned char diff = 0;
+	for (std::string::size_type i = 0; i < s1.size(); i++)
+	{
+		diff |= static_cast<unsigned char>(s1[i] ^ s2[i]);
+	}
+	return diff == 0;
+}
+
+
+bool PasswordHash::parse(const std::string& hash, int& iterations, std::string& salt, std::string& digest)
+{
+	if (hash.compare(0, SCHEME.size(), SCHEME) != 0) return false;
+
+	std::string::size_type pos1 = hash.find('$', SCHEME.size());
+	if (pos1 == std::string::npos) return false;
+	std::string::size_type pos2 = hash.find('$', pos1 + 1);
+	if (pos2 == std::string::npos) return false;
+
+	if (!Poco::NumberParser::tryParse(hash.substr(SCHEME.size(), pos1 - SCHEME.size()), iterations)) return false;
+	if (iterations < MIN_ITERATIONS || iterations > MAX_ITERATIONS) return false;
+
+	try
+	{
+		salt = hexToBinary(hash.substr(pos1 + 1, pos2 - pos1 - 1));
+		digest = hexToBinary(hash.substr(pos2 + 1));
+	}
+	catch (Poco::DataFormatException&)
+	{
+		return false;
+	}
+	return !salt.empty() && digest.size() == PBKDF2SHA1Engine::PRF_DIGEST_SIZE;
+}
+
+
+} } } // namespace Poco::OSP::Auth
@@ -0,0 +1,45 @@
+//
+// ScriptProfilerService.cpp
+//
+// Library: OSP
+// Package: Service
+// Module:  ScriptProfilerService
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/OSP/ScriptProfilerService.h"
+
+
+namespace Poco {
+namespace OSP {
+
+
+ScriptProfilerService::ScriptProfilerService()
+{
+}
+
+
+ScriptProfilerService::~ScriptProfilerService()
+{
+}
+
+
+const std::type_info& ScriptProfilerService::type() const
+{
+	return typeid(ScriptProfilerService);
+}
+
+
+bool ScriptProfilerService::isA(const std::type_info& otherType) const
+{
+	std::string name(typeid(ScriptProfilerService).name());
+	return name == otherType.name() || Service::isA(otherType);
+}
+
+
+} } // namespace Poco::OSP
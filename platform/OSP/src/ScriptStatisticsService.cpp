@@ -0,0 +1,64 @@
+//
+// ScriptStatisticsService.cpp
+//
+// Library: OSP
+// Package: Service
+// Module:  ScriptStatisticsService
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/OSP/ScriptStatisticsService.h"
+
+
+namespace Poco {
+namespace OSP {
+
+
+ScriptStatisticsService::Statistics::Statistics():
+	callbacks(0),
+	scriptTime(0),
+	scriptTimeMax(0),
+	timerCallbacks(0),
+	timerLagTotal(0),
+	timerLagMax(0),
+	gcCount(0),
+	gcTime(0),
+	gcTimeMax(0),
+	heapTotal(0),
+	heapUsed(0),
+	heapLimit(0),
+	mallocedMemory(0),
+	profiling(false)
+{
+}
+
+
+ScriptStatisticsService::ScriptStatisticsService()
+{
+}
+
+
+ScriptStatisticsService::~ScriptStatisticsService()
+{
+}
+
+
+const std::type_info& ScriptStatisticsService::type() const
+{
+	return typeid(ScriptStatisticsService);
+}
+
+
+bool ScriptStatisticsService::isA(const std::type_info& otherType) const
+{
+	std::string name(typeid(ScriptStatisticsService).name());
+	return name == otherType.name() || Service::isA(otherType);
+}
+
+
+} } // namespace Poco::OSP
@@ -0,0 +1,196 @@
+//
+// AuthBenchmark.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// A benchmark for password verification latency.
+//
+// The benchmark verifies a password the way the SimpleAuth bundle
+// does: with a salted MD5 hash (the previous credential format),
+// with a PBKDF2 hash, and with a PBKDF2 hash and a CredentialCache.
+// The latter represents the steady state of a client sending the
+// same credentials with every request, e.g. using HTTP Basic
+// authentication for REST API calls.
+//
+
+
+#include "Poco/OSP/Auth/PasswordHash.h"
+#include "Poco/OSP/Auth/CredentialCache.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/MD5Engine.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Format.h"
+#include <iostream>
+
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::OptionCallback;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using Poco::OSP::Auth::PasswordHash;
+using Poco::OSP::Auth::CredentialCache;
+
+
+namespace
+{
+	const std::string USER_NAME("admin");
+	const std::string PASSWORD("s3cr3t-passw0rd");
+	const std::string SALT("macchina");
+
+	std::string md5Hash(const std::string& credentials)
+	{
+		Poco::MD5Engine md5;
+		md5.update(SALT);
+		md5.update(credentials);
+		return Poco::DigestEngine::digestToHex(md5.digest());
+	}
+}
+
+
+class AuthBenchmark: public Application
+{
+public:
+	AuthBenchmark():
+		_helpRequested(false),
+		_requests(100000),
+		_iterations(PasswordHash::DEFAULT_ITERATIONS)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<AuthBenchmark>(this, &AuthBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("requests", "n", "Number of authenticated requests per measurement (default 100000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 1000000000))
+				.binding("benchmark.requests"));
+
+		options.addOption(
+			Option("iterations", "i", "PBKDF2 iteration count (default 10000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(PasswordHash::MIN_ITERATIONS, PasswordHash::MAX_ITERATIONS))
+				.binding("benchmark.iterations"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("Benchmark measuring password verification latency.");
+		helpFormatter.format(std::cout);
+	}
+
+	void report(const std::string& what, const Poco::Stopwatch& sw, int requests, int verified)
+	{
+		double us = static_cast<double>(sw.elapsed())/requests;
+		std::cout << Poco::format("%-40s %12.2f", what, us);
+		if (verified != requests) std::cout << Poco::format(" (%d of %d verified)", verified, requests);
+		std::cout << std::endl;
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		_requests = config().getInt("benchmark.requests", _requests);
+		_iterations = config().getInt("benchmark.iterations", _iterations);
+
+		const std::string md5PasswordHash = md5Hash(PASSWORD);
+		const std::string pbkdf2PasswordHash = PasswordHash::create(PASSWORD, _iterations);
+
+		// PBKDF2 without cache is slow, so use fewer requests
+		int uncachedRequests = _requests/1000 > 10 ? _requests/1000 : 10;
+
+		std::cout << Poco::format("PBKDF2 with %d iterations, times in microseconds per request", _iterations) << std::endl;
+
+		Poco::Stopwatch sw;
+		int verified = 0;
+
+		sw.start();
+		for (int i = 0; i < _requests; i++)
+		{
+			if (PasswordHash::equals(md5Hash(PASSWORD), md5PasswordHash)) verified++;
+		}
+		sw.stop();
+		report("salted MD5", sw, _requests, verified);
+
+		verified = 0;
+		sw.restart();
+		for (int i = 0; i < uncachedRequests; i++)
+		{
+			if (PasswordHash::verify(PASSWORD, pbkdf2PasswordHash)) verified++;
+		}
+		sw.stop();
+		report("PBKDF2", sw, uncachedRequests, verified);
+
+		CredentialCache cache;
+		verified = 0;
+		sw.restart();
+		for (int i = 0; i < _requests; i++)
+		{
+			if (cache.verified(USER_NAME, PASSWORD))
+			{
+				verified++;
+			}
+			else if (PasswordHash::verify(PASSWORD, pbkdf2PasswordHash))
+			{
+				cache.add(USER_NAME, PASSWORD);
+				verified++;
+			}
+		}
+		sw.stop();
+		report("PBKDF2 with CredentialCache", sw, _requests, verified);
+
+		verified = 0;
+		sw.restart();
+		for (int i = 0; i < uncachedRequests; i++)
+		{
+			if (cache.verified(USER_NAME, "wrong") || PasswordHash::verify("wrong", pbkdf2PasswordHash)) verified++;
+		}
+		sw.stop();
+		report("PBKDF2 with CredentialCache, wrong", sw, uncachedRequests, uncachedRequests - verified);
+
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+	int _requests;
+	int _iterations;
+};
+
+
+POCO_APP_MAIN(AuthBenchmark)
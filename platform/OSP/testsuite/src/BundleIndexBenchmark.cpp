@@ -0,0 +1,391 @@
+//
+// BundleIndexBenchmark.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// A benchmark for the bundle-related part of the startup time.
+//
+// The benchmark creates a bundle repository with synthetic bundle
+// files, each containing a manifest, a bundle.properties file,
+// an extensions.xml file and a number of other resources. It then
+// measures BundleRepository::loadBundles() without a BundleIndex,
+// with an empty BundleIndex (first start) and with a BundleIndex
+// written by a previous start, followed by the processing of the
+// extensions.xml files by the ExtensionPointService, as done when
+// the bundles are started.
+//
+// Every measurement uses a fresh BundleLoader, BundleIndex and
+// ExtensionPointService, so only the page cache is warm, as it
+// would be on a restart.
+//
+
+
+#include "Poco/OSP/BundleRepository.h"
+#include "Poco/OSP/BundleIndex.h"
+#include "Poco/OSP/BundleLoader.h"
+#include "Poco/OSP/BundleFactory.h"
+#include "Poco/OSP/BundleContextFactory.h"
+#include "Poco/OSP/BundleEvents.h"
+#include "Poco/OSP/BundleEvent.h"
+#include "Poco/OSP/BundleManifest.h"
+#include "Poco/OSP/ExtensionPoint.h"
+#include "Poco/OSP/ExtensionPointService.h"
+#include "Poco/OSP/CodeCache.h"
+#include "Poco/OSP/ServiceRegistry.h"
+#include "Poco/OSP/SystemEvents.h"
+#include "Poco/OSP/LanguageTag.h"
+#include "Poco/DOM/Document.h"
+#include "Poco/DOM/DOMParser.h"
+#include "Poco/SAX/InputSource.h"
+#include "Poco/Zip/Compress.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/DateTime.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Logger.h"
+#include "Poco/Format.h"
+#include "Poco/Path.h"
+#include "Poco/File.h"
+#include <sstream>
+#include <memory>
+#include <iostream>
+
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::OptionCallback;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using Poco::OSP::Bundle;
+using Poco::OSP::BundleRepository;
+using Poco::OSP::BundleIndex;
+using Poco::OSP::BundleLoader;
+using Poco::OSP::BundleFactory;
+using Poco::OSP::BundleContextFactory;
+using Poco::OSP::BundleEvents;
+using Poco::OSP::BundleEvent;
+using Poco::OSP::BundleManifest;
+using Poco::OSP::ExtensionPoint;
+using Poco::OSP::ExtensionPointService;
+using Poco::OSP::CodeCache;
+using Poco::OSP::ServiceRegistry;
+using Poco::OSP::SystemEvents;
+using Poco::OSP::LanguageTag;
+using Poco::Path;
+using Poco::File;
+
+
+namespace
+{
+	const std::string REQUEST_HANDLER_XP("osp.web.server.requesthandler");
+	const std::string DIRECTORY_XP("osp.web.server.directory");
+
+	class NullExtensionPoint: public ExtensionPoint
+		/// Stands in for the web server's extension points, which
+		/// mainly read the attributes of the extension element.
+	{
+	public:
+		NullExtensionPoint():
+			_extensions(0)
+		{
+		}
+
+		void handleExtension(Bundle::ConstPtr pBundle, Poco::XML::Element* pExtensionElem)
+		{
+			if (!pExtensionElem->getAttribute("path").empty()) _extensions++;
+		}
+
+		int extensions() const
+		{
+			return _extensions;
+		}
+
+	private:
+		int _extensions;
+	};
+
+	class TestExtensionPointService: public ExtensionPointService
+	{
+	public:
+		TestExtensionPointService(BundleEvents& events):
+			ExtensionPointService(events)
+		{
+		}
+	};
+}
+
+
+class BundleIndexBenchmark: public Application
+{
+public:
+	BundleIndexBenchmark():
+		_helpRequested(false),
+		_bundles(200),
+		_resources(300),
+		_runs(5)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<BundleIndexBenchmark>(this, &BundleIndexBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("bundles", "b", "Number of bundle files in the repository (default 200).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 100000))
+				.binding("benchmark.bundles"));
+
+		options.addOption(
+			Option("resources", "r", "Number of additional resources per bundle file (default 300).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(0, 100000))
+				.binding("benchmark.resources"));
+
+		options.addOption(
+			Option("runs", "n", "Number of runs per measurement (default 5).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 1000))
+				.binding("benchmark.runs"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("Benchmark measuring bundle loading and extension point processing at startup.");
+		helpFormatter.format(std::cout);
+	}
+
+	std::string extensionsXML(int bundle)
+	{
+		std::string xml("<extensions>\n");
+		for (int i = 0; i < 4; i++)
+		{
+			xml += Poco::format(
+				"  <extension point=\"%s\" methods=\"GET, HEAD\" path=\"/bench/bundle%d/handler%d.json\" "
+				"class=\"Bench::RequestHandlerFactory%d\" library=\"bench.bundle%d\" "
+				"allowSpecialization=\"owner\" hidden=\"true\"/>\n",
+				REQUEST_HANDLER_XP, bundle, i, i, bundle);
+		}
+		xml += Poco::format(
+			"  <extension point=\"%s\" path=\"/bench/bundle%d\" resource=\"webapp\" "
+			"allowSpecialization=\"owner\" hidden=\"true\" session=\"bench\"/>\n",
+			DIRECTORY_XP, bundle);
+		xml += "</extensions>\n";
+		return xml;
+	}
+
+	void addFile(Poco::Zip::Compress& zip, const std::string& path, const std::string& content)
+	{
+		std::istringstream istr(content);
+		zip.addFile(istr, Poco::DateTime(), Path(path, Path::PATH_UNIX));
+	}
+
+	void createRepository(const std::string& path)
+	{
+		File(path).createDirectories();
+		for (int b = 0; b < _bundles; b++)
+		{
+			std::string name = Poco::format("bench.bundle%d", b);
+			Path bundlePath(path, Poco::format("%s_1.0.0.bndl", name));
+			Poco::FileOutputStream ostr(bundlePath.toString());
+			Poco::Zip::Compress zip(ostr, true);
+			addFile(zip, "META-INF/manifest.mf", Poco::format(
+				"Manifest-Version: 1.0\n"
+				"Bundle-Name: ${name}\n"
+				"Bundle-SymbolicName: %s\n"
+				"Bundle-Version: 1.0.0\n"
+				"Bundle-Vendor: Applied Informatics\n"
+				"Bundle-Copyright: (c) 2018, Applied Informatics Software Engineering GmbH\n"
+				"Bundle-RunLevel: 620\n"
+				"Bundle-LazyStart: false\n"
+				"Require-Bundle: osp.web;bundle-version=[1.1.0,2.0.0)\n",
+				name));
+			addFile(zip, "bundle.properties", Poco::format("name = Benchmark Bundle %d\n", b));
+			addFile(zip, "extensions.xml", extensionsXML(b));
+			for (int r = 0; r < _resources; r++)
+			{
+				addFile(zip, Poco::format("webapp/dir%d/file%d.js", r/20, r), "// benchmark\n");
+			}
+			zip.close();
+		}
+	}
+
+	void loadBundles(const std::string& path, BundleIndex::Ptr pIndex, bool processExtensions, Poco::Stopwatch& loadTime, Poco::Stopwatch& xpTime)
+	{
+		CodeCache codeCache(Path(path, "codeCache").toString());
+		ServiceRegistry registry;
+		SystemEvents systemEvents;
+		BundleFactory::Ptr pBundleFactory(new BundleFactory(LanguageTag("en", "US")));
+		BundleContextFactory::Ptr pBundleContextFactory(new BundleContextFactory(registry, systemEvents));
+		BundleLoader loader(codeCache, pBundleFactory, pBundleContextFactory);
+		BundleRepository repository(Path(path, "bundles").toString(), loader);
+		repository.setIndex(pIndex);
+
+		loadTime.start();
+		repository.loadBundles();
+		if (pIndex) pIndex->save();
+		loadTime.stop();
+
+		if (processExtensions)
+		{
+			BundleEvents events;
+			Poco::AutoPtr<TestExtensionPointService> pXPS = new TestExtensionPointService(events);
+			Poco::AutoPtr<NullExtensionPoint> pXP = new NullExtensionPoint;
+			std::vector<Bundle::Ptr> bundles;
+			loader.listBundles(bundles);
+			pXPS->registerExtensionPoint(bundles[0], REQUEST_HANDLER_XP, pXP);
+			pXPS->registerExtensionPoint(bundles[0], DIRECTORY_XP, pXP);
+
+			xpTime.start();
+			for (std::vector<Bundle::Ptr>::iterator it = bundles.begin(); it != bundles.end(); ++it)
+			{
+				BundleEvent event(*it, BundleEvent::EV_BUNDLE_STARTED);
+				events.bundleStarted(this, event);
+			}
+			xpTime.stop();
+			poco_assert (pXP->extensions() == 5*_bundles);
+		}
+	}
+
+	void report(const std::string& what, const Poco::Stopwatch& sw)
+	{
+		double ms = static_cast<double>(sw.elapsed())/1000/_runs;
+		std::cout << Poco::format("%-40s %10.2f", what, ms) << std::endl;
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		_bundles = config().getInt("benchmark.bundles", _bundles);
+		_resources = config().getInt("benchmark.resources", _resources);
+		_runs = config().getInt("benchmark.runs", _runs);
+
+		// keep the per-bundle log messages out of the measurements
+		Poco::Logger::setLevel("", Poco::Message::PRIO_WARNING);
+
+		Poco::TemporaryFile tempDir;
+		std::string path = tempDir.path();
+		createRepository(Path(path, "bundles").toString());
+		std::string indexPath = Path(Path(path, "codeCache"), "bundles.idx").toString();
+
+		std::cout << Poco::format("%d bundle files with %d resources, times in milliseconds per run", _bundles, _resources + 3) << std::endl;
+
+		Poco::Stopwatch loadTime;
+		Poco::Stopwatch xpTime;
+		for (int i = 0; i < _runs; i++)
+		{
+			loadBundles(path, 0, true, loadTime, xpTime);
+		}
+		report("loadBundles, no index", loadTime);
+		report("extension points, no index", xpTime);
+
+		loadTime.reset();
+		for (int i = 0; i < _runs; i++)
+		{
+			File indexFile(indexPath);
+			if (indexFile.exists()) indexFile.remove();
+			loadBundles(path, new BundleIndex(indexPath), false, loadTime, xpTime);
+		}
+		report("loadBundles, writing index", loadTime);
+
+		loadTime.reset();
+		xpTime.reset();
+		for (int i = 0; i < _runs; i++)
+		{
+			BundleIndex::Ptr pIndex = new BundleIndex(indexPath);
+			pIndex->load();
+			loadBundles(path, pIndex, true, loadTime, xpTime);
+		}
+		report("loadBundles, from index", loadTime);
+		report("extension points, from index", xpTime);
+
+		// The parts of the above that parse the cached resources.
+		std::string manifest;
+		std::string extensions;
+		{
+			BundleIndex::Ptr pIndex = new BundleIndex(indexPath);
+			pIndex->load();
+			Poco::OSP::BundleStorage::Ptr pStorage = pIndex->storageFor(Path(Path(path, "bundles"), "bench.bundle0_1.0.0.bndl").toString());
+#if __cplusplus < 201103L
+			std::auto_ptr<std::istream> pManifestStream(pStorage->getResource("META-INF/manifest.mf"));
+			std::auto_ptr<std::istream> pExtensionsStream(pStorage->getResource("extensions.xml"));
+#else
+			std::unique_ptr<std::istream> pManifestStream(pStorage->getResource("META-INF/manifest.mf"));
+			std::unique_ptr<std::istream> pExtensionsStream(pStorage->getResource("extensions.xml"));
+#endif
+			Poco::StreamCopier::copyToString(*pManifestStream, manifest);
+			Poco::StreamCopier::copyToString(*pExtensionsStream, extensions);
+		}
+
+		Poco::Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < _runs*_bundles; i++)
+		{
+			std::istringstream istr(manifest);
+			Poco::AutoPtr<BundleManifest> pManifest = new BundleManifest(istr);
+		}
+		sw.stop();
+		report("  thereof parsing manifests", sw);
+
+		sw.restart();
+		for (int i = 0; i < _runs*_bundles; i++)
+		{
+			std::istringstream istr(extensions);
+			Poco::XML::DOMParser parser;
+			parser.setFeature(Poco::XML::XMLReader::FEATURE_NAMESPACES, false);
+			parser.setFeature(Poco::XML::DOMParser::FEATURE_FILTER_WHITESPACE, true);
+			Poco::XML::InputSource source(istr);
+			Poco::AutoPtr<Poco::XML::Document> pDoc = parser.parse(&source);
+		}
+		sw.stop();
+		report("  thereof parsing extensions.xml", sw);
+
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+	int _bundles;
+	int _resources;
+	int _runs;
+};
+
+
+POCO_APP_MAIN(BundleIndexBenchmark)
@@ -0,0 +1,273 @@
+//
+// BundleIndexTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "BundleIndexTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/OSP/BundleIndex.h"
+#include "Poco/OSP/BundleFile.h"
+#include "Poco/OSP/BundleRepository.h"
+#include "Poco/OSP/BundleFactory.h"
+#include "Poco/OSP/BundleContextFactory.h"
+#include "Poco/OSP/BundleLoader.h"
+#include "Poco/OSP/CodeCache.h"
+#include "Poco/OSP/ServiceRegistry.h"
+#include "Poco/OSP/LanguageTag.h"
+#include "Poco/OSP/SystemEvents.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/FileStream.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Path.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
+#include <memory>
+
+
+using Poco::OSP::BundleIndex;
+using Poco::OSP::BundleFile;
+using Poco::OSP::BundleStorage;
+using Poco::OSP::BundleRepository;
+using Poco::OSP::Bundle;
+using Poco::OSP::BundleFactory;
+using Poco::OSP::BundleContextFactory;
+using Poco::OSP::BundleLoader;
+using Poco::OSP::CodeCache;
+using Poco::OSP::ServiceRegistry;
+using Poco::OSP::LanguageTag;
+using Poco::Path;
+using Poco::File;
+
+
+namespace
+{
+	const std::string INDEX_FILE("bundleIndexTest.idx");
+	const std::string BUNDLE_FILE("bundleIndexTest.bndl");
+
+	std::string readResource(const BundleStorage& storage, const std::string& path)
+	{
+		std::auto_ptr<std::istream> pStream(storage.getResource(path));
+		if (!pStream.get()) throw Poco::NotFoundException(path);
+		std::string content;
+		Poco::StreamCopier::copyToString(*pStream, content);
+		return content;
+	}
+}
+
+
+BundleIndexTest::BundleIndexTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+BundleIndexTest::~BundleIndexTest()
+{
+}
+
+
+void BundleIndexTest::testIndex()
+{
+	BundleIndex::Ptr pIndex = new BundleIndex(INDEX_FILE);
+	assert (!pIndex->load());
+	BundleStorage::Ptr pScanned = pIndex->storageFor(BUNDLE_FILE);
+	assert (!pScanned.isNull());
+	assert (pIndex->hits() == 0);
+	assert (pIndex->misses() == 1);
+	pIndex->save();
+	assert (File(INDEX_FILE).exists());
+
+	pIndex = new BundleIndex(INDEX_FILE);
+	assert (pIndex->load());
+	BundleStorage::Ptr pIndexed = pIndex->storageFor(BUNDLE_FILE);
+	assert (!pIndexed.isNull());
+	assert (pIndex->hits() == 1);
+	assert (pIndex->misses() == 0);
+	assert (pIndexed->path() == BUNDLE_FILE);
+
+	// cached resources
+	assert (readResource(*pIndexed, "META-INF/manifest.mf") == readResource(*pScanned, "META-INF/manifest.mf"));
+	assert (readResource(*pIndexed, "bundle.properties") == readResource(*pScanned, "bundle.properties"));
+	assert (readResource(*pIndexed, "de/AT/bundle.properties") == readResource(*pScanned, "de/AT/bundle.properties"));
+
+	// other resources are read from the bundle file
+	assert (readResource(*pIndexed, "de/lang.txt") == readResource(*pScanned, "de/lang.txt"));
+	assert (pIndexed->getResource("de/") == 0);
+	assert (pIndexed->getResource("nonexistent") == 0);
+
+	std::vector<std::string> indexedFiles;
+	std::vector<std::string> scannedFiles;
+	pIndexed->list("", indexedFiles);
+	pScanned->list("", scannedFiles);
+	assert (!indexedFiles.empty());
+	assert (indexedFiles == scannedFiles);
+	pIndexed->list("de", indexedFiles);
+	pScanned->list("de", scannedFiles);
+	assert (!indexedFiles.empty());
+	assert (indexedFiles == scannedFiles);
+
+	assert (pIndexed->lastModified("META-INF/manifest.mf") == pScanned->lastModified("META-INF/manifest.mf"));
+	try
+	{
+		pIndexed->lastModified("nonexistent");
+		fail("nonexistent file - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+}
+
+
+void BundleIndexTest::testModified()
+{
+	BundleIndex::Ptr pIndex = new BundleIndex(INDEX_FILE);
+	pIndex->storageFor(BUNDLE_FILE);
+	pIndex->save();
+
+	File f(BUNDLE_FILE);
+	f.setLastModified(f.getLastModified() - 10*Poco::Timestamp::resolution());
+
+	pIndex = new BundleIndex(INDEX_FILE);
+	assert (pIndex->load());
+	BundleStorage::Ptr pStorage = pIndex->storageFor(BUNDLE_FILE);
+	assert (!pStorage.isNull());
+	assert (pIndex->hits() == 0);
+	assert (pIndex->misses() == 1);
+	assert (!readResource(*pStorage, "META-INF/manifest.mf").empty());
+
+	// the index entry has been replaced
+	pIndex->save();
+	pIndex = new BundleIndex(INDEX_FILE);
+	assert (pIndex->load());
+	pIndex->storageFor(BUNDLE_FILE);
+	assert (pIndex->hits() == 1);
+}
+
+
+void BundleIndexTest::testCorrupt()
+{
+	BundleIndex::Ptr pIndex = new BundleIndex(INDEX_FILE);
+	pIndex->storageFor(BUNDLE_FILE);
+	pIndex->save();
+
+	{
+		Poco::FileStream stream(INDEX_FILE);
+		stream.seekp(40);
+		stream.put('X');
+	}
+
+	pIndex = new BundleIndex(INDEX_FILE);
+	assert (!pIndex->load());
+	BundleStorage::Ptr pStorage = pIndex->storageFor(BUNDLE_FILE);
+	assert (!pStorage.isNull());
+	assert (pIndex->misses() == 1);
+	assert (!readResource(*pStorage, "META-INF/manifest.mf").empty());
+}
+
+
+void BundleIndexTest::testDirectory()
+{
+	Path p(findBundleRepository());
+	p.makeDirectory();
+	p.pushDirectory("com.appinf.osp.bundle1_1.0.0");
+
+	BundleIndex::Ptr pIndex = new BundleIndex(INDEX_FILE);
+	assert (pIndex->storageFor(p.toString()).isNull());
+	assert (pIndex->hits() == 0);
+	assert (pIndex->misses() == 0);
+}
+
+
+void BundleIndexTest::testRepository()
+{
+	CodeCache cc("codeCache");
+	ServiceRegistry reg;
+	LanguageTag lang("en", "US");
+	BundleFactory::Ptr pBundleFactory(new BundleFactory(lang));
+	Poco::OSP::SystemEvents systemEvents;
+	BundleContextFactory::Ptr pBundleContextFactory(new BundleContextFactory(reg, systemEvents));
+
+	{
+		BundleLoader loader(cc, pBundleFactory, pBundleContextFactory);
+		BundleRepository repo(findBundleRepository(), loader);
+		repo.setIndex(new BundleIndex(INDEX_FILE));
+		repo.loadBundles();
+		assert (repo.getIndex()->hits() == 0);
+		assert (repo.getIndex()->misses() == 1);
+		assert (!loader.findBundle("com.appinf.osp.bundle2").isNull());
+	}
+
+	BundleLoader loader(cc, pBundleFactory, pBundleContextFactory);
+	BundleRepository repo(findBundleRepository(), loader);
+	repo.setIndex(new BundleIndex(INDEX_FILE));
+	repo.loadBundles();
+	assert (repo.getIndex()->hits() == 1);
+	assert (repo.getIndex()->misses() == 0);
+
+	Bundle::Ptr pBundle1 = loader.findBundle("com.appinf.osp.bundle1");
+	Bundle::Ptr pBundle2 = loader.findBundle("com.appinf.osp.bundle2");
+	assert (!pBundle1.isNull());
+	assert (!pBundle2.isNull());
+	assert (pBundle2->name() == "OSP Sample Bundle 2");
+}
+
+
+void BundleIndexTest::setUp()
+{
+	tearDown();
+
+	Path p(findBundleRepository());
+	p.makeDirectory();
+	p.setFileName("com.appinf.osp.bundle2_1.0.0.bndl");
+	File(p).copyTo(BUNDLE_FILE);
+}
+
+
+void BundleIndexTest::tearDown()
+{
+	File indexFile(INDEX_FILE);
+	if (indexFile.exists()) indexFile.remove();
+	File bundleFile(BUNDLE_FILE);
+	if (bundleFile.exists()) bundleFile.remove();
+}
+
+
+std::string BundleIndexTest::findBundleRepository()
+{
+	std::string bundles("bundles");
+	std::string cwd(Path::current());
+	Path cwdPath(cwd);
+	Path p(cwdPath, bundles);
+	bool found = false;
+	while (!found && p.depth() > 0)
+	{
+		File f(p);
+		if (f.exists())
+			found = true;
+		else
+			p.popDirectory();
+	}
+	if (found)
+		return p.toString();
+	else
+		throw Poco::FileNotFoundException("bundles");
+}
+
+
+CppUnit::Test* BundleIndexTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("BundleIndexTest");
+
+	CppUnit_addTest(pSuite, BundleIndexTest, testIndex);
+	CppUnit_addTest(pSuite, BundleIndexTest, testModified);
+	CppUnit_addTest(pSuite, BundleIndexTest, testCorrupt);
+	CppUnit_addTest(pSuite, BundleIndexTest, testDirectory);
+	CppUnit_addTest(pSuite, BundleIndexTest, testRepository);
+
+	return pSuite;
+}
@@ -0,0 +1,43 @@
+//
+// BundleIndexTest.h
+//
+// Definition of the BundleIndexTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef BundleIndexTest_INCLUDED
+#define BundleIndexTest_INCLUDED
+
+
+#include "Poco/OSP/OSP.h"
+#include "CppUnit/TestCase.h"
+
+
+class BundleIndexTest: public CppUnit::TestCase
+{
+public:
+	BundleIndexTest(const std::string& name);
+	~BundleIndexTest();
+
+	void testIndex();
+	void testModified();
+	void testCorrupt();
+	void testDirectory();
+	void testRepository();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+protected:
+	std::string findBundleRepository();
+};
+
+
+#endif // BundleIndexTest_INCLUDED
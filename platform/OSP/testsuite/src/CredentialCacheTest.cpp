@@ -0,0 +1,113 @@
+//
+// CredentialCacheTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "CredentialCacheTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/OSP/Auth/CredentialCache.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Thread.h"
+
+
+using Poco::OSP::Auth::CredentialCache;
+
+
+CredentialCacheTest::CredentialCacheTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+CredentialCacheTest::~CredentialCacheTest()
+{
+}
+
+
+void CredentialCacheTest::testVerified()
+{
+	CredentialCache cache;
+	assert (!cache.verified("admin", "secret"));
+
+	cache.add("admin", "secret");
+	assert (cache.verified("admin", "secret"));
+	assert (!cache.verified("admin", "Secret"));
+	assert (!cache.verified("user", "secret"));
+	assert (!cache.verified("admins", "ecret"));
+	assert (cache.size() == 1);
+
+	cache.add("admin", "secret");
+	assert (cache.size() == 1);
+}
+
+
+void CredentialCacheTest::testSize()
+{
+	CredentialCache cache(4);
+	for (int i = 0; i < 4; i++)
+	{
+		cache.add("user", Poco::NumberFormatter::format(i));
+	}
+	assert (cache.size() == 4);
+
+	// the least recently used entry is removed
+	assert (cache.verified("user", "0"));
+	cache.add("user", "4");
+	assert (cache.size() == 4);
+	assert (cache.verified("user", "0"));
+	assert (!cache.verified("user", "1"));
+	assert (cache.verified("user", "4"));
+}
+
+
+void CredentialCacheTest::testExpire()
+{
+	CredentialCache cache(4, 1);
+	cache.add("admin", "secret");
+	assert (cache.verified("admin", "secret"));
+
+	Poco::Thread::sleep(1200);
+	assert (!cache.verified("admin", "secret"));
+	assert (cache.size() == 0);
+}
+
+
+void CredentialCacheTest::testClear()
+{
+	CredentialCache cache;
+	cache.add("admin", "secret");
+	cache.add("user", "secret");
+	assert (cache.size() == 2);
+
+	cache.clear();
+	assert (cache.size() == 0);
+	assert (!cache.verified("admin", "secret"));
+}
+
+
+void CredentialCacheTest::setUp()
+{
+}
+
+
+void CredentialCacheTest::tearDown()
+{
+}
+
+
+CppUnit::Test* CredentialCacheTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("CredentialCacheTest");
+
+	CppUnit_addTest(pSuite, CredentialCacheTest, testVerified);
+	CppUnit_addTest(pSuite, CredentialCacheTest, testSize);
+	CppUnit_addTest(pSuite, CredentialCacheTest, testExpire);
+	CppUnit_addTest(pSuite, CredentialCacheTest, testClear);
+
+	return pSuite;
+}
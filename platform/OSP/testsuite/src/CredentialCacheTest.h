@@ -0,0 +1,39 @@
+//
+// CredentialCacheTest.h
+//
+// Definition of the CredentialCacheTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef CredentialCacheTest_INCLUDED
+#define CredentialCacheTest_INCLUDED
+
+
+#include "Poco/OSP/OSP.h"
+#include "CppUnit/TestCase.h"
+
+
+class CredentialCacheTest: public CppUnit::TestCase
+{
+public:
+	CredentialCacheTest(const std::string& name);
+	~CredentialCacheTest();
+
+	void testVerified();
+	void testSize();
+	void testExpire();
+	void testClear();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // CredentialCacheTest_INCLUDED
@@ -14,6 +14,7 @@
 #include "BundleManifestTest.h"
 #include "BundleTest.h"
 #include "BundleRepositoryTest.h"
+#include "BundleIndexTest.h"
 
 
 CppUnit::Test* OSPBundleTestSuite::suite()
@@ -25,6 +26,7 @@ CppUnit::Test* OSPBundleTestSuite::suite()
 	pSuite->addTest(BundleManifestTest::suite());
 	pSuite->addTest(BundleTest::suite());
 	pSuite->addTest(BundleRepositoryTest::suite());
+	pSuite->addTest(BundleIndexTest::suite());
 
 	return pSuite;
 }
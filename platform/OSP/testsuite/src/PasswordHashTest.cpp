@@ -0,0 +1,112 @@
+//
+// PasswordHashTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "PasswordHashTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/OSP/Auth/PasswordHash.h"
+#include "Poco/Exception.h"
+
+
+using Poco::OSP::Auth::PasswordHash;
+
+
+PasswordHashTest::PasswordHashTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+PasswordHashTest::~PasswordHashTest()
+{
+}
+
+
+void PasswordHashTest::testCreateVerify()
+{
+	std::string hash = PasswordHash::create("secret", PasswordHash::MIN_ITERATIONS);
+	assert (hash.compare(0, 18, "$pbkdf2-sha1$1000$") == 0);
+	assert (PasswordHash::isPasswordHash(hash));
+	assert (PasswordHash::verify("secret", hash));
+	assert (!PasswordHash::verify("Secret", hash));
+	assert (!PasswordHash::verify("", hash));
+
+	// every hash gets its own salt
+	std::string hash2 = PasswordHash::create("secret", PasswordHash::MIN_ITERATIONS);
+	assert (hash2 != hash);
+	assert (PasswordHash::verify("secret", hash2));
+
+	try
+	{
+		PasswordHash::create("secret", 1);
+		fail("too few iterations - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void PasswordHashTest::testKnownHash()
+{
+	// RFC 6070 test vector: P = "password", S = "salt", c = 4096
+	const std::string hash("$pbkdf2-sha1$4096$73616c74$4b007901b765489abead49d926f721d065a429c1");
+	assert (PasswordHash::create("password", "salt", 4096) == hash);
+	assert (PasswordHash::verify("password", hash));
+	assert (!PasswordHash::verify("passwort", hash));
+}
+
+
+void PasswordHashTest::testInvalidHash()
+{
+	assert (!PasswordHash::isPasswordHash(""));
+	assert (!PasswordHash::isPasswordHash("21232f297a57a5a743894a0e4a801fc3"));
+	assert (!PasswordHash::isPasswordHash("$pbkdf2-sha1$"));
+	assert (!PasswordHash::isPasswordHash("$pbkdf2-sha1$4096$73616c74"));
+	assert (!PasswordHash::isPasswordHash("$pbkdf2-sha1$x$73616c74$4b007901b765489abead49d926f721d065a429c1"));
+	assert (!PasswordHash::isPasswordHash("$pbkdf2-sha1$10$73616c74$4b007901b765489abead49d926f721d065a429c1"));
+	assert (!PasswordHash::isPasswordHash("$pbkdf2-sha1$4096$$4b007901b765489abead49d926f721d065a429c1"));
+	assert (!PasswordHash::isPasswordHash("$pbkdf2-sha1$4096$73616c7$4b007901b765489abead49d926f721d065a429c1"));
+	assert (!PasswordHash::isPasswordHash("$pbkdf2-sha1$4096$73616c74$4b007901b765489abead49d926f721d065a429"));
+	assert (!PasswordHash::isPasswordHash("$pbkdf2-sha1$4096$73616c74$4b007901b765489abead49d926f721d065a429cg"));
+	assert (!PasswordHash::verify("admin", "21232f297a57a5a743894a0e4a801fc3"));
+}
+
+
+void PasswordHashTest::testEquals()
+{
+	assert (PasswordHash::equals("", ""));
+	assert (PasswordHash::equals("abc", "abc"));
+	assert (!PasswordHash::equals("abc", "abd"));
+	assert (!PasswordHash::equals("abc", "ab"));
+	assert (!PasswordHash::equals("", "a"));
+}
+
+
+void PasswordHashTest::setUp()
+{
+}
+
+
+void PasswordHashTest::tearDown()
+{
+}
+
+
+CppUnit::Test* PasswordHashTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PasswordHashTest");
+
+	CppUnit_addTest(pSuite, PasswordHashTest, testCreateVerify);
+	CppUnit_addTest(pSuite, PasswordHashTest, testKnownHash);
+	CppUnit_addTest(pSuite, PasswordHashTest, testInvalidHash);
+	CppUnit_addTest(pSuite, PasswordHashTest, testEquals);
+
+	return pSuite;
+}
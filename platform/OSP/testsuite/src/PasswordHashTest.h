@@ -0,0 +1,39 @@
+//
+// PasswordHashTest.h
+//
+// Definition of the PasswordHashTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef PasswordHashTest_INCLUDED
+#define PasswordHashTest_INCLUDED
+
+
+#include "Poco/OSP/OSP.h"
+#include "CppUnit/TestCase.h"
+
+
+class PasswordHashTest: public CppUnit::TestCase
+{
+public:
+	PasswordHashTest(const std::string& name);
+	~PasswordHashTest();
+
+	void testCreateVerify();
+	void testKnownHash();
+	void testInvalidHash();
+	void testEquals();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // PasswordHashTest_INCLUDED
@@ -0,0 +1,257 @@
+//
+// AsyncClient.h
+//
+// Library: Redis
+// Package: Redis
+// Module:  AsyncClient
+//
+// Definition of the AsyncClient class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Redis_AsyncClient_INCLUDED
+#define Redis_AsyncClient_INCLUDED
+
+
+#include "Poco/Redis/Redis.h"
+#include "Poco/Redis/Array.h"
+#include "Poco/Redis/Error.h"
+#include "Poco/Redis/Exception.h"
+#include "Poco/Redis/RedisEventArgs.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/AbstractDelegate.h"
+#include "Poco/ActiveResult.h"
+#include "Poco/Activity.h"
+#include "Poco/Condition.h"
+#include "Poco/Mutex.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Timespan.h"
+#include <deque>
+
+
+namespace Poco {
+namespace Redis {
+
+
+class Redis_API AsyncClient
+	/// A thread-safe, pipelining connection to a Redis server.
+	///
+	/// Unlike Client, which writes a command and then blocks until the
+	/// reply has been received, AsyncClient keeps sending commands while
+	/// replies to earlier commands are still outstanding. Replies are read
+	/// by a separate thread and matched, in order, with a queue of
+	/// pending requests. A reply is passed either to an ActiveResult
+	/// or to a callback delegate.
+	///
+	/// AsyncClient can be used by multiple threads at the same time.
+	/// Commands are batched automatically: while commands are waiting
+	/// for their replies, new commands from all callers are collected.
+	/// As soon as the reader thread has processed the replies received
+	/// so far, a writer thread sends them with a single write. If no
+	/// command is outstanding, the caller sends a command immediately.
+	/// The reader thread never writes to the socket, so it keeps
+	/// receiving replies even if the server does not accept more
+	/// commands for a while.
+	///
+	/// The number of commands waiting for a reply is limited (see
+	/// setMaxPending()). Callers block if the limit is reached.
+	///
+	/// Example:
+	///
+	///     AsyncClient client("localhost:6379");
+	///     AsyncClient::Result result = client.executeAsync(Command::incr("counter"));
+	///     ...
+	///     result.wait();
+	///     Int64 value = AsyncClient::convert<Int64>(result.data());
+	///
+	/// or with a callback:
+	///
+	///     client.executeAsync(Command::rpush("samples", value), Poco::delegate(this, &Historian::onReply));
+	///
+	/// Callbacks are invoked by the reader thread and should not block.
+	/// A callback receives a RedisEventArgs containing either the reply
+	/// or, if the connection failed, an exception.
+{
+public:
+	typedef SharedPtr<AsyncClient> Ptr;
+	typedef ActiveResult<RedisType::Ptr> Result;
+	typedef AbstractDelegate<RedisEventArgs> Callback;
+
+	enum
+	{
+		DEFAULT_MAX_PENDING = 1024
+	};
+
+	enum
+	{
+		FLUSH_THRESHOLD = 65536
+			/// Collected commands are sent without waiting for outstanding
+			/// replies once they exceed this size, in bytes.
+	};
+
+	AsyncClient(const std::string& hostAndPort);
+		/// Creates the AsyncClient and connects to the given Redis host/port.
+		/// The host and port must be separated with a colon.
+
+	AsyncClient(const std::string& host, int port);
+		/// Creates the AsyncClient and connects to the given Redis host/port.
+
+	AsyncClient(const Net::SocketAddress& address);
+		/// Creates the AsyncClient and connects to the given Redis host/port.
+
+	AsyncClient(const Net::SocketAddress& address, const Timespan& timeout);
+		/// Creates the AsyncClient and connects to the given Redis host/port,
+		/// using the given connect timeout.
+
+	~AsyncClient();
+		/// Disconnects and destroys the AsyncClient.
+
+	Net::SocketAddress address() const;
+		/// Returns the address of the Redis server.
+
+	void disconnect();
+		/// Disconnects from the Redis server.
+		///
+		/// All requests still waiting for a reply fail with
+		/// a RedisException.
+
+	bool isConnected() const;
+		/// Returns true if the connection to the Redis server is usable.
+		///
+		/// Returns false after disconnect() has been called, or after a
+		/// send or receive error occurred.
+
+	Result executeAsync(const Array& command);
+		/// Sends the given command and returns an ActiveResult that will
+		/// receive the reply. A Redis error reply is stored as the result's
+		/// data; if the connection fails, the result's exception is set.
+		///
+		/// Throws a RedisException if the client is not connected.
+
+	void executeAsync(const Array& command, const Callback& callback);
+		/// Sends the given command. The given delegate will be called
+		/// from the reader thread with the reply.
+		///
+		/// Throws a RedisException if the client is not connected.
+
+	template <typename T>
+	T execute(const Array& command)
+		/// Sends the given command, waits for the reply and converts it
+		/// to the given type, like Client::execute().
+		///
+		/// The specialization for void does not wait. Its reply, including
+		/// an error reply, is discarded.
+	{
+		Result result = executeAsync(command);
+		result.wait();
+		if (result.failed()) result.exception()->rethrow();
+		return convert<T>(result.data());
+	}
+
+	template <typename T>
+	static T convert(RedisType::Ptr pReply)
+		/// Converts the given reply to the given type.
+		///
+		/// Throws a RedisException if the reply is an Error, or a
+		/// BadCastException if the reply has a different type.
+	{
+		if (pReply->type() == RedisTypeTraits<Error>::TypeId)
+		{
+			Type<Error>* error = dynamic_cast<Type<Error>*>(pReply.get());
+			throw RedisException(error->value().getMessage());
+		}
+		if (pReply->type() != RedisTypeTraits<T>::TypeId) throw BadCastException();
+
+		return static_cast<Type<T>*>(pReply.get())->value();
+	}
+
+	void setMaxPending(int maxPending);
+		/// Sets the maximum number of commands that may be waiting
+		/// for a reply. Defaults to DEFAULT_MAX_PENDING.
+
+	int getMaxPending() const;
+		/// Returns the maximum number of commands that may be waiting
+		/// for a reply.
+
+	int pending() const;
+		/// Returns the number of commands currently waiting for a reply.
+
+	UInt64 commandsSent() const;
+		/// Returns the number of commands sent so far.
+
+	UInt64 writes() const;
+		/// Returns the number of socket write operations used to
+		/// send these commands.
+
+protected:
+	struct PendingReply
+	{
+		AutoPtr<ActiveResultHolder<RedisType::Ptr> > pResult;
+		SharedPtr<Callback> pCallback;
+	};
+
+	void connect(const Timespan& timeout);
+	void submit(const Array& command, const PendingReply& reply);
+	void writeBuffered();
+	void sendAll(const std::string& data);
+	void runActivity();
+	void runWriter();
+	void deliver(PendingReply& reply, RedisType::Ptr pReply);
+	void deliver(PendingReply& reply, const Exception& exc);
+
+private:
+	AsyncClient();
+	AsyncClient(const AsyncClient&);
+	AsyncClient& operator = (const AsyncClient&);
+
+	typedef std::deque<PendingReply> PendingQueue;
+
+	Net::SocketAddress _address;
+	Net::StreamSocket _socket;
+	Activity<AsyncClient> _activity;
+	Activity<AsyncClient> _writer;
+	PendingQueue _pending;
+	std::string _writeBuffer;
+	std::string _sendBuffer;
+	int _buffered;
+	int _inFlight;
+	bool _writing;
+	bool _flushRequested;
+	bool _connected;
+	std::size_t _maxPending;
+	UInt64 _commandsSent;
+	UInt64 _writes;
+	Condition _notFull;
+	Condition _flush;
+	mutable Mutex _mutex;
+};
+
+
+//
+// inlines
+//
+
+
+inline Net::SocketAddress AsyncClient::address() const
+{
+	return _address;
+}
+
+
+template <> inline
+void AsyncClient::execute<void>(const Array& command)
+{
+	submit(command, PendingReply());
+}
+
+
+} } // namespace Poco::Redis
+
+
+#endif // Redis_AsyncClient_INCLUDED
@@ -19,6 +19,7 @@
 
 
 #include "Poco/Redis/Client.h"
+#include "Poco/Redis/AsyncClient.h"
 #include "Poco/ObjectPool.h"
 #include "Poco/Version.h"
 
@@ -69,6 +70,52 @@ private:
 };
 
 
+template<>
+class PoolableObjectFactory<Redis::AsyncClient, Redis::AsyncClient::Ptr>
+	/// PoolableObjectFactory specialisation for AsyncClient. New connections
+	/// are created with the given address.
+	///
+	/// Connections that have failed are not returned to the pool,
+	/// so that they are replaced by new ones.
+{
+public:
+	PoolableObjectFactory(const Net::SocketAddress& address):
+		_address(address)
+	{
+	}
+
+	PoolableObjectFactory(const std::string& address):
+		_address(address)
+	{
+	}
+
+	Redis::AsyncClient::Ptr createObject()
+	{
+		return new Redis::AsyncClient(_address);
+	}
+
+	bool validateObject(Redis::AsyncClient::Ptr pObject)
+	{
+		return pObject->isConnected();
+	}
+
+	void activateObject(Redis::AsyncClient::Ptr pObject)
+	{
+	}
+
+	void deactivateObject(Redis::AsyncClient::Ptr pObject)
+	{
+	}
+
+	void destroyObject(Redis::AsyncClient::Ptr pObject)
+	{
+	}
+
+private:
+	Net::SocketAddress _address;
+};
+
+
 namespace Redis {
 
 
@@ -108,6 +155,42 @@ private:
 };
 
 
+class PooledAsyncConnection
+	/// Helper class for borrowing and returning an AsyncClient automatically from a pool.
+	///
+	/// Since an AsyncClient can be shared by multiple threads, a pool of
+	/// AsyncClient objects is mainly useful to spread load over several
+	/// connections, or to replace failed connections transparently.
+{
+public:
+	PooledAsyncConnection(ObjectPool<AsyncClient, AsyncClient::Ptr>& pool, long timeoutMilliseconds = 0) : _pool(pool)
+	{
+		_client = _pool.borrowObject(timeoutMilliseconds);
+	}
+
+	virtual ~PooledAsyncConnection()
+	{
+		try
+		{
+			_pool.returnObject(_client);
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+
+	operator AsyncClient::Ptr()
+	{
+		return _client;
+	}
+
+private:
+	ObjectPool<AsyncClient, AsyncClient::Ptr>& _pool;
+	AsyncClient::Ptr _client;
+};
+
+
 } } // namespace Poco::Redis
 
 
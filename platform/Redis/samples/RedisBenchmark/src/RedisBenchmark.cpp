@@ -0,0 +1,414 @@
+//
+// RedisBenchmark.cpp
+//
+// This sample measures the throughput of Client and AsyncClient.
+//
+// A number of INCR commands is sent, first one at a time with
+// Client::execute(), then in batches with Client::sendCommands(),
+// then with AsyncClient::execute<void>() from a single thread, and
+// finally with AsyncClient::execute<Int64>() from several threads
+// sharing one AsyncClient. For each, the number of commands per second
+// and, for AsyncClient, the average number of commands sent with a
+// single socket write are reported.
+//
+// The commands are sent to a Redis server, or, with the --stand-in
+// option, to a minimal built-in server on the loopback interface that
+// answers every command with an integer reply.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Redis/Client.h"
+#include "Poco/Redis/AsyncClient.h"
+#include "Poco/Redis/Command.h"
+#include "Poco/Redis/Array.h"
+#include "Poco/Net/TCPServer.h"
+#include "Poco/Net/TCPServerConnection.h"
+#include "Poco/Net/TCPServerConnectionFactory.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/Format.h"
+#include <vector>
+#include <iostream>
+
+
+using Poco::Redis::Client;
+using Poco::Redis::AsyncClient;
+using Poco::Redis::Command;
+using Poco::Redis::Array;
+using Poco::Net::TCPServer;
+using Poco::Net::TCPServerConnection;
+using Poco::Net::TCPServerConnectionFactoryImpl;
+using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using Poco::Stopwatch;
+using Poco::Int64;
+using Poco::UInt64;
+
+
+class StandInConnection: public TCPServerConnection
+	/// Reads RESP commands and answers each one with
+	/// an integer reply, counting up from 1.
+{
+public:
+	StandInConnection(const StreamSocket& socket):
+		TCPServerConnection(socket),
+		_counter(0)
+	{
+	}
+
+	void run()
+	{
+		StreamSocket& ss = socket();
+		std::string input;
+		std::string output;
+		char buffer[8192];
+		try
+		{
+			int n = ss.receiveBytes(buffer, sizeof(buffer));
+			while (n > 0)
+			{
+				input.append(buffer, n);
+				std::size_t pos = 0;
+				while (parseCommand(input, pos))
+				{
+					output += ':';
+					Poco::NumberFormatter::append(output, ++_counter);
+					output += "\r\n";
+				}
+				input.erase(0, pos);
+				sendAll(ss, output);
+				output.clear();
+				n = ss.receiveBytes(buffer, sizeof(buffer));
+			}
+		}
+		catch (Poco::Exception&)
+		{
+		}
+	}
+
+protected:
+	static bool parseCommand(const std::string& input, std::size_t& pos)
+		/// Returns true and advances pos past the command if input
+		/// contains a complete command at pos, otherwise returns false.
+	{
+		std::size_t p = pos;
+		if (p >= input.size()) return false;
+		if (input[p] != '*') throw Poco::DataFormatException("RESP array expected");
+		std::size_t eol = input.find("\r\n", p);
+		if (eol == std::string::npos) return false;
+		int elements = Poco::NumberParser::parse(input.substr(p + 1, eol - p - 1));
+		p = eol + 2;
+		for (int i = 0; i < elements; i++)
+		{
+			if (p >= input.size()) return false;
+			if (input[p] != '$') throw Poco::DataFormatException("RESP bulk string expected");
+			eol = input.find("\r\n", p);
+			if (eol == std::string::npos) return false;
+			int length = Poco::NumberParser::parse(input.substr(p + 1, eol - p - 1));
+			p = eol + 2 + length + 2;
+			if (p > input.size()) return false;
+		}
+		pos = p;
+		return true;
+	}
+
+	static void sendAll(StreamSocket& ss, const std::string& data)
+	{
+		const char* p = data.data();
+		int remaining = static_cast<int>(data.size());
+		while (remaining > 0)
+		{
+			int n = ss.sendBytes(p, remaining);
+			p += n;
+			remaining -= n;
+		}
+	}
+
+private:
+	Int64 _counter;
+};
+
+
+class AsyncWorker: public Poco::Runnable
+	/// Sends a number of commands with AsyncClient::execute<Int64>().
+{
+public:
+	AsyncWorker(AsyncClient& client, int requests):
+		_client(client),
+		_requests(requests)
+	{
+	}
+
+	void run()
+	{
+		Array command = Command::incr("benchmark");
+		for (int i = 0; i < _requests; i++)
+		{
+			_client.execute<Int64>(command);
+		}
+	}
+
+private:
+	AsyncClient& _client;
+	int _requests;
+};
+
+
+class RedisBenchmark: public Application
+	/// Try RedisBenchmark --help (on Unix platforms) or
+	/// RedisBenchmark /help (elsewhere) for more information.
+{
+public:
+	RedisBenchmark():
+		_helpRequested(false),
+		_standIn(false)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(Poco::Util::OptionCallback<RedisBenchmark>(this, &RedisBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("host", "H", "Specify the Redis server host (default localhost).")
+				.required(false)
+				.repeatable(false)
+				.argument("<host>")
+				.binding("benchmark.host"));
+
+		options.addOption(
+			Option("port", "p", "Specify the Redis server port (default 6379).")
+				.required(false)
+				.repeatable(false)
+				.argument("<port>")
+				.validator(new IntValidator(1, 65535))
+				.binding("benchmark.port"));
+
+		options.addOption(
+			Option("stand-in", "s", "Use a built-in stand-in server instead of a Redis server.")
+				.required(false)
+				.repeatable(false)
+				.callback(Poco::Util::OptionCallback<RedisBenchmark>(this, &RedisBenchmark::handleStandIn)));
+
+		options.addOption(
+			Option("requests", "n", "Specify the number of commands to send (default 100000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 100000000))
+				.binding("benchmark.requests"));
+
+		options.addOption(
+			Option("batch", "b", "Specify the number of commands per sendCommands() call (default 100).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 100000))
+				.binding("benchmark.batch"));
+
+		options.addOption(
+			Option("threads", "t", "Specify the number of threads sharing an AsyncClient (default 16).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 1024))
+				.binding("benchmark.threads"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void handleStandIn(const std::string& name, const std::string& value)
+	{
+		_standIn = true;
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("A benchmark for the Redis Client and AsyncClient.");
+		helpFormatter.format(std::cout);
+	}
+
+	static void report(const std::string& title, int requests, const Stopwatch& sw)
+	{
+		double seconds = double(sw.elapsed())/Stopwatch::resolution();
+		std::cout << Poco::format("%-32s %10.1f ops/s", title, seconds > 0 ? requests/seconds : 0.0) << std::endl;
+	}
+
+	static void report(const std::string& title, int requests, const Stopwatch& sw, const AsyncClient& client)
+	{
+		double seconds = double(sw.elapsed())/Stopwatch::resolution();
+		UInt64 writes = client.writes();
+		std::cout
+			<< Poco::format("%-32s %10.1f ops/s %8.1f commands/write",
+				title,
+				seconds > 0 ? requests/seconds : 0.0,
+				writes > 0 ? double(client.commandsSent())/writes : 0.0)
+			<< std::endl;
+	}
+
+	void measureExecute(const SocketAddress& address, int requests)
+	{
+		Client client(address);
+		Array command = Command::incr("benchmark");
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < requests; i++)
+		{
+			client.execute<Int64>(command);
+		}
+		sw.stop();
+		report("Client::execute", requests, sw);
+	}
+
+	void measureSendCommands(const SocketAddress& address, int requests, int batch)
+	{
+		Client client(address);
+		std::vector<Array> commands(batch, Command::incr("benchmark"));
+		int batches = (requests + batch - 1)/batch;
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < batches; i++)
+		{
+			client.sendCommands(commands);
+		}
+		sw.stop();
+		report(Poco::format("Client::sendCommands (%d)", batch), batches*batch, sw);
+	}
+
+	void measureAsyncVoid(const SocketAddress& address, int requests)
+	{
+		AsyncClient client(address);
+		Array command = Command::incr("benchmark");
+		Stopwatch sw;
+		sw.start();
+		for (int i = 1; i < requests; i++)
+		{
+			client.execute<void>(command);
+		}
+		// replies arrive in order, so this waits for all of them
+		client.execute<Int64>(command);
+		sw.stop();
+		report("AsyncClient::execute<void>", requests, sw, client);
+	}
+
+	void measureAsyncThreads(const SocketAddress& address, int requests, int threads)
+	{
+		AsyncClient client(address);
+		int perThread = (requests + threads - 1)/threads;
+		std::vector<AsyncWorker*> workers;
+		std::vector<Poco::Thread*> workerThreads;
+		for (int i = 0; i < threads; i++)
+		{
+			workers.push_back(new AsyncWorker(client, perThread));
+			workerThreads.push_back(new Poco::Thread);
+		}
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < threads; i++)
+		{
+			workerThreads[i]->start(*workers[i]);
+		}
+		for (int i = 0; i < threads; i++)
+		{
+			workerThreads[i]->join();
+		}
+		sw.stop();
+		for (int i = 0; i < threads; i++)
+		{
+			delete workerThreads[i];
+			delete workers[i];
+		}
+		report(Poco::format("AsyncClient::execute<Int64> (%d)", threads), perThread*threads, sw, client);
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		int requests = config().getInt("benchmark.requests", 100000);
+		int batch = config().getInt("benchmark.batch", 100);
+		int threads = config().getInt("benchmark.threads", 16);
+
+		ServerSocket socket;
+		Poco::SharedPtr<TCPServer> pServer;
+		SocketAddress address;
+		if (_standIn)
+		{
+			socket.bind(SocketAddress("127.0.0.1", 0));
+			socket.listen();
+			pServer = new TCPServer(new TCPServerConnectionFactoryImpl<StandInConnection>, socket);
+			pServer->start();
+			address = socket.address();
+		}
+		else
+		{
+			address = SocketAddress(config().getString("benchmark.host", "localhost"), static_cast<Poco::UInt16>(config().getInt("benchmark.port", 6379)));
+		}
+
+		std::cout << Poco::format("%d commands to %s%s", requests, address.toString(), std::string(_standIn ? " (stand-in)" : "")) << std::endl;
+		try
+		{
+			measureExecute(address, requests);
+			measureSendCommands(address, requests, batch);
+			measureAsyncVoid(address, requests);
+			measureAsyncThreads(address, requests, threads);
+		}
+		catch (Poco::Exception& exc)
+		{
+			logger().log(exc);
+			if (pServer) pServer->stop();
+			return Application::EXIT_SOFTWARE;
+		}
+
+		if (pServer) pServer->stop();
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+	bool _standIn;
+};
+
+
+POCO_APP_MAIN(RedisBenchmark)
@@ -0,0 +1,416 @@
+//
+// AsyncClient.cpp
+//
+// Library: Redis
+// Package: Redis
+// Module:  AsyncClient
+//
+// Implementation of the AsyncClient class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Redis/AsyncClient.h"
+#include "Poco/Redis/RedisStream.h"
+#include "Poco/ScopedUnlock.h"
+
+
+namespace Poco {
+namespace Redis {
+
+
+AsyncClient::AsyncClient(const std::string& hostAndPort):
+	_address(hostAndPort),
+	_activity(this, &AsyncClient::runActivity),
+	_writer(this, &AsyncClient::runWriter),
+	_buffered(0),
+	_inFlight(0),
+	_writing(false),
+	_flushRequested(false),
+	_connected(false),
+	_maxPending(DEFAULT_MAX_PENDING),
+	_commandsSent(0),
+	_writes(0)
+{
+	connect(0);
+}
+
+
+AsyncClient::AsyncClient(const std::string& host, int port):
+	_address(host, port),
+	_activity(this, &AsyncClient::runActivity),
+	_writer(this, &AsyncClient::runWriter),
+	_buffered(0),
+	_inFlight(0),
+	_writing(false),
+	_flushRequested(false),
+	_connected(false),
+	_maxPending(DEFAULT_MAX_PENDING),
+	_commandsSent(0),
+	_writes(0)
+{
+	connect(0);
+}
+
+
+AsyncClient::AsyncClient(const Net::SocketAddress& address):
+	_address(address),
+	_activity(this, &AsyncClient::runActivity),
+	_writer(this, &AsyncClient::runWriter),
+	_buffered(0),
+	_inFlight(0),
+	_writing(false),
+	_flushRequested(false),
+	_connected(false),
+	_maxPending(DEFAULT_MAX_PENDING),
+	_commandsSent(0),
+	_writes(0)
+{
+	connect(0);
+}
+
+
+AsyncClient::AsyncClient(const Net::SocketAddress& address, const Timespan& timeout):
+	_address(address),
+	_activity(this, &AsyncClient::runActivity),
+	_writer(this, &AsyncClient::runWriter),
+	_buffered(0),
+	_inFlight(0),
+	_writing(false),
+	_flushRequested(false),
+	_connected(false),
+	_maxPending(DEFAULT_MAX_PENDING),
+	_commandsSent(0),
+	_writes(0)
+{
+	connect(timeout);
+}
+
+
+AsyncClient::~AsyncClient()
+{
+	try
+	{
+		disconnect();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void AsyncClient::connect(const Timespan& timeout)
+{
+	if (timeout.totalMicroseconds() > 0)
+		_socket.connect(_address, timeout);
+	else
+		_socket.connect(_address);
+	_socket.setNoDelay(true);
+	_connected = true;
+	_activity.start();
+	_writer.start();
+}
+
+
+void AsyncClient::disconnect()
+{
+	{
+		Mutex::ScopedLock lock(_mutex);
+
+		_connected = false;
+		_notFull.broadcast();
+		_flush.broadcast();
+	}
+	if (!_activity.isStopped())
+	{
+		_activity.stop();
+		_writer.stop();
+		try
+		{
+			// wakes up the reader thread
+			_socket.shutdown();
+		}
+		catch (Poco::Exception&)
+		{
+		}
+		_activity.wait();
+		_writer.wait();
+		_socket.close();
+	}
+}
+
+
+bool AsyncClient::isConnected() const
+{
+	Mutex::ScopedLock lock(_mutex);
+
+	return _connected;
+}
+
+
+AsyncClient::Result AsyncClient::executeAsync(const Array& command)
+{
+	ActiveResultHolder<RedisType::Ptr>* pHolder = new ActiveResultHolder<RedisType::Ptr>;
+	Result result(pHolder);
+	PendingReply reply;
+	reply.pResult.assign(pHolder, true);
+	submit(command, reply);
+	return result;
+}
+
+
+void AsyncClient::executeAsync(const Array& command, const Callback& callback)
+{
+	PendingReply reply;
+	reply.pCallback = callback.clone();
+	submit(command, reply);
+}
+
+
+void AsyncClient::submit(const Array& command, const PendingReply& reply)
+{
+	std::string data = command.toString();
+
+	Mutex::ScopedLock lock(_mutex);
+
+	while (_connected && _pending.size() >= _maxPending)
+	{
+		_notFull.wait(_mutex);
+	}
+	if (!_connected) throw RedisException("Not connected to Redis server");
+
+	_writeBuffer.append(data);
+	_pending.push_back(reply);
+	_buffered++;
+	_commandsSent++;
+
+	// While earlier commands are still waiting for their replies, new
+	// commands are collected and sent by the writer thread once the reader
+	// thread has received all replies available so far. Otherwise the caller sends
+	// the command right away, together with any commands submitted by
+	// other threads while it is writing.
+	if (_inFlight > 0 && _writeBuffer.size() < FLUSH_THRESHOLD) return;
+	writeBuffered();
+}
+
+
+void AsyncClient::writeBuffered()
+{
+	if (_writing) return;
+
+	_writing = true;
+	try
+	{
+		while (!_writeBuffer.empty())
+		{
+			_sendBuffer.clear();
+			_sendBuffer.swap(_writeBuffer);
+			_inFlight += _buffered;
+			_buffered = 0;
+			_writes++;
+			ScopedUnlock<Mutex> unlock(_mutex);
+			sendAll(_sendBuffer);
+		}
+	}
+	catch (Poco::Exception&)
+	{
+		// The reader thread fails all pending requests,
+		// including the ones not sent yet.
+		_connected = false;
+		_writeBuffer.clear();
+		_buffered = 0;
+		_notFull.broadcast();
+		_flush.broadcast();
+		try
+		{
+			_socket.shutdown();
+		}
+		catch (Poco::Exception&)
+		{
+		}
+	}
+	_writing = false;
+}
+
+
+void AsyncClient::sendAll(const std::string& data)
+{
+	const char* p = data.data();
+	int remaining = static_cast<int>(data.size());
+	while (remaining > 0)
+	{
+		int n = _socket.sendBytes(p, remaining);
+		p += n;
+		remaining -= n;
+	}
+}
+
+
+void AsyncClient::runActivity()
+{
+	RedisInputStream input(_socket);
+	RedisException error("Disconnected from Redis server");
+	while (!_activity.isStopped())
+	{
+		try
+		{
+			int c = input.get();
+			if (c == std::char_traits<char>::eof())
+			{
+				if (!_activity.isStopped()) error = RedisException("Connection closed by Redis server");
+				break;
+			}
+			RedisType::Ptr pReply = RedisType::createRedisType(static_cast<char>(c));
+			if (pReply.isNull()) throw RedisException("Invalid Redis type returned");
+			pReply->read(input);
+
+			PendingReply reply;
+			{
+				Mutex::ScopedLock lock(_mutex);
+
+				if (_pending.empty()) throw RedisException("Unexpected reply from Redis server");
+				reply = _pending.front();
+				_pending.pop_front();
+				_inFlight--;
+				_notFull.signal();
+				if (input.rdbuf()->in_avail() == 0 && !_writeBuffer.empty())
+				{
+					// A write may block, so leave it to the writer thread.
+					_flushRequested = true;
+					_flush.signal();
+				}
+			}
+			deliver(reply, pReply);
+		}
+		catch (Poco::Exception& exc)
+		{
+			if (!_activity.isStopped()) error = RedisException(exc.displayText());
+			break;
+		}
+	}
+
+	PendingQueue failed;
+	{
+		Mutex::ScopedLock lock(_mutex);
+
+		_connected = false;
+		_pending.swap(failed);
+		_notFull.broadcast();
+		_flush.broadcast();
+	}
+	for (PendingQueue::iterator it = failed.begin(); it != failed.end(); ++it)
+	{
+		deliver(*it, error);
+	}
+}
+
+
+void AsyncClient::runWriter()
+{
+	Mutex::ScopedLock lock(_mutex);
+
+	while (_connected && !_writer.isStopped())
+	{
+		if (_flushRequested)
+		{
+			_flushRequested = false;
+			writeBuffered();
+		}
+		else _flush.wait(_mutex);
+	}
+}
+
+
+void AsyncClient::deliver(PendingReply& reply, RedisType::Ptr pReply)
+{
+	if (reply.pResult)
+	{
+		reply.pResult->data(new RedisType::Ptr(pReply));
+		reply.pResult->notify();
+	}
+	else if (reply.pCallback)
+	{
+		RedisEventArgs args(pReply);
+		try
+		{
+			reply.pCallback->notify(this, args);
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+}
+
+
+void AsyncClient::deliver(PendingReply& reply, const Exception& exc)
+{
+	if (reply.pResult)
+	{
+		reply.pResult->error(exc);
+		reply.pResult->notify();
+	}
+	else if (reply.pCallback)
+	{
+		RedisEventArgs args(const_cast<Exception*>(&exc));
+		try
+		{
+			reply.pCallback->notify(this, args);
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+}
+
+
+void AsyncClient::setMaxPending(int maxPending)
+{
+	poco_assert (maxPending > 0);
+
+	Mutex::ScopedLock lock(_mutex);
+
+	_maxPending = static_cast<std::size_t>(maxPending);
+	_notFull.broadcast();
+}
+
+
+int AsyncClient::getMaxPending() const
+{
+	Mutex::ScopedLock lock(_mutex);
+
+	return static_cast<int>(_maxPending);
+}
+
+
+int AsyncClient::pending() const
+{
+	Mutex::ScopedLock lock(_mutex);
+
+	return static_cast<int>(_pending.size());
+}
+
+
+UInt64 AsyncClient::commandsSent() const
+{
+	Mutex::ScopedLock lock(_mutex);
+
+	return _commandsSent;
+}
+
+
+UInt64 AsyncClient::writes() const
+{
+	Mutex::ScopedLock lock(_mutex);
+
+	return _writes;
+}
+
+
+} } // namespace Poco::Redis
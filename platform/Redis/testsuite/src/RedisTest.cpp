@@ -13,8 +13,10 @@
 #include "Poco/Thread.h"
 #include "RedisTest.h"
 #include "Poco/Redis/AsyncReader.h"
+#include "Poco/Redis/AsyncClient.h"
 #include "Poco/Redis/Command.h"
 #include "Poco/Redis/PoolableConnectionFactory.h"
+#include "Poco/Runnable.h"
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include <iostream>
@@ -2925,6 +2927,179 @@ void RedisTest::testPool()
 }
 
 
+void RedisTest::testAsyncClient()
+{
+	if (!_connected)
+	{
+		std::cout << "Not connected, test skipped." << std::endl;
+		return;
+	}
+
+	delKey("myasynckey");
+
+	AsyncClient client(_host, _port);
+
+	AsyncClient::Result result1 = client.executeAsync(Command::set("myasynckey", "10"));
+	AsyncClient::Result result2 = client.executeAsync(Command::incr("myasynckey"));
+	AsyncClient::Result result3 = client.executeAsync(Command::get("myasynckey"));
+
+	result3.wait();
+	assert (result1.available());
+	assert (result2.available());
+	assert (AsyncClient::convert<std::string>(result1.data()) == "OK");
+	assert (AsyncClient::convert<Poco::Int64>(result2.data()) == 11);
+	assert (AsyncClient::convert<BulkString>(result3.data()).value() == "11");
+
+	client.execute<void>(Command::incr("myasynckey"));
+	assert (client.execute<Poco::Int64>(Command::incr("myasynckey")) == 13);
+
+	Array wrong;
+	wrong.add("Wrong Command");
+	try
+	{
+		client.execute<BulkString>(wrong);
+		fail("Invalid command must throw RedisException");
+	}
+	catch (RedisException&)
+	{
+	}
+	Array ping;
+	ping.add("PING");
+	assert (client.execute<std::string>(ping) == "PONG");
+
+	client.disconnect();
+	assert (!client.isConnected());
+	try
+	{
+		client.executeAsync(ping);
+		fail("must throw RedisException");
+	}
+	catch (RedisException&)
+	{
+	}
+}
+
+
+void RedisTest::testAsyncClientCallback()
+{
+	if (!_connected)
+	{
+		std::cout << "Not connected, test skipped." << std::endl;
+		return;
+	}
+
+	delKey("myasynccounter");
+	_asyncReplies.clear();
+
+	AsyncClient client(_host, _port);
+	for (int i = 0; i < 100; i++)
+	{
+		client.executeAsync(Command::incr("myasynccounter"), Poco::delegate(this, &RedisTest::onAsyncReply));
+	}
+	assert (client.execute<Poco::Int64>(Command::incr("myasynccounter")) == 101);
+
+	Poco::FastMutex::ScopedLock lock(_asyncMutex);
+	assert (_asyncReplies.size() == 100);
+	for (int i = 0; i < 100; i++)
+	{
+		assert (_asyncReplies[i] == i + 1);
+	}
+}
+
+
+namespace
+{
+	class AsyncIncrementer: public Poco::Runnable
+	{
+	public:
+		AsyncIncrementer(AsyncClient& client, int count):
+			_client(client),
+			_count(count)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _count; i++)
+			{
+				_client.execute<void>(Command::incr("myasyncconcurrent"));
+			}
+		}
+
+	private:
+		AsyncClient& _client;
+		int _count;
+	};
+}
+
+
+void RedisTest::testAsyncClientConcurrent()
+{
+	if (!_connected)
+	{
+		std::cout << "Not connected, test skipped." << std::endl;
+		return;
+	}
+
+	delKey("myasyncconcurrent");
+
+	AsyncClient client(_host, _port);
+	client.setMaxPending(64);
+
+	const int THREADS = 4;
+	const int COUNT = 1000;
+	AsyncIncrementer incrementer(client, COUNT);
+	Poco::Thread threads[THREADS];
+	for (int i = 0; i < THREADS; i++) threads[i].start(incrementer);
+	for (int i = 0; i < THREADS; i++) threads[i].join();
+
+	assert (client.execute<Poco::Int64>(Command::incr("myasyncconcurrent")) == THREADS*COUNT + 1);
+	assert (client.commandsSent() == THREADS*COUNT + 1);
+	assert (client.writes() <= client.commandsSent());
+	assert (client.pending() == 0);
+}
+
+
+void RedisTest::testAsyncPool()
+{
+	if (!_connected)
+	{
+		std::cout << "Not connected, test skipped." << std::endl;
+		return;
+	}
+
+	Poco::Net::SocketAddress sa(_host, _port);
+	Poco::PoolableObjectFactory<AsyncClient, AsyncClient::Ptr> factory(sa);
+	Poco::ObjectPool<AsyncClient, AsyncClient::Ptr> pool(factory, 10, 15);
+
+	delKey("myasyncpoolkey");
+
+	{
+		PooledAsyncConnection pclient1(pool);
+		PooledAsyncConnection pclient2(pool);
+		assert (pool.size() == 2);
+
+		std::string result = ((AsyncClient::Ptr) pclient1)->execute<std::string>(Command::set("myasyncpoolkey", "Hello"));
+		assert (result == "OK");
+
+		BulkString keyValue = ((AsyncClient::Ptr) pclient2)->execute<BulkString>(Command::get("myasyncpoolkey"));
+		assert (keyValue.value() == "Hello");
+
+		((AsyncClient::Ptr) pclient2)->disconnect();
+	}
+	// the disconnected client is not returned to the pool
+	assert (pool.size() == 1);
+}
+
+
+void RedisTest::onAsyncReply(const void* pSender, RedisEventArgs& args)
+{
+	Poco::FastMutex::ScopedLock lock(_asyncMutex);
+
+	if (args.message()) _asyncReplies.push_back(AsyncClient::convert<Poco::Int64>(args.message()));
+}
+
+
 void RedisTest::delKey(const std::string& key)
 {
 	Command delCommand = Command::del(key);
@@ -3002,6 +3177,10 @@ CppUnit::Test* RedisTest::suite()
 	CppUnit_addTest(pSuite, RedisTest, testRPOPLPUSH);
 	CppUnit_addTest(pSuite, RedisTest, testRPUSH);
 	CppUnit_addTest(pSuite, RedisTest, testPool);
+	CppUnit_addTest(pSuite, RedisTest, testAsyncClient);
+	CppUnit_addTest(pSuite, RedisTest, testAsyncClientCallback);
+	CppUnit_addTest(pSuite, RedisTest, testAsyncClientConcurrent);
+	CppUnit_addTest(pSuite, RedisTest, testAsyncPool);
 
 	return pSuite;
 }
@@ -16,7 +16,10 @@
 
 #include "Poco/Redis/Redis.h"
 #include "Poco/Redis/Client.h"
+#include "Poco/Redis/RedisEventArgs.h"
+#include "Poco/Mutex.h"
 #include "CppUnit/TestCase.h"
+#include <vector>
 
 
 class RedisTest: public CppUnit::TestCase
@@ -82,6 +85,10 @@ public:
 	void testRPUSH();
 
 	void testPool();
+	void testAsyncClient();
+	void testAsyncClientCallback();
+	void testAsyncClientConcurrent();
+	void testAsyncPool();
 
 	void setUp();
 	void tearDown();
@@ -91,6 +98,10 @@ public:
 private:
 
 	void delKey(const std::string& key);
+	void onAsyncReply(const void* pSender, Poco::Redis::RedisEventArgs& args);
+
+	std::vector<Poco::Int64> _asyncReplies;
+	Poco::FastMutex _asyncMutex;
 
 	std::string _host;
 	unsigned    _port;
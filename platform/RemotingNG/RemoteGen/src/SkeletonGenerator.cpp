@@ -90,6 +90,39 @@ void SkeletonGenerator::structStart(const Poco::CppParser::Struct* pStruct, cons
 	Poco::CodeGeneration::Utility::handleInclude(static_cast<const Poco::CppParser::Struct*>(pSym), _cppGen);
 	_cppGen.writeDefaultHeader(_pStruct, _pStruct->name(), _pStruct->getLibrary(), _pStruct->getPackage());
 
+	includeMethodTypeSerializers(pStruct);
+
+	_cppGen.addSrcIncludeFile("Poco/RemotingNG/MethodHandler.h");
+	_cppGen.addSrcIncludeFile("Poco/RemotingNG/ServerTransport.h");
+	_cppGen.addSrcIncludeFile("Poco/RemotingNG/Serializer.h");
+	_cppGen.addSrcIncludeFile("Poco/RemotingNG/Deserializer.h");
+	_cppGen.addSrcIncludeFile("Poco/RemotingNG/TypeSerializer.h");
+	_cppGen.addSrcIncludeFile("Poco/RemotingNG/TypeDeserializer.h");
+	_cppGen.addSrcIncludeFile("Poco/RemotingNG/RemotingException.h");
+	_cppGen.addSrcIncludeFile("Poco/SharedPtr.h");
+	_cppGen.writeIncludes();
+	_cppGen.writeNameSpaceBegin(nameSpace());
+
+	handleParentFunctions(pStruct);
+	checkForEventMembers(pStruct);
+}
+
+
+void SkeletonGenerator::includeMethodTypeSerializers(const Poco::CppParser::Struct* pStruct)
+{
+	// method handlers are also generated for inherited methods,
+	// so the serializers for their parameters are needed, too
+	Poco::CppParser::Struct::BaseIterator itB = pStruct->baseBegin();
+	Poco::CppParser::Struct::BaseIterator itBEnd = pStruct->baseEnd();
+	for (; itB != itBEnd; ++itB)
+	{
+		const Poco::CppParser::Struct* pParent = itB->pClass;
+		if (pParent && Utility::hasAnyRemoteProperty(pParent))
+		{
+			includeMethodTypeSerializers(pParent);
+		}
+	}
+
 	Poco::CodeGeneration::CodeGenerator::Properties classProperties;
 	Poco::CodeGeneration::GeneratorEngine::parseProperties(pStruct, classProperties);
 	Poco::CppParser::Struct::Functions functions;
@@ -107,20 +140,6 @@ void SkeletonGenerator::structStart(const Poco::CppParser::Struct* pStruct, cons
 			includeTypeSerializers(*it, false, false);
 		}
 	}
-
-	_cppGen.addSrcIncludeFile("Poco/RemotingNG/MethodHandler.h");
-	_cppGen.addSrcIncludeFile("Poco/RemotingNG/ServerTransport.h");
-	_cppGen.addSrcIncludeFile("Poco/RemotingNG/Serializer.h");
-	_cppGen.addSrcIncludeFile("Poco/RemotingNG/Deserializer.h");
-	_cppGen.addSrcIncludeFile("Poco/RemotingNG/TypeSerializer.h");
-	_cppGen.addSrcIncludeFile("Poco/RemotingNG/TypeDeserializer.h");
-	_cppGen.addSrcIncludeFile("Poco/RemotingNG/RemotingException.h");
-	_cppGen.addSrcIncludeFile("Poco/SharedPtr.h");
-	_cppGen.writeIncludes();
-	_cppGen.writeNameSpaceBegin(nameSpace());
-
-	handleParentFunctions(pStruct);
-	checkForEventMembers(pStruct);
 }
 
 
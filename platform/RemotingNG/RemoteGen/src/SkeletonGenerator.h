@@ -54,6 +54,9 @@ private:
 	void checkForEventMembers(const Poco::CppParser::Struct* pStruct);
 		/// checks if the class or any parent contains public BasicEvents
 
+	void includeMethodTypeSerializers(const Poco::CppParser::Struct* pStruct);
+		/// includes the type serializers for all remote methods of the class and its parents
+
 	const Poco::CppParser::Function* getCurrentFct() const;
 	bool currentFctHasOneWayProperty() const;
 
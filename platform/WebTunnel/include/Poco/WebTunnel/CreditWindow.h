@@ -0,0 +1,147 @@
+//
+// CreditWindow.h
+//
+// Library: WebTunnel
+// Package: WebTunnel
+// Module:  CreditWindow
+//
+// Definition of the CreditWindow class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef WebTunnel_CreditWindow_INCLUDED
+#define WebTunnel_CreditWindow_INCLUDED
+
+
+#include "Poco/WebTunnel/WebTunnel.h"
+#include "Poco/WebTunnel/Protocol.h"
+
+
+namespace Poco {
+namespace WebTunnel {
+
+
+class WebTunnel_API CreditWindow
+	/// CreditWindow does the credit accounting for a single channel
+	/// if flow control (Protocol::WT_CAP_FLOW_CONTROL) has been negotiated.
+	///
+	/// The send credit is the number of payload bytes that may still
+	/// be sent to the peer. Both peers start with Protocol::WT_INITIAL_CREDIT.
+	/// The send credit is decreased for every Data frame sent
+	/// (consume()) and increased by every Credit frame received (add()).
+	///
+	/// The receive window is the amount of credit a peer tries to keep
+	/// granted to the other peer. Received payload bytes are recorded with
+	/// received(). As soon as the credit held by the other peer has
+	/// dropped to half the window, grant() returns the credit needed
+	/// to fill up the window again.
+	///
+	/// CreditWindow is not thread safe. Callers must provide their
+	/// own synchronization.
+{
+public:
+	enum
+	{
+		MIN_WINDOW = 2*Protocol::WT_FRAME_MAX_SIZE,
+			/// The smallest allowed window size. The window must be large
+			/// enough to let the peer send at least one full frame
+			/// before more credit is granted.
+		MAX_CREDIT = 65535
+			/// The maximum credit that can be transferred in
+			/// a single Credit frame.
+	};
+
+	explicit CreditWindow(int window = Protocol::WT_INITIAL_CREDIT);
+		/// Creates the CreditWindow with the given receive window size.
+		///
+		/// Throws a Poco::InvalidArgumentException if window is
+		/// less than MIN_WINDOW.
+
+	~CreditWindow();
+		/// Destroys the CreditWindow.
+
+	int window() const;
+		/// Returns the receive window size.
+
+	int sendCredit() const;
+		/// Returns the current send credit.
+
+	void consume(int bytes);
+		/// Decreases the send credit by the given number of bytes sent.
+
+	void add(Poco::UInt16 credit);
+		/// Increases the send credit by the credit from a
+		/// Credit frame received from the peer.
+
+	void received(int bytes);
+		/// Records the given number of payload bytes received
+		/// from the peer.
+
+	int peerCredit() const;
+		/// Returns the credit currently held by the peer, i.e. the
+		/// number of bytes the peer may still send.
+
+	int grant();
+		/// Returns the credit to grant to the peer, or 0 if no credit
+		/// needs to be granted yet. The returned credit is counted as
+		/// granted.
+		///
+		/// The returned credit may exceed MAX_CREDIT if the window is
+		/// larger than Protocol::WT_INITIAL_CREDIT, in which case
+		/// it must be sent in multiple Credit frames.
+
+private:
+	int _window;
+	int _sendCredit;
+	int _peerCredit;
+};
+
+
+//
+// inlines
+//
+inline int CreditWindow::window() const
+{
+	return _window;
+}
+
+
+inline int CreditWindow::sendCredit() const
+{
+	return _sendCredit;
+}
+
+
+inline void CreditWindow::consume(int bytes)
+{
+	_sendCredit -= bytes;
+}
+
+
+inline void CreditWindow::add(Poco::UInt16 credit)
+{
+	_sendCredit += credit;
+}
+
+
+inline void CreditWindow::received(int bytes)
+{
+	_peerCredit -= bytes;
+}
+
+
+inline int CreditWindow::peerCredit() const
+{
+	return _peerCredit;
+}
+
+
+} } // namespace Poco::WebTunnel
+
+
+#endif // WebTunnel_CreditWindow_INCLUDED
@@ -0,0 +1,131 @@
+//
+// FrameCoalescer.h
+//
+// Library: WebTunnel
+// Package: WebTunnel
+// Module:  FrameCoalescer
+//
+// Definition of the FrameCoalescer class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef WebTunnel_FrameCoalescer_INCLUDED
+#define WebTunnel_FrameCoalescer_INCLUDED
+
+
+#include "Poco/WebTunnel/WebTunnel.h"
+#include "Poco/WebTunnel/Protocol.h"
+#include "Poco/Net/WebSocket.h"
+#include "Poco/Buffer.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+
+
+namespace Poco {
+namespace WebTunnel {
+
+
+class WebTunnel_API FrameCoalescer
+	/// Combines small WebTunnel frames, sent by different threads
+	/// for different channels over the same WebSocket, into
+	/// Multi-Record frames (see Protocol).
+	///
+	/// A thread that wants to send a frame first adds it to the current
+	/// batch. The thread that adds the first frame to an empty batch
+	/// becomes the owner of the batch and is responsible for sending it,
+	/// by calling flush() while holding the lock that serializes writes
+	/// to the WebSocket. Frames added by other threads while the owner
+	/// waits for that lock (or for an optional delay) go out with the
+	/// same WebSocket frame.
+	///
+	/// The batch is double-buffered, so that new frames can be added
+	/// while the previous batch is being sent.
+{
+public:
+	FrameCoalescer();
+		/// Creates the FrameCoalescer.
+
+	~FrameCoalescer();
+		/// Destroys the FrameCoalescer.
+
+	static bool canCoalesce(std::size_t frameSize);
+		/// Returns true if a frame of the given size can be
+		/// added to a batch.
+
+	bool add(const char* pFrame, std::size_t frameSize, bool& owner);
+		/// Adds the given frame to the current batch.
+		///
+		/// Returns false if there is not enough room left in the current
+		/// batch. In this case the caller must flush() the batch and send the
+		/// frame directly.
+		///
+		/// Otherwise, returns true and sets owner to true if the frame
+		/// is the first one in the batch.
+
+	void wait(long milliseconds);
+		/// Waits until the current batch is full, or until the given
+		/// time interval has expired.
+		///
+		/// Only a batch becoming full after the previous flush()
+		/// ends the wait early.
+
+	void flush(Poco::Net::WebSocket& webSocket);
+		/// Sends all frames in the current batch, as a single Multi-Record
+		/// frame, or as an ordinary frame if the batch contains a single frame.
+		///
+		/// Must be called while holding the lock used to serialize
+		/// sending frames over the WebSocket.
+
+	void send(Poco::Net::WebSocket& webSocket, const char* pFrame, std::size_t frameSize);
+		/// Flushes the current batch, then sends the given frame
+		/// as an ordinary WebSocket frame.
+		///
+		/// Must be called while holding the lock used to serialize
+		/// sending frames over the WebSocket.
+
+	Poco::UInt64 framesSent() const;
+		/// Returns the number of WebSocket frames sent by flush()
+		/// and send().
+
+	Poco::UInt64 recordsSent() const;
+		/// Returns the number of WebTunnel frames sent by flush()
+		/// and send().
+
+private:
+	FrameCoalescer(const FrameCoalescer&);
+	FrameCoalescer& operator = (const FrameCoalescer&);
+
+	enum
+	{
+		BATCH_SIZE = Protocol::WT_FRAME_MAX_SIZE + Protocol::WT_FRAME_HEADER_SIZE
+	};
+
+	Poco::Buffer<char> _pendingBuffer;
+	Poco::Buffer<char> _sendBuffer;
+	std::size_t _pendingSize;
+	int _pendingRecords;
+	Poco::UInt64 _framesSent;
+	Poco::UInt64 _recordsSent;
+	Poco::Event _full;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline bool FrameCoalescer::canCoalesce(std::size_t frameSize)
+{
+	return frameSize + Protocol::WT_RECORD_HEADER_SIZE + Protocol::WT_FRAME_HEADER_SIZE <= BATCH_SIZE;
+}
+
+
+} } // namespace Poco::WebTunnel
+
+
+#endif // WebTunnel_FrameCoalescer_INCLUDED
@@ -0,0 +1,77 @@
+//
+// FrameCompressor.h
+//
+// Library: WebTunnel
+// Package: WebTunnel
+// Module:  FrameCompressor
+//
+// Definition of the FrameCompressor class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef WebTunnel_FrameCompressor_INCLUDED
+#define WebTunnel_FrameCompressor_INCLUDED
+
+
+#include "Poco/WebTunnel/WebTunnel.h"
+#if defined(POCO_UNBUNDLED)
+#include <zlib.h>
+#else
+#include "Poco/zlib.h"
+#endif
+
+
+namespace Poco {
+namespace WebTunnel {
+
+
+class WebTunnel_API FrameCompressor
+	/// Compresses the payload of WebTunnel Data frames, using
+	/// raw deflate (RFC 1951).
+	///
+	/// Every frame is compressed independently (no shared
+	/// compression context between frames), so that frames can
+	/// be decompressed without any state carried over from previous
+	/// frames. This keeps memory usage per channel low and avoids
+	/// any dependency between channels sharing a decompressor.
+{
+public:
+	enum
+	{
+		MIN_COMPRESS_SIZE = 64
+			/// Payloads smaller than this are never compressed.
+	};
+
+	explicit FrameCompressor(int level = 6);
+		/// Creates the FrameCompressor with the given
+		/// compression level (1 - 9).
+
+	~FrameCompressor();
+		/// Destroys the FrameCompressor.
+
+	std::size_t compress(const char* pData, std::size_t size, char* pBuffer, std::size_t bufferSize);
+		/// Compresses size bytes from pData and writes the compressed
+		/// data to pBuffer.
+		///
+		/// Returns the size of the compressed data, or 0 if the
+		/// payload is too small to be worth compressing or if compression
+		/// would not reduce its size. In the latter case, the data
+		/// should be sent uncompressed.
+
+private:
+	FrameCompressor(const FrameCompressor&);
+	FrameCompressor& operator = (const FrameCompressor&);
+
+	z_stream _zstr;
+};
+
+
+} } // namespace Poco::WebTunnel
+
+
+#endif // WebTunnel_FrameCompressor_INCLUDED
@@ -0,0 +1,67 @@
+//
+// FrameDecompressor.h
+//
+// Library: WebTunnel
+// Package: WebTunnel
+// Module:  FrameDecompressor
+//
+// Definition of the FrameDecompressor class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef WebTunnel_FrameDecompressor_INCLUDED
+#define WebTunnel_FrameDecompressor_INCLUDED
+
+
+#include "Poco/WebTunnel/WebTunnel.h"
+#if defined(POCO_UNBUNDLED)
+#include <zlib.h>
+#else
+#include "Poco/zlib.h"
+#endif
+
+
+namespace Poco {
+namespace WebTunnel {
+
+
+class WebTunnel_API FrameDecompressor
+	/// Decompresses the payload of WebTunnel Data frames that have
+	/// been compressed by a FrameCompressor.
+{
+public:
+	FrameDecompressor();
+		/// Creates the FrameDecompressor.
+
+	~FrameDecompressor();
+		/// Destroys the FrameDecompressor.
+
+	std::size_t decompress(const char* pData, std::size_t size, char* pBuffer, std::size_t bufferSize);
+		/// Decompresses size bytes from pData and writes the
+		/// decompressed data to pBuffer.
+		///
+		/// Returns the size of the decompressed data.
+		///
+		/// Throws a DataFormatException if the data is corrupt, or if
+		/// the decompressed data does not fit into the buffer. As
+		/// a frame never carries more than Protocol::WT_FRAME_MAX_SIZE
+		/// bytes of payload, a buffer of that size is sufficient for
+		/// well-behaved peers.
+
+private:
+	FrameDecompressor(const FrameDecompressor&);
+	FrameDecompressor& operator = (const FrameDecompressor&);
+
+	z_stream _zstr;
+};
+
+
+} } // namespace Poco::WebTunnel
+
+
+#endif // WebTunnel_FrameDecompressor_INCLUDED
@@ -22,7 +22,13 @@
 #include "Poco/WebTunnel/SocketDispatcher.h"
 #include "Poco/WebTunnel/TunnelSocket.h"
 #include "Poco/WebTunnel/Protocol.h"
+#include "Poco/WebTunnel/FrameCompressor.h"
+#include "Poco/WebTunnel/FrameDecompressor.h"
+#include "Poco/WebTunnel/FrameCoalescer.h"
+#include "Poco/WebTunnel/CreditWindow.h"
 #include "Poco/Net/WebSocket.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPResponse.h"
 #include "Poco/SharedPtr.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/RefCountedObject.h"
@@ -53,8 +59,9 @@ public:
 	PortReflector(int threadCount, Poco::Timespan dispatcherTimeout = Poco::Timespan(5000), int maxReadsPerWorker = 10);
 		/// Creates the PortReflector, using the given number of worker threads.
 		///
-		/// The given dispatcherTimeout is used for the SocketDispatcher's main select loop, as well as
-		/// by workers to poll if more reads are possible, up to the given maximum number of reads per worker.
+		/// The given dispatcherTimeout is used for the SocketDispatcher's main select loop.
+		/// Workers keep reading from a socket as long as data is immediately available,
+		/// up to the given maximum number of reads per worker.
 
 	~PortReflector();
 		/// Destroys the PortReflector.
@@ -75,9 +82,14 @@ public:
 	TunnelSocket openTunnelSocket(const std::string& targetId, Poco::UInt16 targetPort);
 		/// Creates and returns a TunnelSocket for the given target and port number.
 
-	void addServerSocket(Poco::SharedPtr<Poco::Net::WebSocket> pWebSocket, const std::string& targetId);
+	void addServerSocket(Poco::SharedPtr<Poco::Net::WebSocket> pWebSocket, const std::string& targetId, int capabilities = Protocol::WT_CAP_NONE);
 		/// Adds a server WebSocket connection for forwarding to the given target device.
 		///
+		/// The given capabilities (see Protocol::Capabilities) must be the optional
+		/// protocol features negotiated with the target during the WebSocket handshake,
+		/// i.e. the value sent back in the X-WebTunnel-Capabilities response header.
+		/// See negotiateCapabilities().
+		///
 		/// The WebSocket will be managed by the PortReflector until closed by the peer.
 
 	void removeServerSocket(const std::string& targetId);
@@ -99,6 +111,47 @@ public:
 	Poco::Timespan getServerTimeout() const;
 		/// Returns the timeout for server/agent connections.
 
+	void setCoalescingDelay(Poco::Timespan delay);
+		/// Sets the maximum time a small Data frame is held back in order
+		/// to combine it with frames from other channels to the same target
+		/// into a single Multi-Record frame. Control frames are never held back.
+		///
+		/// The default is 0, which means that frames are only combined
+		/// while waiting for the target's WebSocket to become available.
+		/// The delay has a resolution of one millisecond.
+		///
+		/// Only effective for targets that have negotiated the
+		/// WT_CAP_MULTI_RECORD capability.
+
+	Poco::Timespan getCoalescingDelay() const;
+		/// Returns the maximum time a small Data frame is held back
+		/// for coalescing.
+
+	void setCreditWindow(int window);
+		/// Sets the receive window size for flow control, which is the
+		/// amount of credit granted to a target for each channel.
+		/// Only affects channels opened after the call.
+		///
+		/// The default is Protocol::WT_INITIAL_CREDIT.
+		///
+		/// Throws a Poco::InvalidArgumentException if window is less
+		/// than CreditWindow::MIN_WINDOW.
+		///
+		/// Only effective for targets that have negotiated the
+		/// WT_CAP_FLOW_CONTROL capability.
+
+	int getCreditWindow() const;
+		/// Returns the receive window size for flow control.
+
+	static int negotiateCapabilities(const Poco::Net::HTTPRequest& request, Poco::Net::HTTPResponse& response);
+		/// Determines the capabilities supported by both the PortReflector and
+		/// the target device, based on the X-WebTunnel-Capabilities header of the
+		/// target's WebSocket handshake request, and sets the corresponding header
+		/// in the response.
+		///
+		/// Must be called before the WebSocket is created from the request and response.
+		/// Returns the negotiated capabilities, which must be passed to addServerSocket().
+
 protected:
 	enum
 	{
@@ -121,13 +174,20 @@ protected:
 
 	enum
 	{
-		CONNECT_TIMEOUT = 60000
+		CONNECT_TIMEOUT = 60000,
+		CREDIT_TIMEOUT = 60000
 	};
 
 	struct ChannelInfo: public Poco::RefCountedObject
 	{
 		typedef Poco::AutoPtr<ChannelInfo> Ptr;
 
+		ChannelInfo():
+			suspended(false),
+			compressBuffer(Protocol::WT_FRAME_MAX_SIZE + Protocol::WT_FRAME_HEADER_SIZE)
+		{
+		}
+
 		ChannelState state;
 		Poco::Event stateChanged;
 		Poco::UInt16 channel;
@@ -135,6 +195,11 @@ protected:
 		Poco::FastMutex socketMutex;
 		Poco::SharedPtr<TunnelSocket> pTunnelSocket;
 		std::string initialMessage;
+		CreditWindow credit;
+		bool suspended;
+		Poco::Event creditChanged;
+		Poco::SharedPtr<FrameCompressor> pCompressor;
+		Poco::Buffer<char> compressBuffer;
 	};
 	typedef std::map<Poco::UInt16, ChannelInfo::Ptr> ChannelMap;
 
@@ -142,6 +207,12 @@ protected:
 	{
 		typedef Poco::AutoPtr<TargetInfo> Ptr;
 
+		TargetInfo():
+			capabilities(Protocol::WT_CAP_NONE),
+			decompressBuffer(Protocol::WT_FRAME_MAX_SIZE)
+		{
+		}
+
 		std::string id;
 		TargetState state;
 		ChannelMap channelMap;
@@ -149,6 +220,10 @@ protected:
 		Poco::SharedPtr<Poco::Net::WebSocket> pWebSocket;
 		Poco::FastMutex webSocketMutex;
 		Poco::FastMutex mutex;
+		int capabilities;
+		Poco::SharedPtr<FrameDecompressor> pDecompressor;
+		Poco::Buffer<char> decompressBuffer;
+		FrameCoalescer coalescer;
 	};
 
 	typedef std::map<std::string, TargetInfo::Ptr> TargetMap;
@@ -158,6 +233,7 @@ protected:
 	void multiplexError(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo, Poco::Buffer<char>& buffer);
 	void multiplexTimeout(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo, Poco::Buffer<char>& buffer);
 	bool demultiplex(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, TargetInfo::Ptr pTargetInfo, Poco::Buffer<char>& buffer);
+	bool demultiplexFrame(TargetInfo::Ptr pTargetInfo, const char* pFrame, std::size_t size);
 	void demultiplexError(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, TargetInfo::Ptr pTargetInfo, Poco::Buffer<char>& buffer);
 	void demultiplexTimeout(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, TargetInfo::Ptr pTargetInfo, Poco::Buffer<char>& buffer);
 
@@ -267,11 +343,20 @@ protected:
 	void confirmCloseChannel(TargetInfo::Ptr pTargetInfo, Poco::UInt16 channel, Poco::UInt16 errorCode = Protocol::WT_ERR_NONE);
 	bool forwardData(const char* buffer, std::size_t size, TargetInfo::Ptr pTargetInfo, Poco::UInt16 channel);
 	bool sendInitialMessage(TargetInfo::Ptr pTargetInfo, Poco::UInt16 channel);
+	void sendData(TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo, char* buffer, std::size_t headerSize, std::size_t size);
+	void sendFrame(TargetInfo::Ptr pTargetInfo, const char* pFrame, std::size_t size, bool urgent);
+	bool checkCredit(TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo, int& maxSize);
+	int waitCredit(TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo, int size);
+	void addCredit(TargetInfo::Ptr pTargetInfo, Poco::UInt16 channel, Poco::UInt16 credit);
+	void grantCredit(TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo, std::size_t size);
+	void initChannel(TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo);
 
 	SocketDispatcher _dispatcher;
 	TargetMap _targetMap;
 	Poco::Timespan _clientTimeout;
 	Poco::Timespan _serverTimeout;
+	Poco::Timespan _coalescingDelay;
+	int _creditWindow;
 	mutable Poco::FastMutex _mutex;
 	Poco::Logger& _logger;
 
@@ -304,6 +389,18 @@ inline Poco::Timespan PortReflector::getServerTimeout() const
 }
 
 
+inline Poco::Timespan PortReflector::getCoalescingDelay() const
+{
+	return _coalescingDelay;
+}
+
+
+inline int PortReflector::getCreditWindow() const
+{
+	return _creditWindow;
+}
+
+
 } } // namespace Poco::WebTunnel
 
 
@@ -20,6 +20,7 @@
 
 #include "Poco/WebTunnel/WebTunnel.h"
 #include <cstdlib>
+#include <string>
 
 
 namespace Poco {
@@ -89,6 +90,11 @@ class WebTunnel_API Protocol
 	///     |                                   |
 	///     +-----------------------------------+
 	///
+	/// If the WT_FLAG_DEFLATE flag is set, the data has been
+	/// compressed with raw deflate (RFC 1951). Each Data frame
+	/// is compressed independently. The flag must only be used
+	/// if the peer has announced the WT_CAP_DEFLATE capability.
+	///
 	/// 6. General Error
 	///
 	///     0        1        2        3
@@ -97,6 +103,55 @@ class WebTunnel_API Protocol
 	///     +--------+--------+--------+--------+
 	///     | Error Code      |
 	///     +-----------------+
+	///
+	/// 7. Credit
+	///
+	/// Grants the peer permission to send the given number of
+	/// additional payload bytes (uncompressed) over the channel.
+	/// Only used if both peers have announced the WT_CAP_FLOW_CONTROL
+	/// capability.
+	///
+	///     0        1        2        3
+	///     +--------+--------+--------+--------+
+	///     | 0x03   | 0x00   | Channel Number  |
+	///     +--------+--------+--------+--------+
+	///     | Credit          |
+	///     +-----------------+
+	///
+	/// 8. Multi-Record
+	///
+	/// Carries several complete frames (records) of types 1 - 7,
+	/// possibly for different channels, in a single WebSocket frame.
+	/// Each record is preceded by its size in bytes. Records must be
+	/// processed in order. Only used if both peers have announced the
+	/// WT_CAP_MULTI_RECORD capability. The total size of a Multi-Record
+	/// frame must not exceed WT_FRAME_MAX_SIZE + WT_FRAME_HEADER_SIZE.
+	///
+	///     0        1        2        3
+	///     +--------+--------+--------+--------+
+	///     | 0x04   | 0x00   | 0x00   | 0x00   |
+	///     +--------+--------+--------+--------+
+	///     | Record Size     | Record          |
+	///     +-----------------+                 |
+	///     |                                   |
+	///     +-----------------+-----------------+
+	///     | Record Size     | Record ...      |
+	///     +-----------------+-----------------+
+	///
+	/// Optional protocol features are negotiated when the WebSocket
+	/// connection is established. The initiating peer lists the
+	/// capabilities it supports in the X-WebTunnel-Capabilities
+	/// header of the WebSocket handshake request. The accepting peer
+	/// replies with the subset it supports in the same header of
+	/// the handshake response. A feature must only be used if it
+	/// has been confirmed in the response. Peers not supporting
+	/// negotiation simply ignore the header, in which case no
+	/// optional features are used.
+	///
+	/// With flow control, each side of a channel starts out with
+	/// WT_INITIAL_CREDIT bytes of credit. A sender must not send more
+	/// payload data than it has been granted credit for. A receiver
+	/// sends Credit frames as data is delivered to the local socket.
 {
 public:
 	enum Opcodes
@@ -106,6 +161,8 @@ public:
 		WT_OP_OPEN_CONFIRM    = 0x11,  /// Confirms channel has been opened.
 		WT_OP_OPEN_FAULT      = 0x81,  /// Error opening a channel.
 		WT_OP_CLOSE           = 0x02,  /// Close a channel (uncomfirmed).
+		WT_OP_CREDIT          = 0x03,  /// Grant send credit for a channel.
+		WT_OP_MULTI_RECORD    = 0x04,  /// Multiple frames combined into one.
 		WT_OP_ERROR           = 0x80   /// General error notification, closes a channel.
 	};
 
@@ -121,17 +178,38 @@ public:
 		WT_ERR_CHANNEL_IN_USE = 0x07   /// Channel is already in use.
 	};
 
+	enum Flags
+	{
+		WT_FLAG_DEFLATE       = 0x01   /// Data frame payload is deflate-compressed.
+	};
+
+	enum Capabilities
+	{
+		WT_CAP_NONE           = 0x00,  /// No optional features.
+		WT_CAP_FLOW_CONTROL   = 0x01,  /// Credit-based per-channel flow control.
+		WT_CAP_DEFLATE        = 0x02,  /// Per-message deflate compression of Data frames.
+		WT_CAP_MULTI_RECORD   = 0x04,  /// Multi-Record frames.
+		WT_CAP_ALL            = WT_CAP_FLOW_CONTROL | WT_CAP_DEFLATE | WT_CAP_MULTI_RECORD
+	};
+
 	enum
 	{
 		WT_FRAME_MAX_SIZE = 2048,
-		WT_FRAME_HEADER_SIZE = 4
+		WT_FRAME_HEADER_SIZE = 4,
+		WT_RECORD_HEADER_SIZE = 2,
+		WT_INITIAL_CREDIT = 65535
 	};
 
+	static const std::string X_WEBTUNNEL_CAPABILITIES;
+		/// The name of the HTTP header used to negotiate capabilities
+		/// ("X-WebTunnel-Capabilities").
+
 	static std::size_t writeHeader(char* pBuffer, std::size_t bufferSize, Poco::UInt8 opcode, Poco::UInt8 flags, Poco::UInt16 channel, Poco::UInt16 portOrErrorCode = 0);
 		/// Writes the protocol header to the given buffer, which must be of sufficient size
 		/// (at least 4 or 6 bytes, depending on opcode).
 		///
-		/// Flags are currently unused and should be 0.
+		/// Flags must be 0, except for Data frames, which
+		/// may specify WT_FLAG_DEFLATE.
 		///
 		/// Returns the size of the header in bytes.
 
@@ -139,6 +217,22 @@ public:
 		/// Reads the protocol header from the given buffer.
 		///
 		/// Returns the size of the header in bytes.
+
+	static std::size_t readRecordHeader(const char* pBuffer, std::size_t bufferSize, std::size_t& recordSize);
+		/// Reads the size of the next record in a Multi-Record frame
+		/// from the given buffer, which must start at the record header.
+		///
+		/// Returns the size of the record header in bytes, or 0 if
+		/// the buffer does not contain the complete record.
+
+	static std::string formatCapabilities(int capabilities);
+		/// Returns a comma-separated list of the names of the
+		/// given capabilities (e.g., "flow-control, deflate"),
+		/// suitable for the X-WebTunnel-Capabilities header.
+
+	static int parseCapabilities(const std::string& capabilities);
+		/// Parses the value of an X-WebTunnel-Capabilities header.
+		/// Unknown capability names are ignored.
 };
 
 
@@ -21,6 +21,10 @@
 #include "Poco/WebTunnel/WebTunnel.h"
 #include "Poco/WebTunnel/SocketDispatcher.h"
 #include "Poco/WebTunnel/Protocol.h"
+#include "Poco/WebTunnel/FrameCompressor.h"
+#include "Poco/WebTunnel/FrameDecompressor.h"
+#include "Poco/WebTunnel/FrameCoalescer.h"
+#include "Poco/WebTunnel/CreditWindow.h"
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/SocketAddress.h"
 #include "Poco/Net/WebSocket.h"
@@ -30,6 +34,7 @@
 #include "Poco/Buffer.h"
 #include "Poco/BasicEvent.h"
 #include "Poco/Mutex.h"
+#include "Poco/Condition.h"
 #include "Poco/Logger.h"
 #include <map>
 #include <set>
@@ -42,8 +47,28 @@ namespace WebTunnel {
 class WebTunnel_API RemotePortForwarder
 	/// This class forwards one or more ports to a remote host,
 	/// using a shared web socket for tunneling the data.
+	///
+	/// If negotiated with the reflector server (see Protocol), channels
+	/// use credit-based flow control and Data frames are compressed.
+	///
+	/// Every forwarded port can be assigned a priority class. If several
+	/// channels compete for the web socket, frames of higher priority
+	/// channels (e.g., an interactive SSH session) are sent before frames
+	/// of lower priority channels (e.g., a bulk file transfer).
+	///
+	/// If Multi-Record frames have been negotiated, small frames from
+	/// different channels that become ready at about the same time are
+	/// combined into a single WebSocket frame (see FrameCoalescer and
+	/// setCoalescingDelay()).
 {
 public:
+	enum Priority
+	{
+		PRIO_INTERACTIVE = 0, /// Latency-sensitive traffic (e.g., SSH, VNC input).
+		PRIO_NORMAL      = 1, /// Default priority.
+		PRIO_BULK        = 2  /// Throughput-oriented traffic (e.g., file transfers).
+	};
+
 	enum CloseReason
 	{
 		RPF_CLOSE_GRACEFUL   = 0, /// Graceful shutdown, initiated by peer.
@@ -59,11 +84,15 @@ public:
 		/// reason for the close. See the CloseReason
 		/// enum for values and their meanings.
 
-	RemotePortForwarder(SocketDispatcher& dispatcher, Poco::SharedPtr<Poco::Net::WebSocket> pWebSocket, const Poco::Net::IPAddress& host, const std::set<Poco::UInt16>& ports, Poco::Timespan remoteTimeout = Poco::Timespan(300, 0));
+	RemotePortForwarder(SocketDispatcher& dispatcher, Poco::SharedPtr<Poco::Net::WebSocket> pWebSocket, const Poco::Net::IPAddress& host, const std::set<Poco::UInt16>& ports, Poco::Timespan remoteTimeout = Poco::Timespan(300, 0), int capabilities = Protocol::WT_CAP_NONE);
 		/// Creates the RemotePortForwarder, using the given socket dispatcher and web socket,
 		/// which is used for tunneling data. Only the port numbers given in ports will
 		/// be forwarded. The web socket must have already been connected to the
 		/// reflector server.
+		///
+		/// The given capabilities (see Protocol::Capabilities) must be the optional
+		/// protocol features confirmed by the reflector server in the
+		/// X-WebTunnel-Capabilities header of the WebSocket handshake response.
 
 	~RemotePortForwarder();
 		/// Destroys the RemotePortForwarder and closes the web socket connection.
@@ -86,17 +115,137 @@ public:
 	const Poco::Timespan& remoteTimeout() const;
 		/// Returns the timeout for the remote connection.
 
+	int capabilities() const;
+		/// Returns the negotiated protocol capabilities.
+
+	void setPortPriority(Poco::UInt16 port, Priority priority);
+		/// Sets the priority class for channels to the given port.
+		/// Only affects channels opened after the call.
+
+	Priority getPortPriority(Poco::UInt16 port) const;
+		/// Returns the priority class for channels to the given port.
+		/// The default is PRIO_NORMAL.
+
+	void setCoalescingDelay(const Poco::Timespan& delay);
+		/// Sets the maximum time a small frame is held back in order
+		/// to combine it with frames from other channels into a single
+		/// Multi-Record frame. Frames from PRIO_INTERACTIVE channels are
+		/// never held back.
+		///
+		/// The default is 0, which means that frames are only combined
+		/// while waiting for the web socket to become available.
+		/// The delay has a resolution of one millisecond.
+		///
+		/// Only effective if the WT_CAP_MULTI_RECORD capability has been
+		/// negotiated.
+
+	const Poco::Timespan& getCoalescingDelay() const;
+		/// Returns the maximum time a small frame is held back
+		/// for coalescing.
+
+	void setCreditWindow(int window);
+		/// Sets the receive window size for flow control, which is the
+		/// amount of credit granted to the remote peer for each channel.
+		/// Only affects channels opened after the call.
+		///
+		/// The default is Protocol::WT_INITIAL_CREDIT. A larger window
+		/// increases throughput over connections with a high
+		/// bandwidth-delay product, but lets bulk channels queue more
+		/// data ahead of interactive ones.
+		///
+		/// Throws a Poco::InvalidArgumentException if window is less
+		/// than CreditWindow::MIN_WINDOW.
+		///
+		/// Only effective if the WT_CAP_FLOW_CONTROL capability has been
+		/// negotiated.
+
+	int getCreditWindow() const;
+		/// Returns the receive window size for flow control.
+
+	Poco::UInt64 framesSent() const;
+		/// Returns the number of WebSocket frames sent so far.
+
+	Poco::UInt64 recordsSent() const;
+		/// Returns the number of WebTunnel protocol frames sent so far.
+		/// Can be larger than framesSent() if Multi-Record frames
+		/// are used.
+
 protected:
-	bool multiplex(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, Poco::UInt16 channel, Poco::Buffer<char>& buffer);
+	class SendGate
+		/// Serializes sending frames over the web socket.
+		/// If several threads are waiting, the one with the
+		/// highest priority (lowest priority value) goes first.
+	{
+	public:
+		SendGate();
+		void acquire(int priority);
+		void release();
+
+		class ScopedLock
+		{
+		public:
+			ScopedLock(SendGate& gate, int priority):
+				_gate(gate)
+			{
+				_gate.acquire(priority);
+			}
+
+			~ScopedLock()
+			{
+				try
+				{
+					_gate.release();
+				}
+				catch (...)
+				{
+					poco_unexpected();
+				}
+			}
+
+		private:
+			SendGate& _gate;
+		};
+
+	private:
+		enum
+		{
+			PRIO_LEVELS = PRIO_BULK + 1
+		};
+
+		Poco::FastMutex _mutex;
+		Poco::Condition _released;
+		bool _busy;
+		int _waiting[PRIO_LEVELS];
+	};
+
+	struct ChannelInfo
+	{
+		ChannelInfo():
+			priority(PRIO_NORMAL),
+			suspended(false)
+		{
+		}
+
+		Poco::Net::StreamSocket socket;
+		Priority priority;
+		CreditWindow credit;
+		bool suspended;
+	};
+
+	bool multiplex(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, Poco::UInt16 channel, Priority priority, FrameCompressor* pCompressor, Poco::Buffer<char>& buffer, Poco::Buffer<char>& compressBuffer);
 	void multiplexError(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, Poco::UInt16 channel, Poco::Buffer<char>& buffer);
 	void multiplexTimeout(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, Poco::UInt16 channel, Poco::Buffer<char>& buffer);
 	bool demultiplex(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, Poco::Buffer<char>& buffer);
+	bool demultiplexFrame(const char* pFrame, std::size_t size);
 	void demultiplexError(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, Poco::Buffer<char>& buffer);
 	void demultiplexTimeout(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, Poco::Buffer<char>& buffer);
 	bool forwardData(const char* buffer, int size, Poco::UInt16 channel);
+	void addCredit(Poco::UInt16 channel, Poco::UInt16 credit);
+	void grantCredit(Poco::UInt16 channel, int size);
 	bool openChannel(Poco::UInt16 channel, Poco::UInt16 port);
 	void removeChannel(Poco::UInt16 channel);
 	void sendResponse(Poco::UInt16 channel, Poco::UInt8 opcode, Poco::UInt16 errorCode);
+	void sendFrame(const char* buffer, int length, int priority);
 	void closeWebSocket(CloseReason reason, bool active);
 	void pingWebSocket();
 
@@ -104,16 +253,22 @@ private:
 	class TunnelMultiplexer: public SocketDispatcher::SocketHandler
 	{
 	public:
-		TunnelMultiplexer(RemotePortForwarder& forwarder, Poco::UInt16 channel):
+		TunnelMultiplexer(RemotePortForwarder& forwarder, Poco::UInt16 channel, Priority priority, bool compress):
 			_forwarder(forwarder),
 			_channel(channel),
-			_buffer(Protocol::WT_FRAME_MAX_SIZE + Protocol::WT_FRAME_HEADER_SIZE)
+			_priority(priority),
+			_buffer(Protocol::WT_FRAME_MAX_SIZE + Protocol::WT_FRAME_HEADER_SIZE),
+			_compressBuffer(compress ? Protocol::WT_FRAME_MAX_SIZE + Protocol::WT_FRAME_HEADER_SIZE : 0)
 		{
+			if (compress)
+			{
+				_pCompressor = new FrameCompressor;
+			}
 		}
 
 		bool readable(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket)
 		{
-			return _forwarder.multiplex(dispatcher, socket, _channel, _buffer);
+			return _forwarder.multiplex(dispatcher, socket, _channel, _priority, _pCompressor.get(), _buffer, _compressBuffer);
 		}
 
 		void exception(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket)
@@ -129,7 +284,10 @@ private:
 	private:
 		RemotePortForwarder& _forwarder;
 		Poco::UInt16 _channel;
+		Priority _priority;
+		Poco::SharedPtr<FrameCompressor> _pCompressor;
 		Poco::Buffer<char> _buffer;
+		Poco::Buffer<char> _compressBuffer;
 	};
 
 	class TunnelDemultiplexer: public SocketDispatcher::SocketHandler
@@ -161,19 +319,27 @@ private:
 		Poco::Buffer<char> _buffer;
 	};
 
-	typedef std::map<Poco::UInt16, Poco::Net::StreamSocket> ChannelMap;
+	typedef std::map<Poco::UInt16, ChannelInfo> ChannelMap;
+	typedef std::map<Poco::UInt16, Priority> PriorityMap;
 
 	SocketDispatcher& _dispatcher;
 	Poco::SharedPtr<Poco::Net::WebSocket> _pWebSocket;
-	Poco::FastMutex _webSocketMutex;
+	SendGate _sendGate;
+	FrameCoalescer _coalescer;
+	Poco::Timespan _coalescingDelay;
+	int _creditWindow;
 	Poco::Net::IPAddress _host;
 	std::set<Poco::UInt16> _ports;
+	int _capabilities;
+	PriorityMap _priorities;
+	Poco::SharedPtr<FrameDecompressor> _pDecompressor;
+	Poco::Buffer<char> _decompressBuffer;
 	ChannelMap _channelMap;
 	Poco::Timespan _connectTimeout;
 	Poco::Timespan _localTimeout;
 	Poco::Timespan _remoteTimeout;
 	bool _timeoutCount;
-	Poco::FastMutex _mutex;
+	mutable Poco::FastMutex _mutex;
 	Poco::Logger& _logger;
 
 	RemotePortForwarder();
@@ -20,6 +20,7 @@
 
 #include "Poco/WebTunnel/WebTunnel.h"
 #include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/DatagramSocket.h"
 #include "Poco/Net/PollSet.h"
 #include "Poco/NotificationQueue.h"
 #include "Poco/Thread.h"
@@ -46,6 +47,11 @@ class WebTunnel_API SocketDispatcher
 	/// queue. A number of worker threads dequeue work queue items and
 	/// process the data received over the socket, using registered
 	/// SocketHandler instances.
+	///
+	/// Requests to add, remove, suspend or resume sockets are executed
+	/// by the main thread. To avoid having to wait for the select()
+	/// timeout, the main thread is woken up by sending a datagram to
+	/// a loopback UDP socket that is part of the poll set.
 {
 public:
 	class SocketHandler: public Poco::RefCountedObject
@@ -61,9 +67,10 @@ public:
 	SocketDispatcher(int threadCount, Poco::Timespan timeout = Poco::Timespan(5000), int maxReadsPerWorker = 10);
 		/// Creates the SocketDispatcher, using the given number of worker threads.
 		///
-		/// The given timeout is used for the main select loop, as well as
-		/// by workers to poll if more reads are possible, up to the given
-		/// maximum number of reads per worker.
+		/// The given timeout is used for the main select loop. Workers
+		/// keep reading from a socket as long as data is immediately
+		/// available and SocketHandler::readable() returns true, up to the
+		/// given maximum number of reads per worker.
 
 	~SocketDispatcher();
 		/// Destroys the SocketDispatcher.
@@ -77,6 +84,24 @@ public:
 	void closeSocket(const Poco::Net::StreamSocket& socket);
 		/// Closes and removes a socket and its associated handler from the SocketDispatcher.
 
+	void suspendSocket(const Poco::Net::StreamSocket& socket);
+		/// Stops polling the given socket for readability until
+		/// resumeSocket() is called. A suspended socket does not time out.
+		///
+		/// Can be called from within SocketHandler::readable() to
+		/// implement back pressure, e.g. if the peer the data is forwarded
+		/// to cannot accept more data at the moment.
+		///
+		/// Unlike the other requests, the request is executed asynchronously
+		/// and the method returns without waiting for the main thread.
+		/// It can therefore be called while holding a lock. Suspend and
+		/// resume requests are executed in the order they have been made.
+
+	void resumeSocket(const Poco::Net::StreamSocket& socket);
+		/// Resumes polling a socket previously suspended with suspendSocket().
+		///
+		/// The request is executed asynchronously, see suspendSocket().
+
 	void stop();
 		/// Stops the SocketDispatcher and removes all sockets.
 
@@ -92,7 +117,8 @@ protected:
 			pHandler(pHnd),
 			timeout(tmo),
 			wantRead(true),
-			polling(true)
+			polling(true),
+			suspended(false)
 		{
 		}
 
@@ -101,6 +127,7 @@ protected:
 		Poco::Clock activity;
 		bool wantRead;
 		bool polling;
+		bool suspended;
 	};
 
 	typedef std::map<Poco::Net::Socket, SocketInfo::Ptr> SocketMap;
@@ -112,12 +139,15 @@ protected:
 	void readable(const Poco::Net::StreamSocket& socket, const SocketInfo::Ptr& pInfo);
 	void exception(const Poco::Net::StreamSocket& socket, const SocketInfo::Ptr& pInfo);
 	void timeout(const Poco::Net::StreamSocket& socket, const SocketInfo::Ptr& pInfo);
+	void enqueueTask(Poco::Notification::Ptr pNf);
+	void wakeUp();
 	void readableImpl(Poco::Net::StreamSocket& socket, SocketInfo::Ptr pInfo);
 	void exceptionImpl(Poco::Net::StreamSocket& socket, SocketInfo::Ptr pInfo);
 	void timeoutImpl(Poco::Net::StreamSocket& socket, SocketInfo::Ptr pInfo);
 	void addSocketImpl(const Poco::Net::StreamSocket& socket, SocketHandler::Ptr pHandler, Poco::Timespan timeout);
 	void removeSocketImpl(const Poco::Net::StreamSocket& socket);
 	void closeSocketImpl(Poco::Net::StreamSocket& socket);
+	void suspendSocketImpl(const Poco::Net::StreamSocket& socket, bool suspend);
 	void resetImpl();
 
 private:
@@ -125,6 +155,7 @@ private:
 	int _maxReadsPerWorker;
 	SocketMap _socketMap;
 	Poco::Net::PollSet _pollSet;
+	Poco::Net::DatagramSocket _wakeUpSocket;
 	Poco::Thread _mainThread;
 	ThreadVec _workerThreads;
 	Poco::RunnableAdapter<SocketDispatcher> _mainRunnable;
@@ -140,6 +171,7 @@ private:
 	friend class AddSocketNotification;
 	friend class RemoveSocketNotification;
 	friend class CloseSocketNotification;
+	friend class SuspendSocketNotification;
 	friend class ResetNotification;
 };
 
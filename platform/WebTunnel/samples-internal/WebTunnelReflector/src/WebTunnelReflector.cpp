@@ -67,8 +67,9 @@ public:
 			if (proto == "com.appinf.webtunnel.server/1.0")
 			{
 				response.set("Sec-WebSocket-Protocol", proto);
+				int capabilities = Poco::WebTunnel::PortReflector::negotiateCapabilities(request, response);
 				pWebSocket = new Poco::Net::WebSocket(request, response);
-				_portReflector.addServerSocket(pWebSocket, "ac9667bb-6032-4267-af61-9a7aafd40479");
+				_portReflector.addServerSocket(pWebSocket, "ac9667bb-6032-4267-af61-9a7aafd40479", capabilities);
 			}
 			else if (proto == "com.appinf.webtunnel.client/1.0")
 			{
@@ -219,6 +220,7 @@ protected:
 			int threads = config().getInt("reflector.threads", 64);
 			
 			Poco::WebTunnel::PortReflector portReflector(threads);
+			portReflector.setCoalescingDelay(Poco::Timespan(static_cast<Poco::Timespan::TimeDiff>(config().getInt("reflector.coalescingDelay", 0))*1000));
 			
 			// set-up a server socket
 			ServerSocket svs(port);
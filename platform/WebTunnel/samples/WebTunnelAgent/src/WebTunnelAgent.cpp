@@ -9,6 +9,7 @@
 
 
 #include "Poco/WebTunnel/RemotePortForwarder.h"
+#include "Poco/WebTunnel/CreditWindow.h"
 #include "Poco/Net/HTTPSessionFactory.h"
 #include "Poco/Net/HTTPSessionInstantiator.h"
 #include "Poco/Net/HTTPClientSession.h"
@@ -90,6 +91,8 @@ public:
 		_useProxy(false),
 		_proxyPort(0),
 		_threads(8),
+		_capabilities(Poco::WebTunnel::Protocol::WT_CAP_NONE),
+		_creditWindow(Poco::WebTunnel::Protocol::WT_INITIAL_CREDIT),
 		_retryDelay(1000),
 		_status(STATUS_DISCONNECTED)
 	{
@@ -247,6 +250,10 @@ protected:
 			request.add("X-PTTH-Set-Property", Poco::format("device;name=\"%s\"", _deviceName));
 		}
 		request.set("User-Agent", _userAgent);
+		if (_capabilities != Poco::WebTunnel::Protocol::WT_CAP_NONE)
+		{
+			request.set(Poco::WebTunnel::Protocol::X_WEBTUNNEL_CAPABILITIES, Poco::WebTunnel::Protocol::formatCapabilities(_capabilities));
+		}
 		
 		Poco::Net::HTTPResponse response;
 		bool reconnect = true;
@@ -273,8 +280,23 @@ protected:
 				if (response.get(SEC_WEBSOCKET_PROTOCOL, "") == WEBTUNNEL_PROTOCOL)
 				{
 					logger().debug("WebSocket established. Creating RemotePortForwarder...");
+					int capabilities = _capabilities & Poco::WebTunnel::Protocol::parseCapabilities(response.get(Poco::WebTunnel::Protocol::X_WEBTUNNEL_CAPABILITIES, ""));
+					if (capabilities != Poco::WebTunnel::Protocol::WT_CAP_NONE)
+					{
+						logger().debug("Negotiated WebTunnel capabilities: " + Poco::WebTunnel::Protocol::formatCapabilities(capabilities));
+					}
 					_pDispatcher = new Poco::WebTunnel::SocketDispatcher(_threads);
-					_pForwarder = new Poco::WebTunnel::RemotePortForwarder(*_pDispatcher, pWebSocket, _host, _ports, _remoteTimeout);
+					_pForwarder = new Poco::WebTunnel::RemotePortForwarder(*_pDispatcher, pWebSocket, _host, _ports, _remoteTimeout, capabilities);
+					_pForwarder->setCoalescingDelay(_coalescingDelay);
+					_pForwarder->setCreditWindow(_creditWindow);
+					for (std::set<Poco::UInt16>::const_iterator it = _interactivePorts.begin(); it != _interactivePorts.end(); ++it)
+					{
+						_pForwarder->setPortPriority(*it, Poco::WebTunnel::RemotePortForwarder::PRIO_INTERACTIVE);
+					}
+					for (std::set<Poco::UInt16>::const_iterator it = _bulkPorts.begin(); it != _bulkPorts.end(); ++it)
+					{
+						_pForwarder->setPortPriority(*it, Poco::WebTunnel::RemotePortForwarder::PRIO_BULK);
+					}
 					_pForwarder->setConnectTimeout(_connectTimeout);
 					_pForwarder->setLocalTimeout(_localTimeout);
 					_pForwarder->webSocketClosed += Poco::delegate(this, &WebTunnelAgent::onClose);
@@ -454,6 +476,18 @@ protected:
 				_connectTimeout = Poco::Timespan(config().getInt("webtunnel.connectTimeout", 10), 0);
 				_remoteTimeout = Poco::Timespan(config().getInt("webtunnel.remoteTimeout", 300), 0);
 				_threads = config().getInt("webtunnel.threads", 8);
+				_capabilities = Poco::WebTunnel::Protocol::parseCapabilities(config().getString("webtunnel.capabilities", "multi-record"));
+				_coalescingDelay = Poco::Timespan(static_cast<Poco::Timespan::TimeDiff>(config().getInt("webtunnel.coalescingDelay", 0))*1000);
+				_creditWindow = config().getInt("webtunnel.creditWindow", Poco::WebTunnel::Protocol::WT_INITIAL_CREDIT);
+				if (_creditWindow < Poco::WebTunnel::CreditWindow::MIN_WINDOW)
+				{
+					logger().error(Poco::format("Specified creditWindow %d too small, must be at least %d.", _creditWindow, static_cast<int>(Poco::WebTunnel::CreditWindow::MIN_WINDOW)));
+					return Poco::Util::Application::EXIT_CONFIG;
+				}
+				if (!parsePorts(config().getString("webtunnel.interactivePorts", ""), _interactivePorts) || !parsePorts(config().getString("webtunnel.bulkPorts", ""), _bulkPorts))
+				{
+					return Poco::Util::Application::EXIT_CONFIG;
+				}
 				_httpPort = static_cast<Poco::UInt16>(config().getInt("webtunnel.httpPort", 0));
 				_vncPort = static_cast<Poco::UInt16>(config().getInt("webtunnel.vncPort", 0));
 				_userAgent = config().getString("webtunnel.userAgent", "");
@@ -534,6 +568,30 @@ protected:
 	static const std::string WEBTUNNEL_PROTOCOL;
 	static const std::string WEBTUNNEL_AGENT;
 	
+	bool parsePorts(const std::string& ports, std::set<Poco::UInt16>& portSet)
+	{
+		Poco::StringTokenizer tok(ports, ";,", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+		for (Poco::StringTokenizer::Iterator it = tok.begin(); it != tok.end(); ++it)
+		{
+			int port;
+			if (!Poco::NumberParser::tryParse(*it, port))
+			{
+				logger().error(Poco::format("Invalid port number specified in configuration: %s", *it));
+				return false;
+			}
+			else if (port > 0 && port < 65536)
+			{
+				portSet.insert(static_cast<Poco::UInt16>(port));
+			}
+			else
+			{
+				logger().error(Poco::format("Out-of-range port number specified in configuration: %d", port));
+				return false;
+			}
+		}
+		return true;
+	}
+
 private:
 	bool _helpRequested;
 	std::string _deviceName;
@@ -554,6 +612,11 @@ private:
 	Poco::Timespan _httpTimeout;
 	std::string _notifyExec;
 	int _threads;
+	int _capabilities;
+	Poco::Timespan _coalescingDelay;
+	int _creditWindow;
+	std::set<Poco::UInt16> _interactivePorts;
+	std::set<Poco::UInt16> _bulkPorts;
 	Poco::SharedPtr<Poco::WebTunnel::SocketDispatcher> _pDispatcher;
 	Poco::SharedPtr<Poco::WebTunnel::RemotePortForwarder> _pForwarder;
 	Poco::SharedPtr<Poco::Net::HTTPClientSession> _pHTTPClientSession;
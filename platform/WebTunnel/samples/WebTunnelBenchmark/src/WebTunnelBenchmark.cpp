@@ -0,0 +1,681 @@
+//
+// WebTunnelBenchmark.cpp
+//
+// A loopback benchmark for the WebTunnel library.
+//
+// Runs a PortReflector, a RemotePortForwarder and two target servers
+// (a bulk data source and an echo server) in a single process, all
+// connected over the loopback interface. A number of bulk channels
+// download data from the source server, while an interactive channel
+// measures round-trip times to the echo server at the same time.
+//
+// Optionally, a second phase runs a number of chatty channels, each
+// exchanging small request/response messages with the echo server,
+// to measure message rates, WebSocket frame counts (and thus the
+// effect of Multi-Record frames) and latency.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/WebTunnel/PortReflector.h"
+#include "Poco/WebTunnel/RemotePortForwarder.h"
+#include "Poco/WebTunnel/SocketDispatcher.h"
+#include "Poco/WebTunnel/Protocol.h"
+#include "Poco/WebTunnel/CreditWindow.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/TCPServer.h"
+#include "Poco/Net/TCPServerConnection.h"
+#include "Poco/Net/TCPServerConnectionFactory.h"
+#include "Poco/Net/TCPServerParams.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/WebSocket.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/Thread.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Random.h"
+#include "Poco/Buffer.h"
+#include "Poco/Event.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Format.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::OptionCallback;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using Poco::WebTunnel::Protocol;
+using Poco::WebTunnel::PortReflector;
+using Poco::WebTunnel::RemotePortForwarder;
+
+
+namespace
+{
+	const std::string TARGET_ID("benchmark");
+	const std::string WEBTUNNEL_PROTOCOL("com.appinf.webtunnel.server/1.0");
+	const std::size_t MESSAGE_SIZE = 32;
+	const int MAX_CHANNELS = 256;
+}
+
+
+class SourceConnection: public Poco::Net::TCPServerConnection
+	/// Sends a fixed amount of moderately compressible data
+	/// to the client, then closes the connection.
+{
+public:
+	SourceConnection(const Poco::Net::StreamSocket& socket, const std::string& data, Poco::UInt64 size):
+		Poco::Net::TCPServerConnection(socket),
+		_data(data),
+		_size(size)
+	{
+	}
+
+	void run()
+	{
+		Poco::UInt64 sent = 0;
+		try
+		{
+			while (sent < _size)
+			{
+				std::size_t n = _data.size();
+				if (n > _size - sent) n = static_cast<std::size_t>(_size - sent);
+				sent += socket().sendBytes(_data.data(), static_cast<int>(n));
+			}
+			socket().shutdownSend();
+		}
+		catch (Poco::Exception& exc)
+		{
+			std::cerr << "Source: " << exc.displayText() << std::endl;
+		}
+	}
+
+private:
+	const std::string& _data;
+	Poco::UInt64 _size;
+};
+
+
+class SourceConnectionFactory: public Poco::Net::TCPServerConnectionFactory
+{
+public:
+	SourceConnectionFactory(Poco::UInt64 size):
+		_size(size)
+	{
+		// Log-like text: compresses well, but not trivially.
+		static const char* words[] = {"GET", "POST", "/api/v1/devices", "/index.html", "200", "404", "OK", "sensor", "temperature", "humidity", "device", "connected", "timeout", "value"};
+		Poco::Random rnd;
+		rnd.seed(42);
+		while (_data.size() < 65536)
+		{
+			_data += Poco::format("%08u ", rnd.next());
+			for (int i = 0; i < 6; i++)
+			{
+				_data += words[rnd.next(sizeof(words)/sizeof(words[0]))];
+				_data += ' ';
+			}
+			_data += '\n';
+		}
+	}
+
+	Poco::Net::TCPServerConnection* createConnection(const Poco::Net::StreamSocket& socket)
+	{
+		return new SourceConnection(socket, _data, _size);
+	}
+
+private:
+	std::string _data;
+	Poco::UInt64 _size;
+};
+
+
+class EchoConnection: public Poco::Net::TCPServerConnection
+{
+public:
+	EchoConnection(const Poco::Net::StreamSocket& socket):
+		Poco::Net::TCPServerConnection(socket)
+	{
+	}
+
+	void run()
+	{
+		char buffer[256];
+		try
+		{
+			int n = socket().receiveBytes(buffer, sizeof(buffer));
+			while (n > 0)
+			{
+				socket().sendBytes(buffer, n);
+				n = socket().receiveBytes(buffer, sizeof(buffer));
+			}
+		}
+		catch (Poco::Exception&)
+		{
+		}
+	}
+};
+
+
+class EchoClient: public Poco::Runnable
+	/// Sends small messages over a tunneled echo channel, waiting
+	/// for every reply before sending the next message, until stopped.
+{
+public:
+	EchoClient(Poco::Net::StreamSocket& socket, Poco::Event& stop):
+		_socket(socket),
+		_stop(stop)
+	{
+	}
+
+	void run()
+	{
+		char message[MESSAGE_SIZE];
+		char reply[MESSAGE_SIZE];
+		std::memset(message, 'x', sizeof(message));
+		try
+		{
+			while (!_stop.tryWait(0))
+			{
+				Poco::Stopwatch sw;
+				sw.start();
+				_socket.sendBytes(message, sizeof(message));
+				std::size_t received = 0;
+				while (received < sizeof(reply))
+				{
+					int n = _socket.receiveBytes(reply + received, static_cast<int>(sizeof(reply) - received));
+					if (n <= 0) throw Poco::IOException("Echo channel closed");
+					received += n;
+				}
+				_rtts.push_back(sw.elapsed());
+			}
+		}
+		catch (Poco::Exception& exc)
+		{
+			std::cerr << "Chatty channel: " << exc.displayText() << std::endl;
+		}
+	}
+
+	const std::vector<Poco::Timestamp::TimeDiff>& rtts() const
+	{
+		return _rtts;
+	}
+
+private:
+	Poco::Net::StreamSocket& _socket;
+	Poco::Event& _stop;
+	std::vector<Poco::Timestamp::TimeDiff> _rtts;
+};
+
+
+class ReflectorRequestHandler: public Poco::Net::HTTPRequestHandler
+{
+public:
+	ReflectorRequestHandler(PortReflector& reflector):
+		_reflector(reflector)
+	{
+	}
+
+	void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
+	{
+		if (request.get("Sec-WebSocket-Protocol", "") == WEBTUNNEL_PROTOCOL)
+		{
+			response.set("Sec-WebSocket-Protocol", WEBTUNNEL_PROTOCOL);
+			int capabilities = PortReflector::negotiateCapabilities(request, response);
+			Poco::SharedPtr<Poco::Net::WebSocket> pWebSocket = new Poco::Net::WebSocket(request, response);
+			_reflector.addServerSocket(pWebSocket, TARGET_ID, capabilities);
+		}
+		else
+		{
+			response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_BAD_REQUEST);
+			response.setContentLength(0);
+			response.send();
+		}
+	}
+
+private:
+	PortReflector& _reflector;
+};
+
+
+class ReflectorRequestHandlerFactory: public Poco::Net::HTTPRequestHandlerFactory
+{
+public:
+	ReflectorRequestHandlerFactory(PortReflector& reflector):
+		_reflector(reflector)
+	{
+	}
+
+	Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest&)
+	{
+		return new ReflectorRequestHandler(_reflector);
+	}
+
+private:
+	PortReflector& _reflector;
+};
+
+
+class BulkReceiver: public Poco::Runnable
+	/// Reads everything from a tunneled bulk channel.
+{
+public:
+	BulkReceiver(PortReflector& reflector, Poco::UInt16 port):
+		_reflector(reflector),
+		_port(port),
+		_received(0)
+	{
+	}
+
+	void run()
+	{
+		try
+		{
+			Poco::Net::StreamSocket socket = _reflector.openTunnelSocket(TARGET_ID, _port);
+			socket.setReceiveTimeout(Poco::Timespan(30, 0));
+			Poco::Buffer<char> buffer(8192);
+			int n = socket.receiveBytes(buffer.begin(), static_cast<int>(buffer.size()));
+			while (n > 0)
+			{
+				_received += n;
+				n = socket.receiveBytes(buffer.begin(), static_cast<int>(buffer.size()));
+			}
+			socket.close();
+		}
+		catch (Poco::Exception& exc)
+		{
+			std::cerr << "Bulk channel: " << exc.displayText() << std::endl;
+		}
+	}
+
+	Poco::UInt64 received() const
+	{
+		return _received;
+	}
+
+private:
+	PortReflector& _reflector;
+	Poco::UInt16 _port;
+	Poco::UInt64 _received;
+};
+
+
+class WebTunnelBenchmark: public Application
+{
+public:
+	WebTunnelBenchmark():
+		_helpRequested(false),
+		_capabilities(Protocol::WT_CAP_ALL),
+		_priorities(true),
+		_bulkChannels(2),
+		_bulkSize(64),
+		_interval(10),
+		_chattyChannels(0),
+		_duration(5),
+		_coalescingDelay(0),
+		_creditWindow(Protocol::WT_INITIAL_CREDIT)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<WebTunnelBenchmark>(this, &WebTunnelBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("capabilities", "c", "Protocol capabilities to negotiate (comma-separated list of flow-control, deflate; or none). Default is all.")
+				.required(false)
+				.repeatable(false)
+				.argument("<list>")
+				.callback(OptionCallback<WebTunnelBenchmark>(this, &WebTunnelBenchmark::handleCapabilities)));
+
+		options.addOption(
+			Option("no-priorities", "P", "Do not assign priority classes to the bulk and interactive channels.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<WebTunnelBenchmark>(this, &WebTunnelBenchmark::handleNoPriorities)));
+
+		options.addOption(
+			Option("bulk-channels", "b", "Number of concurrent bulk channels (default 2).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(0, 64))
+				.binding("benchmark.bulkChannels"));
+
+		options.addOption(
+			Option("bulk-size", "s", "Megabytes transferred per bulk channel (default 64).")
+				.required(false)
+				.repeatable(false)
+				.argument("<mb>")
+				.validator(new IntValidator(1, 65536))
+				.binding("benchmark.bulkSize"));
+
+		options.addOption(
+			Option("interval", "i", "Interval between interactive messages in milliseconds (default 10).")
+				.required(false)
+				.repeatable(false)
+				.argument("<ms>")
+				.validator(new IntValidator(0, 10000))
+				.binding("benchmark.interval"));
+
+		options.addOption(
+			Option("chatty-channels", "e", "Number of concurrent chatty (small request/response) channels in the second phase (default 0, no second phase).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(0, 128))
+				.binding("benchmark.chattyChannels"));
+
+		options.addOption(
+			Option("duration", "d", "Duration of the second phase in seconds (default 5).")
+				.required(false)
+				.repeatable(false)
+				.argument("<s>")
+				.validator(new IntValidator(1, 3600))
+				.binding("benchmark.duration"));
+
+		options.addOption(
+			Option("coalescing-delay", "D", "Maximum time in milliseconds small frames are held back for coalescing (default 0).")
+				.required(false)
+				.repeatable(false)
+				.argument("<ms>")
+				.validator(new IntValidator(0, 1000))
+				.binding("benchmark.coalescingDelay"));
+
+		options.addOption(
+			Option("credit-window", "w", "Flow control receive window per channel in bytes (default 65535).")
+				.required(false)
+				.repeatable(false)
+				.argument("<bytes>")
+				.validator(new IntValidator(Poco::WebTunnel::CreditWindow::MIN_WINDOW, 64*1024*1024))
+				.binding("benchmark.creditWindow"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void handleCapabilities(const std::string& name, const std::string& value)
+	{
+		_capabilities = Protocol::parseCapabilities(value);
+	}
+
+	void handleNoPriorities(const std::string& name, const std::string& value)
+	{
+		_priorities = false;
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("Loopback benchmark for WebTunnel, measuring bulk throughput and interactive latency over a shared tunnel.");
+		helpFormatter.format(std::cout);
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		_bulkChannels = config().getInt("benchmark.bulkChannels", _bulkChannels);
+		_bulkSize = config().getInt("benchmark.bulkSize", _bulkSize);
+		_interval = config().getInt("benchmark.interval", _interval);
+		_chattyChannels = config().getInt("benchmark.chattyChannels", _chattyChannels);
+		_duration = config().getInt("benchmark.duration", _duration);
+		_coalescingDelay = config().getInt("benchmark.coalescingDelay", _coalescingDelay);
+		_creditWindow = config().getInt("benchmark.creditWindow", _creditWindow);
+
+		// The default thread pool is too small for all bulk and chatty channels.
+		Poco::ThreadPool serverThreadPool(2, 2*MAX_CHANNELS);
+		Poco::Net::TCPServerParams::Ptr pServerParams = new Poco::Net::TCPServerParams;
+		pServerParams->setMaxThreads(MAX_CHANNELS);
+
+		Poco::Net::ServerSocket sourceSocket(Poco::Net::SocketAddress("127.0.0.1", 0));
+		Poco::Net::TCPServer sourceServer(new SourceConnectionFactory(static_cast<Poco::UInt64>(_bulkSize)*1024*1024), serverThreadPool, sourceSocket, pServerParams);
+		sourceServer.start();
+
+		Poco::Net::ServerSocket echoSocket(Poco::Net::SocketAddress("127.0.0.1", 0));
+		Poco::Net::TCPServer echoServer(new Poco::Net::TCPServerConnectionFactoryImpl<EchoConnection>, serverThreadPool, echoSocket, pServerParams);
+		echoServer.start();
+
+		PortReflector reflector(8);
+		reflector.setCoalescingDelay(Poco::Timespan(static_cast<Poco::Timespan::TimeDiff>(_coalescingDelay)*1000));
+		reflector.setCreditWindow(_creditWindow);
+		Poco::Net::ServerSocket reflectorSocket(Poco::Net::SocketAddress("127.0.0.1", 0));
+		Poco::Net::HTTPServer reflectorServer(new ReflectorRequestHandlerFactory(reflector), reflectorSocket, new Poco::Net::HTTPServerParams);
+		reflectorServer.start();
+
+		Poco::UInt16 sourcePort = sourceSocket.address().port();
+		Poco::UInt16 echoPort = echoSocket.address().port();
+		std::set<Poco::UInt16> ports;
+		ports.insert(sourcePort);
+		ports.insert(echoPort);
+
+		Poco::Net::HTTPClientSession session("127.0.0.1", reflectorSocket.address().port());
+		Poco::Net::HTTPRequest request(Poco::Net::HTTPRequest::HTTP_POST, "/", Poco::Net::HTTPRequest::HTTP_1_1);
+		Poco::Net::HTTPResponse response;
+		request.set("Sec-WebSocket-Protocol", WEBTUNNEL_PROTOCOL);
+		if (_capabilities != Protocol::WT_CAP_NONE)
+		{
+			request.set(Protocol::X_WEBTUNNEL_CAPABILITIES, Protocol::formatCapabilities(_capabilities));
+		}
+		Poco::SharedPtr<Poco::Net::WebSocket> pWebSocket = new Poco::Net::WebSocket(session, request, response);
+		pWebSocket->setNoDelay(true);
+		int capabilities = _capabilities & Protocol::parseCapabilities(response.get(Protocol::X_WEBTUNNEL_CAPABILITIES, ""));
+
+		Poco::WebTunnel::SocketDispatcher dispatcher(4);
+		RemotePortForwarder forwarder(dispatcher, pWebSocket, Poco::Net::IPAddress("127.0.0.1"), ports, Poco::Timespan(300, 0), capabilities);
+		forwarder.setCoalescingDelay(Poco::Timespan(static_cast<Poco::Timespan::TimeDiff>(_coalescingDelay)*1000));
+		forwarder.setCreditWindow(_creditWindow);
+		if (_priorities)
+		{
+			forwarder.setPortPriority(sourcePort, RemotePortForwarder::PRIO_BULK);
+			forwarder.setPortPriority(echoPort, RemotePortForwarder::PRIO_INTERACTIVE);
+		}
+
+		// wait until the reflector has registered the target
+		for (int i = 0; i < 100 && reflector.countConnections() == 0; i++)
+		{
+			Poco::Thread::sleep(10);
+		}
+
+		std::cout << "Capabilities: " << (capabilities ? Protocol::formatCapabilities(capabilities) : std::string("none"))
+		          << ", priorities: " << (_priorities ? "on" : "off")
+		          << ", bulk channels: " << _bulkChannels << " x " << _bulkSize << " MB"
+		          << ", coalescing delay: " << _coalescingDelay << " ms"
+		          << ", credit window: " << _creditWindow << " bytes" << std::endl;
+
+		Poco::Net::StreamSocket echo = reflector.openTunnelSocket(TARGET_ID, echoPort);
+		echo.setReceiveTimeout(Poco::Timespan(30, 0));
+
+		std::vector<Poco::SharedPtr<BulkReceiver> > receivers;
+		std::vector<Poco::SharedPtr<Poco::Thread> > threads;
+		Poco::Stopwatch bulkTime;
+		bulkTime.start();
+		for (int i = 0; i < _bulkChannels; i++)
+		{
+			Poco::SharedPtr<BulkReceiver> pReceiver = new BulkReceiver(reflector, sourcePort);
+			Poco::SharedPtr<Poco::Thread> pThread = new Poco::Thread;
+			pThread->start(*pReceiver);
+			receivers.push_back(pReceiver);
+			threads.push_back(pThread);
+		}
+
+		std::vector<Poco::Timestamp::TimeDiff> rtts;
+		char message[MESSAGE_SIZE];
+		char reply[MESSAGE_SIZE];
+		std::memset(message, 'x', sizeof(message));
+		bool bulkRunning = true;
+		while (bulkRunning)
+		{
+			Poco::Stopwatch sw;
+			sw.start();
+			echo.sendBytes(message, sizeof(message));
+			std::size_t received = 0;
+			while (received < sizeof(reply))
+			{
+				int n = echo.receiveBytes(reply + received, static_cast<int>(sizeof(reply) - received));
+				if (n <= 0) throw Poco::IOException("Echo channel closed");
+				received += n;
+			}
+			rtts.push_back(sw.elapsed());
+
+			bulkRunning = false;
+			for (std::vector<Poco::SharedPtr<Poco::Thread> >::iterator it = threads.begin(); it != threads.end(); ++it)
+			{
+				if ((*it)->isRunning()) bulkRunning = true;
+			}
+			if (bulkRunning && _interval > 0) Poco::Thread::sleep(_interval);
+		}
+		bulkTime.stop();
+
+		Poco::UInt64 totalBytes = 0;
+		for (std::vector<Poco::SharedPtr<BulkReceiver> >::iterator it = receivers.begin(); it != receivers.end(); ++it)
+		{
+			totalBytes += (*it)->received();
+		}
+		for (std::vector<Poco::SharedPtr<Poco::Thread> >::iterator it = threads.begin(); it != threads.end(); ++it)
+		{
+			(*it)->join();
+		}
+
+		std::sort(rtts.begin(), rtts.end());
+		double seconds = static_cast<double>(bulkTime.elapsed())/Poco::Timestamp::resolution();
+		std::cout << Poco::format("Bulk: %Lu bytes in %.2f s (%.2f MB/s)", totalBytes, seconds, seconds > 0 ? totalBytes/seconds/(1024*1024) : 0.0) << std::endl;
+		printRTTs("Interactive", rtts);
+
+		if (_chattyChannels > 0)
+		{
+			runChatty(reflector, forwarder, echoPort);
+		}
+
+		echo.close();
+		forwarder.stop();
+		dispatcher.stop();
+		reflectorServer.stop();
+		echoServer.stop();
+		sourceServer.stop();
+
+		return Application::EXIT_OK;
+	}
+
+	void runChatty(PortReflector& reflector, RemotePortForwarder& forwarder, Poco::UInt16 echoPort)
+	{
+		std::vector<Poco::Net::StreamSocket> sockets;
+		for (int i = 0; i < _chattyChannels; i++)
+		{
+			sockets.push_back(reflector.openTunnelSocket(TARGET_ID, echoPort));
+			sockets.back().setReceiveTimeout(Poco::Timespan(30, 0));
+		}
+
+		Poco::Event stop(false);
+		std::vector<Poco::SharedPtr<EchoClient> > clients;
+		std::vector<Poco::SharedPtr<Poco::Thread> > threads;
+		Poco::UInt64 framesBefore = forwarder.framesSent();
+		Poco::UInt64 recordsBefore = forwarder.recordsSent();
+		Poco::Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < _chattyChannels; i++)
+		{
+			Poco::SharedPtr<EchoClient> pClient = new EchoClient(sockets[i], stop);
+			Poco::SharedPtr<Poco::Thread> pThread = new Poco::Thread;
+			pThread->start(*pClient);
+			clients.push_back(pClient);
+			threads.push_back(pThread);
+		}
+		Poco::Thread::sleep(_duration*1000);
+		stop.set();
+		for (std::vector<Poco::SharedPtr<Poco::Thread> >::iterator it = threads.begin(); it != threads.end(); ++it)
+		{
+			(*it)->join();
+		}
+		sw.stop();
+		Poco::UInt64 frames = forwarder.framesSent() - framesBefore;
+		Poco::UInt64 records = forwarder.recordsSent() - recordsBefore;
+
+		std::vector<Poco::Timestamp::TimeDiff> rtts;
+		for (std::vector<Poco::SharedPtr<EchoClient> >::iterator it = clients.begin(); it != clients.end(); ++it)
+		{
+			rtts.insert(rtts.end(), (*it)->rtts().begin(), (*it)->rtts().end());
+		}
+		std::sort(rtts.begin(), rtts.end());
+		double seconds = static_cast<double>(sw.elapsed())/Poco::Timestamp::resolution();
+		std::cout << Poco::format("Chatty: %d channels, %.0f messages/s, %.0f WebSocket frames/s from target (%.2f records/frame)",
+			_chattyChannels,
+			rtts.size()/seconds,
+			frames/seconds,
+			frames > 0 ? static_cast<double>(records)/frames : 0.0) << std::endl;
+		printRTTs("Chatty", rtts);
+
+		for (std::vector<Poco::Net::StreamSocket>::iterator it = sockets.begin(); it != sockets.end(); ++it)
+		{
+			it->close();
+		}
+	}
+
+	static void printRTTs(const std::string& label, const std::vector<Poco::Timestamp::TimeDiff>& rtts)
+		/// Prints statistics for the given sorted round-trip times.
+	{
+		if (!rtts.empty())
+		{
+			std::cout << Poco::format("%s: %z round trips, RTT min %.2f ms, median %.2f ms, p99 %.2f ms, max %.2f ms",
+				label,
+				rtts.size(),
+				rtts.front()/1000.0,
+				rtts[rtts.size()/2]/1000.0,
+				rtts[(rtts.size()*99)/100]/1000.0,
+				rtts.back()/1000.0) << std::endl;
+		}
+	}
+
+private:
+	bool _helpRequested;
+	int _capabilities;
+	bool _priorities;
+	int _bulkChannels;
+	int _bulkSize;
+	int _interval;
+	int _chattyChannels;
+	int _duration;
+	int _coalescingDelay;
+	int _creditWindow;
+};
+
+
+POCO_APP_MAIN(WebTunnelBenchmark)
@@ -0,0 +1,49 @@
+//
+// CreditWindow.cpp
+//
+// Library: WebTunnel
+// Package: WebTunnel
+// Module:  CreditWindow
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/WebTunnel/CreditWindow.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+namespace WebTunnel {
+
+
+CreditWindow::CreditWindow(int window):
+	_window(window),
+	_sendCredit(Protocol::WT_INITIAL_CREDIT),
+	_peerCredit(Protocol::WT_INITIAL_CREDIT)
+{
+	if (window < MIN_WINDOW) throw Poco::InvalidArgumentException("WebTunnel credit window too small");
+}
+
+
+CreditWindow::~CreditWindow()
+{
+}
+
+
+int CreditWindow::grant()
+{
+	if (_peerCredit <= _window/2)
+	{
+		int credit = _window - _peerCredit;
+		_peerCredit += credit;
+		return credit;
+	}
+	return 0;
+}
+
+
+} } // namespace Poco::WebTunnel
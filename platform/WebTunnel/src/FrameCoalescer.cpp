@@ -0,0 +1,132 @@
+//
+// FrameCoalescer.cpp
+//
+// Library: WebTunnel
+// Package: WebTunnel
+// Module:  FrameCoalescer
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/WebTunnel/FrameCoalescer.h"
+#include <cstring>
+
+
+namespace Poco {
+namespace WebTunnel {
+
+
+FrameCoalescer::FrameCoalescer():
+	_pendingBuffer(BATCH_SIZE),
+	_sendBuffer(BATCH_SIZE),
+	_pendingSize(Protocol::WT_FRAME_HEADER_SIZE),
+	_pendingRecords(0),
+	_framesSent(0),
+	_recordsSent(0)
+{
+	Protocol::writeHeader(_pendingBuffer.begin(), _pendingBuffer.size(), Protocol::WT_OP_MULTI_RECORD, 0, 0);
+	Protocol::writeHeader(_sendBuffer.begin(), _sendBuffer.size(), Protocol::WT_OP_MULTI_RECORD, 0, 0);
+}
+
+
+FrameCoalescer::~FrameCoalescer()
+{
+}
+
+
+bool FrameCoalescer::add(const char* pFrame, std::size_t frameSize, bool& owner)
+{
+	poco_assert (canCoalesce(frameSize));
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	if (_pendingSize + Protocol::WT_RECORD_HEADER_SIZE + frameSize > _pendingBuffer.size())
+	{
+		_full.set();
+		return false;
+	}
+	char* p = _pendingBuffer.begin() + _pendingSize;
+	p[0] = static_cast<char>((frameSize >> 8) & 0xFF);
+	p[1] = static_cast<char>(frameSize & 0xFF);
+	std::memcpy(p + Protocol::WT_RECORD_HEADER_SIZE, pFrame, frameSize);
+	_pendingSize += Protocol::WT_RECORD_HEADER_SIZE + frameSize;
+	owner = _pendingRecords++ == 0;
+	return true;
+}
+
+
+void FrameCoalescer::wait(long milliseconds)
+{
+	if (milliseconds > 0)
+	{
+		_full.tryWait(milliseconds);
+	}
+}
+
+
+void FrameCoalescer::flush(Poco::Net::WebSocket& webSocket)
+{
+	std::size_t size;
+	int records;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		if (_pendingRecords == 0) return;
+		_pendingBuffer.swap(_sendBuffer);
+		size = _pendingSize;
+		records = _pendingRecords;
+		_pendingSize = Protocol::WT_FRAME_HEADER_SIZE;
+		_pendingRecords = 0;
+		// A full signal for the batch just taken must not cut
+		// short the wait for the next batch.
+		_full.reset();
+		_framesSent++;
+		_recordsSent += records;
+	}
+	if (records == 1)
+	{
+		// no need for the Multi-Record wrapper
+		const std::size_t offset = Protocol::WT_FRAME_HEADER_SIZE + Protocol::WT_RECORD_HEADER_SIZE;
+		webSocket.sendFrame(_sendBuffer.begin() + offset, static_cast<int>(size - offset), Poco::Net::WebSocket::FRAME_BINARY);
+	}
+	else
+	{
+		webSocket.sendFrame(_sendBuffer.begin(), static_cast<int>(size), Poco::Net::WebSocket::FRAME_BINARY);
+	}
+}
+
+
+void FrameCoalescer::send(Poco::Net::WebSocket& webSocket, const char* pFrame, std::size_t frameSize)
+{
+	flush(webSocket);
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_framesSent++;
+		_recordsSent++;
+	}
+	webSocket.sendFrame(pFrame, static_cast<int>(frameSize), Poco::Net::WebSocket::FRAME_BINARY);
+}
+
+
+Poco::UInt64 FrameCoalescer::framesSent() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _framesSent;
+}
+
+
+Poco::UInt64 FrameCoalescer::recordsSent() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _recordsSent;
+}
+
+
+} } // namespace Poco::WebTunnel
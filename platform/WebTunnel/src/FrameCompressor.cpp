@@ -0,0 +1,61 @@
+//
+// FrameCompressor.cpp
+//
+// Library: WebTunnel
+// Package: WebTunnel
+// Module:  FrameCompressor
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/WebTunnel/FrameCompressor.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+namespace WebTunnel {
+
+
+FrameCompressor::FrameCompressor(int level)
+{
+	_zstr.zalloc    = Z_NULL;
+	_zstr.zfree     = Z_NULL;
+	_zstr.opaque    = Z_NULL;
+	_zstr.next_in   = 0;
+	_zstr.avail_in  = 0;
+	_zstr.next_out  = 0;
+	_zstr.avail_out = 0;
+
+	// negative window bits: raw deflate, no zlib header or checksum
+	int rc = deflateInit2(&_zstr, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+	if (rc != Z_OK) throw Poco::IOException(zError(rc));
+}
+
+
+FrameCompressor::~FrameCompressor()
+{
+	deflateEnd(&_zstr);
+}
+
+
+std::size_t FrameCompressor::compress(const char* pData, std::size_t size, char* pBuffer, std::size_t bufferSize)
+{
+	if (size < MIN_COMPRESS_SIZE) return 0;
+
+	deflateReset(&_zstr);
+	_zstr.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(pData));
+	_zstr.avail_in  = static_cast<uInt>(size);
+	_zstr.next_out  = reinterpret_cast<Bytef*>(pBuffer);
+	// only accept results that are actually smaller than the input
+	_zstr.avail_out = static_cast<uInt>(bufferSize < size ? bufferSize : size - 1);
+	int rc = deflate(&_zstr, Z_FINISH);
+	if (rc != Z_STREAM_END) return 0;
+	return static_cast<std::size_t>(_zstr.total_out);
+}
+
+
+} } // namespace Poco::WebTunnel
@@ -0,0 +1,63 @@
+//
+// FrameDecompressor.cpp
+//
+// Library: WebTunnel
+// Package: WebTunnel
+// Module:  FrameDecompressor
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/WebTunnel/FrameDecompressor.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+namespace WebTunnel {
+
+
+FrameDecompressor::FrameDecompressor()
+{
+	_zstr.zalloc    = Z_NULL;
+	_zstr.zfree     = Z_NULL;
+	_zstr.opaque    = Z_NULL;
+	_zstr.next_in   = 0;
+	_zstr.avail_in  = 0;
+	_zstr.next_out  = 0;
+	_zstr.avail_out = 0;
+
+	int rc = inflateInit2(&_zstr, -MAX_WBITS);
+	if (rc != Z_OK) throw Poco::IOException(zError(rc));
+}
+
+
+FrameDecompressor::~FrameDecompressor()
+{
+	inflateEnd(&_zstr);
+}
+
+
+std::size_t FrameDecompressor::decompress(const char* pData, std::size_t size, char* pBuffer, std::size_t bufferSize)
+{
+	inflateReset(&_zstr);
+	_zstr.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(pData));
+	_zstr.avail_in  = static_cast<uInt>(size);
+	_zstr.next_out  = reinterpret_cast<Bytef*>(pBuffer);
+	_zstr.avail_out = static_cast<uInt>(bufferSize);
+	int rc = inflate(&_zstr, Z_FINISH);
+	if (rc != Z_STREAM_END)
+	{
+		if (rc == Z_BUF_ERROR && _zstr.avail_out == 0)
+			throw Poco::DataFormatException("Decompressed frame exceeds maximum size");
+		else
+			throw Poco::DataFormatException("Corrupt compressed frame", _zstr.msg ? std::string(_zstr.msg) : std::string());
+	}
+	return static_cast<std::size_t>(_zstr.total_out);
+}
+
+
+} } // namespace Poco::WebTunnel
@@ -35,6 +35,7 @@ void shutdownSocket(Poco::Net::StreamSocket& socket, Poco::UInt16 statusCode)
 
 PortReflector::PortReflector(int threadCount, Poco::Timespan dispatcherTimeout, int maxReadsPerWorker):
 	_dispatcher(threadCount, dispatcherTimeout, maxReadsPerWorker),
+	_creditWindow(Protocol::WT_INITIAL_CREDIT),
 	_logger(Poco::Logger::get("WebTunnel.PortReflector"))
 {
 }
@@ -87,6 +88,7 @@ void PortReflector::addWebSocket(Poco::SharedPtr<Poco::Net::WebSocket> pWebSocke
 		pChannelInfo->channel = channel;
 		pChannelInfo->pSocket = pWebSocket;
 		pChannelInfo->pTunnelSocket = 0;
+		initChannel(pTargetInfo, pChannelInfo);
 		pTargetInfo->channelMap[channel] = pChannelInfo;
 		if (_logger.debug())
 		{
@@ -133,6 +135,7 @@ void PortReflector::addStreamSocket(Poco::SharedPtr<Poco::Net::StreamSocket> pSt
 		pChannelInfo->pSocket = pStreamSocket;
 		pChannelInfo->pTunnelSocket = 0;
 		pChannelInfo->initialMessage = initialMessage;
+		initChannel(pTargetInfo, pChannelInfo);
 		pTargetInfo->channelMap[channel] = pChannelInfo;
 		if (_logger.debug())
 		{
@@ -178,6 +181,7 @@ TunnelSocket PortReflector::openTunnelSocket(const std::string& targetId, Poco::
 		pChannelInfo->state = CS_CONNECTING;
 		pChannelInfo->channel = channel;
 		pChannelInfo->pTunnelSocket = new TunnelSocket(new TunnelSocketImpl(*this, pTargetInfo, pChannelInfo));
+		initChannel(pTargetInfo, pChannelInfo);
 		pTargetInfo->channelMap[channel] = pChannelInfo;
 		if (_logger.debug())
 		{
@@ -193,11 +197,11 @@ TunnelSocket PortReflector::openTunnelSocket(const std::string& targetId, Poco::
 }
 
 
-void PortReflector::addServerSocket(Poco::SharedPtr<Poco::Net::WebSocket> pWebSocket, const std::string& targetId)
+void PortReflector::addServerSocket(Poco::SharedPtr<Poco::Net::WebSocket> pWebSocket, const std::string& targetId, int capabilities)
 {
 	if (_logger.information())
 	{
-		_logger.information(Poco::format("Adding server connection to target %s", targetId));
+		_logger.information(Poco::format("Adding server connection to target %s (capabilities: %s)", targetId, capabilities ? Protocol::formatCapabilities(capabilities) : std::string("none")));
 	}
 	{
 		Poco::FastMutex::ScopedLock lock(_mutex);
@@ -214,6 +218,11 @@ void PortReflector::addServerSocket(Poco::SharedPtr<Poco::Net::WebSocket> pWebSo
 		pTargetInfo->id = targetId;
 		pTargetInfo->state = TS_CONNECTED;
 		pTargetInfo->lastChannel = 0;
+		pTargetInfo->capabilities = capabilities;
+		if (capabilities & Protocol::WT_CAP_DEFLATE)
+		{
+			pTargetInfo->pDecompressor = new FrameDecompressor;
+		}
 		_targetMap[targetId] = pTargetInfo;
 		_dispatcher.addSocket(*pWebSocket, new TunnelDemultiplexer(*this, pTargetInfo), _serverTimeout);
 	}
@@ -251,16 +260,43 @@ void PortReflector::setServerTimeout(Poco::Timespan timeout)
 }
 
 
+void PortReflector::setCoalescingDelay(Poco::Timespan delay)
+{
+	_coalescingDelay = delay;
+}
+
+
+void PortReflector::setCreditWindow(int window)
+{
+	if (window < CreditWindow::MIN_WINDOW) throw Poco::InvalidArgumentException("WebTunnel credit window too small");
+
+	_creditWindow = window;
+}
+
+
+int PortReflector::negotiateCapabilities(const Poco::Net::HTTPRequest& request, Poco::Net::HTTPResponse& response)
+{
+	int capabilities = Protocol::parseCapabilities(request.get(Protocol::X_WEBTUNNEL_CAPABILITIES, "")) & Protocol::WT_CAP_ALL;
+	if (request.has(Protocol::X_WEBTUNNEL_CAPABILITIES))
+	{
+		response.set(Protocol::X_WEBTUNNEL_CAPABILITIES, Protocol::formatCapabilities(capabilities));
+	}
+	return capabilities;
+}
+
+
 bool PortReflector::multiplexWebSocket(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo, Poco::Buffer<char>& buffer)
 {
 	bool expectMore = true;
 	Poco::Net::WebSocket webSocket(socket);
 	std::size_t hn = Protocol::writeHeader(buffer.begin(), buffer.size(), Protocol::WT_OP_DATA, 0, pChannelInfo->channel);
+	int maxSize = static_cast<int>(buffer.size() - hn);
+	if (!checkCredit(pTargetInfo, pChannelInfo, maxSize)) return false;
 	int n = 0;
 	try
 	{
 		int flags;
-		n = webSocket.receiveFrame(buffer.begin() + hn, static_cast<int>(buffer.size() - hn), flags);
+		n = webSocket.receiveFrame(buffer.begin() + hn, maxSize, flags);
 		if (n >= 0 && (flags & Poco::Net::WebSocket::FRAME_OP_BITMASK) == Poco::Net::WebSocket::FRAME_OP_PING)
 		{
 			_logger.debug("PING received from client");
@@ -313,8 +349,7 @@ bool PortReflector::multiplexWebSocket(SocketDispatcher& dispatcher, Poco::Net::
 
 	try
 	{
-		Poco::FastMutex::ScopedLock lock(pTargetInfo->webSocketMutex);
-		pTargetInfo->pWebSocket->sendFrame(buffer.begin(), static_cast<int>(n + hn), Poco::Net::WebSocket::FRAME_BINARY);
+		sendData(pTargetInfo, pChannelInfo, buffer.begin(), hn, n);
 	}
 	catch (Poco::Exception& exc)
 	{
@@ -330,10 +365,12 @@ bool PortReflector::multiplexStreamSocket(SocketDispatcher& dispatcher, Poco::Ne
 {
 	bool expectMore = true;
 	std::size_t hn = Protocol::writeHeader(buffer.begin(), buffer.size(), Protocol::WT_OP_DATA, 0, pChannelInfo->channel);
+	int maxSize = static_cast<int>(buffer.size() - hn);
+	if (!checkCredit(pTargetInfo, pChannelInfo, maxSize)) return false;
 	int n = 0;
 	try
 	{
-		n = socket.receiveBytes(buffer.begin() + hn, static_cast<int>(buffer.size() - hn));
+		n = socket.receiveBytes(buffer.begin() + hn, maxSize);
 		if (n == 0)
 		{
 			_logger.debug("Client StreamSocket closed by peer");
@@ -379,8 +416,7 @@ bool PortReflector::multiplexStreamSocket(SocketDispatcher& dispatcher, Poco::Ne
 
 	try
 	{
-		Poco::FastMutex::ScopedLock lock(pTargetInfo->webSocketMutex);
-		pTargetInfo->pWebSocket->sendFrame(buffer.begin(), static_cast<int>(n + hn), Poco::Net::WebSocket::FRAME_BINARY);
+		sendData(pTargetInfo, pChannelInfo, buffer.begin(), hn, n);
 	}
 	catch (Poco::Exception& exc)
 	{
@@ -440,45 +476,31 @@ bool PortReflector::demultiplex(SocketDispatcher& dispatcher, Poco::Net::StreamS
 	}
 	else if (n > 0 && (wsFlags & Poco::Net::WebSocket::FRAME_OP_BITMASK) == Poco::Net::WebSocket::FRAME_OP_BINARY)
 	{
-		Poco::UInt8 opcode;
-		Poco::UInt8 flags;
-		Poco::UInt16 channel;
-		Poco::UInt16 portOrErrorCode;
-		std::size_t hn = Protocol::readHeader(buffer.begin(), buffer.size(), opcode, flags, channel, &portOrErrorCode);
-		switch (opcode)
+		Poco::UInt8 opcode = 0;
+		Poco::UInt8 flags = 0;
+		Poco::UInt16 channel = 0;
+		std::size_t hn = Protocol::readHeader(buffer.begin(), n, opcode, flags, channel);
+		if (opcode == Protocol::WT_OP_MULTI_RECORD && (pTargetInfo->capabilities & Protocol::WT_CAP_MULTI_RECORD))
 		{
-		case Protocol::WT_OP_DATA:
-			return forwardData(buffer.begin() + hn, n - hn, pTargetInfo, channel);
-			return true;
-
-		case Protocol::WT_OP_OPEN_CONFIRM:
-			if (confirmOpenChannel(pTargetInfo, channel))
-				return sendInitialMessage(pTargetInfo, channel);
-			else
-				return false;
-
-		case Protocol::WT_OP_OPEN_FAULT:
-			_logger.error(Poco::format("Failed to open channel %hu (status code %hu)", channel, portOrErrorCode));
-			confirmCloseChannel(pTargetInfo, channel, portOrErrorCode);
-			return false;
-
-		case Protocol::WT_OP_CLOSE:
-			confirmCloseChannel(pTargetInfo, channel);
-			return false;
-
-		case Protocol::WT_OP_ERROR:
-			if (_logger.debug())
+			const char* pRecord = buffer.begin() + hn;
+			std::size_t remaining = n - hn;
+			while (remaining > 0 && pTargetInfo->state == TS_CONNECTED)
 			{
-				_logger.debug(Poco::format("Status %hu reported by peer. Closing channel %hu.", portOrErrorCode, channel));
+				std::size_t recordSize = 0;
+				std::size_t rhn = Protocol::readRecordHeader(pRecord, remaining, recordSize);
+				if (rhn == 0)
+				{
+					_logger.error(Poco::format("Invalid WebSocket frame received from target %s (truncated record).", pTargetInfo->id));
+					removeTarget(pTargetInfo);
+					return false;
+				}
+				demultiplexFrame(pTargetInfo, pRecord + rhn, recordSize);
+				pRecord += rhn + recordSize;
+				remaining -= rhn + recordSize;
 			}
-			confirmCloseChannel(pTargetInfo, channel, portOrErrorCode);
-			return false;
-
-		default:
-			_logger.error(Poco::format("Invalid WebSocket frame received (bad channel opcode: %hu).", static_cast<Poco::UInt16>(opcode)));
-			removeTarget(pTargetInfo);
-			return false;
+			return true;
 		}
+		return demultiplexFrame(pTargetInfo, buffer.begin(), n);
 	}
 	else if (n <= 0 || (wsFlags & Poco::Net::WebSocket::FRAME_OP_BITMASK) == Poco::Net::WebSocket::FRAME_OP_CLOSE)
 	{
@@ -497,6 +519,80 @@ bool PortReflector::demultiplex(SocketDispatcher& dispatcher, Poco::Net::StreamS
 }
 
 
+bool PortReflector::demultiplexFrame(TargetInfo::Ptr pTargetInfo, const char* pFrame, std::size_t size)
+{
+	Poco::UInt8 opcode = 0;
+	Poco::UInt8 flags = 0;
+	Poco::UInt16 channel = 0;
+	Poco::UInt16 portOrErrorCode = 0;
+	std::size_t hn = Protocol::readHeader(pFrame, size, opcode, flags, channel, &portOrErrorCode);
+	if (hn > size)
+	{
+		_logger.error(Poco::format("Invalid WebSocket frame received from target %s (truncated header).", pTargetInfo->id));
+		removeTarget(pTargetInfo);
+		return false;
+	}
+	switch (opcode)
+	{
+	case Protocol::WT_OP_DATA:
+		if (flags & Protocol::WT_FLAG_DEFLATE)
+		{
+			if (!pTargetInfo->pDecompressor)
+			{
+				_logger.error(Poco::format("Received compressed data for channel %hu on target %s, but compression has not been negotiated", channel, pTargetInfo->id));
+				removeTarget(pTargetInfo);
+				return false;
+			}
+			std::size_t dn = 0;
+			try
+			{
+				dn = pTargetInfo->pDecompressor->decompress(pFrame + hn, size - hn, pTargetInfo->decompressBuffer.begin(), pTargetInfo->decompressBuffer.size());
+			}
+			catch (Poco::Exception& exc)
+			{
+				_logger.error(Poco::format("Invalid compressed data for channel %hu on target %s: %s", channel, pTargetInfo->id, exc.displayText()));
+				removeTarget(pTargetInfo);
+				return false;
+			}
+			return forwardData(pTargetInfo->decompressBuffer.begin(), dn, pTargetInfo, channel);
+		}
+		return forwardData(pFrame + hn, size - hn, pTargetInfo, channel);
+
+	case Protocol::WT_OP_CREDIT:
+		addCredit(pTargetInfo, channel, portOrErrorCode);
+		return true;
+
+	case Protocol::WT_OP_OPEN_CONFIRM:
+		if (confirmOpenChannel(pTargetInfo, channel))
+			return sendInitialMessage(pTargetInfo, channel);
+		else
+			return false;
+
+	case Protocol::WT_OP_OPEN_FAULT:
+		_logger.error(Poco::format("Failed to open channel %hu (status code %hu)", channel, portOrErrorCode));
+		confirmCloseChannel(pTargetInfo, channel, portOrErrorCode);
+		return false;
+
+	case Protocol::WT_OP_CLOSE:
+		confirmCloseChannel(pTargetInfo, channel);
+		return false;
+
+	case Protocol::WT_OP_ERROR:
+		if (_logger.debug())
+		{
+			_logger.debug(Poco::format("Status %hu reported by peer. Closing channel %hu.", portOrErrorCode, channel));
+		}
+		confirmCloseChannel(pTargetInfo, channel, portOrErrorCode);
+		return false;
+
+	default:
+		_logger.error(Poco::format("Invalid WebSocket frame received (bad channel opcode: %hu).", static_cast<Poco::UInt16>(opcode)));
+		removeTarget(pTargetInfo);
+		return false;
+	}
+}
+
+
 void PortReflector::demultiplexError(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, TargetInfo::Ptr pTargetInfo, Poco::Buffer<char>& buffer)
 {
 	_logger.error(Poco::format("Error reading from target %s", pTargetInfo->id));
@@ -527,6 +623,7 @@ bool PortReflector::abortTarget(TargetInfo::Ptr pTargetInfo)
 				{
 					it->second->state = CS_DISCONNECTED;
 					it->second->stateChanged.set();
+					it->second->creditChanged.set();
 					Poco::FastMutex::ScopedLock lock(it->second->socketMutex);
 					shutdownSocket(*it->second->pSocket, Poco::Net::WebSocket::WS_UNEXPECTED_CONDITION);
 				}
@@ -599,8 +696,7 @@ void PortReflector::openChannel(TargetInfo::Ptr pTargetInfo, Poco::UInt16 channe
 	Protocol::writeHeader(buffer, sizeof(buffer), Protocol::WT_OP_OPEN_REQUEST, 0, channel, port);
 	try
 	{
-		Poco::FastMutex::ScopedLock lock(pTargetInfo->webSocketMutex);
-		pTargetInfo->pWebSocket->sendFrame(buffer, sizeof(buffer), Poco::Net::WebSocket::FRAME_BINARY);
+		sendFrame(pTargetInfo, buffer, sizeof(buffer), true);
 	}
 	catch (Poco::Exception& exc)
 	{
@@ -620,8 +716,7 @@ void PortReflector::closeChannel(TargetInfo::Ptr pTargetInfo, Poco::UInt16 chann
 	Protocol::writeHeader(buffer, sizeof(buffer), Protocol::WT_OP_CLOSE, 0, channel);
 	try
 	{
-		Poco::FastMutex::ScopedLock lock(pTargetInfo->webSocketMutex);
-		pTargetInfo->pWebSocket->sendFrame(buffer, sizeof(buffer), Poco::Net::WebSocket::FRAME_BINARY);
+		sendFrame(pTargetInfo, buffer, sizeof(buffer), true);
 	}
 	catch (Poco::Exception& exc)
 	{
@@ -671,6 +766,7 @@ void PortReflector::confirmCloseChannel(TargetInfo::Ptr pTargetInfo, Poco::UInt1
 	{
 		it->second->state = CS_DISCONNECTED;
 		it->second->stateChanged.set();
+		it->second->creditChanged.set();
 		try
 		{
 			if (it->second->pSocket)
@@ -710,11 +806,15 @@ bool PortReflector::forwardData(const char* buffer, std::size_t size, TargetInfo
 		{
 			if (pChannelInfo->pSocket)
 			{
-				Poco::FastMutex::ScopedLock lock(pChannelInfo->socketMutex);
-				pChannelInfo->pSocket->sendBytes(buffer, static_cast<int>(size));
+				{
+					Poco::FastMutex::ScopedLock lock(pChannelInfo->socketMutex);
+					pChannelInfo->pSocket->sendBytes(buffer, static_cast<int>(size));
+				}
+				grantCredit(pTargetInfo, pChannelInfo, size);
 			}
 			else if (pChannelInfo->pTunnelSocket)
 			{
+				// credit is granted as the data is read from the TunnelSocket
 				static_cast<TunnelSocketImpl*>(pChannelInfo->pTunnelSocket->impl())->enqueueBytes(buffer, static_cast<int>(size));
 			}
 			return true;
@@ -746,8 +846,7 @@ bool PortReflector::sendInitialMessage(TargetInfo::Ptr pTargetInfo, Poco::UInt16
 			std::memcpy(buffer.begin() + hn, it->second->initialMessage.data(), it->second->initialMessage.size());
 			try
 			{
-				Poco::FastMutex::ScopedLock lock(pTargetInfo->webSocketMutex);
-				pTargetInfo->pWebSocket->sendFrame(buffer.begin(), static_cast<int>(it->second->initialMessage.size() + hn), Poco::Net::WebSocket::FRAME_BINARY);
+				sendData(pTargetInfo, it->second, buffer.begin(), hn, it->second->initialMessage.size());
 			}
 			catch (Poco::Exception& exc)
 			{
@@ -761,4 +860,162 @@ bool PortReflector::sendInitialMessage(TargetInfo::Ptr pTargetInfo, Poco::UInt16
 }
 
 
+void PortReflector::initChannel(TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo)
+{
+	pChannelInfo->credit = CreditWindow(_creditWindow);
+	if (pTargetInfo->capabilities & Protocol::WT_CAP_DEFLATE)
+	{
+		pChannelInfo->pCompressor = new FrameCompressor;
+	}
+}
+
+
+void PortReflector::sendData(TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo, char* buffer, std::size_t headerSize, std::size_t size)
+{
+	if (pTargetInfo->capabilities & Protocol::WT_CAP_FLOW_CONTROL)
+	{
+		Poco::FastMutex::ScopedLock lock(pTargetInfo->mutex);
+		pChannelInfo->credit.consume(static_cast<int>(size));
+	}
+
+	const char* pFrame = buffer;
+	std::size_t frameSize = headerSize + size;
+	if (pChannelInfo->pCompressor && size <= Protocol::WT_FRAME_MAX_SIZE)
+	{
+		char* pCompressed = pChannelInfo->compressBuffer.begin();
+		std::size_t cn = pChannelInfo->pCompressor->compress(buffer + headerSize, size, pCompressed + headerSize, pChannelInfo->compressBuffer.size() - headerSize);
+		if (cn > 0)
+		{
+			Protocol::writeHeader(pCompressed, headerSize, Protocol::WT_OP_DATA, Protocol::WT_FLAG_DEFLATE, pChannelInfo->channel);
+			pFrame = pCompressed;
+			frameSize = headerSize + cn;
+		}
+	}
+
+	sendFrame(pTargetInfo, pFrame, frameSize, false);
+}
+
+
+void PortReflector::sendFrame(TargetInfo::Ptr pTargetInfo, const char* pFrame, std::size_t size, bool urgent)
+{
+	if ((pTargetInfo->capabilities & Protocol::WT_CAP_MULTI_RECORD) && FrameCoalescer::canCoalesce(size))
+	{
+		bool owner = false;
+		if (pTargetInfo->coalescer.add(pFrame, size, owner))
+		{
+			// The thread that started the batch sends it, unless a
+			// thread with an urgent frame gets there first.
+			if (!urgent)
+			{
+				if (!owner) return;
+				pTargetInfo->coalescer.wait(static_cast<long>(_coalescingDelay.totalMilliseconds()));
+			}
+			Poco::FastMutex::ScopedLock lock(pTargetInfo->webSocketMutex);
+			pTargetInfo->coalescer.flush(*pTargetInfo->pWebSocket);
+			return;
+		}
+	}
+	Poco::FastMutex::ScopedLock lock(pTargetInfo->webSocketMutex);
+	pTargetInfo->coalescer.send(*pTargetInfo->pWebSocket, pFrame, size);
+}
+
+
+bool PortReflector::checkCredit(TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo, int& maxSize)
+{
+	if (!(pTargetInfo->capabilities & Protocol::WT_CAP_FLOW_CONTROL)) return true;
+
+	Poco::FastMutex::ScopedLock lock(pTargetInfo->mutex);
+	// WebSocket frames cannot be read partially, so we always
+	// wait until there is enough credit for a full frame.
+	if (pChannelInfo->credit.sendCredit() < maxSize)
+	{
+		if (pChannelInfo->pSocket && pChannelInfo->state == CS_CONNECTED && !pChannelInfo->suspended)
+		{
+			if (_logger.trace())
+			{
+				_logger.trace(Poco::format("Out of credit for channel %hu on target %s, suspending", pChannelInfo->channel, pTargetInfo->id));
+			}
+			pChannelInfo->suspended = true;
+			// Does not wait for the dispatcher, and keeps the order
+			// with a resumeSocket() call from addCredit().
+			_dispatcher.suspendSocket(*pChannelInfo->pSocket);
+		}
+		return pChannelInfo->state != CS_CONNECTED;
+	}
+	return true;
+}
+
+
+int PortReflector::waitCredit(TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo, int size)
+{
+	if (!(pTargetInfo->capabilities & Protocol::WT_CAP_FLOW_CONTROL)) return size;
+
+	pTargetInfo->mutex.lock();
+	while (pChannelInfo->credit.sendCredit() <= 0 && pChannelInfo->state == CS_CONNECTED)
+	{
+		pTargetInfo->mutex.unlock();
+		if (!pChannelInfo->creditChanged.tryWait(CREDIT_TIMEOUT))
+		{
+			throw Poco::TimeoutException("Timeout waiting for send credit");
+		}
+		pTargetInfo->mutex.lock();
+	}
+	int credit = pChannelInfo->state == CS_CONNECTED ? pChannelInfo->credit.sendCredit() : 0;
+	pTargetInfo->mutex.unlock();
+	return size < credit ? size : credit;
+}
+
+
+void PortReflector::addCredit(TargetInfo::Ptr pTargetInfo, Poco::UInt16 channel, Poco::UInt16 credit)
+{
+	Poco::FastMutex::ScopedLock lock(pTargetInfo->mutex);
+
+	ChannelMap::iterator it = pTargetInfo->channelMap.find(channel);
+	if (it != pTargetInfo->channelMap.end())
+	{
+		ChannelInfo::Ptr pChannelInfo = it->second;
+		pChannelInfo->credit.add(credit);
+		pChannelInfo->creditChanged.set();
+		if (pChannelInfo->suspended && pChannelInfo->credit.sendCredit() >= Protocol::WT_FRAME_MAX_SIZE)
+		{
+			pChannelInfo->suspended = false;
+			if (pChannelInfo->pSocket)
+			{
+				_dispatcher.resumeSocket(*pChannelInfo->pSocket);
+			}
+		}
+	}
+}
+
+
+void PortReflector::grantCredit(TargetInfo::Ptr pTargetInfo, ChannelInfo::Ptr pChannelInfo, std::size_t size)
+{
+	if (!(pTargetInfo->capabilities & Protocol::WT_CAP_FLOW_CONTROL)) return;
+
+	int credit = 0;
+	{
+		Poco::FastMutex::ScopedLock lock(pTargetInfo->mutex);
+		pChannelInfo->credit.received(static_cast<int>(size));
+		credit = pChannelInfo->credit.grant();
+	}
+	while (credit > 0)
+	{
+		int n = credit < CreditWindow::MAX_CREDIT ? credit : CreditWindow::MAX_CREDIT;
+		char buffer[6];
+		std::size_t hn = Protocol::writeHeader(buffer, sizeof(buffer), Protocol::WT_OP_CREDIT, 0, pChannelInfo->channel, static_cast<Poco::UInt16>(n));
+		try
+		{
+			sendFrame(pTargetInfo, buffer, hn, true);
+		}
+		catch (Poco::Exception& exc)
+		{
+			_logger.error(Poco::format("Error sending credit for channel %hu on target %s: %s", pChannelInfo->channel, pTargetInfo->id, exc.displayText()));
+			removeTarget(pTargetInfo);
+			break;
+		}
+		credit -= n;
+	}
+}
+
+
 } } // namespace Poco::WebTunnel
@@ -18,12 +18,17 @@
 #include "Poco/BinaryWriter.h"
 #include "Poco/BinaryReader.h"
 #include "Poco/MemoryStream.h"
+#include "Poco/StringTokenizer.h"
+#include "Poco/String.h"
 
 
 namespace Poco {
 namespace WebTunnel {
 
 
+const std::string Protocol::X_WEBTUNNEL_CAPABILITIES("X-WebTunnel-Capabilities");
+
+
 std::size_t Protocol::writeHeader(char* pBuffer, std::size_t bufferSize, Poco::UInt8 opcode, Poco::UInt8 flags, Poco::UInt16 channel, Poco::UInt16 portOrErrorCode)
 {
 	Poco::MemoryOutputStream mos(pBuffer, static_cast<std::streamsize>(bufferSize));
@@ -34,6 +39,7 @@ std::size_t Protocol::writeHeader(char* pBuffer, std::size_t bufferSize, Poco::U
 	case WT_OP_OPEN_REQUEST:
 	case WT_OP_OPEN_FAULT:
 	case WT_OP_ERROR:
+	case WT_OP_CREDIT:
 		writer << portOrErrorCode;
 		break;
 	}
@@ -53,6 +59,7 @@ std::size_t Protocol::readHeader(const char* pBuffer, std::size_t bufferSize, Po
 		case WT_OP_OPEN_REQUEST:
 		case WT_OP_OPEN_FAULT:
 		case WT_OP_ERROR:
+		case WT_OP_CREDIT:
 			reader >> *pPortOrErrorCode;
 			return 6;
 		}
@@ -61,4 +68,51 @@ std::size_t Protocol::readHeader(const char* pBuffer, std::size_t bufferSize, Po
 }
 
 
+std::size_t Protocol::readRecordHeader(const char* pBuffer, std::size_t bufferSize, std::size_t& recordSize)
+{
+	if (bufferSize < WT_RECORD_HEADER_SIZE) return 0;
+	recordSize = (static_cast<std::size_t>(static_cast<unsigned char>(pBuffer[0])) << 8) | static_cast<unsigned char>(pBuffer[1]);
+	if (recordSize > bufferSize - WT_RECORD_HEADER_SIZE) return 0;
+	return WT_RECORD_HEADER_SIZE;
+}
+
+
+std::string Protocol::formatCapabilities(int capabilities)
+{
+	std::string result;
+	if (capabilities & WT_CAP_FLOW_CONTROL)
+	{
+		result += "flow-control";
+	}
+	if (capabilities & WT_CAP_DEFLATE)
+	{
+		if (!result.empty()) result += ", ";
+		result += "deflate";
+	}
+	if (capabilities & WT_CAP_MULTI_RECORD)
+	{
+		if (!result.empty()) result += ", ";
+		result += "multi-record";
+	}
+	return result;
+}
+
+
+int Protocol::parseCapabilities(const std::string& capabilities)
+{
+	int result = WT_CAP_NONE;
+	Poco::StringTokenizer tok(capabilities, ",", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+	for (Poco::StringTokenizer::Iterator it = tok.begin(); it != tok.end(); ++it)
+	{
+		if (Poco::icompare(*it, "flow-control") == 0)
+			result |= WT_CAP_FLOW_CONTROL;
+		else if (Poco::icompare(*it, "deflate") == 0)
+			result |= WT_CAP_DEFLATE;
+		else if (Poco::icompare(*it, "multi-record") == 0)
+			result |= WT_CAP_MULTI_RECORD;
+	}
+	return result;
+}
+
+
 } } // namespace Poco::WebTunnel
@@ -22,17 +22,61 @@ namespace Poco {
 namespace WebTunnel {
 
 
-RemotePortForwarder::RemotePortForwarder(SocketDispatcher& dispatcher, Poco::SharedPtr<Poco::Net::WebSocket> pWebSocket, const Poco::Net::IPAddress& host, const std::set<Poco::UInt16>& ports, Poco::Timespan remoteTimeout):
+RemotePortForwarder::SendGate::SendGate():
+	_busy(false)
+{
+	for (int i = 0; i < PRIO_LEVELS; i++) _waiting[i] = 0;
+}
+
+
+void RemotePortForwarder::SendGate::acquire(int priority)
+{
+	poco_assert (priority >= 0 && priority < PRIO_LEVELS);
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	_waiting[priority]++;
+	for (;;)
+	{
+		bool higherWaiting = false;
+		for (int i = 0; i < priority; i++)
+		{
+			if (_waiting[i] > 0) higherWaiting = true;
+		}
+		if (!_busy && !higherWaiting) break;
+		_released.wait(_mutex);
+	}
+	_waiting[priority]--;
+	_busy = true;
+}
+
+
+void RemotePortForwarder::SendGate::release()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	_busy = false;
+	_released.broadcast();
+}
+
+
+RemotePortForwarder::RemotePortForwarder(SocketDispatcher& dispatcher, Poco::SharedPtr<Poco::Net::WebSocket> pWebSocket, const Poco::Net::IPAddress& host, const std::set<Poco::UInt16>& ports, Poco::Timespan remoteTimeout, int capabilities):
 	_dispatcher(dispatcher),
 	_pWebSocket(pWebSocket),
+	_coalescingDelay(0),
+	_creditWindow(Protocol::WT_INITIAL_CREDIT),
 	_host(host),
 	_ports(ports),
+	_capabilities(capabilities & Protocol::WT_CAP_ALL),
+	_decompressBuffer(Protocol::WT_FRAME_MAX_SIZE),
 	_connectTimeout(30, 0),
 	_localTimeout(7200, 0),
 	_remoteTimeout(remoteTimeout),
 	_timeoutCount(0),
 	_logger(Poco::Logger::get("WebTunnel.RemotePortForwarder"))
 {
+	if (_capabilities & Protocol::WT_CAP_DEFLATE)
+	{
+		_pDecompressor = new FrameDecompressor;
+	}
 	_dispatcher.addSocket(*pWebSocket, new TunnelDemultiplexer(*this), remoteTimeout);
 }
 
@@ -89,15 +133,124 @@ const Poco::Timespan& RemotePortForwarder::remoteTimeout() const
 }
 
 
-bool RemotePortForwarder::multiplex(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, Poco::UInt16 channel, Poco::Buffer<char>& buffer)
+int RemotePortForwarder::capabilities() const
+{
+	return _capabilities;
+}
+
+
+void RemotePortForwarder::setPortPriority(Poco::UInt16 port, Priority priority)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_priorities[port] = priority;
+}
+
+
+RemotePortForwarder::Priority RemotePortForwarder::getPortPriority(Poco::UInt16 port) const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	PriorityMap::const_iterator it = _priorities.find(port);
+	if (it != _priorities.end())
+		return it->second;
+	else
+		return PRIO_NORMAL;
+}
+
+
+void RemotePortForwarder::setCoalescingDelay(const Poco::Timespan& delay)
+{
+	_coalescingDelay = delay;
+}
+
+
+const Poco::Timespan& RemotePortForwarder::getCoalescingDelay() const
+{
+	return _coalescingDelay;
+}
+
+
+void RemotePortForwarder::setCreditWindow(int window)
+{
+	if (window < CreditWindow::MIN_WINDOW) throw Poco::InvalidArgumentException("WebTunnel credit window too small");
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	_creditWindow = window;
+}
+
+
+int RemotePortForwarder::getCreditWindow() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	return _creditWindow;
+}
+
+
+Poco::UInt64 RemotePortForwarder::framesSent() const
+{
+	return _coalescer.framesSent();
+}
+
+
+Poco::UInt64 RemotePortForwarder::recordsSent() const
+{
+	return _coalescer.recordsSent();
+}
+
+
+bool RemotePortForwarder::multiplex(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, Poco::UInt16 channel, Priority priority, FrameCompressor* pCompressor, Poco::Buffer<char>& buffer, Poco::Buffer<char>& compressBuffer)
 {
 	std::size_t hn = Protocol::writeHeader(buffer.begin(), buffer.size(), Protocol::WT_OP_DATA, 0, channel);
+	int maxSize = static_cast<int>(buffer.size() - hn);
+	if (_capabilities & Protocol::WT_CAP_FLOW_CONTROL)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		ChannelMap::iterator it = _channelMap.find(channel);
+		if (it == _channelMap.end()) return false;
+		if (it->second.credit.sendCredit() <= 0)
+		{
+			if (!it->second.suspended)
+			{
+				if (_logger.trace())
+				{
+					_logger.trace(Poco::format("Out of credit for channel %hu, suspending", channel));
+				}
+				it->second.suspended = true;
+				// Does not wait for the dispatcher, and keeps the order
+				// with a resumeSocket() call from addCredit().
+				_dispatcher.suspendSocket(socket);
+			}
+			return false;
+		}
+		if (maxSize > it->second.credit.sendCredit()) maxSize = it->second.credit.sendCredit();
+	}
+	const char* pFrame = buffer.begin();
 	bool expectMore = true;
 	int n = 0;
 	try
 	{
-		n = socket.receiveBytes(buffer.begin() + hn, static_cast<int>(buffer.size() - hn));
-		if (n <= 0)
+		n = socket.receiveBytes(buffer.begin() + hn, maxSize);
+		if (n > 0)
+		{
+			if (_capabilities & Protocol::WT_CAP_FLOW_CONTROL)
+			{
+				Poco::FastMutex::ScopedLock lock(_mutex);
+				ChannelMap::iterator it = _channelMap.find(channel);
+				if (it != _channelMap.end()) it->second.credit.consume(n);
+			}
+			if (pCompressor)
+			{
+				std::size_t cn = pCompressor->compress(buffer.begin() + hn, n, compressBuffer.begin() + hn, compressBuffer.size() - hn);
+				if (cn > 0)
+				{
+					Protocol::writeHeader(compressBuffer.begin(), compressBuffer.size(), Protocol::WT_OP_DATA, Protocol::WT_FLAG_DEFLATE, channel);
+					pFrame = compressBuffer.begin();
+					n = static_cast<int>(cn);
+				}
+			}
+		}
+		else
 		{
 			if (_logger.debug())
 			{
@@ -106,6 +259,7 @@ bool RemotePortForwarder::multiplex(SocketDispatcher& dispatcher, Poco::Net::Str
 			removeChannel(channel);
 			n = 0;
 			hn = Protocol::writeHeader(buffer.begin(), buffer.size(), Protocol::WT_OP_CLOSE, 0, channel);
+			pFrame = buffer.begin();
 			expectMore = false;
 		}
 	}
@@ -115,12 +269,12 @@ bool RemotePortForwarder::multiplex(SocketDispatcher& dispatcher, Poco::Net::Str
 		removeChannel(channel);
 		n = 0;
 		hn = Protocol::writeHeader(buffer.begin(), buffer.size(), Protocol::WT_OP_ERROR, 0, channel, Protocol::WT_ERR_SOCKET);
+		pFrame = buffer.begin();
 		expectMore = false;
 	}
 	try
 	{
-		Poco::FastMutex::ScopedLock lock(_webSocketMutex);
-		_pWebSocket->sendFrame(buffer.begin(), static_cast<int>(n + hn), Poco::Net::WebSocket::FRAME_BINARY);
+		sendFrame(pFrame, static_cast<int>(n + hn), priority);
 	}
 	catch (Poco::Exception& exc)
 	{
@@ -139,8 +293,7 @@ void RemotePortForwarder::multiplexError(SocketDispatcher& dispatcher, Poco::Net
 	std::size_t hn = Protocol::writeHeader(buffer.begin(), buffer.size(), Protocol::WT_OP_ERROR, 0, channel, Protocol::WT_ERR_SOCKET);
 	try
 	{
-		Poco::FastMutex::ScopedLock lock(_webSocketMutex);
-		_pWebSocket->sendFrame(buffer.begin(), static_cast<int>(hn), Poco::Net::WebSocket::FRAME_BINARY);
+		sendFrame(buffer.begin(), static_cast<int>(hn), PRIO_INTERACTIVE);
 	}
 	catch (Poco::Exception& exc)
 	{
@@ -157,8 +310,7 @@ void RemotePortForwarder::multiplexTimeout(SocketDispatcher& dispatcher, Poco::N
 	std::size_t hn = Protocol::writeHeader(buffer.begin(), buffer.size(), Protocol::WT_OP_ERROR, 0, channel, Protocol::WT_ERR_TIMEOUT);
 	try
 	{
-		Poco::FastMutex::ScopedLock lock(_webSocketMutex);
-		_pWebSocket->sendFrame(buffer.begin(), static_cast<int>(hn), Poco::Net::WebSocket::FRAME_BINARY);
+		sendFrame(buffer.begin(), static_cast<int>(hn), PRIO_INTERACTIVE);
 	}
 	catch (Poco::Exception& exc)
 	{
@@ -190,33 +342,31 @@ bool RemotePortForwarder::demultiplex(SocketDispatcher& dispatcher, Poco::Net::S
 	}
 	if (n > 0 && (wsFlags & Poco::Net::WebSocket::FRAME_OP_BITMASK) == Poco::Net::WebSocket::FRAME_OP_BINARY)
 	{
-		Poco::UInt8 opcode;
-		Poco::UInt8 flags;
-		Poco::UInt16 channel;
-		Poco::UInt16 portOrErrorCode;
-		std::size_t hn = Protocol::readHeader(buffer.begin(), buffer.size(), opcode, flags, channel, &portOrErrorCode);
-		switch (opcode)
+		Poco::UInt8 opcode = 0;
+		Poco::UInt8 flags = 0;
+		Poco::UInt16 channel = 0;
+		std::size_t hn = Protocol::readHeader(buffer.begin(), n, opcode, flags, channel);
+		if (opcode == Protocol::WT_OP_MULTI_RECORD && (_capabilities & Protocol::WT_CAP_MULTI_RECORD))
 		{
-		case Protocol::WT_OP_DATA:
-			return forwardData(buffer.begin() + hn, static_cast<int>(n - hn), channel);
-
-		case Protocol::WT_OP_OPEN_REQUEST:
-			return openChannel(channel, portOrErrorCode);
-
-		case Protocol::WT_OP_CLOSE:
-			removeChannel(channel);
-			return false;
-
-		case Protocol::WT_OP_ERROR:
-			_logger.error(Poco::format("Status %hu reported by peer. Closing channel %hu", portOrErrorCode, channel));
-			removeChannel(channel);
-			return false;
-
-		default:
-			_logger.error(Poco::format("Invalid WebSocket frame received (bad opcode: %hu)", static_cast<Poco::UInt16>(opcode)));
-			sendResponse(channel, Protocol::WT_OP_ERROR, Protocol::WT_ERR_PROTOCOL);
-			return false;
+			const char* pRecord = buffer.begin() + hn;
+			std::size_t remaining = n - hn;
+			while (remaining > 0)
+			{
+				std::size_t recordSize = 0;
+				std::size_t rhn = Protocol::readRecordHeader(pRecord, remaining, recordSize);
+				if (rhn == 0)
+				{
+					_logger.error("Invalid WebSocket frame received (truncated record)");
+					closeWebSocket(RPF_CLOSE_ERROR, false);
+					return false;
+				}
+				demultiplexFrame(pRecord + rhn, recordSize);
+				pRecord += rhn + recordSize;
+				remaining -= rhn + recordSize;
+			}
+			return true;
 		}
+		return demultiplexFrame(buffer.begin(), n);
 	}
 	else if (n <= 0 || (wsFlags & Poco::Net::WebSocket::FRAME_OP_BITMASK) == Poco::Net::WebSocket::FRAME_OP_CLOSE)
 	{
@@ -232,6 +382,70 @@ bool RemotePortForwarder::demultiplex(SocketDispatcher& dispatcher, Poco::Net::S
 }
 
 
+bool RemotePortForwarder::demultiplexFrame(const char* pFrame, std::size_t size)
+{
+	Poco::UInt8 opcode = 0;
+	Poco::UInt8 flags = 0;
+	Poco::UInt16 channel = 0;
+	Poco::UInt16 portOrErrorCode = 0;
+	std::size_t hn = Protocol::readHeader(pFrame, size, opcode, flags, channel, &portOrErrorCode);
+	if (hn > size)
+	{
+		_logger.error("Invalid WebSocket frame received (truncated header)");
+		return false;
+	}
+	switch (opcode)
+	{
+	case Protocol::WT_OP_DATA:
+		if (flags & Protocol::WT_FLAG_DEFLATE)
+		{
+			if (!_pDecompressor)
+			{
+				_logger.error(Poco::format("Received compressed data for channel %hu, but compression has not been negotiated", channel));
+				removeChannel(channel);
+				sendResponse(channel, Protocol::WT_OP_ERROR, Protocol::WT_ERR_PROTOCOL);
+				return false;
+			}
+			std::size_t dn = 0;
+			try
+			{
+				dn = _pDecompressor->decompress(pFrame + hn, size - hn, _decompressBuffer.begin(), _decompressBuffer.size());
+			}
+			catch (Poco::Exception& exc)
+			{
+				_logger.error(Poco::format("Invalid compressed data for channel %hu: %s", channel, exc.displayText()));
+				removeChannel(channel);
+				sendResponse(channel, Protocol::WT_OP_ERROR, Protocol::WT_ERR_PROTOCOL);
+				return false;
+			}
+			return forwardData(_decompressBuffer.begin(), static_cast<int>(dn), channel);
+		}
+		return forwardData(pFrame + hn, static_cast<int>(size - hn), channel);
+
+	case Protocol::WT_OP_CREDIT:
+		addCredit(channel, portOrErrorCode);
+		return true;
+
+	case Protocol::WT_OP_OPEN_REQUEST:
+		return openChannel(channel, portOrErrorCode);
+
+	case Protocol::WT_OP_CLOSE:
+		removeChannel(channel);
+		return false;
+
+	case Protocol::WT_OP_ERROR:
+		_logger.error(Poco::format("Status %hu reported by peer. Closing channel %hu", portOrErrorCode, channel));
+		removeChannel(channel);
+		return false;
+
+	default:
+		_logger.error(Poco::format("Invalid WebSocket frame received (bad opcode: %hu)", static_cast<Poco::UInt16>(opcode)));
+		sendResponse(channel, Protocol::WT_OP_ERROR, Protocol::WT_ERR_PROTOCOL);
+		return false;
+	}
+}
+
+
 void RemotePortForwarder::demultiplexError(SocketDispatcher& dispatcher, Poco::Net::StreamSocket& socket, Poco::Buffer<char>& buffer)
 {
 	_logger.error("Error reading from WebSocket");
@@ -248,7 +462,7 @@ void RemotePortForwarder::demultiplexTimeout(SocketDispatcher& dispatcher, Poco:
 		try
 		{
 			_logger.debug("Sending PING");
-			Poco::FastMutex::ScopedLock lock(_webSocketMutex);
+			SendGate::ScopedLock lock(_sendGate, PRIO_INTERACTIVE);
 			_pWebSocket->sendFrame(0, 0, Poco::Net::WebSocket::FRAME_FLAG_FIN | Poco::Net::WebSocket::FRAME_OP_PING);
 		}
 		catch (Poco::Exception&)
@@ -269,11 +483,12 @@ bool RemotePortForwarder::forwardData(const char* buffer, int size, Poco::UInt16
 	ChannelMap::iterator it = _channelMap.find(channel);
 	if (it != _channelMap.end())
 	{
-		Poco::Net::StreamSocket streamSocket = it->second;
+		Poco::Net::StreamSocket streamSocket = it->second.socket;
 		lock.unlock();
 		try
 		{
 			streamSocket.sendBytes(buffer, size);
+			grantCredit(channel, size);
 			return true;
 		}
 		catch (Poco::Exception&)
@@ -316,11 +531,15 @@ bool RemotePortForwarder::openChannel(Poco::UInt16 channel, Poco::UInt16 port)
 			Poco::Net::StreamSocket streamSocket;
 			streamSocket.connect(addr, _connectTimeout);
 			streamSocket.setNoDelay(true);
-			_dispatcher.addSocket(streamSocket, new TunnelMultiplexer(*this, channel), _localTimeout);
-			_channelMap[channel] = streamSocket;
+			ChannelInfo& info = _channelMap[channel];
+			info.socket = streamSocket;
+			info.credit = CreditWindow(_creditWindow);
+			PriorityMap::const_iterator itPrio = _priorities.find(port);
+			if (itPrio != _priorities.end()) info.priority = itPrio->second;
 		}
 		catch (Poco::Net::ConnectionRefusedException& exc)
 		{
+			_channelMap.erase(channel);
 			lock.unlock();
 			_logger.error(Poco::format("Failed to open channel %hu for port %hu: %s", channel, port, exc.displayText()));
 			sendResponse(channel, Protocol::WT_OP_OPEN_FAULT, Protocol::WT_ERR_CONN_REFUSED);
@@ -328,6 +547,7 @@ bool RemotePortForwarder::openChannel(Poco::UInt16 channel, Poco::UInt16 port)
 		}
 		catch (Poco::TimeoutException& exc)
 		{
+			_channelMap.erase(channel);
 			lock.unlock();
 			_logger.error(Poco::format("Failed to open channel %hu for port %hu: %s", channel, port, exc.displayText()));
 			sendResponse(channel, Protocol::WT_OP_OPEN_FAULT, Protocol::WT_ERR_TIMEOUT);
@@ -335,12 +555,17 @@ bool RemotePortForwarder::openChannel(Poco::UInt16 channel, Poco::UInt16 port)
 		}
 		catch (Poco::Exception& exc)
 		{
+			_channelMap.erase(channel);
 			lock.unlock();
 			_logger.error(Poco::format("Failed to open channel %hu for port %hu: %s", channel, port, exc.displayText()));
 			sendResponse(channel, Protocol::WT_OP_OPEN_FAULT, Protocol::WT_ERR_SOCKET);
 			return false;
 		}
+		// The confirmation must be sent before the socket is handed to the
+		// dispatcher, otherwise data read from the socket may overtake it.
 		sendResponse(channel, Protocol::WT_OP_OPEN_CONFIRM, 0);
+		const ChannelInfo& info = _channelMap[channel];
+		_dispatcher.addSocket(info.socket, new TunnelMultiplexer(*this, channel, info.priority, (_capabilities & Protocol::WT_CAP_DEFLATE) != 0), _localTimeout);
 		return true;
 	}
 	else
@@ -359,7 +584,7 @@ void RemotePortForwarder::removeChannel(Poco::UInt16 channel)
 	ChannelMap::iterator it = _channelMap.find(channel);
 	if (it != _channelMap.end())
 	{
-		_dispatcher.closeSocket(it->second);
+		_dispatcher.closeSocket(it->second.socket);
 		_channelMap.erase(it);
 	}
 }
@@ -371,8 +596,7 @@ void RemotePortForwarder::sendResponse(Poco::UInt16 channel, Poco::UInt8 opcode,
 	std::size_t hn = Protocol::writeHeader(buffer, sizeof(buffer), opcode, 0, channel, errorCode);
 	try
 	{
-		Poco::FastMutex::ScopedLock lock(_webSocketMutex);
-		_pWebSocket->sendFrame(buffer, static_cast<int>(hn), Poco::Net::WebSocket::FRAME_BINARY);
+		sendFrame(buffer, static_cast<int>(hn), PRIO_INTERACTIVE);
 	}
 	catch (Poco::Exception&)
 	{
@@ -381,6 +605,69 @@ void RemotePortForwarder::sendResponse(Poco::UInt16 channel, Poco::UInt8 opcode,
 }
 
 
+void RemotePortForwarder::sendFrame(const char* buffer, int length, int priority)
+{
+	if ((_capabilities & Protocol::WT_CAP_MULTI_RECORD) && FrameCoalescer::canCoalesce(length))
+	{
+		bool owner = false;
+		if (_coalescer.add(buffer, length, owner))
+		{
+			// The thread that started the batch sends it, unless a
+			// thread with an interactive frame gets there first.
+			if (priority != PRIO_INTERACTIVE)
+			{
+				if (!owner) return;
+				_coalescer.wait(static_cast<long>(_coalescingDelay.totalMilliseconds()));
+			}
+			SendGate::ScopedLock lock(_sendGate, priority);
+			_coalescer.flush(*_pWebSocket);
+			return;
+		}
+	}
+	SendGate::ScopedLock lock(_sendGate, priority);
+	_coalescer.send(*_pWebSocket, buffer, length);
+}
+
+
+void RemotePortForwarder::addCredit(Poco::UInt16 channel, Poco::UInt16 credit)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	ChannelMap::iterator it = _channelMap.find(channel);
+	if (it != _channelMap.end())
+	{
+		it->second.credit.add(credit);
+		if (it->second.suspended && it->second.credit.sendCredit() > 0)
+		{
+			it->second.suspended = false;
+			_dispatcher.resumeSocket(it->second.socket);
+		}
+	}
+}
+
+
+void RemotePortForwarder::grantCredit(Poco::UInt16 channel, int size)
+{
+	if (!(_capabilities & Protocol::WT_CAP_FLOW_CONTROL)) return;
+
+	int credit = 0;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		ChannelMap::iterator it = _channelMap.find(channel);
+		if (it != _channelMap.end())
+		{
+			it->second.credit.received(size);
+			credit = it->second.credit.grant();
+		}
+	}
+	while (credit > 0)
+	{
+		int n = credit < CreditWindow::MAX_CREDIT ? credit : CreditWindow::MAX_CREDIT;
+		sendResponse(channel, Protocol::WT_OP_CREDIT, static_cast<Poco::UInt16>(n));
+		credit -= n;
+	}
+}
+
+
 void RemotePortForwarder::closeWebSocket(CloseReason reason, bool active)
 {
 	if (!_pWebSocket || !_pWebSocket->impl()->initialized()) return;
@@ -407,7 +694,7 @@ void RemotePortForwarder::closeWebSocket(CloseReason reason, bool active)
 		}
 		for (ChannelMap::iterator it = _channelMap.begin(); it != _channelMap.end(); ++it)
 		{
-			_dispatcher.removeSocket(it->second);
+			_dispatcher.removeSocket(it->second.socket);
 		}
 		_pWebSocket->close();
 		_channelMap.clear();
@@ -228,6 +228,29 @@ private:
 };
 
 
+class SuspendSocketNotification: public TaskNotification
+{
+public:
+	typedef Poco::AutoPtr<SuspendSocketNotification> Ptr;
+
+	SuspendSocketNotification(SocketDispatcher& dispatcher, const Poco::Net::StreamSocket& socket, bool suspend):
+		TaskNotification(dispatcher),
+		_socket(socket),
+		_suspend(suspend)
+	{
+	}
+
+	void execute()
+	{
+		_dispatcher.suspendSocketImpl(_socket, _suspend);
+	}
+
+private:
+	Poco::Net::StreamSocket _socket;
+	bool _suspend;
+};
+
+
 class ResetNotification: public TaskNotification
 {
 public:
@@ -255,6 +278,10 @@ SocketDispatcher::SocketDispatcher(int threadCount, Poco::Timespan timeout, int
 	_stopped(false),
 	_logger(Poco::Logger::get("WebTunnel.SocketDispatcher"))
 {
+	_wakeUpSocket.bind(Poco::Net::SocketAddress("127.0.0.1", 0));
+	_wakeUpSocket.setBlocking(false);
+	_pollSet.add(_wakeUpSocket, Poco::Net::PollSet::POLL_READ);
+
 	for (int i = 0; i < threadCount; i++)
 	{
 		ThreadPtr pThread = new Poco::Thread;
@@ -283,6 +310,7 @@ void SocketDispatcher::stop()
 	if (!_stopped)
 	{
 		_stopped = true;
+		wakeUp();
 		_mainQueue.wakeUpAll();
 		_workerQueue.wakeUpAll();
 		_mainThread.join();
@@ -299,7 +327,7 @@ void SocketDispatcher::stop()
 void SocketDispatcher::reset()
 {
 	ResetNotification::Ptr pNf = new ResetNotification(*this);
-	_mainQueue.enqueueNotification(pNf);
+	enqueueTask(pNf);
 	pNf->wait();
 }
 
@@ -307,7 +335,7 @@ void SocketDispatcher::reset()
 void SocketDispatcher::addSocket(const Poco::Net::StreamSocket& socket, SocketHandler::Ptr pHandler, Poco::Timespan timeout)
 {
 	AddSocketNotification::Ptr pNf = new AddSocketNotification(*this, socket, pHandler, timeout);
-	_mainQueue.enqueueNotification(pNf);
+	enqueueTask(pNf);
 	pNf->wait();
 }
 
@@ -315,7 +343,7 @@ void SocketDispatcher::addSocket(const Poco::Net::StreamSocket& socket, SocketHa
 void SocketDispatcher::removeSocket(const Poco::Net::StreamSocket& socket)
 {
 	RemoveSocketNotification::Ptr pNf = new RemoveSocketNotification(*this, socket);
-	_mainQueue.enqueueNotification(pNf);
+	enqueueTask(pNf);
 	pNf->wait();
 }
 
@@ -323,11 +351,45 @@ void SocketDispatcher::removeSocket(const Poco::Net::StreamSocket& socket)
 void SocketDispatcher::closeSocket(const Poco::Net::StreamSocket& socket)
 {
 	CloseSocketNotification::Ptr pNf = new CloseSocketNotification(*this, socket);
-	_mainQueue.enqueueNotification(pNf);
+	enqueueTask(pNf);
 	pNf->wait();
 }
 
 
+void SocketDispatcher::suspendSocket(const Poco::Net::StreamSocket& socket)
+{
+	enqueueTask(new SuspendSocketNotification(*this, socket, true));
+}
+
+
+void SocketDispatcher::resumeSocket(const Poco::Net::StreamSocket& socket)
+{
+	enqueueTask(new SuspendSocketNotification(*this, socket, false));
+}
+
+
+void SocketDispatcher::enqueueTask(Poco::Notification::Ptr pNf)
+{
+	_mainQueue.enqueueNotification(pNf);
+	wakeUp();
+}
+
+
+void SocketDispatcher::wakeUp()
+{
+	try
+	{
+		char b = 0;
+		_wakeUpSocket.sendTo(&b, 1, _wakeUpSocket.address());
+	}
+	catch (Poco::Exception&)
+	{
+		// If the datagram cannot be sent, the main thread will
+		// still pick up the request after the select() timeout.
+	}
+}
+
+
 void SocketDispatcher::runMain()
 {
 	Poco::Timespan currentTimeout(_timeout);
@@ -337,13 +399,13 @@ void SocketDispatcher::runMain()
 		{
 			for (SocketMap::iterator it = _socketMap.begin(); it != _socketMap.end(); ++it)
 			{
-				if (it->second->wantRead && it->second->timeout != 0 && it->second->timeout < it->second->activity.elapsed())
+				if (it->second->wantRead && !it->second->suspended && it->second->timeout != 0 && it->second->timeout < it->second->activity.elapsed())
 				{
 					it->second->wantRead = false;
 					it->second->activity.update();
 					timeout(it->first, it->second);
 				}
-				if (it->second->wantRead)
+				if (it->second->wantRead && !it->second->suspended)
 				{
 					if (!it->second->polling)
 					{
@@ -369,8 +431,17 @@ void SocketDispatcher::runMain()
 				currentTimeout = _timeout;
 				for (Poco::Net::PollSet::SocketModeMap::const_iterator it = socketModeMap.begin(); it != socketModeMap.end(); ++it)
 				{
+					if (it->first == _wakeUpSocket)
+					{
+						char buffer[64];
+						while (_wakeUpSocket.available() > 0)
+						{
+							_wakeUpSocket.receiveBytes(buffer, sizeof(buffer));
+						}
+						continue;
+					}
 					SocketMap::iterator its = _socketMap.find(it->first);
-					if (its != _socketMap.end() && its->second->wantRead)
+					if (its != _socketMap.end() && its->second->wantRead && !its->second->suspended)
 					{
 						its->second->wantRead = false;
 						its->second->activity.update();
@@ -466,19 +537,28 @@ void SocketDispatcher::readableImpl(Poco::Net::StreamSocket& socket, SocketDispa
 {
 	try
 	{
+		// Only continue with data that has already arrived. Blocking here
+		// to wait for more would stall a worker on every quiet socket;
+		// handing the socket back to the main thread is cheap.
+		// Stop as soon as the handler did not make progress (e.g., because
+		// it has run out of credit and asked for the socket to be suspended),
+		// as retrying would just spin until the main thread has processed
+		// the request. SocketInfo::suspended is owned by the main thread
+		// and therefore not looked at here.
 		int reads = 0;
 		bool expectMore = false;
 		do
 		{
 			expectMore = pInfo->pHandler->readable(*this, socket);
 		}
-		while (socket.available() > 0 || (expectMore && reads++ < _maxReadsPerWorker && socket.poll(_timeout, Poco::Net::Socket::SELECT_READ)));
+		while (expectMore && ++reads < _maxReadsPerWorker && (socket.available() > 0 || socket.poll(0, Poco::Net::Socket::SELECT_READ)));
 	}
 	catch (Poco::Exception& exc)
 	{
 		_logger.log(exc);
 	}
 	pInfo->wantRead = socket.impl()->initialized();
+	wakeUp();
 }
 
 
@@ -506,6 +586,7 @@ void SocketDispatcher::timeoutImpl(Poco::Net::StreamSocket& socket, SocketDispat
 		_logger.log(exc);
 	}
 	pInfo->wantRead = socket.impl()->initialized();
+	wakeUp();
 }
 
 
@@ -531,10 +612,21 @@ void SocketDispatcher::closeSocketImpl(Poco::Net::StreamSocket& socket)
 }
 
 
+void SocketDispatcher::suspendSocketImpl(const Poco::Net::StreamSocket& socket, bool suspend)
+{
+	SocketMap::iterator it = _socketMap.find(socket);
+	if (it != _socketMap.end())
+	{
+		it->second->suspended = suspend;
+	}
+}
+
+
 void SocketDispatcher::resetImpl()
 {
 	_socketMap.clear();
 	_pollSet.clear();
+	_pollSet.add(_wakeUpSocket, Poco::Net::PollSet::POLL_READ);
 }
 
 
@@ -86,14 +86,19 @@ int TunnelSocketImpl::sendBytes(const void* buffer, int length, int flags)
 			std::size_t hn = Protocol::writeHeader(_writeBuffer.begin(), _writeBuffer.size(), Protocol::WT_OP_DATA, 0, _pChannelInfo->channel);
 			int frameLength = length;
 			if (frameLength > Protocol::WT_FRAME_MAX_SIZE) frameLength = Protocol::WT_FRAME_MAX_SIZE;
+			frameLength = _portReflector.waitCredit(_pTargetInfo, _pChannelInfo, frameLength);
+			if (frameLength == 0) break;
 			std::memcpy(_writeBuffer.begin() + hn, pB, frameLength);
-			Poco::FastMutex::ScopedLock lock(_pTargetInfo->webSocketMutex);
-			_pTargetInfo->pWebSocket->sendFrame(_writeBuffer.begin(), static_cast<int>(frameLength + hn), Poco::Net::WebSocket::FRAME_BINARY);
+			_portReflector.sendData(_pTargetInfo, _pChannelInfo, _writeBuffer.begin(), hn, frameLength);
 			length -= frameLength;
 			sent += frameLength;
 			pB += frameLength;
 		}
 	}
+	catch (Poco::TimeoutException&)
+	{
+		throw;
+	}
 	catch (Poco::Exception&)
 	{
 		_portReflector.removeTarget(_pTargetInfo);
@@ -106,7 +111,11 @@ int TunnelSocketImpl::sendBytes(const void* buffer, int length, int flags)
 int TunnelSocketImpl::receiveBytes(void* buffer, int length, int)
 {
 	int n = _readBuffer.read(reinterpret_cast<char*>(buffer), length, static_cast<long>(_receiveTimeout.totalMilliseconds()));
-	if (n == 0)
+	if (n > 0)
+	{
+		_portReflector.grantCredit(_pTargetInfo, _pChannelInfo, n);
+	}
+	else if (n == 0)
 	{
 		switch (_statusCode)
 		{
@@ -0,0 +1,168 @@
+//
+// CreditWindowTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "CreditWindowTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/WebTunnel/CreditWindow.h"
+#include "Poco/WebTunnel/Protocol.h"
+#include "Poco/Exception.h"
+
+
+using Poco::WebTunnel::CreditWindow;
+using Poco::WebTunnel::Protocol;
+
+
+CreditWindowTest::CreditWindowTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+CreditWindowTest::~CreditWindowTest()
+{
+}
+
+
+void CreditWindowTest::testInitialCredit()
+{
+	CreditWindow cw;
+	assert (cw.window() == Protocol::WT_INITIAL_CREDIT);
+	assert (cw.sendCredit() == Protocol::WT_INITIAL_CREDIT);
+	assert (cw.peerCredit() == Protocol::WT_INITIAL_CREDIT);
+	assert (cw.grant() == 0);
+
+	// both peers start with the protocol's initial credit,
+	// regardless of the window size
+	CreditWindow cw2(CreditWindow::MIN_WINDOW);
+	assert (cw2.sendCredit() == Protocol::WT_INITIAL_CREDIT);
+	assert (cw2.peerCredit() == Protocol::WT_INITIAL_CREDIT);
+}
+
+
+void CreditWindowTest::testSendCredit()
+{
+	CreditWindow cw;
+	cw.consume(Protocol::WT_FRAME_MAX_SIZE);
+	assert (cw.sendCredit() == Protocol::WT_INITIAL_CREDIT - Protocol::WT_FRAME_MAX_SIZE);
+	cw.consume(Protocol::WT_INITIAL_CREDIT - Protocol::WT_FRAME_MAX_SIZE);
+	assert (cw.sendCredit() == 0);
+	cw.add(1000);
+	assert (cw.sendCredit() == 1000);
+	cw.add(65535);
+	assert (cw.sendCredit() == 66535);
+
+	// consuming the send credit does not affect the receive side
+	assert (cw.peerCredit() == Protocol::WT_INITIAL_CREDIT);
+	assert (cw.grant() == 0);
+}
+
+
+void CreditWindowTest::testGrant()
+{
+	CreditWindow cw;
+	int half = Protocol::WT_INITIAL_CREDIT/2;
+
+	cw.received(half);
+	assert (cw.peerCredit() == Protocol::WT_INITIAL_CREDIT - half);
+	assert (cw.grant() == 0);
+
+	cw.received(1);
+	int credit = cw.grant();
+	assert (credit == half + 1);
+	assert (credit <= CreditWindow::MAX_CREDIT);
+	assert (cw.peerCredit() == Protocol::WT_INITIAL_CREDIT);
+	assert (cw.grant() == 0);
+
+	// the peer never holds more credit than the window
+	int total = 0;
+	for (int i = 0; i < 1000; i++)
+	{
+		cw.received(Protocol::WT_FRAME_MAX_SIZE);
+		total += Protocol::WT_FRAME_MAX_SIZE;
+		int granted = cw.grant();
+		total -= granted;
+		assert (cw.peerCredit() <= cw.window());
+		assert (cw.peerCredit() > 0);
+		assert (granted <= CreditWindow::MAX_CREDIT);
+	}
+	assert (cw.peerCredit() == Protocol::WT_INITIAL_CREDIT - total);
+}
+
+
+void CreditWindowTest::testLargeWindow()
+{
+	const int window = 1024*1024;
+	CreditWindow cw(window);
+	assert (cw.window() == window);
+
+	// the peer's initial credit is less than half the window,
+	// so the window is opened with the first grant
+	cw.received(100);
+	int credit = cw.grant();
+	assert (credit == window - Protocol::WT_INITIAL_CREDIT + 100);
+	assert (credit > CreditWindow::MAX_CREDIT);
+	assert (cw.peerCredit() == window);
+
+	cw.received(window/2 - 1);
+	assert (cw.grant() == 0);
+	cw.received(1);
+	assert (cw.grant() == window/2);
+	assert (cw.peerCredit() == window);
+}
+
+
+void CreditWindowTest::testSmallWindow()
+{
+	CreditWindow cw(CreditWindow::MIN_WINDOW);
+
+	// the initial credit is larger than the window, so the
+	// first grant happens only after most of it has been used
+	cw.received(Protocol::WT_INITIAL_CREDIT - CreditWindow::MIN_WINDOW/2 - 1);
+	assert (cw.grant() == 0);
+	cw.received(1);
+	assert (cw.grant() == CreditWindow::MIN_WINDOW/2);
+	assert (cw.peerCredit() == CreditWindow::MIN_WINDOW);
+
+	// the peer can always send at least one full frame
+	assert (cw.peerCredit() >= Protocol::WT_FRAME_MAX_SIZE);
+
+	try
+	{
+		CreditWindow cw2(CreditWindow::MIN_WINDOW - 1);
+		fail("window too small - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void CreditWindowTest::setUp()
+{
+}
+
+
+void CreditWindowTest::tearDown()
+{
+}
+
+
+CppUnit::Test* CreditWindowTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("CreditWindowTest");
+
+	CppUnit_addTest(pSuite, CreditWindowTest, testInitialCredit);
+	CppUnit_addTest(pSuite, CreditWindowTest, testSendCredit);
+	CppUnit_addTest(pSuite, CreditWindowTest, testGrant);
+	CppUnit_addTest(pSuite, CreditWindowTest, testLargeWindow);
+	CppUnit_addTest(pSuite, CreditWindowTest, testSmallWindow);
+
+	return pSuite;
+}
@@ -0,0 +1,40 @@
+//
+// CreditWindowTest.h
+//
+// Definition of the CreditWindowTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef CreditWindowTest_INCLUDED
+#define CreditWindowTest_INCLUDED
+
+
+#include "Poco/WebTunnel/WebTunnel.h"
+#include "CppUnit/TestCase.h"
+
+
+class CreditWindowTest: public CppUnit::TestCase
+{
+public:
+	CreditWindowTest(const std::string& name);
+	~CreditWindowTest();
+
+	void testInitialCredit();
+	void testSendCredit();
+	void testGrant();
+	void testLargeWindow();
+	void testSmallWindow();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // CreditWindowTest_INCLUDED
@@ -0,0 +1,405 @@
+//
+// FrameCoalescerTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "FrameCoalescerTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/WebTunnel/FrameCoalescer.h"
+#include "Poco/WebTunnel/Protocol.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Buffer.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberFormatter.h"
+
+
+using Poco::WebTunnel::FrameCoalescer;
+using Poco::WebTunnel::Protocol;
+using Poco::Net::WebSocket;
+
+
+namespace
+{
+	class EchoRequestHandler: public Poco::Net::HTTPRequestHandler
+	{
+	public:
+		void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
+		{
+			try
+			{
+				WebSocket ws(request, response);
+				Poco::Buffer<char> buffer(2*Protocol::WT_FRAME_MAX_SIZE);
+				int flags;
+				int n;
+				do
+				{
+					n = ws.receiveFrame(buffer.begin(), static_cast<int>(buffer.size()), flags);
+					ws.sendFrame(buffer.begin(), n, flags);
+				}
+				while (n > 0 && (flags & WebSocket::FRAME_OP_BITMASK) != WebSocket::FRAME_OP_CLOSE);
+			}
+			catch (Poco::Exception&)
+			{
+			}
+		}
+	};
+
+	class EchoRequestHandlerFactory: public Poco::Net::HTTPRequestHandlerFactory
+	{
+	public:
+		Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest& request)
+		{
+			return new EchoRequestHandler;
+		}
+	};
+
+	std::string frame(Poco::UInt16 channel, const std::string& payload)
+	{
+		char header[Protocol::WT_FRAME_HEADER_SIZE];
+		std::size_t hn = Protocol::writeHeader(header, sizeof(header), Protocol::WT_OP_DATA, 0, channel);
+		return std::string(header, hn) + payload;
+	}
+
+	class AddRunnable: public Poco::Runnable
+	{
+	public:
+		AddRunnable(FrameCoalescer& coalescer, const std::string& frame):
+			_coalescer(coalescer),
+			_frame(frame),
+			_added(false),
+			_owner(true)
+		{
+		}
+
+		void run()
+		{
+			_added = _coalescer.add(_frame.data(), _frame.size(), _owner);
+		}
+
+		bool added() const
+		{
+			return _added;
+		}
+
+		bool owner() const
+		{
+			return _owner;
+		}
+
+	private:
+		FrameCoalescer& _coalescer;
+		std::string _frame;
+		bool _added;
+		bool _owner;
+	};
+
+	class WaitRunnable: public Poco::Runnable
+	{
+	public:
+		WaitRunnable(FrameCoalescer& coalescer, long milliseconds):
+			_coalescer(coalescer),
+			_milliseconds(milliseconds)
+		{
+		}
+
+		void run()
+		{
+			_stopwatch.start();
+			_coalescer.wait(_milliseconds);
+			_stopwatch.stop();
+		}
+
+		Poco::Timestamp::TimeDiff elapsed() const
+		{
+			return _stopwatch.elapsed()/1000;
+		}
+
+	private:
+		FrameCoalescer& _coalescer;
+		long _milliseconds;
+		Poco::Stopwatch _stopwatch;
+	};
+}
+
+
+FrameCoalescerTest::FrameCoalescerTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+FrameCoalescerTest::~FrameCoalescerTest()
+{
+}
+
+
+void FrameCoalescerTest::testSingleRecord()
+{
+	FrameCoalescer coalescer;
+	std::string f = frame(1, "Hello");
+	bool owner = false;
+	assert (coalescer.add(f.data(), f.size(), owner));
+	assert (owner);
+	coalescer.flush(*_pWebSocket);
+	assert (coalescer.framesSent() == 1);
+	assert (coalescer.recordsSent() == 1);
+
+	// a batch with a single record is sent without Multi-Record wrapper
+	assert (receiveFrame() == f);
+
+	// flushing an empty batch does not send anything
+	coalescer.flush(*_pWebSocket);
+	assert (coalescer.framesSent() == 1);
+}
+
+
+void FrameCoalescerTest::testOrdering()
+{
+	FrameCoalescer coalescer;
+	std::vector<std::string> frames;
+	frames.push_back(frame(1, "first"));
+	frames.push_back(frame(2, "second"));
+	frames.push_back(frame(1, "third"));
+	frames.push_back(frame(3, ""));
+	for (std::size_t i = 0; i < frames.size(); i++)
+	{
+		bool owner = false;
+		assert (coalescer.add(frames[i].data(), frames[i].size(), owner));
+		assert (owner == (i == 0));
+	}
+	coalescer.flush(*_pWebSocket);
+	assert (coalescer.framesSent() == 1);
+	assert (coalescer.recordsSent() == frames.size());
+
+	std::vector<std::string> records = receiveRecords();
+	assert (records == frames);
+
+	// the next batch starts empty, with a new owner
+	bool owner = false;
+	assert (coalescer.add(frames[1].data(), frames[1].size(), owner));
+	assert (owner);
+	coalescer.flush(*_pWebSocket);
+	assert (receiveFrame() == frames[1]);
+}
+
+
+void FrameCoalescerTest::testBatchFull()
+{
+	FrameCoalescer coalescer;
+	std::string f = frame(1, std::string(100, 'x'));
+	assert (FrameCoalescer::canCoalesce(f.size()));
+	assert (!FrameCoalescer::canCoalesce(Protocol::WT_FRAME_MAX_SIZE));
+
+	std::size_t count = 0;
+	bool owner = false;
+	while (coalescer.add(f.data(), f.size(), owner)) count++;
+	std::size_t expected = (Protocol::WT_FRAME_MAX_SIZE)/(Protocol::WT_RECORD_HEADER_SIZE + f.size());
+	assert (count == expected);
+
+	coalescer.flush(*_pWebSocket);
+	std::vector<std::string> records = receiveRecords();
+	assert (records.size() == count);
+	for (std::size_t i = 0; i < records.size(); i++)
+	{
+		assert (records[i] == f);
+	}
+
+	// the frame that did not fit goes into the next batch
+	assert (coalescer.add(f.data(), f.size(), owner));
+	assert (owner);
+}
+
+
+void FrameCoalescerTest::testGroupCommit()
+{
+	FrameCoalescer coalescer;
+	std::string f = frame(0, "owner");
+	bool owner = false;
+	assert (coalescer.add(f.data(), f.size(), owner));
+	assert (owner);
+
+	// frames added by other threads before the owner flushes
+	// go out with the same WebSocket frame
+	const int THREADS = 4;
+	std::vector<std::string> frames;
+	frames.push_back(f);
+	for (int i = 0; i < THREADS; i++)
+	{
+		frames.push_back(frame(static_cast<Poco::UInt16>(i + 1), "data" + Poco::NumberFormatter::format(i)));
+		AddRunnable ar(coalescer, frames.back());
+		Poco::Thread thread;
+		thread.start(ar);
+		thread.join();
+		assert (ar.added());
+		assert (!ar.owner());
+	}
+	coalescer.flush(*_pWebSocket);
+	assert (coalescer.framesSent() == 1);
+	assert (coalescer.recordsSent() == THREADS + 1);
+	assert (receiveRecords() == frames);
+
+	// a batch becoming full ends the owner's wait early
+	assert (coalescer.add(f.data(), f.size(), owner));
+	assert (owner);
+	WaitRunnable wr(coalescer, 10000);
+	Poco::Thread waiter;
+	waiter.start(wr);
+	Poco::Thread::sleep(100);
+	std::string big = frame(1, std::string(500, 'x'));
+	while (coalescer.add(big.data(), big.size(), owner))
+	{
+		assert (!owner);
+	}
+	waiter.join();
+	assert (wr.elapsed() < 5000);
+	coalescer.flush(*_pWebSocket);
+	assert (coalescer.framesSent() == 2);
+	std::vector<std::string> records = receiveRecords();
+	assert (records.size() > 1);
+	assert (records[0] == f);
+}
+
+
+void FrameCoalescerTest::testWaitAfterFlush()
+{
+	FrameCoalescer coalescer;
+	std::string f = frame(1, std::string(500, 'x'));
+	bool owner = false;
+
+	// fill the batch with no one waiting
+	while (coalescer.add(f.data(), f.size(), owner));
+	coalescer.flush(*_pWebSocket);
+	receiveFrame();
+
+	// the full signal of the previous batch must not end the wait
+	assert (coalescer.add(f.data(), f.size(), owner));
+	assert (owner);
+	Poco::Stopwatch sw;
+	sw.start();
+	coalescer.wait(300);
+	sw.stop();
+	assert (sw.elapsed()/1000 >= 250);
+	coalescer.flush(*_pWebSocket);
+	assert (receiveFrame() == f);
+}
+
+
+void FrameCoalescerTest::testFlushBeforeSend()
+{
+	FrameCoalescer coalescer;
+	std::string f1 = frame(1, "one");
+	std::string f2 = frame(2, "two");
+	std::string f3 = frame(1, std::string(Protocol::WT_FRAME_MAX_SIZE, 'x'));
+	bool owner = false;
+	assert (coalescer.add(f1.data(), f1.size(), owner));
+	assert (coalescer.add(f2.data(), f2.size(), owner));
+
+	// a frame sent directly must not overtake frames already in the batch
+	coalescer.send(*_pWebSocket, f3.data(), f3.size());
+	assert (coalescer.framesSent() == 2);
+	assert (coalescer.recordsSent() == 3);
+
+	std::vector<std::string> records = receiveRecords();
+	assert (records.size() == 2);
+	assert (records[0] == f1);
+	assert (records[1] == f2);
+	assert (receiveFrame() == f3);
+
+	// with an empty batch, only the frame itself is sent
+	coalescer.send(*_pWebSocket, f1.data(), f1.size());
+	assert (coalescer.framesSent() == 3);
+	assert (receiveFrame() == f1);
+}
+
+
+std::string FrameCoalescerTest::receiveFrame()
+{
+	Poco::Buffer<char> buffer(2*Protocol::WT_FRAME_MAX_SIZE);
+	int flags;
+	int n = _pWebSocket->receiveFrame(buffer.begin(), static_cast<int>(buffer.size()), flags);
+	assert (n > 0);
+	return std::string(buffer.begin(), n);
+}
+
+
+std::vector<std::string> FrameCoalescerTest::receiveRecords()
+{
+	std::string f = receiveFrame();
+	Poco::UInt8 opcode;
+	Poco::UInt8 flags;
+	Poco::UInt16 channel;
+	std::size_t offset = Protocol::readHeader(f.data(), f.size(), opcode, flags, channel);
+	assert (opcode == Protocol::WT_OP_MULTI_RECORD);
+	assert (f.size() <= Protocol::WT_FRAME_MAX_SIZE + Protocol::WT_FRAME_HEADER_SIZE);
+
+	std::vector<std::string> records;
+	while (offset < f.size())
+	{
+		std::size_t recordSize;
+		std::size_t rhn = Protocol::readRecordHeader(f.data() + offset, f.size() - offset, recordSize);
+		assert (rhn == Protocol::WT_RECORD_HEADER_SIZE);
+		offset += rhn;
+		records.push_back(f.substr(offset, recordSize));
+		offset += recordSize;
+	}
+	return records;
+}
+
+
+void FrameCoalescerTest::setUp()
+{
+	Poco::Net::ServerSocket ss(0);
+	_pServer = new Poco::Net::HTTPServer(new EchoRequestHandlerFactory, ss, new Poco::Net::HTTPServerParams);
+	_pServer->start();
+
+	Poco::Net::HTTPClientSession cs("127.0.0.1", ss.address().port());
+	Poco::Net::HTTPRequest request(Poco::Net::HTTPRequest::HTTP_GET, "/ws", Poco::Net::HTTPRequest::HTTP_1_1);
+	Poco::Net::HTTPResponse response;
+	_pWebSocket = new WebSocket(cs, request, response);
+	_pWebSocket->setReceiveTimeout(Poco::Timespan(10, 0));
+}
+
+
+void FrameCoalescerTest::tearDown()
+{
+	if (_pWebSocket)
+	{
+		_pWebSocket->shutdown();
+		_pWebSocket = 0;
+	}
+	if (_pServer)
+	{
+		_pServer->stop();
+		_pServer = 0;
+	}
+}
+
+
+CppUnit::Test* FrameCoalescerTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("FrameCoalescerTest");
+
+	CppUnit_addTest(pSuite, FrameCoalescerTest, testSingleRecord);
+	CppUnit_addTest(pSuite, FrameCoalescerTest, testOrdering);
+	CppUnit_addTest(pSuite, FrameCoalescerTest, testBatchFull);
+	CppUnit_addTest(pSuite, FrameCoalescerTest, testGroupCommit);
+	CppUnit_addTest(pSuite, FrameCoalescerTest, testWaitAfterFlush);
+	CppUnit_addTest(pSuite, FrameCoalescerTest, testFlushBeforeSend);
+
+	return pSuite;
+}
@@ -0,0 +1,53 @@
+//
+// FrameCoalescerTest.h
+//
+// Definition of the FrameCoalescerTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef FrameCoalescerTest_INCLUDED
+#define FrameCoalescerTest_INCLUDED
+
+
+#include "Poco/WebTunnel/WebTunnel.h"
+#include "Poco/Net/WebSocket.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/SharedPtr.h"
+#include "CppUnit/TestCase.h"
+#include <vector>
+
+
+class FrameCoalescerTest: public CppUnit::TestCase
+{
+public:
+	FrameCoalescerTest(const std::string& name);
+	~FrameCoalescerTest();
+
+	void testSingleRecord();
+	void testOrdering();
+	void testBatchFull();
+	void testGroupCommit();
+	void testWaitAfterFlush();
+	void testFlushBeforeSend();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+protected:
+	std::string receiveFrame();
+	std::vector<std::string> receiveRecords();
+
+private:
+	Poco::SharedPtr<Poco::Net::HTTPServer> _pServer;
+	Poco::SharedPtr<Poco::Net::WebSocket> _pWebSocket;
+};
+
+
+#endif // FrameCoalescerTest_INCLUDED
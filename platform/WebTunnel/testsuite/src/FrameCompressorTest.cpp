@@ -0,0 +1,204 @@
+//
+// FrameCompressorTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "FrameCompressorTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/WebTunnel/FrameCompressor.h"
+#include "Poco/WebTunnel/FrameDecompressor.h"
+#include "Poco/WebTunnel/Protocol.h"
+#include "Poco/Random.h"
+#include "Poco/Buffer.h"
+#include "Poco/Exception.h"
+#include <cstring>
+
+
+using Poco::WebTunnel::FrameCompressor;
+using Poco::WebTunnel::FrameDecompressor;
+using Poco::WebTunnel::Protocol;
+
+
+namespace
+{
+	std::string text(std::size_t size)
+	{
+		static const std::string LINE("GET /index.html HTTP/1.1\r\nHost: localhost\r\n\r\n");
+		std::string result;
+		while (result.size() < size) result += LINE;
+		result.resize(size);
+		return result;
+	}
+
+	std::string noise(std::size_t size)
+	{
+		Poco::Random rnd;
+		rnd.seed(42);
+		std::string result;
+		for (std::size_t i = 0; i < size; i++)
+		{
+			result += static_cast<char>(rnd.next(256));
+		}
+		return result;
+	}
+}
+
+
+FrameCompressorTest::FrameCompressorTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+FrameCompressorTest::~FrameCompressorTest()
+{
+}
+
+
+void FrameCompressorTest::testRoundTrip()
+{
+	FrameCompressor compressor;
+	FrameDecompressor decompressor;
+	Poco::Buffer<char> compressed(Protocol::WT_FRAME_MAX_SIZE);
+	Poco::Buffer<char> decompressed(Protocol::WT_FRAME_MAX_SIZE);
+
+	// frames are compressed independently, so the same
+	// compressor and decompressor can be used repeatedly
+	for (std::size_t size = 100; size <= 1000; size += 300)
+	{
+		std::string data = text(size);
+		std::size_t cn = compressor.compress(data.data(), data.size(), compressed.begin(), compressed.size());
+		assert (cn > 0);
+		assert (cn < data.size());
+
+		std::size_t dn = decompressor.decompress(compressed.begin(), cn, decompressed.begin(), decompressed.size());
+		assert (dn == data.size());
+		assert (std::memcmp(decompressed.begin(), data.data(), dn) == 0);
+	}
+}
+
+
+void FrameCompressorTest::testSmallPayload()
+{
+	FrameCompressor compressor;
+	char compressed[256];
+	std::string data = text(FrameCompressor::MIN_COMPRESS_SIZE - 1);
+	assert (compressor.compress(data.data(), data.size(), compressed, sizeof(compressed)) == 0);
+	data = text(FrameCompressor::MIN_COMPRESS_SIZE);
+	assert (compressor.compress(data.data(), data.size(), compressed, sizeof(compressed)) > 0);
+}
+
+
+void FrameCompressorTest::testIncompressible()
+{
+	FrameCompressor compressor;
+	Poco::Buffer<char> compressed(Protocol::WT_FRAME_MAX_SIZE);
+	std::string data = noise(1024);
+	assert (compressor.compress(data.data(), data.size(), compressed.begin(), compressed.size()) == 0);
+
+	// the compressor must still be usable afterwards
+	data = text(1024);
+	assert (compressor.compress(data.data(), data.size(), compressed.begin(), compressed.size()) > 0);
+}
+
+
+void FrameCompressorTest::testMaxFrameSize()
+{
+	FrameCompressor compressor;
+	FrameDecompressor decompressor;
+	Poco::Buffer<char> compressed(Protocol::WT_FRAME_MAX_SIZE);
+	Poco::Buffer<char> decompressed(Protocol::WT_FRAME_MAX_SIZE);
+	std::string data = text(Protocol::WT_FRAME_MAX_SIZE);
+	std::size_t cn = compressor.compress(data.data(), data.size(), compressed.begin(), compressed.size());
+	assert (cn > 0);
+	std::size_t dn = decompressor.decompress(compressed.begin(), cn, decompressed.begin(), decompressed.size());
+	assert (dn == data.size());
+	assert (std::memcmp(decompressed.begin(), data.data(), dn) == 0);
+}
+
+
+void FrameCompressorTest::testCorruptData()
+{
+	FrameDecompressor decompressor;
+	Poco::Buffer<char> decompressed(Protocol::WT_FRAME_MAX_SIZE);
+	std::string data = noise(100);
+	data[0] = static_cast<char>(0xFF); // invalid deflate block type
+	try
+	{
+		decompressor.decompress(data.data(), data.size(), decompressed.begin(), decompressed.size());
+		fail("corrupt data - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+
+	// a truncated frame is corrupt, too
+	FrameCompressor compressor;
+	Poco::Buffer<char> compressed(Protocol::WT_FRAME_MAX_SIZE);
+	data = text(1000);
+	std::size_t cn = compressor.compress(data.data(), data.size(), compressed.begin(), compressed.size());
+	assert (cn > 2);
+	try
+	{
+		decompressor.decompress(compressed.begin(), cn/2, decompressed.begin(), decompressed.size());
+		fail("truncated data - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+
+	// the decompressor must still be usable afterwards
+	std::size_t dn = decompressor.decompress(compressed.begin(), cn, decompressed.begin(), decompressed.size());
+	assert (dn == data.size());
+}
+
+
+void FrameCompressorTest::testBufferTooSmall()
+{
+	FrameCompressor compressor;
+	FrameDecompressor decompressor;
+	Poco::Buffer<char> compressed(Protocol::WT_FRAME_MAX_SIZE);
+	Poco::Buffer<char> decompressed(Protocol::WT_FRAME_MAX_SIZE);
+	std::string data = text(Protocol::WT_FRAME_MAX_SIZE);
+	std::size_t cn = compressor.compress(data.data(), data.size(), compressed.begin(), compressed.size());
+	assert (cn > 0);
+	try
+	{
+		// a peer must not send more than WT_FRAME_MAX_SIZE bytes of payload
+		decompressor.decompress(compressed.begin(), cn, decompressed.begin(), Protocol::WT_FRAME_MAX_SIZE/2);
+		fail("decompressed data exceeds buffer - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+}
+
+
+void FrameCompressorTest::setUp()
+{
+}
+
+
+void FrameCompressorTest::tearDown()
+{
+}
+
+
+CppUnit::Test* FrameCompressorTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("FrameCompressorTest");
+
+	CppUnit_addTest(pSuite, FrameCompressorTest, testRoundTrip);
+	CppUnit_addTest(pSuite, FrameCompressorTest, testSmallPayload);
+	CppUnit_addTest(pSuite, FrameCompressorTest, testIncompressible);
+	CppUnit_addTest(pSuite, FrameCompressorTest, testMaxFrameSize);
+	CppUnit_addTest(pSuite, FrameCompressorTest, testCorruptData);
+	CppUnit_addTest(pSuite, FrameCompressorTest, testBufferTooSmall);
+
+	return pSuite;
+}
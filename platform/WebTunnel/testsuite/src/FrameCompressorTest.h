@@ -0,0 +1,41 @@
+//
+// FrameCompressorTest.h
+//
+// Definition of the FrameCompressorTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef FrameCompressorTest_INCLUDED
+#define FrameCompressorTest_INCLUDED
+
+
+#include "Poco/WebTunnel/WebTunnel.h"
+#include "CppUnit/TestCase.h"
+
+
+class FrameCompressorTest: public CppUnit::TestCase
+{
+public:
+	FrameCompressorTest(const std::string& name);
+	~FrameCompressorTest();
+
+	void testRoundTrip();
+	void testSmallPayload();
+	void testIncompressible();
+	void testMaxFrameSize();
+	void testCorruptData();
+	void testBufferTooSmall();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // FrameCompressorTest_INCLUDED
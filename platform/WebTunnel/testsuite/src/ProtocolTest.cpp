@@ -0,0 +1,287 @@
+//
+// ProtocolTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ProtocolTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/WebTunnel/Protocol.h"
+#include <vector>
+
+
+using Poco::WebTunnel::Protocol;
+
+
+namespace
+{
+	void appendRecord(std::string& frame, const std::string& record)
+	{
+		frame += static_cast<char>((record.size() >> 8) & 0xFF);
+		frame += static_cast<char>(record.size() & 0xFF);
+		frame += record;
+	}
+
+	std::string dataFrame(Poco::UInt16 channel, const std::string& payload)
+	{
+		char header[Protocol::WT_FRAME_HEADER_SIZE];
+		std::size_t hn = Protocol::writeHeader(header, sizeof(header), Protocol::WT_OP_DATA, 0, channel);
+		return std::string(header, hn) + payload;
+	}
+}
+
+
+ProtocolTest::ProtocolTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ProtocolTest::~ProtocolTest()
+{
+}
+
+
+void ProtocolTest::testDataHeader()
+{
+	char buffer[Protocol::WT_FRAME_HEADER_SIZE];
+	std::size_t n = Protocol::writeHeader(buffer, sizeof(buffer), Protocol::WT_OP_DATA, Protocol::WT_FLAG_DEFLATE, 0x1234);
+	assert (n == Protocol::WT_FRAME_HEADER_SIZE);
+	assert (buffer[0] == 0x00);
+	assert (buffer[1] == 0x01);
+	assert (buffer[2] == 0x12);
+	assert (buffer[3] == 0x34);
+
+	Poco::UInt8 opcode = 0xFF;
+	Poco::UInt8 flags = 0xFF;
+	Poco::UInt16 channel = 0;
+	Poco::UInt16 portOrErrorCode = 0xFFFF;
+	n = Protocol::readHeader(buffer, sizeof(buffer), opcode, flags, channel, &portOrErrorCode);
+	assert (n == Protocol::WT_FRAME_HEADER_SIZE);
+	assert (opcode == Protocol::WT_OP_DATA);
+	assert (flags == Protocol::WT_FLAG_DEFLATE);
+	assert (channel == 0x1234);
+	assert (portOrErrorCode == 0xFFFF);
+}
+
+
+void ProtocolTest::testCreditHeader()
+{
+	char buffer[16];
+	std::size_t n = Protocol::writeHeader(buffer, sizeof(buffer), Protocol::WT_OP_CREDIT, 0, 7, 0xFFFF);
+	assert (n == 6);
+	assert (buffer[0] == Protocol::WT_OP_CREDIT);
+	assert (buffer[1] == 0x00);
+	assert (buffer[2] == 0x00);
+	assert (buffer[3] == 0x07);
+	assert (static_cast<unsigned char>(buffer[4]) == 0xFF);
+	assert (static_cast<unsigned char>(buffer[5]) == 0xFF);
+
+	Poco::UInt8 opcode = 0;
+	Poco::UInt8 flags = 0xFF;
+	Poco::UInt16 channel = 0;
+	Poco::UInt16 credit = 0;
+	n = Protocol::readHeader(buffer, n, opcode, flags, channel, &credit);
+	assert (n == 6);
+	assert (opcode == Protocol::WT_OP_CREDIT);
+	assert (flags == 0);
+	assert (channel == 7);
+	assert (credit == 0xFFFF);
+
+	n = Protocol::writeHeader(buffer, sizeof(buffer), Protocol::WT_OP_CREDIT, 0, 0x0102, 2048);
+	assert (n == 6);
+	n = Protocol::readHeader(buffer, n, opcode, flags, channel, &credit);
+	assert (n == 6);
+	assert (channel == 0x0102);
+	assert (credit == 2048);
+
+	// without pPortOrErrorCode, only the common header is read
+	n = Protocol::readHeader(buffer, 6, opcode, flags, channel);
+	assert (n == Protocol::WT_FRAME_HEADER_SIZE);
+	assert (opcode == Protocol::WT_OP_CREDIT);
+}
+
+
+void ProtocolTest::testOpenRequestHeader()
+{
+	char buffer[16];
+	std::size_t n = Protocol::writeHeader(buffer, sizeof(buffer), Protocol::WT_OP_OPEN_REQUEST, 0, 1, 22);
+	assert (n == 6);
+
+	Poco::UInt8 opcode = 0;
+	Poco::UInt8 flags = 0;
+	Poco::UInt16 channel = 0;
+	Poco::UInt16 port = 0;
+	n = Protocol::readHeader(buffer, n, opcode, flags, channel, &port);
+	assert (n == 6);
+	assert (opcode == Protocol::WT_OP_OPEN_REQUEST);
+	assert (channel == 1);
+	assert (port == 22);
+
+	// the port is not part of a confirmation
+	n = Protocol::writeHeader(buffer, sizeof(buffer), Protocol::WT_OP_OPEN_CONFIRM, 0, 1, 22);
+	assert (n == Protocol::WT_FRAME_HEADER_SIZE);
+	n = Protocol::readHeader(buffer, n, opcode, flags, channel, &port);
+	assert (n == Protocol::WT_FRAME_HEADER_SIZE);
+	assert (opcode == Protocol::WT_OP_OPEN_CONFIRM);
+}
+
+
+void ProtocolTest::testErrorHeader()
+{
+	char buffer[16];
+	std::size_t n = Protocol::writeHeader(buffer, sizeof(buffer), Protocol::WT_OP_OPEN_FAULT, 0, 3, Protocol::WT_ERR_CONN_REFUSED);
+	assert (n == 6);
+
+	Poco::UInt8 opcode = 0;
+	Poco::UInt8 flags = 0;
+	Poco::UInt16 channel = 0;
+	Poco::UInt16 errorCode = 0;
+	n = Protocol::readHeader(buffer, n, opcode, flags, channel, &errorCode);
+	assert (n == 6);
+	assert (opcode == Protocol::WT_OP_OPEN_FAULT);
+	assert (channel == 3);
+	assert (errorCode == Protocol::WT_ERR_CONN_REFUSED);
+
+	n = Protocol::writeHeader(buffer, sizeof(buffer), Protocol::WT_OP_ERROR, 0, 4, Protocol::WT_ERR_PROTOCOL);
+	assert (n == 6);
+	n = Protocol::readHeader(buffer, n, opcode, flags, channel, &errorCode);
+	assert (n == 6);
+	assert (opcode == Protocol::WT_OP_ERROR);
+	assert (channel == 4);
+	assert (errorCode == Protocol::WT_ERR_PROTOCOL);
+
+	n = Protocol::writeHeader(buffer, sizeof(buffer), Protocol::WT_OP_CLOSE, 0, 5);
+	assert (n == Protocol::WT_FRAME_HEADER_SIZE);
+}
+
+
+void ProtocolTest::testCapabilities()
+{
+	assert (Protocol::formatCapabilities(Protocol::WT_CAP_NONE).empty());
+	assert (Protocol::formatCapabilities(Protocol::WT_CAP_FLOW_CONTROL) == "flow-control");
+	assert (Protocol::formatCapabilities(Protocol::WT_CAP_DEFLATE | Protocol::WT_CAP_MULTI_RECORD) == "deflate, multi-record");
+	assert (Protocol::formatCapabilities(Protocol::WT_CAP_ALL) == "flow-control, deflate, multi-record");
+
+	assert (Protocol::parseCapabilities("") == Protocol::WT_CAP_NONE);
+	assert (Protocol::parseCapabilities("flow-control, deflate, multi-record") == Protocol::WT_CAP_ALL);
+	assert (Protocol::parseCapabilities("Deflate,unknown,,MULTI-RECORD") == (Protocol::WT_CAP_DEFLATE | Protocol::WT_CAP_MULTI_RECORD));
+	assert (Protocol::parseCapabilities(Protocol::formatCapabilities(Protocol::WT_CAP_FLOW_CONTROL)) == Protocol::WT_CAP_FLOW_CONTROL);
+}
+
+
+void ProtocolTest::testReadRecordHeader()
+{
+	std::size_t recordSize = 0;
+	const char buffer[] = {0x01, 0x02, 'x'};
+	assert (Protocol::readRecordHeader(buffer, 0, recordSize) == 0);
+	assert (Protocol::readRecordHeader(buffer, 1, recordSize) == 0);
+
+	// record size 0x0102 exceeds the buffer
+	assert (Protocol::readRecordHeader(buffer, sizeof(buffer), recordSize) == 0);
+
+	const char empty[] = {0x00, 0x00};
+	assert (Protocol::readRecordHeader(empty, sizeof(empty), recordSize) == Protocol::WT_RECORD_HEADER_SIZE);
+	assert (recordSize == 0);
+
+	const char exact[] = {0x00, 0x01, 'x'};
+	assert (Protocol::readRecordHeader(exact, sizeof(exact), recordSize) == Protocol::WT_RECORD_HEADER_SIZE);
+	assert (recordSize == 1);
+	assert (Protocol::readRecordHeader(exact, sizeof(exact) - 1, recordSize) == 0);
+
+	const char large[] = {static_cast<char>(0x80), static_cast<char>(0xFF)};
+	assert (Protocol::readRecordHeader(large, sizeof(large), recordSize) == 0);
+	assert (recordSize == 0x80FF);
+}
+
+
+void ProtocolTest::testMultiRecordFrame()
+{
+	std::vector<std::string> records;
+	records.push_back(dataFrame(1, "Hello"));
+	char credit[16];
+	records.push_back(std::string(credit, Protocol::writeHeader(credit, sizeof(credit), Protocol::WT_OP_CREDIT, 0, 2, 4096)));
+	records.push_back(dataFrame(3, std::string(300, 'x')));
+	records.push_back(dataFrame(1, ""));
+
+	char header[Protocol::WT_FRAME_HEADER_SIZE];
+	std::string frame(header, Protocol::writeHeader(header, sizeof(header), Protocol::WT_OP_MULTI_RECORD, 0, 0));
+	for (std::vector<std::string>::const_iterator it = records.begin(); it != records.end(); ++it)
+	{
+		appendRecord(frame, *it);
+	}
+
+	Poco::UInt8 opcode;
+	Poco::UInt8 flags;
+	Poco::UInt16 channel;
+	std::size_t offset = Protocol::readHeader(frame.data(), frame.size(), opcode, flags, channel);
+	assert (offset == Protocol::WT_FRAME_HEADER_SIZE);
+	assert (opcode == Protocol::WT_OP_MULTI_RECORD);
+	assert (channel == 0);
+
+	std::vector<std::string> parsed;
+	while (offset < frame.size())
+	{
+		std::size_t recordSize;
+		std::size_t rhn = Protocol::readRecordHeader(frame.data() + offset, frame.size() - offset, recordSize);
+		assert (rhn == Protocol::WT_RECORD_HEADER_SIZE);
+		offset += rhn;
+		parsed.push_back(frame.substr(offset, recordSize));
+		offset += recordSize;
+	}
+	assert (offset == frame.size());
+	assert (parsed == records);
+
+	// records are complete frames
+	Poco::UInt16 creditValue = 0;
+	std::size_t hn = Protocol::readHeader(parsed[1].data(), parsed[1].size(), opcode, flags, channel, &creditValue);
+	assert (hn == parsed[1].size());
+	assert (opcode == Protocol::WT_OP_CREDIT);
+	assert (channel == 2);
+	assert (creditValue == 4096);
+
+	// a truncated last record is detected
+	std::string truncated = frame.substr(0, frame.size() - 1);
+	offset = Protocol::WT_FRAME_HEADER_SIZE;
+	std::size_t complete = 0;
+	for (;;)
+	{
+		std::size_t recordSize;
+		std::size_t rhn = Protocol::readRecordHeader(truncated.data() + offset, truncated.size() - offset, recordSize);
+		if (rhn == 0) break;
+		offset += rhn + recordSize;
+		complete++;
+	}
+	assert (complete == records.size() - 1);
+	assert (offset < truncated.size());
+}
+
+
+void ProtocolTest::setUp()
+{
+}
+
+
+void ProtocolTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ProtocolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ProtocolTest");
+
+	CppUnit_addTest(pSuite, ProtocolTest, testDataHeader);
+	CppUnit_addTest(pSuite, ProtocolTest, testCreditHeader);
+	CppUnit_addTest(pSuite, ProtocolTest, testOpenRequestHeader);
+	CppUnit_addTest(pSuite, ProtocolTest, testErrorHeader);
+	CppUnit_addTest(pSuite, ProtocolTest, testCapabilities);
+	CppUnit_addTest(pSuite, ProtocolTest, testReadRecordHeader);
+	CppUnit_addTest(pSuite, ProtocolTest, testMultiRecordFrame);
+
+	return pSuite;
+}
@@ -0,0 +1,42 @@
+//
+// ProtocolTest.h
+//
+// Definition of the ProtocolTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef ProtocolTest_INCLUDED
+#define ProtocolTest_INCLUDED
+
+
+#include "Poco/WebTunnel/WebTunnel.h"
+#include "CppUnit/TestCase.h"
+
+
+class ProtocolTest: public CppUnit::TestCase
+{
+public:
+	ProtocolTest(const std::string& name);
+	~ProtocolTest();
+
+	void testDataHeader();
+	void testCreditHeader();
+	void testOpenRequestHeader();
+	void testErrorHeader();
+	void testCapabilities();
+	void testReadRecordHeader();
+	void testMultiRecordFrame();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // ProtocolTest_INCLUDED
@@ -0,0 +1,28 @@
+//
+// WebTunnelTestSuite.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "WebTunnelTestSuite.h"
+#include "ProtocolTest.h"
+#include "FrameCompressorTest.h"
+#include "FrameCoalescerTest.h"
+#include "CreditWindowTest.h"
+
+
+CppUnit::Test* WebTunnelTestSuite::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("WebTunnelTestSuite");
+
+	pSuite->addTest(ProtocolTest::suite());
+	pSuite->addTest(FrameCompressorTest::suite());
+	pSuite->addTest(FrameCoalescerTest::suite());
+	pSuite->addTest(CreditWindowTest::suite());
+
+	return pSuite;
+}
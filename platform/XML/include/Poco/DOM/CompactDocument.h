@@ -0,0 +1,382 @@
+//
+// CompactDocument.h
+//
+// Library: XML
+// Package: DOM
+// Module:  CompactDocument
+//
+// Definition of the CompactDocument and CompactNode classes.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef DOM_CompactDocument_INCLUDED
+#define DOM_CompactDocument_INCLUDED
+
+
+#include "Poco/XML/XML.h"
+#include "Poco/XML/XMLString.h"
+#include "Poco/XML/Name.h"
+#include "Poco/SharedPtr.h"
+#include <vector>
+
+
+namespace Poco {
+namespace XML {
+
+
+class CompactDocumentParser;
+
+
+class XML_API CompactNode
+	/// A read-only element or text node in a CompactDocument.
+	///
+	/// Names are shared by all nodes of a document with the same
+	/// name, and can therefore also be compared by address.
+	/// Text and attribute values are zero-terminated strings owned
+	/// by the document.
+	///
+	/// Comments, processing instructions and the document type
+	/// declaration are not kept. CDATA sections become ordinary
+	/// text, and adjacent text is merged into a single text node.
+{
+public:
+	enum
+	{
+		ELEMENT_NODE = 1, /// The node is an Element.
+		TEXT_NODE    = 3  /// The node is a Text node.
+	};
+
+	unsigned short nodeType() const;
+		/// Returns the type of the node, ELEMENT_NODE or TEXT_NODE.
+
+	const Name& name() const;
+		/// Returns the name of an element, or an empty
+		/// name for a text node.
+
+	const XMLString& nodeName() const;
+		/// Returns the qualified name of an element,
+		/// or "#text" for a text node.
+
+	const XMLString& localName() const;
+		/// Returns the local name of an element.
+
+	const XMLString& namespaceURI() const;
+		/// Returns the namespace URI of an element, if namespace
+		/// processing was enabled when parsing the document.
+
+	const XMLChar* value() const;
+		/// Returns the zero-terminated text of a text node,
+		/// or an empty string for an element.
+
+	std::size_t valueLength() const;
+		/// Returns the length of the text of a text node.
+
+	XMLString nodeValue() const;
+		/// Returns a copy of the text of a text node.
+
+	XMLString innerText() const;
+		/// Returns the text of this node and all its descendants.
+
+	const CompactNode* parentNode() const;
+		/// Returns the parent element, or null for the document element.
+
+	const CompactNode* firstChild() const;
+		/// Returns the first child node, or null if there is none.
+
+	const CompactNode* nextSibling() const;
+		/// Returns the next sibling node, or null if there is none.
+
+	const CompactNode* firstChildElement() const;
+		/// Returns the first child element, or null if there is none.
+
+	const CompactNode* nextSiblingElement() const;
+		/// Returns the next sibling element, or null if there is none.
+
+	const CompactNode* getChildElement(const XMLString& name) const;
+		/// Returns the first child element with the given
+		/// qualified name, or null if there is none.
+
+	int attributeCount() const;
+		/// Returns the number of attributes of an element.
+
+	const Name& attributeName(int index) const;
+		/// Returns the name of the attribute with the given index.
+
+	const XMLChar* attributeValue(int index) const;
+		/// Returns the zero-terminated value of the attribute
+		/// with the given index.
+
+	const XMLChar* findAttribute(const XMLString& name) const;
+		/// Returns the zero-terminated value of the attribute with
+		/// the given qualified name, or null if there is no such
+		/// attribute.
+
+	bool hasAttribute(const XMLString& name) const;
+		/// Returns true if the element has an attribute with
+		/// the given qualified name.
+
+	XMLString getAttribute(const XMLString& name) const;
+		/// Returns the value of the attribute with the given qualified
+		/// name, or an empty string if there is no such attribute.
+
+protected:
+	struct Attribute
+	{
+		const Name* pName;
+		const XMLChar* pValue;
+	};
+
+	CompactNode(unsigned short type, const Name* pName);
+	~CompactNode();
+
+	void appendChild(CompactNode* pChild);
+	void appendText(XMLString& text) const;
+
+private:
+	CompactNode();
+	CompactNode(const CompactNode&);
+	CompactNode& operator = (const CompactNode&);
+
+	unsigned short _type;
+	int _attributeCount;
+	const Name* _pName;
+	const XMLChar* _pValue;
+	std::size_t _valueLength;
+	Attribute* _pAttributes;
+	CompactNode* _pParent;
+	CompactNode* _pFirstChild;
+	CompactNode* _pLastChild;
+	CompactNode* _pNext;
+
+	static const XMLString TEXT_NAME;
+
+	friend class CompactDocument;
+	friend class CompactDocumentParser;
+};
+
+
+class XML_API CompactDocument
+	/// A read-only, memory-efficient alternative to Document,
+	/// created by CompactDocumentParser.
+	///
+	/// Where a Document allocates every node and string
+	/// individually, a CompactDocument places all its nodes and
+	/// strings in a few large memory blocks (an arena), which are
+	/// released together when the document is destroyed.
+	/// Element and attribute names are interned, so each distinct
+	/// name is stored only once per document.
+	///
+	/// This makes a CompactDocument a good fit for configuration
+	/// files and other documents that are parsed once and then
+	/// only read. The document cannot be modified, and it does
+	/// not support the DOM APIs (events, iterators, serialization).
+{
+public:
+	typedef Poco::SharedPtr<CompactDocument> Ptr;
+
+	CompactDocument();
+		/// Creates an empty CompactDocument.
+
+	~CompactDocument();
+		/// Destroys the CompactDocument, together with all its nodes.
+
+	const CompactNode* documentElement() const;
+		/// Returns the document element, or null if the
+		/// document is empty.
+
+	std::size_t nodeCount() const;
+		/// Returns the number of nodes in the document.
+
+	std::size_t nameCount() const;
+		/// Returns the number of distinct names in the document.
+
+	std::size_t memoryUsed() const;
+		/// Returns the number of bytes in the memory blocks
+		/// allocated for nodes and strings.
+
+protected:
+	void* allocate(std::size_t size);
+		/// Allocates memory from the arena.
+
+	const XMLChar* copyString(const XMLChar* pString, std::size_t length);
+		/// Copies the given string into the arena, adding a
+		/// terminating zero.
+
+	const Name& internName(const XMLChar* pRawName, bool namespaces);
+		/// Returns the name for the given name, as reported by expat.
+		///
+		/// If namespaces is true, the raw name consists of namespace URI,
+		/// local name and prefix, separated by tab characters.
+
+	CompactNode* createNode(unsigned short type, const Name* pName);
+		/// Creates a new node in the arena.
+
+	void setDocumentElement(CompactNode* pElement);
+
+	static unsigned long hash(const XMLChar* pString, std::size_t length);
+
+private:
+	CompactDocument(const CompactDocument&);
+	CompactDocument& operator = (const CompactDocument&);
+
+	enum
+	{
+		MIN_BLOCK_SIZE = 4096,
+		MAX_BLOCK_SIZE = 65536,
+		ALIGNMENT      = 8
+	};
+
+	struct NameEntry
+	{
+		unsigned long hash;
+		const XMLChar* pKey;
+		std::size_t length;
+		const Name* pName;
+	};
+
+	void growNameTable();
+
+	std::vector<char*> _blocks;
+	char* _pFree;
+	std::size_t _available;
+	std::size_t _blockSize;
+	std::size_t _memoryUsed;
+	std::vector<NameEntry> _nameTable;
+	std::vector<Name*> _names;
+	CompactNode* _pDocumentElement;
+	std::size_t _nodeCount;
+
+	friend class CompactDocumentParser;
+};
+
+
+//
+// inlines
+//
+inline unsigned short CompactNode::nodeType() const
+{
+	return _type;
+}
+
+
+inline const Name& CompactNode::name() const
+{
+	return *_pName;
+}
+
+
+inline const XMLString& CompactNode::nodeName() const
+{
+	return _type == TEXT_NODE ? TEXT_NAME : _pName->qname();
+}
+
+
+inline const XMLString& CompactNode::localName() const
+{
+	return _pName->localName();
+}
+
+
+inline const XMLString& CompactNode::namespaceURI() const
+{
+	return _pName->namespaceURI();
+}
+
+
+inline const XMLChar* CompactNode::value() const
+{
+	return _pValue;
+}
+
+
+inline std::size_t CompactNode::valueLength() const
+{
+	return _valueLength;
+}
+
+
+inline XMLString CompactNode::nodeValue() const
+{
+	return XMLString(_pValue, _valueLength);
+}
+
+
+inline const CompactNode* CompactNode::parentNode() const
+{
+	return _pParent;
+}
+
+
+inline const CompactNode* CompactNode::firstChild() const
+{
+	return _pFirstChild;
+}
+
+
+inline const CompactNode* CompactNode::nextSibling() const
+{
+	return _pNext;
+}
+
+
+inline int CompactNode::attributeCount() const
+{
+	return _attributeCount;
+}
+
+
+inline const Name& CompactNode::attributeName(int index) const
+{
+	poco_assert (index >= 0 && index < _attributeCount);
+
+	return *_pAttributes[index].pName;
+}
+
+
+inline const XMLChar* CompactNode::attributeValue(int index) const
+{
+	poco_assert (index >= 0 && index < _attributeCount);
+
+	return _pAttributes[index].pValue;
+}
+
+
+inline bool CompactNode::hasAttribute(const XMLString& name) const
+{
+	return findAttribute(name) != 0;
+}
+
+
+inline const CompactNode* CompactDocument::documentElement() const
+{
+	return _pDocumentElement;
+}
+
+
+inline std::size_t CompactDocument::nodeCount() const
+{
+	return _nodeCount;
+}
+
+
+inline std::size_t CompactDocument::nameCount() const
+{
+	return _names.size();
+}
+
+
+inline std::size_t CompactDocument::memoryUsed() const
+{
+	return _memoryUsed;
+}
+
+
+} } // namespace Poco::XML
+
+
+#endif // DOM_CompactDocument_INCLUDED
@@ -0,0 +1,133 @@
+//
+// CompactDocumentParser.h
+//
+// Library: XML
+// Package: DOM
+// Module:  CompactDocumentParser
+//
+// Definition of the CompactDocumentParser class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef DOM_CompactDocumentParser_INCLUDED
+#define DOM_CompactDocumentParser_INCLUDED
+
+
+#include "Poco/XML/XML.h"
+#if defined(POCO_UNBUNDLED)
+#include <expat.h>
+#else
+#include "Poco/XML/expat.h"
+#endif
+#include "Poco/XML/XMLString.h"
+#include "Poco/DOM/CompactDocument.h"
+#include <istream>
+
+
+namespace Poco {
+namespace XML {
+
+
+class XML_API CompactDocumentParser
+	/// CompactDocumentParser builds a CompactDocument directly from
+	/// expat callbacks, bypassing the SAX layer used by DOMParser.
+	///
+	/// No SAX Attributes or temporary strings are created for
+	/// elements, and text is collected in a reusable buffer
+	/// before being copied into the document's arena.
+	///
+	/// The following features (see setFeature()) are supported:
+	///   - XMLReader::FEATURE_NAMESPACES (default: true)
+	///   - DOMParser::FEATURE_FILTER_WHITESPACE (default: false)
+	///
+	/// External entities are not resolved.
+{
+public:
+	CompactDocumentParser();
+		/// Creates the CompactDocumentParser.
+
+	~CompactDocumentParser();
+		/// Destroys the CompactDocumentParser.
+
+	void setEncoding(const XMLString& encoding);
+		/// Sets the encoding used by the parser if no
+		/// encoding is specified in the XML document.
+
+	const XMLString& getEncoding() const;
+		/// Returns the name of the encoding used by
+		/// the parser if no encoding is specified in
+		/// the XML document.
+
+	void setFeature(const XMLString& name, bool state);
+		/// Set the state of a feature.
+		///
+		/// Throws a SAXNotRecognizedException if the feature
+		/// is not supported.
+
+	bool getFeature(const XMLString& name) const;
+		/// Look up the value of a feature.
+		///
+		/// Throws a SAXNotRecognizedException if the feature
+		/// is not supported.
+
+	CompactDocument::Ptr parse(const XMLString& path);
+		/// Parses the XML document in the file with the given path.
+
+	CompactDocument::Ptr parse(std::istream& istr);
+		/// Parses an XML document from the given stream.
+
+	CompactDocument::Ptr parseString(const std::string& xml);
+		/// Parses an XML document from a string.
+
+	CompactDocument::Ptr parseMemory(const char* xml, std::size_t size);
+		/// Parses an XML document from memory.
+
+protected:
+	void init();
+	void parseBuffer(const char* pBuffer, std::size_t size, bool isFinal);
+	CompactDocument::Ptr finish();
+	void flushText();
+	void handleError();
+
+	static void XMLCALL handleStartElement(void* userData, const XML_Char* name, const XML_Char** atts);
+	static void XMLCALL handleEndElement(void* userData, const XML_Char* name);
+	static void XMLCALL handleCharacterData(void* userData, const XML_Char* s, int len);
+
+private:
+	CompactDocumentParser(const CompactDocumentParser&);
+	CompactDocumentParser& operator = (const CompactDocumentParser&);
+
+	enum
+	{
+		PARSE_BUFFER_SIZE = 16384
+	};
+
+	XML_Parser _parser;
+	XMLString _encoding;
+	bool _encodingSpecified;
+	bool _namespaces;
+	bool _filterWhitespace;
+	CompactDocument::Ptr _pDocument;
+	CompactNode* _pCurrent;
+	XMLString _text;
+};
+
+
+//
+// inlines
+//
+inline const XMLString& CompactDocumentParser::getEncoding() const
+{
+	return _encoding;
+}
+
+
+} } // namespace Poco::XML
+
+
+#endif // DOM_CompactDocumentParser_INCLUDED
@@ -0,0 +1,129 @@
+//
+// DOMBenchmark.cpp
+//
+// This sample compares the time needed to parse XML documents
+// with the DOMParser and with the CompactDocumentParser.
+//
+// Usage: DOMBenchmark [<file> ...]
+//
+// If no files are given, a generated RemoteGen/WSDL-like
+// document is used.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/DOM/DOMParser.h"
+#include "Poco/DOM/Document.h"
+#include "Poco/DOM/AutoPtr.h"
+#include "Poco/DOM/CompactDocumentParser.h"
+#include "Poco/DOM/CompactDocument.h"
+#include "Poco/FileStream.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Exception.h"
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+
+
+using Poco::XML::DOMParser;
+using Poco::XML::Document;
+using Poco::XML::AutoPtr;
+using Poco::XML::CompactDocumentParser;
+using Poco::XML::CompactDocument;
+using Poco::Stopwatch;
+using Poco::Exception;
+
+
+std::string generateDocument()
+{
+	std::ostringstream ostr;
+	ostr << "<definitions xmlns=\"http://schemas.xmlsoap.org/wsdl/\" xmlns:xsd=\"http://www.w3.org/2001/XMLSchema\" xmlns:soap=\"http://schemas.xmlsoap.org/wsdl/soap/\">\n";
+	ostr << "  <types>\n    <xsd:schema targetNamespace=\"urn:benchmark\">\n";
+	for (int i = 0; i < 2000; i++)
+	{
+		ostr << "      <xsd:complexType name=\"Type" << i << "\">\n        <xsd:sequence>\n";
+		for (int j = 0; j < 8; j++)
+		{
+			ostr << "          <xsd:element name=\"field" << j << "\" type=\"xsd:string\" minOccurs=\"0\" maxOccurs=\"1\"/>\n";
+		}
+		ostr << "        </xsd:sequence>\n      </xsd:complexType>\n";
+	}
+	ostr << "    </xsd:schema>\n  </types>\n";
+	for (int i = 0; i < 2000; i++)
+	{
+		ostr << "  <message name=\"Message" << i << "\"><part name=\"parameters\" element=\"Type" << i << "\"/></message>\n";
+		ostr << "  <documentation>Operation " << i << " of the generated benchmark service &amp; some text.</documentation>\n";
+	}
+	ostr << "</definitions>\n";
+	return ostr.str();
+}
+
+
+void benchmark(const std::string& name, const std::string& xml)
+{
+	const int minRuns = 5;
+	const Poco::Timestamp::TimeDiff minTime = 1000000;
+
+	Stopwatch sw;
+	int domRuns = 0;
+	sw.start();
+	while (domRuns < minRuns || sw.elapsed() < minTime)
+	{
+		DOMParser parser;
+		AutoPtr<Document> pDoc = parser.parseString(xml);
+		domRuns++;
+	}
+	sw.stop();
+	double domTime = double(sw.elapsed())/domRuns;
+
+	int compactRuns = 0;
+	std::size_t memoryUsed = 0;
+	std::size_t nodeCount = 0;
+	sw.restart();
+	while (compactRuns < minRuns || sw.elapsed() < minTime)
+	{
+		CompactDocumentParser parser;
+		CompactDocument::Ptr pDoc = parser.parseString(xml);
+		memoryUsed = pDoc->memoryUsed();
+		nodeCount = pDoc->nodeCount();
+		compactRuns++;
+	}
+	sw.stop();
+	double compactTime = double(sw.elapsed())/compactRuns;
+
+	double mb = xml.size()/(1024.0*1024.0);
+	std::printf("%s: %u bytes, %u nodes\n", name.c_str(), static_cast<unsigned>(xml.size()), static_cast<unsigned>(nodeCount));
+	std::printf("  DOMParser:             %10.3f ms (%7.1f MB/s)\n", domTime/1000, mb/(domTime/1000000));
+	std::printf("  CompactDocumentParser: %10.3f ms (%7.1f MB/s), %.2fx, %u bytes arena\n", compactTime/1000, mb/(compactTime/1000000), domTime/compactTime, static_cast<unsigned>(memoryUsed));
+}
+
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		if (argc < 2)
+		{
+			benchmark("generated", generateDocument());
+		}
+		for (int i = 1; i < argc; i++)
+		{
+			Poco::FileInputStream istr(argv[i]);
+			std::string xml;
+			Poco::StreamCopier::copyToString(istr, xml);
+			benchmark(argv[i], xml);
+		}
+	}
+	catch (Exception& exc)
+	{
+		std::cerr << exc.displayText() << std::endl;
+		return 1;
+	}
+	return 0;
+}
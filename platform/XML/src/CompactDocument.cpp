@@ -0,0 +1,297 @@
+//
+// CompactDocument.cpp
+//
+// Library: XML
+// Package: DOM
+// Module:  CompactDocument
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/DOM/CompactDocument.h"
+#include <cstring>
+#include <new>
+
+
+namespace Poco {
+namespace XML {
+
+
+namespace
+{
+	const Name EMPTY_NAME;
+	const XMLChar EMPTY_VALUE[1] = {0};
+}
+
+
+const XMLString CompactNode::TEXT_NAME = toXMLString("#text");
+
+
+CompactNode::CompactNode(unsigned short type, const Name* pName):
+	_type(type),
+	_attributeCount(0),
+	_pName(pName ? pName : &EMPTY_NAME),
+	_pValue(EMPTY_VALUE),
+	_valueLength(0),
+	_pAttributes(0),
+	_pParent(0),
+	_pFirstChild(0),
+	_pLastChild(0),
+	_pNext(0)
+{
+}
+
+
+CompactNode::~CompactNode()
+{
+}
+
+
+void CompactNode::appendChild(CompactNode* pChild)
+{
+	pChild->_pParent = this;
+	if (_pLastChild)
+		_pLastChild->_pNext = pChild;
+	else
+		_pFirstChild = pChild;
+	_pLastChild = pChild;
+}
+
+
+XMLString CompactNode::innerText() const
+{
+	if (_type == TEXT_NODE) return nodeValue();
+
+	XMLString result;
+	appendText(result);
+	return result;
+}
+
+
+void CompactNode::appendText(XMLString& text) const
+{
+	for (const CompactNode* pChild = _pFirstChild; pChild; pChild = pChild->_pNext)
+	{
+		if (pChild->_type == TEXT_NODE)
+			text.append(pChild->_pValue, pChild->_valueLength);
+		else
+			pChild->appendText(text);
+	}
+}
+
+
+const CompactNode* CompactNode::firstChildElement() const
+{
+	const CompactNode* pChild = _pFirstChild;
+	while (pChild && pChild->_type != ELEMENT_NODE) pChild = pChild->_pNext;
+	return pChild;
+}
+
+
+const CompactNode* CompactNode::nextSiblingElement() const
+{
+	const CompactNode* pSibling = _pNext;
+	while (pSibling && pSibling->_type != ELEMENT_NODE) pSibling = pSibling->_pNext;
+	return pSibling;
+}
+
+
+const CompactNode* CompactNode::getChildElement(const XMLString& name) const
+{
+	for (const CompactNode* pChild = firstChildElement(); pChild; pChild = pChild->nextSiblingElement())
+	{
+		if (pChild->_pName->qname() == name) return pChild;
+	}
+	return 0;
+}
+
+
+const XMLChar* CompactNode::findAttribute(const XMLString& name) const
+{
+	for (int i = 0; i < _attributeCount; i++)
+	{
+		if (_pAttributes[i].pName->qname() == name) return _pAttributes[i].pValue;
+	}
+	return 0;
+}
+
+
+XMLString CompactNode::getAttribute(const XMLString& name) const
+{
+	const XMLChar* pValue = findAttribute(name);
+	if (pValue)
+		return XMLString(pValue);
+	else
+		return XMLString();
+}
+
+
+CompactDocument::CompactDocument():
+	_pFree(0),
+	_available(0),
+	_blockSize(MIN_BLOCK_SIZE),
+	_memoryUsed(0),
+	_nameTable(64),
+	_pDocumentElement(0),
+	_nodeCount(0)
+{
+}
+
+
+CompactDocument::~CompactDocument()
+{
+	for (std::vector<Name*>::iterator it = _names.begin(); it != _names.end(); ++it)
+	{
+		delete *it;
+	}
+	for (std::vector<char*>::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+	{
+		delete [] *it;
+	}
+}
+
+
+void* CompactDocument::allocate(std::size_t size)
+{
+	size = (size + ALIGNMENT - 1) & ~static_cast<std::size_t>(ALIGNMENT - 1);
+	if (size > _available)
+	{
+		if (size > _blockSize/4)
+		{
+			// large strings get a block of their own, so that
+			// the rest of the current block is not wasted
+			char* pBlock = new char[size];
+			_blocks.push_back(pBlock);
+			_memoryUsed += size;
+			return pBlock;
+		}
+		// start small, for small documents
+		_pFree = new char[_blockSize];
+		_blocks.push_back(_pFree);
+		_available = _blockSize;
+		_memoryUsed += _blockSize;
+		if (_blockSize < MAX_BLOCK_SIZE) _blockSize *= 2;
+	}
+	void* p = _pFree;
+	_pFree += size;
+	_available -= size;
+	return p;
+}
+
+
+const XMLChar* CompactDocument::copyString(const XMLChar* pString, std::size_t length)
+{
+	XMLChar* p = static_cast<XMLChar*>(allocate((length + 1)*sizeof(XMLChar)));
+	std::memcpy(p, pString, length*sizeof(XMLChar));
+	p[length] = 0;
+	return p;
+}
+
+
+CompactNode* CompactDocument::createNode(unsigned short type, const Name* pName)
+{
+	_nodeCount++;
+	return new (allocate(sizeof(CompactNode))) CompactNode(type, pName);
+}
+
+
+void CompactDocument::setDocumentElement(CompactNode* pElement)
+{
+	_pDocumentElement = pElement;
+}
+
+
+unsigned long CompactDocument::hash(const XMLChar* pString, std::size_t length)
+{
+	unsigned long h = 2166136261UL;
+	for (std::size_t i = 0; i < length; i++)
+	{
+		h ^= static_cast<unsigned long>(pString[i]);
+		h *= 16777619UL;
+	}
+	return h;
+}
+
+
+const Name& CompactDocument::internName(const XMLChar* pRawName, bool namespaces)
+{
+	std::size_t length = 0;
+	while (pRawName[length]) length++;
+	unsigned long h = hash(pRawName, length);
+
+	std::size_t mask = _nameTable.size() - 1;
+	std::size_t i = h & mask;
+	while (_nameTable[i].pName)
+	{
+		const NameEntry& entry = _nameTable[i];
+		if (entry.hash == h && entry.length == length && std::memcmp(entry.pKey, pRawName, length*sizeof(XMLChar)) == 0)
+		{
+			return *entry.pName;
+		}
+		i = (i + 1) & mask;
+	}
+
+	Name* pName = 0;
+	if (namespaces)
+	{
+		XMLString uri;
+		XMLString local;
+		XMLString prefix;
+		const XMLChar* p = pRawName;
+		const XMLChar* pEnd = pRawName + length;
+		while (p != pEnd && *p != '\t') local += *p++;
+		if (p != pEnd)
+		{
+			uri.swap(local);
+			++p;
+			while (p != pEnd && *p != '\t') local += *p++;
+			if (p != pEnd)
+			{
+				++p;
+				prefix.assign(p, pEnd);
+			}
+		}
+		XMLString qname(prefix);
+		if (!qname.empty()) qname += ':';
+		qname += local;
+		pName = new Name(qname, uri, local);
+	}
+	else
+	{
+		pName = new Name(XMLString(pRawName, length));
+	}
+	_names.push_back(pName);
+
+	NameEntry& entry = _nameTable[i];
+	entry.hash = h;
+	entry.pKey = copyString(pRawName, length);
+	entry.length = length;
+	entry.pName = pName;
+
+	if (2*_names.size() > _nameTable.size()) growNameTable();
+	return *pName;
+}
+
+
+void CompactDocument::growNameTable()
+{
+	std::vector<NameEntry> table(2*_nameTable.size());
+	std::size_t mask = table.size() - 1;
+	for (std::vector<NameEntry>::const_iterator it = _nameTable.begin(); it != _nameTable.end(); ++it)
+	{
+		if (it->pName)
+		{
+			std::size_t i = it->hash & mask;
+			while (table[i].pName) i = (i + 1) & mask;
+			table[i] = *it;
+		}
+	}
+	_nameTable.swap(table);
+}
+
+
+} } // namespace Poco::XML
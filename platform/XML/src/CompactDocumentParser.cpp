@@ -0,0 +1,245 @@
+//
+// CompactDocumentParser.cpp
+//
+// Library: XML
+// Package: DOM
+// Module:  CompactDocumentParser
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/DOM/CompactDocumentParser.h"
+#include "Poco/DOM/DOMParser.h"
+#include "Poco/SAX/XMLReader.h"
+#include "Poco/SAX/SAXException.h"
+#include "Poco/XML/XMLException.h"
+#include "Poco/FileStream.h"
+
+
+namespace Poco {
+namespace XML {
+
+
+CompactDocumentParser::CompactDocumentParser():
+	_parser(0),
+	_encodingSpecified(false),
+	_namespaces(true),
+	_filterWhitespace(false),
+	_pCurrent(0)
+{
+}
+
+
+CompactDocumentParser::~CompactDocumentParser()
+{
+	if (_parser) XML_ParserFree(_parser);
+}
+
+
+void CompactDocumentParser::setEncoding(const XMLString& encoding)
+{
+	_encoding = encoding;
+	_encodingSpecified = true;
+}
+
+
+void CompactDocumentParser::setFeature(const XMLString& name, bool state)
+{
+	if (name == XMLReader::FEATURE_NAMESPACES)
+		_namespaces = state;
+	else if (name == DOMParser::FEATURE_FILTER_WHITESPACE)
+		_filterWhitespace = state;
+	else
+		throw SAXNotRecognizedException(fromXMLString(name));
+}
+
+
+bool CompactDocumentParser::getFeature(const XMLString& name) const
+{
+	if (name == XMLReader::FEATURE_NAMESPACES)
+		return _namespaces;
+	else if (name == DOMParser::FEATURE_FILTER_WHITESPACE)
+		return _filterWhitespace;
+	else
+		throw SAXNotRecognizedException(fromXMLString(name));
+}
+
+
+CompactDocument::Ptr CompactDocumentParser::parse(const XMLString& path)
+{
+	Poco::FileInputStream istr(fromXMLString(path));
+	return parse(istr);
+}
+
+
+CompactDocument::Ptr CompactDocumentParser::parse(std::istream& istr)
+{
+	init();
+	while (istr.good())
+	{
+		void* pBuffer = XML_GetBuffer(_parser, PARSE_BUFFER_SIZE);
+		if (!pBuffer) throw XMLException("No memory");
+		istr.read(static_cast<char*>(pBuffer), PARSE_BUFFER_SIZE);
+		int n = static_cast<int>(istr.gcount());
+		if (!XML_ParseBuffer(_parser, n, 0)) handleError();
+	}
+	if (istr.bad()) throw XMLException("Error reading XML input");
+	parseBuffer(0, 0, true);
+	return finish();
+}
+
+
+CompactDocument::Ptr CompactDocumentParser::parseString(const std::string& xml)
+{
+	return parseMemory(xml.data(), xml.size());
+}
+
+
+CompactDocument::Ptr CompactDocumentParser::parseMemory(const char* xml, std::size_t size)
+{
+	init();
+	const std::size_t maxChunk = 0x40000000;
+	while (size > maxChunk)
+	{
+		parseBuffer(xml, maxChunk, false);
+		xml += maxChunk;
+		size -= maxChunk;
+	}
+	parseBuffer(xml, size, true);
+	return finish();
+}
+
+
+void CompactDocumentParser::init()
+{
+	if (_parser) XML_ParserFree(_parser);
+	if (_namespaces)
+	{
+		_parser = XML_ParserCreateNS(_encodingSpecified ? _encoding.c_str() : 0, '\t');
+		if (_parser) XML_SetReturnNSTriplet(_parser, 1);
+	}
+	else
+	{
+		_parser = XML_ParserCreate(_encodingSpecified ? _encoding.c_str() : 0);
+	}
+	if (!_parser) throw XMLException("Cannot create Expat parser");
+
+	XML_SetUserData(_parser, this);
+	XML_SetElementHandler(_parser, handleStartElement, handleEndElement);
+	XML_SetCharacterDataHandler(_parser, handleCharacterData);
+
+	_pDocument = new CompactDocument;
+	_pCurrent = 0;
+	_text.clear();
+}
+
+
+void CompactDocumentParser::parseBuffer(const char* pBuffer, std::size_t size, bool isFinal)
+{
+	if (!XML_Parse(_parser, pBuffer, static_cast<int>(size), isFinal ? 1 : 0)) handleError();
+}
+
+
+CompactDocument::Ptr CompactDocumentParser::finish()
+{
+	XML_ParserFree(_parser);
+	_parser = 0;
+	_pCurrent = 0;
+	CompactDocument::Ptr pDocument = _pDocument;
+	_pDocument = 0;
+	return pDocument;
+}
+
+
+void CompactDocumentParser::handleError()
+{
+	std::string msg(XML_ErrorString(XML_GetErrorCode(_parser)));
+	int line = static_cast<int>(XML_GetCurrentLineNumber(_parser));
+	int column = static_cast<int>(XML_GetCurrentColumnNumber(_parser));
+	_pDocument = 0;
+	throw SAXParseException(msg, XMLString(), XMLString(), line, column);
+}
+
+
+void CompactDocumentParser::flushText()
+{
+	if (_text.empty()) return;
+
+	if (_filterWhitespace)
+	{
+		bool whitespace = true;
+		for (XMLString::const_iterator it = _text.begin(); whitespace && it != _text.end(); ++it)
+		{
+			whitespace = *it == ' ' || *it == '\t' || *it == '\r' || *it == '\n';
+		}
+		if (whitespace)
+		{
+			_text.clear();
+			return;
+		}
+	}
+	if (_pCurrent)
+	{
+		CompactNode* pText = _pDocument->createNode(CompactNode::TEXT_NODE, 0);
+		pText->_pValue = _pDocument->copyString(_text.data(), _text.size());
+		pText->_valueLength = _text.size();
+		_pCurrent->appendChild(pText);
+	}
+	_text.clear();
+}
+
+
+void CompactDocumentParser::handleStartElement(void* userData, const XML_Char* name, const XML_Char** atts)
+{
+	CompactDocumentParser* pThis = reinterpret_cast<CompactDocumentParser*>(userData);
+	CompactDocument* pDocument = pThis->_pDocument.get();
+
+	pThis->flushText();
+
+	CompactNode* pElement = pDocument->createNode(CompactNode::ELEMENT_NODE, &pDocument->internName(name, pThis->_namespaces));
+	int count = 0;
+	while (atts[2*count]) count++;
+	if (count > 0)
+	{
+		pElement->_pAttributes = static_cast<CompactNode::Attribute*>(pDocument->allocate(count*sizeof(CompactNode::Attribute)));
+		pElement->_attributeCount = count;
+		for (int i = 0; i < count; i++)
+		{
+			const XML_Char* pValue = atts[2*i + 1];
+			std::size_t length = 0;
+			while (pValue[length]) length++;
+			pElement->_pAttributes[i].pName = &pDocument->internName(atts[2*i], pThis->_namespaces);
+			pElement->_pAttributes[i].pValue = pDocument->copyString(pValue, length);
+		}
+	}
+
+	if (pThis->_pCurrent)
+		pThis->_pCurrent->appendChild(pElement);
+	else
+		pDocument->setDocumentElement(pElement);
+	pThis->_pCurrent = pElement;
+}
+
+
+void CompactDocumentParser::handleEndElement(void* userData, const XML_Char* name)
+{
+	CompactDocumentParser* pThis = reinterpret_cast<CompactDocumentParser*>(userData);
+
+	pThis->flushText();
+	pThis->_pCurrent = pThis->_pCurrent->_pParent;
+}
+
+
+void CompactDocumentParser::handleCharacterData(void* userData, const XML_Char* s, int len)
+{
+	CompactDocumentParser* pThis = reinterpret_cast<CompactDocumentParser*>(userData);
+
+	pThis->_text.append(s, len);
+}
+
+
+} } // namespace Poco::XML
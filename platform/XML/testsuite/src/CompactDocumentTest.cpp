@@ -0,0 +1,275 @@
+//
+// CompactDocumentTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "CompactDocumentTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/DOM/CompactDocumentParser.h"
+#include "Poco/DOM/CompactDocument.h"
+#include "Poco/DOM/DOMParser.h"
+#include "Poco/SAX/XMLReader.h"
+#include "Poco/SAX/SAXException.h"
+#include <sstream>
+
+
+using Poco::XML::CompactDocumentParser;
+using Poco::XML::CompactDocument;
+using Poco::XML::CompactNode;
+using Poco::XML::DOMParser;
+using Poco::XML::XMLReader;
+using Poco::XML::XMLString;
+
+
+namespace
+{
+	const std::string CONFIG =
+		"<?xml version=\"1.0\"?>\n"
+		"<!-- configuration -->\n"
+		"<config version=\"2\">\n"
+		"  <device id=\"dev1\" type=\"sensor\">Temperature</device>\n"
+		"  <device id=\"dev2\" type=\"actuator\"/>\n"
+		"  <?pi data?>\n"
+		"  <text>a &lt; b<![CDATA[ & c]]></text>\n"
+		"</config>\n";
+
+	const std::string WSDL =
+		"<definitions xmlns=\"http://schemas.xmlsoap.org/wsdl/\" xmlns:xsd=\"http://www.w3.org/2001/XMLSchema\">"
+		"<types><xsd:schema targetNamespace=\"urn:test\"><xsd:element name=\"e\" type=\"xsd:string\"/></xsd:schema></types>"
+		"</definitions>";
+}
+
+
+CompactDocumentTest::CompactDocumentTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+CompactDocumentTest::~CompactDocumentTest()
+{
+}
+
+
+void CompactDocumentTest::testParse()
+{
+	CompactDocumentParser parser;
+	CompactDocument::Ptr pDoc = parser.parseString(CONFIG);
+
+	const CompactNode* pConfig = pDoc->documentElement();
+	assert (pConfig != 0);
+	assert (pConfig->nodeType() == CompactNode::ELEMENT_NODE);
+	assert (pConfig->nodeName() == "config");
+	assert (pConfig->parentNode() == 0);
+	assert (pConfig->attributeCount() == 1);
+	assert (pConfig->getAttribute("version") == "2");
+	assert (pConfig->findAttribute("missing") == 0);
+	assert (pConfig->getAttribute("missing").empty());
+
+	const CompactNode* pDevice = pConfig->firstChildElement();
+	assert (pDevice != 0);
+	assert (pDevice->nodeName() == "device");
+	assert (pDevice->parentNode() == pConfig);
+	assert (pDevice->attributeCount() == 2);
+	assert (pDevice->attributeName(0).qname() == "id");
+	assert (XMLString(pDevice->attributeValue(0)) == "dev1");
+	assert (pDevice->getAttribute("type") == "sensor");
+	assert (pDevice->innerText() == "Temperature");
+
+	pDevice = pDevice->nextSiblingElement();
+	assert (pDevice != 0);
+	assert (pDevice->getAttribute("id") == "dev2");
+	assert (pDevice->firstChild() == 0);
+
+	const CompactNode* pText = pConfig->getChildElement("text");
+	assert (pText != 0);
+	assert (pText->nextSiblingElement() == 0);
+	assert (pConfig->getChildElement("none") == 0);
+}
+
+
+void CompactDocumentTest::testNamespaces()
+{
+	CompactDocumentParser parser;
+	assert (parser.getFeature(XMLReader::FEATURE_NAMESPACES));
+	CompactDocument::Ptr pDoc = parser.parseString(WSDL);
+
+	const CompactNode* pDefinitions = pDoc->documentElement();
+	assert (pDefinitions->localName() == "definitions");
+	assert (pDefinitions->namespaceURI() == "http://schemas.xmlsoap.org/wsdl/");
+	assert (pDefinitions->nodeName() == "definitions");
+	assert (pDefinitions->attributeCount() == 0);
+
+	const CompactNode* pSchema = pDefinitions->firstChildElement()->firstChildElement();
+	assert (pSchema->nodeName() == "xsd:schema");
+	assert (pSchema->localName() == "schema");
+	assert (pSchema->namespaceURI() == "http://www.w3.org/2001/XMLSchema");
+	assert (pSchema->getAttribute("targetNamespace") == "urn:test");
+
+	const CompactNode* pElement = pSchema->getChildElement("xsd:element");
+	assert (pElement != 0);
+	assert (pElement->getAttribute("type") == "xsd:string");
+}
+
+
+void CompactDocumentTest::testNoNamespaces()
+{
+	CompactDocumentParser parser;
+	parser.setFeature(XMLReader::FEATURE_NAMESPACES, false);
+	CompactDocument::Ptr pDoc = parser.parseString(WSDL);
+
+	const CompactNode* pDefinitions = pDoc->documentElement();
+	assert (pDefinitions->nodeName() == "definitions");
+	assert (pDefinitions->namespaceURI().empty());
+	assert (pDefinitions->getAttribute("xmlns:xsd") == "http://www.w3.org/2001/XMLSchema");
+
+	const CompactNode* pSchema = pDefinitions->firstChildElement()->firstChildElement();
+	assert (pSchema->nodeName() == "xsd:schema");
+}
+
+
+void CompactDocumentTest::testText()
+{
+	CompactDocumentParser parser;
+	CompactDocument::Ptr pDoc = parser.parseString(CONFIG);
+
+	const CompactNode* pText = pDoc->documentElement()->getChildElement("text");
+	const CompactNode* pChild = pText->firstChild();
+	assert (pChild != 0);
+	assert (pChild->nodeType() == CompactNode::TEXT_NODE);
+	assert (pChild->nodeName() == "#text");
+	assert (pChild->nodeValue() == "a < b & c");
+	assert (pChild->valueLength() == 9);
+	assert (pChild->nextSibling() == 0);
+
+	// whitespace, comments and processing instructions
+	const CompactNode* pFirst = pDoc->documentElement()->firstChild();
+	assert (pFirst->nodeType() == CompactNode::TEXT_NODE);
+	assert (pFirst->nodeValue() == "\n  ");
+}
+
+
+void CompactDocumentTest::testFilterWhitespace()
+{
+	CompactDocumentParser parser;
+	parser.setFeature(DOMParser::FEATURE_FILTER_WHITESPACE, true);
+	CompactDocument::Ptr pDoc = parser.parseString(CONFIG);
+
+	const CompactNode* pConfig = pDoc->documentElement();
+	int count = 0;
+	for (const CompactNode* pChild = pConfig->firstChild(); pChild; pChild = pChild->nextSibling())
+	{
+		assert (pChild->nodeType() == CompactNode::ELEMENT_NODE);
+		++count;
+	}
+	assert (count == 3);
+	assert (pDoc->nodeCount() == 6);
+}
+
+
+void CompactDocumentTest::testInternedNames()
+{
+	CompactDocumentParser parser;
+	CompactDocument::Ptr pDoc = parser.parseString(CONFIG);
+
+	const CompactNode* pDevice1 = pDoc->documentElement()->firstChildElement();
+	const CompactNode* pDevice2 = pDevice1->nextSiblingElement();
+	assert (&pDevice1->name() == &pDevice2->name());
+	assert (&pDevice1->attributeName(0) == &pDevice2->attributeName(0));
+	// config, version, device, id, type, text
+	assert (pDoc->nameCount() == 6);
+}
+
+
+void CompactDocumentTest::testLargeDocument()
+{
+	std::ostringstream ostr;
+	ostr << "<root>";
+	for (int i = 0; i < 10000; i++)
+	{
+		ostr << "<item" << (i % 500) << " index=\"" << i << "\">" << std::string(i % 100, 'x') << "</item" << (i % 500) << ">";
+	}
+	ostr << "<big>" << std::string(100000, 'y') << "</big>";
+	ostr << "</root>";
+
+	CompactDocumentParser parser;
+	CompactDocument::Ptr pDoc = parser.parseString(ostr.str());
+
+	assert (pDoc->nameCount() == 503);
+	int i = 0;
+	const CompactNode* pItem = pDoc->documentElement()->firstChildElement();
+	for (; i < 10000; i++, pItem = pItem->nextSiblingElement())
+	{
+		std::ostringstream name;
+		name << "item" << (i % 500);
+		assert (pItem->nodeName() == name.str());
+		assert (pItem->innerText() == std::string(i % 100, 'x'));
+	}
+	assert (pItem->nodeName() == "big");
+	assert (pItem->innerText() == std::string(100000, 'y'));
+	assert (pItem->nextSiblingElement() == 0);
+}
+
+
+void CompactDocumentTest::testParseError()
+{
+	CompactDocumentParser parser;
+	try
+	{
+		parser.parseString("<root><a></b></root>");
+		fail("malformed document - must throw");
+	}
+	catch (Poco::XML::SAXParseException& exc)
+	{
+		assert (exc.getLineNumber() == 1);
+	}
+	CompactDocument::Ptr pDoc = parser.parseString("<root/>");
+	assert (pDoc->documentElement()->nodeName() == "root");
+}
+
+
+void CompactDocumentTest::testStream()
+{
+	std::string xml = "<root>";
+	for (int i = 0; i < 5000; i++) xml += "<a b=\"c\">d</a>";
+	xml += "</root>";
+	std::istringstream istr(xml);
+
+	CompactDocumentParser parser;
+	CompactDocument::Ptr pDoc = parser.parse(istr);
+	assert (pDoc->nodeCount() == 10001);
+	assert (pDoc->documentElement()->innerText() == std::string(5000, 'd'));
+}
+
+
+void CompactDocumentTest::setUp()
+{
+}
+
+
+void CompactDocumentTest::tearDown()
+{
+}
+
+
+CppUnit::Test* CompactDocumentTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("CompactDocumentTest");
+
+	CppUnit_addTest(pSuite, CompactDocumentTest, testParse);
+	CppUnit_addTest(pSuite, CompactDocumentTest, testNamespaces);
+	CppUnit_addTest(pSuite, CompactDocumentTest, testNoNamespaces);
+	CppUnit_addTest(pSuite, CompactDocumentTest, testText);
+	CppUnit_addTest(pSuite, CompactDocumentTest, testFilterWhitespace);
+	CppUnit_addTest(pSuite, CompactDocumentTest, testInternedNames);
+	CppUnit_addTest(pSuite, CompactDocumentTest, testLargeDocument);
+	CppUnit_addTest(pSuite, CompactDocumentTest, testParseError);
+	CppUnit_addTest(pSuite, CompactDocumentTest, testStream);
+
+	return pSuite;
+}
@@ -0,0 +1,46 @@
+//
+// CompactDocumentTest.h
+//
+// Definition of the CompactDocumentTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef CompactDocumentTest_INCLUDED
+#define CompactDocumentTest_INCLUDED
+
+
+#include "Poco/XML/XML.h"
+#include "CppUnit/TestCase.h"
+
+
+class CompactDocumentTest: public CppUnit::TestCase
+{
+public:
+	CompactDocumentTest(const std::string& name);
+	~CompactDocumentTest();
+
+	void testParse();
+	void testNamespaces();
+	void testNoNamespaces();
+	void testText();
+	void testFilterWhitespace();
+	void testInternedNames();
+	void testLargeDocument();
+	void testParseError();
+	void testStream();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // CompactDocumentTest_INCLUDED
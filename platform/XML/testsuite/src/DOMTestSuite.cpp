@@ -20,6 +20,7 @@
 #include "TreeWalkerTest.h"
 #include "ParserWriterTest.h"
 #include "NodeAppenderTest.h"
+#include "CompactDocumentTest.h"
 
 
 CppUnit::Test* DOMTestSuite::suite()
@@ -37,6 +38,7 @@ CppUnit::Test* DOMTestSuite::suite()
 	pSuite->addTest(TreeWalkerTest::suite());
 	pSuite->addTest(ParserWriterTest::suite());
 	pSuite->addTest(NodeAppenderTest::suite());
+	pSuite->addTest(CompactDocumentTest::suite());
 
 	return pSuite;
 }
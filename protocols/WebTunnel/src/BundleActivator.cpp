@@ -9,6 +9,7 @@
 
 
 #include "Poco/WebTunnel/RemotePortForwarder.h"
+#include "Poco/WebTunnel/CreditWindow.h"
 #include "Poco/Net/HTTPSessionFactory.h"
 #include "Poco/Net/HTTPSessionInstantiator.h"
 #include "Poco/Net/HTTPClientSession.h"
@@ -59,6 +60,8 @@ public:
 		_useProxy(false),
 		_proxyPort(0),
 		_threads(0),
+		_capabilities(Poco::WebTunnel::Protocol::WT_CAP_NONE),
+		_creditWindow(Poco::WebTunnel::Protocol::WT_INITIAL_CREDIT),
 		_retryDelay(1000)
 	{
 	}
@@ -113,6 +116,16 @@ public:
 				_connectTimeout = Poco::Timespan(getIntConfig("webtunnel.connectTimeout", 10), 0);
 				_remoteTimeout = Poco::Timespan(getIntConfig("webtunnel.remoteTimeout", 300), 0);
 				_threads = getIntConfig("webtunnel.threads", 4);
+				_capabilities = Poco::WebTunnel::Protocol::parseCapabilities(getStringConfig("webtunnel.capabilities", "multi-record"));
+				_coalescingDelay = Poco::Timespan(static_cast<Poco::Timespan::TimeDiff>(getIntConfig("webtunnel.coalescingDelay", 0))*1000);
+				_creditWindow = getIntConfig("webtunnel.creditWindow", Poco::WebTunnel::Protocol::WT_INITIAL_CREDIT);
+				if (_creditWindow < Poco::WebTunnel::CreditWindow::MIN_WINDOW)
+				{
+					_pContext->logger().warning(Poco::format("Specified creditWindow %d too small - using default.", _creditWindow));
+					_creditWindow = Poco::WebTunnel::Protocol::WT_INITIAL_CREDIT;
+				}
+				parsePorts(getStringConfig("webtunnel.interactivePorts", ""), _interactivePorts);
+				parsePorts(getStringConfig("webtunnel.bulkPorts", ""), _bulkPorts);
 				_userAgent = getStringConfig("webtunnel.userAgent", "");
 				_httpTimeout = Poco::Timespan(getIntConfig("webtunnel.http.timeout", 30), 0);
 				_useProxy = getBoolConfig("webtunnel.http.proxy.enable", false);
@@ -233,6 +246,10 @@ protected:
 			request.add("X-PTTH-Set-Property", Poco::format("device;name=\"%s\"", _deviceName));
 		}
 		request.set("User-Agent", _userAgent);
+		if (_capabilities != Poco::WebTunnel::Protocol::WT_CAP_NONE)
+		{
+			request.set(Poco::WebTunnel::Protocol::X_WEBTUNNEL_CAPABILITIES, Poco::WebTunnel::Protocol::formatCapabilities(_capabilities));
+		}
 		
 		try
 		{
@@ -256,8 +273,23 @@ protected:
 				_pContext->logger().debug("WebSocket established. Creating RemotePortForwarder...");
 				pWebSocket->setNoDelay(true);
 				_retryDelay = 1000;
+				int capabilities = _capabilities & Poco::WebTunnel::Protocol::parseCapabilities(response.get(Poco::WebTunnel::Protocol::X_WEBTUNNEL_CAPABILITIES, ""));
+				if (capabilities != Poco::WebTunnel::Protocol::WT_CAP_NONE)
+				{
+					_pContext->logger().debug("Negotiated WebTunnel capabilities: " + Poco::WebTunnel::Protocol::formatCapabilities(capabilities));
+				}
 				_pDispatcher = new Poco::WebTunnel::SocketDispatcher(_threads);
-				_pForwarder = new Poco::WebTunnel::RemotePortForwarder(*_pDispatcher, pWebSocket, _host, _ports, _remoteTimeout);
+				_pForwarder = new Poco::WebTunnel::RemotePortForwarder(*_pDispatcher, pWebSocket, _host, _ports, _remoteTimeout, capabilities);
+				_pForwarder->setCoalescingDelay(_coalescingDelay);
+				_pForwarder->setCreditWindow(_creditWindow);
+				for (std::set<Poco::UInt16>::const_iterator it = _interactivePorts.begin(); it != _interactivePorts.end(); ++it)
+				{
+					_pForwarder->setPortPriority(*it, Poco::WebTunnel::RemotePortForwarder::PRIO_INTERACTIVE);
+				}
+				for (std::set<Poco::UInt16>::const_iterator it = _bulkPorts.begin(); it != _bulkPorts.end(); ++it)
+				{
+					_pForwarder->setPortPriority(*it, Poco::WebTunnel::RemotePortForwarder::PRIO_BULK);
+				}
 				_pForwarder->webSocketClosed += Poco::delegate(this, &BundleActivator::onClose);
 				_pForwarder->setConnectTimeout(_connectTimeout);
 				_pForwarder->setLocalTimeout(_localTimeout);
@@ -342,6 +374,27 @@ protected:
 		}
 	}
 
+	void parsePorts(const std::string& ports, std::set<Poco::UInt16>& portSet)
+	{
+		Poco::StringTokenizer tok(ports, ";,", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+		for (Poco::StringTokenizer::Iterator it = tok.begin(); it != tok.end(); ++it)
+		{
+			int port;
+			if (!Poco::NumberParser::tryParse(*it, port))
+			{
+				_pContext->logger().warning(Poco::format("Ignored invalid port number specified in configuration: %s", *it));
+			}
+			else if (port > 0 && port < 65536)
+			{
+				portSet.insert(static_cast<Poco::UInt16>(port));
+			}
+			else
+			{
+				_pContext->logger().warning(Poco::format("Ignored out-of-range port number specified in configuration: %d", port));
+			}
+		}
+	}
+
 	void scheduleReconnect()
 	{
 		if (!_stopped.tryWait(1))
@@ -376,6 +429,11 @@ private:
 	Poco::Timespan _remoteTimeout;
 	Poco::Timespan _httpTimeout;
 	int _threads;
+	int _capabilities;
+	Poco::Timespan _coalescingDelay;
+	int _creditWindow;
+	std::set<Poco::UInt16> _interactivePorts;
+	std::set<Poco::UInt16> _bulkPorts;
 	Poco::SharedPtr<Poco::WebTunnel::SocketDispatcher> _pDispatcher;
 	Poco::SharedPtr<Poco::WebTunnel::RemotePortForwarder> _pForwarder;
 	Poco::SharedPtr<Poco::Net::HTTPClientSession> _pHTTPClientSession;
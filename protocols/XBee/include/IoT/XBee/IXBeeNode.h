@@ -49,6 +49,32 @@ public:
 	virtual ~IXBeeNode();
 		/// Destroys the IXBeeNode.
 
+	virtual IoT::XBee::ATCommandResponse executeCommand(const IoT::XBee::ATCommand& command, int timeout) = 0;
+		/// Sends an AT command to the connected XBee device and waits up to
+		/// timeout milliseconds for the response.
+		///
+		/// The frameID given in command is ignored, a frame ID is assigned
+		/// automatically. Multiple commands and requests can be in flight
+		/// at the same time, up to a configurable limit. If that limit is
+		/// reached, the command is delayed until another request has
+		/// been completed.
+		///
+		/// The response is also reported with the commandResponseReceived event.
+		///
+		/// Throws a Poco::TimeoutException if no response is received in time.
+
+	virtual IoT::XBee::RemoteATCommandResponse executeRemoteCommand(const IoT::XBee::RemoteATCommand& command, int timeout) = 0;
+		/// Sends an AT command to a remote XBee device and waits up to
+		/// timeout milliseconds for the response.
+		///
+		/// See executeCommand() for more information.
+
+	virtual IoT::XBee::ZigBeeTransmitStatus executeZigBeeTransmitRequest(const IoT::XBee::ZigBeeTransmitRequest& request, int timeout) = 0;
+		/// Sends a ZigBeeTransmitRequest to the XBee device and waits up to
+		/// timeout milliseconds for the transmit status.
+		///
+		/// See executeCommand() for more information.
+
 	bool isA(const std::type_info& otherType) const;
 		/// Returns true if the class is a subclass of the class given by otherType.
 
@@ -641,6 +641,37 @@ public:
 	virtual void sendExplicitAddressingZigBeeTransmitRequest(const ExplicitAddressingZigBeeTransmitRequest& request) = 0;
 		/// Sends an ExplicitAddressingZigBeeTransmitRequest to the XBee device.
 
+	virtual ATCommandResponse executeCommand(const ATCommand& command, int timeout) = 0;
+		/// Sends an AT command to the connected XBee device and waits up to
+		/// timeout milliseconds for the response.
+		///
+		/// The frameID given in command is ignored, a frame ID is assigned
+		/// automatically from the range 128 to 255, which is reserved for
+		/// this purpose. Commands and requests sent with sendCommand(),
+		/// sendRemoteCommand(), etc. should use frame IDs 1 to 127, so
+		/// that their responses cannot be mistaken for the responses to
+		/// commands sent with executeCommand().
+		///
+		/// Multiple commands and requests can be in flight at the same
+		/// time, up to a configurable limit. If that limit is reached,
+		/// the command is delayed until another request has been completed.
+		///
+		/// The response is also reported with the commandResponseReceived event.
+		///
+		/// Throws a Poco::TimeoutException if no response is received in time.
+
+	virtual RemoteATCommandResponse executeRemoteCommand(const RemoteATCommand& command, int timeout) = 0;
+		/// Sends an AT command to a remote XBee device and waits up to
+		/// timeout milliseconds for the response.
+		///
+		/// See executeCommand() for more information.
+
+	virtual ZigBeeTransmitStatus executeZigBeeTransmitRequest(const ZigBeeTransmitRequest& request, int timeout) = 0;
+		/// Sends a ZigBeeTransmitRequest to the XBee device and waits up to
+		/// timeout milliseconds for the transmit status.
+		///
+		/// See executeCommand() for more information.
+
 private:
 	XBeeNode(const XBeeNode&);
 	XBeeNode& operator = (const XBeeNode&);
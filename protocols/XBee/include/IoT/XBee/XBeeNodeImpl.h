@@ -20,6 +20,7 @@
 
 #include "IoT/XBee/XBeeNode.h"
 #include "IoT/XBee/XBeePort.h"
+#include "IoT/XBee/XBeeRequestPipeline.h"
 #include "Poco/Thread.h"
 #include "Poco/Runnable.h"
 #include "Poco/Mutex.h"
@@ -45,16 +46,28 @@ public:
 	
 	enum
 	{
-		XBEE_MAX_PAYLOAD_SIZE = 100
+		XBEE_MAX_PAYLOAD_SIZE = 100,
+		XBEE_DEFAULT_MAX_IN_FLIGHT = 8
 	};
 	
-	XBeeNodeImpl(Poco::SharedPtr<XBeePort> pXBeePort, int options = 0);
+	XBeeNodeImpl(Poco::SharedPtr<XBeePort> pXBeePort, int options = 0, int maxInFlight = XBEE_DEFAULT_MAX_IN_FLIGHT);
 		/// Creates a XBeeNodeImpl using the given XBeePort instance
 		/// and options.
+		///
+		/// maxInFlight specifies the maximum number of requests
+		/// sent with executeCommand(), executeRemoteCommand() or
+		/// executeZigBeeTransmitRequest() that can wait for their
+		/// response at the same time, from 1 to 128.
 		
 	~XBeeNodeImpl();
 		/// Destroys the ZBPort.
 
+	void setMaxInFlight(int maxInFlight);
+		/// Sets the maximum number of requests in flight.
+
+	int getMaxInFlight() const;
+		/// Returns the maximum number of requests in flight.
+
 	// XBeeNode
 	void sendFrame(const APIFrame& frame);
 	void sendCommand(const ATCommand& command);
@@ -63,6 +76,9 @@ public:
 	void sendTransmitRequest(const TransmitRequest& request);
 	void sendZigBeeTransmitRequest(const ZigBeeTransmitRequest& request);
 	void sendExplicitAddressingZigBeeTransmitRequest(const ExplicitAddressingZigBeeTransmitRequest& request);
+	ATCommandResponse executeCommand(const ATCommand& command, int timeout);
+	RemoteATCommandResponse executeRemoteCommand(const RemoteATCommand& command, int timeout);
+	ZigBeeTransmitStatus executeZigBeeTransmitRequest(const ZigBeeTransmitRequest& request, int timeout);
 	
 protected:
 	void run();
@@ -80,11 +96,15 @@ protected:
 	void handleRemoteCommandResponse(const XBeeFrame& frame);
 	void handleSampleRxIndicator(const XBeeFrame& frame);
 	void handleSensorRead(const XBeeFrame& frame);
+	static void decodeZigBeeTransmitStatus(const XBeeFrame& frame, ZigBeeTransmitStatus& transmitStatus);
+	static void decodeCommandResponse(const XBeeFrame& frame, ATCommandResponse& commandResponse);
+	static void decodeRemoteCommandResponse(const XBeeFrame& frame, RemoteATCommandResponse& commandResponse);
 	void sendFrame(XBeeFrame& frame);
 
 private:
 	Poco::SharedPtr<XBeePort> _pXBeePort;
 	int _options;
+	XBeeRequestPipeline _pipeline;
 	Poco::Thread _thread;	
 	bool _stopped;
 	mutable Poco::FastMutex _mutex;
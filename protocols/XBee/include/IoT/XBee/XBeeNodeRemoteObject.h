@@ -48,6 +48,32 @@ public:
 	virtual ~XBeeNodeRemoteObject();
 		/// Destroys the XBeeNodeRemoteObject.
 
+	IoT::XBee::ATCommandResponse executeCommand(const IoT::XBee::ATCommand& command, int timeout);
+		/// Sends an AT command to the connected XBee device and waits up to
+		/// timeout milliseconds for the response.
+		///
+		/// The frameID given in command is ignored, a frame ID is assigned
+		/// automatically. Multiple commands and requests can be in flight
+		/// at the same time, up to a configurable limit. If that limit is
+		/// reached, the command is delayed until another request has
+		/// been completed.
+		///
+		/// The response is also reported with the commandResponseReceived event.
+		///
+		/// Throws a Poco::TimeoutException if no response is received in time.
+
+	IoT::XBee::RemoteATCommandResponse executeRemoteCommand(const IoT::XBee::RemoteATCommand& command, int timeout);
+		/// Sends an AT command to a remote XBee device and waits up to
+		/// timeout milliseconds for the response.
+		///
+		/// See executeCommand() for more information.
+
+	IoT::XBee::ZigBeeTransmitStatus executeZigBeeTransmitRequest(const IoT::XBee::ZigBeeTransmitRequest& request, int timeout);
+		/// Sends a ZigBeeTransmitRequest to the XBee device and waits up to
+		/// timeout milliseconds for the transmit status.
+		///
+		/// See executeCommand() for more information.
+
 	virtual void queueCommand(const IoT::XBee::ATCommand& command);
 		/// Queues an AT command for execution on the connected XBee device.
 		///
@@ -119,6 +145,24 @@ private:
 };
 
 
+inline IoT::XBee::ATCommandResponse XBeeNodeRemoteObject::executeCommand(const IoT::XBee::ATCommand& command, int timeout)
+{
+	return _pServiceObject->executeCommand(command, timeout);
+}
+
+
+inline IoT::XBee::RemoteATCommandResponse XBeeNodeRemoteObject::executeRemoteCommand(const IoT::XBee::RemoteATCommand& command, int timeout)
+{
+	return _pServiceObject->executeRemoteCommand(command, timeout);
+}
+
+
+inline IoT::XBee::ZigBeeTransmitStatus XBeeNodeRemoteObject::executeZigBeeTransmitRequest(const IoT::XBee::ZigBeeTransmitRequest& request, int timeout)
+{
+	return _pServiceObject->executeZigBeeTransmitRequest(request, timeout);
+}
+
+
 inline void XBeeNodeRemoteObject::queueCommand(const IoT::XBee::ATCommand& command)
 {
 	_pServiceObject->queueCommand(command);
@@ -35,6 +35,11 @@ class XBeeFrame;
 class IoTXBee_API XBeePort
 	/// This class provides an interface to a Digi XBee module
 	/// using the Digi XBee API frame-based protocol.
+	///
+	/// Received data is kept in an internal buffer, from which
+	/// frames are decoded in place. Data following a frame
+	/// is retained for the next call to receiveFrame(), so
+	/// that frames arriving back-to-back are not lost.
 {
 public:
 	XBeePort(Poco::SharedPtr<Poco::Serial::SerialPort> pSerialPort);
@@ -59,6 +64,9 @@ public:
 		///
 		/// Returns the number of bytes received, which may be 0 if the
 		/// receive operation times out.
+		///
+		/// The timeout only applies if no complete frame is
+		/// already in the internal buffer.
 
 	bool poll(const Poco::Timespan& timeout);
 		/// Waits for data to arrive at the port.
@@ -71,9 +79,14 @@ private:
 	XBeePort();
 	XBeePort(const XBeePort&);
 	XBeePort& operator = (const XBeePort&);
+
+	bool extractFrame(XBeeFrame& frame, std::size_t& length);
+	std::size_t space();
 	
 	Poco::SharedPtr<Poco::Serial::SerialPort> _pSerialPort;
 	Poco::Buffer<char> _buffer;
+	std::size_t _begin;
+	std::size_t _end;
 };
 
 
@@ -82,7 +95,7 @@ private:
 //
 inline bool XBeePort::poll(const Poco::Timespan& timeout)
 {
-	return _pSerialPort->poll(timeout);
+	return _begin < _end || _pSerialPort->poll(timeout);
 }
 
 
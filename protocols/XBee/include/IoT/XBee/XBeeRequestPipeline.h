@@ -0,0 +1,163 @@
+//
+// XBeeRequestPipeline.h
+//
+// Library: IoT/XBee
+// Package: XBee
+// Module:  XBeeRequestPipeline
+//
+// Definition of the XBeeRequestPipeline class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_XBee_XBeeRequestPipeline_INCLUDED
+#define IoT_XBee_XBeeRequestPipeline_INCLUDED
+
+
+#include "IoT/XBee/XBee.h"
+#include "IoT/XBee/XBeeFrame.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include <vector>
+
+
+namespace IoT {
+namespace XBee {
+
+
+class IoTXBee_API XBeeRequestPipeline
+	/// XBeeRequestPipeline correlates API requests with their
+	/// responses, using the frame ID. This allows multiple requests
+	/// (e.g., remote AT commands to different nodes) to be
+	/// in flight at the same time, without waiting for the response
+	/// to one request before sending the next one.
+	///
+	/// A request is started with begin(), which allocates a frame ID.
+	/// Frame IDs are allocated round-robin from the range 128 to 255,
+	/// so that a late response to a timed out request is unlikely
+	/// to be mistaken for the response to a new request. Frame IDs
+	/// 1 to 127 are never used by the pipeline and remain available
+	/// for requests sent without it; see isPipelined().
+	/// When the response frame arrives, the receiving thread
+	/// passes it to complete(). The requesting thread waits for
+	/// the response with wait(), and must finally release the frame ID
+	/// with end().
+	///
+	/// The number of requests in flight is limited. The XBee
+	/// module only has a limited number of transmit buffers, and
+	/// sending more requests than it can handle will result in
+	/// transmit failures.
+	///
+	/// This class is thread-safe.
+{
+public:
+	enum
+	{
+		XBEE_FIRST_FRAME_ID = 128,
+		XBEE_LAST_FRAME_ID  = 255,
+		XBEE_MAX_IN_FLIGHT  = XBEE_LAST_FRAME_ID - XBEE_FIRST_FRAME_ID + 1
+	};
+
+	explicit XBeeRequestPipeline(int maxInFlight);
+		/// Creates the XBeeRequestPipeline, allowing up to maxInFlight
+		/// requests at the same time. maxInFlight must be between 1 and
+		/// XBEE_MAX_IN_FLIGHT (128).
+
+	~XBeeRequestPipeline();
+		/// Destroys the XBeeRequestPipeline.
+
+	Poco::UInt8 begin(long timeout);
+		/// Begins a new request and returns its frame ID.
+		///
+		/// If the maximum number of requests is already in flight,
+		/// waits up to timeout milliseconds for another request to
+		/// end. Throws a Poco::TimeoutException if no request ends
+		/// in time, or a Poco::IllegalStateException if the
+		/// pipeline has been cancelled.
+
+	bool complete(Poco::UInt8 frameID, const XBeeFrame& response);
+		/// Completes the request with the given frame ID with the
+		/// given response frame.
+		///
+		/// Returns true if a request with the given frame ID was
+		/// waiting for a response, otherwise false. Always returns
+		/// false for frame IDs outside the pipeline's range.
+
+	bool wait(Poco::UInt8 frameID, XBeeFrame& response, long timeout);
+		/// Waits up to timeout milliseconds for the response to
+		/// the request with the given frame ID.
+		///
+		/// Returns true and the response frame in response if the
+		/// request has been completed, or false if the wait timed out.
+		/// Throws a Poco::IllegalStateException if the pipeline has been
+		/// cancelled.
+
+	void end(Poco::UInt8 frameID);
+		/// Ends the request with the given frame ID, making its frame
+		/// ID and slot available to other requests.
+
+	void cancel();
+		/// Cancels the pipeline. All threads waiting in begin() or
+		/// wait() are woken up and receive a Poco::IllegalStateException.
+
+	void setMaxInFlight(int maxInFlight);
+		/// Sets the maximum number of requests in flight.
+		/// maxInFlight must be between 1 and XBEE_MAX_IN_FLIGHT (128).
+
+	int getMaxInFlight() const;
+		/// Returns the maximum number of requests in flight.
+
+	int inFlight() const;
+		/// Returns the number of requests currently in flight.
+
+	static bool isPipelined(Poco::UInt8 frameID);
+		/// Returns true if the given frame ID belongs to the range
+		/// used by the pipeline (XBEE_FIRST_FRAME_ID to
+		/// XBEE_LAST_FRAME_ID), otherwise false.
+
+private:
+	XBeeRequestPipeline();
+	XBeeRequestPipeline(const XBeeRequestPipeline&);
+	XBeeRequestPipeline& operator = (const XBeeRequestPipeline&);
+
+	struct Slot
+	{
+		Slot():
+			pending(false),
+			completed(false)
+		{
+		}
+
+		bool pending;
+		bool completed;
+		XBeeFrame response;
+	};
+
+	std::vector<Slot> _slots;
+	int _maxInFlight;
+	int _inFlight;
+	Poco::UInt8 _lastFrameID;
+	bool _cancelled;
+	mutable Poco::FastMutex _mutex;
+	Poco::Condition _requestEnded;
+	Poco::Condition _responseReceived;
+};
+
+
+//
+// inlines
+//
+inline bool XBeeRequestPipeline::isPipelined(Poco::UInt8 frameID)
+{
+	return frameID >= XBEE_FIRST_FRAME_ID;
+}
+
+
+} } // namespace IoT::XBee
+
+
+#endif // IoT_XBee_XBeeRequestPipeline_INCLUDED
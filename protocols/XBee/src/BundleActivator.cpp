@@ -50,9 +50,9 @@ public:
 	{
 	}
 	
-	void createXBeeNode(const std::string& uid, Poco::SharedPtr<Poco::Serial::SerialPort> pSerialPort, int options)
+	void createXBeeNode(const std::string& uid, Poco::SharedPtr<Poco::Serial::SerialPort> pSerialPort, int options, int maxInFlight)
 	{
-		Poco::SharedPtr<XBeeNode> pXBeeNode = new XBeeNodeImpl(new XBeePort(pSerialPort));
+		Poco::SharedPtr<XBeeNode> pXBeeNode = new XBeeNodeImpl(new XBeePort(pSerialPort), options, maxInFlight);
 		std::string symbolicName = "io.macchina.xbee";
 		Poco::RemotingNG::Identifiable::ObjectId oid = symbolicName;
 		oid += '#';
@@ -88,13 +88,14 @@ public:
 			{
 				options |= XBeeNodeImpl::XBEE_OPTION_ESCAPE_FRAMES;
 			}
+			int maxInFlight = _pPrefs->configuration()->getInt(baseKey + ".maxInFlight", XBeeNodeImpl::XBEE_DEFAULT_MAX_IN_FLIGHT);
 		
 			try
 			{
 				pContext->logger().information(Poco::format("Creating serial port for XBee device '%s'.", device));
 
 				Poco::SharedPtr<Poco::Serial::SerialPort> pSerialPort = new Poco::Serial::SerialPort(device, speed, params);
-				createXBeeNode(Poco::NumberFormatter::format(index), pSerialPort, options);
+				createXBeeNode(Poco::NumberFormatter::format(index), pSerialPort, options, maxInFlight);
 			}
 			catch (Poco::Exception& exc)
 			{
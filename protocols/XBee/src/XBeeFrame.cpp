@@ -85,6 +85,19 @@ void XBeeFrame::swap(XBeeFrame& other)
 
 
 XBeeFrame::ReadStatus XBeeFrame::read(XBeeFrame& frame, const char* buffer, std::size_t size)
+{
+	std::size_t offset;
+	std::size_t length;
+	ReadStatus rs = scan(buffer, size, offset, length);
+	if (rs == XBEE_FRAME_OK)
+	{
+		frame.assign(buffer + offset, length);
+	}
+	return rs;
+}
+
+
+XBeeFrame::ReadStatus XBeeFrame::scan(const char* buffer, std::size_t size, std::size_t& offset, std::size_t& length)
 {
 	std::size_t i = 0;
 	while (i < size)
@@ -92,31 +105,53 @@ XBeeFrame::ReadStatus XBeeFrame::read(XBeeFrame& frame, const char* buffer, std:
 		while (i < size && buffer[i] != XBEE_FRAME_START_DELIM) i++;
 		if (i < size)
 		{
-			if (i + 2 + 1 < size) // 2 length bytes + checksum
+			if (i + 2 + 1 < size) // 2 length bytes + frame type
 			{
 				std::size_t dataSize = static_cast<unsigned char>(buffer[i + 1])*256 + static_cast<unsigned char>(buffer[i + 2]);
-				if (dataSize <= XBEE_MAX_DATA_LENGTH)
+				if (dataSize > 0 && dataSize <= XBEE_MAX_DATA_LENGTH)
 				{
-					if (i + 2 + dataSize + 1 < size) // 2 length bytes + data + checksum
+					if (i + 2 + dataSize + 1 < size) // 2 length bytes + frame type and data + checksum
 					{
-						XBeeFrame tempFrame(static_cast<FrameType>(buffer[i + 3]), buffer + i + 4, dataSize - 1);
-						if (tempFrame.checksum() == static_cast<unsigned char>(buffer[i + 2 + dataSize + 1]))
+						// frame type, data and checksum must add up to 0xFF
+						Poco::UInt32 checksum = 0;
+						const char* p = buffer + i + 3;
+						const char* end = p + dataSize + 1;
+						while (p < end) checksum += static_cast<unsigned char>(*p++);
+						if ((checksum & 0xFF) == 0xFF)
 						{
-							frame.swap(tempFrame);
+							offset = i;
+							length = dataSize + 4;
 							return XBEE_FRAME_OK;
 						}
 					}
-					else return XBEE_FRAME_NOT_ENOUGH_DATA;
+					else
+					{
+						offset = i;
+						return XBEE_FRAME_NOT_ENOUGH_DATA;
+					}
 				}
 				i++;
 			}
-			else return XBEE_FRAME_NOT_ENOUGH_DATA;
+			else
+			{
+				offset = i;
+				return XBEE_FRAME_NOT_ENOUGH_DATA;
+			}
 		}
 	}
+	offset = size;
 	return XBEE_FRAME_NOT_FOUND;
 }
 
 
+void XBeeFrame::assign(const char* frame, std::size_t length)
+{
+	poco_assert (length >= 5 && length <= XBEE_MAX_FRAME_LENGTH);
+
+	_frame.assign(frame, frame + length);
+}
+
+
 void XBeeFrame::escape()
 {
 	if (_frame.empty()) return;
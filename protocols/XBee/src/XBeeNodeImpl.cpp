@@ -17,8 +17,8 @@
 #include "Poco/NumberParser.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/MemoryStream.h"
-#include "Poco/BinaryReader.h"
 #include "Poco/BinaryWriter.h"
+#include "Poco/Clock.h"
 #include "Poco/Exception.h"
 #include "Poco/Format.h"
 
@@ -53,7 +53,91 @@ namespace
 		}
 	}
 
-	void deserializeDeviceAddress(Poco::BinaryReader& reader, std::string& addr)
+	class FrameReader
+		/// Decodes big-endian (network byte order) fields
+		/// directly from the data of a received XBeeFrame.
+	{
+	public:
+		FrameReader(const IoT::XBee::XBeeFrame& frame):
+			_pCur(frame.data()),
+			_pEnd(frame.data() + frame.dataSize())
+		{
+		}
+
+		FrameReader& operator >> (Poco::UInt8& value)
+		{
+			require(1);
+			value = static_cast<Poco::UInt8>(*_pCur++);
+			return *this;
+		}
+
+		FrameReader& operator >> (char& value)
+		{
+			require(1);
+			value = *_pCur++;
+			return *this;
+		}
+
+		FrameReader& operator >> (Poco::UInt16& value)
+		{
+			require(2);
+			value = static_cast<Poco::UInt16>((byte(0) << 8) | byte(1));
+			_pCur += 2;
+			return *this;
+		}
+
+		FrameReader& operator >> (Poco::Int16& value)
+		{
+			Poco::UInt16 uvalue;
+			*this >> uvalue;
+			value = static_cast<Poco::Int16>(uvalue);
+			return *this;
+		}
+
+		FrameReader& operator >> (Poco::UInt64& value)
+		{
+			require(8);
+			value = 0;
+			for (int i = 0; i < 8; i++)
+			{
+				value = (value << 8) | byte(i);
+			}
+			_pCur += 8;
+			return *this;
+		}
+
+		const char* current() const
+		{
+			return _pCur;
+		}
+
+		std::size_t available() const
+		{
+			return static_cast<std::size_t>(_pEnd - _pCur);
+		}
+
+		void skip(std::size_t n)
+		{
+			require(n);
+			_pCur += n;
+		}
+
+	private:
+		void require(std::size_t n) const
+		{
+			if (available() < n) throw Poco::DataFormatException("Truncated XBee frame");
+		}
+
+		Poco::UInt32 byte(int i) const
+		{
+			return static_cast<unsigned char>(_pCur[i]);
+		}
+
+		const char* _pCur;
+		const char* _pEnd;
+	};
+
+	void deserializeDeviceAddress(FrameReader& reader, std::string& addr)
 	{
 		Poco::UInt64 deviceAddress;
 		reader >> deviceAddress;
@@ -61,7 +145,7 @@ namespace
 		Poco::NumberFormatter::appendHex(addr, deviceAddress, 16);
 	}
 
-	void deserializeNetworkAddress(Poco::BinaryReader& reader, std::string& addr)
+	void deserializeNetworkAddress(FrameReader& reader, std::string& addr)
 	{
 		Poco::UInt16 networkAddress;
 		reader >> networkAddress;
@@ -69,16 +153,50 @@ namespace
 		Poco::NumberFormatter::appendHex(addr, networkAddress, 4);
 	}
 
-	void deserializeData(Poco::BinaryReader& reader, std::size_t size, std::vector<Poco::UInt8>& data)
+	void deserializeData(FrameReader& reader, std::vector<Poco::UInt8>& data)
 	{
-		data.clear();
-		for (std::size_t i = 0; i < size; i++)
+		const Poco::UInt8* begin = reinterpret_cast<const Poco::UInt8*>(reader.current());
+		data.assign(begin, begin + reader.available());
+		reader.skip(reader.available());
+	}
+
+	class PipelinedRequest
+		/// Begins a request in a XBeeRequestPipeline and
+		/// ends it when destroyed.
+	{
+	public:
+		PipelinedRequest(IoT::XBee::XBeeRequestPipeline& pipeline, long timeout):
+			_pipeline(pipeline),
+			_timeout(timeout),
+			_frameID(pipeline.begin(timeout))
 		{
-			Poco::UInt8 byte;
-			reader >> byte;
-			data.push_back(byte);
 		}
-	}
+
+		~PipelinedRequest()
+		{
+			_pipeline.end(_frameID);
+		}
+
+		Poco::UInt8 frameID() const
+		{
+			return _frameID;
+		}
+
+		void waitForResponse(IoT::XBee::XBeeFrame& response, IoT::XBee::XBeeFrame::FrameType responseType)
+		{
+			long remaining = _timeout - static_cast<long>(_start.elapsed()/1000);
+			if (!_pipeline.wait(_frameID, response, remaining > 0 ? remaining : 0))
+				throw Poco::TimeoutException("No response from XBee device");
+			if (response.type() != responseType)
+				throw Poco::ProtocolException(Poco::format("Unexpected XBee response frame (type=0x%x)", static_cast<unsigned>(response.type())));
+		}
+
+	private:
+		IoT::XBee::XBeeRequestPipeline& _pipeline;
+		Poco::Clock _start;
+		long _timeout;
+		Poco::UInt8 _frameID;
+	};
 }
 
 
@@ -86,9 +204,10 @@ namespace IoT {
 namespace XBee {
 
 
-XBeeNodeImpl::XBeeNodeImpl(Poco::SharedPtr<XBeePort> pXBeePort, int options):
+XBeeNodeImpl::XBeeNodeImpl(Poco::SharedPtr<XBeePort> pXBeePort, int options, int maxInFlight):
 	_pXBeePort(pXBeePort),
 	_options(options),
+	_pipeline(maxInFlight),
 	_stopped(false),
 	_logger(Poco::Logger::get("IoT.XBeeNode"))
 {
@@ -251,6 +370,63 @@ void XBeeNodeImpl::sendExplicitAddressingZigBeeTransmitRequest(const ExplicitAdd
 }
 
 
+ATCommandResponse XBeeNodeImpl::executeCommand(const ATCommand& command, int timeout)
+{
+	PipelinedRequest request(_pipeline, timeout);
+	ATCommand pipelinedCommand(command);
+	pipelinedCommand.frameID = request.frameID();
+	sendCommand(pipelinedCommand);
+
+	XBeeFrame response;
+	request.waitForResponse(response, XBeeFrame::XBEE_FRAME_AT_COMMAND_RESPONSE);
+	ATCommandResponse commandResponse;
+	decodeCommandResponse(response, commandResponse);
+	return commandResponse;
+}
+
+
+RemoteATCommandResponse XBeeNodeImpl::executeRemoteCommand(const RemoteATCommand& command, int timeout)
+{
+	PipelinedRequest request(_pipeline, timeout);
+	RemoteATCommand pipelinedCommand(command);
+	pipelinedCommand.frameID = request.frameID();
+	sendRemoteCommand(pipelinedCommand);
+
+	XBeeFrame response;
+	request.waitForResponse(response, XBeeFrame::XBEE_FRAME_REMOTE_AT_COMMAND_RESPONSE);
+	RemoteATCommandResponse commandResponse;
+	decodeRemoteCommandResponse(response, commandResponse);
+	return commandResponse;
+}
+
+
+ZigBeeTransmitStatus XBeeNodeImpl::executeZigBeeTransmitRequest(const ZigBeeTransmitRequest& request, int timeout)
+{
+	PipelinedRequest pipelinedRequest(_pipeline, timeout);
+	ZigBeeTransmitRequest transmitRequest(request);
+	transmitRequest.frameID = pipelinedRequest.frameID();
+	sendZigBeeTransmitRequest(transmitRequest);
+
+	XBeeFrame response;
+	pipelinedRequest.waitForResponse(response, XBeeFrame::XBEE_FRAME_ZIGBEE_TRANSMIT_STATUS);
+	ZigBeeTransmitStatus transmitStatus;
+	decodeZigBeeTransmitStatus(response, transmitStatus);
+	return transmitStatus;
+}
+
+
+void XBeeNodeImpl::setMaxInFlight(int maxInFlight)
+{
+	_pipeline.setMaxInFlight(maxInFlight);
+}
+
+
+int XBeeNodeImpl::getMaxInFlight() const
+{
+	return _pipeline.getMaxInFlight();
+}
+
+
 void XBeeNodeImpl::run()
 {
 	while (!_stopped)
@@ -295,6 +471,7 @@ void XBeeNodeImpl::stop()
 	if (!_stopped)
 	{
 		_stopped = true;
+		_pipeline.cancel();
 		_thread.join();
 	}
 }
@@ -302,6 +479,24 @@ void XBeeNodeImpl::stop()
 
 void XBeeNodeImpl::handleFrame(const XBeeFrame& frame)
 {
+	switch (frame.type())
+	{
+	case XBeeFrame::XBEE_FRAME_AT_COMMAND_RESPONSE:
+	case XBeeFrame::XBEE_FRAME_REMOTE_AT_COMMAND_RESPONSE:
+	case XBeeFrame::XBEE_FRAME_ZIGBEE_TRANSMIT_STATUS:
+	case XBeeFrame::XBEE_FRAME_TRANSMIT_STATUS:
+		// The frame ID is always the first byte of a response.
+		// Responses to requests sent without the pipeline have
+		// frame IDs outside its range and are not passed to it.
+		if (frame.dataSize() > 0 && XBeeRequestPipeline::isPipelined(static_cast<Poco::UInt8>(frame.data()[0])))
+		{
+			_pipeline.complete(static_cast<Poco::UInt8>(frame.data()[0]), frame);
+		}
+		break;
+	default:
+		break;
+	}
+
 	APIFrame apiFrame;
 	apiFrame.type = frame.type();
 	apiFrame.data.assign(
@@ -360,8 +555,7 @@ void XBeeNodeImpl::handleFrame(const XBeeFrame& frame)
 void XBeeNodeImpl::handleTransmitStatusReceived(const XBeeFrame& frame)
 {
 	TransmitStatus transmitStatus;
-	Poco::MemoryInputStream mistr(frame.data(), frame.dataSize());
-	Poco::BinaryReader reader(mistr, Poco::BinaryReader::NETWORK_BYTE_ORDER);
+	FrameReader reader(frame);
 
 	reader
 		>> transmitStatus.frameID
@@ -373,8 +567,7 @@ void XBeeNodeImpl::handleTransmitStatusReceived(const XBeeFrame& frame)
 void XBeeNodeImpl::handlePacketReceived(const XBeeFrame& frame)
 {
 	ReceivePacket receivePacket;
-	Poco::MemoryInputStream mistr(frame.data(), frame.dataSize());
-	Poco::BinaryReader reader(mistr, Poco::BinaryReader::NETWORK_BYTE_ORDER);
+	FrameReader reader(frame);
 
 	if (frame.type() == XBeeFrame::XBEE_FRAME_RECEIVE_PACKET_64BIT_ADDRESS)
 	{
@@ -388,7 +581,7 @@ void XBeeNodeImpl::handlePacketReceived(const XBeeFrame& frame)
 	reader
 		>> receivePacket.rssi
 		>> receivePacket.options;
-	deserializeData(reader, reader.available(), receivePacket.payload);
+	deserializeData(reader, receivePacket.payload);
 
 	packetReceived(receivePacket);
 }
@@ -397,8 +590,7 @@ void XBeeNodeImpl::handlePacketReceived(const XBeeFrame& frame)
 void XBeeNodeImpl::handleIODataReceived(const XBeeFrame& frame)
 {
 	ReceivePacket receivePacket;
-	Poco::MemoryInputStream mistr(frame.data(), frame.dataSize());
-	Poco::BinaryReader reader(mistr, Poco::BinaryReader::NETWORK_BYTE_ORDER);
+	FrameReader reader(frame);
 
 	if (frame.type() == XBeeFrame::XBEE_FRAME_RECEIVE_PACKET_64BIT_ADDRESS_IO)
 	{
@@ -412,7 +604,7 @@ void XBeeNodeImpl::handleIODataReceived(const XBeeFrame& frame)
 	reader
 		>> receivePacket.rssi
 		>> receivePacket.options;
-	deserializeData(reader, reader.available(), receivePacket.payload);
+	deserializeData(reader, receivePacket.payload);
 
 	ioDataReceived(receivePacket);
 }
@@ -421,29 +613,33 @@ void XBeeNodeImpl::handleIODataReceived(const XBeeFrame& frame)
 void XBeeNodeImpl::handleZigBeeTransmitStatusReceived(const XBeeFrame& frame)
 {
 	ZigBeeTransmitStatus transmitStatus;
-	Poco::MemoryInputStream mistr(frame.data(), frame.dataSize());
-	Poco::BinaryReader reader(mistr, Poco::BinaryReader::NETWORK_BYTE_ORDER);
+	decodeZigBeeTransmitStatus(frame, transmitStatus);
+	zigBeeTransmitStatusReceived(transmitStatus);
+}
+
+
+void XBeeNodeImpl::decodeZigBeeTransmitStatus(const XBeeFrame& frame, ZigBeeTransmitStatus& transmitStatus)
+{
+	FrameReader reader(frame);
 
 	reader >> transmitStatus.frameID;
 	deserializeNetworkAddress(reader, transmitStatus.networkAddress);
+	reader.skip(1); // transmit retry count
 	reader
 		>> transmitStatus.deliveryStatus
 		>> transmitStatus.discoveryStatus;
-
-	zigBeeTransmitStatusReceived(transmitStatus);
 }
 
 
 void XBeeNodeImpl::handleZigBeePacketReceived(const XBeeFrame& frame)
 {
 	ZigBeeReceivePacket receivePacket;
-	Poco::MemoryInputStream mistr(frame.data(), frame.dataSize());
-	Poco::BinaryReader reader(mistr, Poco::BinaryReader::NETWORK_BYTE_ORDER);
+	FrameReader reader(frame);
 
 	deserializeDeviceAddress(reader, receivePacket.deviceAddress);
 	deserializeNetworkAddress(reader, receivePacket.networkAddress);
 	reader >> receivePacket.options;
-	deserializeData(reader, reader.available(), receivePacket.payload);
+	deserializeData(reader, receivePacket.payload);
 
 	zigBeePacketReceived(receivePacket);
 }
@@ -452,8 +648,7 @@ void XBeeNodeImpl::handleZigBeePacketReceived(const XBeeFrame& frame)
 void XBeeNodeImpl::handleExplicitAddressingZigBeePacketReceived(const XBeeFrame& frame)
 {
 	ExplicitAddressingZigBeeReceivePacket receivePacket;
-	Poco::MemoryInputStream mistr(frame.data(), frame.dataSize());
-	Poco::BinaryReader reader(mistr, Poco::BinaryReader::NETWORK_BYTE_ORDER);
+	FrameReader reader(frame);
 
 	deserializeDeviceAddress(reader, receivePacket.deviceAddress);
 	deserializeNetworkAddress(reader, receivePacket.networkAddress);
@@ -463,7 +658,7 @@ void XBeeNodeImpl::handleExplicitAddressingZigBeePacketReceived(const XBeeFrame&
 		>> receivePacket.clusterID
 		>> receivePacket.profileID
 		>> receivePacket.options;
-	deserializeData(reader, reader.available(), receivePacket.payload);
+	deserializeData(reader, receivePacket.payload);
 
 	explicitAddressingZigBeePacketReceived(receivePacket);
 }
@@ -472,8 +667,14 @@ void XBeeNodeImpl::handleExplicitAddressingZigBeePacketReceived(const XBeeFrame&
 void XBeeNodeImpl::handleCommandResponse(const XBeeFrame& frame)
 {
 	ATCommandResponse commandResponse;
-	Poco::MemoryInputStream mistr(frame.data(), frame.dataSize());
-	Poco::BinaryReader reader(mistr, Poco::BinaryReader::NETWORK_BYTE_ORDER);
+	decodeCommandResponse(frame, commandResponse);
+	commandResponseReceived(commandResponse);
+}
+
+
+void XBeeNodeImpl::decodeCommandResponse(const XBeeFrame& frame, ATCommandResponse& commandResponse)
+{
+	FrameReader reader(frame);
 
 	reader >> commandResponse.frameID;
 
@@ -481,17 +682,21 @@ void XBeeNodeImpl::handleCommandResponse(const XBeeFrame& frame)
 	reader >> command[0] >> command[1];
 	commandResponse.command.assign(command, 2);
 	reader >> commandResponse.status;
-	deserializeData(reader, frame.dataSize() - 4, commandResponse.data);
-
-	commandResponseReceived(commandResponse);
+	deserializeData(reader, commandResponse.data);
 }
 
 
 void XBeeNodeImpl::handleRemoteCommandResponse(const XBeeFrame& frame)
 {
 	RemoteATCommandResponse commandResponse;
-	Poco::MemoryInputStream mistr(frame.data(), frame.dataSize());
-	Poco::BinaryReader reader(mistr, Poco::BinaryReader::NETWORK_BYTE_ORDER);
+	decodeRemoteCommandResponse(frame, commandResponse);
+	remoteCommandResponseReceived(commandResponse);
+}
+
+
+void XBeeNodeImpl::decodeRemoteCommandResponse(const XBeeFrame& frame, RemoteATCommandResponse& commandResponse)
+{
+	FrameReader reader(frame);
 
 	reader >> commandResponse.frameID;
 	deserializeDeviceAddress(reader, commandResponse.deviceAddress);
@@ -502,17 +707,14 @@ void XBeeNodeImpl::handleRemoteCommandResponse(const XBeeFrame& frame)
 	commandResponse.command.assign(command, 2);
 
 	reader >> commandResponse.status;
-	deserializeData(reader, frame.dataSize() - 14, commandResponse.data);
-
-	remoteCommandResponseReceived(commandResponse);
+	deserializeData(reader, commandResponse.data);
 }
 
 
 void XBeeNodeImpl::handleSampleRxIndicator(const XBeeFrame& frame)
 {
 	IOSample ioSample;
-	Poco::MemoryInputStream mistr(frame.data(), frame.dataSize());
-	Poco::BinaryReader reader(mistr, Poco::BinaryReader::NETWORK_BYTE_ORDER);
+	FrameReader reader(frame);
 
 	deserializeDeviceAddress(reader, ioSample.deviceAddress);
 	deserializeNetworkAddress(reader, ioSample.networkAddress);
@@ -547,8 +749,7 @@ void XBeeNodeImpl::handleSampleRxIndicator(const XBeeFrame& frame)
 void XBeeNodeImpl::handleSensorRead(const XBeeFrame& frame)
 {
 	SensorRead sensorRead;
-	Poco::MemoryInputStream mistr(frame.data(), frame.dataSize());
-	Poco::BinaryReader reader(mistr, Poco::BinaryReader::NETWORK_BYTE_ORDER);
+	FrameReader reader(frame);
 
 	deserializeDeviceAddress(reader, sensorRead.deviceAddress);
 	deserializeNetworkAddress(reader, sensorRead.networkAddress);
@@ -14,6 +14,7 @@
 
 #include "IoT/XBee/XBeePort.h"
 #include "IoT/XBee/XBeeFrame.h"
+#include <cstring>
 
 
 namespace IoT {
@@ -22,7 +23,9 @@ namespace XBee {
 
 XBeePort::XBeePort(Poco::SharedPtr<Poco::Serial::SerialPort> pSerialPort):
 	_pSerialPort(pSerialPort),
-	_buffer(XBeeFrame::XBEE_MAX_FRAME_LENGTH)
+	_buffer(2*XBeeFrame::XBEE_MAX_FRAME_LENGTH),
+	_begin(0),
+	_end(0)
 {
 }
 
@@ -40,33 +43,69 @@ void XBeePort::sendFrame(const XBeeFrame& frame)
 
 std::size_t XBeePort::receiveFrame(XBeeFrame& frame)
 {
-	std::size_t n = 0;
-	XBeeFrame::ReadStatus rs = XBeeFrame::XBEE_FRAME_NOT_FOUND;
-	do
+	std::size_t length = 0;
+	while (!extractFrame(frame, length))
 	{
-		n += _pSerialPort->read(_buffer.begin() + n, _buffer.size() - n);
-		rs = XBeeFrame::read(frame, _buffer.begin(), n);
+		_end += _pSerialPort->read(_buffer.begin() + _end, space());
 	}
-	while (rs == XBeeFrame::XBEE_FRAME_NOT_ENOUGH_DATA && n < _buffer.size());
-	
-	return rs == XBeeFrame::XBEE_FRAME_OK ? n : 0;
+	return length;
 }
 
 	
 std::size_t XBeePort::receiveFrame(XBeeFrame& frame, const Poco::Timespan& timeout)
 {
-	std::size_t n = 0;
-	XBeeFrame::ReadStatus rs = XBeeFrame::XBEE_FRAME_NOT_FOUND;
-	do
+	std::size_t length = 0;
+	while (!extractFrame(frame, length))
 	{
-		std::size_t rd = _pSerialPort->read(_buffer.begin() + n, _buffer.size() - n, timeout);
-		if (rd == 0) return 0;
-		n += rd;
-		rs = XBeeFrame::read(frame, _buffer.begin(), n);
+		if (!_pSerialPort->poll(timeout)) return 0;
+
+		// poll() has filled the SerialPort's buffer, so
+		// this will not block.
+		_end += _pSerialPort->read(_buffer.begin() + _end, space());
 	}
-	while (rs == XBeeFrame::XBEE_FRAME_NOT_ENOUGH_DATA && n < _buffer.size());
-	
-	return rs == XBeeFrame::XBEE_FRAME_OK ? n : 0;
+	return length;
+}
+
+
+bool XBeePort::extractFrame(XBeeFrame& frame, std::size_t& length)
+{
+	std::size_t offset = 0;
+	XBeeFrame::ReadStatus rs = XBeeFrame::scan(_buffer.begin() + _begin, _end - _begin, offset, length);
+	if (rs == XBeeFrame::XBEE_FRAME_OK)
+	{
+		frame.assign(_buffer.begin() + _begin + offset, length);
+		_begin += offset + length;
+	}
+	else
+	{
+		_begin += offset;
+	}
+	if (_begin == _end)
+	{
+		_begin = _end = 0;
+	}
+	return rs == XBeeFrame::XBEE_FRAME_OK;
+}
+
+
+std::size_t XBeePort::space()
+{
+	if (_end == _buffer.size())
+	{
+		if (_begin > 0)
+		{
+			// move the incomplete frame to the start of the buffer
+			std::memmove(_buffer.begin(), _buffer.begin() + _begin, _end - _begin);
+			_end -= _begin;
+			_begin = 0;
+		}
+		else
+		{
+			// the buffer is full, but does not contain a valid frame
+			_end = 0;
+		}
+	}
+	return _buffer.size() - _end;
 }
 
 
@@ -0,0 +1,166 @@
+//
+// XBeeRequestPipeline.cpp
+//
+// Library: IoT/XBee
+// Package: XBee
+// Module:  XBeeRequestPipeline
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/XBee/XBeeRequestPipeline.h"
+#include "Poco/Clock.h"
+#include "Poco/Exception.h"
+
+
+namespace IoT {
+namespace XBee {
+
+
+XBeeRequestPipeline::XBeeRequestPipeline(int maxInFlight):
+	_slots(XBEE_LAST_FRAME_ID + 1),
+	_maxInFlight(0),
+	_inFlight(0),
+	_lastFrameID(XBEE_LAST_FRAME_ID),
+	_cancelled(false)
+{
+	setMaxInFlight(maxInFlight);
+}
+
+
+XBeeRequestPipeline::~XBeeRequestPipeline()
+{
+}
+
+
+Poco::UInt8 XBeeRequestPipeline::begin(long timeout)
+{
+	Poco::Clock start;
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	while (!_cancelled && _inFlight >= _maxInFlight)
+	{
+		long remaining = timeout - static_cast<long>(start.elapsed()/1000);
+		if (remaining <= 0 || !_requestEnded.tryWait(_mutex, remaining))
+			throw Poco::TimeoutException("No XBee request slot available");
+	}
+	if (_cancelled) throw Poco::IllegalStateException("XBee request pipeline has been cancelled");
+
+	// Frame IDs below XBEE_FIRST_FRAME_ID are left to requests
+	// sent without the pipeline (frame ID 0 is special anyway,
+	// as the XBee module does not send a response to it).
+	// As there are at most XBEE_MAX_IN_FLIGHT requests in flight,
+	// a free frame ID is guaranteed to exist.
+	Poco::UInt8 frameID = _lastFrameID;
+	do
+	{
+		frameID = frameID == XBEE_LAST_FRAME_ID ? XBEE_FIRST_FRAME_ID : frameID + 1;
+	}
+	while (_slots[frameID].pending);
+
+	Slot& slot = _slots[frameID];
+	slot.pending = true;
+	slot.completed = false;
+	_lastFrameID = frameID;
+	_inFlight++;
+	return frameID;
+}
+
+
+bool XBeeRequestPipeline::complete(Poco::UInt8 frameID, const XBeeFrame& response)
+{
+	if (!isPipelined(frameID)) return false;
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	Slot& slot = _slots[frameID];
+	if (slot.pending && !slot.completed)
+	{
+		slot.response = response;
+		slot.completed = true;
+		_responseReceived.broadcast();
+		return true;
+	}
+	else return false;
+}
+
+
+bool XBeeRequestPipeline::wait(Poco::UInt8 frameID, XBeeFrame& response, long timeout)
+{
+	Poco::Clock start;
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	Slot& slot = _slots[frameID];
+	while (!_cancelled && !slot.completed)
+	{
+		long remaining = timeout - static_cast<long>(start.elapsed()/1000);
+		if (remaining <= 0 || !_responseReceived.tryWait(_mutex, remaining))
+		{
+			if (slot.completed) break;
+			return false;
+		}
+	}
+	if (!slot.completed) throw Poco::IllegalStateException("XBee request pipeline has been cancelled");
+
+	response.swap(slot.response);
+	return true;
+}
+
+
+void XBeeRequestPipeline::end(Poco::UInt8 frameID)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	Slot& slot = _slots[frameID];
+	if (slot.pending)
+	{
+		slot.pending = false;
+		slot.completed = false;
+		_inFlight--;
+		_requestEnded.signal();
+	}
+}
+
+
+void XBeeRequestPipeline::cancel()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_cancelled = true;
+	_requestEnded.broadcast();
+	_responseReceived.broadcast();
+}
+
+
+void XBeeRequestPipeline::setMaxInFlight(int maxInFlight)
+{
+	if (maxInFlight < 1 || maxInFlight > XBEE_MAX_IN_FLIGHT) throw Poco::InvalidArgumentException("maxInFlight must be between 1 and 128");
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_maxInFlight = maxInFlight;
+	_requestEnded.broadcast();
+}
+
+
+int XBeeRequestPipeline::getMaxInFlight() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _maxInFlight;
+}
+
+
+int XBeeRequestPipeline::inFlight() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _inFlight;
+}
+
+
+} } // namespace IoT::XBee
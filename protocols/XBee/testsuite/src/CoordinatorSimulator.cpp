@@ -0,0 +1,411 @@
+//
+// CoordinatorSimulator.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "CoordinatorSimulator.h"
+#include "Poco/Util/TimerTask.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Clock.h"
+#include "Poco/Exception.h"
+#include <cstring>
+#include <cerrno>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <termios.h>
+
+
+using IoT::XBee::XBeeFrame;
+
+
+namespace
+{
+	const Poco::UInt64 NODE_ADDRESS_BASE = 0x0013A20040000000ULL;
+	const Poco::UInt16 NODE_NETWORK_ADDRESS_BASE = 0x1000;
+	const Poco::UInt16 UNKNOWN_NETWORK_ADDRESS = 0xFFFE;
+
+	Poco::UInt64 readUInt64(const char* p)
+	{
+		Poco::UInt64 value = 0;
+		for (int i = 0; i < 8; i++)
+		{
+			value = (value << 8) | static_cast<unsigned char>(p[i]);
+		}
+		return value;
+	}
+
+	void appendUInt16(std::string& data, Poco::UInt16 value)
+	{
+		data += static_cast<char>(value >> 8);
+		data += static_cast<char>(value & 0xFF);
+	}
+
+	void appendUInt64(std::string& data, Poco::UInt64 value)
+	{
+		for (int i = 7; i >= 0; i--)
+		{
+			data += static_cast<char>((value >> (8*i)) & 0xFF);
+		}
+	}
+}
+
+
+class CoordinatorSimulator::ResponseTask: public Poco::Util::TimerTask
+	/// Sends a delayed response and releases its transmit buffer.
+{
+public:
+	ResponseTask(CoordinatorSimulator& simulator, const XBeeFrame& response, bool buffered):
+		_simulator(simulator),
+		_response(response),
+		_buffered(buffered)
+	{
+	}
+
+	void run()
+	{
+		if (_buffered) _simulator.releaseBuffer();
+		_simulator.sendResponse(_response);
+	}
+
+private:
+	CoordinatorSimulator& _simulator;
+	XBeeFrame _response;
+	bool _buffered;
+};
+
+
+CoordinatorSimulator::CoordinatorSimulator(int nodes, int latency, int buffers):
+	_nodes(nodes),
+	_latency(latency),
+	_buffers(buffers),
+	_buffersInUse(0),
+	_requests(0),
+	_failures(0),
+	_master(-1),
+	_slave(-1),
+	_buffer(4*XBeeFrame::XBEE_MAX_FRAME_LENGTH),
+	_end(0),
+	_stopped(true)
+{
+	_master = posix_openpt(O_RDWR | O_NOCTTY);
+	if (_master == -1) throw Poco::IOException("cannot open pseudo terminal", std::strerror(errno));
+	if (grantpt(_master) == -1 || unlockpt(_master) == -1)
+	{
+		::close(_master);
+		throw Poco::IOException("cannot unlock pseudo terminal", std::strerror(errno));
+	}
+	_device = ptsname(_master);
+
+	// Keep the slave side open, so that the master side does not
+	// see a hangup when the client closes its port. Also put the
+	// line discipline into raw mode, so that no bytes are
+	// translated before the client has configured the port.
+	_slave = ::open(_device.c_str(), O_RDWR | O_NOCTTY);
+	if (_slave == -1)
+	{
+		::close(_master);
+		throw Poco::IOException("cannot open pseudo terminal slave " + _device, std::strerror(errno));
+	}
+	struct termios term;
+	if (tcgetattr(_slave, &term) == 0)
+	{
+		cfmakeraw(&term);
+		tcsetattr(_slave, TCSANOW, &term);
+	}
+}
+
+
+CoordinatorSimulator::~CoordinatorSimulator()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+	::close(_slave);
+	::close(_master);
+}
+
+
+void CoordinatorSimulator::start()
+{
+	_stopped = false;
+	_thread.start(*this);
+}
+
+
+void CoordinatorSimulator::stop()
+{
+	if (!_stopped)
+	{
+		_stopped = true;
+		_thread.join();
+		_timer.cancel(true);
+	}
+}
+
+
+int CoordinatorSimulator::requests() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _requests;
+}
+
+
+int CoordinatorSimulator::failures() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _failures;
+}
+
+
+std::string CoordinatorSimulator::nodeAddress(int node)
+{
+	return Poco::NumberFormatter::formatHex(NODE_ADDRESS_BASE + node, 16);
+}
+
+
+void CoordinatorSimulator::run()
+{
+	while (!_stopped)
+	{
+		struct pollfd pfd;
+		pfd.fd = _master;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		int rc = ::poll(&pfd, 1, 100);
+		if (rc <= 0 || !(pfd.revents & POLLIN)) continue;
+
+		if (_end == _buffer.size()) _end = 0;
+		ssize_t n = ::read(_master, _buffer.begin() + _end, _buffer.size() - _end);
+		if (n <= 0) continue;
+		_end += n;
+
+		std::size_t begin = 0;
+		std::size_t offset;
+		std::size_t length;
+		XBeeFrame::ReadStatus rs;
+		while ((rs = XBeeFrame::scan(_buffer.begin() + begin, _end - begin, offset, length)) == XBeeFrame::XBEE_FRAME_OK)
+		{
+			XBeeFrame frame;
+			frame.assign(_buffer.begin() + begin + offset, length);
+			begin += offset + length;
+			handleFrame(frame);
+		}
+		begin += offset;
+		std::memmove(_buffer.begin(), _buffer.begin() + begin, _end - begin);
+		_end -= begin;
+	}
+}
+
+
+void CoordinatorSimulator::handleFrame(const XBeeFrame& frame)
+{
+	switch (frame.type())
+	{
+	case XBeeFrame::XBEE_FRAME_AT_COMMAND:
+	case XBeeFrame::XBEE_FRAME_AT_COMMAND_QUEUE_PARAMETER_VALUE:
+		handleCommand(frame);
+		break;
+	case XBeeFrame::XBEE_FRAME_REMOTE_AT_COMMAND_REQUEST:
+		handleRemoteCommand(frame);
+		break;
+	case XBeeFrame::XBEE_FRAME_ZIGBEE_TRANSMIT_REQUEST:
+		handleZigBeeTransmitRequest(frame);
+		break;
+	default:
+		break;
+	}
+}
+
+
+void CoordinatorSimulator::handleCommand(const XBeeFrame& frame)
+{
+	// frame ID, AT command, parameters
+	if (frame.dataSize() < 3) return;
+	const char* data = frame.data();
+	Poco::UInt8 frameID = static_cast<Poco::UInt8>(data[0]);
+	std::string command(data + 1, 2);
+
+	std::string response;
+	response += static_cast<char>(frameID);
+	response += command;
+	response += static_cast<char>(STATUS_OK);
+	if (command == "NI")
+	{
+		response += "COORDINATOR";
+	}
+	else if (command == "SH")
+	{
+		appendUInt16(response, static_cast<Poco::UInt16>(NODE_ADDRESS_BASE >> 48));
+		appendUInt16(response, static_cast<Poco::UInt16>(NODE_ADDRESS_BASE >> 32));
+	}
+	else if (command == "SL")
+	{
+		appendUInt16(response, 0);
+		appendUInt16(response, 0);
+	}
+
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		_requests++;
+	}
+	if (frameID != 0)
+	{
+		sendResponse(XBeeFrame(XBeeFrame::XBEE_FRAME_AT_COMMAND_RESPONSE, response));
+	}
+}
+
+
+void CoordinatorSimulator::handleRemoteCommand(const XBeeFrame& frame)
+{
+	// frame ID, 64-bit address, 16-bit address, options, AT command, parameters
+	if (frame.dataSize() < 14) return;
+	const char* data = frame.data();
+	Poco::UInt8 frameID = static_cast<Poco::UInt8>(data[0]);
+	Poco::UInt64 address = readUInt64(data + 1);
+	std::string command(data + 12, 2);
+
+	int node = findNode(address);
+	bool buffered = acquireBuffer();
+	Poco::UInt8 status = STATUS_OK;
+	if (!buffered || node < 0) status = STATUS_TRANSMISSION_FAILED;
+
+	std::string response;
+	response += static_cast<char>(frameID);
+	appendUInt64(response, address);
+	appendUInt16(response, node >= 0 ? static_cast<Poco::UInt16>(NODE_NETWORK_ADDRESS_BASE + node) : UNKNOWN_NETWORK_ADDRESS);
+	response += command;
+	response += static_cast<char>(status);
+	if (status == STATUS_OK && command == "NI")
+	{
+		response += "NODE";
+		response += Poco::NumberFormatter::format(node);
+	}
+
+	if (frameID != 0)
+	{
+		scheduleResponse(XBeeFrame(XBeeFrame::XBEE_FRAME_REMOTE_AT_COMMAND_RESPONSE, response), buffered);
+	}
+	else if (buffered)
+	{
+		releaseBuffer();
+	}
+}
+
+
+void CoordinatorSimulator::handleZigBeeTransmitRequest(const XBeeFrame& frame)
+{
+	// frame ID, 64-bit address, 16-bit address, broadcast radius, options, payload
+	if (frame.dataSize() < 13) return;
+	const char* data = frame.data();
+	Poco::UInt8 frameID = static_cast<Poco::UInt8>(data[0]);
+	Poco::UInt64 address = readUInt64(data + 1);
+
+	int node = findNode(address);
+	bool buffered = acquireBuffer();
+	Poco::UInt8 deliveryStatus = STATUS_OK;
+	if (!buffered)
+		deliveryStatus = DELIVERY_RESOURCE_ERROR;
+	else if (node < 0)
+		deliveryStatus = DELIVERY_ADDRESS_NOT_FOUND;
+
+	std::string response;
+	response += static_cast<char>(frameID);
+	appendUInt16(response, node >= 0 ? static_cast<Poco::UInt16>(NODE_NETWORK_ADDRESS_BASE + node) : 0xFFFD);
+	response += static_cast<char>(0); // transmit retry count
+	response += static_cast<char>(deliveryStatus);
+	response += static_cast<char>(0); // discovery status
+
+	if (frameID != 0)
+	{
+		scheduleResponse(XBeeFrame(XBeeFrame::XBEE_FRAME_ZIGBEE_TRANSMIT_STATUS, response), buffered);
+	}
+	else if (buffered)
+	{
+		releaseBuffer();
+	}
+}
+
+
+bool CoordinatorSimulator::acquireBuffer()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_requests++;
+	if (_buffersInUse < _buffers)
+	{
+		_buffersInUse++;
+		return true;
+	}
+	else
+	{
+		_failures++;
+		return false;
+	}
+}
+
+
+void CoordinatorSimulator::releaseBuffer()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_buffersInUse--;
+}
+
+
+int CoordinatorSimulator::findNode(Poco::UInt64 address) const
+{
+	if (address >= NODE_ADDRESS_BASE && address < NODE_ADDRESS_BASE + _nodes)
+		return static_cast<int>(address - NODE_ADDRESS_BASE);
+	else
+		return -1;
+}
+
+
+void CoordinatorSimulator::scheduleResponse(const XBeeFrame& response, bool buffered)
+{
+	if (buffered)
+	{
+		Poco::Clock due;
+		due += static_cast<Poco::Clock::ClockDiff>(_latency)*1000;
+		_timer.schedule(new ResponseTask(*this, response, buffered), due);
+	}
+	else
+	{
+		// no transmit buffer available, fail immediately
+		sendResponse(response);
+	}
+}
+
+
+void CoordinatorSimulator::sendResponse(const XBeeFrame& response)
+{
+	Poco::FastMutex::ScopedLock lock(_writeMutex);
+
+	const char* p = response.frame();
+	std::size_t remaining = response.frameSize();
+	while (remaining > 0)
+	{
+		ssize_t n = ::write(_master, p, remaining);
+		if (n < 0)
+		{
+			if (errno == EINTR) continue;
+			throw Poco::IOException("cannot write to pseudo terminal", std::strerror(errno));
+		}
+		p += n;
+		remaining -= n;
+	}
+}
@@ -0,0 +1,135 @@
+//
+// CoordinatorSimulator.h
+//
+// Definition of the CoordinatorSimulator class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef CoordinatorSimulator_INCLUDED
+#define CoordinatorSimulator_INCLUDED
+
+
+#include "IoT/XBee/XBeeFrame.h"
+#include "Poco/Util/Timer.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Mutex.h"
+#include "Poco/Buffer.h"
+#include <string>
+
+
+class CoordinatorSimulator: public Poco::Runnable
+	/// Simulates a XBee ZigBee coordinator in API mode (AP=1),
+	/// together with a number of remote nodes, on a pseudo terminal.
+	///
+	/// The slave side of the pseudo terminal (see device()) can
+	/// be opened with a Poco::Serial::SerialPort and used with a
+	/// XBeePort, like a real XBee module connected via USB.
+	///
+	/// The simulator handles the following API frames:
+	///   - AT Command (0x08, 0x09): answered immediately with an
+	///     AT Command Response (0x88).
+	///   - Remote AT Command Request (0x17): answered with a
+	///     Remote AT Command Response (0x97) after the simulated
+	///     network latency.
+	///   - ZigBee Transmit Request (0x10): answered with a
+	///     ZigBee Transmit Status (0x8B) after the simulated
+	///     network latency.
+	///
+	/// Like a real coordinator, the simulator only has a limited
+	/// number of transmit buffers. If a request arrives while all
+	/// buffers are in use, it fails immediately.
+	///
+	/// Remote nodes have the 64-bit addresses returned by nodeAddress().
+	/// Requests to other addresses fail after the simulated latency.
+{
+public:
+	enum
+	{
+		STATUS_OK                  = 0x00,
+		STATUS_TRANSMISSION_FAILED = 0x04,
+		DELIVERY_ADDRESS_NOT_FOUND = 0x24,
+		DELIVERY_RESOURCE_ERROR    = 0x32
+	};
+
+	CoordinatorSimulator(int nodes, int latency, int buffers);
+		/// Creates the CoordinatorSimulator with the given number of
+		/// remote nodes, network latency (in milliseconds) and
+		/// transmit buffers.
+		///
+		/// Opens the pseudo terminal.
+
+	~CoordinatorSimulator();
+		/// Stops the simulator and closes the pseudo terminal.
+
+	const std::string& device() const;
+		/// Returns the path of the pseudo terminal's slave device.
+
+	void start();
+		/// Starts the simulator thread.
+
+	void stop();
+		/// Stops the simulator thread.
+
+	int requests() const;
+		/// Returns the number of requests received.
+
+	int failures() const;
+		/// Returns the number of requests that failed because
+		/// no transmit buffer was available.
+
+	static std::string nodeAddress(int node);
+		/// Returns the 64-bit address of the given node (0 to nodes - 1)
+		/// as hexadecimal string.
+
+protected:
+	void run();
+	void handleFrame(const IoT::XBee::XBeeFrame& frame);
+	void handleCommand(const IoT::XBee::XBeeFrame& frame);
+	void handleRemoteCommand(const IoT::XBee::XBeeFrame& frame);
+	void handleZigBeeTransmitRequest(const IoT::XBee::XBeeFrame& frame);
+	bool acquireBuffer();
+	void releaseBuffer();
+	int findNode(Poco::UInt64 address) const;
+	void scheduleResponse(const IoT::XBee::XBeeFrame& response, bool buffered);
+	void sendResponse(const IoT::XBee::XBeeFrame& response);
+
+private:
+	class ResponseTask;
+
+	int _nodes;
+	int _latency;
+	int _buffers;
+	int _buffersInUse;
+	int _requests;
+	int _failures;
+	int _master;
+	int _slave;
+	std::string _device;
+	Poco::Buffer<char> _buffer;
+	std::size_t _end;
+	bool _stopped;
+	Poco::Thread _thread;
+	Poco::Util::Timer _timer;
+	mutable Poco::FastMutex _mutex;
+	Poco::FastMutex _writeMutex;
+
+	friend class ResponseTask;
+};
+
+
+//
+// inlines
+//
+inline const std::string& CoordinatorSimulator::device() const
+{
+	return _device;
+}
+
+
+#endif // CoordinatorSimulator_INCLUDED
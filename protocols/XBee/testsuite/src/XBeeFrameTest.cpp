@@ -0,0 +1,190 @@
+//
+// XBeeFrameTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "XBeeFrameTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "IoT/XBee/XBeeFrame.h"
+#include <cstring>
+
+
+using IoT::XBee::XBeeFrame;
+
+
+namespace
+{
+	// AT Command frame "NJ" with frame ID 0x52,
+	// from the XBee ZigBee user guide.
+	const char AT_COMMAND_FRAME[] = {0x7E, 0x00, 0x04, 0x08, 0x52, 0x4E, 0x4A, 0x0D};
+}
+
+
+XBeeFrameTest::XBeeFrameTest(const std::string& name):
+	CppUnit::TestCase(name)
+{
+}
+
+
+XBeeFrameTest::~XBeeFrameTest()
+{
+}
+
+
+void XBeeFrameTest::testCreate()
+{
+	XBeeFrame frame(XBeeFrame::XBEE_FRAME_AT_COMMAND, std::string("\x52NJ"));
+	assert (frame.type() == XBeeFrame::XBEE_FRAME_AT_COMMAND);
+	assert (frame.dataSize() == 3);
+	assert (frame.frameSize() == sizeof(AT_COMMAND_FRAME));
+	assert (std::memcmp(frame.frame(), AT_COMMAND_FRAME, sizeof(AT_COMMAND_FRAME)) == 0);
+}
+
+
+void XBeeFrameTest::testScan()
+{
+	std::size_t offset = 99;
+	std::size_t length = 99;
+	XBeeFrame::ReadStatus rs = XBeeFrame::scan(AT_COMMAND_FRAME, sizeof(AT_COMMAND_FRAME), offset, length);
+	assert (rs == XBeeFrame::XBEE_FRAME_OK);
+	assert (offset == 0);
+	assert (length == sizeof(AT_COMMAND_FRAME));
+
+	XBeeFrame frame;
+	frame.assign(AT_COMMAND_FRAME + offset, length);
+	assert (frame.type() == XBeeFrame::XBEE_FRAME_AT_COMMAND);
+	assert (frame.dataSize() == 3);
+	assert (std::memcmp(frame.data(), "\x52NJ", 3) == 0);
+}
+
+
+void XBeeFrameTest::testScanIncomplete()
+{
+	std::size_t offset = 99;
+	std::size_t length = 0;
+	for (std::size_t size = 1; size < sizeof(AT_COMMAND_FRAME); size++)
+	{
+		XBeeFrame::ReadStatus rs = XBeeFrame::scan(AT_COMMAND_FRAME, size, offset, length);
+		assert (rs == XBeeFrame::XBEE_FRAME_NOT_ENOUGH_DATA);
+		assert (offset == 0);
+	}
+}
+
+
+void XBeeFrameTest::testScanGarbage()
+{
+	char buffer[32];
+	std::memcpy(buffer, "\x01\x02\x03", 3);
+	std::memcpy(buffer + 3, AT_COMMAND_FRAME, sizeof(AT_COMMAND_FRAME));
+
+	std::size_t offset = 0;
+	std::size_t length = 0;
+	XBeeFrame::ReadStatus rs = XBeeFrame::scan(buffer, 3, offset, length);
+	assert (rs == XBeeFrame::XBEE_FRAME_NOT_FOUND);
+	assert (offset == 3);
+
+	rs = XBeeFrame::scan(buffer, 5, offset, length);
+	assert (rs == XBeeFrame::XBEE_FRAME_NOT_ENOUGH_DATA);
+	assert (offset == 3);
+
+	rs = XBeeFrame::scan(buffer, 3 + sizeof(AT_COMMAND_FRAME), offset, length);
+	assert (rs == XBeeFrame::XBEE_FRAME_OK);
+	assert (offset == 3);
+	assert (length == sizeof(AT_COMMAND_FRAME));
+}
+
+
+void XBeeFrameTest::testScanChecksumError()
+{
+	char buffer[2*sizeof(AT_COMMAND_FRAME)];
+	std::memcpy(buffer, AT_COMMAND_FRAME, sizeof(AT_COMMAND_FRAME));
+	std::memcpy(buffer + sizeof(AT_COMMAND_FRAME), AT_COMMAND_FRAME, sizeof(AT_COMMAND_FRAME));
+	buffer[sizeof(AT_COMMAND_FRAME) - 1] ^= 0x01;
+
+	std::size_t offset = 0;
+	std::size_t length = 0;
+	XBeeFrame::ReadStatus rs = XBeeFrame::scan(buffer, sizeof(AT_COMMAND_FRAME), offset, length);
+	assert (rs == XBeeFrame::XBEE_FRAME_NOT_FOUND);
+	assert (offset == sizeof(AT_COMMAND_FRAME));
+
+	rs = XBeeFrame::scan(buffer, sizeof(buffer), offset, length);
+	assert (rs == XBeeFrame::XBEE_FRAME_OK);
+	assert (offset == sizeof(AT_COMMAND_FRAME));
+}
+
+
+void XBeeFrameTest::testScanMultiple()
+{
+	XBeeFrame first(XBeeFrame::XBEE_FRAME_MODEM_STATUS, std::string("\x06"));
+	XBeeFrame second(XBeeFrame::XBEE_FRAME_AT_COMMAND_RESPONSE, std::string("\x01NI\x00node", 8));
+	std::string buffer(first.frame(), first.frameSize());
+	buffer.append(second.frame(), second.frameSize());
+	buffer.append(second.frame(), 3);
+
+	std::size_t begin = 0;
+	std::size_t offset = 0;
+	std::size_t length = 0;
+	XBeeFrame::ReadStatus rs = XBeeFrame::scan(buffer.data() + begin, buffer.size() - begin, offset, length);
+	assert (rs == XBeeFrame::XBEE_FRAME_OK);
+	assert (offset == 0 && length == first.frameSize());
+	begin += offset + length;
+
+	rs = XBeeFrame::scan(buffer.data() + begin, buffer.size() - begin, offset, length);
+	assert (rs == XBeeFrame::XBEE_FRAME_OK);
+	assert (offset == 0 && length == second.frameSize());
+	XBeeFrame frame;
+	frame.assign(buffer.data() + begin + offset, length);
+	assert (frame.type() == XBeeFrame::XBEE_FRAME_AT_COMMAND_RESPONSE);
+	assert (std::string(frame.data(), frame.dataSize()) == std::string("\x01NI\x00node", 8));
+	begin += offset + length;
+
+	rs = XBeeFrame::scan(buffer.data() + begin, buffer.size() - begin, offset, length);
+	assert (rs == XBeeFrame::XBEE_FRAME_NOT_ENOUGH_DATA);
+	assert (offset == 0);
+}
+
+
+void XBeeFrameTest::testRead()
+{
+	char buffer[32];
+	std::memcpy(buffer, "\x00\x11", 2);
+	std::memcpy(buffer + 2, AT_COMMAND_FRAME, sizeof(AT_COMMAND_FRAME));
+
+	XBeeFrame frame;
+	XBeeFrame::ReadStatus rs = XBeeFrame::read(frame, buffer, 2 + sizeof(AT_COMMAND_FRAME));
+	assert (rs == XBeeFrame::XBEE_FRAME_OK);
+	assert (frame.type() == XBeeFrame::XBEE_FRAME_AT_COMMAND);
+	assert (frame.frameSize() == sizeof(AT_COMMAND_FRAME));
+}
+
+
+void XBeeFrameTest::setUp()
+{
+}
+
+
+void XBeeFrameTest::tearDown()
+{
+}
+
+
+CppUnit::Test* XBeeFrameTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("XBeeFrameTest");
+
+	CppUnit_addTest(pSuite, XBeeFrameTest, testCreate);
+	CppUnit_addTest(pSuite, XBeeFrameTest, testScan);
+	CppUnit_addTest(pSuite, XBeeFrameTest, testScanIncomplete);
+	CppUnit_addTest(pSuite, XBeeFrameTest, testScanGarbage);
+	CppUnit_addTest(pSuite, XBeeFrameTest, testScanChecksumError);
+	CppUnit_addTest(pSuite, XBeeFrameTest, testScanMultiple);
+	CppUnit_addTest(pSuite, XBeeFrameTest, testRead);
+
+	return pSuite;
+}
@@ -0,0 +1,42 @@
+//
+// XBeeFrameTest.h
+//
+// Definition of the XBeeFrameTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef XBeeFrameTest_INCLUDED
+#define XBeeFrameTest_INCLUDED
+
+
+#include "IoT/XBee/XBee.h"
+#include "CppUnit/TestCase.h"
+
+
+class XBeeFrameTest: public CppUnit::TestCase
+{
+public:
+	XBeeFrameTest(const std::string& name);
+	~XBeeFrameTest();
+
+	void testCreate();
+	void testScan();
+	void testScanIncomplete();
+	void testScanGarbage();
+	void testScanChecksumError();
+	void testScanMultiple();
+	void testRead();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // XBeeFrameTest_INCLUDED
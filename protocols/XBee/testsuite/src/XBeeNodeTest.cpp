@@ -0,0 +1,266 @@
+//
+// XBeeNodeTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "XBeeNodeTest.h"
+#include "CoordinatorSimulator.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "IoT/XBee/XBeeNodeImpl.h"
+#include "IoT/XBee/XBeePort.h"
+#include "IoT/XBee/XBeeRequestPipeline.h"
+#include "Poco/Serial/SerialPort.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
+
+
+using namespace IoT::XBee;
+
+
+namespace
+{
+	Poco::SharedPtr<XBeeNodeImpl> createNode(const CoordinatorSimulator& simulator, int maxInFlight)
+	{
+		Poco::SharedPtr<Poco::Serial::SerialPort> pSerialPort = new Poco::Serial::SerialPort(simulator.device(), 115200, "8N1");
+		return new XBeeNodeImpl(new XBeePort(pSerialPort), 0, maxInFlight);
+	}
+
+	RemoteATCommand remoteCommand(const std::string& deviceAddress, const std::string& command)
+	{
+		RemoteATCommand remoteCommand;
+		remoteCommand.frameID = 0;
+		remoteCommand.deviceAddress = deviceAddress;
+		remoteCommand.options = 0;
+		remoteCommand.command = command;
+		return remoteCommand;
+	}
+
+	class Client: public Poco::Runnable
+	{
+	public:
+		Client(XBeeNode& node, int firstNode, int requests):
+			_node(node),
+			_firstNode(firstNode),
+			_requests(requests),
+			_errors(0)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _requests; i++)
+			{
+				try
+				{
+					RemoteATCommandResponse response = _node.executeRemoteCommand(remoteCommand(CoordinatorSimulator::nodeAddress(_firstNode + i), "NI"), 5000);
+					if (response.status != 0) _errors++;
+				}
+				catch (Poco::Exception&)
+				{
+					_errors++;
+				}
+			}
+		}
+
+		int errors() const
+		{
+			return _errors;
+		}
+
+	private:
+		XBeeNode& _node;
+		int _firstNode;
+		int _requests;
+		int _errors;
+	};
+}
+
+
+XBeeNodeTest::XBeeNodeTest(const std::string& name):
+	CppUnit::TestCase(name)
+{
+}
+
+
+XBeeNodeTest::~XBeeNodeTest()
+{
+}
+
+
+void XBeeNodeTest::testExecuteCommand()
+{
+	CoordinatorSimulator simulator(4, 20, 8);
+	simulator.start();
+	Poco::SharedPtr<XBeeNodeImpl> pNode = createNode(simulator, 4);
+
+	ATCommand command;
+	command.frameID = 0;
+	command.command = "NI";
+	ATCommandResponse response = pNode->executeCommand(command, 5000);
+	assert (response.frameID >= XBeeRequestPipeline::XBEE_FIRST_FRAME_ID);
+	assert (response.command == "NI");
+	assert (response.status == 0);
+	assert (std::string(response.data.begin(), response.data.end()) == "COORDINATOR");
+}
+
+
+void XBeeNodeTest::testExecuteRemoteCommand()
+{
+	CoordinatorSimulator simulator(4, 20, 8);
+	simulator.start();
+	Poco::SharedPtr<XBeeNodeImpl> pNode = createNode(simulator, 4);
+
+	RemoteATCommandResponse response = pNode->executeRemoteCommand(remoteCommand(CoordinatorSimulator::nodeAddress(2), "NI"), 5000);
+	assert (response.status == 0);
+	assert (response.deviceAddress == CoordinatorSimulator::nodeAddress(2));
+	assert (response.networkAddress == "1002");
+	assert (response.command == "NI");
+	assert (std::string(response.data.begin(), response.data.end()) == "NODE2");
+
+	response = pNode->executeRemoteCommand(remoteCommand(CoordinatorSimulator::nodeAddress(4), "NI"), 5000);
+	assert (response.status == CoordinatorSimulator::STATUS_TRANSMISSION_FAILED);
+	assert (response.data.empty());
+}
+
+
+void XBeeNodeTest::testExecuteZigBeeTransmitRequest()
+{
+	CoordinatorSimulator simulator(4, 20, 8);
+	simulator.start();
+	Poco::SharedPtr<XBeeNodeImpl> pNode = createNode(simulator, 4);
+
+	ZigBeeTransmitRequest request;
+	request.frameID = 0;
+	request.deviceAddress = CoordinatorSimulator::nodeAddress(1);
+	request.broadcastRadius = 0;
+	request.options = 0;
+	request.payload.assign(10, 0x55);
+	ZigBeeTransmitStatus status = pNode->executeZigBeeTransmitRequest(request, 5000);
+	assert (status.networkAddress == "1001");
+	assert (status.deliveryStatus == 0);
+	assert (status.discoveryStatus == 0);
+
+	request.deviceAddress = CoordinatorSimulator::nodeAddress(7);
+	status = pNode->executeZigBeeTransmitRequest(request, 5000);
+	assert (status.deliveryStatus == CoordinatorSimulator::DELIVERY_ADDRESS_NOT_FOUND);
+}
+
+
+void XBeeNodeTest::testTimeout()
+{
+	CoordinatorSimulator simulator(4, 500, 8);
+	simulator.start();
+	Poco::SharedPtr<XBeeNodeImpl> pNode = createNode(simulator, 4);
+
+	try
+	{
+		pNode->executeRemoteCommand(remoteCommand(CoordinatorSimulator::nodeAddress(0), "NI"), 50);
+		fail("no response in time - must throw");
+	}
+	catch (Poco::TimeoutException&)
+	{
+	}
+
+	// the late response must not be mistaken for the response to the next command
+	RemoteATCommandResponse response = pNode->executeRemoteCommand(remoteCommand(CoordinatorSimulator::nodeAddress(1), "NI"), 5000);
+	assert (response.deviceAddress == CoordinatorSimulator::nodeAddress(1));
+	assert (std::string(response.data.begin(), response.data.end()) == "NODE1");
+}
+
+
+void XBeeNodeTest::testMixedFrameIDs()
+{
+	CoordinatorSimulator simulator(4, 100, 8);
+	simulator.start();
+	Poco::SharedPtr<XBeeNodeImpl> pNode = createNode(simulator, 4);
+
+	// A request sent without the pipeline, with the frame ID
+	// the first pipelined request would have got if both shared
+	// the same range. Its response arrives first, but must not be
+	// taken for the response to the pipelined request.
+	RemoteATCommand command = remoteCommand(CoordinatorSimulator::nodeAddress(2), "NI");
+	command.frameID = 1;
+	pNode->sendRemoteCommand(command);
+	Poco::Thread::sleep(20);
+
+	RemoteATCommandResponse response = pNode->executeRemoteCommand(remoteCommand(CoordinatorSimulator::nodeAddress(1), "NI"), 5000);
+	assert (response.frameID >= XBeeRequestPipeline::XBEE_FIRST_FRAME_ID);
+	assert (response.deviceAddress == CoordinatorSimulator::nodeAddress(1));
+	assert (std::string(response.data.begin(), response.data.end()) == "NODE1");
+}
+
+
+void XBeeNodeTest::testPipelining()
+{
+	const int LATENCY = 100;
+	const int CLIENTS = 8;
+	const int REQUESTS = 3;
+
+	CoordinatorSimulator simulator(CLIENTS*REQUESTS, LATENCY, 8);
+	simulator.start();
+	Poco::SharedPtr<XBeeNodeImpl> pNode = createNode(simulator, 8);
+
+	std::vector<Client*> clients;
+	std::vector<Poco::Thread*> threads;
+	for (int i = 0; i < CLIENTS; i++)
+	{
+		clients.push_back(new Client(*pNode, i*REQUESTS, REQUESTS));
+		threads.push_back(new Poco::Thread);
+	}
+
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < CLIENTS; i++)
+	{
+		threads[i]->start(*clients[i]);
+	}
+	int errors = 0;
+	for (int i = 0; i < CLIENTS; i++)
+	{
+		threads[i]->join();
+		errors += clients[i]->errors();
+		delete threads[i];
+		delete clients[i];
+	}
+	sw.stop();
+
+	assert (errors == 0);
+	assert (simulator.requests() == CLIENTS*REQUESTS);
+	assert (simulator.failures() == 0);
+
+	// sequential execution would take CLIENTS*REQUESTS*LATENCY ms
+	assert (sw.elapsed()/1000 < CLIENTS*REQUESTS*LATENCY/2);
+}
+
+
+void XBeeNodeTest::setUp()
+{
+}
+
+
+void XBeeNodeTest::tearDown()
+{
+}
+
+
+CppUnit::Test* XBeeNodeTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("XBeeNodeTest");
+
+	CppUnit_addTest(pSuite, XBeeNodeTest, testExecuteCommand);
+	CppUnit_addTest(pSuite, XBeeNodeTest, testExecuteRemoteCommand);
+	CppUnit_addTest(pSuite, XBeeNodeTest, testExecuteZigBeeTransmitRequest);
+	CppUnit_addTest(pSuite, XBeeNodeTest, testTimeout);
+	CppUnit_addTest(pSuite, XBeeNodeTest, testMixedFrameIDs);
+	CppUnit_addTest(pSuite, XBeeNodeTest, testPipelining);
+
+	return pSuite;
+}
@@ -0,0 +1,42 @@
+//
+// XBeeNodeTest.h
+//
+// Definition of the XBeeNodeTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef XBeeNodeTest_INCLUDED
+#define XBeeNodeTest_INCLUDED
+
+
+#include "IoT/XBee/XBee.h"
+#include "CppUnit/TestCase.h"
+
+
+class XBeeNodeTest: public CppUnit::TestCase
+	/// Tests XBeeNodeImpl against a CoordinatorSimulator.
+{
+public:
+	XBeeNodeTest(const std::string& name);
+	~XBeeNodeTest();
+
+	void testExecuteCommand();
+	void testExecuteRemoteCommand();
+	void testExecuteZigBeeTransmitRequest();
+	void testTimeout();
+	void testMixedFrameIDs();
+	void testPipelining();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // XBeeNodeTest_INCLUDED
@@ -0,0 +1,263 @@
+//
+// XBeeRequestPipelineTest.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "XBeeRequestPipelineTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "IoT/XBee/XBeeRequestPipeline.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Exception.h"
+#include <set>
+
+
+using IoT::XBee::XBeeRequestPipeline;
+using IoT::XBee::XBeeFrame;
+
+
+namespace
+{
+	XBeeFrame commandResponse(Poco::UInt8 frameID)
+	{
+		std::string data;
+		data += static_cast<char>(frameID);
+		data += "NI";
+		data += '\0';
+		return XBeeFrame(XBeeFrame::XBEE_FRAME_AT_COMMAND_RESPONSE, data);
+	}
+
+	class Responder: public Poco::Runnable
+	{
+	public:
+		Responder(XBeeRequestPipeline& pipeline, Poco::UInt8 frameID, long delay):
+			_pipeline(pipeline),
+			_frameID(frameID),
+			_delay(delay)
+		{
+		}
+
+		void run()
+		{
+			Poco::Thread::sleep(_delay);
+			_pipeline.complete(_frameID, commandResponse(_frameID));
+		}
+
+	private:
+		XBeeRequestPipeline& _pipeline;
+		Poco::UInt8 _frameID;
+		long _delay;
+	};
+
+	class Ender: public Poco::Runnable
+	{
+	public:
+		Ender(XBeeRequestPipeline& pipeline, Poco::UInt8 frameID, long delay):
+			_pipeline(pipeline),
+			_frameID(frameID),
+			_delay(delay)
+		{
+		}
+
+		void run()
+		{
+			Poco::Thread::sleep(_delay);
+			_pipeline.end(_frameID);
+		}
+
+	private:
+		XBeeRequestPipeline& _pipeline;
+		Poco::UInt8 _frameID;
+		long _delay;
+	};
+}
+
+
+XBeeRequestPipelineTest::XBeeRequestPipelineTest(const std::string& name):
+	CppUnit::TestCase(name)
+{
+}
+
+
+XBeeRequestPipelineTest::~XBeeRequestPipelineTest()
+{
+}
+
+
+void XBeeRequestPipelineTest::testFrameIDs()
+{
+	XBeeRequestPipeline pipeline(XBeeRequestPipeline::XBEE_MAX_IN_FLIGHT);
+
+	std::set<Poco::UInt8> frameIDs;
+	for (int i = 0; i < XBeeRequestPipeline::XBEE_MAX_IN_FLIGHT; i++)
+	{
+		Poco::UInt8 frameID = pipeline.begin(0);
+		assert (frameID >= XBeeRequestPipeline::XBEE_FIRST_FRAME_ID);
+		assert (XBeeRequestPipeline::isPipelined(frameID));
+		assert (frameIDs.insert(frameID).second);
+	}
+	assert (pipeline.inFlight() == XBeeRequestPipeline::XBEE_MAX_IN_FLIGHT);
+
+	// frame IDs are reused round-robin
+	pipeline.end(135);
+	pipeline.end(131);
+	assert (pipeline.begin(0) == 131);
+	assert (pipeline.begin(0) == 135);
+
+	// frame IDs below the pipeline's range are left to other requests
+	assert (!XBeeRequestPipeline::isPipelined(0));
+	assert (!XBeeRequestPipeline::isPipelined(1));
+	assert (!XBeeRequestPipeline::isPipelined(127));
+	assert (!pipeline.complete(1, commandResponse(1)));
+
+	try
+	{
+		pipeline.setMaxInFlight(XBeeRequestPipeline::XBEE_MAX_IN_FLIGHT + 1);
+		fail("more requests in flight than frame IDs - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void XBeeRequestPipelineTest::testComplete()
+{
+	XBeeRequestPipeline pipeline(4);
+
+	Poco::UInt8 frameID = pipeline.begin(0);
+	assert (frameID == XBeeRequestPipeline::XBEE_FIRST_FRAME_ID);
+	assert (!pipeline.complete(frameID + 1, commandResponse(frameID + 1)));
+
+	XBeeFrame response;
+	assert (!pipeline.wait(frameID, response, 10));
+
+	Responder responder(pipeline, frameID, 50);
+	Poco::Thread thread;
+	thread.start(responder);
+	assert (pipeline.wait(frameID, response, 5000));
+	thread.join();
+	assert (response.type() == XBeeFrame::XBEE_FRAME_AT_COMMAND_RESPONSE);
+	assert (static_cast<Poco::UInt8>(response.data()[0]) == frameID);
+
+	pipeline.end(frameID);
+	assert (pipeline.inFlight() == 0);
+}
+
+
+void XBeeRequestPipelineTest::testLateResponse()
+{
+	XBeeRequestPipeline pipeline(4);
+
+	Poco::UInt8 frameID = pipeline.begin(0);
+	XBeeFrame response;
+	assert (!pipeline.wait(frameID, response, 10));
+	pipeline.end(frameID);
+
+	// a response arriving after the request has ended is ignored
+	assert (!pipeline.complete(frameID, commandResponse(frameID)));
+
+	// and the next request gets a different frame ID
+	Poco::UInt8 nextFrameID = pipeline.begin(0);
+	assert (nextFrameID != frameID);
+	assert (!pipeline.wait(nextFrameID, response, 10));
+	pipeline.end(nextFrameID);
+}
+
+
+void XBeeRequestPipelineTest::testMaxInFlight()
+{
+	XBeeRequestPipeline pipeline(2);
+
+	Poco::UInt8 first = pipeline.begin(0);
+	pipeline.begin(0);
+	assert (pipeline.inFlight() == 2);
+
+	try
+	{
+		pipeline.begin(20);
+		fail("maximum number of requests in flight - must throw");
+	}
+	catch (Poco::TimeoutException&)
+	{
+	}
+
+	Ender ender(pipeline, first, 50);
+	Poco::Thread thread;
+	thread.start(ender);
+	Poco::UInt8 third = pipeline.begin(5000);
+	thread.join();
+	assert (third == XBeeRequestPipeline::XBEE_FIRST_FRAME_ID + 2);
+	assert (pipeline.inFlight() == 2);
+
+	pipeline.setMaxInFlight(3);
+	pipeline.begin(0);
+	assert (pipeline.inFlight() == 3);
+
+	try
+	{
+		pipeline.setMaxInFlight(0);
+		fail("invalid maximum - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void XBeeRequestPipelineTest::testCancel()
+{
+	XBeeRequestPipeline pipeline(1);
+
+	Poco::UInt8 frameID = pipeline.begin(0);
+	pipeline.cancel();
+
+	XBeeFrame response;
+	try
+	{
+		pipeline.wait(frameID, response, 5000);
+		fail("pipeline cancelled - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+
+	try
+	{
+		pipeline.begin(5000);
+		fail("pipeline cancelled - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+}
+
+
+void XBeeRequestPipelineTest::setUp()
+{
+}
+
+
+void XBeeRequestPipelineTest::tearDown()
+{
+}
+
+
+CppUnit::Test* XBeeRequestPipelineTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("XBeeRequestPipelineTest");
+
+	CppUnit_addTest(pSuite, XBeeRequestPipelineTest, testFrameIDs);
+	CppUnit_addTest(pSuite, XBeeRequestPipelineTest, testComplete);
+	CppUnit_addTest(pSuite, XBeeRequestPipelineTest, testLateResponse);
+	CppUnit_addTest(pSuite, XBeeRequestPipelineTest, testMaxInFlight);
+	CppUnit_addTest(pSuite, XBeeRequestPipelineTest, testCancel);
+
+	return pSuite;
+}
@@ -0,0 +1,40 @@
+//
+// XBeeRequestPipelineTest.h
+//
+// Definition of the XBeeRequestPipelineTest class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef XBeeRequestPipelineTest_INCLUDED
+#define XBeeRequestPipelineTest_INCLUDED
+
+
+#include "IoT/XBee/XBee.h"
+#include "CppUnit/TestCase.h"
+
+
+class XBeeRequestPipelineTest: public CppUnit::TestCase
+{
+public:
+	XBeeRequestPipelineTest(const std::string& name);
+	~XBeeRequestPipelineTest();
+
+	void testFrameIDs();
+	void testComplete();
+	void testLateResponse();
+	void testMaxInFlight();
+	void testCancel();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // XBeeRequestPipelineTest_INCLUDED
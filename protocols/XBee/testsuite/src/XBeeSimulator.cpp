@@ -0,0 +1,282 @@
+//
+// XBeeSimulator.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Simulates a XBee ZigBee coordinator and a number of remote nodes
+// on a pseudo terminal.
+//
+// By default, the simulator prints the path of the pseudo terminal
+// and runs until terminated. The path can be used as XBee device
+// (xbee.ports.<n>.device) in the macchina.io configuration.
+//
+// With --benchmark, the simulator runs a load test, sending remote
+// AT commands from multiple threads through XBeeNodeImpl, with
+// different limits for the number of requests in flight.
+//
+
+
+#include "CoordinatorSimulator.h"
+#include "IoT/XBee/XBeeNodeImpl.h"
+#include "IoT/XBee/XBeePort.h"
+#include "Poco/Serial/SerialPort.h"
+#include "Poco/Util/ServerApplication.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
+#include "Poco/Format.h"
+#include <iostream>
+#include <vector>
+
+
+using Poco::Util::ServerApplication;
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::OptionCallback;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using namespace IoT::XBee;
+
+
+class LoadClient: public Poco::Runnable
+	/// Sends remote AT commands to the simulated nodes, one after
+	/// another, and records the response times.
+{
+public:
+	LoadClient(XBeeNode& node, int client, int nodes, int requests):
+		_node(node),
+		_client(client),
+		_nodes(nodes),
+		_requests(requests),
+		_errors(0),
+		_totalLatency(0)
+	{
+	}
+
+	void run()
+	{
+		RemoteATCommand command;
+		command.frameID = 0;
+		command.options = 0;
+		command.command = "NI";
+		for (int i = 0; i < _requests; i++)
+		{
+			command.deviceAddress = CoordinatorSimulator::nodeAddress((_client + i) % _nodes);
+			Poco::Stopwatch sw;
+			sw.start();
+			try
+			{
+				RemoteATCommandResponse response = _node.executeRemoteCommand(command, 10000);
+				if (response.status != 0) _errors++;
+			}
+			catch (Poco::Exception&)
+			{
+				_errors++;
+			}
+			_totalLatency += sw.elapsed();
+		}
+	}
+
+	int errors() const
+	{
+		return _errors;
+	}
+
+	Poco::Timestamp::TimeDiff totalLatency() const
+	{
+		return _totalLatency;
+	}
+
+private:
+	XBeeNode& _node;
+	int _client;
+	int _nodes;
+	int _requests;
+	int _errors;
+	Poco::Timestamp::TimeDiff _totalLatency;
+};
+
+
+class XBeeSimulator: public ServerApplication
+{
+public:
+	XBeeSimulator():
+		_helpRequested(false),
+		_benchmark(false)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		ServerApplication::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<XBeeSimulator>(this, &XBeeSimulator::handleHelp)));
+
+		options.addOption(
+			Option("nodes", "n", "Number of simulated remote nodes (default 16).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 65535))
+				.binding("simulator.nodes"));
+
+		options.addOption(
+			Option("latency", "l", "Simulated network latency in milliseconds (default 50).")
+				.required(false)
+				.repeatable(false)
+				.argument("<ms>")
+				.validator(new IntValidator(0, 60000))
+				.binding("simulator.latency"));
+
+		options.addOption(
+			Option("buffers", "b", "Number of transmit buffers of the simulated coordinator (default 8).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 255))
+				.binding("simulator.buffers"));
+
+		options.addOption(
+			Option("benchmark", "B", "Run a load test against the simulator, instead of waiting for a client.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<XBeeSimulator>(this, &XBeeSimulator::handleBenchmark)));
+
+		options.addOption(
+			Option("clients", "c", "Number of client threads for the load test (default 16).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 256))
+				.binding("benchmark.clients"));
+
+		options.addOption(
+			Option("requests", "r", "Number of requests per client thread for the load test (default 20).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 100000))
+				.binding("benchmark.requests"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void handleBenchmark(const std::string& name, const std::string& value)
+	{
+		_benchmark = true;
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("Simulates a XBee ZigBee coordinator and remote nodes on a pseudo terminal.");
+		helpFormatter.format(std::cout);
+	}
+
+	void runLoadTest(const CoordinatorSimulator& simulator, int nodes, int maxInFlight)
+	{
+		int clients = config().getInt("benchmark.clients", 16);
+		int requests = config().getInt("benchmark.requests", 20);
+
+		Poco::SharedPtr<Poco::Serial::SerialPort> pSerialPort = new Poco::Serial::SerialPort(simulator.device(), 115200, "8N1");
+		XBeeNodeImpl node(new XBeePort(pSerialPort), 0, maxInFlight);
+
+		std::vector<LoadClient*> loadClients;
+		std::vector<Poco::Thread*> threads;
+		for (int i = 0; i < clients; i++)
+		{
+			loadClients.push_back(new LoadClient(node, i, nodes, requests));
+			threads.push_back(new Poco::Thread);
+		}
+
+		int failuresBefore = simulator.failures();
+		Poco::Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < clients; i++)
+		{
+			threads[i]->start(*loadClients[i]);
+		}
+		int errors = 0;
+		Poco::Timestamp::TimeDiff totalLatency = 0;
+		for (int i = 0; i < clients; i++)
+		{
+			threads[i]->join();
+			errors += loadClients[i]->errors();
+			totalLatency += loadClients[i]->totalLatency();
+			delete threads[i];
+			delete loadClients[i];
+		}
+		sw.stop();
+
+		int total = clients*requests;
+		double seconds = static_cast<double>(sw.elapsed())/Poco::Timestamp::resolution();
+		std::cout << Poco::format("%11d %13.1f %14.1f %8d %11d",
+			maxInFlight,
+			seconds > 0 ? total/seconds : 0.0,
+			static_cast<double>(totalLatency)/total/1000,
+			errors,
+			simulator.failures() - failuresBefore) << std::endl;
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		int nodes = config().getInt("simulator.nodes", 16);
+		int latency = config().getInt("simulator.latency", 50);
+		int buffers = config().getInt("simulator.buffers", 8);
+
+		CoordinatorSimulator simulator(nodes, latency, buffers);
+		simulator.start();
+
+		if (_benchmark)
+		{
+			std::cout << Poco::format("%d nodes, %d ms latency, %d transmit buffers", nodes, latency, buffers) << std::endl;
+			std::cout << "maxInFlight  requests/s  mean latency/ms  errors  tx failures" << std::endl;
+			static const int MAX_IN_FLIGHT[] = {1, 2, 4, 8, 16};
+			for (std::size_t i = 0; i < sizeof(MAX_IN_FLIGHT)/sizeof(MAX_IN_FLIGHT[0]); i++)
+			{
+				runLoadTest(simulator, nodes, MAX_IN_FLIGHT[i]);
+			}
+		}
+		else
+		{
+			std::cout << Poco::format("Simulating XBee coordinator on %s", simulator.device()) << std::endl;
+			waitForTerminationRequest();
+		}
+
+		simulator.stop();
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+	bool _benchmark;
+};
+
+
+POCO_SERVER_MAIN(XBeeSimulator)
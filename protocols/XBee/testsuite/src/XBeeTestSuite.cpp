@@ -0,0 +1,26 @@
+//
+// XBeeTestSuite.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "XBeeTestSuite.h"
+#include "XBeeFrameTest.h"
+#include "XBeeRequestPipelineTest.h"
+#include "XBeeNodeTest.h"
+
+
+CppUnit::Test* XBeeTestSuite::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("XBeeTestSuite");
+
+	pSuite->addTest(XBeeFrameTest::suite());
+	pSuite->addTest(XBeeRequestPipelineTest::suite());
+	pSuite->addTest(XBeeNodeTest::suite());
+
+	return pSuite;
+}
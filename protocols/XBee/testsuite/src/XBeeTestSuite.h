@@ -0,0 +1,27 @@
+//
+// XBeeTestSuite.h
+//
+// Definition of the XBeeTestSuite class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef XBeeTestSuite_INCLUDED
+#define XBeeTestSuite_INCLUDED
+
+
+#include "CppUnit/TestSuite.h"
+
+
+class XBeeTestSuite
+{
+public:
+	static CppUnit::Test* suite();
+};
+
+
+#endif // XBeeTestSuite_INCLUDED
@@ -0,0 +1,68 @@
+//
+// DeviceInfoDeserializer.h
+//
+// Package: Generated
+// Module:  TypeDeserializer
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TypeDeserializer_IoT_DeviceState_DeviceInfo_INCLUDED
+#define TypeDeserializer_IoT_DeviceState_DeviceInfo_INCLUDED
+
+
+#include "IoT/DeviceState/DeviceStateService.h"
+#include "Poco/RemotingNG/TypeDeserializer.h"
+
+
+namespace Poco {
+namespace RemotingNG {
+
+
+template <>
+class TypeDeserializer<IoT::DeviceState::DeviceInfo>
+{
+public:
+	static bool deserialize(const std::string& name, bool isMandatory, Deserializer& deser, IoT::DeviceState::DeviceInfo& value)
+	{
+		bool ret = deser.deserializeStructBegin(name, isMandatory);
+		if (ret)
+		{
+			deserializeImpl(deser, value);
+			deser.deserializeStructEnd(name);
+		}
+		return ret;
+	}
+
+	static void deserializeImpl(Deserializer& deser, IoT::DeviceState::DeviceInfo& value)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"displayState","displayValue","id","name","physicalQuantity","physicalUnit","symbolicName","type","version"};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[0], true, deser, value.displayState);
+		TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[1], true, deser, value.displayValue);
+		TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[2], true, deser, value.id);
+		TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[3], true, deser, value.name);
+		TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[4], true, deser, value.physicalQuantity);
+		TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[5], true, deser, value.physicalUnit);
+		TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[6], true, deser, value.symbolicName);
+		TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[7], true, deser, value.type);
+		TypeDeserializer<Poco::Int64 >::deserialize(REMOTING__NAMES[8], true, deser, value.version);
+	}
+
+};
+
+
+} // namespace RemotingNG
+} // namespace Poco
+
+
+#endif // TypeDeserializer_IoT_DeviceState_DeviceInfo_INCLUDED
+
@@ -0,0 +1,64 @@
+//
+// DeviceInfoSerializer.h
+//
+// Package: Generated
+// Module:  TypeSerializer
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TypeSerializer_IoT_DeviceState_DeviceInfo_INCLUDED
+#define TypeSerializer_IoT_DeviceState_DeviceInfo_INCLUDED
+
+
+#include "IoT/DeviceState/DeviceStateService.h"
+#include "Poco/RemotingNG/TypeSerializer.h"
+
+
+namespace Poco {
+namespace RemotingNG {
+
+
+template <>
+class TypeSerializer<IoT::DeviceState::DeviceInfo>
+{
+public:
+	static void serialize(const std::string& name, const IoT::DeviceState::DeviceInfo& value, Serializer& ser)
+	{
+		ser.serializeStructBegin(name);
+		serializeImpl(value, ser);
+		ser.serializeStructEnd(name);
+	}
+
+	static void serializeImpl(const IoT::DeviceState::DeviceInfo& value, Serializer& ser)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"displayState","displayValue","id","name","physicalQuantity","physicalUnit","symbolicName","type","version",""};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[0], value.displayState, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[1], value.displayValue, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[2], value.id, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[3], value.name, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[4], value.physicalQuantity, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[5], value.physicalUnit, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[6], value.symbolicName, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[7], value.type, ser);
+		TypeSerializer<Poco::Int64 >::serialize(REMOTING__NAMES[8], value.version, ser);
+	}
+
+};
+
+
+} // namespace RemotingNG
+} // namespace Poco
+
+
+#endif // TypeSerializer_IoT_DeviceState_DeviceInfo_INCLUDED
+
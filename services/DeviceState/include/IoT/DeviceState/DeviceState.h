@@ -0,0 +1,58 @@
+//
+// DeviceState.h
+//
+// Library: IoT/DeviceState
+// Package: DeviceState
+// Module:  DeviceState
+//
+// Basic definitions for the IoT DeviceState library.
+// This file must be the first file included by every other Core
+// header file.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_DeviceState_DeviceState_INCLUDED
+#define IoT_DeviceState_DeviceState_INCLUDED
+
+
+#include "Poco/Poco.h"
+
+
+//
+// The following block is the standard way of creating macros which make exporting
+// from a DLL simpler. All files within this DLL are compiled with the IoTDeviceState_EXPORTS
+// symbol defined on the command line. this symbol should not be defined on any project
+// that uses this DLL. This way any other project whose source files include this file see
+// IoTDeviceState_API functions as being imported from a DLL, wheras this DLL sees symbols
+// defined with this macro as being exported.
+//
+#if defined(_WIN32) && defined(POCO_DLL)
+	#if defined(IoTDeviceState_EXPORTS)
+		#define IoTDeviceState_API __declspec(dllexport)
+	#else
+		#define IoTDeviceState_API __declspec(dllimport)
+	#endif
+#endif
+
+
+#if !defined(IoTDeviceState_API)
+	#define IoTDeviceState_API
+#endif
+
+
+//
+// Automatically link Devices library.
+//
+#if defined(_MSC_VER)
+	#if !defined(POCO_NO_AUTOMATIC_LIBS) && !defined(IoTDeviceState_EXPORTS)
+		#pragma comment(lib, "IoTDeviceState" POCO_LIB_SUFFIX)
+	#endif
+#endif
+
+
+#endif // IoT_DeviceState_DeviceState_INCLUDED
@@ -0,0 +1,161 @@
+//
+// DeviceStateService.h
+//
+// Library: IoT/DeviceState
+// Package: DeviceStateService
+// Module:  DeviceStateService
+//
+// Definition of the DeviceStateService interface.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_DeviceState_DeviceStateService_INCLUDED
+#define IoT_DeviceState_DeviceStateService_INCLUDED
+
+
+#include "IoT/DeviceState/DeviceState.h"
+#include "Poco/SharedPtr.h"
+#include <vector>
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+//@ serialize
+struct DeviceInfo
+	/// The current state of a device, as kept by the DeviceStateService.
+{
+	DeviceInfo():
+		version(0)
+	{
+	}
+
+	std::string id;
+		/// The service name of the device.
+
+	std::string name;
+		/// The value of the device's "name" property.
+
+	std::string type;
+		/// The value of the device's "type" property.
+
+	std::string symbolicName;
+		/// The value of the device's "symbolicName" property.
+
+	std::string physicalQuantity;
+		/// The value of the device's "physicalQuantity" property,
+		/// or an empty string if the device does not have it.
+
+	std::string physicalUnit;
+		/// The value of the device's "physicalUnit" property,
+		/// or an empty string if the device does not have it.
+
+	std::string displayValue;
+		/// The value of the device's "displayValue" property,
+		/// or an empty string if the device does not have it.
+
+	std::string displayState;
+		/// The value of the device's "displayState" property,
+		/// or an empty string if the device does not have it.
+
+	Poco::Int64 version;
+		/// The version of the snapshot in which the state
+		/// of the device was last changed.
+};
+
+
+//@ serialize
+struct DeviceStateSnapshot
+	/// The current state of all devices.
+{
+	DeviceStateSnapshot():
+		version(0)
+	{
+	}
+
+	Poco::Int64 version;
+		/// The current version. Every change published by the
+		/// DeviceStateService increments the version.
+
+	std::string subject;
+		/// The base subject name used for publishing changes
+		/// through the WebEventService, or an empty string
+		/// if changes are not published.
+
+	std::vector<DeviceInfo> devices;
+		/// The current state of all devices.
+};
+
+
+//@ remote
+class IoTDeviceState_API DeviceStateService
+	/// The DeviceStateService keeps track of the state of all devices
+	/// registered with the service registry (all services having an
+	/// "io.macchina.device" property).
+	///
+	/// The service listens to the valueChanged, stateChanged, countChanged
+	/// and positionUpdate events of the devices. Changes are collected and,
+	/// at a fixed interval, published as small JSON documents through the
+	/// Poco::OSP::WebEvent::WebEventService, using the subject
+	/// <subject>.<id>, where <subject> is the base subject name (default:
+	/// "io.macchina.device") and <id> is the service name of the device.
+	///
+	/// A web client therefore only needs to fetch the initial state of
+	/// all devices with snapshot(), and can then subscribe to the base
+	/// subject to receive all subsequent changes, instead of periodically
+	/// querying every device.
+	///
+	/// Three kinds of messages are published:
+	///   - {"event":"added","id":...,"version":...,"name":...,...} when
+	///     a device has been registered. The message contains all members
+	///     of DeviceInfo.
+	///   - {"event":"changed","id":...,"version":...,...} when the
+	///     displayValue or displayState of a device has changed. Only
+	///     the changed members are included. For a GNSS sensor, the
+	///     message also contains the latest position ("position", with
+	///     "latitude" and "longitude"), "course" and "speed".
+	///   - {"event":"removed","id":...,"version":...} when a device
+	///     has been unregistered.
+	///
+	/// Every message carries the version assigned to the change. Messages
+	/// for different devices may be delivered out of version order, so a
+	/// client must compare the version of a message with the version of
+	/// the respective device (DeviceInfo::version), not with the highest
+	/// version received so far. A message with a version not greater than
+	/// the device's version is outdated and must be ignored.
+	///
+	/// Devices not supporting any of the above events are periodically
+	/// checked for changes.
+{
+public:
+	typedef Poco::SharedPtr<DeviceStateService> Ptr;
+
+	DeviceStateService();
+		/// Creates the DeviceStateService.
+
+	virtual ~DeviceStateService();
+		/// Destroys the DeviceStateService.
+
+	virtual DeviceStateSnapshot snapshot() const = 0;
+		/// Returns the current state of all devices, together with
+		/// the current version and the base subject name.
+
+	virtual Poco::Int64 version() const = 0;
+		/// Returns the current version.
+
+	virtual std::string subject() const = 0;
+		/// Returns the base subject name used for publishing changes,
+		/// or an empty string if changes are not published.
+};
+
+
+} } // namespace IoT::DeviceState
+
+
+#endif // IoT_DeviceState_DeviceStateService_INCLUDED
@@ -0,0 +1,120 @@
+//
+// DeviceStateServiceRemoteObject.h
+//
+// Library: IoT/DeviceState
+// Package: Generated
+// Module:  DeviceStateServiceRemoteObject
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_DeviceState_DeviceStateServiceRemoteObject_INCLUDED
+#define IoT_DeviceState_DeviceStateServiceRemoteObject_INCLUDED
+
+
+#include "IoT/DeviceState/IDeviceStateService.h"
+#include "Poco/RemotingNG/Identifiable.h"
+#include "Poco/RemotingNG/RemoteObject.h"
+#include "Poco/SharedPtr.h"
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+class DeviceStateServiceRemoteObject: public IoT::DeviceState::IDeviceStateService, public Poco::RemotingNG::RemoteObject
+	/// The DeviceStateService keeps track of the state of all devices
+	/// registered with the service registry (all services having an
+	/// "io.macchina.device" property).
+	///
+	/// The service listens to the valueChanged, stateChanged, countChanged
+	/// and positionUpdate events of the devices. Changes are collected and,
+	/// at a fixed interval, published as small JSON documents through the
+	/// Poco::OSP::WebEvent::WebEventService, using the subject
+	/// <subject>.<id>, where <subject> is the base subject name (default:
+	/// "io.macchina.device") and <id> is the service name of the device.
+	///
+	/// A web client therefore only needs to fetch the initial state of
+	/// all devices with snapshot(), and can then subscribe to the base
+	/// subject to receive all subsequent changes, instead of periodically
+	/// querying every device.
+	///
+	/// Three kinds of messages are published:
+	///   - {"event":"added","id":...,"version":...,"name":...,...} when
+	///     a device has been registered. The message contains all members
+	///     of DeviceInfo.
+	///   - {"event":"changed","id":...,"version":...,...} when the
+	///     displayValue or displayState of a device has changed. Only
+	///     the changed members are included. For a GNSS sensor, the
+	///     message also contains the latest position ("position", with
+	///     "latitude" and "longitude"), "course" and "speed".
+	///   - {"event":"removed","id":...,"version":...} when a device
+	///     has been unregistered.
+	///
+	/// Devices not supporting any of the above events are periodically
+	/// checked for changes.
+{
+public:
+	typedef Poco::AutoPtr<DeviceStateServiceRemoteObject> Ptr;
+
+	DeviceStateServiceRemoteObject(const Poco::RemotingNG::Identifiable::ObjectId& oid, Poco::SharedPtr<IoT::DeviceState::DeviceStateService> pServiceObject);
+		/// Creates a DeviceStateServiceRemoteObject.
+
+	virtual ~DeviceStateServiceRemoteObject();
+		/// Destroys the DeviceStateServiceRemoteObject.
+
+	virtual const Poco::RemotingNG::Identifiable::TypeId& remoting__typeId() const;
+
+	IoT::DeviceState::DeviceStateSnapshot snapshot() const;
+		/// Returns the current state of all devices, together with
+		/// the current version and the base subject name.
+
+	virtual std::string subject() const;
+		/// Returns the base subject name used for publishing changes,
+		/// or an empty string if changes are not published.
+
+	virtual Poco::Int64 version() const;
+		/// Returns the current version.
+
+private:
+	Poco::SharedPtr<IoT::DeviceState::DeviceStateService> _pServiceObject;
+};
+
+
+inline const Poco::RemotingNG::Identifiable::TypeId& DeviceStateServiceRemoteObject::remoting__typeId() const
+{
+	return IDeviceStateService::remoting__typeId();
+}
+
+
+inline IoT::DeviceState::DeviceStateSnapshot DeviceStateServiceRemoteObject::snapshot() const
+{
+	return _pServiceObject->snapshot();
+}
+
+
+inline std::string DeviceStateServiceRemoteObject::subject() const
+{
+	return _pServiceObject->subject();
+}
+
+
+inline Poco::Int64 DeviceStateServiceRemoteObject::version() const
+{
+	return _pServiceObject->version();
+}
+
+
+} // namespace DeviceState
+} // namespace IoT
+
+
+#endif // IoT_DeviceState_DeviceStateServiceRemoteObject_INCLUDED
+
@@ -0,0 +1,147 @@
+//
+// DeviceStateServiceServerHelper.h
+//
+// Library: IoT/DeviceState
+// Package: Generated
+// Module:  DeviceStateServiceServerHelper
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_DeviceState_DeviceStateServiceServerHelper_INCLUDED
+#define IoT_DeviceState_DeviceStateServiceServerHelper_INCLUDED
+
+
+#include "IoT/DeviceState/DeviceStateService.h"
+#include "IoT/DeviceState/DeviceStateServiceRemoteObject.h"
+#include "IoT/DeviceState/IDeviceStateService.h"
+#include "Poco/RemotingNG/Identifiable.h"
+#include "Poco/RemotingNG/ORB.h"
+#include "Poco/RemotingNG/ServerHelper.h"
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+class DeviceStateServiceServerHelper
+	/// The DeviceStateService keeps track of the state of all devices
+	/// registered with the service registry (all services having an
+	/// "io.macchina.device" property).
+	///
+	/// The service listens to the valueChanged, stateChanged, countChanged
+	/// and positionUpdate events of the devices. Changes are collected and,
+	/// at a fixed interval, published as small JSON documents through the
+	/// Poco::OSP::WebEvent::WebEventService, using the subject
+	/// <subject>.<id>, where <subject> is the base subject name (default:
+	/// "io.macchina.device") and <id> is the service name of the device.
+	///
+	/// A web client therefore only needs to fetch the initial state of
+	/// all devices with snapshot(), and can then subscribe to the base
+	/// subject to receive all subsequent changes, instead of periodically
+	/// querying every device.
+	///
+	/// Three kinds of messages are published:
+	///   - {"event":"added","id":...,"version":...,"name":...,...} when
+	///     a device has been registered. The message contains all members
+	///     of DeviceInfo.
+	///   - {"event":"changed","id":...,"version":...,...} when the
+	///     displayValue or displayState of a device has changed. Only
+	///     the changed members are included. For a GNSS sensor, the
+	///     message also contains the latest position ("position", with
+	///     "latitude" and "longitude"), "course" and "speed".
+	///   - {"event":"removed","id":...,"version":...} when a device
+	///     has been unregistered.
+	///
+	/// Devices not supporting any of the above events are periodically
+	/// checked for changes.
+{
+public:
+	typedef IoT::DeviceState::DeviceStateService Service;
+
+	DeviceStateServiceServerHelper();
+		/// Creates a DeviceStateServiceServerHelper.
+
+	~DeviceStateServiceServerHelper();
+		/// Destroys the DeviceStateServiceServerHelper.
+
+	static Poco::AutoPtr<IoT::DeviceState::DeviceStateServiceRemoteObject> createRemoteObject(Poco::SharedPtr<IoT::DeviceState::DeviceStateService> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid);
+		/// Creates and returns a RemoteObject wrapper for the given IoT::DeviceState::DeviceStateService instance.
+
+	static std::string registerObject(Poco::SharedPtr<IoT::DeviceState::DeviceStateService> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid, const std::string& listenerId);
+		/// Creates a RemoteObject wrapper for the given IoT::DeviceState::DeviceStateService instance
+		/// and registers it with the ORB and the Listener instance
+		/// uniquely identified by the Listener's ID.
+		/// 
+		///	Returns the URI created for the object.
+
+	static std::string registerRemoteObject(Poco::AutoPtr<IoT::DeviceState::DeviceStateServiceRemoteObject> pRemoteObject, const std::string& listenerId);
+		/// Registers the given RemoteObject with the ORB and the Listener instance
+		/// uniquely identified by the Listener's ID.
+		/// 
+		///	Returns the URI created for the object.
+
+	static void shutdown();
+		/// Removes the Skeleton for IoT::DeviceState::DeviceStateService from the ORB.
+
+	static void unregisterObject(const std::string& uri);
+		/// Unregisters a service object identified by URI from the ORB.
+
+private:
+	static Poco::AutoPtr<IoT::DeviceState::DeviceStateServiceRemoteObject> createRemoteObjectImpl(Poco::SharedPtr<IoT::DeviceState::DeviceStateService> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid);
+
+	static DeviceStateServiceServerHelper& instance();
+		/// Returns a static instance of the helper class.
+
+	std::string registerObjectImpl(Poco::AutoPtr<IoT::DeviceState::DeviceStateServiceRemoteObject> pRemoteObject, const std::string& listenerId);
+
+	void registerSkeleton();
+
+	void unregisterObjectImpl(const std::string& uri);
+
+	void unregisterSkeleton();
+
+	Poco::RemotingNG::ORB* _pORB;
+};
+
+
+inline Poco::AutoPtr<IoT::DeviceState::DeviceStateServiceRemoteObject> DeviceStateServiceServerHelper::createRemoteObject(Poco::SharedPtr<IoT::DeviceState::DeviceStateService> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid)
+{
+	return DeviceStateServiceServerHelper::instance().createRemoteObjectImpl(pServiceObject, oid);
+}
+
+
+inline std::string DeviceStateServiceServerHelper::registerObject(Poco::SharedPtr<IoT::DeviceState::DeviceStateService> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid, const std::string& listenerId)
+{
+	return DeviceStateServiceServerHelper::instance().registerObjectImpl(createRemoteObject(pServiceObject, oid), listenerId);
+}
+
+
+inline std::string DeviceStateServiceServerHelper::registerRemoteObject(Poco::AutoPtr<IoT::DeviceState::DeviceStateServiceRemoteObject> pRemoteObject, const std::string& listenerId)
+{
+	return DeviceStateServiceServerHelper::instance().registerObjectImpl(pRemoteObject, listenerId);
+}
+
+
+inline void DeviceStateServiceServerHelper::unregisterObject(const std::string& uri)
+{
+	DeviceStateServiceServerHelper::instance().unregisterObjectImpl(uri);
+}
+
+
+} // namespace DeviceState
+} // namespace IoT
+
+
+REMOTING_SPECIALIZE_SERVER_HELPER(IoT::DeviceState, DeviceStateService)
+
+
+#endif // IoT_DeviceState_DeviceStateServiceServerHelper_INCLUDED
+
@@ -0,0 +1,86 @@
+//
+// DeviceStateServiceSkeleton.h
+//
+// Library: IoT/DeviceState
+// Package: Generated
+// Module:  DeviceStateServiceSkeleton
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_DeviceState_DeviceStateServiceSkeleton_INCLUDED
+#define IoT_DeviceState_DeviceStateServiceSkeleton_INCLUDED
+
+
+#include "IoT/DeviceState/DeviceStateServiceRemoteObject.h"
+#include "Poco/RemotingNG/Skeleton.h"
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+class DeviceStateServiceSkeleton: public Poco::RemotingNG::Skeleton
+	/// The DeviceStateService keeps track of the state of all devices
+	/// registered with the service registry (all services having an
+	/// "io.macchina.device" property).
+	///
+	/// The service listens to the valueChanged, stateChanged, countChanged
+	/// and positionUpdate events of the devices. Changes are collected and,
+	/// at a fixed interval, published as small JSON documents through the
+	/// Poco::OSP::WebEvent::WebEventService, using the subject
+	/// <subject>.<id>, where <subject> is the base subject name (default:
+	/// "io.macchina.device") and <id> is the service name of the device.
+	///
+	/// A web client therefore only needs to fetch the initial state of
+	/// all devices with snapshot(), and can then subscribe to the base
+	/// subject to receive all subsequent changes, instead of periodically
+	/// querying every device.
+	///
+	/// Three kinds of messages are published:
+	///   - {"event":"added","id":...,"version":...,"name":...,...} when
+	///     a device has been registered. The message contains all members
+	///     of DeviceInfo.
+	///   - {"event":"changed","id":...,"version":...,...} when the
+	///     displayValue or displayState of a device has changed. Only
+	///     the changed members are included. For a GNSS sensor, the
+	///     message also contains the latest position ("position", with
+	///     "latitude" and "longitude"), "course" and "speed".
+	///   - {"event":"removed","id":...,"version":...} when a device
+	///     has been unregistered.
+	///
+	/// Devices not supporting any of the above events are periodically
+	/// checked for changes.
+{
+public:
+	DeviceStateServiceSkeleton();
+		/// Creates a DeviceStateServiceSkeleton.
+
+	virtual ~DeviceStateServiceSkeleton();
+		/// Destroys a DeviceStateServiceSkeleton.
+
+	virtual const Poco::RemotingNG::Identifiable::TypeId& remoting__typeId() const;
+
+	static const std::string DEFAULT_NS;
+};
+
+
+inline const Poco::RemotingNG::Identifiable::TypeId& DeviceStateServiceSkeleton::remoting__typeId() const
+{
+	return IDeviceStateService::remoting__typeId();
+}
+
+
+} // namespace DeviceState
+} // namespace IoT
+
+
+#endif // IoT_DeviceState_DeviceStateServiceSkeleton_INCLUDED
+
@@ -0,0 +1,64 @@
+//
+// DeviceStateSnapshotDeserializer.h
+//
+// Package: Generated
+// Module:  TypeDeserializer
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TypeDeserializer_IoT_DeviceState_DeviceStateSnapshot_INCLUDED
+#define TypeDeserializer_IoT_DeviceState_DeviceStateSnapshot_INCLUDED
+
+
+#include "IoT/DeviceState/DeviceInfoDeserializer.h"
+#include "IoT/DeviceState/DeviceInfoSerializer.h"
+#include "IoT/DeviceState/DeviceStateService.h"
+#include "Poco/RemotingNG/TypeDeserializer.h"
+
+
+namespace Poco {
+namespace RemotingNG {
+
+
+template <>
+class TypeDeserializer<IoT::DeviceState::DeviceStateSnapshot>
+{
+public:
+	static bool deserialize(const std::string& name, bool isMandatory, Deserializer& deser, IoT::DeviceState::DeviceStateSnapshot& value)
+	{
+		bool ret = deser.deserializeStructBegin(name, isMandatory);
+		if (ret)
+		{
+			deserializeImpl(deser, value);
+			deser.deserializeStructEnd(name);
+		}
+		return ret;
+	}
+
+	static void deserializeImpl(Deserializer& deser, IoT::DeviceState::DeviceStateSnapshot& value)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"devices","subject","version"};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		TypeDeserializer<std::vector < IoT::DeviceState::DeviceInfo > >::deserialize(REMOTING__NAMES[0], true, deser, value.devices);
+		TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[1], true, deser, value.subject);
+		TypeDeserializer<Poco::Int64 >::deserialize(REMOTING__NAMES[2], true, deser, value.version);
+	}
+
+};
+
+
+} // namespace RemotingNG
+} // namespace Poco
+
+
+#endif // TypeDeserializer_IoT_DeviceState_DeviceStateSnapshot_INCLUDED
+
@@ -0,0 +1,60 @@
+//
+// DeviceStateSnapshotSerializer.h
+//
+// Package: Generated
+// Module:  TypeSerializer
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TypeSerializer_IoT_DeviceState_DeviceStateSnapshot_INCLUDED
+#define TypeSerializer_IoT_DeviceState_DeviceStateSnapshot_INCLUDED
+
+
+#include "IoT/DeviceState/DeviceInfoDeserializer.h"
+#include "IoT/DeviceState/DeviceInfoSerializer.h"
+#include "IoT/DeviceState/DeviceStateService.h"
+#include "Poco/RemotingNG/TypeSerializer.h"
+
+
+namespace Poco {
+namespace RemotingNG {
+
+
+template <>
+class TypeSerializer<IoT::DeviceState::DeviceStateSnapshot>
+{
+public:
+	static void serialize(const std::string& name, const IoT::DeviceState::DeviceStateSnapshot& value, Serializer& ser)
+	{
+		ser.serializeStructBegin(name);
+		serializeImpl(value, ser);
+		ser.serializeStructEnd(name);
+	}
+
+	static void serializeImpl(const IoT::DeviceState::DeviceStateSnapshot& value, Serializer& ser)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"devices","subject","version",""};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		TypeSerializer<std::vector < IoT::DeviceState::DeviceInfo > >::serialize(REMOTING__NAMES[0], value.devices, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[1], value.subject, ser);
+		TypeSerializer<Poco::Int64 >::serialize(REMOTING__NAMES[2], value.version, ser);
+	}
+
+};
+
+
+} // namespace RemotingNG
+} // namespace Poco
+
+
+#endif // TypeSerializer_IoT_DeviceState_DeviceStateSnapshot_INCLUDED
+
@@ -0,0 +1,101 @@
+//
+// IDeviceStateService.h
+//
+// Library: IoT/DeviceState
+// Package: Generated
+// Module:  IDeviceStateService
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_DeviceState_IDeviceStateService_INCLUDED
+#define IoT_DeviceState_IDeviceStateService_INCLUDED
+
+
+#include "IoT/DeviceState/DeviceStateService.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/OSP/Service.h"
+#include "Poco/RemotingNG/Identifiable.h"
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+class IDeviceStateService: public Poco::OSP::Service
+	/// The DeviceStateService keeps track of the state of all devices
+	/// registered with the service registry (all services having an
+	/// "io.macchina.device" property).
+	///
+	/// The service listens to the valueChanged, stateChanged, countChanged
+	/// and positionUpdate events of the devices. Changes are collected and,
+	/// at a fixed interval, published as small JSON documents through the
+	/// Poco::OSP::WebEvent::WebEventService, using the subject
+	/// <subject>.<id>, where <subject> is the base subject name (default:
+	/// "io.macchina.device") and <id> is the service name of the device.
+	///
+	/// A web client therefore only needs to fetch the initial state of
+	/// all devices with snapshot(), and can then subscribe to the base
+	/// subject to receive all subsequent changes, instead of periodically
+	/// querying every device.
+	///
+	/// Three kinds of messages are published:
+	///   - {"event":"added","id":...,"version":...,"name":...,...} when
+	///     a device has been registered. The message contains all members
+	///     of DeviceInfo.
+	///   - {"event":"changed","id":...,"version":...,...} when the
+	///     displayValue or displayState of a device has changed. Only
+	///     the changed members are included. For a GNSS sensor, the
+	///     message also contains the latest position ("position", with
+	///     "latitude" and "longitude"), "course" and "speed".
+	///   - {"event":"removed","id":...,"version":...} when a device
+	///     has been unregistered.
+	///
+	/// Devices not supporting any of the above events are periodically
+	/// checked for changes.
+{
+public:
+	typedef Poco::AutoPtr<IDeviceStateService> Ptr;
+
+	IDeviceStateService();
+		/// Creates a IDeviceStateService.
+
+	virtual ~IDeviceStateService();
+		/// Destroys the IDeviceStateService.
+
+	bool isA(const std::type_info& otherType) const;
+		/// Returns true if the class is a subclass of the class given by otherType.
+
+	static const Poco::RemotingNG::Identifiable::TypeId& remoting__typeId();
+		/// Returns the TypeId of the class.
+
+	virtual IoT::DeviceState::DeviceStateSnapshot snapshot() const = 0;
+		/// Returns the current state of all devices, together with
+		/// the current version and the base subject name.
+
+	virtual std::string subject() const = 0;
+		/// Returns the base subject name used for publishing changes,
+		/// or an empty string if changes are not published.
+
+	const std::type_info& type() const;
+		/// Returns the type information for the object's class.
+
+	virtual Poco::Int64 version() const = 0;
+		/// Returns the current version.
+
+};
+
+
+} // namespace DeviceState
+} // namespace IoT
+
+
+#endif // IoT_DeviceState_IDeviceStateService_INCLUDED
+
@@ -0,0 +1,98 @@
+//
+// BundleActivator.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "DeviceStateServiceImpl.h"
+#include "IoT/DeviceState/DeviceStateServiceServerHelper.h"
+#include "Poco/OSP/BundleActivator.h"
+#include "Poco/OSP/BundleContext.h"
+#include "Poco/OSP/Bundle.h"
+#include "Poco/OSP/ServiceRegistry.h"
+#include "Poco/OSP/ServiceRef.h"
+#include "Poco/OSP/ServiceFinder.h"
+#include "Poco/OSP/PreferencesService.h"
+#include "Poco/OSP/WebEvent/WebEventService.h"
+#include "Poco/ClassLibrary.h"
+
+
+using Poco::OSP::BundleContext;
+using Poco::OSP::ServiceRegistry;
+using Poco::OSP::ServiceRef;
+using Poco::OSP::Properties;
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+class BundleActivator: public Poco::OSP::BundleActivator
+{
+public:
+	typedef Poco::RemotingNG::ServerHelper<IoT::DeviceState::DeviceStateService> ServerHelper;
+
+	BundleActivator()
+	{
+	}
+
+	~BundleActivator()
+	{
+	}
+
+	void start(BundleContext::Ptr pContext)
+	{
+		_pContext = pContext;
+
+		Poco::OSP::PreferencesService::Ptr pPrefs = Poco::OSP::ServiceFinder::find<Poco::OSP::PreferencesService>(pContext);
+
+		std::string subject = pPrefs->configuration()->getString("deviceState.subject", "io.macchina.device");
+		long publishInterval = pPrefs->configuration()->getInt("deviceState.publishInterval", 250);
+		long refreshInterval = pPrefs->configuration()->getInt("deviceState.refreshInterval", 5000);
+
+		Poco::OSP::WebEvent::WebEventService::Ptr pWebEventService;
+		try
+		{
+			pWebEventService = Poco::OSP::ServiceFinder::find<Poco::OSP::WebEvent::WebEventService>(pContext);
+		}
+		catch (Poco::NotFoundException&)
+		{
+			pContext->logger().warning("No WebEventService available. Device state changes will not be published.");
+		}
+
+		_pDeviceStateServiceImpl = new DeviceStateServiceImpl(pContext, pWebEventService, subject, publishInterval, refreshInterval);
+		_pDeviceStateServiceImpl->start();
+
+		std::string oid("io.macchina.services.devicestate");
+		ServerHelper::RemoteObjectPtr pDeviceStateServiceRemoteObject = ServerHelper::createRemoteObject(_pDeviceStateServiceImpl, oid);
+		_pServiceRef = pContext->registry().registerService(oid, pDeviceStateServiceRemoteObject, Properties());
+	}
+
+	void stop(BundleContext::Ptr pContext)
+	{
+		pContext->registry().unregisterService(_pServiceRef);
+		_pServiceRef = 0;
+		_pDeviceStateServiceImpl->stop();
+		_pDeviceStateServiceImpl = 0;
+		_pContext = 0;
+
+		ServerHelper::shutdown();
+	}
+
+private:
+	Poco::OSP::BundleContext::Ptr _pContext;
+	Poco::SharedPtr<DeviceStateServiceImpl> _pDeviceStateServiceImpl;
+	Poco::OSP::ServiceRef::Ptr _pServiceRef;
+};
+
+
+} } // namespace IoT::DeviceState
+
+
+POCO_BEGIN_MANIFEST(Poco::OSP::BundleActivator)
+	POCO_EXPORT_CLASS(IoT::DeviceState::BundleActivator)
+POCO_END_MANIFEST
@@ -0,0 +1,32 @@
+//
+// DeviceStateService.cpp
+//
+// Library: IoT/DeviceState
+// Package: DeviceStateService
+// Module:  DeviceStateService
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/DeviceState/DeviceStateService.h"
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+DeviceStateService::DeviceStateService()
+{
+}
+
+	
+DeviceStateService::~DeviceStateService()
+{
+}
+
+
+} } // namespace IoT::DeviceState
@@ -0,0 +1,371 @@
+//
+// DeviceStateServiceImpl.cpp
+//
+// Library: IoT/DeviceState
+// Package: DeviceStateServiceImpl
+// Module:  DeviceStateServiceImpl
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "DeviceStateServiceImpl.h"
+#include "Poco/OSP/ServiceRegistry.h"
+#include "Poco/Util/TimerTaskAdapter.h"
+#include "Poco/Delegate.h"
+#include <sstream>
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+namespace
+{
+	const std::string PROP_NAME("name");
+	const std::string PROP_TYPE("type");
+	const std::string PROP_SYMBOLIC_NAME("symbolicName");
+	const std::string PROP_PHYSICAL_QUANTITY("physicalQuantity");
+	const std::string PROP_PHYSICAL_UNIT("physicalUnit");
+	const std::string PROP_DISPLAY_VALUE("displayValue");
+	const std::string PROP_DISPLAY_STATE("displayState");
+}
+
+
+DeviceStateServiceImpl::DeviceStateServiceImpl(Poco::OSP::BundleContext::Ptr pContext, Poco::OSP::WebEvent::WebEventService::Ptr pWebEventService, const std::string& subject, long publishInterval, long refreshInterval):
+	_pContext(pContext),
+	_pWebEventService(pWebEventService),
+	_subject(subject),
+	_publishInterval(publishInterval),
+	_refreshInterval(refreshInterval),
+	_sinceRefresh(0),
+	_version(0),
+	_logger(Poco::Logger::get("IoT.DeviceState"))
+{
+	poco_assert (_publishInterval > 0);
+}
+
+
+DeviceStateServiceImpl::~DeviceStateServiceImpl()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void DeviceStateServiceImpl::start()
+{
+	_pListener = _pContext->registry().createListener(
+		"io.macchina.device != \"\"",
+		Poco::delegate(this, &DeviceStateServiceImpl::onDeviceRegistered),
+		Poco::delegate(this, &DeviceStateServiceImpl::onDeviceUnregistered));
+
+	Poco::Util::TimerTask::Ptr pTask = new Poco::Util::TimerTaskAdapter<DeviceStateServiceImpl>(*this, &DeviceStateServiceImpl::onPublish);
+	_timer.schedule(pTask, _publishInterval, _publishInterval);
+}
+
+
+void DeviceStateServiceImpl::stop()
+{
+	_timer.cancel(true);
+	_pListener = 0;
+
+	DeviceMap devices;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_devices.swap(devices);
+		_changed.clear();
+		_positions.clear();
+	}
+
+	// disable() waits for events still being delivered,
+	// so the watchers can safely be destroyed afterwards.
+	for (DeviceMap::iterator it = devices.begin(); it != devices.end(); ++it)
+	{
+		it->second.pWatcher->disable();
+	}
+}
+
+
+void DeviceStateServiceImpl::deviceChanged(const std::string& id)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_changed.insert(id);
+}
+
+
+void DeviceStateServiceImpl::positionChanged(const std::string& id, const IoT::Devices::PositionUpdate& update)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	_changed.insert(id);
+	_positions[id] = update;
+}
+
+
+DeviceStateSnapshot DeviceStateServiceImpl::snapshot() const
+{
+	DeviceStateSnapshot result;
+	result.subject = subject();
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	result.version = _version;
+	result.devices.reserve(_devices.size());
+	for (DeviceMap::const_iterator it = _devices.begin(); it != _devices.end(); ++it)
+	{
+		result.devices.push_back(it->second.info);
+	}
+	return result;
+}
+
+
+Poco::Int64 DeviceStateServiceImpl::version() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _version;
+}
+
+
+std::string DeviceStateServiceImpl::subject() const
+{
+	if (_pWebEventService)
+		return _subject;
+	else
+		return std::string();
+}
+
+
+void DeviceStateServiceImpl::onDeviceRegistered(const Poco::OSP::ServiceRef::Ptr& pDeviceRef)
+{
+	IoT::Devices::IDevice::Ptr pDevice = pDeviceRef->instance().cast<IoT::Devices::IDevice>();
+	if (!pDevice)
+	{
+		_logger.warning("Service %s is not a device.", pDeviceRef->name());
+		return;
+	}
+
+	const std::string* pNames[] = {&PROP_NAME, &PROP_TYPE, &PROP_SYMBOLIC_NAME, &PROP_PHYSICAL_QUANTITY, &PROP_PHYSICAL_UNIT, &PROP_DISPLAY_VALUE, &PROP_DISPLAY_STATE};
+	std::vector<std::string> names;
+	for (std::size_t i = 0; i < sizeof(pNames)/sizeof(pNames[0]); i++)
+	{
+		names.push_back(*pNames[i]);
+	}
+	std::map<std::string, std::string> values;
+	readProperties(pDevice, names, values);
+
+	DeviceEntry entry;
+	entry.pWatcher = new DeviceWatcher(*this, pDeviceRef->name(), pDevice);
+	entry.info.id = pDeviceRef->name();
+	entry.info.name = values[PROP_NAME];
+	entry.info.type = values[PROP_TYPE];
+	entry.info.symbolicName = values[PROP_SYMBOLIC_NAME];
+	entry.info.physicalQuantity = values[PROP_PHYSICAL_QUANTITY];
+	entry.info.physicalUnit = values[PROP_PHYSICAL_UNIT];
+	entry.info.displayValue = values[PROP_DISPLAY_VALUE];
+	entry.info.displayState = values[PROP_DISPLAY_STATE];
+
+	Poco::JSON::Object::Ptr pMessage;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		entry.info.version = ++_version;
+		_devices[entry.info.id] = entry;
+		pMessage = toJSON(entry.info);
+
+		// Enabled while holding the mutex, so that a concurrent
+		// onDeviceUnregistered() cannot disable the watcher before
+		// it has been enabled.
+		entry.pWatcher->enable();
+	}
+
+	_logger.debug("Watching device %s.", entry.info.id);
+
+	pMessage->set("event", std::string("added"));
+	publish(entry.info.id, pMessage);
+}
+
+
+void DeviceStateServiceImpl::onDeviceUnregistered(const Poco::OSP::ServiceRef::Ptr& pDeviceRef)
+{
+	const std::string& id = pDeviceRef->name();
+
+	DeviceWatcher::Ptr pWatcher;
+	Poco::JSON::Object::Ptr pMessage = new Poco::JSON::Object;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		DeviceMap::iterator it = _devices.find(id);
+		if (it == _devices.end()) return;
+		pWatcher = it->second.pWatcher;
+		_devices.erase(it);
+		_changed.erase(id);
+		_positions.erase(id);
+		pMessage->set("version", ++_version);
+	}
+	pWatcher->disable();
+
+	_logger.debug("No longer watching device %s.", id);
+
+	pMessage->set("event", std::string("removed"));
+	pMessage->set("id", id);
+	publish(id, pMessage);
+}
+
+
+void DeviceStateServiceImpl::onPublish(Poco::Util::TimerTask& task)
+{
+	std::vector<DeviceWatcher::Ptr> watchers;
+	PositionMap positions;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_sinceRefresh += _publishInterval;
+		if (_sinceRefresh >= _refreshInterval)
+		{
+			_sinceRefresh = 0;
+			for (DeviceMap::const_iterator it = _devices.begin(); it != _devices.end(); ++it)
+			{
+				if (!it->second.pWatcher->hasEvents()) _changed.insert(it->first);
+			}
+		}
+		for (std::set<std::string>::const_iterator it = _changed.begin(); it != _changed.end(); ++it)
+		{
+			DeviceMap::const_iterator itDev = _devices.find(*it);
+			if (itDev != _devices.end()) watchers.push_back(itDev->second.pWatcher);
+		}
+		_changed.clear();
+		_positions.swap(positions);
+	}
+	if (watchers.empty()) return;
+
+	std::vector<std::string> names;
+	names.push_back(PROP_DISPLAY_VALUE);
+	names.push_back(PROP_DISPLAY_STATE);
+
+	// Read the current values without holding the mutex,
+	// as this calls into the device implementations.
+	std::vector<std::map<std::string, std::string> > values(watchers.size());
+	for (std::size_t i = 0; i < watchers.size(); i++)
+	{
+		readProperties(watchers[i]->device(), names, values[i]);
+	}
+
+	std::vector<std::pair<std::string, Poco::JSON::Object::Ptr> > messages;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		for (std::size_t i = 0; i < watchers.size(); i++)
+		{
+			const std::string& id = watchers[i]->id();
+			DeviceMap::iterator itDev = _devices.find(id);
+			if (itDev == _devices.end() || itDev->second.pWatcher != watchers[i]) continue;
+
+			DeviceInfo& info = itDev->second.info;
+			Poco::JSON::Object::Ptr pMessage = new Poco::JSON::Object;
+			const std::string& displayValue = values[i][PROP_DISPLAY_VALUE];
+			if (displayValue != info.displayValue)
+			{
+				info.displayValue = displayValue;
+				pMessage->set(PROP_DISPLAY_VALUE, displayValue);
+			}
+			const std::string& displayState = values[i][PROP_DISPLAY_STATE];
+			if (displayState != info.displayState)
+			{
+				info.displayState = displayState;
+				pMessage->set(PROP_DISPLAY_STATE, displayState);
+			}
+			PositionMap::const_iterator itPos = positions.find(id);
+			if (itPos != positions.end())
+			{
+				Poco::JSON::Object::Ptr pPosition = new Poco::JSON::Object;
+				pPosition->set("latitude", itPos->second.position.latitude);
+				pPosition->set("longitude", itPos->second.position.longitude);
+				pMessage->set("position", pPosition);
+				pMessage->set("course", itPos->second.course);
+				pMessage->set("speed", itPos->second.speed);
+			}
+			if (pMessage->size() > 0)
+			{
+				info.version = ++_version;
+				pMessage->set("event", std::string("changed"));
+				pMessage->set("id", id);
+				pMessage->set("version", info.version);
+				messages.push_back(std::make_pair(id, pMessage));
+			}
+		}
+	}
+
+	for (std::vector<std::pair<std::string, Poco::JSON::Object::Ptr> >::const_iterator it = messages.begin(); it != messages.end(); ++it)
+	{
+		publish(it->first, it->second);
+	}
+}
+
+
+void DeviceStateServiceImpl::publish(const std::string& id, Poco::JSON::Object::Ptr pMessage)
+{
+	if (!_pWebEventService) return;
+
+	try
+	{
+		std::ostringstream ostr;
+		pMessage->stringify(ostr);
+		_pWebEventService->notify(_subject + "." + id, ostr.str());
+	}
+	catch (Poco::Exception& exc)
+	{
+		_logger.log(exc);
+	}
+}
+
+
+void DeviceStateServiceImpl::readProperties(IoT::Devices::IDevice::Ptr pDevice, const std::vector<std::string>& names, std::map<std::string, std::string>& values)
+{
+	try
+	{
+		std::vector<IoT::Devices::DeviceProperty> properties = pDevice->getProperties(names);
+		for (std::vector<IoT::Devices::DeviceProperty>::const_iterator it = properties.begin(); it != properties.end(); ++it)
+		{
+			if (it->type == IoT::Devices::DEVICE_PROPERTY_STRING)
+			{
+				values[it->name] = it->stringValue;
+			}
+		}
+	}
+	catch (Poco::Exception& exc)
+	{
+		Poco::Logger::get("IoT.DeviceState").log(exc);
+	}
+}
+
+
+Poco::JSON::Object::Ptr DeviceStateServiceImpl::toJSON(const DeviceInfo& info)
+{
+	Poco::JSON::Object::Ptr pObject = new Poco::JSON::Object;
+	pObject->set("id", info.id);
+	pObject->set(PROP_NAME, info.name);
+	pObject->set(PROP_TYPE, info.type);
+	pObject->set(PROP_SYMBOLIC_NAME, info.symbolicName);
+	pObject->set(PROP_PHYSICAL_QUANTITY, info.physicalQuantity);
+	pObject->set(PROP_PHYSICAL_UNIT, info.physicalUnit);
+	pObject->set(PROP_DISPLAY_VALUE, info.displayValue);
+	pObject->set(PROP_DISPLAY_STATE, info.displayState);
+	pObject->set("version", info.version);
+	return pObject;
+}
+
+
+} } // namespace IoT::DeviceState
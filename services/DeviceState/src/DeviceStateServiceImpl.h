@@ -0,0 +1,110 @@
+//
+// DeviceStateServiceImpl.h
+//
+// Library: IoT/DeviceState
+// Package: DeviceStateServiceImpl
+// Module:  DeviceStateServiceImpl
+//
+// Definition of the DeviceStateServiceImpl class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_DeviceState_DeviceStateServiceImpl_INCLUDED
+#define IoT_DeviceState_DeviceStateServiceImpl_INCLUDED
+
+
+#include "IoT/DeviceState/DeviceStateService.h"
+#include "DeviceWatcher.h"
+#include "Poco/OSP/BundleContext.h"
+#include "Poco/OSP/ServiceListener.h"
+#include "Poco/OSP/WebEvent/WebEventService.h"
+#include "Poco/Util/Timer.h"
+#include "Poco/JSON/Object.h"
+#include "Poco/Logger.h"
+#include "Poco/Mutex.h"
+#include <map>
+#include <set>
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+class DeviceStateServiceImpl: public DeviceStateService
+	/// Default implementation of the DeviceStateService.
+{
+public:
+	DeviceStateServiceImpl(Poco::OSP::BundleContext::Ptr pContext, Poco::OSP::WebEvent::WebEventService::Ptr pWebEventService, const std::string& subject, long publishInterval, long refreshInterval);
+		/// Creates the DeviceStateServiceImpl.
+		///
+		/// Changes are published to the given WebEventService (which may
+		/// be null) every publishInterval milliseconds. Devices not
+		/// supporting any change events are checked for changes
+		/// every refreshInterval milliseconds.
+
+	~DeviceStateServiceImpl();
+		/// Destroys the DeviceStateServiceImpl.
+
+	void start();
+		/// Starts watching devices and publishing changes.
+
+	void stop();
+		/// Stops watching devices and publishing changes.
+
+	void deviceChanged(const std::string& id);
+		/// Called by a DeviceWatcher when the value or state
+		/// of the device with the given ID has changed.
+
+	void positionChanged(const std::string& id, const IoT::Devices::PositionUpdate& update);
+		/// Called by a DeviceWatcher when the GNSS sensor with
+		/// the given ID has reported a new position.
+
+	// DeviceStateService
+	DeviceStateSnapshot snapshot() const;
+	Poco::Int64 version() const;
+	std::string subject() const;
+
+protected:
+	struct DeviceEntry
+	{
+		DeviceWatcher::Ptr pWatcher;
+		DeviceInfo info;
+	};
+
+	typedef std::map<std::string, DeviceEntry> DeviceMap;
+	typedef std::map<std::string, IoT::Devices::PositionUpdate> PositionMap;
+
+	void onDeviceRegistered(const Poco::OSP::ServiceRef::Ptr& pDeviceRef);
+	void onDeviceUnregistered(const Poco::OSP::ServiceRef::Ptr& pDeviceRef);
+	void onPublish(Poco::Util::TimerTask& task);
+	void publish(const std::string& id, Poco::JSON::Object::Ptr pMessage);
+	static void readProperties(IoT::Devices::IDevice::Ptr pDevice, const std::vector<std::string>& names, std::map<std::string, std::string>& values);
+	static Poco::JSON::Object::Ptr toJSON(const DeviceInfo& info);
+
+private:
+	Poco::OSP::BundleContext::Ptr _pContext;
+	Poco::OSP::WebEvent::WebEventService::Ptr _pWebEventService;
+	std::string _subject;
+	long _publishInterval;
+	long _refreshInterval;
+	long _sinceRefresh;
+	Poco::OSP::ServiceListener::Ptr _pListener;
+	Poco::Util::Timer _timer;
+	DeviceMap _devices;
+	std::set<std::string> _changed;
+	PositionMap _positions;
+	Poco::Int64 _version;
+	Poco::Logger& _logger;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+} } // namespace IoT::DeviceState
+
+
+#endif // IoT_DeviceState_DeviceStateServiceImpl_INCLUDED
@@ -0,0 +1,47 @@
+//
+// DeviceStateServiceRemoteObject.cpp
+//
+// Library: IoT/DeviceState
+// Package: Generated
+// Module:  DeviceStateServiceRemoteObject
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/DeviceState/DeviceStateServiceRemoteObject.h"
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+DeviceStateServiceRemoteObject::DeviceStateServiceRemoteObject(const Poco::RemotingNG::Identifiable::ObjectId& oid, Poco::SharedPtr<IoT::DeviceState::DeviceStateService> pServiceObject):
+	IoT::DeviceState::IDeviceStateService(),
+	Poco::RemotingNG::RemoteObject(oid),
+	_pServiceObject(pServiceObject)
+{
+}
+
+
+DeviceStateServiceRemoteObject::~DeviceStateServiceRemoteObject()
+{
+	try
+	{
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+} // namespace DeviceState
+} // namespace IoT
+
@@ -0,0 +1,92 @@
+//
+// DeviceStateServiceServerHelper.cpp
+//
+// Library: IoT/DeviceState
+// Package: Generated
+// Module:  DeviceStateServiceServerHelper
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/DeviceState/DeviceStateServiceServerHelper.h"
+#include "IoT/DeviceState/DeviceStateServiceSkeleton.h"
+#include "Poco/RemotingNG/URIUtility.h"
+#include "Poco/SingletonHolder.h"
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+namespace
+{
+	static Poco::SingletonHolder<DeviceStateServiceServerHelper> shDeviceStateServiceServerHelper;
+}
+
+
+DeviceStateServiceServerHelper::DeviceStateServiceServerHelper():
+	_pORB(0)
+{
+	_pORB = &Poco::RemotingNG::ORB::instance();
+	registerSkeleton();
+}
+
+
+DeviceStateServiceServerHelper::~DeviceStateServiceServerHelper()
+{
+}
+
+
+void DeviceStateServiceServerHelper::shutdown()
+{
+	DeviceStateServiceServerHelper::instance().unregisterSkeleton();
+	shDeviceStateServiceServerHelper.reset();
+}
+
+
+Poco::AutoPtr<IoT::DeviceState::DeviceStateServiceRemoteObject> DeviceStateServiceServerHelper::createRemoteObjectImpl(Poco::SharedPtr<IoT::DeviceState::DeviceStateService> pServiceObject, const Poco::RemotingNG::Identifiable::ObjectId& oid)
+{
+	return new DeviceStateServiceRemoteObject(oid, pServiceObject);
+}
+
+
+DeviceStateServiceServerHelper& DeviceStateServiceServerHelper::instance()
+{
+	return *shDeviceStateServiceServerHelper.get();
+}
+
+
+std::string DeviceStateServiceServerHelper::registerObjectImpl(Poco::AutoPtr<IoT::DeviceState::DeviceStateServiceRemoteObject> pRemoteObject, const std::string& listenerId)
+{
+	return _pORB->registerObject(pRemoteObject, listenerId);
+}
+
+
+void DeviceStateServiceServerHelper::registerSkeleton()
+{
+	_pORB->registerSkeleton("IoT.DeviceState.DeviceStateService", new DeviceStateServiceSkeleton);
+}
+
+
+void DeviceStateServiceServerHelper::unregisterObjectImpl(const std::string& uri)
+{
+	_pORB->unregisterObject(uri);
+}
+
+
+void DeviceStateServiceServerHelper::unregisterSkeleton()
+{
+	_pORB->unregisterSkeleton("IoT.DeviceState.DeviceStateService", true);
+}
+
+
+} // namespace DeviceState
+} // namespace IoT
+
@@ -0,0 +1,151 @@
+//
+// DeviceWatcher.cpp
+//
+// Library: IoT/DeviceState
+// Package: DeviceStateServiceImpl
+// Module:  DeviceWatcher
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "DeviceWatcher.h"
+#include "DeviceStateServiceImpl.h"
+#include "Poco/Delegate.h"
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+DeviceWatcher::DeviceWatcher(DeviceStateServiceImpl& service, const std::string& id, IoT::Devices::IDevice::Ptr pDevice):
+	_service(service),
+	_id(id),
+	_pDevice(pDevice),
+	_pSensor(pDevice.cast<IoT::Devices::ISensor>()),
+	_pBooleanSensor(pDevice.cast<IoT::Devices::IBooleanSensor>()),
+	_pSwitch(pDevice.cast<IoT::Devices::ISwitch>()),
+	_pIO(pDevice.cast<IoT::Devices::IIO>()),
+	_pCounter(pDevice.cast<IoT::Devices::ICounter>()),
+	_pGNSSSensor(pDevice.cast<IoT::Devices::IGNSSSensor>()),
+	_enabled(false),
+	_deliveries(0)
+{
+}
+
+
+DeviceWatcher::~DeviceWatcher()
+{
+	try
+	{
+		disable();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void DeviceWatcher::enable()
+{
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		if (_enabled) return;
+		_enabled = true;
+	}
+
+	if (_pSensor) _pSensor->valueChanged += Poco::delegate(this, &DeviceWatcher::onValueChanged);
+	if (_pBooleanSensor) _pBooleanSensor->stateChanged += Poco::delegate(this, &DeviceWatcher::onStateChanged);
+	if (_pSwitch) _pSwitch->stateChanged += Poco::delegate(this, &DeviceWatcher::onStateChanged);
+	if (_pIO) _pIO->stateChanged += Poco::delegate(this, &DeviceWatcher::onStateChanged);
+	if (_pCounter) _pCounter->countChanged += Poco::delegate(this, &DeviceWatcher::onCountChanged);
+	if (_pGNSSSensor) _pGNSSSensor->positionUpdate += Poco::delegate(this, &DeviceWatcher::onPositionUpdate);
+}
+
+
+void DeviceWatcher::disable()
+{
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		if (!_enabled) return;
+		_enabled = false;
+	}
+
+	if (_pSensor) _pSensor->valueChanged -= Poco::delegate(this, &DeviceWatcher::onValueChanged);
+	if (_pBooleanSensor) _pBooleanSensor->stateChanged -= Poco::delegate(this, &DeviceWatcher::onStateChanged);
+	if (_pSwitch) _pSwitch->stateChanged -= Poco::delegate(this, &DeviceWatcher::onStateChanged);
+	if (_pIO) _pIO->stateChanged -= Poco::delegate(this, &DeviceWatcher::onStateChanged);
+	if (_pCounter) _pCounter->countChanged -= Poco::delegate(this, &DeviceWatcher::onCountChanged);
+	if (_pGNSSSensor) _pGNSSSensor->positionUpdate -= Poco::delegate(this, &DeviceWatcher::onPositionUpdate);
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	while (_deliveries > 0)
+	{
+		_delivered.wait(_mutex);
+	}
+}
+
+
+bool DeviceWatcher::hasEvents() const
+{
+	return _pSensor || _pBooleanSensor || _pSwitch || _pIO || _pCounter || _pGNSSSensor;
+}
+
+
+bool DeviceWatcher::enter()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	if (!_enabled) return false;
+	_deliveries++;
+	return true;
+}
+
+
+void DeviceWatcher::leave()
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	if (--_deliveries == 0) _delivered.broadcast();
+}
+
+
+void DeviceWatcher::onValueChanged(const double& value)
+{
+	if (!enter()) return;
+	_service.deviceChanged(_id);
+	leave();
+}
+
+
+void DeviceWatcher::onStateChanged(const bool& state)
+{
+	if (!enter()) return;
+	_service.deviceChanged(_id);
+	leave();
+}
+
+
+void DeviceWatcher::onCountChanged(const Poco::Int32& count)
+{
+	if (!enter()) return;
+	_service.deviceChanged(_id);
+	leave();
+}
+
+
+void DeviceWatcher::onPositionUpdate(const IoT::Devices::PositionUpdate& update)
+{
+	if (!enter()) return;
+	_service.positionChanged(_id, update);
+	leave();
+}
+
+
+} } // namespace IoT::DeviceState
@@ -0,0 +1,133 @@
+//
+// DeviceWatcher.h
+//
+// Library: IoT/DeviceState
+// Package: DeviceStateServiceImpl
+// Module:  DeviceWatcher
+//
+// Definition of the DeviceWatcher class.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef IoT_DeviceState_DeviceWatcher_INCLUDED
+#define IoT_DeviceState_DeviceWatcher_INCLUDED
+
+
+#include "IoT/Devices/IDevice.h"
+#include "IoT/Devices/ISensor.h"
+#include "IoT/Devices/IBooleanSensor.h"
+#include "IoT/Devices/ISwitch.h"
+#include "IoT/Devices/IIO.h"
+#include "IoT/Devices/ICounter.h"
+#include "IoT/Devices/IGNSSSensor.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+class DeviceStateServiceImpl;
+
+
+class DeviceWatcher: public Poco::RefCountedObject
+	/// A DeviceWatcher subscribes to the change events supported
+	/// by a device and reports changes to the DeviceStateServiceImpl.
+{
+public:
+	typedef Poco::AutoPtr<DeviceWatcher> Ptr;
+
+	DeviceWatcher(DeviceStateServiceImpl& service, const std::string& id, IoT::Devices::IDevice::Ptr pDevice);
+		/// Creates the DeviceWatcher for the given device.
+
+	~DeviceWatcher();
+		/// Destroys the DeviceWatcher.
+
+	void enable();
+		/// Subscribes to the events of the device.
+
+	void disable();
+		/// Unsubscribes from the events of the device.
+		///
+		/// An event may already be in the process of being delivered
+		/// to the DeviceWatcher while it is disabled. Therefore,
+		/// disable() waits until all deliveries in progress have
+		/// reported their change to the DeviceStateServiceImpl.
+		/// After disable() returns, the DeviceStateServiceImpl will
+		/// not be called again, and the DeviceWatcher can be destroyed.
+		///
+		/// Must not be called while holding the DeviceStateServiceImpl's
+		/// mutex, and not from within an event delegate of the device.
+
+	const std::string& id() const;
+		/// Returns the service name of the device.
+
+	IoT::Devices::IDevice::Ptr device() const;
+		/// Returns the device.
+
+	bool hasEvents() const;
+		/// Returns true if the device supports at
+		/// least one of the watched events.
+
+protected:
+	bool enter();
+		/// Called at the beginning of every event delegate.
+		/// Returns true if the event must be reported.
+
+	void leave();
+		/// Called at the end of every event delegate
+		/// for which enter() returned true.
+
+	void onValueChanged(const double& value);
+	void onStateChanged(const bool& state);
+	void onCountChanged(const Poco::Int32& count);
+	void onPositionUpdate(const IoT::Devices::PositionUpdate& update);
+
+private:
+	DeviceWatcher();
+	DeviceWatcher(const DeviceWatcher&);
+	DeviceWatcher& operator = (const DeviceWatcher&);
+
+	DeviceStateServiceImpl& _service;
+	std::string _id;
+	IoT::Devices::IDevice::Ptr _pDevice;
+	IoT::Devices::ISensor::Ptr _pSensor;
+	IoT::Devices::IBooleanSensor::Ptr _pBooleanSensor;
+	IoT::Devices::ISwitch::Ptr _pSwitch;
+	IoT::Devices::IIO::Ptr _pIO;
+	IoT::Devices::ICounter::Ptr _pCounter;
+	IoT::Devices::IGNSSSensor::Ptr _pGNSSSensor;
+	bool _enabled;
+	int _deliveries;
+	Poco::FastMutex _mutex;
+	Poco::Condition _delivered;
+};
+
+
+//
+// inlines
+//
+inline const std::string& DeviceWatcher::id() const
+{
+	return _id;
+}
+
+
+inline IoT::Devices::IDevice::Ptr DeviceWatcher::device() const
+{
+	return _pDevice;
+}
+
+
+} } // namespace IoT::DeviceState
+
+
+#endif // IoT_DeviceState_DeviceWatcher_INCLUDED
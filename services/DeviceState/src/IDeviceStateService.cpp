@@ -0,0 +1,61 @@
+//
+// IDeviceStateService.cpp
+//
+// Library: IoT/DeviceState
+// Package: Generated
+// Module:  IDeviceStateService
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "IoT/DeviceState/IDeviceStateService.h"
+
+
+namespace IoT {
+namespace DeviceState {
+
+
+IDeviceStateService::IDeviceStateService():
+	Poco::OSP::Service()
+
+{
+}
+
+
+IDeviceStateService::~IDeviceStateService()
+{
+}
+
+
+bool IDeviceStateService::isA(const std::type_info& otherType) const
+{
+	std::string name(type().name());
+	return name == otherType.name();
+}
+
+
+const Poco::RemotingNG::Identifiable::TypeId& IDeviceStateService::remoting__typeId()
+{
+	remoting__staticInitBegin(REMOTING__TYPE_ID);
+	static const std::string REMOTING__TYPE_ID("IoT.DeviceState.DeviceStateService");
+	remoting__staticInitEnd(REMOTING__TYPE_ID);
+	return REMOTING__TYPE_ID;
+}
+
+
+const std::type_info& IDeviceStateService::type() const
+{
+	return typeid(IDeviceStateService);
+}
+
+
+} // namespace DeviceState
+} // namespace IoT
+
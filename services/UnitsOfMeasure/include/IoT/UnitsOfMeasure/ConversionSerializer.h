@@ -0,0 +1,59 @@
+//
+// ConversionSerializer.h
+//
+// Package: Generated
+// Module:  TypeSerializer
+//
+// This file has been generated.
+// Warning: All changes to this will be lost when the file is re-generated.
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+// 
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef TypeSerializer_IoT_UnitsOfMeasure_Conversion_INCLUDED
+#define TypeSerializer_IoT_UnitsOfMeasure_Conversion_INCLUDED
+
+
+#include "IoT/UnitsOfMeasure/UnitsOfMeasureService.h"
+#include "Poco/RemotingNG/TypeSerializer.h"
+
+
+namespace Poco {
+namespace RemotingNG {
+
+
+template <>
+class TypeSerializer<IoT::UnitsOfMeasure::Conversion>
+{
+public:
+	static void serialize(const std::string& name, const IoT::UnitsOfMeasure::Conversion& value, Serializer& ser)
+	{
+		ser.serializeStructBegin(name);
+		serializeImpl(value, ser);
+		ser.serializeStructEnd(name);
+	}
+
+	static void serializeImpl(const IoT::UnitsOfMeasure::Conversion& value, Serializer& ser)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"factor","from","offset","to",""};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		TypeSerializer<double >::serialize(REMOTING__NAMES[0], value.factor, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[1], value.from, ser);
+		TypeSerializer<double >::serialize(REMOTING__NAMES[2], value.offset, ser);
+		TypeSerializer<std::string >::serialize(REMOTING__NAMES[3], value.to, ser);
+	}
+
+};
+
+
+} // namespace RemotingNG
+} // namespace Poco
+
+
+#endif // TypeSerializer_IoT_UnitsOfMeasure_Conversion_INCLUDED
+
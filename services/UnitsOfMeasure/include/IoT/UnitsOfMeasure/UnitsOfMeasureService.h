@@ -20,6 +20,7 @@
 
 #include "IoT/UnitsOfMeasure/UnitsOfMeasure.h"
 #include "Poco/SharedPtr.h"
+#include <vector>
 
 
 namespace IoT {
@@ -127,6 +128,35 @@ struct CanonicalValue
 };
 
 
+//@ serialize
+struct Conversion
+	/// A compiled unit conversion, obtained from
+	/// UnitsOfMeasureService::compileConversion().
+	///
+	/// All conversions supported by UnitsOfMeasureService are
+	/// affine, so a value is converted with:
+	///
+	///     converted = value*factor + offset
+	///
+	/// The structure is self-contained and can be applied locally
+	/// (e.g., in JavaScript) without calling back into the service.
+{
+	Conversion(): factor(1), offset(0) { }
+
+	std::string from;
+		/// source unit code (e.g. "Cel")
+
+	std::string to;
+		/// target unit code (e.g. "[degF]")
+
+	double factor;
+		/// multiplier
+
+	double offset;
+		/// offset added after scaling (non-zero only for temperatures)
+};
+
+
 //@ remote
 class IoTUnitsOfMeasure_API UnitsOfMeasureService
 	/// The UnitsOfMeasureService service is mainly used to map
@@ -181,6 +211,18 @@ public:
 		/// Temperature conversions between degrees Celsius ("Cel"), degrees Fahrenheit ("[degF]") and Kelvin ("K") are supported.
 		///
 		/// Throws a Poco::InvalidArgumentException if the conversion cannot be performed.
+
+	virtual Conversion compileConversion(const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const = 0;
+		/// Resolves both unit codes and returns a Conversion that can be used
+		/// with convertMany() to efficiently convert many values.
+		/// Compiled conversions are cached, so repeated calls for the same pair of units
+		/// are cheap.
+		///
+		/// Throws a Poco::InvalidArgumentException if the conversion cannot be performed.
+
+	virtual std::vector<double> convertMany(const std::vector<double>& values, const Conversion& conversion) const = 0;
+		/// Converts all given values using the given Conversion, which must have been
+		/// obtained from compileConversion(), and returns the converted values.
 };
 
 
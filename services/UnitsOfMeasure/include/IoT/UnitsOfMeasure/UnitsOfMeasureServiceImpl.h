@@ -19,6 +19,7 @@
 
 
 #include "IoT/UnitsOfMeasure/UnitsOfMeasureService.h"
+#include "Poco/Mutex.h"
 #include <map>
 
 
@@ -33,6 +34,16 @@ public:
 	typedef Poco::SharedPtr<UnitsOfMeasureServiceImpl> Ptr;
 	typedef std::map<std::string, Prefix::Ptr> PrefixMap;
 	typedef std::map<std::string, Unit::Ptr> UnitMap;
+	typedef std::map<std::pair<std::string, std::string>, Conversion> ConversionMap;
+
+	enum
+	{
+		MAX_CACHED_CONVERSIONS = 1024
+			/// Maximum number of compiled conversions kept in the cache.
+			/// Unit codes are supplied by clients, so the cache must
+			/// not grow without bounds. If the cache is full, it is
+			/// cleared before a new conversion is added.
+	};
 
 	UnitsOfMeasureServiceImpl();
 		/// Creates the UnitsOfMeasureService.
@@ -46,6 +57,9 @@ public:
 	void addUnit(const Unit& unit);
 		/// Adds a Unit.
 
+	std::size_t cachedConversions() const;
+		/// Returns the number of compiled conversions currently cached.
+
 	// UnitsOfMeasureService
 	Prefix::Ptr findPrefix(const std::string& code) const;
 	Unit::Ptr findUnit(const std::string& code) const;
@@ -53,8 +67,14 @@ public:
 	std::string format(const std::string& code) const;
 	CanonicalValue canonicalize(double value, const std::string& prefixedCode) const;
 	double convert(double value, const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const;
+	Conversion compileConversion(const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const;
+	std::vector<double> convertMany(const std::vector<double>& values, const Conversion& conversion) const;
 
 protected:
+	double convertSlow(double value, const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const;
+		/// Converts the value by walking the unit definitions.
+		/// Used to compile conversions.
+
 	CanonicalValue convertToBase(double value, const std::string& code) const;
 	double convertFromBase(double value, const std::string& code, const std::string& base) const;
 	PrefixedUnit tryResolve(const std::string& code) const;
@@ -63,6 +83,8 @@ protected:
 private:
 	PrefixMap _prefixes;
 	UnitMap _units;
+	mutable ConversionMap _conversions;
+	mutable Poco::FastMutex _mutex;
 };
 
 
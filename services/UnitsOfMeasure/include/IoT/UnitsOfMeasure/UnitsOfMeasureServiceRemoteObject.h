@@ -50,9 +50,27 @@ public:
 	IoT::UnitsOfMeasure::CanonicalValue canonicalize(double value, const std::string& prefixedCode) const;
 		/// Removes the prefix from the code and scales the value accordingly.
 
+	virtual IoT::UnitsOfMeasure::Conversion compileConversion(const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const;
+		/// Resolves both unit codes and returns a Conversion that can be used
+		/// with convertMany() to efficiently convert many values.
+		/// Compiled conversions are cached, so repeated calls for the same pair of units
+		/// are cheap.
+		///
+		/// Throws a Poco::InvalidArgumentException if the conversion cannot be performed.
+
 	virtual double convert(double value, const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const;
-		/// Converts the value from one unit (given in fromPrefixedCode) to a different one (given in
-		/// toPrefixedCode). Conversion only works if both units share the same base unit.
+		/// Attempts to convert the value from one unit (given in fromPrefixedCode) to a different one
+		/// (given in toPrefixedCode). Conversion only works if both units share the same base unit,
+		/// which must be atomic. Unfortunately, this means that conversion only works for
+		/// a small set of unit pairs, e.g. from km to nautical miles [nmi_i].
+		///
+		/// Temperature conversions between degrees Celsius ("Cel"), degrees Fahrenheit ("[degF]") and Kelvin ("K") are supported.
+		///
+		/// Throws a Poco::InvalidArgumentException if the conversion cannot be performed.
+
+	virtual std::vector < double > convertMany(const std::vector < double >& values, const IoT::UnitsOfMeasure::Conversion& conversion) const;
+		/// Converts all given values using the given Conversion, which must have been
+		/// obtained from compileConversion(), and returns the converted values.
 
 	Poco::SharedPtr < IoT::UnitsOfMeasure::Prefix > findPrefix(const std::string& code) const;
 		/// Looks up the prefix with the given code.
@@ -90,12 +108,24 @@ inline IoT::UnitsOfMeasure::CanonicalValue UnitsOfMeasureServiceRemoteObject::ca
 }
 
 
+inline IoT::UnitsOfMeasure::Conversion UnitsOfMeasureServiceRemoteObject::compileConversion(const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const
+{
+	return _pServiceObject->compileConversion(fromPrefixedCode, toPrefixedCode);
+}
+
+
 inline double UnitsOfMeasureServiceRemoteObject::convert(double value, const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const
 {
 	return _pServiceObject->convert(value, fromPrefixedCode, toPrefixedCode);
 }
 
 
+inline std::vector < double > UnitsOfMeasureServiceRemoteObject::convertMany(const std::vector < double >& values, const IoT::UnitsOfMeasure::Conversion& conversion) const
+{
+	return _pServiceObject->convertMany(values, conversion);
+}
+
+
 inline Poco::SharedPtr < IoT::UnitsOfMeasure::Prefix > UnitsOfMeasureServiceRemoteObject::findPrefix(const std::string& code) const
 {
 	return _pServiceObject->findPrefix(code);
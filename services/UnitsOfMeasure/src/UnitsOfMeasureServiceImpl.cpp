@@ -34,12 +34,26 @@ UnitsOfMeasureServiceImpl::~UnitsOfMeasureServiceImpl()
 void UnitsOfMeasureServiceImpl::addPrefix(const Prefix& prefix)
 {
 	_prefixes[prefix.code] = new Prefix(prefix);
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	_conversions.clear();
 }
 
 
 void UnitsOfMeasureServiceImpl::addUnit(const Unit& unit)
 {
 	_units[unit.code] = new Unit(unit);
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	_conversions.clear();
+}
+
+
+std::size_t UnitsOfMeasureServiceImpl::cachedConversions() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _conversions.size();
 }
 
 
@@ -109,6 +123,55 @@ CanonicalValue UnitsOfMeasureServiceImpl::canonicalize(double value, const std::
 
 
 double UnitsOfMeasureServiceImpl::convert(double value, const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const
+{
+	Conversion conv = compileConversion(fromPrefixedCode, toPrefixedCode);
+	return value*conv.factor + conv.offset;
+}
+
+
+Conversion UnitsOfMeasureServiceImpl::compileConversion(const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const
+{
+	const std::pair<std::string, std::string> key(fromPrefixedCode, toPrefixedCode);
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		ConversionMap::const_iterator it = _conversions.find(key);
+		if (it != _conversions.end()) return it->second;
+	}
+
+	// All supported conversions are affine, so two
+	// sample points are sufficient to determine them.
+	Conversion conv;
+	conv.from = fromPrefixedCode;
+	conv.to = toPrefixedCode;
+	conv.offset = convertSlow(0, fromPrefixedCode, toPrefixedCode);
+	conv.factor = convertSlow(1, fromPrefixedCode, toPrefixedCode) - conv.offset;
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	// Simply start over if the cache is full. Conversions in actual
+	// use are compiled again on their next use, which is cheap
+	// compared to maintaining LRU order on every lookup.
+	if (_conversions.size() >= MAX_CACHED_CONVERSIONS) _conversions.clear();
+	_conversions[key] = conv;
+	return conv;
+}
+
+
+std::vector<double> UnitsOfMeasureServiceImpl::convertMany(const std::vector<double>& values, const Conversion& conversion) const
+{
+	const double factor = conversion.factor;
+	const double offset = conversion.offset;
+	const std::size_t n = values.size();
+	std::vector<double> result(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		result[i] = values[i]*factor + offset;
+	}
+	return result;
+}
+
+
+double UnitsOfMeasureServiceImpl::convertSlow(double value, const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const
 {
 	try
 	{
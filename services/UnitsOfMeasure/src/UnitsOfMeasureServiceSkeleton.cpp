@@ -18,6 +18,8 @@
 #include "IoT/UnitsOfMeasure/UnitsOfMeasureServiceSkeleton.h"
 #include "IoT/UnitsOfMeasure/CanonicalValueDeserializer.h"
 #include "IoT/UnitsOfMeasure/CanonicalValueSerializer.h"
+#include "IoT/UnitsOfMeasure/ConversionDeserializer.h"
+#include "IoT/UnitsOfMeasure/ConversionSerializer.h"
 #include "IoT/UnitsOfMeasure/PrefixDeserializer.h"
 #include "IoT/UnitsOfMeasure/PrefixSerializer.h"
 #include "IoT/UnitsOfMeasure/PrefixedUnitDeserializer.h"
@@ -97,6 +99,65 @@ public:
 };
 
 
+class UnitsOfMeasureServiceCompileConversionMethodHandler: public Poco::RemotingNG::MethodHandler
+{
+public:
+	void invoke(Poco::RemotingNG::ServerTransport& remoting__trans, Poco::RemotingNG::Deserializer& remoting__deser, Poco::RemotingNG::RemoteObject::Ptr remoting__pRemoteObject)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"compileConversion","fromPrefixedCode","toPrefixedCode"};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		bool remoting__requestSucceeded = false;
+		try
+		{
+			std::string fromPrefixedCode;
+			std::string toPrefixedCode;
+			remoting__deser.deserializeMessageBegin(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			Poco::RemotingNG::TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[1], true, remoting__deser, fromPrefixedCode);
+			Poco::RemotingNG::TypeDeserializer<std::string >::deserialize(REMOTING__NAMES[2], true, remoting__deser, toPrefixedCode);
+			remoting__deser.deserializeMessageEnd(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			IoT::UnitsOfMeasure::UnitsOfMeasureServiceRemoteObject* remoting__pCastedRO = static_cast<IoT::UnitsOfMeasure::UnitsOfMeasureServiceRemoteObject*>(remoting__pRemoteObject.get());
+			IoT::UnitsOfMeasure::Conversion remoting__return = remoting__pCastedRO->compileConversion(fromPrefixedCode, toPrefixedCode);
+			remoting__requestSucceeded = true;
+			Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			remoting__staticInitBegin(REMOTING__REPLY_NAME);
+			static const std::string REMOTING__REPLY_NAME("compileConversionReply");
+			remoting__staticInitEnd(REMOTING__REPLY_NAME);
+			remoting__ser.serializeMessageBegin(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			Poco::RemotingNG::TypeSerializer<IoT::UnitsOfMeasure::Conversion >::serialize(Poco::RemotingNG::SerializerBase::RETURN_PARAM, remoting__return, remoting__ser);
+			remoting__ser.serializeMessageEnd(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+		}
+		catch (Poco::Exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], e);
+			}
+		}
+		catch (std::exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc(e.what());
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+		catch (...)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc("Unknown Exception");
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+	}
+
+};
+
+
 class UnitsOfMeasureServiceConvertMethodHandler: public Poco::RemotingNG::MethodHandler
 {
 public:
@@ -158,6 +219,65 @@ public:
 };
 
 
+class UnitsOfMeasureServiceConvertManyMethodHandler: public Poco::RemotingNG::MethodHandler
+{
+public:
+	void invoke(Poco::RemotingNG::ServerTransport& remoting__trans, Poco::RemotingNG::Deserializer& remoting__deser, Poco::RemotingNG::RemoteObject::Ptr remoting__pRemoteObject)
+	{
+		remoting__staticInitBegin(REMOTING__NAMES);
+		static const std::string REMOTING__NAMES[] = {"convertMany","values","conversion"};
+		remoting__staticInitEnd(REMOTING__NAMES);
+		bool remoting__requestSucceeded = false;
+		try
+		{
+			std::vector < double > values;
+			IoT::UnitsOfMeasure::Conversion conversion;
+			remoting__deser.deserializeMessageBegin(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			Poco::RemotingNG::TypeDeserializer<std::vector < double > >::deserialize(REMOTING__NAMES[1], true, remoting__deser, values);
+			Poco::RemotingNG::TypeDeserializer<IoT::UnitsOfMeasure::Conversion >::deserialize(REMOTING__NAMES[2], true, remoting__deser, conversion);
+			remoting__deser.deserializeMessageEnd(REMOTING__NAMES[0], Poco::RemotingNG::SerializerBase::MESSAGE_REQUEST);
+			IoT::UnitsOfMeasure::UnitsOfMeasureServiceRemoteObject* remoting__pCastedRO = static_cast<IoT::UnitsOfMeasure::UnitsOfMeasureServiceRemoteObject*>(remoting__pRemoteObject.get());
+			std::vector < double > remoting__return = remoting__pCastedRO->convertMany(values, conversion);
+			remoting__requestSucceeded = true;
+			Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			remoting__staticInitBegin(REMOTING__REPLY_NAME);
+			static const std::string REMOTING__REPLY_NAME("convertManyReply");
+			remoting__staticInitEnd(REMOTING__REPLY_NAME);
+			remoting__ser.serializeMessageBegin(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+			Poco::RemotingNG::TypeSerializer<std::vector < double > >::serialize(Poco::RemotingNG::SerializerBase::RETURN_PARAM, remoting__return, remoting__ser);
+			remoting__ser.serializeMessageEnd(REMOTING__REPLY_NAME, Poco::RemotingNG::SerializerBase::MESSAGE_REPLY);
+		}
+		catch (Poco::Exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], e);
+			}
+		}
+		catch (std::exception& e)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc(e.what());
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+		catch (...)
+		{
+			if (!remoting__requestSucceeded)
+			{
+				Poco::RemotingNG::Serializer& remoting__ser = remoting__trans.sendReply(Poco::RemotingNG::SerializerBase::MESSAGE_FAULT);
+				Poco::Exception exc("Unknown Exception");
+				remoting__ser.serializeFaultMessage(REMOTING__NAMES[0], exc);
+			}
+		}
+	}
+
+};
+
+
 class UnitsOfMeasureServiceFindPrefixMethodHandler: public Poco::RemotingNG::MethodHandler
 {
 public:
@@ -391,7 +511,9 @@ UnitsOfMeasureServiceSkeleton::UnitsOfMeasureServiceSkeleton():
 
 {
 	addMethodHandler("canonicalize", new IoT::UnitsOfMeasure::UnitsOfMeasureServiceCanonicalizeMethodHandler);
+	addMethodHandler("compileConversion", new IoT::UnitsOfMeasure::UnitsOfMeasureServiceCompileConversionMethodHandler);
 	addMethodHandler("convert", new IoT::UnitsOfMeasure::UnitsOfMeasureServiceConvertMethodHandler);
+	addMethodHandler("convertMany", new IoT::UnitsOfMeasure::UnitsOfMeasureServiceConvertManyMethodHandler);
 	addMethodHandler("findPrefix", new IoT::UnitsOfMeasure::UnitsOfMeasureServiceFindPrefixMethodHandler);
 	addMethodHandler("findUnit", new IoT::UnitsOfMeasure::UnitsOfMeasureServiceFindUnitMethodHandler);
 	addMethodHandler("format", new IoT::UnitsOfMeasure::UnitsOfMeasureServiceFormatMethodHandler);
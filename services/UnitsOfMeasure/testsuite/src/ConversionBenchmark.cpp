@@ -0,0 +1,197 @@
+//
+// ConversionBenchmark.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// A conversion rate benchmark for the UnitsOfMeasureService.
+//
+// For a set of unit pairs, the benchmark measures how many values
+// per second can be converted by:
+//   - resolving both units for every value (uncached),
+//   - calling convert() for every value,
+//   - calling convertMany() with a compiled Conversion.
+//
+
+
+#include "IoT/UnitsOfMeasure/UnitsOfMeasureServiceImpl.h"
+#include "IoT/UnitsOfMeasure/UCUMEssenceParser.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/IntValidator.h"
+#include "Poco/FileStream.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Format.h"
+#include <iostream>
+#include <vector>
+
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::OptionCallback;
+using Poco::Util::HelpFormatter;
+using Poco::Util::IntValidator;
+using namespace IoT::UnitsOfMeasure;
+
+
+class BenchmarkService: public UnitsOfMeasureServiceImpl
+	/// Gives the benchmark access to the uncached conversion.
+{
+public:
+	typedef Poco::SharedPtr<BenchmarkService> Ptr;
+
+	double convertUncached(double value, const std::string& fromPrefixedCode, const std::string& toPrefixedCode) const
+	{
+		return convertSlow(value, fromPrefixedCode, toPrefixedCode);
+	}
+};
+
+
+class ConversionBenchmark: public Application
+{
+public:
+	ConversionBenchmark():
+		_helpRequested(false),
+		_values(1000000),
+		_batch(1000)
+	{
+	}
+
+protected:
+	void defineOptions(OptionSet& options)
+	{
+		Application::defineOptions(options);
+
+		options.addOption(
+			Option("help", "h", "Display help information on command line arguments.")
+				.required(false)
+				.repeatable(false)
+				.callback(OptionCallback<ConversionBenchmark>(this, &ConversionBenchmark::handleHelp)));
+
+		options.addOption(
+			Option("ucum", "u", "Path to the ucum-essence.xml file (default ../bundle/ucum-essence.xml).")
+				.required(false)
+				.repeatable(false)
+				.argument("<path>")
+				.binding("benchmark.ucum"));
+
+		options.addOption(
+			Option("values", "n", "Number of values to convert per measurement (default 1000000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 1000000000))
+				.binding("benchmark.values"));
+
+		options.addOption(
+			Option("batch", "b", "Number of values passed to a single convertMany() call (default 1000).")
+				.required(false)
+				.repeatable(false)
+				.argument("<n>")
+				.validator(new IntValidator(1, 10000000))
+				.binding("benchmark.batch"));
+	}
+
+	void handleHelp(const std::string& name, const std::string& value)
+	{
+		_helpRequested = true;
+		stopOptionsProcessing();
+	}
+
+	void displayHelp()
+	{
+		HelpFormatter helpFormatter(options());
+		helpFormatter.setCommand(commandName());
+		helpFormatter.setUsage("OPTIONS");
+		helpFormatter.setHeader("Benchmark measuring the unit conversion rate of the UnitsOfMeasureService.");
+		helpFormatter.format(std::cout);
+	}
+
+	static double rate(int values, const Poco::Stopwatch& sw)
+	{
+		double seconds = static_cast<double>(sw.elapsed())/Poco::Timestamp::resolution();
+		return seconds > 0 ? values/seconds : 0.0;
+	}
+
+	void measure(const BenchmarkService& uom, const std::string& from, const std::string& to)
+	{
+		Poco::Stopwatch sw;
+		double sum = 0;
+
+		// uncached conversion is slow, so use fewer values
+		int uncachedValues = std::max(_values/100, 1);
+		sw.start();
+		for (int i = 0; i < uncachedValues; i++)
+		{
+			sum += uom.convertUncached(i, from, to);
+		}
+		sw.stop();
+		double uncachedRate = rate(uncachedValues, sw);
+
+		sw.restart();
+		for (int i = 0; i < _values; i++)
+		{
+			sum += uom.convert(i, from, to);
+		}
+		sw.stop();
+		double convertRate = rate(_values, sw);
+
+		std::vector<double> values(_batch);
+		for (int i = 0; i < _batch; i++) values[i] = i;
+		sw.restart();
+		Conversion conv = uom.compileConversion(from, to);
+		int converted = 0;
+		while (converted < _values)
+		{
+			std::vector<double> result = uom.convertMany(values, conv);
+			sum += result.back();
+			converted += _batch;
+		}
+		sw.stop();
+		double batchRate = rate(converted, sw);
+
+		std::cout << Poco::format("%-20s %14.0f %14.0f %14.0f", from + " -> " + to, uncachedRate, convertRate, batchRate);
+		// keep the compiler from optimizing the conversions away
+		std::cout << (sum == 0.5 ? " " : "") << std::endl;
+	}
+
+	int main(const std::vector<std::string>& args)
+	{
+		if (_helpRequested)
+		{
+			displayHelp();
+			return Application::EXIT_OK;
+		}
+
+		_values = config().getInt("benchmark.values", _values);
+		_batch = config().getInt("benchmark.batch", _batch);
+
+		BenchmarkService uom;
+		UCUMEssenceParser parser(uom);
+		Poco::FileInputStream istr(config().getString("benchmark.ucum", "../bundle/ucum-essence.xml"));
+		parser.parse(istr);
+
+		std::cout << Poco::format("%d values per measurement, batch size %d, rates in values per second", _values, _batch) << std::endl;
+		std::cout << "conversion                 uncached      convert()  convertMany()" << std::endl;
+
+		measure(uom, "km", "[nmi_i]");
+		measure(uom, "[nmi_i]", "[mi_i]");
+		measure(uom, "Cel", "[degF]");
+		measure(uom, "[degF]", "K");
+
+		return Application::EXIT_OK;
+	}
+
+private:
+	bool _helpRequested;
+	int _values;
+	int _batch;
+};
+
+
+POCO_APP_MAIN(ConversionBenchmark)
@@ -145,6 +145,105 @@ void UnitsOfMeasureTest::testConvert()
 }
 
 
+void UnitsOfMeasureTest::testCompileConversion()
+{
+	Conversion conv = _pUoM->compileConversion("[nmi_i]", "km");
+	assert (conv.from == "[nmi_i]");
+	assert (conv.to == "km");
+	assertEqualDelta (1.852, conv.factor, 0.0001);
+	assert (conv.offset == 0);
+
+	conv = _pUoM->compileConversion("Cel", "[degF]");
+	assertEqualDelta (1.8, conv.factor, 0.0001);
+	assertEqualDelta (32, conv.offset, 0.0001);
+
+	conv = _pUoM->compileConversion("Cel", "K");
+	assertEqualDelta (1, conv.factor, 0.0001);
+	assertEqualDelta (273.15, conv.offset, 0.0001);
+
+	conv = _pUoM->compileConversion("m", "m");
+	assert (conv.factor == 1);
+	assert (conv.offset == 0);
+
+	try
+	{
+		conv = _pUoM->compileConversion("m", "s");
+		fail("incompatible units - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	try
+	{
+		conv = _pUoM->compileConversion("m", "kfoo");
+		fail("bad code - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+}
+
+
+void UnitsOfMeasureTest::testConversionCache()
+{
+	static const char* prefixes[] = {"", "k", "M", "G", "T", "P", "E", "Z", "Y", "h", "da", "d", "c", "m", "u", "n", "p", "f", "a", "z", "y"};
+	static const char* units[] = {"m", "g", "s"};
+	const std::size_t nPrefixes = sizeof(prefixes)/sizeof(prefixes[0]);
+	const std::size_t nUnits = sizeof(units)/sizeof(units[0]);
+
+	for (std::size_t u = 0; u < nUnits; u++)
+	{
+		for (std::size_t i = 0; i < nPrefixes; i++)
+		{
+			for (std::size_t k = 0; k < nPrefixes; k++)
+			{
+				_pUoM->compileConversion(std::string(prefixes[i]) + units[u], std::string(prefixes[k]) + units[u]);
+			}
+		}
+	}
+	assert (nUnits*nPrefixes*nPrefixes > UnitsOfMeasureServiceImpl::MAX_CACHED_CONVERSIONS);
+	assert (_pUoM->cachedConversions() > 0);
+	assert (_pUoM->cachedConversions() <= UnitsOfMeasureServiceImpl::MAX_CACHED_CONVERSIONS);
+
+	// discarded conversions are compiled again
+	Conversion conv = _pUoM->compileConversion("km", "m");
+	assertEqualDelta (1000, conv.factor, 0.0001);
+	assert (conv.offset == 0);
+	assert (_pUoM->cachedConversions() <= UnitsOfMeasureServiceImpl::MAX_CACHED_CONVERSIONS);
+}
+
+
+void UnitsOfMeasureTest::testConvertMany()
+{
+	std::vector<double> values;
+	values.push_back(-40);
+	values.push_back(0);
+	values.push_back(30);
+	values.push_back(100);
+
+	Conversion conv = _pUoM->compileConversion("Cel", "[degF]");
+	std::vector<double> converted = _pUoM->convertMany(values, conv);
+	assert (converted.size() == 4);
+	assertEqualDelta (-40, converted[0], 0.0001);
+	assertEqualDelta (32, converted[1], 0.0001);
+	assertEqualDelta (86, converted[2], 0.0001);
+	assertEqualDelta (212, converted[3], 0.0001);
+
+	for (std::size_t i = 0; i < values.size(); i++)
+	{
+		assertEqualDelta (_pUoM->convert(values[i], "Cel", "[degF]"), converted[i], 0.0001);
+	}
+
+	conv = _pUoM->compileConversion("[nmi_i]", "[mi_i]");
+	converted = _pUoM->convertMany(values, conv);
+	assertEqualDelta (34.5234, converted[2], 0.0001);
+
+	converted = _pUoM->convertMany(std::vector<double>(), conv);
+	assert (converted.empty());
+}
+
+
 void UnitsOfMeasureTest::setUp()
 {
 	_pUoM = new UnitsOfMeasureServiceImpl;
@@ -179,6 +278,9 @@ CppUnit::Test* UnitsOfMeasureTest::suite()
 	CppUnit_addTest(pSuite, UnitsOfMeasureTest, testFormat);
 	CppUnit_addTest(pSuite, UnitsOfMeasureTest, testCanonicalize);
 	CppUnit_addTest(pSuite, UnitsOfMeasureTest, testConvert);
+	CppUnit_addTest(pSuite, UnitsOfMeasureTest, testCompileConversion);
+	CppUnit_addTest(pSuite, UnitsOfMeasureTest, testConversionCache);
+	CppUnit_addTest(pSuite, UnitsOfMeasureTest, testConvertMany);
 
 	return pSuite;
 }
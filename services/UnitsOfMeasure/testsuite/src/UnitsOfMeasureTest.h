@@ -31,6 +31,9 @@ public:
 	void testFormat();
 	void testCanonicalize();
 	void testConvert();
+	void testCompileConversion();
+	void testConversionCache();
+	void testConvertMany();
 
 	void setUp();
 	void tearDown();
@@ -9,14 +9,87 @@ devicesControllers.controller('DevicesCtrl', ['$scope', '$http', '$interval',
     $scope.setOrderBy = function(col) {
       $scope.orderBy = col;
     }
-    $http.get('/macchina/devices/devices.jss').success(function(data) {
-      $scope.devices = data;
-    });
-    $interval(function() {
+    $scope.version = 0;
+    $scope.removed = {};
+    $scope.poller = null;
+
+    $scope.findDevice = function(id) {
+      for (var i = 0; i < $scope.devices.length; i++) {
+        if ($scope.devices[i].id == id) return i;
+      }
+      return -1;
+    };
+
+    // Applies a change published by the DeviceState service.
+    // Changes for different devices may arrive out of order, so
+    // a change is compared with the version of its device.
+    // An added device requires a complete reload.
+    $scope.applyChange = function(change) {
+      var index = $scope.findDevice(change.id);
+      var device = index >= 0 ? $scope.devices[index] : null;
+      if (change.event == 'changed') {
+        if (!device || change.version <= device.version) return;
+        device.version = change.version;
+        if (change.displayValue !== undefined) {
+          device.displayValue = change.displayValue + " " + device.displayUnit;
+        }
+        else if (change.displayState !== undefined && device.physicalUnit == "") {
+          device.displayValue = change.displayState;
+        }
+      }
+      else if (change.event == 'removed') {
+        if (device && change.version <= device.version) return;
+        $scope.removed[change.id] = change.version;
+        if (device) $scope.devices.splice(index, 1);
+      }
+      else if (change.event == 'added') {
+        if (device && change.version <= device.version) return;
+        if (!device && change.version <= $scope.version) return;
+        if ($scope.removed[change.id] !== undefined && change.version <= $scope.removed[change.id]) return;
+        $scope.load();
+      }
+    };
+
+    $scope.subscribe = function(subject) {
+      WebEvent.onConnect = function() {
+        WebEvent.subscribe(subject);
+      };
+      WebEvent.onNotify = function(event) {
+        $scope.$apply(function() {
+          $scope.applyChange(JSON.parse(event.data));
+        });
+      };
+      WebEvent.onDisconnect = function() {
+        $scope.poll();
+      };
+      if (!WebEvent.connect()) {
+        $scope.poll();
+      }
+    };
+
+    // Without the DeviceState service or WebSocket support,
+    // device states are periodically reloaded.
+    $scope.poll = function() {
+      if ($scope.poller) return;
+      $scope.poller = $interval(function() {
+        $scope.load();
+      }, 1000);
+    };
+
+    $scope.load = function(subscribe) {
       $http.get('/macchina/devices/devices.jss').success(function(data) {
-        $scope.devices = data;
-      })
-    }, 1000);
+        $scope.devices = data.devices;
+        $scope.version = data.version;
+        if (subscribe) {
+          if (data.subject)
+            $scope.subscribe(data.subject);
+          else
+            $scope.poll();
+        }
+      });
+    };
+
+    $scope.load(true);
   }]);
 
 devicesControllers.controller('SessionCtrl', ['$scope', '$http',
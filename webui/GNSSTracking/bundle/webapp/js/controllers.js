@@ -56,23 +56,60 @@ trackingControllers.controller('TrackingCtrl', ['$scope', '$http', '$interval',
 		$scope.markers.addMarker($scope.marker);	
     };
     
-    $http.get('/macchina/gnss/tracking.jss').success(function(data) {
+    $scope.update = function(data) {
       $scope.trackingData = data;
       if (data.valid)
       {
         $scope.setPosition(data.position);
       }
-      if (data.refresh)
+    };
+
+    $scope.poll = function(refresh) {
+      $interval(function() {
+        $http.get('/macchina/gnss/tracking.jss').success(function(data) {
+          $scope.update(data);
+        })
+      }, refresh);
+    };
+
+    // Position updates published by the DeviceState service
+    // only contain position, course and speed. Outdated
+    // updates (with a lower version) are ignored.
+    $scope.version = 0;
+    $scope.subscribe = function(subject, refresh) {
+      WebEvent.onConnect = function() {
+        WebEvent.subscribe(subject);
+      };
+      WebEvent.onNotify = function(event) {
+        var change = JSON.parse(event.data);
+        if (change.version <= $scope.version) return;
+        $scope.version = change.version;
+        if (change.position)
+        {
+          $scope.$apply(function() {
+            $scope.trackingData.position = change.position;
+            $scope.trackingData.course = change.course;
+            $scope.trackingData.speed = change.speed;
+            $scope.trackingData.valid = true;
+            $scope.setPosition(change.position);
+          });
+        }
+      };
+      if (!WebEvent.connect() && refresh)
+      {
+        $scope.poll(refresh);
+      }
+    };
+
+    $http.get('/macchina/gnss/tracking.jss').success(function(data) {
+      $scope.update(data);
+      if (data.subject && data.id)
+      {
+        $scope.subscribe(data.subject + '.' + data.id, data.refresh);
+      }
+      else if (data.refresh)
       {
-        $interval(function() {
-          $http.get('/macchina/gnss/tracking.jss').success(function(data) {
-            $scope.trackingData = data;
-            if (data.valid)
-            {
-              $scope.setPosition(data.position);
-            }
-          })
-        }, data.refresh);
+        $scope.poll(data.refresh);
       }
     });
   }]);
@@ -37,6 +37,37 @@ sysinfoControllers.controller('MemoryCtrl', ['$scope', '$http',
     });
   }]);
 
+sysinfoControllers.controller('JSRuntimeCtrl', ['$scope', '$http',
+  function ($scope, $http) {
+    $scope.executors = [];
+    $http.get('/macchina/sysinfo/jsruntime.json').success(function(data) {
+      $scope.executors = data;
+    });
+    $scope.profilerAction = function(executor, action, done) {
+      $http({
+        method: 'POST',
+        url: '/macchina/sysinfo/jsprofiler',
+        data: $.param({action: action, uri: executor.uri}),
+        headers: {'Content-Type': 'application/x-www-form-urlencoded'}
+      }).success(done);
+    };
+    $scope.startProfiling = function(executor) {
+      $scope.profilerAction(executor, 'start', function(data) {
+        executor.profiling = data.count > 0;
+      });
+    };
+    $scope.stopProfiling = function(executor) {
+      $scope.profilerAction(executor, 'stop', function(data) {
+        executor.profiling = false;
+        executor.profiled = data.count > 0;
+      });
+    };
+  }]);
+
+sysinfoControllers.filter('encodeURIComponent', function() {
+  return window.encodeURIComponent;
+});
+
 sysinfoControllers.controller('SessionCtrl', ['$scope', '$http',
   function($scope, $http) {
     $http.get('/macchina/session.json').success(function(data) {
@@ -0,0 +1,55 @@
+//
+// BundleActivator.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Poco/OSP/BundleActivator.h"
+#include "Poco/OSP/BundleContext.h"
+#include "Poco/ClassLibrary.h"
+#include "JSRuntimeRequestHandler.h"
+#include "JSProfilerRequestHandler.h"
+
+
+namespace IoT {
+namespace Web {
+namespace SystemInformation {
+
+
+class BundleActivator: public Poco::OSP::BundleActivator
+{
+public:
+	BundleActivator()
+	{
+	}
+	
+	~BundleActivator()
+	{
+	}
+	
+	void start(Poco::OSP::BundleContext::Ptr pContext)
+	{
+	}
+		
+	void stop(Poco::OSP::BundleContext::Ptr pContext)
+	{
+	}
+};
+
+
+} } } // namespace IoT::Web::SystemInformation
+
+
+POCO_BEGIN_NAMED_MANIFEST(WebServer, Poco::OSP::Web::WebRequestHandlerFactory)
+	POCO_EXPORT_CLASS(IoT::Web::SystemInformation::JSRuntimeRequestHandlerFactory)
+	POCO_EXPORT_CLASS(IoT::Web::SystemInformation::JSProfilerRequestHandlerFactory)
+POCO_END_MANIFEST
+
+
+POCO_BEGIN_MANIFEST(Poco::OSP::BundleActivator)
+	POCO_EXPORT_CLASS(IoT::Web::SystemInformation::BundleActivator)
+POCO_END_MANIFEST
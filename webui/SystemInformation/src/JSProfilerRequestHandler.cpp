@@ -0,0 +1,146 @@
+//
+// JSProfilerRequestHandler.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "JSProfilerRequestHandler.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTMLForm.h"
+#include "Poco/OSP/Web/WebSession.h"
+#include "Poco/OSP/Web/WebSessionManager.h"
+#include "Poco/OSP/ScriptProfilerService.h"
+#include "Poco/OSP/ServiceRegistry.h"
+#include "Poco/OSP/ServiceFinder.h"
+#include "Poco/OSP/Auth/AuthService.h"
+#include "Poco/NumberParser.h"
+#include "Utility.h"
+
+
+namespace IoT {
+namespace Web {
+namespace SystemInformation {
+
+
+const std::string JSProfilerRequestHandler::PROFILER_SERVICE_NAME("com.appinf.osp.js.profiler");
+const std::string JSProfilerRequestHandler::PROFILER_PERMISSION("bundleAdmin");
+
+
+JSProfilerRequestHandler::JSProfilerRequestHandler(Poco::OSP::BundleContext::Ptr pContext):
+	_pContext(pContext)
+{
+}
+
+
+void JSProfilerRequestHandler::handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
+{
+	Poco::OSP::Web::WebSession::Ptr pSession;
+	{
+		Poco::OSP::ServiceRef::Ptr pWebSessionManagerRef = context()->registry().findByName(Poco::OSP::Web::WebSessionManager::SERVICE_NAME);
+		if (pWebSessionManagerRef)
+		{
+			Poco::OSP::Web::WebSessionManager::Ptr pWebSessionManager = pWebSessionManagerRef->castedInstance<Poco::OSP::Web::WebSessionManager>();
+			pSession = pWebSessionManager->find(context()->thisBundle()->properties().getString("websession.id"), request);
+		}
+	}
+	if (!Utility::isAuthenticated(pSession, response)) return;
+
+	Poco::OSP::ServiceRef::Ptr pProfilerServiceRef = context()->registry().findByName(PROFILER_SERVICE_NAME);
+	if (!pProfilerServiceRef)
+	{
+		sendStatus(response, Poco::Net::HTTPResponse::HTTP_SERVICE_UNAVAILABLE);
+		return;
+	}
+	Poco::OSP::ScriptProfilerService::Ptr pProfilerService = pProfilerServiceRef->castedInstance<Poco::OSP::ScriptProfilerService>();
+
+	Poco::Net::HTMLForm form(request, request.stream());
+	std::string action = form.get("action", "");
+	std::string uri = form.get("uri", "");
+	if (uri.empty())
+	{
+		sendStatus(response, Poco::Net::HTTPResponse::HTTP_BAD_REQUEST);
+		return;
+	}
+
+	if (action == "download" && request.getMethod() == Poco::Net::HTTPRequest::HTTP_GET)
+	{
+		if (pProfilerService->profileCount(uri) == 0)
+		{
+			sendStatus(response, Poco::Net::HTTPResponse::HTTP_NOT_FOUND);
+			return;
+		}
+
+		std::string format = form.get("format", "cpuprofile");
+		response.setChunkedTransferEncoding(true);
+		if (format == "collapsed")
+		{
+			response.setContentType("text/plain");
+			response.set("Content-Disposition", "attachment; filename=\"profile.collapsed.txt\"");
+			std::ostream& ostr = response.send();
+			pProfilerService->writeProfiles(uri, Poco::OSP::ScriptProfilerService::FORMAT_COLLAPSED_STACKS, ostr);
+		}
+		else
+		{
+			response.setContentType("application/json");
+			response.set("Content-Disposition", "attachment; filename=\"profile.cpuprofile\"");
+			std::ostream& ostr = response.send();
+			pProfilerService->writeProfiles(uri, Poco::OSP::ScriptProfilerService::FORMAT_CPUPROFILE, ostr);
+		}
+	}
+	else if (request.getMethod() == Poco::Net::HTTPRequest::HTTP_POST && (action == "start" || action == "stop"))
+	{
+		std::string username = pSession->getValue<std::string>("username");
+		Poco::OSP::Auth::AuthService::Ptr pAuthService = Poco::OSP::ServiceFinder::findByName<Poco::OSP::Auth::AuthService>(context(), "osp.auth");
+		if (!pAuthService->authorize(username, PROFILER_PERMISSION))
+		{
+			sendStatus(response, Poco::Net::HTTPResponse::HTTP_FORBIDDEN);
+			return;
+		}
+
+		std::size_t count;
+		if (action == "start")
+		{
+			int interval = 0;
+			if (!Poco::NumberParser::tryParse(form.get("interval", "0"), interval) || interval < 0)
+			{
+				sendStatus(response, Poco::Net::HTTPResponse::HTTP_BAD_REQUEST);
+				return;
+			}
+			count = pProfilerService->start(uri, interval);
+		}
+		else
+		{
+			count = pProfilerService->stop(uri);
+		}
+		response.setChunkedTransferEncoding(true);
+		response.setContentType("application/json");
+		std::ostream& ostr = response.send();
+		ostr << "{\"count\":" << count << "}";
+	}
+	else
+	{
+		sendStatus(response, Poco::Net::HTTPResponse::HTTP_BAD_REQUEST);
+	}
+}
+
+
+void JSProfilerRequestHandler::sendStatus(Poco::Net::HTTPServerResponse& response, Poco::Net::HTTPResponse::HTTPStatus status)
+{
+	response.setStatusAndReason(status);
+	response.setContentLength(0);
+	response.send();
+}
+
+
+Poco::Net::HTTPRequestHandler* JSProfilerRequestHandlerFactory::createRequestHandler(const Poco::Net::HTTPServerRequest& request)
+{
+	return new JSProfilerRequestHandler(context());
+}
+
+
+} } } // namespace IoT::Web::SystemInformation
@@ -0,0 +1,81 @@
+//
+// JSProfilerRequestHandler.h
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef SystemInformation_JSProfilerRequestHandler_INCLUDED
+#define SystemInformation_JSProfilerRequestHandler_INCLUDED
+
+
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/OSP/Web/WebRequestHandlerFactory.h"
+#include "Poco/OSP/BundleContext.h"
+
+
+namespace IoT {
+namespace Web {
+namespace SystemInformation {
+
+
+class JSProfilerRequestHandler: public Poco::Net::HTTPRequestHandler
+	/// Controls the JSProfilerService.
+	///
+	/// Supported requests (parameters in query string or form):
+	///   - POST action=start&uri=<script URI>[&interval=<microseconds>]:
+	///     starts profiling the given script(s).
+	///   - POST action=stop&uri=<script URI>: stops profiling
+	///     the given script(s).
+	///   - GET action=download&uri=<script URI>&format=cpuprofile|collapsed:
+	///     downloads the last recorded profile, either in Chrome DevTools
+	///     (.cpuprofile) format, or as collapsed stacks for flame graphs.
+	///
+	/// All requests require an authenticated session. Starting and
+	/// stopping the profiler additionally requires the "bundleAdmin"
+	/// permission.
+	///
+	/// The profiler is accessed through the ScriptProfilerService
+	/// interface registered by the JavaScript bundle.
+{
+public:
+	static const std::string PROFILER_SERVICE_NAME;
+		/// The name of the ScriptProfilerService for JavaScript.
+
+	static const std::string PROFILER_PERMISSION;
+		/// The permission required to start and stop the profiler.
+
+	JSProfilerRequestHandler(Poco::OSP::BundleContext::Ptr pContext);
+		/// Creates the JSProfilerRequestHandler using the given bundle context.
+
+	// Poco::Net::HTTPRequestHandler
+	void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response);
+
+protected:
+	Poco::OSP::BundleContext::Ptr context() const
+	{
+		return _pContext;
+	}
+
+	void sendStatus(Poco::Net::HTTPServerResponse& response, Poco::Net::HTTPResponse::HTTPStatus status);
+
+private:
+	Poco::OSP::BundleContext::Ptr _pContext;
+};
+
+
+class JSProfilerRequestHandlerFactory: public Poco::OSP::Web::WebRequestHandlerFactory
+{
+public:
+	Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest& request);
+};
+
+
+} } } // namespace IoT::Web::SystemInformation
+
+
+#endif // SystemInformation_JSProfilerRequestHandler_INCLUDED
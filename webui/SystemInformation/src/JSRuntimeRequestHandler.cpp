@@ -0,0 +1,93 @@
+//
+// JSRuntimeRequestHandler.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "JSRuntimeRequestHandler.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/OSP/Web/WebSession.h"
+#include "Poco/OSP/Web/WebSessionManager.h"
+#include "Poco/OSP/ScriptStatisticsService.h"
+#include "Poco/OSP/ServiceRegistry.h"
+#include "Poco/UTF8String.h"
+#include "Utility.h"
+
+
+namespace IoT {
+namespace Web {
+namespace SystemInformation {
+
+
+const std::string JSRuntimeRequestHandler::STATISTICS_SERVICE_NAME("com.appinf.osp.js.statistics");
+
+
+JSRuntimeRequestHandler::JSRuntimeRequestHandler(Poco::OSP::BundleContext::Ptr pContext):
+	_pContext(pContext)
+{
+}
+
+
+void JSRuntimeRequestHandler::handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
+{
+	Poco::OSP::Web::WebSession::Ptr pSession;
+	{
+		Poco::OSP::ServiceRef::Ptr pWebSessionManagerRef = context()->registry().findByName(Poco::OSP::Web::WebSessionManager::SERVICE_NAME);
+		if (pWebSessionManagerRef)
+		{
+			Poco::OSP::Web::WebSessionManager::Ptr pWebSessionManager = pWebSessionManagerRef->castedInstance<Poco::OSP::Web::WebSessionManager>();
+			pSession = pWebSessionManager->find(context()->thisBundle()->properties().getString("websession.id"), request);
+		}
+	}
+	if (!Utility::isAuthenticated(pSession, response)) return;
+
+	std::vector<Poco::OSP::ScriptStatisticsService::Statistics> statistics;
+	Poco::OSP::ServiceRef::Ptr pStatisticsServiceRef = context()->registry().findByName(STATISTICS_SERVICE_NAME);
+	if (pStatisticsServiceRef)
+	{
+		pStatisticsServiceRef->castedInstance<Poco::OSP::ScriptStatisticsService>()->statistics(statistics);
+	}
+
+	response.setChunkedTransferEncoding(true);
+	response.setContentType("application/json");
+	std::ostream& ostr = response.send();
+
+	ostr << "[";
+	for (std::vector<Poco::OSP::ScriptStatisticsService::Statistics>::const_iterator it = statistics.begin(); it != statistics.end(); ++it)
+	{
+		if (it != statistics.begin()) ostr << ",";
+		ostr
+			<< "{"
+			<< "\"uri\":\"" << Poco::UTF8::escape(it->uri) << "\","
+			<< "\"callbacks\":" << it->callbacks << ","
+			<< "\"scriptTime\":" << it->scriptTime << ","
+			<< "\"scriptTimeMax\":" << it->scriptTimeMax << ","
+			<< "\"timerCallbacks\":" << it->timerCallbacks << ","
+			<< "\"timerLagTotal\":" << it->timerLagTotal << ","
+			<< "\"timerLagMax\":" << it->timerLagMax << ","
+			<< "\"gcCount\":" << it->gcCount << ","
+			<< "\"gcTime\":" << it->gcTime << ","
+			<< "\"gcTimeMax\":" << it->gcTimeMax << ","
+			<< "\"heapTotal\":" << it->heapTotal << ","
+			<< "\"heapUsed\":" << it->heapUsed << ","
+			<< "\"heapLimit\":" << it->heapLimit << ","
+			<< "\"mallocedMemory\":" << it->mallocedMemory << ","
+			<< "\"profiling\":" << (it->profiling ? "true" : "false")
+			<< "}";
+	}
+	ostr << "]";
+}
+
+
+Poco::Net::HTTPRequestHandler* JSRuntimeRequestHandlerFactory::createRequestHandler(const Poco::Net::HTTPServerRequest& request)
+{
+	return new JSRuntimeRequestHandler(context());
+}
+
+
+} } } // namespace IoT::Web::SystemInformation
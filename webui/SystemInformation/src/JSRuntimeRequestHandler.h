@@ -0,0 +1,62 @@
+//
+// JSRuntimeRequestHandler.h
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef SystemInformation_JSRuntimeRequestHandler_INCLUDED
+#define SystemInformation_JSRuntimeRequestHandler_INCLUDED
+
+
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/OSP/Web/WebRequestHandlerFactory.h"
+#include "Poco/OSP/BundleContext.h"
+
+
+namespace IoT {
+namespace Web {
+namespace SystemInformation {
+
+
+class JSRuntimeRequestHandler: public Poco::Net::HTTPRequestHandler
+	/// Returns the runtime statistics of all JavaScript executors,
+	/// obtained from the ScriptStatisticsService registered by the
+	/// JavaScript bundle, as JSON array. If the service is not
+	/// available, an empty array is returned.
+{
+public:
+	static const std::string STATISTICS_SERVICE_NAME;
+		/// The name of the ScriptStatisticsService for JavaScript.
+
+	JSRuntimeRequestHandler(Poco::OSP::BundleContext::Ptr pContext);
+		/// Creates the JSRuntimeRequestHandler using the given bundle context.
+
+	// Poco::Net::HTTPRequestHandler
+	void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response);
+
+protected:
+	Poco::OSP::BundleContext::Ptr context() const
+	{
+		return _pContext;
+	}
+
+private:
+	Poco::OSP::BundleContext::Ptr _pContext;
+};
+
+
+class JSRuntimeRequestHandlerFactory: public Poco::OSP::Web::WebRequestHandlerFactory
+{
+public:
+	Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest& request);
+};
+
+
+} } } // namespace IoT::Web::SystemInformation
+
+
+#endif // SystemInformation_JSRuntimeRequestHandler_INCLUDED
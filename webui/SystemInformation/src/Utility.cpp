@@ -0,0 +1,33 @@
+//
+// Utility.cpp
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#include "Utility.h"
+
+
+namespace IoT {
+namespace Web {
+namespace SystemInformation {
+
+
+bool Utility::isAuthenticated(Poco::OSP::Web::WebSession::Ptr pSession, Poco::Net::HTTPServerResponse& response)
+{
+	if (!pSession || !pSession->has("username"))
+	{
+		response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_UNAUTHORIZED);
+		response.setContentLength(0);
+		response.setChunkedTransferEncoding(false);
+		response.send();
+		return false;
+	}
+	return true;
+}
+
+
+} } } // namespace IoT::Web::SystemInformation
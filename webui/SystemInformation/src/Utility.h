@@ -0,0 +1,40 @@
+//
+// Utility.h
+//
+// Copyright (c) 2018, Applied Informatics Software Engineering GmbH.
+// All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+
+
+#ifndef SystemInformation_Utility_INCLUDED
+#define SystemInformation_Utility_INCLUDED
+
+
+#include "Poco/Poco.h"
+#include "Poco/OSP/Web/WebSession.h"
+#include "Poco/Net/HTTPServerResponse.h"
+
+
+namespace IoT {
+namespace Web {
+namespace SystemInformation {
+
+
+class Utility
+	/// This class contains various utility functions used by request handlers.
+{
+public:
+	static bool isAuthenticated(Poco::OSP::Web::WebSession::Ptr pSession, Poco::Net::HTTPServerResponse& response);
+		/// Checks if there is a valid session.
+		///
+		/// Returns true if the session is valid.
+		/// Returns false and sends the HTTP response with a 401 status if not.
+};
+
+
+} } } // namespace IoT::Web::SystemInformation
+
+
+#endif // SystemInformation_Utility_INCLUDED